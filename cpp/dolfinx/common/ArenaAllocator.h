@@ -0,0 +1,152 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace dolfinx::common
+{
+
+/// Monotonic arena for construction-phase temporaries. Mesh and dofmap
+/// building allocate and free many short-lived vectors and maps whose
+/// lifetimes all end when the build finishes; routing them through an
+/// arena turns each allocation into a pointer bump and releases the
+/// memory wholesale when the arena goes out of scope. Individual
+/// deallocations are no-ops, so the arena is only suitable for
+/// temporaries that are dropped together.
+///
+/// Usage:
+///
+///   Arena arena;
+///   std::vector<int, ArenaAllocator<int>> tmp(arena);
+
+class Arena
+{
+public:
+  /// Create an arena
+  /// @param[in] chunk_size Size in bytes of the first chunk; later
+  ///            chunks double until reaching a fixed cap
+  explicit Arena(std::size_t chunk_size = 1 << 20)
+      : _chunk_size(chunk_size), _free(nullptr), _space(0)
+  {
+  }
+
+  // An arena is referenced by its allocators and must not move
+  Arena(const Arena&) = delete;
+
+  /// Copy assignment is not permitted
+  Arena& operator=(const Arena&) = delete;
+
+  /// Destructor; releases all chunks. All containers using the arena
+  /// must be gone by this point.
+  ~Arena() = default;
+
+  /// Allocate bytes with the given alignment from the current chunk,
+  /// starting a new chunk when it does not fit
+  void* allocate(std::size_t bytes, std::size_t alignment)
+  {
+    if (!std::align(alignment, bytes, _free, _space))
+    {
+      // Start a new chunk large enough for this request
+      while (_chunk_size < bytes + alignment)
+        _chunk_size *= 2;
+      _chunks.emplace_back(std::make_unique<std::byte[]>(_chunk_size),
+                           _chunk_size);
+      _free = _chunks.back().first.get();
+      _space = _chunk_size;
+      if (_chunk_size < _max_chunk_size)
+        _chunk_size *= 2;
+      std::align(alignment, bytes, _free, _space);
+    }
+    void* p = _free;
+    _free = static_cast<std::byte*>(_free) + bytes;
+    _space -= bytes;
+    return p;
+  }
+
+  /// Drop all allocations, keeping the most recent (largest) chunk for
+  /// reuse. Only valid when no container still uses the arena.
+  void reset()
+  {
+    if (_chunks.size() > 1)
+      _chunks.erase(_chunks.begin(), _chunks.end() - 1);
+    if (!_chunks.empty())
+    {
+      _free = _chunks.back().first.get();
+      _space = _chunks.back().second;
+    }
+  }
+
+private:
+  static constexpr std::size_t _max_chunk_size = 1 << 26;
+
+  std::size_t _chunk_size;
+
+  // Chunks and their sizes, in allocation order
+  std::vector<std::pair<std::unique_ptr<std::byte[]>, std::size_t>> _chunks;
+
+  // Bump pointer and remaining space in the current chunk
+  void* _free;
+  std::size_t _space;
+};
+
+/// Standard-library allocator adapter for an Arena, usable with
+/// std::vector, std::map, boost::unordered_map etc. Deallocation is a
+/// no-op; the memory is reclaimed when the arena is destroyed or
+/// reset.
+template <typename T>
+class ArenaAllocator
+{
+public:
+  /// Value type, for the allocator requirements
+  using value_type = T;
+
+  /// Create an allocator drawing from an arena, which must outlive
+  /// every container using the allocator
+  /// @param[in] arena The arena to allocate from
+  ArenaAllocator(Arena& arena) : _arena(&arena) {}
+
+  /// Rebinding copy constructor
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena())
+  {
+  }
+
+  /// Allocate storage for n objects from the arena
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  /// No-op; the arena releases all memory at once
+  void deallocate(T*, std::size_t) {}
+
+  /// The underlying arena
+  Arena* arena() const { return _arena; }
+
+private:
+  Arena* _arena;
+};
+
+/// Allocators are interchangeable when they draw from the same arena
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+  return a.arena() == b.arena();
+}
+
+/// Inequality, in terms of equality
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+  return !(a == b);
+}
+} // namespace dolfinx::common
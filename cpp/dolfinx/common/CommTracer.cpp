@@ -0,0 +1,181 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CommTracer.h"
+#include "MPI.h"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <mutex>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+struct Event
+{
+  int phase;
+  int neighbor;
+  std::int64_t bytes;
+  double duration;
+};
+
+struct Trace
+{
+  std::mutex mutex;
+  bool enabled = false;
+
+  // Ring buffer of events; next is the slot the next event is written
+  // to and count the number of valid events (at most the capacity)
+  std::vector<Event> ring;
+  std::size_t next = 0;
+  std::size_t count = 0;
+
+  // Interned phase tags (events store an index) and the active tag
+  std::vector<std::string> phase_names;
+  std::string active_phase;
+};
+
+Trace& trace()
+{
+  static Trace t;
+  return t;
+}
+
+// Intern a phase tag, returning its index. Caller holds the lock.
+int intern_phase(Trace& t, const std::string& tag)
+{
+  const auto it
+      = std::find(t.phase_names.begin(), t.phase_names.end(), tag);
+  if (it != t.phase_names.end())
+    return std::distance(t.phase_names.begin(), it);
+  t.phase_names.push_back(tag);
+  return t.phase_names.size() - 1;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+CommTracer::Phase::Phase(const std::string& tag, bool replace_active)
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  _previous = t.active_phase;
+  if (replace_active or t.active_phase.empty())
+    t.active_phase = tag;
+}
+//-----------------------------------------------------------------------------
+CommTracer::Phase::~Phase()
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  t.active_phase = _previous;
+}
+//-----------------------------------------------------------------------------
+void CommTracer::enable(std::size_t capacity)
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  t.ring.assign(capacity, Event{0, 0, 0, 0.0});
+  t.next = 0;
+  t.count = 0;
+  t.phase_names.clear();
+  t.enabled = true;
+}
+//-----------------------------------------------------------------------------
+void CommTracer::disable()
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  t.enabled = false;
+}
+//-----------------------------------------------------------------------------
+bool CommTracer::enabled()
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  return t.enabled;
+}
+//-----------------------------------------------------------------------------
+void CommTracer::record(int neighbor, std::int64_t bytes, double duration)
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  if (!t.enabled or t.ring.empty())
+    return;
+
+  const int phase
+      = intern_phase(t, t.active_phase.empty() ? "untagged" : t.active_phase);
+  t.ring[t.next] = {phase, neighbor, bytes, duration};
+  t.next = (t.next + 1) % t.ring.size();
+  t.count = std::min(t.count + 1, t.ring.size());
+}
+//-----------------------------------------------------------------------------
+std::vector<std::string> CommTracer::phases()
+{
+  Trace& t = trace();
+  std::lock_guard<std::mutex> lock(t.mutex);
+  return t.phase_names;
+}
+//-----------------------------------------------------------------------------
+Table CommTracer::matrix(MPI_Comm comm, const std::string& phase)
+{
+  // Accumulate this rank's bytes per neighbour for the phase
+  std::map<int, std::int64_t> bytes;
+  {
+    Trace& t = trace();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    const auto it
+        = std::find(t.phase_names.begin(), t.phase_names.end(), phase);
+    if (it != t.phase_names.end())
+    {
+      const int p = std::distance(t.phase_names.begin(), it);
+      for (std::size_t e = 0; e < t.count; ++e)
+      {
+        if (t.ring[e].phase == p)
+          bytes[t.ring[e].neighbor] += t.ring[e].bytes;
+      }
+    }
+  }
+
+  // Each rank fills its own row; the reduction merges the rows (the
+  // maximum is a union, since no other rank sets this rank's entries)
+  const int rank = MPI::rank(comm);
+  Table table("Communication matrix: " + phase);
+  for (const auto& [neighbor, b] : bytes)
+    table.set("rank " + std::to_string(rank), "rank " + std::to_string(neighbor),
+              double(b));
+
+  return table.reduce(comm, Table::Reduction::max);
+}
+//-----------------------------------------------------------------------------
+Table CommTracer::summary(MPI_Comm comm)
+{
+  // Per-phase totals on this rank
+  std::map<std::string, std::array<double, 3>> totals;
+  {
+    Trace& t = trace();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    for (std::size_t e = 0; e < t.count; ++e)
+    {
+      std::array<double, 3>& s = totals[t.phase_names[t.ring[e].phase]];
+      s[0] += 1.0;
+      s[1] += double(t.ring[e].bytes);
+      s[2] += t.ring[e].duration;
+    }
+  }
+
+  Table table("Communication phases");
+  for (const auto& [phase, s] : totals)
+  {
+    table.set(phase, "events", s[0]);
+    table.set(phase, "bytes", s[1]);
+    table.set(phase, "time (s)", s[2]);
+  }
+
+  return table.reduce(comm, Table::Reduction::max);
+}
+//-----------------------------------------------------------------------------
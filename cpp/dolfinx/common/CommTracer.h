@@ -0,0 +1,107 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/common/Table.h>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+namespace dolfinx::common
+{
+
+/// Lightweight tracer for MPI communication. When enabled, the
+/// instrumented communication paths (scatter of ghost values, the
+/// all-to-all exchanges of mesh distribution, the assembly stash
+/// exchange) record one event per message into a fixed-size per-rank
+/// ring buffer: the active phase tag, the neighbour rank, the number
+/// of bytes moved and the duration of the carrying MPI call. The
+/// events can then be merged into a communication matrix per named
+/// phase, showing which phase degrades at scale without re-running
+/// under a heavyweight profiler.
+///
+/// Recording is off by default and the per-event cost when enabled is
+/// a few stores, so the instrumentation can stay in production code.
+/// A collective carrying several messages attributes its duration to
+/// the first message it records (and zero to the others), so that
+/// per-phase times add up to wall time spent communicating.
+///
+/// Usage:
+///
+///   CommTracer::enable();
+///   {
+///     CommTracer::Phase phase("mesh distribution");
+///     ...   // instrumented communication records under this tag
+///   }
+///   std::cout << CommTracer::matrix(comm, "mesh distribution").str();
+
+class CommTracer
+{
+public:
+  /// Scoped phase tag. Sets the phase that events record under and
+  /// restores the previous phase on destruction, so phases nest.
+  class Phase
+  {
+  public:
+    /// Set the active phase tag
+    /// @param[in] tag Phase name, as shown in the reports
+    /// @param[in] replace_active If false, an already active phase is
+    ///     kept and the tag is only a fallback. Used by generic
+    ///     communication paths (e.g. the ghost scatter) so that
+    ///     calls made from inside a tagged phase count towards it.
+    explicit Phase(const std::string& tag, bool replace_active = true);
+
+    /// Restore the previous phase
+    ~Phase();
+
+    // Phases are strictly scoped
+    Phase(const Phase&) = delete;
+    Phase& operator=(const Phase&) = delete;
+
+  private:
+    std::string _previous;
+  };
+
+  /// Start recording events, clearing any previous trace
+  /// @param[in] capacity Ring buffer capacity (events per rank); when
+  ///     full, the oldest events are overwritten
+  static void enable(std::size_t capacity = 65536);
+
+  /// Stop recording. The recorded events are kept for reporting.
+  static void disable();
+
+  /// Whether recording is active
+  static bool enabled();
+
+  /// Record one message under the active phase. Called by the
+  /// instrumented communication paths; cheap no-op when disabled.
+  /// @param[in] neighbor Rank of the communication partner
+  /// @param[in] bytes Number of bytes sent plus received
+  /// @param[in] duration Wall time (s) of the carrying MPI call
+  static void record(int neighbor, std::int64_t bytes, double duration);
+
+  /// Names of the phases with recorded events on this rank
+  static std::vector<std::string> phases();
+
+  /// Merged communication matrix for a phase: row "rank i", column
+  /// "rank j" holds the bytes rank i moved to/from rank j in that
+  /// phase. Each rank contributes its own row; entries for rank pairs
+  /// that did not communicate are absent. Collective.
+  /// @param[in] comm MPI communicator to merge over
+  /// @param[in] phase The phase tag
+  /// @return The merged matrix (complete on rank 0)
+  static Table matrix(MPI_Comm comm, const std::string& phase);
+
+  /// Per-phase totals merged over the communicator: number of events,
+  /// bytes moved and time spent, with the maximum over the ranks.
+  /// Collective.
+  /// @param[in] comm MPI communicator to merge over
+  /// @return Summary table (complete on rank 0)
+  static Table summary(MPI_Comm comm);
+};
+} // namespace dolfinx::common
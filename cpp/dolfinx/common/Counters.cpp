@@ -0,0 +1,116 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Counters.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <variant>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::string> names;
+  // Deque keeps the atomics at stable addresses while counters are
+  // registered
+  std::deque<std::atomic<std::int64_t>> values;
+};
+
+Registry& registry()
+{
+  static Registry r;
+  return r;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+int Counters::register_counter(const std::string& name)
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  const auto it = std::find(r.names.begin(), r.names.end(), name);
+  if (it != r.names.end())
+    return std::distance(r.names.begin(), it);
+  r.names.push_back(name);
+  r.values.emplace_back(0);
+  return r.names.size() - 1;
+}
+//-----------------------------------------------------------------------------
+void Counters::add(int counter, std::int64_t value)
+{
+  registry().values[counter].fetch_add(value, std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+std::int64_t Counters::value(int counter)
+{
+  return registry().values[counter].load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+Table Counters::summary(MPI_Comm mpi_comm)
+{
+  Registry& r = registry();
+  std::vector<std::string> names;
+  std::vector<double> local;
+  {
+    std::lock_guard<std::mutex> lock(r.mutex);
+    names = r.names;
+    for (std::size_t i = 0; i < names.size(); ++i)
+      local.push_back(double(r.values[i].load(std::memory_order_relaxed)));
+  }
+
+  // All processes register the same counters in the same order, so
+  // element-wise reductions line up
+  std::vector<double> sum(local), max(local), min(local);
+  MPI_Allreduce(MPI_IN_PLACE, sum.data(), sum.size(), MPI_DOUBLE, MPI_SUM,
+                mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, max.data(), max.size(), MPI_DOUBLE, MPI_MAX,
+                mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, min.data(), min.size(), MPI_DOUBLE, MPI_MIN,
+                mpi_comm);
+
+  Table table("Summary of counters");
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    table.set(names[i], "local", local[i]);
+    table.set(names[i], "sum", sum[i]);
+    table.set(names[i], "max", max[i]);
+    table.set(names[i], "min", min[i]);
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+std::string Counters::json()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::string s = "{";
+  for (std::size_t i = 0; i < r.names.size(); ++i)
+  {
+    if (i > 0)
+      s += ", ";
+    s += "\"" + r.names[i]
+         + "\": " + std::to_string(r.values[i].load(std::memory_order_relaxed));
+  }
+  s += "}";
+  return s;
+}
+//-----------------------------------------------------------------------------
+void Counters::reset()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (std::atomic<std::int64_t>& v : r.values)
+    v.store(0, std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
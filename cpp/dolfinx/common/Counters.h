@@ -0,0 +1,61 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/common/Table.h>
+#include <mpi.h>
+#include <string>
+
+namespace dolfinx::common
+{
+
+/// Registry of runtime throughput counters, complementing the wall
+/// timers: bytes moved through halo exchange, cells assembled, bytes
+/// written to disk. Counters are registered once by name and
+/// incremented by integer id with a relaxed atomic add, cheap enough
+/// for hot loops and communication paths in production. The totals
+/// can be reported as an MPI-reduced Table alongside the timing
+/// tables, or dumped as JSON for a monitoring pipeline.
+///
+/// Usage:
+///
+///   static const int counter = Counters::register_counter("foo bytes");
+///   Counters::add(counter, num_bytes);
+
+class Counters
+{
+public:
+  /// Intern a counter name, returning the id to increment. Thread-safe
+  /// but not cheap; call once at setup (e.g. into a function-local
+  /// static), not in the hot loop.
+  /// @param[in] name The counter name, as shown in the summary
+  /// @return Counter id for add()
+  static int register_counter(const std::string& name);
+
+  /// Add a value to a counter (relaxed atomic increment)
+  /// @param[in] counter Counter id from register_counter
+  /// @param[in] value Amount to add
+  static void add(int counter, std::int64_t value);
+
+  /// Current value of a counter on this process
+  /// @param[in] counter Counter id from register_counter
+  static std::int64_t value(int counter);
+
+  /// Summary of all counters as a Table with the per-process value and
+  /// the sum, maximum and minimum over the communicator. Collective.
+  /// @param[in] mpi_comm MPI communicator to reduce over
+  static Table summary(MPI_Comm mpi_comm);
+
+  /// Machine-readable dump of the counters on this process, as a JSON
+  /// object mapping counter names to values
+  static std::string json();
+
+  /// Reset all counters on this process to zero
+  static void reset();
+};
+} // namespace dolfinx::common
@@ -5,6 +5,8 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "IndexMap.h"
+#include "CommTracer.h"
+#include "Counters.h"
 #include <algorithm>
 #include <numeric>
 
@@ -325,6 +327,18 @@ IndexMap::IndexMap(
     disp[np] += 1;
   }
 
+  // Detect whether the ghosts are grouped by owning neighbour, which
+  // allows the scatter pack/unpack loops to be bypassed
+  _ghosts_grouped = std::is_sorted(_ghost_owners.data(),
+                                   _ghost_owners.data() + _ghost_owners.size());
+
+  // Cache the owning rank on the global communicator for each ghost, so
+  // ghost_owners() can return a view without re-building the
+  // neighbourhood communicator
+  _ghost_owner_rank.resize(_ghost_owners.size());
+  for (Eigen::Index i = 0; i < _ghost_owners.size(); ++i)
+    _ghost_owner_rank[i] = _neighbours[_ghost_owners[i]];
+
   //  May have repeated shared indices with different processes
   std::vector<std::int32_t> indices_in(disp_in.back());
   MPI_Neighbor_alltoallv(
@@ -428,64 +442,13 @@ std::vector<std::int32_t> IndexMap::global_to_local(
         indices,
     bool blocked) const
 {
-  const std::int32_t local_size = _local_range[1] - _local_range[0];
-
-  std::vector<std::pair<std::int64_t, std::int32_t>> global_local_ghosts;
-  for (Eigen::Index i = 0; i < _ghosts.rows(); ++i)
-    global_local_ghosts.emplace_back(_ghosts[i], i + local_size);
-  std::map<std::int64_t, std::int32_t> global_to_local(
-      global_local_ghosts.begin(), global_local_ghosts.end());
-
-  const int bs = blocked ? 1 : _block_size;
-  std::vector<std::int32_t> local;
-  const std::array<std::int64_t, 2> range = this->local_range();
-  for (Eigen::Index i = 0; i < indices.size(); ++i)
-  {
-    const std::int64_t index = indices[i];
-    if (index >= bs * range[0] and index < bs * range[1])
-      local.push_back(index - bs * range[0]);
-    else
-    {
-      const std::int64_t index_block = index / bs;
-      if (auto it = global_to_local.find(index_block);
-          it != global_to_local.end())
-      {
-        local.push_back(it->second * bs + index % bs);
-      }
-      else
-        local.push_back(-1);
-    }
-  }
-
-  return local;
+  return GlobalToLocal(*this)(indices, blocked);
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<std::int32_t, Eigen::Dynamic, 1> IndexMap::ghost_owners() const
+const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>&
+IndexMap::ghost_owners() const
 {
-  MPI_Comm neighbour_comm;
-  MPI_Dist_graph_create_adjacent(
-      _mpi_comm.comm(), _neighbours.size(), _neighbours.data(), MPI_UNWEIGHTED,
-      _neighbours.size(), _neighbours.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
-      false, &neighbour_comm);
-
-  int indegree(-1), outdegree(-2), weighted(-1);
-  MPI_Dist_graph_neighbors_count(neighbour_comm, &indegree, &outdegree,
-                                 &weighted);
-  assert(indegree == outdegree);
-  std::vector<int> neighbours(indegree), neighbours1(indegree);
-
-  MPI_Dist_graph_neighbors(neighbour_comm, indegree, neighbours.data(),
-                           MPI_UNWEIGHTED, outdegree, neighbours1.data(),
-                           MPI_UNWEIGHTED);
-
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> proc_owners(
-      _ghost_owners.size());
-  for (int i = 0; i < proc_owners.size(); ++i)
-    proc_owners[i] = neighbours[_ghost_owners[i]];
-
-  MPI_Comm_free(&neighbour_comm);
-
-  return proc_owners;
+  return _ghost_owner_rank;
 }
 //----------------------------------------------------------------------------
 Eigen::Array<std::int64_t, Eigen::Dynamic, 1>
@@ -571,8 +534,7 @@ std::map<int, std::set<int>> IndexMap::compute_shared_indices() const
       neighbour_comm, fwd_sharing_offsets, fwd_sharing_data);
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> recv_sharing_offsets
       = sharing.offsets();
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& recv_sharing_data
-      = sharing.array();
+  const auto recv_sharing_data = sharing.array();
 
   // FIXME: The below is confusing and the std::set<int> inside the loop
   // should be avoided
@@ -628,6 +590,33 @@ IndexMap::scatter_fwd(const std::vector<std::int32_t>& local_data, int n) const
   return remote_data;
 }
 //-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(const std::vector<float>& local_data,
+                           std::vector<float>& remote_data, int n) const
+{
+  scatter_fwd_impl(local_data, remote_data, n);
+}
+//-----------------------------------------------------------------------------
+std::vector<float> IndexMap::scatter_fwd(const std::vector<float>& local_data,
+                                         int n) const
+{
+  std::vector<float> remote_data;
+  scatter_fwd_impl(local_data, remote_data, n);
+  return remote_data;
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(const std::vector<double>& local_data,
+                           std::vector<double>& remote_data, int n) const
+{
+  scatter_fwd_impl(local_data, remote_data, n);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(const std::vector<std::complex<double>>& local_data,
+                           std::vector<std::complex<double>>& remote_data,
+                           int n) const
+{
+  scatter_fwd_impl(local_data, remote_data, n);
+}
+//-----------------------------------------------------------------------------
 void IndexMap::scatter_rev(std::vector<std::int64_t>& local_data,
                            const std::vector<std::int64_t>& remote_data, int n,
                            IndexMap::Mode op) const
@@ -642,6 +631,27 @@ void IndexMap::scatter_rev(std::vector<std::int32_t>& local_data,
   scatter_rev_impl(local_data, remote_data, n, op);
 }
 //-----------------------------------------------------------------------------
+void IndexMap::scatter_rev(std::vector<float>& local_data,
+                           const std::vector<float>& remote_data, int n,
+                           IndexMap::Mode op) const
+{
+  scatter_rev_impl(local_data, remote_data, n, op);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_rev(std::vector<double>& local_data,
+                           const std::vector<double>& remote_data, int n,
+                           IndexMap::Mode op) const
+{
+  scatter_rev_impl(local_data, remote_data, n, op);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_rev(std::vector<std::complex<double>>& local_data,
+                           const std::vector<std::complex<double>>& remote_data,
+                           int n, IndexMap::Mode op) const
+{
+  scatter_rev_impl(local_data, remote_data, n, op);
+}
+//-----------------------------------------------------------------------------
 template <typename T>
 void IndexMap::scatter_fwd_impl(const std::vector<T>& local_data,
                                 std::vector<T>& remote_data, int n) const
@@ -690,21 +700,55 @@ void IndexMap::scatter_fwd_impl(const std::vector<T>& local_data,
       data_to_send[i * n + j] = local_data[index * n + j];
   }
 
-  // Send/receive data
-  std::vector<T> data_to_recv(displs_recv.back());
-  MPI_Neighbor_alltoallv(
-      data_to_send.data(), sizes_send.data(), displs_send.data(),
-      MPI::mpi_type<T>(), data_to_recv.data(), sizes_recv.data(),
-      displs_recv.data(), MPI::mpi_type<T>(), neighbour_comm);
+  // Send/receive data. When the ghosts are grouped by owning
+  // neighbour the data arrives in ghost order, so receive directly
+  // into the ghost buffer and skip the unpack loop below.
+  std::vector<T> data_to_recv;
+  T* recv_buffer;
+  if (_ghosts_grouped)
+    recv_buffer = remote_data.data();
+  else
+  {
+    data_to_recv.resize(displs_recv.back());
+    recv_buffer = data_to_recv.data();
+  }
+  const double t0 = MPI_Wtime();
+  MPI_Neighbor_alltoallv(data_to_send.data(), sizes_send.data(),
+                         displs_send.data(), MPI::mpi_type<T>(), recv_buffer,
+                         sizes_recv.data(), displs_recv.data(),
+                         MPI::mpi_type<T>(), neighbour_comm);
+
+  static const int counter = Counters::register_counter("scatter bytes");
+  Counters::add(counter, sizeof(T)
+                             * (displs_send.back() + displs_recv.back()));
+  if (CommTracer::enabled())
+  {
+    // Tag as "scatter" unless a more specific phase is active
+    CommTracer::Phase phase("scatter", false);
+    double duration = MPI_Wtime() - t0;
+    for (int i = 0; i < num_neighbours; ++i)
+    {
+      if (sizes_send[i] + sizes_recv[i] > 0)
+      {
+        CommTracer::record(_neighbours[i],
+                           sizeof(T) * (sizes_send[i] + sizes_recv[i]),
+                           duration);
+        duration = 0.0;
+      }
+    }
+  }
 
   // Copy into ghost area ("remote_data")
-  std::vector<std::int32_t> displs(displs_recv);
-  for (int i = 0; i < _ghosts.size(); ++i)
+  if (not _ghosts_grouped)
   {
-    const int np = _ghost_owners[i];
-    for (int j = 0; j < n; ++j)
-      remote_data[i * n + j] = data_to_recv[displs[np] + j];
-    displs[np] += n;
+    std::vector<std::int32_t> displs(displs_recv);
+    for (int i = 0; i < _ghosts.size(); ++i)
+    {
+      const int np = _ghost_owners[i];
+      for (int j = 0; j < n; ++j)
+        remote_data[i * n + j] = data_to_recv[displs[np] + j];
+      displs[np] += n;
+    }
   }
 
   MPI_Comm_free(&neighbour_comm);
@@ -750,23 +794,54 @@ void IndexMap::scatter_rev_impl(std::vector<T>& local_data,
     displs_recv[i + 1] = displs_recv[i] + recv_sizes[i];
   }
 
-  // Fill sending data
-  std::vector<T> send_data(displs_send.back());
-  std::vector<std::int32_t> displs(displs_send);
-  for (std::int32_t i = 0; i < _ghosts.size(); ++i)
+  // Fill sending data. When the ghosts are grouped by owning
+  // neighbour, the ghost buffer is already in send order and is used
+  // directly.
+  std::vector<T> send_data;
+  const T* send_buffer;
+  if (_ghosts_grouped)
+    send_buffer = remote_data.data();
+  else
   {
-    const int np = _ghost_owners[i];
-    for (std::int32_t j = 0; j < n; ++j)
-      send_data[displs[np] + j] = remote_data[i * n + j];
-    displs[np] += n;
+    send_data.resize(displs_send.back());
+    std::vector<std::int32_t> displs(displs_send);
+    for (std::int32_t i = 0; i < _ghosts.size(); ++i)
+    {
+      const int np = _ghost_owners[i];
+      for (std::int32_t j = 0; j < n; ++j)
+        send_data[displs[np] + j] = remote_data[i * n + j];
+      displs[np] += n;
+    }
+    send_buffer = send_data.data();
   }
 
   // Send and receive data
   std::vector<T> recv_data(displs_recv.back());
-  MPI_Neighbor_alltoallv(
-      send_data.data(), send_sizes.data(), displs_send.data(),
-      MPI::mpi_type<T>(), recv_data.data(), recv_sizes.data(),
-      displs_recv.data(), MPI::mpi_type<T>(), neighbour_comm);
+  const double t0 = MPI_Wtime();
+  MPI_Neighbor_alltoallv(send_buffer, send_sizes.data(), displs_send.data(),
+                         MPI::mpi_type<T>(), recv_data.data(),
+                         recv_sizes.data(), displs_recv.data(),
+                         MPI::mpi_type<T>(), neighbour_comm);
+
+  static const int counter = Counters::register_counter("scatter bytes");
+  Counters::add(counter, sizeof(T)
+                             * (displs_send.back() + displs_recv.back()));
+  if (CommTracer::enabled())
+  {
+    // Tag as "scatter" unless a more specific phase is active
+    CommTracer::Phase phase("scatter", false);
+    double duration = MPI_Wtime() - t0;
+    for (int i = 0; i < num_neighbours; ++i)
+    {
+      if (send_sizes[i] + recv_sizes[i] > 0)
+      {
+        CommTracer::record(_neighbours[i],
+                           sizeof(T) * (send_sizes[i] + recv_sizes[i]),
+                           duration);
+        duration = 0.0;
+      }
+    }
+  }
 
   // Copy or accumulate into "local_data"
   if (op == Mode::insert)
@@ -791,3 +866,40 @@ void IndexMap::scatter_rev_impl(std::vector<T>& local_data,
   MPI_Comm_free(&neighbour_comm);
 }
 //-----------------------------------------------------------------------------
+GlobalToLocal::GlobalToLocal(const IndexMap& map)
+    : _block_size(map.block_size()), _local_range(map.local_range())
+{
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts = map.ghosts();
+  const std::int32_t local_size = _local_range[1] - _local_range[0];
+  _ghosts.reserve(ghosts.rows());
+  for (Eigen::Index i = 0; i < ghosts.rows(); ++i)
+    _ghosts.emplace_back(ghosts[i], i + local_size);
+  std::sort(_ghosts.begin(), _ghosts.end());
+}
+//-----------------------------------------------------------------------------
+std::int32_t GlobalToLocal::operator()(std::int64_t index, bool blocked) const
+{
+  const int bs = blocked ? 1 : _block_size;
+  if (index >= bs * _local_range[0] and index < bs * _local_range[1])
+    return index - bs * _local_range[0];
+
+  const std::int64_t index_block = index / bs;
+  const auto it = std::lower_bound(
+      _ghosts.begin(), _ghosts.end(),
+      std::pair<std::int64_t, std::int32_t>(index_block, 0));
+  if (it != _ghosts.end() and it->first == index_block)
+    return it->second * bs + index % bs;
+  return -1;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> GlobalToLocal::operator()(
+    const Eigen::Ref<const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>>&
+        indices,
+    bool blocked) const
+{
+  std::vector<std::int32_t> local(indices.size());
+  for (Eigen::Index i = 0; i < indices.size(); ++i)
+    local[i] = (*this)(indices[i], blocked);
+  return local;
+}
+//-----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include <Eigen/Dense>
 #include <array>
+#include <complex>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <functional>
@@ -159,6 +160,10 @@ public:
       bool blocked = true) const;
 
   /// Global indices
+  ///
+  /// Note: this materializes a new array on every call. In
+  /// performance-sensitive loops prefer local_range() for owned indices
+  /// and ghosts() for ghost indices, which do not allocate.
   /// @return The global index for all local indices (0, 1, 2, ...) on this
   /// process, including ghosts
   std::vector<std::int64_t> global_indices(bool blocked = true) const;
@@ -172,11 +177,16 @@ public:
     return _forward_indices;
   }
 
-  /// Owner rank (on global communicator) of each ghost entry
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> ghost_owners() const;
+  /// Owner rank (on global communicator) of each ghost entry. The
+  /// array is computed at construction; this accessor is a view and
+  /// does not allocate or communicate.
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& ghost_owners() const;
 
   /// Return array of global indices for all indices on this process,
   /// including ghosts
+  ///
+  /// Note: this materializes a new array on every call. In
+  /// performance-sensitive loops prefer local_range() and ghosts().
   Eigen::Array<std::int64_t, Eigen::Dynamic, 1>
   indices(bool unroll_block) const;
 
@@ -241,6 +251,51 @@ public:
   std::vector<std::int32_t>
   scatter_fwd(const std::vector<std::int32_t>& local_data, int n) const;
 
+  /// Send n values for each index that is owned to processes that have
+  /// the index as a ghost. Single-precision variant for halo exchange
+  /// at half the message volume, e.g. for float32 sub-solves.
+  /// @param[in] local_data Local data associated with each owned local
+  ///   index to be sent to process where the data is ghosted. Size must
+  ///   be n * size_local().
+  /// @param[in,out] remote_data Ghost data on this process received
+  ///   from the owning process. Size will be n * num_ghosts().
+  /// @param[in] n Number of data items per index
+  void scatter_fwd(const std::vector<float>& local_data,
+                   std::vector<float>& remote_data, int n) const;
+
+  /// Send n values for each index that is owned to processes that have
+  /// the index as a ghost. Single-precision variant.
+  /// @param[in] local_data Local data associated with each owned local
+  ///   index to be sent to process where the data is ghosted. Size must
+  ///   be n * size_local().
+  /// @param[in] n Number of data items per index
+  /// @return Ghost data on this process received from the owning
+  ///   process. Size will be n * num_ghosts().
+  std::vector<float> scatter_fwd(const std::vector<float>& local_data,
+                                 int n) const;
+
+  /// Send n values for each index that is owned to processes that have
+  /// the index as a ghost. Double-precision variant.
+  /// @param[in] local_data Local data associated with each owned local
+  ///   index to be sent to process where the data is ghosted. Size must
+  ///   be n * size_local().
+  /// @param[in,out] remote_data Ghost data on this process received
+  ///   from the owning process. Size will be n * num_ghosts().
+  /// @param[in] n Number of data items per index
+  void scatter_fwd(const std::vector<double>& local_data,
+                   std::vector<double>& remote_data, int n) const;
+
+  /// Send n values for each index that is owned to processes that have
+  /// the index as a ghost. Complex variant.
+  /// @param[in] local_data Local data associated with each owned local
+  ///   index to be sent to process where the data is ghosted. Size must
+  ///   be n * size_local().
+  /// @param[in,out] remote_data Ghost data on this process received
+  ///   from the owning process. Size will be n * num_ghosts().
+  /// @param[in] n Number of data items per index
+  void scatter_fwd(const std::vector<std::complex<double>>& local_data,
+                   std::vector<std::complex<double>>& remote_data, int n) const;
+
   /// Send n values for each ghost index to owning to the process.
   /// @param[in,out] local_data Local data associated with each owned
   ///   local index to be sent to process where the data is ghosted.
@@ -265,6 +320,45 @@ public:
                    const std::vector<std::int32_t>& remote_data, int n,
                    IndexMap::Mode op) const;
 
+  /// Send n values for each ghost index to owning to the process.
+  /// Single-precision variant.
+  /// @param[in,out] local_data Local data associated with each owned
+  ///   local index to be sent to process where the data is ghosted.
+  ///   Size must be n * size_local().
+  /// @param[in] remote_data Ghost data on this process received from
+  ///   the owning process. Size will be n * num_ghosts().
+  /// @param[in] n Number of data items per index
+  /// @param[in] op Sum or set received values in local_data
+  void scatter_rev(std::vector<float>& local_data,
+                   const std::vector<float>& remote_data, int n,
+                   IndexMap::Mode op) const;
+
+  /// Send n values for each ghost index to owning to the process.
+  /// Double-precision variant.
+  /// @param[in,out] local_data Local data associated with each owned
+  ///   local index to be sent to process where the data is ghosted.
+  ///   Size must be n * size_local().
+  /// @param[in] remote_data Ghost data on this process received from
+  ///   the owning process. Size will be n * num_ghosts().
+  /// @param[in] n Number of data items per index
+  /// @param[in] op Sum or set received values in local_data
+  void scatter_rev(std::vector<double>& local_data,
+                   const std::vector<double>& remote_data, int n,
+                   IndexMap::Mode op) const;
+
+  /// Send n values for each ghost index to owning to the process.
+  /// Complex variant.
+  /// @param[in,out] local_data Local data associated with each owned
+  ///   local index to be sent to process where the data is ghosted.
+  ///   Size must be n * size_local().
+  /// @param[in] remote_data Ghost data on this process received from
+  ///   the owning process. Size will be n * num_ghosts().
+  /// @param[in] n Number of data items per index
+  /// @param[in] op Sum or set received values in local_data
+  void scatter_rev(std::vector<std::complex<double>>& local_data,
+                   const std::vector<std::complex<double>>& remote_data, int n,
+                   IndexMap::Mode op) const;
+
 private:
   int _block_size;
 
@@ -293,6 +387,11 @@ private:
   // Owning neighbour for each ghost index
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _ghost_owners;
 
+  // Owning rank on the global communicator for each ghost index
+  // (i.e. _ghost_owners translated through _neighbours), cached so
+  // ghost_owners() does not allocate per call
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _ghost_owner_rank;
+
   // Number of indices to send to each neighbour process (ghost ->
   // owner, i.e. forward mode scatter)
   std::vector<std::int32_t> _forward_sizes;
@@ -300,6 +399,15 @@ private:
   // "Owned" local indices shared with neighbour processes
   std::vector<std::int32_t> _forward_indices;
 
+  // True if the ghosts are grouped by owning neighbour (in
+  // neighbourhood rank order). Received scatter data then arrives in
+  // ghost order, so scatter_fwd can receive straight into the ghost
+  // buffer and scatter_rev can send from it, with no per-index
+  // pack/unpack. DofMapBuilder orders ghosts this way; the flag is
+  // detected at construction so maps built elsewhere still work
+  // through the general path.
+  bool _ghosts_grouped = true;
+
   template <typename T>
   void scatter_fwd_impl(const std::vector<T>& local_data,
                         std::vector<T>& remote_data, int n) const;
@@ -309,4 +417,46 @@ private:
                         Mode op) const;
 };
 
+/// Reusable global-to-local index translator for an IndexMap. Sorts
+/// the ghost indices once at construction and translates by binary
+/// search over the sorted array, so translating n indices against g
+/// ghosts costs O(n log g) with contiguous memory access. Use this
+/// instead of IndexMap::global_to_local when translating repeatedly
+/// against the same map, e.g. in dofmap and mesh construction loops.
+class GlobalToLocal
+{
+public:
+  /// Create a translator for an index map. Copies the ghost list; the
+  /// translator remains valid for its own lifetime.
+  /// @param[in] map The index map to translate against
+  explicit GlobalToLocal(const IndexMap& map);
+
+  /// Translate a single global index
+  /// @param[in] index Global index
+  /// @param[in] blocked If true work with blocked indices. If false
+  ///   the input index is not block-wise.
+  /// @return The local index, or -1 if the global index is neither
+  ///   owned nor ghosted on this process
+  std::int32_t operator()(std::int64_t index, bool blocked = true) const;
+
+  /// Translate a batch of global indices
+  /// @param[in] indices Global indices
+  /// @param[in] blocked If true work with blocked indices. If false
+  ///   the input indices are not block-wise.
+  /// @return The local index for each global index, with -1 for
+  ///   indices that are neither owned nor ghosted on this process
+  std::vector<std::int32_t> operator()(
+      const Eigen::Ref<const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>>&
+          indices,
+      bool blocked = true) const;
+
+private:
+  // Block size and owned (global) range of the map
+  int _block_size;
+  std::array<std::int64_t, 2> _local_range;
+
+  // Ghost (global, local) pairs sorted by global index
+  std::vector<std::pair<std::int64_t, std::int32_t>> _ghosts;
+};
+
 } // namespace dolfinx::common
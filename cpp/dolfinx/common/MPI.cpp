@@ -146,3 +146,27 @@ std::vector<int> dolfinx::MPI::neighbors(MPI_Comm neighbor_comm)
   return neighbors;
 }
 //-----------------------------------------------------------------------------
+MPI_Comm dolfinx::MPI::create_subcomm(MPI_Comm comm, bool has_data)
+{
+  // Split with the parent rank as key to keep the relative order
+  MPI_Comm subcomm = MPI_COMM_NULL;
+  MPI_Comm_split(comm, has_data ? 0 : MPI_UNDEFINED, MPI::rank(comm),
+                 &subcomm);
+  return subcomm;
+}
+//-----------------------------------------------------------------------------
+std::vector<int> dolfinx::MPI::translate_ranks(MPI_Comm comm_from,
+                                               MPI_Comm comm_to,
+                                               const std::vector<int>& ranks)
+{
+  MPI_Group group_from, group_to;
+  MPI_Comm_group(comm_from, &group_from);
+  MPI_Comm_group(comm_to, &group_to);
+  std::vector<int> ranks_to(ranks.size());
+  MPI_Group_translate_ranks(group_from, ranks.size(), ranks.data(), group_to,
+                            ranks_to.data());
+  MPI_Group_free(&group_from);
+  MPI_Group_free(&group_to);
+  return ranks_to;
+}
+//-----------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #include <cassert>
 #include <complex>
 #include <cstdint>
+#include <dolfinx/common/CommTracer.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <iostream>
 #include <numeric>
@@ -86,6 +87,28 @@ public:
   /// @param[in] neighbor_comm Neighborhood communicator
   static std::vector<int> neighbors(MPI_Comm neighbor_comm);
 
+  /// Create a sub-communicator containing only the ranks that hold
+  /// data, so that meshes and index maps of small sub-problems can be
+  /// built on it and their collectives do not involve idle ranks.
+  /// Collective over comm. Relative rank order is preserved. The
+  /// caller frees the returned communicator with MPI_Comm_free.
+  /// @param[in] comm The parent communicator
+  /// @param[in] has_data Whether the calling rank holds data of the
+  ///                     sub-problem
+  /// @return The sub-communicator on participating ranks,
+  ///         MPI_COMM_NULL elsewhere
+  static MPI_Comm create_subcomm(MPI_Comm comm, bool has_data);
+
+  /// Translate ranks from one communicator to another, e.g. between a
+  /// sub-communicator and its parent when coupling sub-problems back.
+  /// @param[in] comm_from Communicator the input ranks refer to
+  /// @param[in] comm_to Communicator to translate into
+  /// @param[in] ranks Ranks on comm_from
+  /// @return The corresponding ranks on comm_to, with MPI_UNDEFINED
+  ///         for ranks that are not in its group
+  static std::vector<int> translate_ranks(MPI_Comm comm_from, MPI_Comm comm_to,
+                                          const std::vector<int>& ranks);
+
   /// Find global offset (index) (wrapper for MPI_(Ex)Scan with MPI_SUM
   /// as reduction op)
   static std::size_t global_offset(MPI_Comm comm, std::size_t range,
@@ -118,6 +141,144 @@ public:
   }
 };
 
+/// Aggregated all-to-all exchange. Callers of MPI::all_to_all stage a
+/// fresh flat buffer per call, and mesh distribution performs several
+/// such exchanges with many tiny per-destination messages. The builder
+/// accumulates any number of logical messages in an arena that is
+/// reused (capacity kept) across exchanges, combines them into a
+/// single data movement per call to exchange(), and picks the
+/// transport from the message census: a dense MPI_Alltoallv when most
+/// rank pairs communicate, nonblocking point-to-point when fewer than
+/// 5% do, which avoids scanning empty slots on large communicators.
+template <typename T>
+class AllToAllBuilder
+{
+public:
+  /// Create a builder for a communicator
+  /// @param[in] comm The communicator to exchange over
+  explicit AllToAllBuilder(MPI_Comm comm)
+      : _comm(comm), _size(MPI::size(comm)), _msg_offset(1, 0)
+  {
+  }
+
+  /// Append a logical message for a destination rank. Messages for the
+  /// same rank are concatenated in the order they are appended.
+  /// @param[in] dest Destination rank
+  /// @param[in] data Values to send
+  void append(int dest, const std::vector<T>& data)
+  {
+    assert(dest >= 0 and dest < _size);
+    _msg_dest.push_back(dest);
+    _arena.insert(_arena.end(), data.begin(), data.end());
+    _msg_offset.push_back(_arena.size());
+  }
+
+  /// Perform the aggregated exchange and reset the builder for reuse.
+  /// Collective over the communicator; every rank must call it the
+  /// same number of times.
+  /// @return Received data, grouped by source rank
+  graph::AdjacencyList<T> exchange()
+  {
+    // Group the staged messages by destination
+    std::vector<int> send_size(_size, 0);
+    for (std::size_t m = 0; m < _msg_dest.size(); ++m)
+      send_size[_msg_dest[m]] += _msg_offset[m + 1] - _msg_offset[m];
+    std::vector<int> send_offset(_size + 1, 0);
+    std::partial_sum(send_size.begin(), send_size.end(),
+                     send_offset.begin() + 1);
+    _send_buffer.resize(_arena.size());
+    {
+      std::vector<int> pos(send_offset.begin(), send_offset.end() - 1);
+      for (std::size_t m = 0; m < _msg_dest.size(); ++m)
+      {
+        std::copy(_arena.begin() + _msg_offset[m],
+                  _arena.begin() + _msg_offset[m + 1],
+                  _send_buffer.begin() + pos[_msg_dest[m]]);
+        pos[_msg_dest[m]] += _msg_offset[m + 1] - _msg_offset[m];
+      }
+    }
+
+    // Message census: sizes for the receive side, and the global
+    // number of non-empty rank pairs for the transport selection
+    std::vector<int> recv_size(_size);
+    MPI_Alltoall(send_size.data(), 1, MPI::mpi_type<int>(), recv_size.data(),
+                 1, MPI::mpi_type<int>(), _comm);
+    std::int64_t num_msgs
+        = std::count_if(send_size.begin(), send_size.end(),
+                        [](int s) { return s > 0; });
+    MPI_Allreduce(MPI_IN_PLACE, &num_msgs, 1, MPI_INT64_T, MPI_SUM, _comm);
+
+    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> recv_offset(_size + 1);
+    recv_offset(0) = 0;
+    std::partial_sum(recv_size.begin(), recv_size.end(),
+                     recv_offset.data() + 1);
+    Eigen::Array<T, Eigen::Dynamic, 1> recv_values(recv_offset(_size));
+
+    const double t0 = MPI_Wtime();
+    if (20 * num_msgs < std::int64_t(_size) * _size)
+    {
+      // Sparse pattern: exchange only the non-empty pairs
+      std::vector<MPI_Request> requests;
+      for (int p = 0; p < _size; ++p)
+      {
+        if (recv_size[p] > 0)
+        {
+          requests.push_back(MPI_REQUEST_NULL);
+          MPI_Irecv(recv_values.data() + recv_offset(p), recv_size[p],
+                    MPI::mpi_type<T>(), p, 0, _comm, &requests.back());
+        }
+        if (send_size[p] > 0)
+        {
+          requests.push_back(MPI_REQUEST_NULL);
+          MPI_Isend(_send_buffer.data() + send_offset[p], send_size[p],
+                    MPI::mpi_type<T>(), p, 0, _comm, &requests.back());
+        }
+      }
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+    else
+    {
+      MPI_Alltoallv(_send_buffer.data(), send_size.data(), send_offset.data(),
+                    MPI::mpi_type<T>(), recv_values.data(), recv_size.data(),
+                    recv_offset.data(), MPI::mpi_type<T>(), _comm);
+    }
+    if (common::CommTracer::enabled())
+    {
+      double duration = MPI_Wtime() - t0;
+      for (int p = 0; p < _size; ++p)
+      {
+        if (send_size[p] + recv_size[p] > 0)
+        {
+          common::CommTracer::record(
+              p, sizeof(T) * (send_size[p] + recv_size[p]), duration);
+          duration = 0.0;
+        }
+      }
+    }
+
+    // Reset the staging, keeping the arena capacity for the next round
+    _msg_dest.clear();
+    _msg_offset.resize(1);
+    _arena.clear();
+
+    return graph::AdjacencyList<T>(std::move(recv_values),
+                                   std::move(recv_offset));
+  }
+
+private:
+  MPI_Comm _comm;
+  int _size;
+
+  // Staged messages: values back to back in the arena, with the
+  // destination and arena extent of each message
+  std::vector<T> _arena;
+  std::vector<int> _msg_dest;
+  std::vector<int> _msg_offset;
+
+  // Send buffer grouped by destination, reused across exchanges
+  std::vector<T> _send_buffer;
+};
+
 // Turn off doxygen for these template specialisations
 /// @cond
 // Specialisations for MPI_Datatypes
@@ -183,9 +344,8 @@ graph::AdjacencyList<T>
 dolfinx::MPI::all_to_all(MPI_Comm comm,
                          const graph::AdjacencyList<T>& send_data)
 {
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& send_offsets
-      = send_data.offsets();
-  const Eigen::Array<T, Eigen::Dynamic, 1>& values_in = send_data.array();
+  const auto send_offsets = send_data.offsets();
+  const auto values_in = send_data.array();
 
   const int comm_size = MPI::size(comm);
   assert(send_data.num_nodes() == comm_size);
@@ -208,9 +368,23 @@ dolfinx::MPI::all_to_all(MPI_Comm comm,
 
   // Send/receive data
   Eigen::Array<T, Eigen::Dynamic, 1> recv_values(recv_offset(comm_size));
+  const double t0 = MPI_Wtime();
   MPI_Alltoallv(values_in.data(), send_size.data(), send_offsets.data(),
                 mpi_type<T>(), recv_values.data(), recv_size.data(),
                 recv_offset.data(), mpi_type<T>(), comm);
+  if (common::CommTracer::enabled())
+  {
+    double duration = MPI_Wtime() - t0;
+    for (int p = 0; p < comm_size; ++p)
+    {
+      if (send_size[p] + recv_size[p] > 0)
+      {
+        common::CommTracer::record(
+            p, sizeof(T) * (send_size[p] + recv_size[p]), duration);
+        duration = 0.0;
+      }
+    }
+  }
 
   return graph::AdjacencyList<T>(std::move(recv_values),
                                  std::move(recv_offset));
@@ -0,0 +1,177 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MemoryRegistry.h"
+#include "MPI.h"
+#include "log.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::string> names;
+  // Deque keeps the atomics at stable addresses while subsystems are
+  // registered
+  std::deque<std::atomic<std::int64_t>> values;
+  std::atomic<std::int64_t> total{0};
+  std::atomic<std::int64_t> threshold{0};
+};
+
+Registry& registry()
+{
+  static Registry r;
+  return r;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+MemoryRegistry::Usage::Usage(const std::string& subsystem)
+    : _subsystem(register_subsystem(subsystem)), _bytes(0)
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+MemoryRegistry::Usage::Usage(const Usage& usage)
+    : _subsystem(usage._subsystem), _bytes(usage._bytes)
+{
+  add(_subsystem, _bytes);
+}
+//-----------------------------------------------------------------------------
+MemoryRegistry::Usage::Usage(Usage&& usage) noexcept
+    : _subsystem(usage._subsystem), _bytes(usage._bytes)
+{
+  usage._bytes = 0;
+}
+//-----------------------------------------------------------------------------
+MemoryRegistry::Usage& MemoryRegistry::Usage::operator=(const Usage& usage)
+{
+  add(_subsystem, -_bytes);
+  _subsystem = usage._subsystem;
+  _bytes = usage._bytes;
+  add(_subsystem, _bytes);
+  return *this;
+}
+//-----------------------------------------------------------------------------
+MemoryRegistry::Usage&
+MemoryRegistry::Usage::operator=(Usage&& usage) noexcept
+{
+  add(_subsystem, -_bytes);
+  _subsystem = usage._subsystem;
+  _bytes = usage._bytes;
+  usage._bytes = 0;
+  return *this;
+}
+//-----------------------------------------------------------------------------
+MemoryRegistry::Usage::~Usage() { add(_subsystem, -_bytes); }
+//-----------------------------------------------------------------------------
+void MemoryRegistry::Usage::update(std::int64_t bytes)
+{
+  add(_subsystem, bytes - _bytes);
+  _bytes = bytes;
+}
+//-----------------------------------------------------------------------------
+int MemoryRegistry::register_subsystem(const std::string& name)
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  const auto it = std::find(r.names.begin(), r.names.end(), name);
+  if (it != r.names.end())
+    return std::distance(r.names.begin(), it);
+  r.names.push_back(name);
+  r.values.emplace_back(0);
+  return r.names.size() - 1;
+}
+//-----------------------------------------------------------------------------
+void MemoryRegistry::add(int subsystem, std::int64_t bytes)
+{
+  Registry& r = registry();
+  r.values[subsystem].fetch_add(bytes, std::memory_order_relaxed);
+  const std::int64_t total
+      = r.total.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+  // Warn once per upward crossing of the threshold
+  const std::int64_t threshold = r.threshold.load(std::memory_order_relaxed);
+  if (threshold > 0 and total >= threshold and total - bytes < threshold)
+  {
+    LOG(WARNING) << "Registered memory usage (" << total
+                 << " bytes) crossed the warning threshold (" << threshold
+                 << " bytes): " << json();
+  }
+}
+//-----------------------------------------------------------------------------
+std::int64_t MemoryRegistry::bytes(int subsystem)
+{
+  return registry().values[subsystem].load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+std::int64_t MemoryRegistry::total_bytes()
+{
+  return registry().total.load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+void MemoryRegistry::set_warning_threshold(std::int64_t bytes)
+{
+  registry().threshold.store(bytes, std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+Table MemoryRegistry::summary(MPI_Comm mpi_comm)
+{
+  Registry& r = registry();
+  std::vector<std::string> names;
+  std::vector<double> local;
+  {
+    std::lock_guard<std::mutex> lock(r.mutex);
+    names = r.names;
+    for (std::size_t i = 0; i < names.size(); ++i)
+      local.push_back(double(r.values[i].load(std::memory_order_relaxed)));
+  }
+
+  // All processes register the same subsystems in the same order, so
+  // element-wise reductions line up
+  std::vector<double> sum(local), max(local);
+  MPI_Allreduce(MPI_IN_PLACE, sum.data(), sum.size(), MPI_DOUBLE, MPI_SUM,
+                mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, max.data(), max.size(), MPI_DOUBLE, MPI_MAX,
+                mpi_comm);
+
+  const int mpi_size = MPI::size(mpi_comm);
+  Table table("Registered memory usage (bytes)");
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    table.set(names[i], "local", local[i]);
+    table.set(names[i], "mean", sum[i] / mpi_size);
+    table.set(names[i], "max", max[i]);
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+std::string MemoryRegistry::json()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::string s = "{";
+  for (std::size_t i = 0; i < r.names.size(); ++i)
+  {
+    if (i > 0)
+      s += ", ";
+    s += "\"" + r.names[i]
+         + "\": " + std::to_string(r.values[i].load(std::memory_order_relaxed));
+  }
+  s += "}";
+  return s;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/common/Table.h>
+#include <mpi.h>
+#include <string>
+
+namespace dolfinx::common
+{
+
+/// Registry of the resident bytes held by the major data owners
+/// (topology connectivities, geometry coordinates, dofmaps, sparsity
+/// patterns, bounding box trees). Each owner embeds a Usage member and
+/// reports its allocation through it whenever the allocation changes;
+/// the per-subsystem totals can be queried at runtime, dumped as an
+/// MPI-reduced Table and monitored against a warning threshold, so
+/// memory capacity planning is arithmetic rather than trial and error.
+///
+/// Usage (in the owning class):
+///
+///   common::MemoryRegistry::Usage _mem_usage{"Topology"};
+///   ...
+///   _mem_usage.update(num_bytes);  // after (re)allocation
+///
+/// Data shared between owners through shared pointers is reported by
+/// every owner holding it, so the totals are an upper bound on the
+/// resident set.
+
+class MemoryRegistry
+{
+public:
+  /// Reported allocation of one owner. The reported bytes follow the
+  /// owner through copies (the copy reports the same amount), moves
+  /// (the reporting is transferred) and destruction (the reporting is
+  /// withdrawn), so owners with default copy and move semantics stay
+  /// correctly accounted.
+  class Usage
+  {
+  public:
+    /// Create a reporting hook for a subsystem
+    /// @param[in] subsystem The subsystem name, as shown in reports
+    explicit Usage(const std::string& subsystem);
+
+    /// Copy constructor (the copy reports the same number of bytes)
+    Usage(const Usage& usage);
+
+    /// Move constructor (reporting is transferred)
+    Usage(Usage&& usage) noexcept;
+
+    /// Copy assignment
+    Usage& operator=(const Usage& usage);
+
+    /// Move assignment
+    Usage& operator=(Usage&& usage) noexcept;
+
+    /// Destructor (withdraws the reported bytes)
+    ~Usage();
+
+    /// Replace the reported number of bytes
+    /// @param[in] bytes Current allocation of the owner
+    void update(std::int64_t bytes);
+
+  private:
+    int _subsystem;
+    std::int64_t _bytes;
+  };
+
+  /// Intern a subsystem name, returning the id used for reporting.
+  /// Thread-safe but not cheap; Usage calls it once at construction.
+  /// @param[in] name The subsystem name
+  /// @return Subsystem id for add()
+  static int register_subsystem(const std::string& name);
+
+  /// Adjust the bytes reported for a subsystem (signed)
+  /// @param[in] subsystem Subsystem id from register_subsystem
+  /// @param[in] bytes Number of bytes to add (negative to withdraw)
+  static void add(int subsystem, std::int64_t bytes);
+
+  /// Current bytes reported for a subsystem on this process
+  /// @param[in] subsystem Subsystem id from register_subsystem
+  static std::int64_t bytes(int subsystem);
+
+  /// Total bytes reported on this process, over all subsystems
+  static std::int64_t total_bytes();
+
+  /// Dump a warning with the local per-subsystem breakdown when the
+  /// reported total crosses the threshold from below, e.g. set to 90%
+  /// of the node memory divided by the ranks per node. Zero (the
+  /// default) disables the check.
+  /// @param[in] bytes The threshold
+  static void set_warning_threshold(std::int64_t bytes);
+
+  /// Summary of all subsystems as a Table with the per-process value
+  /// and the mean and maximum over the communicator. Collective.
+  /// @param[in] mpi_comm MPI communicator to reduce over
+  static Table summary(MPI_Comm mpi_comm);
+
+  /// Machine-readable dump of the subsystems on this process, as a
+  /// JSON object mapping subsystem names to bytes
+  static std::string json();
+};
+} // namespace dolfinx::common
@@ -0,0 +1,502 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "IndexMap.h"
+#include "MPI.h"
+#include <algorithm>
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx
+{
+namespace common
+{
+
+/// Persistent scatter over the pattern of an IndexMap. The
+/// IndexMap::scatter_fwd/scatter_rev calls rebuild displacement
+/// vectors, allocate buffers and create a neighbourhood communicator
+/// on every invocation; this class computes the pack/unpack index
+/// lists once, preallocates the buffers and initializes persistent
+/// point-to-point requests, so each exchange only packs, starts the
+/// requests and waits. The begin/end split-phase variants let local
+/// computation overlap the halo exchange.
+///
+/// The Scatterer keeps a reference to nothing: it copies the pattern
+/// from the IndexMap at construction and remains valid for its own
+/// lifetime.
+
+template <typename T>
+class Scatterer
+{
+public:
+  /// Neighbour exchange strategy
+  enum class Exchange
+  {
+    flat,      ///< Persistent point-to-point requests for every
+               ///< neighbour
+    node_aware ///< Two-level exchange: the staging buffers live in an
+               ///< MPI shared-memory window and on-node neighbours
+               ///< exchange blocks by direct loads from each other's
+               ///< segments, so only off-node neighbours touch the
+               ///< network
+  };
+
+  /// Create a persistent scatter for the pattern of an index map
+  /// @param[in] map The index map describing the ghost pattern
+  /// @param[in] n Number of data items per index (block size)
+  /// @param[in] mode Neighbour exchange strategy
+  Scatterer(const IndexMap& map, int n, Exchange mode = Exchange::flat)
+      : _n(n), _size_local(map.size_local()),
+        _shared_indices(map.forward_indices()), _send_data(nullptr),
+        _recv_data(nullptr)
+  {
+    init(map, nullptr, nullptr, mode);
+  }
+
+  /// Create a persistent scatter using externally owned communication
+  /// buffers, e.g. pinned or interconnect-registered memory. The
+  /// persistent requests are bound to the supplied buffers, which must
+  /// outlive the Scatterer and have at least send_buffer_size and
+  /// recv_buffer_size elements respectively. Callers that pack the
+  /// buffers themselves (see pack_indices/unpack_positions) can use
+  /// the no-copy begin/end overloads for a zero-copy exchange.
+  /// @param[in] map The index map describing the ghost pattern
+  /// @param[in] n Number of data items per index (block size)
+  /// @param[in] send_buffer Externally owned send staging buffer
+  /// @param[in] recv_buffer Externally owned receive staging buffer
+  Scatterer(const IndexMap& map, int n, T* send_buffer, T* recv_buffer)
+      : _n(n), _size_local(map.size_local()),
+        _shared_indices(map.forward_indices()), _send_data(send_buffer),
+        _recv_data(recv_buffer)
+  {
+    if ((send_buffer == nullptr) != (recv_buffer == nullptr))
+    {
+      throw std::runtime_error(
+          "Provide both communication buffers or neither.");
+    }
+    init(map, send_buffer, recv_buffer, Exchange::flat);
+  }
+
+  /// Required size (in elements) of the send buffer for a map and
+  /// block size, for callers allocating their own buffers
+  static std::size_t send_buffer_size(const IndexMap& map, int n)
+  {
+    return std::size_t(n) * map.forward_indices().size();
+  }
+
+  /// Required size (in elements) of the receive buffer for a map and
+  /// block size, for callers allocating their own buffers
+  static std::size_t recv_buffer_size(const IndexMap& map, int n)
+  {
+    return std::size_t(n) * map.num_ghosts();
+  }
+
+  // Copying would duplicate persistent requests
+  Scatterer(const Scatterer&) = delete;
+
+  /// Copy assignment is not permitted
+  Scatterer& operator=(const Scatterer&) = delete;
+
+  /// Destructor
+  ~Scatterer()
+  {
+    for (MPI_Request& r : _fwd_requests)
+      MPI_Request_free(&r);
+    for (MPI_Request& r : _rev_requests)
+      MPI_Request_free(&r);
+    if (_send_win != MPI_WIN_NULL)
+    {
+      MPI_Win_unlock_all(_send_win);
+      MPI_Win_unlock_all(_recv_win);
+      MPI_Win_free(&_send_win);
+      MPI_Win_free(&_recv_win);
+    }
+    if (_node_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&_node_comm);
+    MPI_Comm_free(&_comm);
+  }
+
+  /// Start a forward scatter (owned to ghost). The local data must
+  /// not be needed again before scatter_fwd_end returns.
+  /// @param[in] local_data Owned data, n items per index
+  void scatter_fwd_begin(const std::vector<T>& local_data)
+  {
+    assert((std::int32_t)local_data.size() >= _n * _size_local);
+    for (std::size_t i = 0; i < _shared_indices.size(); ++i)
+    {
+      const std::int32_t index = _shared_indices[i];
+      for (int j = 0; j < _n; ++j)
+        _send_data[i * _n + j] = local_data[index * _n + j];
+    }
+    scatter_fwd_begin();
+  }
+
+  /// Finish a forward scatter
+  /// @param[in,out] remote_data Ghost data, n items per ghost index.
+  ///                            Resized if required.
+  void scatter_fwd_end(std::vector<T>& remote_data)
+  {
+    scatter_fwd_end();
+    remote_data.resize(_n * _ghost_pos.size());
+    for (std::size_t i = 0; i < _ghost_pos.size(); ++i)
+    {
+      const std::int32_t pos = _ghost_pos[i];
+      for (int j = 0; j < _n; ++j)
+        remote_data[i * _n + j] = _recv_data[pos * _n + j];
+    }
+  }
+
+  /// Start a forward scatter without packing: the caller has already
+  /// filled the send buffer (see pack_indices), e.g. with a kernel
+  /// writing directly into registered memory
+  void scatter_fwd_begin()
+  {
+    MPI_Startall(_fwd_requests.size(), _fwd_requests.data());
+    if (_send_win != MPI_WIN_NULL)
+      MPI_Win_sync(_send_win);
+  }
+
+  /// Finish a forward scatter without unpacking: the received values
+  /// are left in the receive buffer, ordered by unpack_positions
+  void scatter_fwd_end()
+  {
+    if (_node_comm != MPI_COMM_NULL)
+    {
+      // All on-node ranks have packed and synced their send segments;
+      // pull the blocks destined for this rank by direct loads. The
+      // closing barrier guards the segments against repacking before
+      // every neighbour has read them.
+      MPI_Barrier(_node_comm);
+      MPI_Win_sync(_send_win);
+      for (const NodeNeighbour& nb : _node_neighbours)
+      {
+        std::copy(nb.remote_send, nb.remote_send + _n * nb.recv_count,
+                  _recv_data + _n * nb.recv_offset);
+      }
+      MPI_Barrier(_node_comm);
+    }
+    MPI_Waitall(_fwd_requests.size(), _fwd_requests.data(),
+                MPI_STATUSES_IGNORE);
+  }
+
+  /// Forward scatter (owned to ghost)
+  /// @param[in] local_data Owned data, n items per index
+  /// @param[in,out] remote_data Ghost data, n items per ghost index
+  void scatter_fwd(const std::vector<T>& local_data,
+                   std::vector<T>& remote_data)
+  {
+    scatter_fwd_begin(local_data);
+    scatter_fwd_end(remote_data);
+  }
+
+  /// Start a reverse scatter (ghost to owned)
+  /// @param[in] remote_data Ghost data, n items per ghost index
+  void scatter_rev_begin(const std::vector<T>& remote_data)
+  {
+    assert(remote_data.size() == std::size_t(_n) * _ghost_pos.size());
+    for (std::size_t i = 0; i < _ghost_pos.size(); ++i)
+    {
+      const std::int32_t pos = _ghost_pos[i];
+      for (int j = 0; j < _n; ++j)
+        _recv_data[pos * _n + j] = remote_data[i * _n + j];
+    }
+    scatter_rev_begin();
+  }
+
+  /// Finish a reverse scatter
+  /// @param[in,out] local_data Owned data, n items per index. Resized
+  ///                           if required.
+  /// @param[in] op Whether received values overwrite or accumulate
+  ///               into the owned data
+  void scatter_rev_end(std::vector<T>& local_data, IndexMap::Mode op)
+  {
+    scatter_rev_end();
+    local_data.resize(_n * _size_local, 0);
+    if (op == IndexMap::Mode::insert)
+    {
+      for (std::size_t i = 0; i < _shared_indices.size(); ++i)
+      {
+        const std::int32_t index = _shared_indices[i];
+        for (int j = 0; j < _n; ++j)
+          local_data[index * _n + j] = _send_data[i * _n + j];
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < _shared_indices.size(); ++i)
+      {
+        const std::int32_t index = _shared_indices[i];
+        for (int j = 0; j < _n; ++j)
+          local_data[index * _n + j] += _send_data[i * _n + j];
+      }
+    }
+  }
+
+  /// Reverse scatter (ghost to owned)
+  /// @param[in,out] local_data Owned data, n items per index
+  /// @param[in] remote_data Ghost data, n items per ghost index
+  /// @param[in] op Whether received values overwrite or accumulate
+  ///               into the owned data
+  void scatter_rev(std::vector<T>& local_data,
+                   const std::vector<T>& remote_data, IndexMap::Mode op)
+  {
+    scatter_rev_begin(remote_data);
+    scatter_rev_end(local_data, op);
+  }
+
+  /// Start a reverse scatter without packing: the caller has already
+  /// filled the receive buffer (positions given by unpack_positions)
+  void scatter_rev_begin()
+  {
+    MPI_Startall(_rev_requests.size(), _rev_requests.data());
+    if (_recv_win != MPI_WIN_NULL)
+      MPI_Win_sync(_recv_win);
+  }
+
+  /// Finish a reverse scatter without unpacking: the received values
+  /// are left in the send buffer, ordered by pack_indices
+  void scatter_rev_end()
+  {
+    if (_node_comm != MPI_COMM_NULL)
+    {
+      MPI_Barrier(_node_comm);
+      MPI_Win_sync(_recv_win);
+      for (const NodeNeighbour& nb : _node_neighbours)
+      {
+        std::copy(nb.remote_recv, nb.remote_recv + _n * nb.send_count,
+                  _send_data + _n * nb.send_offset);
+      }
+      MPI_Barrier(_node_comm);
+    }
+    MPI_Waitall(_rev_requests.size(), _rev_requests.data(),
+                MPI_STATUSES_IGNORE);
+  }
+
+  /// Owned indices in send-buffer order: slot i of the send buffer
+  /// holds the data of owned index pack_indices()[i]. Callers packing
+  /// the buffers themselves (e.g. on a device) apply this gather before
+  /// scatter_fwd_begin() and this scatter after scatter_rev_end().
+  const std::vector<std::int32_t>& pack_indices() const
+  {
+    return _shared_indices;
+  }
+
+  /// Receive-buffer slot (in index units) of each ghost: ghost i is
+  /// delivered at slot unpack_positions()[i] of the receive buffer
+  const std::vector<std::int32_t>& unpack_positions() const
+  {
+    return _ghost_pos;
+  }
+
+  /// The send buffer bound to the persistent requests
+  T* send_buffer() { return _send_data; }
+
+  /// The receive buffer bound to the persistent requests
+  T* recv_buffer() { return _recv_data; }
+
+private:
+  // Block descriptor for an on-node neighbour: the extent of the
+  // exchanged blocks in this rank's buffers and where the blocks
+  // destined for this rank start in the neighbour's shared segments
+  struct NodeNeighbour
+  {
+    std::int32_t send_offset;
+    std::int32_t send_count;
+    std::int32_t recv_offset;
+    std::int32_t recv_count;
+    const T* remote_send;
+    const T* remote_recv;
+  };
+
+  // Build the communicators, buffers and persistent requests. Called
+  // from the constructors after the pattern members are set.
+  void init(const IndexMap& map, T* send_buffer, T* recv_buffer,
+            Exchange mode)
+  {
+    if (_n < 1)
+      throw std::runtime_error("Block size must be at least 1.");
+
+    const std::vector<std::int32_t>& neighbours = map.neighbours();
+    const int num_neighbours = neighbours.size();
+    MPI_Dist_graph_create_adjacent(
+        map.mpi_comm(), num_neighbours, neighbours.data(), MPI_UNWEIGHTED,
+        num_neighbours, neighbours.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
+        false, &_comm);
+
+    // Group ghosts by owning neighbour: _ghost_pos[i] is the position
+    // of ghost i in the receive buffer (in index units)
+    const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& ghost_owners
+        = map.ghost_owners();
+    std::vector<std::int32_t> recv_count(num_neighbours, 0);
+    std::vector<int> owner_pos(ghost_owners.rows());
+    for (Eigen::Index i = 0; i < ghost_owners.rows(); ++i)
+    {
+      const auto it = std::find(neighbours.begin(), neighbours.end(),
+                                ghost_owners[i]);
+      assert(it != neighbours.end());
+      owner_pos[i] = std::distance(neighbours.begin(), it);
+      ++recv_count[owner_pos[i]];
+    }
+
+    std::vector<std::int32_t> recv_offset(num_neighbours + 1, 0);
+    for (int p = 0; p < num_neighbours; ++p)
+      recv_offset[p + 1] = recv_offset[p] + recv_count[p];
+    _ghost_pos.resize(ghost_owners.rows());
+    {
+      std::vector<std::int32_t> pos(recv_offset.begin(),
+                                    recv_offset.end() - 1);
+      for (Eigen::Index i = 0; i < ghost_owners.rows(); ++i)
+        _ghost_pos[i] = pos[owner_pos[i]]++;
+    }
+
+    // The number of owned indices sent to each neighbour is the
+    // number of ghosts the neighbour holds of this process
+    std::vector<std::int32_t> send_count(num_neighbours, 0);
+    MPI_Neighbor_alltoall(recv_count.data(), 1, MPI_INT32_T,
+                          send_count.data(), 1, MPI_INT32_T, _comm);
+    std::vector<std::int32_t> send_offset(num_neighbours + 1, 0);
+    for (int p = 0; p < num_neighbours; ++p)
+      send_offset[p + 1] = send_offset[p] + send_count[p];
+    assert((std::int32_t)_shared_indices.size() == send_offset.back());
+
+    // Which node communicator rank, if any, each neighbour has. The
+    // split and the window allocations below are collective over the
+    // full communicator, as the scatters then are too.
+    std::vector<int> node_rank(num_neighbours, -1);
+    if (mode == Exchange::node_aware)
+    {
+      MPI_Comm_split_type(map.mpi_comm(), MPI_COMM_TYPE_SHARED,
+                          MPI::rank(map.mpi_comm()), MPI_INFO_NULL,
+                          &_node_comm);
+      const int node_size = MPI::size(_node_comm);
+      std::vector<int> node_global(node_size);
+      const int global_rank = MPI::rank(map.mpi_comm());
+      MPI_Allgather(&global_rank, 1, MPI_INT, node_global.data(), 1, MPI_INT,
+                    _node_comm);
+      for (int p = 0; p < num_neighbours; ++p)
+      {
+        const auto it = std::find(node_global.begin(), node_global.end(),
+                                  neighbours[p]);
+        if (it != node_global.end())
+          node_rank[p] = std::distance(node_global.begin(), it);
+      }
+    }
+
+    // Allocate staging buffers unless the caller supplied long-lived
+    // ones. In node-aware mode the buffers live in shared-memory
+    // windows so on-node neighbours can read them directly.
+    if (mode == Exchange::node_aware)
+    {
+      T* base = nullptr;
+      MPI_Win_allocate_shared(sizeof(T) * _n * send_offset.back(), sizeof(T),
+                              MPI_INFO_NULL, _node_comm, &base, &_send_win);
+      _send_data = base;
+      MPI_Win_allocate_shared(sizeof(T) * _n * recv_offset.back(), sizeof(T),
+                              MPI_INFO_NULL, _node_comm, &base, &_recv_win);
+      _recv_data = base;
+      MPI_Win_lock_all(MPI_MODE_NOCHECK, _send_win);
+      MPI_Win_lock_all(MPI_MODE_NOCHECK, _recv_win);
+    }
+    else if (send_buffer == nullptr)
+    {
+      _send_buffer.resize(_n * send_offset.back());
+      _recv_buffer.resize(_n * recv_offset.back());
+      _send_data = _send_buffer.data();
+      _recv_data = _recv_buffer.data();
+    }
+
+    // Each neighbour needs to know where the block destined for it
+    // starts in this rank's buffers: exchange (send, recv) offsets
+    std::vector<std::int32_t> offsets_out(2 * num_neighbours);
+    std::vector<std::int32_t> offsets_in(2 * num_neighbours);
+    for (int p = 0; p < num_neighbours; ++p)
+    {
+      offsets_out[2 * p] = send_offset[p];
+      offsets_out[2 * p + 1] = recv_offset[p];
+    }
+    MPI_Neighbor_alltoall(offsets_out.data(), 2, MPI_INT32_T,
+                          offsets_in.data(), 2, MPI_INT32_T, _comm);
+
+    // Initialize the exchange: direct-load descriptors for on-node
+    // neighbours, persistent requests for the rest. Forward scatter
+    // sends the owned (send) buffer and receives into the ghost (recv)
+    // buffer, reverse scatter runs the same channels backwards.
+    for (int p = 0; p < num_neighbours; ++p)
+    {
+      if (node_rank[p] >= 0)
+      {
+        MPI_Aint size;
+        int disp_unit;
+        T *send_base, *recv_base;
+        MPI_Win_shared_query(_send_win, node_rank[p], &size, &disp_unit,
+                             &send_base);
+        MPI_Win_shared_query(_recv_win, node_rank[p], &size, &disp_unit,
+                             &recv_base);
+        _node_neighbours.push_back(
+            {send_offset[p], send_count[p], recv_offset[p], recv_count[p],
+             send_base + _n * offsets_in[2 * p],
+             recv_base + _n * offsets_in[2 * p + 1]});
+        continue;
+      }
+
+      _fwd_requests.push_back(MPI_REQUEST_NULL);
+      MPI_Send_init(_send_data + _n * send_offset[p], _n * send_count[p],
+                    MPI::mpi_type<T>(), neighbours[p], 0, _comm,
+                    &_fwd_requests.back());
+      _fwd_requests.push_back(MPI_REQUEST_NULL);
+      MPI_Recv_init(_recv_data + _n * recv_offset[p], _n * recv_count[p],
+                    MPI::mpi_type<T>(), neighbours[p], 0, _comm,
+                    &_fwd_requests.back());
+      _rev_requests.push_back(MPI_REQUEST_NULL);
+      MPI_Send_init(_recv_data + _n * recv_offset[p], _n * recv_count[p],
+                    MPI::mpi_type<T>(), neighbours[p], 1, _comm,
+                    &_rev_requests.back());
+      _rev_requests.push_back(MPI_REQUEST_NULL);
+      MPI_Recv_init(_send_data + _n * send_offset[p], _n * send_count[p],
+                    MPI::mpi_type<T>(), neighbours[p], 1, _comm,
+                    &_rev_requests.back());
+    }
+  }
+
+  // Block size and number of owned indices
+  int _n;
+  std::int32_t _size_local;
+
+  // Neighbourhood communicator the persistent requests live on
+  MPI_Comm _comm;
+
+  // Owned indices to pack, grouped by destination neighbour
+  std::vector<std::int32_t> _shared_indices;
+
+  // Receive buffer position (in index units) of each ghost
+  std::vector<std::int32_t> _ghost_pos;
+
+  // Internally allocated exchange buffers (empty when the caller
+  // supplied external buffers or in node-aware mode)
+  std::vector<T> _send_buffer;
+  std::vector<T> _recv_buffer;
+
+  // Buffers bound to the persistent requests
+  T* _send_data;
+  T* _recv_data;
+
+  // Node-local communicator, shared-memory windows holding the
+  // buffers and copy descriptors for the on-node neighbours
+  // (node-aware mode only)
+  MPI_Comm _node_comm = MPI_COMM_NULL;
+  MPI_Win _send_win = MPI_WIN_NULL;
+  MPI_Win _recv_win = MPI_WIN_NULL;
+  std::vector<NodeNeighbour> _node_neighbours;
+
+  // Persistent requests for the off-node neighbours
+  std::vector<MPI_Request> _fwd_requests;
+  std::vector<MPI_Request> _rev_requests;
+};
+} // namespace common
+} // namespace dolfinx
@@ -197,6 +197,15 @@ bool SubSystemsManager::mpi_finalized()
   return mpi_finalized;
 }
 //-----------------------------------------------------------------------------
+int SubSystemsManager::mpi_thread_level()
+{
+  if (!mpi_initialized() or mpi_finalized())
+    return MPI_THREAD_SINGLE;
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return provided;
+}
+//-----------------------------------------------------------------------------
 PetscErrorCode SubSystemsManager::PetscDolfinErrorHandler(
     MPI_Comm, int line, const char* fun, const char* file, PetscErrorCode n,
     PetscErrorType, const char* mess, void*)
@@ -63,6 +63,11 @@ public:
   /// finalised)
   static bool mpi_finalized();
 
+  /// Level of MPI thread support provided at initialisation
+  /// (MPI_Query_thread), whether MPI was initialised by DOLFINX or by
+  /// the caller. Returns MPI_THREAD_SINGLE if MPI is not initialised.
+  static int mpi_thread_level();
+
   /// PETSc error handler. Logs everything known to DOLFINX logging
   /// system (with level TRACE) and stores the error message into
   /// pests_err_msg member.
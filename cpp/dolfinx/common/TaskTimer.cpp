@@ -0,0 +1,161 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "TaskTimer.h"
+#include <algorithm>
+#include <mutex>
+#include <variant>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+// Per-thread tick/count accumulation. On thread exit the totals move
+// to the retired arrays so they survive for the report.
+struct ThreadBuffer
+{
+  std::vector<std::uint64_t> ticks;
+  std::vector<std::uint64_t> count;
+  ~ThreadBuffer();
+};
+
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::string> task_names;
+  std::vector<ThreadBuffer*> live;
+  std::vector<std::uint64_t> retired_ticks;
+  std::vector<std::uint64_t> retired_count;
+
+  // Reference sample for tick-rate calibration, taken at start-up
+  std::uint64_t t0;
+  std::chrono::steady_clock::time_point s0;
+};
+
+Registry& registry()
+{
+  static Registry r;
+  return r;
+}
+
+ThreadBuffer::~ThreadBuffer()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (r.retired_ticks.size() < ticks.size())
+  {
+    r.retired_ticks.resize(ticks.size(), 0);
+    r.retired_count.resize(ticks.size(), 0);
+  }
+  for (std::size_t i = 0; i < ticks.size(); ++i)
+  {
+    r.retired_ticks[i] += ticks[i];
+    r.retired_count[i] += count[i];
+  }
+  r.live.erase(std::remove(r.live.begin(), r.live.end(), this), r.live.end());
+}
+
+ThreadBuffer& thread_buffer()
+{
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (!buffer)
+  {
+    static thread_local ThreadBuffer b;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.live.push_back(&b);
+    buffer = &b;
+  }
+  return *buffer;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+int TaskTimer::register_task(const std::string& name)
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (r.task_names.empty())
+  {
+    // First registration: take the calibration reference sample
+    r.t0 = now();
+    r.s0 = std::chrono::steady_clock::now();
+  }
+  const auto it = std::find(r.task_names.begin(), r.task_names.end(), name);
+  if (it != r.task_names.end())
+    return std::distance(r.task_names.begin(), it);
+  r.task_names.push_back(name);
+  return r.task_names.size() - 1;
+}
+//-----------------------------------------------------------------------------
+void TaskTimer::accumulate(int task, std::uint64_t ticks)
+{
+  ThreadBuffer& b = thread_buffer();
+  if (b.ticks.size() <= std::size_t(task))
+  {
+    b.ticks.resize(task + 1, 0);
+    b.count.resize(task + 1, 0);
+  }
+  b.ticks[task] += ticks;
+  b.count[task] += 1;
+}
+//-----------------------------------------------------------------------------
+Table TaskTimer::timings()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+
+  // Calibrate the tick rate against the monotonic clock over the time
+  // since the first task registration
+  const std::uint64_t t1 = now();
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - r.s0;
+  const double seconds_per_tick
+      = t1 > r.t0 ? elapsed.count() / double(t1 - r.t0) : 0.0;
+
+  std::vector<std::uint64_t> ticks(r.retired_ticks);
+  std::vector<std::uint64_t> count(r.retired_count);
+  ticks.resize(r.task_names.size(), 0);
+  count.resize(r.task_names.size(), 0);
+  for (const ThreadBuffer* b : r.live)
+  {
+    for (std::size_t i = 0; i < b->ticks.size(); ++i)
+    {
+      ticks[i] += b->ticks[i];
+      count[i] += b->count[i];
+    }
+  }
+
+  Table table("Summary of task timings");
+  for (std::size_t i = 0; i < r.task_names.size(); ++i)
+  {
+    if (count[i] == 0)
+      continue;
+    const double wall = seconds_per_tick * ticks[i];
+    table.set(r.task_names[i], "reps",
+              std::variant<std::string, int, double>(int(count[i])));
+    table.set(r.task_names[i], "wall avg", wall / double(count[i]));
+    table.set(r.task_names[i], "wall tot", wall);
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+void TaskTimer::reset()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.retired_ticks.assign(r.task_names.size(), 0);
+  r.retired_count.assign(r.task_names.size(), 0);
+  for (ThreadBuffer* b : r.live)
+  {
+    std::fill(b->ticks.begin(), b->ticks.end(), 0);
+    std::fill(b->count.begin(), b->count.end(), 0);
+  }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,92 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <dolfinx/common/Table.h>
+#include <string>
+
+#if defined(__x86_64__) or defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace dolfinx::common
+{
+
+/// Low-overhead scoped timer for instrumenting hot code, e.g.
+/// per-cell assembly or scatter phases. common::Timer formats a log
+/// line and updates a string-keyed map on every stop, which distorts
+/// anything that runs more than a few thousand times per second.
+/// TaskTimer instead times against an integer task id interned once at
+/// setup, reads the cycle counter directly where available
+/// (std::chrono::steady_clock elsewhere), and accumulates into a
+/// per-thread buffer with no locking or allocation in the timed scope;
+/// the buffers are merged and the tick rate calibrated only when
+/// timings() is called. The cost per scope is two timestamp reads and
+/// one cached add, so the timers can stay on in production.
+///
+/// Usage:
+///
+///   static const int task = TaskTimer::register_task("pack ghosts");
+///   {
+///     TaskTimer timer(task);
+///     ...
+///   }
+
+class TaskTimer
+{
+public:
+  /// Intern a task name, returning the id to time against. Thread-safe
+  /// but not cheap; call once at setup (e.g. into a function-local
+  /// static), not in the timed loop.
+  /// @param[in] name The task name, as shown in the timing table
+  /// @return Task id for the TaskTimer constructor
+  static int register_task(const std::string& name);
+
+  /// Start timing a task. The elapsed time is accumulated when the
+  /// object goes out of scope.
+  /// @param[in] task Task id from register_task
+  TaskTimer(int task) : _task(task), _t0(now()) {}
+
+  // Copying a running scope would double-count
+  TaskTimer(const TaskTimer&) = delete;
+
+  /// Copy assignment is not permitted
+  TaskTimer& operator=(const TaskTimer&) = delete;
+
+  /// Stop timing and accumulate into the per-thread buffer
+  ~TaskTimer() { accumulate(_task, now() - _t0); }
+
+  /// Merge the per-thread buffers and return a table of (reps, wall
+  /// avg, wall tot) per task, with ticks converted to seconds using
+  /// the calibrated tick rate. Does not reset the accumulated data.
+  /// Call from a point where no timed scopes are running; scopes still
+  /// in flight on other threads are not included.
+  static Table timings();
+
+  /// Reset all accumulated timings
+  static void reset();
+
+private:
+  // Raw timestamp: cycle counter on x86-64, monotonic clock otherwise
+  static std::uint64_t now()
+  {
+#if defined(__x86_64__) or defined(_M_X64)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+  }
+
+  // Add elapsed ticks to the calling thread's buffer for a task
+  static void accumulate(int task, std::uint64_t ticks);
+
+  int _task;
+  std::uint64_t _t0;
+};
+} // namespace dolfinx::common
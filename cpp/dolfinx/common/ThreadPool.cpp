@@ -0,0 +1,106 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "ThreadPool.h"
+#include "utils.h"
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+common::ThreadPool::ThreadPool(int size)
+{
+  for (int t = 1; t < size; ++t)
+    _workers.emplace_back([this] { worker_loop(); });
+}
+//-----------------------------------------------------------------------------
+common::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _region_begin.notify_all();
+  for (std::thread& w : _workers)
+    w.join();
+}
+//-----------------------------------------------------------------------------
+int common::ThreadPool::size() const
+{
+  return static_cast<int>(_workers.size()) + 1;
+}
+//-----------------------------------------------------------------------------
+void common::ThreadPool::run(int num_tasks,
+                             const std::function<void(int)>& task)
+{
+  // Serial fallback: no workers, trivial region, or a task on this
+  // pool entering a nested parallel region
+  if (_workers.empty() or num_tasks <= 1 or _running)
+  {
+    for (int i = 0; i < num_tasks; ++i)
+      task(i);
+    return;
+  }
+
+  // Publish the region and wake the workers
+  std::atomic<int> next(0);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _task = &task;
+    _num_tasks = num_tasks;
+    _next = &next;
+    _active = static_cast<int>(_workers.size());
+    _running = true;
+    ++_generation;
+  }
+  _region_begin.notify_all();
+
+  // The calling thread claims tasks alongside the workers
+  int i;
+  while ((i = next.fetch_add(1)) < num_tasks)
+    task(i);
+
+  // Wait until every worker has left the region before the task (and
+  // the caller's stack) can go out of scope
+  std::unique_lock<std::mutex> lock(_mutex);
+  _region_end.wait(lock, [this] { return _active == 0; });
+  _task = nullptr;
+  _next = nullptr;
+  _running = false;
+}
+//-----------------------------------------------------------------------------
+void common::ThreadPool::worker_loop()
+{
+  std::uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(_mutex);
+  for (;;)
+  {
+    _region_begin.wait(
+        lock, [&] { return _shutdown or _generation != generation; });
+    if (_shutdown)
+      return;
+
+    generation = _generation;
+    const std::function<void(int)>* task = _task;
+    const int num_tasks = _num_tasks;
+    std::atomic<int>* next = _next;
+    lock.unlock();
+
+    int i;
+    while ((i = next->fetch_add(1)) < num_tasks)
+      (*task)(i);
+
+    lock.lock();
+    if (--_active == 0)
+      _region_end.notify_all();
+  }
+}
+//-----------------------------------------------------------------------------
+common::ThreadPool& common::global_thread_pool()
+{
+  static ThreadPool pool(num_worker_threads());
+  return pool;
+}
+//-----------------------------------------------------------------------------
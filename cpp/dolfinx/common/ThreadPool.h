@@ -0,0 +1,94 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dolfinx::common
+{
+
+/// A pool of persistent worker threads for thread-parallel loops.
+///
+/// Workers are started once and reused, so parallel regions do not pay
+/// thread creation/teardown on every call. Tasks are self-scheduled
+/// from a shared atomic counter: each worker (and the calling thread,
+/// which participates) repeatedly claims the next unclaimed task index,
+/// which balances uneven task costs without a per-task queue.
+///
+/// There is one process-wide pool, shared by all parallel loops in the
+/// library (assembly, topology computation, tree construction, quality
+/// metrics), accessed through global_thread_pool() and sized by
+/// num_worker_threads(). Using a single pool keeps the thread count
+/// bounded regardless of how many components run parallel loops.
+/// Parallel regions must be entered from one thread at a time,
+/// normally the main thread; nested calls run serially on the calling
+/// thread. MPI calls must not be made from inside tasks.
+class ThreadPool
+{
+public:
+  /// Create a pool. The pool holds size - 1 worker threads; the thread
+  /// calling run() acts as the remaining worker.
+  /// @param[in] size Total number of threads executing a parallel
+  ///   region, including the caller. Values below 2 create no workers
+  ///   and run() executes serially.
+  explicit ThreadPool(int size);
+
+  // Copy and move are deleted: workers hold a pointer to the pool state
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// Destructor. Blocks until the workers have shut down.
+  ~ThreadPool();
+
+  /// Total number of threads executing a parallel region, including
+  /// the calling thread
+  int size() const;
+
+  /// Execute task(i) for i in [0, num_tasks) on the pool and the
+  /// calling thread, returning when all tasks have completed. Tasks
+  /// must not throw and must only write to locations derived from
+  /// their own index.
+  /// @param[in] num_tasks Number of task indices
+  /// @param[in] task Task body, called with each index exactly once
+  void run(int num_tasks, const std::function<void(int)>& task);
+
+private:
+  // Worker main loop
+  void worker_loop();
+
+  // Worker threads (size() - 1 entries)
+  std::vector<std::thread> _workers;
+
+  // State shared with the workers, guarded by _mutex: the current
+  // parallel region (task, task count, claim counter), a generation
+  // counter workers use to detect a new region, the number of workers
+  // still inside the current region, and the shutdown flag
+  std::mutex _mutex;
+  std::condition_variable _region_begin;
+  std::condition_variable _region_end;
+  const std::function<void(int)>* _task = nullptr;
+  int _num_tasks = 0;
+  std::atomic<int>* _next = nullptr;
+  std::uint64_t _generation = 0;
+  int _active = 0;
+  bool _shutdown = false;
+  bool _running = false;
+};
+
+/// The process-wide thread pool used by the library's parallel loops,
+/// created on first use with num_worker_threads() threads
+ThreadPool& global_thread_pool();
+
+} // namespace dolfinx::common
@@ -5,8 +5,10 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "TimeLogger.h"
+#include <algorithm>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <numeric>
 #include <variant>
 #include <vector>
 
@@ -39,6 +41,14 @@ void TimeLogger::register_timing(std::string task, double wall, double user,
     _timings.insert({task, {1, wall, user, system}});
 }
 //-----------------------------------------------------------------------------
+void TimeLogger::record_event(std::string task, double wall)
+{
+  const double stop = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - _epoch)
+                          .count();
+  _events.push_back({std::move(task), stop - wall, stop});
+}
+//-----------------------------------------------------------------------------
 void TimeLogger::list_timings(MPI_Comm mpi_comm, std::set<TimingType> type)
 {
   // Format and reduce to rank 0
@@ -88,6 +98,153 @@ Table TimeLogger::timings(std::set<TimingType> type)
   return table;
 }
 //-----------------------------------------------------------------------------
+Table TimeLogger::timings_imbalance(MPI_Comm mpi_comm)
+{
+  const int mpi_size = dolfinx::MPI::size(mpi_comm);
+  const int mpi_rank = dolfinx::MPI::rank(mpi_comm);
+
+  // Build the union of task names over all ranks: names are
+  // concatenated with '\0' separators and allgathered
+  std::string names;
+  for (const auto& it : _timings)
+    names += it.first + '\0';
+  const int local_size = names.size();
+  std::vector<int> sizes(mpi_size), offsets(mpi_size + 1, 0);
+  MPI_Allgather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, mpi_comm);
+  std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+  std::vector<char> names_all(offsets.back());
+  MPI_Allgatherv(names.data(), names.size(), MPI_CHAR, names_all.data(),
+                 sizes.data(), offsets.data(), MPI_CHAR, mpi_comm);
+  std::set<std::string> tasks;
+  for (auto it = names_all.begin(); it != names_all.end();)
+  {
+    const auto end = std::find(it, names_all.end(), '\0');
+    tasks.insert(std::string(it, end));
+    it = end + 1;
+  }
+
+  // Element-wise reductions of the local wall totals over the task
+  // union; MPI_MAXLOC also locates the slowest rank per task
+  struct WallRank
+  {
+    double wall;
+    int rank;
+  };
+  std::vector<double> wall;
+  std::vector<WallRank> wall_rank;
+  for (const std::string& task : tasks)
+  {
+    const auto it = _timings.find(task);
+    wall.push_back(it != _timings.end() ? std::get<1>(it->second) : 0.0);
+    wall_rank.push_back({wall.back(), mpi_rank});
+  }
+  std::vector<double> sum(wall), min(wall);
+  MPI_Allreduce(MPI_IN_PLACE, sum.data(), sum.size(), MPI_DOUBLE, MPI_SUM,
+                mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, min.data(), min.size(), MPI_DOUBLE, MPI_MIN,
+                mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, wall_rank.data(), wall_rank.size(),
+                MPI_DOUBLE_INT, MPI_MAXLOC, mpi_comm);
+
+  Table table("Wall time imbalance across ranks");
+  int i = 0;
+  for (const std::string& task : tasks)
+  {
+    const double avg = sum[i] / mpi_size;
+    table.set(task, "wall avg", avg);
+    table.set(task, "wall min", min[i]);
+    table.set(task, "wall max", wall_rank[i].wall);
+    table.set(task, "max rank", wall_rank[i].rank);
+    table.set(task, "imbalance", avg > 0.0 ? wall_rank[i].wall / avg : 1.0);
+    ++i;
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+std::string TimeLogger::timings_csv(MPI_Comm mpi_comm)
+{
+  const int mpi_size = dolfinx::MPI::size(mpi_comm);
+  const int mpi_rank = dolfinx::MPI::rank(mpi_comm);
+
+  // Serialize the local rows and gather to rank 0
+  std::string rows;
+  for (const auto& it : _timings)
+  {
+    rows += it.first + "," + std::to_string(mpi_rank) + ","
+            + std::to_string(std::get<0>(it.second)) + ","
+            + std::to_string(std::get<1>(it.second)) + "\n";
+  }
+  const int local_size = rows.size();
+  std::vector<int> sizes(mpi_size), offsets(mpi_size + 1, 0);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, mpi_comm);
+  std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+  std::vector<char> rows_all(offsets.back());
+  MPI_Gatherv(rows.data(), rows.size(), MPI_CHAR, rows_all.data(),
+              sizes.data(), offsets.data(), MPI_CHAR, 0, mpi_comm);
+
+  if (mpi_rank != 0)
+    return "";
+  return "task,rank,reps,wall\n"
+         + std::string(rows_all.begin(), rows_all.end());
+}
+//-----------------------------------------------------------------------------
+std::string TimeLogger::trace_json(MPI_Comm mpi_comm)
+{
+  const int mpi_size = dolfinx::MPI::size(mpi_comm);
+  const int mpi_rank = dolfinx::MPI::rank(mpi_comm);
+
+  // Each rank's _epoch is private. Align the timelines by expressing
+  // event times relative to a common instant: immediately after a
+  // barrier all ranks are (to within barrier skew) at the same wall
+  // time, so t - now is comparable across ranks.
+  MPI_Barrier(mpi_comm);
+  const double now = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - _epoch)
+                         .count();
+
+  // Shift so the earliest event over all ranks is at t=0
+  double t_min = 0.0;
+  for (const Event& e : _events)
+    t_min = std::min(t_min, e.start - now);
+  MPI_Allreduce(MPI_IN_PLACE, &t_min, 1, MPI_DOUBLE, MPI_MIN, mpi_comm);
+
+  // Serialize the local events as chrome-tracing complete ('X') events
+  // with pid = rank; viewers nest events contained in other events on
+  // the same row. Timestamps and durations are in microseconds.
+  std::string events;
+  for (const Event& e : _events)
+  {
+    std::string name;
+    for (const char c : e.task)
+    {
+      if (c == '"' or c == '\\')
+        name += '\\';
+      name += c;
+    }
+    events += "{\"name\":\"" + name + "\",\"cat\":\"dolfinx\",\"ph\":\"X\""
+              + ",\"ts\":" + std::to_string(1e6 * (e.start - now - t_min))
+              + ",\"dur\":" + std::to_string(1e6 * (e.stop - e.start))
+              + ",\"pid\":" + std::to_string(mpi_rank) + ",\"tid\":0},";
+  }
+
+  // Gather the fragments to rank 0
+  const int local_size = events.size();
+  std::vector<int> sizes(mpi_size), offsets(mpi_size + 1, 0);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, mpi_comm);
+  std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+  std::vector<char> events_all(offsets.back());
+  MPI_Gatherv(events.data(), events.size(), MPI_CHAR, events_all.data(),
+              sizes.data(), offsets.data(), MPI_CHAR, 0, mpi_comm);
+
+  if (mpi_rank != 0)
+    return "";
+  std::string all(events_all.begin(), events_all.end());
+  if (!all.empty() and all.back() == ',')
+    all.pop_back();
+  return "{\"traceEvents\":[" + all + "]}\n";
+}
+//-----------------------------------------------------------------------------
 std::tuple<int, double, double, double> TimeLogger::timing(std::string task)
 {
   // Find timing
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <dolfinx/common/Table.h>
 #include <dolfinx/common/timing.h>
 #include <map>
@@ -16,6 +17,7 @@
 #include <string>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 namespace dolfinx::common
 {
@@ -41,6 +43,15 @@ public:
   void register_timing(std::string task, double wall, double user,
                        double system);
 
+  /// Record a completed phase on the event timeline. The event covers
+  /// the interval ending now and extending @p wall seconds back, so a
+  /// stopping Timer can report itself without the logger having seen
+  /// its start. Phases that enclose other phases (outer Timers) appear
+  /// as enclosing intervals in the timeline.
+  /// @param task Name of the phase
+  /// @param wall Elapsed wall time of the phase (seconds)
+  void record_event(std::string task, double wall);
+
   /// Return a summary of timings and tasks in a Table
   Table timings(std::set<TimingType> type);
 
@@ -56,7 +67,46 @@ public:
   /// system time) for given task.
   std::tuple<int, double, double, double> timing(std::string task);
 
+  /// Return a table of load-imbalance statistics for the total wall
+  /// time of each task across the communicator: average, minimum,
+  /// maximum, the rank holding the maximum, and the imbalance ratio
+  /// max/avg. Tasks timed on only some ranks contribute zero on the
+  /// others. Collective; all ranks get the same table.
+  /// @param mpi_comm MPI communicator
+  Table timings_imbalance(MPI_Comm mpi_comm);
+
+  /// Return the per-rank timings as CSV text (columns task, rank,
+  /// reps, wall) gathered to rank 0, one row per (task, rank).
+  /// Collective; the returned string is empty on ranks other than 0.
+  /// @param mpi_comm MPI communicator
+  std::string timings_csv(MPI_Comm mpi_comm);
+
+  /// Return the event timeline in the chrome-tracing JSON format
+  /// (load the string into chrome://tracing or Perfetto), with one
+  /// process row per MPI rank so phase overlap, nesting and per-rank
+  /// skew are visible directly. Timestamps are best-effort aligned
+  /// across ranks using MPI_Wtime after a barrier. Collective; the
+  /// returned string is non-empty only on rank 0.
+  /// @param mpi_comm MPI communicator
+  std::string trace_json(MPI_Comm mpi_comm);
+
 private:
+  // Timeline event: phase name and its start/stop offsets (seconds)
+  // from _epoch
+  struct Event
+  {
+    std::string task;
+    double start;
+    double stop;
+  };
+
+  // Completed phases, in order of completion
+  std::vector<Event> _events;
+
+  // Local reference point for event timestamps
+  std::chrono::steady_clock::time_point _epoch
+      = std::chrono::steady_clock::now();
+
   // List of timings for tasks, map from string to (num_timings,
   // total_wall_time, total_user_time, total_system_time)
   std::map<std::string, std::tuple<int, double, double, double>> _timings;
@@ -45,7 +45,10 @@ double Timer::stop()
   _timer.stop();
   const auto [wall, user, system] = this->elapsed();
   if (!_task.empty())
+  {
     TimeLogManager::logger().register_timing(_task, wall, user, system);
+    TimeLogManager::logger().record_event(_task, wall);
+  }
   return wall;
 }
 //-----------------------------------------------------------------------------
@@ -0,0 +1,17 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "check.h"
+#include <stdexcept>
+
+//-----------------------------------------------------------------------------
+void dolfinx::common::check_failed(const char* cond, const std::string& msg,
+                                   const char* file, int line)
+{
+  throw std::runtime_error("Sanitize check failed: " + msg + " (" + cond
+                           + ") at " + file + ":" + std::to_string(line));
+}
+//-----------------------------------------------------------------------------
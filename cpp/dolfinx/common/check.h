@@ -0,0 +1,57 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cassert>
+#include <string>
+
+/// @file check.h
+/// Validation macros for hot paths. Two tiers:
+///
+/// - DOLFINX_ASSERT(cond): consolidated debug assertion. Behaves like
+///   assert() in Debug/Developer builds and is compiled out of
+///   release builds, but stays active in sanitize builds even when
+///   NDEBUG is set.
+///
+/// - DOLFINX_CHECK(cond, msg): full validation (index bounds,
+///   ownership invariants, connectivity consistency). Compiled in
+///   only when DOLFINX_SANITIZE is defined (cmake
+///   -DDOLFINX_SANITIZE=ON); a failure throws std::runtime_error with
+///   the condition and source location. Release builds compile the
+///   check out entirely, so it may be placed inside hot loops.
+
+namespace dolfinx::common
+{
+/// Throw std::runtime_error for a failed sanitize-build check.
+/// Out-of-line so the macro expansion in hot loops stays small.
+/// @param[in] cond Stringified condition that failed
+/// @param[in] msg Description of the violated invariant
+/// @param[in] file Source file of the check
+/// @param[in] line Source line of the check
+[[noreturn]] void check_failed(const char* cond, const std::string& msg,
+                               const char* file, int line);
+} // namespace dolfinx::common
+
+#ifdef DOLFINX_SANITIZE
+#define DOLFINX_CHECK(cond, msg)                                               \
+  do                                                                           \
+  {                                                                            \
+    if (!(cond))                                                               \
+      ::dolfinx::common::check_failed(#cond, msg, __FILE__, __LINE__);         \
+  } while (false)
+#define DOLFINX_ASSERT(cond) DOLFINX_CHECK(cond, "assertion")
+#else
+// The unevaluated sizeof keeps the arguments referenced (no unused
+// variable warnings at call sites) without generating any code
+#define DOLFINX_CHECK(cond, msg)                                               \
+  do                                                                           \
+  {                                                                            \
+    (void)sizeof(cond);                                                        \
+    (void)sizeof(msg);                                                         \
+  } while (false)
+#define DOLFINX_ASSERT(cond) assert(cond)
+#endif
@@ -12,10 +12,18 @@ namespace dolfinx
 
 // DOLFINX common
 
+#include <dolfinx/common/ArenaAllocator.h>
+#include <dolfinx/common/CommTracer.h>
+#include <dolfinx/common/Counters.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MemoryRegistry.h>
+#include <dolfinx/common/Scatterer.h>
 #include <dolfinx/common/SubSystemsManager.h>
 #include <dolfinx/common/Table.h>
+#include <dolfinx/common/TaskTimer.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/check.h>
 #include <dolfinx/common/defines.h>
 #include <dolfinx/common/init.h>
 #include <dolfinx/common/timing.h>
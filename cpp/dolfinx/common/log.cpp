@@ -6,3 +6,259 @@
 
 #include "log.h"
 #include "loguru.cpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mpi.h>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Bounded multi-producer single-consumer ring buffer of formatted log
+// lines. Producers (the logging threads) claim a slot with one
+// compare-and-swap and never block: a full ring rejects the push and
+// the message is dropped rather than stalling the caller. Each slot
+// carries a sequence number that tells both sides whether the slot is
+// ready for them.
+class LogRing
+{
+public:
+  // Capacity must be a power of two
+  static constexpr std::size_t capacity = 1024;
+
+  LogRing() : _slots(new Slot[capacity])
+  {
+    for (std::size_t i = 0; i < capacity; ++i)
+      _slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  // Push a line; returns false (dropping the line) when the ring is
+  // full
+  bool push(std::string&& text)
+  {
+    std::size_t pos = _tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      Slot& slot = _slots[pos & (capacity - 1)];
+      const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+      const std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)pos;
+      if (diff == 0)
+      {
+        if (_tail.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed))
+        {
+          slot.text = std::move(text);
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = _tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Pop a line (writer thread only); returns false when the ring is
+  // empty
+  bool pop(std::string& text)
+  {
+    const std::size_t pos = _head.load(std::memory_order_relaxed);
+    Slot& slot = _slots[pos & (capacity - 1)];
+    const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+    if ((std::intptr_t)seq - (std::intptr_t)(pos + 1) < 0)
+      return false;
+    text = std::move(slot.text);
+    slot.seq.store(pos + capacity, std::memory_order_release);
+    _head.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool empty() const
+  {
+    return _head.load(std::memory_order_acquire)
+           == _tail.load(std::memory_order_acquire);
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<std::size_t> seq;
+    std::string text;
+  };
+
+  std::unique_ptr<Slot[]> _slots;
+  std::atomic<std::size_t> _head{0};
+  std::atomic<std::size_t> _tail{0};
+};
+//-----------------------------------------------------------------------------
+// State of the async logging mode
+struct AsyncLogState
+{
+  LogRing ring;
+  std::thread writer;
+  FILE* sink = nullptr;
+  bool own_sink = false;
+  std::string rank_prefix;
+  std::atomic<std::size_t> dropped{0};
+
+  // Writer wake-up and flush handshake. Producers only notify; the
+  // mutex is shared by the writer and the (rare) flush/shutdown paths.
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable drained;
+  bool shutdown = false;
+  bool quiescent = false;
+
+  loguru::Verbosity saved_stderr_verbosity = loguru::Verbosity_WARNING;
+};
+
+AsyncLogState* async_state = nullptr;
+//-----------------------------------------------------------------------------
+// Background writer: drain the ring in batches, one write and one
+// flush per batch
+void writer_loop(AsyncLogState* state)
+{
+  std::string batch, line;
+  for (;;)
+  {
+    batch.clear();
+    while (state->ring.pop(line))
+    {
+      batch += line;
+      batch += '\n';
+    }
+    if (!batch.empty())
+    {
+      std::fwrite(batch.data(), 1, batch.size(), state->sink);
+      std::fflush(state->sink);
+    }
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (state->ring.empty())
+    {
+      state->quiescent = true;
+      state->drained.notify_all();
+      if (state->shutdown)
+        return;
+      state->wake.wait_for(lock, std::chrono::milliseconds(10));
+      state->quiescent = false;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+// loguru handler: format and enqueue, never touching the sink
+void async_log_handler(void* user_data, const loguru::Message& message)
+{
+  auto* state = static_cast<AsyncLogState*>(user_data);
+  std::string line;
+  line.reserve(state->rank_prefix.size() + std::strlen(message.preamble)
+               + std::strlen(message.message) + 16);
+  line += state->rank_prefix;
+  line += message.preamble;
+  line += message.indentation;
+  line += message.prefix;
+  line += message.message;
+  if (!state->ring.push(std::move(line)))
+    state->dropped.fetch_add(1, std::memory_order_relaxed);
+  state->wake.notify_one();
+}
+//-----------------------------------------------------------------------------
+void async_flush_handler(void* user_data)
+{
+  auto* state = static_cast<AsyncLogState*>(user_data);
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->wake.notify_one();
+  state->drained.wait(lock, [state] {
+    return state->quiescent and state->ring.empty();
+  });
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+void dolfinx::common::enable_async_logging(const std::string& path)
+{
+  if (async_state)
+    return;
+
+  auto state = std::make_unique<AsyncLogState>();
+  if (path.empty())
+    state->sink = stderr;
+  else
+  {
+    state->sink = std::fopen(path.c_str(), "a");
+    if (!state->sink)
+      throw std::runtime_error("Cannot open log file " + path);
+    state->own_sink = true;
+  }
+
+  // Prefix each line with the rank and demote the verbosity of ranks
+  // other than 0 so per-step INFO logging only writes from rank 0
+  int rank = 0;
+  int mpi_initialized = 0;
+  MPI_Initialized(&mpi_initialized);
+  if (mpi_initialized)
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  state->rank_prefix = "[rank " + std::to_string(rank) + "] ";
+  const loguru::Verbosity verbosity
+      = rank == 0 ? loguru::g_stderr_verbosity
+                  : std::min<loguru::Verbosity>(loguru::g_stderr_verbosity,
+                                                loguru::Verbosity_WARNING);
+
+  // The async sink replaces the synchronous stderr path
+  state->saved_stderr_verbosity = loguru::g_stderr_verbosity;
+  loguru::g_stderr_verbosity = loguru::Verbosity_OFF;
+
+  state->writer = std::thread(writer_loop, state.get());
+  async_state = state.release();
+  loguru::add_callback("dolfinx.async_log", async_log_handler, async_state,
+                       verbosity, nullptr, async_flush_handler);
+}
+//-----------------------------------------------------------------------------
+void dolfinx::common::disable_async_logging()
+{
+  if (!async_state)
+    return;
+
+  loguru::remove_callback("dolfinx.async_log");
+
+  AsyncLogState* state = async_state;
+  async_state = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->shutdown = true;
+  }
+  state->wake.notify_one();
+  state->writer.join();
+
+  const std::size_t dropped = state->dropped.load(std::memory_order_relaxed);
+  if (dropped > 0)
+  {
+    std::fprintf(state->sink,
+                 "%s%zu log message(s) dropped by the async log writer\n",
+                 state->rank_prefix.c_str(), dropped);
+    std::fflush(state->sink);
+  }
+  if (state->own_sink)
+    std::fclose(state->sink);
+
+  loguru::g_stderr_verbosity = state->saved_stderr_verbosity;
+  delete state;
+}
+//-----------------------------------------------------------------------------
+void dolfinx::common::flush_async_logging()
+{
+  if (async_state)
+    async_flush_handler(async_state);
+}
+//-----------------------------------------------------------------------------
@@ -10,3 +10,36 @@
 #define LOGURU_REPLACE_GLOG 1
 
 #include "loguru.hpp"
+#include <string>
+
+namespace dolfinx::common
+{
+
+/// Switch log output to an asynchronous background writer. Log calls
+/// (LOG(INFO) etc.) format the message and push it onto a bounded
+/// lock-free ring buffer; a background thread drains the ring and
+/// writes rank-prefixed lines in batches, one write and one flush per
+/// batch. The logging threads never wait on the sink, so a slow or
+/// contended log file cannot stall the caller and propagate into the
+/// next collective. If the ring fills faster than the writer drains
+/// it, messages are dropped and the drop count is reported when async
+/// logging is disabled.
+///
+/// On ranks other than 0 the verbosity of the sink is demoted to
+/// WARNING, so per-step INFO logging at scale only writes from rank 0.
+/// While async logging is enabled the synchronous stderr output is
+/// turned off; disable_async_logging restores it.
+/// @param[in] path File to append log output to. An empty path writes
+///   to stderr.
+void enable_async_logging(const std::string& path = std::string());
+
+/// Drain the ring, stop the background writer and restore synchronous
+/// logging. No-op when async logging is not enabled.
+void disable_async_logging();
+
+/// Block until every message enqueued so far has been written to the
+/// sink, e.g. before timing a critical section or aborting. No-op when
+/// async logging is not enabled.
+void flush_async_logging();
+
+} // namespace dolfinx::common
@@ -29,6 +29,21 @@ void dolfinx::list_timings(MPI_Comm mpi_comm, std::set<TimingType> type)
   TimeLogManager::logger().list_timings(mpi_comm, type);
 }
 //-----------------------------------------------------------------------------
+Table dolfinx::timings_imbalance(MPI_Comm mpi_comm)
+{
+  return TimeLogManager::logger().timings_imbalance(mpi_comm);
+}
+//-----------------------------------------------------------------------------
+std::string dolfinx::timings_csv(MPI_Comm mpi_comm)
+{
+  return TimeLogManager::logger().timings_csv(mpi_comm);
+}
+//-----------------------------------------------------------------------------
+std::string dolfinx::trace_json(MPI_Comm mpi_comm)
+{
+  return TimeLogManager::logger().trace_json(mpi_comm);
+}
+//-----------------------------------------------------------------------------
 std::tuple<std::size_t, double, double, double> dolfinx::timing(std::string task)
 {
   return TimeLogManager::logger().timing(task);
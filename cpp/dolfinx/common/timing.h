@@ -40,6 +40,30 @@ Table timings(std::set<TimingType> type);
 ///                 TimingType::system }
 void list_timings(MPI_Comm mpi_comm, std::set<TimingType> type);
 
+/// Return a table of load-imbalance statistics for the total wall time
+/// of each task across the communicator: average, minimum, maximum,
+/// the rank holding the maximum, and the imbalance ratio max/avg.
+/// Collective; all ranks get the same table.
+/// @param[in] mpi_comm MPI Communicator
+/// @returns Table with imbalance statistics
+Table timings_imbalance(MPI_Comm mpi_comm);
+
+/// Return the per-rank timings as CSV text (columns task, rank, reps,
+/// wall), for offline imbalance analysis. Collective; the returned
+/// string is non-empty only on rank 0.
+/// @param[in] mpi_comm MPI Communicator
+/// @returns CSV text on rank 0, empty string otherwise
+std::string timings_csv(MPI_Comm mpi_comm);
+
+/// Return the timeline of completed timed phases in the chrome-tracing
+/// JSON format (load into chrome://tracing or Perfetto), one process
+/// row per MPI rank, so phase overlap, nesting and per-rank skew can
+/// be inspected directly. Collective; the returned string is non-empty
+/// only on rank 0.
+/// @param[in] mpi_comm MPI Communicator
+/// @returns Trace JSON on rank 0, empty string otherwise
+std::string trace_json(MPI_Comm mpi_comm);
+
 /// Return timing (count, total wall time, total user time, total system
 /// time) for given task.
 /// @param[in] task Name of a task
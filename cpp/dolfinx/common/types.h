@@ -9,6 +9,10 @@
 #include <cstdint>
 #include <petscsys.h>
 
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 // Typedefs for ufc_scalar
 #ifdef PETSC_USE_COMPLEX
 #include <complex>
@@ -16,3 +20,46 @@ using ufc_scalar_t = std::complex<double>;
 #else
 using ufc_scalar_t = double;
 #endif
+
+namespace dolfinx
+{
+
+/// Process-local entity/dof index. 32-bit by default: local indices
+/// fill the hot assembly and connectivity loops, and the narrower
+/// type halves their memory traffic. Configure with
+/// -DDOLFINX_LOCAL_INDEX_64=ON for runs holding more than 2^31
+/// entities on a single process.
+#ifdef DOLFINX_LOCAL_INDEX_64
+using local_index_t = std::int64_t;
+#else
+using local_index_t = std::int32_t;
+#endif
+
+/// Global (distributed) entity/dof index; always 64-bit
+using global_index_t = std::int64_t;
+
+namespace common
+{
+/// Checked conversion of a 64-bit count or global index to the local
+/// index type: the named conversion point between the global and the
+/// (default 32-bit) local indexing. Size computations should be
+/// carried out in 64 bits and narrowed here, so approaching the
+/// 2^31 local entity limit throws instead of silently wrapping. The
+/// check is a single predictable branch, cheap at loop-setup
+/// granularity; inside hot loops use local_index_t throughout and
+/// convert outside.
+/// @param[in] n Non-negative count or index to narrow
+/// @return The value as a local index
+inline local_index_t narrow_index(std::int64_t n)
+{
+  if (n < 0 or n > std::numeric_limits<local_index_t>::max())
+  {
+    throw std::runtime_error("Index " + std::to_string(n)
+                             + " out of range for the local index type. "
+                               "Rebuild with DOLFINX_LOCAL_INDEX_64 for more "
+                               "than 2^31 local entities.");
+  }
+  return static_cast<local_index_t>(n);
+}
+} // namespace common
+} // namespace dolfinx
@@ -7,6 +7,11 @@
 #include "utils.h"
 #include <cstdlib>
 #include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 //-----------------------------------------------------------------------------
 std::string dolfinx::common::indent(std::string block)
@@ -25,3 +30,34 @@ std::string dolfinx::common::indent(std::string block)
   return s.str();
 }
 //-----------------------------------------------------------------------------
+int dolfinx::common::num_worker_threads()
+{
+  static const int num_threads = []() {
+    const char* env = std::getenv("DOLFINX_NUM_THREADS");
+    if (!env)
+      return 1;
+    int n = std::atoi(env);
+    if (n < 1)
+      return 1;
+
+    // Clamp to the CPUs actually available to this process, so MPI
+    // launcher binding and cpusets are respected and ranks do not
+    // oversubscribe their slots
+#ifdef __linux__
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+    {
+      const int num_cpus = CPU_COUNT(&mask);
+      if (num_cpus > 0 and n > num_cpus)
+        n = num_cpus;
+    }
+#else
+    const int num_cpus = std::thread::hardware_concurrency();
+    if (num_cpus > 0 and n > num_cpus)
+      n = num_cpus;
+#endif
+    return n;
+  }();
+  return num_threads;
+}
+//-----------------------------------------------------------------------------
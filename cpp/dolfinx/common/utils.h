@@ -10,6 +10,7 @@
 #include <boost/functional/hash.hpp>
 #include <cstring>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <limits>
 #include <mpi.h>
 #include <sstream>
@@ -58,6 +59,77 @@ std::pair<U, V> sort_unique(const U& indices, const V& values)
 /// Indent string block
 std::string indent(std::string block);
 
+/// Number of worker threads to use for thread-parallel loops.
+/// Controlled by the DOLFINX_NUM_THREADS environment variable, clamped
+/// to the number of CPUs in this process's affinity mask so that MPI
+/// launcher binding and cpusets are respected; returns 1 (serial) if
+/// the variable is not set, which is the right default when running
+/// one MPI rank per core.
+int num_worker_threads();
+
+/// Run f(begin, end) over [0, n) split across the process-wide thread
+/// pool (see ThreadPool), sized by DOLFINX_NUM_THREADS. The ranges are
+/// disjoint, so f must only write to positions derived from its own
+/// range, and f must not throw. Runs serially for small n or when one
+/// thread is configured.
+template <typename F>
+void parallel_for(std::int32_t n, F&& f)
+{
+  ThreadPool& pool = global_thread_pool();
+  if (pool.size() <= 1 or n < 1024)
+  {
+    f(0, n);
+    return;
+  }
+
+  // Several chunks per thread so that the pool's self-scheduling can
+  // balance ranges of uneven cost
+  const std::int32_t num_chunks
+      = std::min(n, static_cast<std::int32_t>(4 * pool.size()));
+  const std::int32_t chunk = (n + num_chunks - 1) / num_chunks;
+  pool.run(num_chunks, [n, chunk, &f](int t) {
+    const std::int32_t begin = t * chunk;
+    const std::int32_t end = std::min(n, begin + chunk);
+    if (begin < end)
+      f(begin, end);
+  });
+}
+
+/// Reduce f(begin, end) over [0, n) split across the process-wide
+/// thread pool. f returns the partial result for its range and partial
+/// results are combined with op (in unspecified order, so op should be
+/// associative and commutative), starting from @p init. Runs serially
+/// for small n or when one thread is configured.
+/// @param[in] n Iteration count
+/// @param[in] init Identity element of the reduction
+/// @param[in] f Function mapping a range [begin, end) to its partial
+///   result
+/// @param[in] op Binary operation combining two partial results
+/// @return The reduction of f over [0, n)
+template <typename T, typename F, typename Op>
+T parallel_reduce(std::int32_t n, T init, F&& f, Op&& op)
+{
+  ThreadPool& pool = global_thread_pool();
+  if (pool.size() <= 1 or n < 1024)
+    return n > 0 ? op(init, f(0, n)) : init;
+
+  const std::int32_t num_chunks
+      = std::min(n, static_cast<std::int32_t>(4 * pool.size()));
+  const std::int32_t chunk = (n + num_chunks - 1) / num_chunks;
+  std::vector<T> partial(num_chunks, init);
+  pool.run(num_chunks, [n, chunk, &f, &partial](int t) {
+    const std::int32_t begin = t * chunk;
+    const std::int32_t end = std::min(n, begin + chunk);
+    if (begin < end)
+      partial[t] = f(begin, end);
+  });
+
+  T result = init;
+  for (const T& p : partial)
+    result = op(result, p);
+  return result;
+}
+
 /// Return string representation of given container of ints, floats,
 /// etc.
 template <typename T>
@@ -0,0 +1,39 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "AssemblyTrace.h"
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+namespace
+{
+bool trace_enabled = false;
+
+std::vector<std::int32_t>& trace()
+{
+  static std::vector<std::int32_t> cells;
+  return cells;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+void AssemblyTrace::enable() { trace_enabled = true; }
+//-----------------------------------------------------------------------------
+void AssemblyTrace::disable() { trace_enabled = false; }
+//-----------------------------------------------------------------------------
+bool AssemblyTrace::enabled() { return trace_enabled; }
+//-----------------------------------------------------------------------------
+void AssemblyTrace::record(const std::vector<std::int32_t>& cells)
+{
+  if (trace_enabled)
+    trace().insert(trace().end(), cells.begin(), cells.end());
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& AssemblyTrace::cells() { return trace(); }
+//-----------------------------------------------------------------------------
+void AssemblyTrace::clear() { trace().clear(); }
+//-----------------------------------------------------------------------------
@@ -0,0 +1,60 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx::fem
+{
+
+/// Recorder for the cell access sequence of the assembly drivers, for
+/// profiling-guided cell reordering. When enabled, each cell batch
+/// handed to an assembly loop (the sequence of per-cell dof gathers)
+/// is appended to a per-process trace. The trace feeds
+/// graph::AccessOrdering::compute_blocked, which computes a
+/// locality-optimized cell permutation from the accesses actually
+/// performed — on meshes with mixed cell sizes or multiple integral
+/// domains this captures locality the static dual-graph orderings
+/// (reverse Cuthill-McKee, space-filling curves) cannot see.
+///
+/// Usage:
+///
+///   fem::AssemblyTrace::enable();
+///   ... representative assembly calls ...
+///   fem::AssemblyTrace::disable();
+///   auto perm = graph::AccessOrdering::compute_blocked(
+///       dofmap, fem::AssemblyTrace::cells(), num_owned_cells);
+///   mesh::Mesh mesh2 = mesh::reorder_cells(mesh, perm);
+///
+/// Recording is per-process state, like the counters registry; it is
+/// not thread-safe, so record with a single worker thread.
+
+class AssemblyTrace
+{
+public:
+  /// Start recording cell accesses
+  static void enable();
+
+  /// Stop recording; the trace is kept until clear()
+  static void disable();
+
+  /// True while recording is on
+  static bool enabled();
+
+  /// Append a cell batch to the trace (called by the assembly drivers
+  /// once per integral; a no-op unless recording is on)
+  /// @param[in] cells The cells in traversal order
+  static void record(const std::vector<std::int32_t>& cells);
+
+  /// The recorded cell access sequence
+  static const std::vector<std::int32_t>& cells();
+
+  /// Discard the recorded trace
+  static void clear();
+};
+} // namespace dolfinx::fem
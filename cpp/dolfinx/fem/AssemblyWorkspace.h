@@ -0,0 +1,73 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace fem
+{
+
+/// Reusable scratch storage for assembly. Construct once and pass to
+/// the assembly entry points (fem::assemble_matrix,
+/// fem::assemble_vector) when assembling repeatedly, e.g. every Newton
+/// iteration or time step. The buffers grow to the size required by the
+/// first assembly and are then reused, so steady-state assembly
+/// performs no heap allocation. A workspace may be shared between forms
+/// and between matrix and vector assembly, but not between threads.
+
+struct AssemblyWorkspace
+{
+  /// Packed coefficient array (num_cells x total coefficient size)
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coeffs;
+
+  /// Coefficient vector versions (PETSc object states) recorded when
+  /// coeffs was packed. Repacking is skipped while the versions match.
+  /// Note: versions are only meaningful while the workspace is used
+  /// with a single form.
+  std::vector<std::uint64_t> coeff_versions;
+
+  /// Packed constants array
+  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants;
+
+  /// Cell geometry scratch (num coordinate dofs x gdim)
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs;
+
+  /// Element matrix scratch
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae;
+
+  /// Element vector scratch
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
+};
+
+/// Cache of per-cell element tensors used by incremental re-assembly
+/// (fem::assemble_matrix_incremental). The cache records the element
+/// tensor inserted for each cell so that a later update can subtract
+/// the stale contribution before adding the new one. A cache is tied to
+/// one form and one matrix; it is invalidated by clear().
+
+struct CellTensorCache
+{
+  /// Cached element tensors, one row per cell (flattened row-major
+  /// element tensor). Empty until the first (full) assembly.
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values;
+
+  /// Discard all cached tensors. The next incremental assembly then
+  /// performs a full assembly.
+  void clear() { values.resize(0, 0); }
+};
+
+} // namespace fem
+} // namespace dolfinx
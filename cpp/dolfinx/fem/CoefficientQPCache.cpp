@@ -0,0 +1,139 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CoefficientQPCache.h"
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "Form.h"
+#include "FormCoefficients.h"
+#include <cassert>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/utils.h>
+#include <dolfinx/function/Function.h>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/la/PETScVector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <stdexcept>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+//-----------------------------------------------------------------------------
+CoefficientQPCache::CoefficientQPCache(
+    const Form& form,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& X)
+    : _num_points(X.rows())
+{
+  const fem::FormCoefficients& coefficients = form.coefficients();
+  std::shared_ptr<const mesh::Mesh> mesh = form.mesh();
+  assert(mesh);
+  const int tdim = mesh->topology().dim();
+  auto map = mesh->topology().index_map(tdim);
+  assert(map);
+  _num_cells = map->size_local() + map->num_ghosts();
+
+  // Tabulate the reference basis of each coefficient's element at the
+  // points and flatten to a (num_points * value_size) x space_dimension
+  // matrix, so the values on a cell are a single matrix-vector product
+  // with the cell's expansion coefficients
+  _coefficients.resize(coefficients.size());
+  _basis.resize(coefficients.size());
+  _offsets = {0};
+  for (int i = 0; i < coefficients.size(); ++i)
+  {
+    _coefficients[i] = coefficients.get(i);
+    assert(_coefficients[i]);
+    std::shared_ptr<const fem::FiniteElement> element
+        = _coefficients[i]->function_space()->element();
+    assert(element);
+    if (element->value_size() != element->reference_value_size())
+    {
+      throw std::runtime_error(
+          "CoefficientQPCache requires elements whose physical and "
+          "reference values coincide.");
+    }
+
+    const int nd = element->space_dimension();
+    const int vs = element->value_size();
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis(_num_points, nd, vs);
+    element->evaluate_reference_basis(basis, X);
+
+    _basis[i].resize(_num_points * vs, nd);
+    for (int p = 0; p < _num_points; ++p)
+      for (int k = 0; k < nd; ++k)
+        for (int v = 0; v < vs; ++v)
+          _basis[i](p * vs + v, k) = basis(p, k, v);
+
+    _offsets.push_back(_offsets.back() + _num_points * vs);
+  }
+
+  _w.resize(_num_cells, _offsets.back());
+  update();
+}
+//-----------------------------------------------------------------------------
+void CoefficientQPCache::update()
+{
+  for (std::size_t i = 0; i < _coefficients.size(); ++i)
+  {
+    // Skip coefficients whose vector has not been modified since the
+    // last evaluation. PETSc bumps the object state whenever vector
+    // entries change.
+    PetscObjectState state;
+    PetscObjectStateGet((PetscObject)_coefficients[i]->vector().vec(), &state);
+    if (i < _versions.size() and _versions[i] == (std::uint64_t)state)
+      continue;
+
+    std::shared_ptr<const fem::DofMap> dofmap
+        = _coefficients[i]->function_space()->dofmap();
+    assert(dofmap);
+
+    Vec x = _coefficients[i]->vector().vec();
+    Vec x_local = nullptr;
+    VecGhostGetLocalForm(x, &x_local);
+    const PetscScalar* v = nullptr;
+    VecGetArrayRead(x_local, &v);
+
+    const Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>& basis
+        = _basis[i];
+    const int len = _offsets[i + 1] - _offsets[i];
+    const int offset = _offsets[i];
+    common::parallel_for(_num_cells, [&](std::int32_t begin, std::int32_t end) {
+      Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> d(basis.cols());
+      Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dofs;
+      for (std::int32_t cell = begin; cell < end; ++cell)
+      {
+        dofmap->cell_dofs(cell, dofs);
+        assert(dofs.size() == basis.cols());
+        for (Eigen::Index k = 0; k < dofs.size(); ++k)
+          d[k] = v[dofs[k]];
+        Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> values(
+            _w.data() + std::size_t(cell) * _w.cols() + offset, len);
+        values.noalias() = basis * d;
+      }
+    });
+
+    VecRestoreArrayRead(x_local, &v);
+    VecGhostRestoreLocalForm(x, &x_local);
+
+    if (i >= _versions.size())
+      _versions.resize(i + 1, 0);
+    _versions[i] = state;
+  }
+}
+//-----------------------------------------------------------------------------
+int CoefficientQPCache::num_points() const { return _num_points; }
+//-----------------------------------------------------------------------------
+const std::vector<int>& CoefficientQPCache::offsets() const { return _offsets; }
+//-----------------------------------------------------------------------------
+const PetscScalar* CoefficientQPCache::w(std::int32_t cell) const
+{
+  return _w.data() + std::size_t(cell) * _w.cols();
+}
+//-----------------------------------------------------------------------------
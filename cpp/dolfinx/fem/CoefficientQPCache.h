@@ -0,0 +1,103 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+
+namespace function
+{
+class Function;
+}
+
+namespace fem
+{
+class Form;
+
+/// Cache of form coefficient values at a fixed set of reference
+/// (quadrature) points, for every cell of the mesh.
+///
+/// Kernels interpolate each coefficient from its expansion
+/// coefficients to the quadrature points on every cell of every
+/// assembly, even when the coefficient never changes (e.g. material
+/// fields). This cache evaluates the coefficients at the given
+/// reference points once and kernels that opt into the quadrature-point
+/// signature (see FormIntegrals::set_qp_tabulate_tensor) read the
+/// cached values instead of re-tabulating. update() re-evaluates only
+/// the coefficients whose vector has been modified since the last
+/// update, tracked through the PETSc object state, so a
+/// constant-in-time coefficient is interpolated exactly once.
+///
+/// The values are computed from the reference basis, so only elements
+/// whose physical and reference values coincide (e.g. Lagrange) are
+/// supported. The reference points must match the quadrature points of
+/// the kernels that consume the cache.
+
+class CoefficientQPCache
+{
+public:
+  /// Create a cache for the coefficients of a form and evaluate them
+  /// @param[in] form The form whose coefficients to cache
+  /// @param[in] X Points on the reference cell (shape num_points x
+  ///              tdim) at which to evaluate the coefficients, i.e. the
+  ///              quadrature points of the kernels that will consume
+  ///              the cache
+  CoefficientQPCache(const Form& form,
+                     const Eigen::Ref<const Eigen::Array<
+                         double, Eigen::Dynamic, Eigen::Dynamic,
+                         Eigen::RowMajor>>& X);
+
+  /// Re-evaluate coefficients whose vector has been modified since the
+  /// last update. A no-op when no coefficient has changed.
+  void update();
+
+  /// Number of reference points per cell
+  int num_points() const;
+
+  /// Offset of each coefficient's values within a cell row. Coefficient
+  /// i occupies entries [offsets[i], offsets[i+1]) in the layout
+  /// w[point][value_component]; the last entry is the row width.
+  const std::vector<int>& offsets() const;
+
+  /// Cached coefficient values for a cell (see offsets() for the
+  /// layout)
+  const PetscScalar* w(std::int32_t cell) const;
+
+private:
+  // The coefficients, kept so update() can re-read modified vectors
+  std::vector<std::shared_ptr<const function::Function>> _coefficients;
+
+  // Reference basis evaluated at the points, one matrix per
+  // coefficient of shape (num_points * value_size) x space_dimension,
+  // so values = basis * expansion_coefficients per cell
+  std::vector<
+      Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                    Eigen::RowMajor>>
+      _basis;
+
+  // Value offsets of each coefficient within a cell row
+  std::vector<int> _offsets;
+
+  // Coefficient vector versions (PETSc object states) at the last
+  // evaluation; a mismatch triggers re-evaluation in update()
+  std::vector<std::uint64_t> _versions;
+
+  int _num_points;
+  std::int32_t _num_cells;
+
+  // Cached values, one row per cell
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      _w;
+};
+} // namespace fem
+} // namespace dolfinx
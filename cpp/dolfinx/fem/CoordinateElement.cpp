@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "CoordinateElement.h"
+#include <cmath>
 #include <unsupported/Eigen/CXX11/Tensor>
 
 using namespace dolfinx;
@@ -25,6 +26,15 @@ CoordinateElement::CoordinateElement(
       _compute_physical_coordinates(compute_physical_coordinates),
       _compute_reference_geometry(compute_reference_geometry)
 {
+  // The map is affine if the cell is a simplex and the geometry
+  // degrees-of-freedom sit on the vertices only
+  _is_affine = mesh::is_simplex(cell_type)
+               and dof_layout.num_entity_dofs(0) == 1;
+  for (int d = 1; d <= _tdim; ++d)
+  {
+    if (dof_layout.num_entity_dofs(d) > 0)
+      _is_affine = false;
+  }
 }
 //-----------------------------------------------------------------------------
 std::string CoordinateElement::signature() const { return _signature; }
@@ -40,6 +50,8 @@ const ElementDofLayout& CoordinateElement::dof_layout() const
   return _dof_layout;
 }
 //-----------------------------------------------------------------------------
+bool CoordinateElement::is_affine() const { return _is_affine; }
+//-----------------------------------------------------------------------------
 void CoordinateElement::push_forward(
     Eigen::Ref<
         Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
@@ -86,6 +98,53 @@ void CoordinateElement::compute_reference_geometry(
   assert(K.dimension(1) == this->topological_dimension());
   assert(K.dimension(2) == this->geometric_dimension());
 
+  // Fast path for affine maps: the Jacobian is constant on the cell,
+  // so invert it once and pull back the whole batch of points in a
+  // single matrix product, skipping the generated (Newton) pull-back
+  if (_is_affine)
+  {
+    // Column j of the Jacobian is the difference between vertex j + 1
+    // and vertex 0
+    Eigen::MatrixXd Jc(_gdim, _tdim);
+    for (int j = 0; j < _tdim; ++j)
+    {
+      Jc.col(j)
+          = (cell_geometry.row(j + 1) - cell_geometry.row(0)).matrix()
+                .transpose();
+    }
+
+    Eigen::MatrixXd Kc(_tdim, _gdim);
+    double det;
+    if (_gdim == _tdim)
+    {
+      det = Jc.determinant();
+      Kc = Jc.inverse();
+    }
+    else
+    {
+      // Pseudo-inverse for cells embedded in a higher dimension
+      const Eigen::MatrixXd JTJ = Jc.transpose() * Jc;
+      det = std::sqrt(JTJ.determinant());
+      Kc = JTJ.inverse() * Jc.transpose();
+    }
+
+    // X = K (x - x0) for all points at once
+    X = ((x.rowwise() - cell_geometry.row(0)).matrix() * Kc.transpose())
+            .array();
+
+    for (int p = 0; p < num_points; ++p)
+    {
+      detJ[p] = det;
+      for (int i = 0; i < _gdim; ++i)
+        for (int j = 0; j < _tdim; ++j)
+          J(p, i, j) = Jc(i, j);
+      for (int i = 0; i < _tdim; ++i)
+        for (int j = 0; j < _gdim; ++j)
+          K(p, i, j) = Kc(i, j);
+    }
+    return;
+  }
+
   assert(_compute_reference_geometry);
   _compute_reference_geometry(X.data(), J.data(), detJ.data(), K.data(),
                               num_points, x.data(), cell_geometry.data());
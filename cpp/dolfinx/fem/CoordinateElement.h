@@ -63,6 +63,13 @@ public:
   /// Return the dof layout
   const ElementDofLayout& dof_layout() const;
 
+  /// Check whether the coordinate map is affine, i.e. the cell is a
+  /// straight-sided simplex. For affine maps the pull-back in
+  /// compute_reference_geometry is computed directly from the constant
+  /// Jacobian for the whole batch of points, skipping the generated
+  /// Newton iteration.
+  bool is_affine() const;
+
   /// Compute physical coordinates x for points X  in the reference
   /// configuration
   /// @param[in,out] x The physical coordinates of the reference points X
@@ -96,6 +103,9 @@ private:
 
   mesh::CellType _cell;
 
+  // True if the coordinate map is affine (straight-sided simplex)
+  bool _is_affine;
+
   std::string _signature;
 
   ElementDofLayout _dof_layout;
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <array>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
@@ -220,10 +221,17 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 2> _locate_dofs_topological(
   assert(dofmap0);
   assert(dofmap1);
 
-  // Initialise entity-cell connectivity
+  // Initialise entity-cell connectivity. For facets the fixed-width
+  // facet -> cell array is used: the cell query is a single indexed
+  // load with no offsets lookup.
   // FIXME: cleanup these calls? Some of the happen internally again.
+  const bool use_facet_cells = (dim == tdim - 1);
   mesh->topology_mutable().create_entities(tdim);
   mesh->topology_mutable().create_connectivity(dim, tdim);
+  if (use_facet_cells)
+    mesh->topology_mutable().create_facet_cell_connectivity();
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 2, Eigen::RowMajor>*
+      f_cells = use_facet_cells ? &mesh->topology().facet_cells() : nullptr;
 
   // Allocate space
   assert(dofmap0->element_dof_layout);
@@ -243,33 +251,42 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 2> _locate_dofs_topological(
   auto c_to_e = mesh->topology().connectivity(tdim, dim);
   assert(c_to_e);
 
-  // Iterate over marked facets
-  std::vector<std::array<std::int32_t, 2>> bc_dofs;
-  for (Eigen::Index e = 0; e < entities.rows(); ++e)
-  {
-    // Get first attached cell
-    assert(e_to_c->num_links(entities[e]) > 0);
-    const int cell = e_to_c->links(entities[e])[0];
-
-    // Get local index of facet with respect to the cell
-    auto entities_d = c_to_e->links(cell);
-    const auto *it = std::find(entities_d.data(),
-                        entities_d.data() + entities_d.rows(), entities[e]);
-    assert(it != (entities_d.data() + entities_d.rows()));
-    const int entity_local_index = std::distance(entities_d.data(), it);
-
-    // Get cell dofmap
-    auto cell_dofs0 = dofmap0->cell_dofs(cell);
-    auto cell_dofs1 = dofmap1->cell_dofs(cell);
-
-    // Loop over facet dofs
-    for (int i = 0; i < num_entity_dofs; ++i)
-    {
-      const int index = entity_dofs[entity_local_index][i];
-      bc_dofs.push_back(
-          {(std::int32_t)cell_dofs0[index], (std::int32_t)cell_dofs1[index]});
-    }
-  }
+  // Iterate over marked facets across worker threads; each marked
+  // facet writes a disjoint slice of bc_dofs
+  std::vector<std::array<std::int32_t, 2>> bc_dofs(entities.rows()
+                                                   * num_entity_dofs);
+  common::parallel_for(
+      entities.rows(), [&](std::int32_t begin, std::int32_t end) {
+        Eigen::Array<std::int32_t, Eigen::Dynamic, 1> cell_dofs0, cell_dofs1;
+        for (std::int32_t e = begin; e < end; ++e)
+        {
+          // Get first attached cell
+          assert(e_to_c->num_links(entities[e]) > 0);
+          const int cell = f_cells ? (*f_cells)(entities[e], 0)
+                                   : e_to_c->links(entities[e])[0];
+
+          // Get local index of facet with respect to the cell
+          auto entities_d = c_to_e->links(cell);
+          const auto* it
+              = std::find(entities_d.data(),
+                          entities_d.data() + entities_d.rows(), entities[e]);
+          assert(it != (entities_d.data() + entities_d.rows()));
+          const int entity_local_index = std::distance(entities_d.data(), it);
+
+          // Get cell dofmap
+          dofmap0->cell_dofs(cell, cell_dofs0);
+          dofmap1->cell_dofs(cell, cell_dofs1);
+
+          // Loop over facet dofs
+          for (int i = 0; i < num_entity_dofs; ++i)
+          {
+            const int index = entity_dofs[entity_local_index][i];
+            bc_dofs[e * num_entity_dofs + i]
+                = {(std::int32_t)cell_dofs0[index],
+                   (std::int32_t)cell_dofs1[index]};
+          }
+        }
+      });
 
   // TODO: is removing duplicates at this point worth the effort?
   // Remove duplicates
@@ -312,58 +329,25 @@ _locate_dofs_topological(const function::FunctionSpace& V, const int entity_dim,
 {
   assert(V.dofmap());
   std::shared_ptr<const DofMap> dofmap = V.dofmap();
-  assert(V.mesh());
-  std::shared_ptr<const mesh::Mesh> mesh = V.mesh();
-
-  const int tdim = mesh->topology().dim();
-
-  // Initialise entity-cell connectivity
-  // FIXME: cleanup these calls? Some of the happen internally again.
-  mesh->topology_mutable().create_entities(tdim);
-  mesh->topology_mutable().create_connectivity(entity_dim, tdim);
-
-  // Prepare an element - local dof layout for dofs on entities of the
-  // entity_dim
-  const int num_cell_entities
-      = mesh::cell_num_entities(mesh->topology().cell_type(), entity_dim);
-  std::vector<Eigen::Array<int, Eigen::Dynamic, 1>> entity_dofs;
-  for (int i = 0; i < num_cell_entities; ++i)
-  {
-    entity_dofs.push_back(
-        dofmap->element_dof_layout->entity_closure_dofs(entity_dim, i));
-  }
-
-  auto e_to_c = mesh->topology().connectivity(entity_dim, tdim);
-  assert(e_to_c);
-  auto c_to_e = mesh->topology().connectivity(tdim, entity_dim);
-  assert(c_to_e);
 
+  // Get the (cached) entity-to-closure-dofs map and gather the dofs of
+  // the marked entities across worker threads; each marked entity
+  // writes a disjoint slice of dofs
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> ent_dofs
+      = V.entity_closure_dofs(entity_dim);
+  assert(ent_dofs);
   const int num_entity_closure_dofs
       = dofmap->element_dof_layout->num_entity_closure_dofs(entity_dim);
-  std::vector<std::int32_t> dofs;
-  for (Eigen::Index i = 0; i < entities.rows(); ++i)
-  {
-    // Get first attached cell
-    assert(e_to_c->num_links(entities[i]) > 0);
-    const int cell = e_to_c->links(entities[i])[0];
-
-    // Get local index of facet with respect to the cell
-    auto entities_d = c_to_e->links(cell);
-    const auto *it = std::find(entities_d.data(),
-                        entities_d.data() + entities_d.rows(), entities[i]);
-    assert(it != (entities_d.data() + entities_d.rows()));
-    const int entity_local_index = std::distance(entities_d.data(), it);
-
-    // Get cell dofmap
-    auto cell_dofs = dofmap->cell_dofs(cell);
-
-    // Loop over entity dofs
-    for (int j = 0; j < num_entity_closure_dofs; j++)
-    {
-      const int index = entity_dofs[entity_local_index][j];
-      dofs.push_back(cell_dofs[index]);
-    }
-  }
+  std::vector<std::int32_t> dofs(entities.rows() * num_entity_closure_dofs);
+  common::parallel_for(
+      entities.rows(), [&](std::int32_t begin, std::int32_t end) {
+        for (std::int32_t i = begin; i < end; ++i)
+        {
+          auto entity_dofs = ent_dofs->links(entities[i]);
+          for (int j = 0; j < num_entity_closure_dofs; ++j)
+            dofs[i * num_entity_closure_dofs + j] = entity_dofs[j];
+        }
+      });
 
   // TODO: is removing duplicates at this point worth the effort?
   // Remove duplicates
@@ -543,10 +527,11 @@ DirichletBC::DirichletBC(
   _dofs.col(0) = V_dofs;
   _dofs.col(1) = V_dofs;
 
-  const int owned_size = _function_space->dofmap()->index_map->block_size()
-                         * _function_space->dofmap()->index_map->size_local();
+  auto map = _function_space->dofmap()->index_map;
+  _owned_size = map->block_size() * map->size_local();
+  _local_size = map->block_size() * (map->size_local() + map->num_ghosts());
   auto *it = std::lower_bound(_dofs.col(0).data(),
-                             _dofs.col(0).data() + _dofs.rows(), owned_size);
+                             _dofs.col(0).data() + _dofs.rows(), _owned_size);
   _owned_indices = std::distance(_dofs.col(0).data(), it);
 }
 //-----------------------------------------------------------------------------
@@ -557,11 +542,44 @@ DirichletBC::DirichletBC(
     std::shared_ptr<const function::FunctionSpace> V)
     : _function_space(V), _g(g), _dofs(V_g_dofs)
 {
-  const int owned_size = _function_space->dofmap()->index_map->block_size()
-                         * _function_space->dofmap()->index_map->size_local();
+  auto map = _function_space->dofmap()->index_map;
+  _owned_size = map->block_size() * map->size_local();
+  _local_size = map->block_size() * (map->size_local() + map->num_ghosts());
   auto *it = std::lower_bound(_dofs.col(0).data(),
-                             _dofs.col(0).data() + _dofs.rows(), owned_size);
+                             _dofs.col(0).data() + _dofs.rows(), _owned_size);
+  _owned_indices = std::distance(_dofs.col(0).data(), it);
+}
+//-----------------------------------------------------------------------------
+DirichletBC::DirichletBC(
+    std::shared_ptr<const function::FunctionSpace> V,
+    const std::function<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>(
+        const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
+                                            Eigen::RowMajor>>&)>& g,
+    const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& dofs)
+    : _function_space(V), _dofs(dofs.rows(), 2)
+{
+  _dofs.col(0) = dofs;
+  _dofs.col(1) = dofs;
+
+  auto map = _function_space->dofmap()->index_map;
+  _owned_size = map->block_size() * map->size_local();
+  _local_size = map->block_size() * (map->size_local() + map->num_ghosts());
+  auto* it = std::lower_bound(_dofs.col(0).data(),
+                              _dofs.col(0).data() + _dofs.rows(), _owned_size);
   _owned_indices = std::distance(_dofs.col(0).data(), it);
+
+  // Evaluate g at the boundary dof coordinates only, rather than
+  // interpolating it into a Function over the whole space
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x
+      = _function_space->tabulate_dof_coordinates();
+  Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor> x_bc(3,
+                                                                _dofs.rows());
+  for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
+    x_bc.col(i) = x.row(_dofs(i, 0)).transpose();
+  _g_values = g(x_bc);
+  if (_g_values.rows() != _dofs.rows())
+    throw std::runtime_error(
+        "Boundary value callable must return one value per dof.");
 }
 //-----------------------------------------------------------------------------
 std::shared_ptr<const function::FunctionSpace>
@@ -586,17 +604,41 @@ DirichletBC::dofs_owned() const
   return _dofs.block<Eigen::Dynamic, 2>(0, 0, _owned_indices, 2);
 }
 // -----------------------------------------------------------------------------
+Eigen::Index DirichletBC::num_dofs_below(Eigen::Index size) const
+{
+  // _dofs is sorted by dof index, so the bounds filter applied by
+  // set()/mark_dofs() keeps a prefix of the list. The two sizes seen
+  // in practice (owned, owned + ghosts) resolve from values cached at
+  // construction; anything else falls back to a binary search.
+  if (size >= _local_size)
+    return _dofs.rows();
+  else if (size == _owned_size)
+    return _owned_indices;
+  const std::int32_t* dofs0 = _dofs.col(0).data();
+  return std::distance(dofs0,
+                       std::lower_bound(dofs0, dofs0 + _dofs.rows(), size));
+}
+// -----------------------------------------------------------------------------
 void DirichletBC::set(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x,
     double scale) const
 {
   // FIXME: This one excludes ghosts. Need to straighten out.
-  assert(_g);
-  la::VecReadWrapper g(_g->vector().vec(), false);
-  for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
+  // The clamp to x is a precomputed prefix of the sorted dof list, so
+  // the loops below are branch-free streaming stores
+  const Eigen::Index num_dofs = num_dofs_below(x.rows());
+  const std::int32_t* dofs0 = _dofs.col(0).data();
+  if (_g)
+  {
+    la::VecReadWrapper g(_g->vector().vec(), false);
+    const std::int32_t* dofs1 = _dofs.col(1).data();
+    for (Eigen::Index i = 0; i < num_dofs; ++i)
+      x[dofs0[i]] = scale * g.x[dofs1[i]];
+  }
+  else
   {
-    if (_dofs(i, 0) < x.rows())
-      x[_dofs(i, 0)] = scale * g.x[_dofs(i, 1)];
+    for (Eigen::Index i = 0; i < num_dofs; ++i)
+      x[dofs0[i]] = scale * _g_values[i];
   }
 }
 //-----------------------------------------------------------------------------
@@ -606,31 +648,46 @@ void DirichletBC::set(
     double scale) const
 {
   // FIXME: This one excludes ghosts. Need to straighten out.
-  assert(_g);
   assert(x.rows() <= x0.rows());
-  la::VecReadWrapper g(_g->vector().vec(), false);
-  for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
+  const Eigen::Index num_dofs = num_dofs_below(x.rows());
+  const std::int32_t* dofs0 = _dofs.col(0).data();
+  if (_g)
+  {
+    la::VecReadWrapper g(_g->vector().vec(), false);
+    const std::int32_t* dofs1 = _dofs.col(1).data();
+    for (Eigen::Index i = 0; i < num_dofs; ++i)
+      x[dofs0[i]] = scale * (g.x[dofs1[i]] - x0[dofs0[i]]);
+  }
+  else
   {
-    if (_dofs(i, 0) < x.rows())
-      x[_dofs(i, 0)] = scale * (g.x[_dofs(i, 1)] - x0[_dofs(i, 0)]);
+    for (Eigen::Index i = 0; i < num_dofs; ++i)
+      x[dofs0[i]] = scale * (_g_values[i] - x0[dofs0[i]]);
   }
 }
 //-----------------------------------------------------------------------------
 void DirichletBC::dof_values(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> values) const
 {
-  assert(_g);
-  la::VecReadWrapper g(_g->vector().vec());
-  for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
-    values[_dofs(i, 0)] = g.x[_dofs(i, 1)];
+  if (_g)
+  {
+    la::VecReadWrapper g(_g->vector().vec());
+    for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
+      values[_dofs(i, 0)] = g.x[_dofs(i, 1)];
+  }
+  else
+  {
+    for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
+      values[_dofs(i, 0)] = _g_values[i];
+  }
 }
 //-----------------------------------------------------------------------------
 void DirichletBC::mark_dofs(std::vector<bool>& markers) const
 {
+  const std::int32_t* dofs0 = _dofs.col(0).data();
   for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
   {
-    assert(_dofs(i, 0) < (std::int32_t)markers.size());
-    markers[_dofs(i, 0)] = true;
+    assert(dofs0[i] < (std::int32_t)markers.size());
+    markers[dofs0[i]] = true;
   }
 }
 //-----------------------------------------------------------------------------
@@ -125,6 +125,27 @@ public:
           V_g_dofs,
       std::shared_ptr<const function::FunctionSpace> V);
 
+  /// Create boundary condition from a callable evaluated only at the
+  /// boundary dof coordinates. Avoids interpolating the expression
+  /// into a Function over the whole space: only the values at the
+  /// boundary dofs are computed and stored. The callable receives the
+  /// coordinates of the boundary dofs (shape 3 x num dofs) and must
+  /// return one value per dof. For vector-valued spaces where the
+  /// components differ, use the Function-based constructor.
+  ///
+  /// @param[in] V The function space on which the boundary condition
+  ///   is applied
+  /// @param[in] g Callable evaluating the boundary value at given
+  ///   coordinates
+  /// @param[in] dofs Degree-of-freedom indices in the space V
+  DirichletBC(
+      std::shared_ptr<const function::FunctionSpace> V,
+      const std::function<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>(
+          const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
+                                              Eigen::RowMajor>>&)>& g,
+      const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+          dofs);
+
   /// Copy constructor
   /// @param[in] bc The object to be copied
   DirichletBC(const DirichletBC& bc) = default;
@@ -147,7 +168,9 @@ public:
   /// @return The function space
   std::shared_ptr<const function::FunctionSpace> function_space() const;
 
-  /// Return boundary value function g
+  /// Return boundary value function g. Returns nullptr for boundary
+  /// conditions built from a callable, which store only the
+  /// boundary-dof values.
   /// @return The boundary values Function
   std::shared_ptr<const function::Function> value() const;
 
@@ -185,17 +208,32 @@ public:
   void mark_dofs(std::vector<bool>& markers) const;
 
 private:
+  // Number of leading rows of _dofs (sorted by dof index) whose index
+  // is below size, i.e. the clamp applied by set() for a vector of
+  // that length. The owned and owned+ghost prefixes are precomputed at
+  // construction; other lengths fall back to a binary search.
+  Eigen::Index num_dofs_below(Eigen::Index size) const;
+
   // The function space (possibly a sub function space)
   std::shared_ptr<const function::FunctionSpace> _function_space;
 
-  // The function
+  // The function (nullptr for callable-based boundary conditions)
   std::shared_ptr<const function::Function> _g;
 
+  // Boundary values for callable-based boundary conditions, one entry
+  // per row of _dofs
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> _g_values;
+
   // Indices of dofs in _function_space and in the space of _g
   Eigen::Array<std::int32_t, Eigen::Dynamic, 2> _dofs;
 
   // The first _owned_indices in _dofs are owned by this process
   int _owned_indices = -1;
+
+  // Cached block-scaled owned and owned+ghost sizes of the function
+  // space dof range, so set()/mark_dofs() resolve their clamp without
+  // dofmap lookups
+  std::int32_t _owned_size = 0, _local_size = 0;
 };
 } // namespace fem
 } // namespace dolfinx
@@ -5,149 +5,530 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "DiscreteOperators.h"
+#include <Eigen/Dense>
+#include <algorithm>
 #include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Mesh.h>
-#include <dolfinx/mesh/MeshEntity.h>
+#include <dolfinx/mesh/Topology.h>
+#include <map>
+#include <stdexcept>
 #include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
-// //-----------------------------------------------------------------------------
-// la::PETScMatrix
-// DiscreteOperators::build_gradient(const function::FunctionSpace& V0,
-//                                   const function::FunctionSpace& V1)
-// {
-//   // TODO: This function would be significantly simplified if it was
-//   // easier to build matrix sparsity patterns.
-
-//   // Get mesh
-//   assert(V0.mesh());
-//   const mesh::Mesh& mesh = *(V0.mesh());
-
-//   // Check that mesh is the same for both function spaces
-//   assert(V1.mesh());
-//   if (&mesh != V1.mesh().get())
-//   {
-//     throw std::runtime_error(
-//         "Ccompute discrete gradient operator. Function spaces "
-//         "do not share the same mesh");
-//   }
-
-//   // Check that V0 is a (lowest-order) edge basis
-//   mesh.topology_mutable().create_entities(1);
-//   if (V0.dim() != mesh.num_entities_global(1))
-//   {
-//     throw std::runtime_error(
-//         "Cannot compute discrete gradient operator. Function "
-//         "spaces is not a lowest-order edge space");
-//   }
-
-//   // Check that V1 is a linear nodal basis
-//   if (V1.dim() != mesh.num_entities_global(0))
-//   {
-//     throw std::runtime_error(
-//         "Cannot compute discrete gradient operator. Function "
-//         "space is not a linear nodal function space");
-//   }
-
-//   // Build maps from entities to local dof indices
-//   const Eigen::Array<std::int32_t, Eigen::Dynamic, 1> edge_to_dof
-//       = V0.dofmap()->dofs(mesh.topology(), 1);
-//   const Eigen::Array<std::int32_t, Eigen::Dynamic, 1> vertex_to_dof
-//       = V1.dofmap()->dofs(mesh.topology(), 0);
-
-//   // Build maps from local dof numbering to global
-//   Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global_map0
-//       = V0.dofmap()->index_map->indices(true);
-//   Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global_map1
-//       = V1.dofmap()->index_map->indices(true);
-
-//   // Initialize edge -> vertex connections
-//   mesh.create_connectivity(1, 0);
-
-//   // Copy index maps from dofmaps
-//   std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
-//       = {{V0.dofmap()->index_map, V1.dofmap()->index_map}};
-//   std::vector<std::array<std::int64_t, 2>> local_range
-//       = {{index_maps[0]->block_size * index_maps[0]->local_range()[0],
-//           index_maps[0]->block_size * index_maps[0]->local_range()[1]},
-//          {index_maps[1]->block_size * index_maps[1]->local_range()[0],
-//           index_maps[1]->block_size * index_maps[1]->local_range()[1]}};
-
-//   // Initialise sparsity pattern
-//   la::SparsityPattern pattern(mesh.mpi_comm(), index_maps);
-
-//   // Build sparsity pattern
-//   std::vector<PetscInt> rows;
-//   std::vector<PetscInt> cols;
-//   for (auto& edge : mesh::MeshRange(mesh, 1))
-//   {
-//     // Row index (global indices)
-//     const std::int64_t row = local_to_global_map0[edge_to_dof[edge.index()]];
-//     rows.push_back(row);
-
-//     if (row >= local_range[0][0] and row < local_range[0][1])
-//     {
-//       // Column indices (global indices)
-//       const mesh::MeshEntity v0(mesh, 0, edge.entities(0)[0]);
-//       const mesh::MeshEntity v1(mesh, 0, edge.entities(0)[1]);
-//       std::size_t col0 = local_to_global_map1[vertex_to_dof[v0.index()]];
-//       std::size_t col1 = local_to_global_map1[vertex_to_dof[v1.index()]];
-//       cols.push_back(col0);
-//       cols.push_back(col1);
-//     }
-//   }
-
-//   Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> _rows(
-//       rows.data(), rows.size());
-//   Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> _cols(
-//       cols.data(), cols.size());
-//   pattern.insert_global(_rows, _cols);
-//   pattern.assemble();
-
-//   // Create matrix
-//   la::PETScMatrix A(mesh.mpi_comm(), pattern);
-
-//   // Build discrete gradient operator/matrix
-//   const std::vector<std::int64_t>& global_indices
-//       = mesh.topology().global_indices(0);
-//   for (auto& edge : mesh::MeshRange(mesh, 1))
-//   {
-//     PetscInt row;
-//     PetscInt cols[2];
-//     PetscScalar values[2];
-
-//     row = local_to_global_map0[edge_to_dof[edge.index()]];
-
-//     mesh::MeshEntity v0(mesh, 0, edge.entities(0)[0]);
-//     mesh::MeshEntity v1(mesh, 0, edge.entities(0)[1]);
-
-//     cols[0] = local_to_global_map1[vertex_to_dof[v0.index()]];
-//     cols[1] = local_to_global_map1[vertex_to_dof[v1.index()]];
-//     if (global_indices[v1.index()] < global_indices[v0.index()])
-//     {
-//       values[0] = 1.0;
-//       values[1] = -1.0;
-//     }
-//     else
-//     {
-//       values[0] = -1.0;
-//       values[1] = 1.0;
-//     }
-
-//     // Set values in matrix
-//     A.set(values, 1, &row, 2, cols);
-//   }
-
-//   // Finalise matrix
-//   A.apply(la::PETScMatrix::AssemblyType::FINAL);
-
-//   return A;
-// }
-// //-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Check that two spaces share a mesh and return it
+const mesh::Mesh& get_common_mesh(const function::FunctionSpace& V0,
+                                  const function::FunctionSpace& V1)
+{
+  assert(V0.mesh());
+  assert(V1.mesh());
+  if (V0.mesh() != V1.mesh())
+  {
+    throw std::runtime_error("Cannot build discrete operator. Function spaces "
+                             "do not share the same mesh.");
+  }
+  return *V0.mesh();
+}
+//-----------------------------------------------------------------------------
+// Map each mesh entity of dimension dim (owned and ghost) to its
+// single dof in V. The space must have exactly one dof per entity of
+// dimension dim, e.g. the edges of a lowest-order Nedelec space.
+std::vector<std::int32_t> entity_to_dof(const function::FunctionSpace& V,
+                                        int dim)
+{
+  assert(V.mesh());
+  const mesh::Topology& topology = V.mesh()->topology();
+  const int tdim = topology.dim();
+
+  assert(V.dofmap());
+  std::shared_ptr<const fem::ElementDofLayout> layout
+      = V.dofmap()->element_dof_layout;
+  assert(layout);
+  if (layout->num_entity_dofs(dim) != 1)
+  {
+    throw std::runtime_error(
+        "Cannot build discrete operator. Expected a space with one dof per "
+        "entity of dimension " + std::to_string(dim) + ".");
+  }
+
+  auto e_map = topology.index_map(dim);
+  assert(e_map);
+  std::vector<std::int32_t> e_to_dof(e_map->size_local() + e_map->num_ghosts(),
+                                     -1);
+
+  auto c_to_e = topology.connectivity(tdim, dim);
+  assert(c_to_e);
+  auto c_map = topology.index_map(tdim);
+  assert(c_map);
+  const std::int32_t num_cells = c_map->size_local() + c_map->num_ghosts();
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto dofs = V.dofmap()->cell_dofs(c);
+    auto entities = c_to_e->links(c);
+    for (Eigen::Index i = 0; i < entities.rows(); ++i)
+      e_to_dof[entities[i]] = dofs[layout->entity_dofs(dim, i)[0]];
+  }
+
+  return e_to_dof;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+la::PETScMatrix
+DiscreteOperators::build_gradient(const function::FunctionSpace& V0,
+                                  const function::FunctionSpace& V1)
+{
+  const mesh::Mesh& mesh = get_common_mesh(V0, V1);
+  const int tdim = mesh.topology().dim();
+
+  // Create edges and the connectivities used to map entities to dofs
+  mesh.topology_mutable().create_entities(1);
+  mesh.topology_mutable().create_connectivity(1, 0);
+  mesh.topology_mutable().create_connectivity(tdim, 1);
+
+  // Check that V0 is a (lowest-order) edge basis
+  auto edge_map = mesh.topology().index_map(1);
+  assert(edge_map);
+  if (V0.dim() != edge_map->size_global())
+  {
+    throw std::runtime_error(
+        "Cannot compute discrete gradient operator. Function space is not a "
+        "lowest-order edge space.");
+  }
+
+  // Check that V1 is a linear nodal basis
+  auto vertex_map = mesh.topology().index_map(0);
+  assert(vertex_map);
+  if (V1.dim() != vertex_map->size_global())
+  {
+    throw std::runtime_error(
+        "Cannot compute discrete gradient operator. Function space is not a "
+        "linear nodal function space.");
+  }
+
+  // Build maps from entities to local dof indices
+  const std::vector<std::int32_t> edge_to_dof = entity_to_dof(V0, 1);
+  const std::vector<std::int32_t> vertex_to_dof = entity_to_dof(V1, 0);
+
+  // Build and preallocate the sparsity pattern from the edge-vertex
+  // connectivity: one row per owned edge, holding the dofs of the two
+  // edge vertices
+  std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
+      = {{V0.dofmap()->index_map, V1.dofmap()->index_map}};
+  la::SparsityPattern pattern(mesh.mpi_comm(), index_maps);
+
+  auto e_to_v = mesh.topology().connectivity(1, 0);
+  assert(e_to_v);
+  const std::int32_t num_owned_edges = edge_map->size_local();
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      rows(num_owned_edges, 1), cols(num_owned_edges, 2);
+  for (std::int32_t e = 0; e < num_owned_edges; ++e)
+  {
+    auto vertices = e_to_v->links(e);
+    rows(e, 0) = edge_to_dof[e];
+    cols(e, 0) = vertex_to_dof[vertices[0]];
+    cols(e, 1) = vertex_to_dof[vertices[1]];
+  }
+  pattern.insert_cells(graph::AdjacencyList<std::int32_t>(rows),
+                       graph::AdjacencyList<std::int32_t>(cols));
+  pattern.assemble();
+
+  // Create matrix
+  la::PETScMatrix A(mesh.mpi_comm(), pattern);
+
+  // Build maps from local dof numbering to global
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global0
+      = index_maps[0]->indices(true);
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global1
+      = index_maps[1]->indices(true);
+  const std::vector<std::int64_t> vertex_global
+      = vertex_map->global_indices(true);
+
+  // Fill the matrix in one pass over the owned edges. Each edge is
+  // owned by exactly one process, so every row is set exactly once.
+  for (std::int32_t e = 0; e < num_owned_edges; ++e)
+  {
+    auto vertices = e_to_v->links(e);
+    const PetscInt row = local_to_global0[edge_to_dof[e]];
+    PetscInt columns[2]
+        = {(PetscInt)local_to_global1[vertex_to_dof[vertices[0]]],
+           (PetscInt)local_to_global1[vertex_to_dof[vertices[1]]]};
+
+    // Orient the edge from the lower to the higher global vertex index
+    PetscScalar values[2] = {-1.0, 1.0};
+    if (vertex_global[vertices[1]] < vertex_global[vertices[0]])
+    {
+      values[0] = 1.0;
+      values[1] = -1.0;
+    }
+
+    A.set(values, 1, &row, 2, columns);
+  }
+
+  // Finalise matrix
+  A.apply(la::PETScMatrix::AssemblyType::FINAL);
+
+  return A;
+}
+//-----------------------------------------------------------------------------
+la::PETScMatrix DiscreteOperators::build_curl(const function::FunctionSpace& V0,
+                                              const function::FunctionSpace& V1)
+{
+  const mesh::Mesh& mesh = get_common_mesh(V0, V1);
+  const int tdim = mesh.topology().dim();
+  if (mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Cannot compute discrete curl operator. Only "
+                             "tetrahedral meshes are supported.");
+  }
+
+  // Create faces and edges, and the connectivities used below
+  mesh.topology_mutable().create_entities(2);
+  mesh.topology_mutable().create_entities(1);
+  mesh.topology_mutable().create_connectivity(2, 1);
+  mesh.topology_mutable().create_connectivity(2, 0);
+  mesh.topology_mutable().create_connectivity(1, 0);
+  mesh.topology_mutable().create_connectivity(tdim, 2);
+  mesh.topology_mutable().create_connectivity(tdim, 1);
+
+  // Check that V0 is a (lowest-order) face basis
+  auto face_map = mesh.topology().index_map(2);
+  assert(face_map);
+  if (V0.dim() != face_map->size_global())
+  {
+    throw std::runtime_error(
+        "Cannot compute discrete curl operator. Function space is not a "
+        "lowest-order face space.");
+  }
+
+  // Check that V1 is a (lowest-order) edge basis
+  auto edge_map = mesh.topology().index_map(1);
+  assert(edge_map);
+  if (V1.dim() != edge_map->size_global())
+  {
+    throw std::runtime_error(
+        "Cannot compute discrete curl operator. Function space is not a "
+        "lowest-order edge space.");
+  }
+
+  // Build maps from entities to local dof indices
+  const std::vector<std::int32_t> face_to_dof = entity_to_dof(V0, 2);
+  const std::vector<std::int32_t> edge_to_dof = entity_to_dof(V1, 1);
+
+  // Build and preallocate the sparsity pattern from the face-edge
+  // connectivity: one row per owned face, holding the dofs of the
+  // three face edges
+  std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
+      = {{V0.dofmap()->index_map, V1.dofmap()->index_map}};
+  la::SparsityPattern pattern(mesh.mpi_comm(), index_maps);
+
+  auto f_to_e = mesh.topology().connectivity(2, 1);
+  auto f_to_v = mesh.topology().connectivity(2, 0);
+  auto e_to_v = mesh.topology().connectivity(1, 0);
+  assert(f_to_e);
+  assert(f_to_v);
+  assert(e_to_v);
+  const std::int32_t num_owned_faces = face_map->size_local();
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      rows(num_owned_faces, 1), cols(num_owned_faces, 3);
+  for (std::int32_t f = 0; f < num_owned_faces; ++f)
+  {
+    auto edges = f_to_e->links(f);
+    rows(f, 0) = face_to_dof[f];
+    for (int i = 0; i < 3; ++i)
+      cols(f, i) = edge_to_dof[edges[i]];
+  }
+  pattern.insert_cells(graph::AdjacencyList<std::int32_t>(rows),
+                       graph::AdjacencyList<std::int32_t>(cols));
+  pattern.assemble();
+
+  // Create matrix
+  la::PETScMatrix A(mesh.mpi_comm(), pattern);
+
+  // Build maps from local dof numbering to global
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global0
+      = index_maps[0]->indices(true);
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global1
+      = index_maps[1]->indices(true);
+  const std::vector<std::int64_t> vertex_global
+      = mesh.topology().index_map(0)->global_indices(true);
+
+  // Fill the matrix in one pass over the owned faces. With the face
+  // vertices ordered by ascending global index (v0 < v1 < v2) and
+  // edges oriented from the lower to the higher global vertex, the
+  // boundary of the face is e(v1, v2) - e(v0, v2) + e(v0, v1), i.e.
+  // the sign of each edge is (-1)^i, where i is the position of the
+  // opposite vertex in the ordering.
+  for (std::int32_t f = 0; f < num_owned_faces; ++f)
+  {
+    auto edges = f_to_e->links(f);
+    auto face_vertices = f_to_v->links(f);
+
+    // Global indices of the face vertices, sorted ascending
+    std::array<std::int64_t, 3> v = {vertex_global[face_vertices[0]],
+                                     vertex_global[face_vertices[1]],
+                                     vertex_global[face_vertices[2]]};
+    std::sort(v.begin(), v.end());
+
+    const PetscInt row = local_to_global0[face_to_dof[f]];
+    PetscInt columns[3];
+    PetscScalar values[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      columns[i] = local_to_global1[edge_to_dof[edges[i]]];
+
+      // Find the face vertex opposite to this edge
+      auto edge_vertices = e_to_v->links(edges[i]);
+      const std::int64_t w0 = vertex_global[edge_vertices[0]];
+      const std::int64_t w1 = vertex_global[edge_vertices[1]];
+      int opposite = -1;
+      for (int j = 0; j < 3; ++j)
+      {
+        if (v[j] != w0 and v[j] != w1)
+          opposite = j;
+      }
+      assert(opposite >= 0);
+      values[i] = (opposite % 2 == 0) ? 1.0 : -1.0;
+    }
+
+    A.set(values, 1, &row, 3, columns);
+  }
+
+  // Finalise matrix
+  A.apply(la::PETScMatrix::AssemblyType::FINAL);
+
+  return A;
+}
+//-----------------------------------------------------------------------------
+la::PETScMatrix
+DiscreteOperators::build_restriction(const function::FunctionSpace& V)
+{
+  if (V.component().empty())
+  {
+    throw std::runtime_error("Cannot build restriction matrix. Function "
+                             "space is not a sub-space.");
+  }
+
+  // Collapse the sub-space to get the row index map and the map from
+  // collapsed dofs to parent dofs. The collapsed space is cached in V,
+  // so the row indexing matches a separate collapse() call.
+  const std::pair<std::shared_ptr<function::FunctionSpace>,
+                  std::vector<std::int32_t>>
+      collapsed = V.collapse();
+  const function::FunctionSpace& W = *collapsed.first;
+  const std::vector<std::int32_t>& collapsed_dofs = collapsed.second;
+
+  // The sub-space view shares the index map of its parent, which
+  // provides the column indexing
+  assert(W.dofmap());
+  assert(V.dofmap());
+  std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
+      = {{W.dofmap()->index_map, V.dofmap()->index_map}};
+
+  // One entry per owned collapsed dof
+  assert(V.mesh());
+  const std::int32_t num_owned
+      = index_maps[0]->block_size() * index_maps[0]->size_local();
+  la::SparsityPattern pattern(V.mesh()->mpi_comm(), index_maps);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      rows(num_owned, 1), cols(num_owned, 1);
+  for (std::int32_t i = 0; i < num_owned; ++i)
+  {
+    rows(i, 0) = i;
+    cols(i, 0) = collapsed_dofs[i];
+  }
+  pattern.insert_cells(graph::AdjacencyList<std::int32_t>(rows),
+                       graph::AdjacencyList<std::int32_t>(cols));
+  pattern.assemble();
+
+  // Create matrix
+  la::PETScMatrix A(V.mesh()->mpi_comm(), pattern);
+
+  // Build maps from local dof numbering to global
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global0
+      = index_maps[0]->indices(true);
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global1
+      = index_maps[1]->indices(true);
+
+  // Fill the matrix in one pass over the owned collapsed dofs
+  const PetscScalar one = 1.0;
+  for (std::int32_t i = 0; i < num_owned; ++i)
+  {
+    const PetscInt row = local_to_global0[i];
+    const PetscInt col = local_to_global1[collapsed_dofs[i]];
+    A.set(&one, 1, &row, 1, &col);
+  }
+
+  // Finalise matrix
+  A.apply(la::PETScMatrix::AssemblyType::FINAL);
+
+  return A;
+}
+//-----------------------------------------------------------------------------
+la::PETScMatrix
+DiscreteOperators::build_interpolation(const function::FunctionSpace& V0,
+                                       const function::FunctionSpace& V1)
+{
+  const mesh::Mesh& mesh = get_common_mesh(V0, V1);
+  const int tdim = mesh.topology().dim();
+  const int gdim = mesh.geometry().dim();
+
+  std::shared_ptr<const fem::FiniteElement> e0 = V0.element();
+  std::shared_ptr<const fem::FiniteElement> e1 = V1.element();
+  assert(e0);
+  assert(e1);
+
+  // The dofs of V0 must be point evaluations at known reference
+  // coordinates and both elements must be scalar valued (identity
+  // pull-back), so that the local interpolation matrix can be built
+  // from reference element data alone
+  if (!e0->has_dof_reference_coordinates())
+  {
+    throw std::runtime_error(
+        "Cannot build interpolation matrix. Dof reference coordinates are "
+        "required for the target element.");
+  }
+  if (e0->value_size() != 1 or e0->reference_value_size() != 1
+      or e1->value_size() != 1 or e1->reference_value_size() != 1)
+  {
+    throw std::runtime_error("Cannot build interpolation matrix. Only scalar "
+                             "elements are supported.");
+  }
+
+  // The dof reference coordinates are tabulated in reference dof
+  // order, so the target element's dof permutations must be the
+  // identity for the matrix rows to match the cell dofs
+  assert(V0.dofmap());
+  assert(V0.dofmap()->element_dof_layout);
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      base_perm = V0.dofmap()->element_dof_layout->base_permutations();
+  for (Eigen::Index i = 0; i < base_perm.rows(); ++i)
+  {
+    for (Eigen::Index j = 0; j < base_perm.cols(); ++j)
+    {
+      if (base_perm(i, j) != j)
+      {
+        throw std::runtime_error(
+            "Cannot build interpolation matrix. Target elements with "
+            "permuted dofs are not supported.");
+      }
+    }
+  }
+
+  const int num_dofs0 = e0->space_dimension();
+  const int num_dofs1 = e1->space_dimension();
+
+  // Tabulate the source basis at the dof points of the target element,
+  // once for all cells
+  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      X = e0->dof_reference_coordinates();
+  assert(X.rows() == num_dofs0);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(num_dofs0,
+                                                                   num_dofs1,
+                                                                   1);
+  e1->evaluate_reference_basis(basis_reference_values, X);
+
+  // Identity geometry data: the push-forward of identity-mapped
+  // (scalar) basis functions does not depend on the cell geometry, but
+  // it may apply the cell's dof permutations
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_dofs0, gdim, tdim);
+  J.setZero();
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_dofs0, tdim, gdim);
+  K.setZero();
+  const int dim_min = gdim < tdim ? gdim : tdim;
+  for (int p = 0; p < num_dofs0; ++p)
+  {
+    for (int i = 0; i < dim_min; ++i)
+    {
+      J(p, i, i) = 1.0;
+      K(p, i, i) = 1.0;
+    }
+  }
+  const Eigen::Array<double, Eigen::Dynamic, 1> detJ
+      = Eigen::Array<double, Eigen::Dynamic, 1>::Ones(num_dofs0);
+
+  mesh.topology_mutable().create_entity_permutations();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Build and preallocate the sparsity pattern from the cell dofmaps
+  assert(V1.dofmap());
+  std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
+      = {{V0.dofmap()->index_map, V1.dofmap()->index_map}};
+  la::SparsityPattern pattern(mesh.mpi_comm(), index_maps);
+  auto cell_map = mesh.topology().index_map(tdim);
+  assert(cell_map);
+  const std::int32_t num_cells
+      = cell_map->size_local() + cell_map->num_ghosts();
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    pattern.insert(V0.dofmap()->cell_dofs(c), V1.dofmap()->cell_dofs(c));
+  pattern.assemble();
+
+  // Create matrix
+  la::PETScMatrix A(mesh.mpi_comm(), pattern);
+
+  // Build maps from local dof numbering to global
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global0
+      = index_maps[0]->indices(true);
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global1
+      = index_maps[1]->indices(true);
+
+  // Local interpolation matrices, one per distinct cell permutation. A
+  // mesh has only a few distinct permutations, so each matrix is built
+  // once and re-used across cells.
+  std::map<std::uint32_t, Eigen::Matrix<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+      M_cache;
+
+  // Insert the local matrix for each cell. Cells sharing dofs insert
+  // identical rows, so repeated insertion is harmless.
+  std::vector<PetscInt> rows(num_dofs0), columns(num_dofs1);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto it = M_cache.find(cell_info[c]);
+    if (it == M_cache.end())
+    {
+      // Push the source basis forward with this cell's permutations
+      Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(num_dofs0,
+                                                             num_dofs1, 1);
+      e1->transform_reference_basis(basis_values, basis_reference_values, X, J,
+                                    detJ, K, cell_info[c]);
+      Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                    Eigen::RowMajor>
+          M(num_dofs0, num_dofs1);
+      for (int i = 0; i < num_dofs0; ++i)
+        for (int j = 0; j < num_dofs1; ++j)
+          M(i, j) = basis_values(i, j, 0);
+      it = M_cache.emplace(cell_info[c], std::move(M)).first;
+    }
+
+    auto dofs0 = V0.dofmap()->cell_dofs(c);
+    auto dofs1 = V1.dofmap()->cell_dofs(c);
+    for (int i = 0; i < num_dofs0; ++i)
+      rows[i] = local_to_global0[dofs0[i]];
+    for (int j = 0; j < num_dofs1; ++j)
+      columns[j] = local_to_global1[dofs1[j]];
+
+    A.set(it->second.data(), num_dofs0, rows.data(), num_dofs1,
+          columns.data());
+  }
+
+  // Finalise matrix
+  A.apply(la::PETScMatrix::AssemblyType::FINAL);
+
+  return A;
+}
+//-----------------------------------------------------------------------------
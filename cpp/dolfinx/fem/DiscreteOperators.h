@@ -26,15 +26,11 @@ namespace fem
 
 /// Discrete gradient operators providing derivatives of functions
 
-/// This class computes discrete gradient operators (matrices) that map
-/// derivatives of finite element functions into other finite element
-/// spaces. An example of where discrete gradient operators are required
-/// is the creation of algebraic multigrid solvers for H(curl) and
-/// H(div) problems.
-
-/// @warning This class is highly experimental and likely to change. It
-/// will eventually be expanded to provide the discrete curl and
-/// divergence.
+/// This class computes discrete differential operators (matrices) that
+/// map finite element functions into other finite element spaces. An
+/// example of where discrete gradient operators are required is the
+/// creation of algebraic multigrid solvers for H(curl) and H(div)
+/// problems.
 
 class DiscreteOperators
 {
@@ -44,11 +40,65 @@ public:
   /// (lowest order Nedelec), i.e. v = Aw. V0 is the H(curl) space,
   /// and V1 is the P1 Lagrange space.
   ///
+  /// The matrix is assembled into a preallocated sparsity pattern in a
+  /// single pass over the owned edges; each row holds the values +1
+  /// and -1 at the two vertices of the edge, with the sign fixed by
+  /// the global vertex ordering.
+  ///
   /// @param[in] V0 H(curl) space
   /// @param[in] V1 P1 Lagrange space
   /// @return The discrete operator matrix
   static la::PETScMatrix build_gradient(const function::FunctionSpace& V0,
                                         const function::FunctionSpace& V1);
+
+  /// Build the discrete curl operator A that takes a
+  /// \f$w \in H(curl)\f$ (lowest order Nedelec) to \f$v \in H(div)\f$
+  /// (lowest order Raviart-Thomas), i.e. v = Aw. V0 is the H(div)
+  /// space, and V1 is the H(curl) space. Supported for tetrahedral
+  /// meshes only.
+  ///
+  /// Each row corresponds to a face and holds the incidence signs of
+  /// the three face edges, with orientations fixed by the global
+  /// vertex ordering.
+  ///
+  /// @param[in] V0 H(div) space
+  /// @param[in] V1 H(curl) space
+  /// @return The discrete operator matrix
+  static la::PETScMatrix build_curl(const function::FunctionSpace& V0,
+                                    const function::FunctionSpace& V1);
+
+  /// Build the interpolation matrix A that takes a \f$w \in V1\f$ to
+  /// its interpolant \f$v \in V0\f$, i.e. v = Aw. Both spaces must be
+  /// defined on the same mesh and use scalar (identity mapped)
+  /// elements whose dofs are point evaluations at known reference
+  /// coordinates, e.g. Lagrange spaces of different degree.
+  ///
+  /// The local interpolation matrix is built once from reference
+  /// element data and inserted per cell into a preallocated sparsity
+  /// pattern.
+  ///
+  /// @param[in] V0 Space interpolated into (matrix rows)
+  /// @param[in] V1 Space interpolated from (matrix columns)
+  /// @return The interpolation matrix
+  static la::PETScMatrix build_interpolation(const function::FunctionSpace& V0,
+                                             const function::FunctionSpace& V1);
+
+  /// Build the restriction matrix R from a parent space to the
+  /// collapsed version of one of its sub-spaces, i.e. for
+  /// \f$w\f$ in the parent space, \f$v = Rw\f$ holds the entries of w
+  /// belonging to the sub-space component. R has one entry (1.0) per
+  /// row and is built directly from the sub-dofmap relationship, with
+  /// no geometry involvement and O(dofs) cost. The prolongation back
+  /// into the parent space is the transpose of R.
+  ///
+  /// The rows of R are indexed by the collapsed space returned by
+  /// FunctionSpace::collapse on @p V, which is cached, so calling
+  /// collapse separately (e.g. to create component Functions) yields
+  /// matching indexing.
+  ///
+  /// @param[in] V Sub-space (view) of the parent space, e.g. W.sub({0})
+  /// @return The restriction matrix
+  static la::PETScMatrix build_restriction(const function::FunctionSpace& V);
 };
 } // namespace fem
 } // namespace dolfinx
@@ -25,7 +25,7 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1>
 remap_dofs(const std::vector<std::int32_t>& old_to_new,
            const graph::AdjacencyList<T>& dofs_old)
 {
-  const Eigen::Array<T, Eigen::Dynamic, 1>& _dofs_old = dofs_old.array();
+  const auto _dofs_old = dofs_old.array();
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dofmap(_dofs_old.rows());
   for (Eigen::Index i = 0; i < dofmap.size(); ++i)
     dofmap[i] = old_to_new[_dofs_old[i]];
@@ -108,7 +108,7 @@ fem::DofMap build_collapsed_dofmap(MPI_Comm comm, const DofMap& dofmap_view,
   // receive new global indices from owner
   std::vector<std::int64_t> global_index_remote
       = dofmap_view.index_map->scatter_fwd(global_index, 1);
-  auto ghost_owner_old = dofmap_view.index_map->ghost_owners();
+  const auto& ghost_owner_old = dofmap_view.index_map->ghost_owners();
 
   // Compute ghosts for collapsed dofmap
   Eigen::Array<std::int64_t, Eigen::Dynamic, 1> ghosts(num_unowned);
@@ -158,14 +158,60 @@ DofMap::DofMap(std::shared_ptr<const ElementDofLayout> element_dof_layout,
                std::shared_ptr<const common::IndexMap> index_map,
                const graph::AdjacencyList<std::int32_t>& dofmap)
     : element_dof_layout(element_dof_layout), index_map(index_map),
-      _dofmap(dofmap)
+      _dofmap(std::make_shared<graph::AdjacencyList<std::int32_t>>(dofmap))
 {
   // Dofmap data is copied as the types for dofmap and _dofmap may
   // differ, typically 32- vs 64-bit integers
+  _mem_usage.update(sizeof(std::int32_t)
+                    * (_dofmap->array().rows() + _dofmap->offsets().rows()));
+}
+//-----------------------------------------------------------------------------
+DofMap::DofMap(
+    std::shared_ptr<const ElementDofLayout> element_dof_layout,
+    std::shared_ptr<const common::IndexMap> index_map,
+    std::shared_ptr<const graph::AdjacencyList<std::int32_t>> node_dofmap,
+    int block_size)
+    : element_dof_layout(element_dof_layout), index_map(index_map),
+      _node_map(node_dofmap), _bs(block_size)
+{
+  assert(_node_map);
+  if (block_size < 1)
+    throw std::runtime_error("Block size must be at least 1.");
+}
+//-----------------------------------------------------------------------------
+DofMap::DofMap(
+    std::shared_ptr<const ElementDofLayout> element_dof_layout,
+    std::shared_ptr<const common::IndexMap> index_map,
+    std::shared_ptr<const graph::AdjacencyList<std::int32_t>> view_parent,
+    std::vector<int> view_positions)
+    : element_dof_layout(element_dof_layout), index_map(index_map),
+      _view_parent(view_parent), _view_positions(std::move(view_positions))
+{
+  assert(_view_parent);
+}
+//-----------------------------------------------------------------------------
+void DofMap::materialize_view() const
+{
+  assert(_view_parent);
+  const std::int32_t num_cells = _view_parent->num_nodes();
+  const std::int32_t dofs_per_cell = _view_positions.size();
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      dofmap(num_cells, dofs_per_cell);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto parent_dofs = _view_parent->links(c);
+    for (std::int32_t i = 0; i < dofs_per_cell; ++i)
+      dofmap(c, i) = parent_dofs[_view_positions[i]];
+  }
+  _dofmap = std::make_shared<graph::AdjacencyList<std::int32_t>>(dofmap);
+  _mem_usage.update(sizeof(std::int32_t)
+                    * (_dofmap->array().rows() + _dofmap->offsets().rows()));
 }
 //-----------------------------------------------------------------------------
 DofMap DofMap::extract_sub_dofmap(const std::vector<int>& component) const
 {
+  if (is_implicit())
+    throw std::runtime_error("Cannot extract sub-dofmap of implicit dofmap.");
   assert(!component.empty());
 
   // Set element dof layout and cell dimension
@@ -174,28 +220,33 @@ DofMap DofMap::extract_sub_dofmap(const std::vector<int>& component) const
       = this->element_dof_layout->sub_dofmap(component);
 
   // Get components in parent map that correspond to sub-dofs
-  const std::vector<int> sub_element_map_view
+  std::vector<int> sub_element_map_view
       = this->element_dof_layout->sub_view(component);
 
-  // Build dofmap by extracting from parent
-  const int num_cells = this->_dofmap.num_nodes();
-  const std::int32_t dofs_per_cell = sub_element_map_view.size();
-  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      dofmap(num_cells, dofs_per_cell);
-  for (int c = 0; c < num_cells; ++c)
+  // Return a view over the parent adjacency list instead of
+  // materializing the extracted dofmap; a view of a view composes the
+  // positions so that it remains a view over the root parent. The
+  // expanded list is built lazily if list()/cell_dofs(cell) is called
+  if (_view_parent)
   {
-    auto cell_dmap_parent = this->_dofmap.links(c);
-    for (std::int32_t i = 0; i < dofs_per_cell; ++i)
-      dofmap(c, i) = cell_dmap_parent[sub_element_map_view[i]];
+    for (int& pos : sub_element_map_view)
+      pos = _view_positions[pos];
+    return DofMap(sub_element_dof_layout, this->index_map, _view_parent,
+                  std::move(sub_element_map_view));
+  }
+  else
+  {
+    assert(_dofmap);
+    return DofMap(sub_element_dof_layout, this->index_map, _dofmap,
+                  std::move(sub_element_map_view));
   }
-
-  return DofMap(sub_element_dof_layout, this->index_map,
-                graph::AdjacencyList<std::int32_t>(dofmap));
 }
 //-----------------------------------------------------------------------------
 std::pair<std::unique_ptr<DofMap>, std::vector<std::int32_t>>
 DofMap::collapse(MPI_Comm comm, const mesh::Topology& topology) const
 {
+  if (is_implicit())
+    throw std::runtime_error("Cannot collapse implicit dofmap.");
   assert(element_dof_layout);
   assert(index_map);
 
@@ -9,8 +9,10 @@
 #include "ElementDofLayout.h"
 #include <Eigen/Dense>
 #include <cstdlib>
+#include <dolfinx/common/MemoryRegistry.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -47,6 +49,18 @@ public:
          std::shared_ptr<const common::IndexMap> index_map,
          const graph::AdjacencyList<std::int32_t>& dofmap);
 
+  /// Create an implicit (blocked) DofMap. Cell dofs are computed
+  /// arithmetically from the node graph as
+  ///   dof = block_size * node + component
+  /// rather than read from a materialized list, which avoids storing
+  /// the block-expanded dof indices for vector-valued spaces. Implicit
+  /// maps support cell_dofs(cell, dofs) only; list() and the
+  /// segment-returning cell_dofs are unavailable.
+  DofMap(std::shared_ptr<const ElementDofLayout> element_dof_layout,
+         std::shared_ptr<const common::IndexMap> index_map,
+         std::shared_ptr<const graph::AdjacencyList<std::int32_t>> node_dofmap,
+         int block_size);
+
   // Copy constructor
   DofMap(const DofMap& dofmap) = delete;
 
@@ -62,15 +76,60 @@ public:
   /// Move assignment
   DofMap& operator=(DofMap&& dofmap) = default;
 
-  /// Local-to-global mapping of dofs on a cell
+  /// Local-to-global mapping of dofs on a cell. Not available for
+  /// implicit maps - use cell_dofs(cell, dofs) instead. For sub-dofmap
+  /// views this materializes the view on first access.
   /// @param[in] cell The cell index
   /// @return Local-global dof map for the cell (using process-local indices)
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::ConstSegmentReturnType
+  Eigen::Map<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>
   cell_dofs(int cell) const
   {
-    return _dofmap.links(cell);
+    assert(!_node_map);
+    if (!_dofmap)
+      materialize_view();
+    return _dofmap->links(cell);
   }
 
+  /// Compute the local-to-global mapping of dofs on a cell into a
+  /// caller-provided array. Works for both implicit and explicit maps;
+  /// for implicit maps the dofs are computed arithmetically from the
+  /// node graph without reading an expanded list.
+  /// @param[in] cell The cell index
+  /// @param[in,out] dofs Array to fill (resized to the number of dofs
+  ///   on the cell)
+  void cell_dofs(int cell,
+                 Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& dofs) const
+  {
+    if (_node_map)
+    {
+      auto nodes = _node_map->links(cell);
+      const std::int32_t num_nodes = nodes.rows();
+      dofs.resize(_bs * num_nodes);
+      for (int block = 0; block < _bs; ++block)
+        for (std::int32_t j = 0; j < num_nodes; ++j)
+          dofs[block * num_nodes + j] = _bs * nodes[j] + block;
+    }
+    else if (_view_parent)
+    {
+      auto parent_dofs = _view_parent->links(cell);
+      dofs.resize(_view_positions.size());
+      for (std::size_t i = 0; i < _view_positions.size(); ++i)
+        dofs[i] = parent_dofs[_view_positions[i]];
+    }
+    else
+      dofs = _dofmap->links(cell);
+  }
+
+  /// True if this map uses the implicit (unexpanded) representation
+  bool is_implicit() const { return _node_map != nullptr; }
+
+  /// True if this map is a sub-dofmap view over a parent dofmap
+  bool is_view() const { return _view_parent != nullptr; }
+
+  /// Block size used for the arithmetic dof computation (1 for
+  /// explicit maps)
+  int block_size() const { return _bs; }
+
   /// Extract subdofmap component
   /// @param[in] component The component indices
   /// @return The dofmap for the component
@@ -83,9 +142,29 @@ public:
   std::pair<std::unique_ptr<DofMap>, std::vector<std::int32_t>>
   collapse(MPI_Comm comm, const mesh::Topology& topology) const;
 
-  /// Get dofmap data
+  /// Get dofmap data. Not available for implicit maps. For sub-dofmap
+  /// views this materializes the view on first access.
   /// @return The adjacency list with dof indices for each cell
-  const graph::AdjacencyList<std::int32_t>& list() const { return _dofmap; }
+  const graph::AdjacencyList<std::int32_t>& list() const
+  {
+    if (_node_map)
+    {
+      throw std::runtime_error(
+          "Dofmap is implicit and has no materialized list. Use "
+          "cell_dofs(cell, dofs).");
+    }
+    if (!_dofmap)
+      materialize_view();
+    return *_dofmap;
+  }
+
+  /// Get the node graph of an implicit map (cell to unexpanded dof
+  /// node). Not available for explicit maps.
+  const graph::AdjacencyList<std::int32_t>& node_list() const
+  {
+    assert(_node_map);
+    return *_node_map;
+  }
 
   /// Layout of dofs on an element
   std::shared_ptr<const ElementDofLayout> element_dof_layout;
@@ -94,8 +173,39 @@ public:
   std::shared_ptr<const common::IndexMap> index_map;
 
 private:
-  // Cell-local-to-dof map (dofs for cell dofmap[i])
-  graph::AdjacencyList<std::int32_t> _dofmap;
+  // Create a sub-dofmap view over a parent adjacency list. For each
+  // cell, dof i of the view is the parent cell dof at view_positions[i]
+  DofMap(std::shared_ptr<const ElementDofLayout> element_dof_layout,
+         std::shared_ptr<const common::IndexMap> index_map,
+         std::shared_ptr<const graph::AdjacencyList<std::int32_t>> view_parent,
+         std::vector<int> view_positions);
+
+  // Materialize a view into _dofmap. Called lazily from the list() and
+  // segment cell_dofs accessors; not safe against a concurrent first
+  // access from several threads, so touch the map from one thread
+  // before sharing it
+  void materialize_view() const;
+
+  // Cell-local-to-dof map (dofs for cell dofmap[i]). Shared so that
+  // sub-dofmap views can alias their parent. Null for implicit maps
+  // and for views that have not been materialized; mutable to allow
+  // lazy materialization from const accessors
+  mutable std::shared_ptr<const graph::AdjacencyList<std::int32_t>> _dofmap;
+
+  // Cell-to-node map for implicit maps (nullptr for explicit maps)
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> _node_map;
+
+  // Block size for the arithmetic dof computation
+  int _bs = 1;
+
+  // Parent adjacency list for sub-dofmap views (nullptr otherwise),
+  // and the position of each view dof in the parent cell dofs
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> _view_parent;
+  std::vector<int> _view_positions;
+
+  // Reported resident bytes of the materialized dof list; mutable
+  // because views materialize lazily from const accessors
+  mutable common::MemoryRegistry::Usage _mem_usage{"DofMap"};
 };
 } // namespace fem
 } // namespace dolfinx
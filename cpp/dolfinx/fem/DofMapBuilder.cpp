@@ -8,17 +8,23 @@
 #include "ElementDofLayout.h"
 #include <algorithm>
 #include <cstdlib>
+#include <dolfinx/common/ArenaAllocator.h>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/common/types.h>
 #include <dolfinx/common/utils.h>
 #include <dolfinx/fem/dofs_permutation.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/BoostGraphOrdering.h>
+#include <dolfinx/graph/RedistributionPlan.h>
 #include <dolfinx/graph/SCOTCH.h>
 #include <dolfinx/mesh/Topology.h>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <random>
 #include <unordered_map>
 #include <utility>
@@ -30,6 +36,8 @@ namespace
 {
 //-----------------------------------------------------------------------------
 
+using common::parallel_for;
+
 /// Build a simple dofmap from ElementDofmap based on mesh entity
 /// indices (local and global)
 ///
@@ -89,110 +97,142 @@ build_basic_dofmap(const mesh::Topology& topology,
     }
   }
 
-  // Number of dofs on this process
-  std::int32_t local_size(0), d(0);
+  // Number of dofs on this process. Accumulate in 64 bits and narrow
+  // through the checked conversion point, so approaching the local
+  // index limit fails loudly instead of wrapping.
+  std::int64_t local_size64(0);
+  int d = 0;
   for (std::int32_t n : num_mesh_entities_local)
-    local_size += n * element_dof_layout.num_entity_dofs(d++);
+    local_size64 += std::int64_t(n) * element_dof_layout.num_entity_dofs(d++);
+  const auto local_size = common::narrow_index(local_size64);
 
   // Number of dofs per cell
   const int local_dim = element_dof_layout.num_dofs();
 
   // Allocate dofmap memory
   const int num_cells = topology.connectivity(D, 0)->num_nodes();
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dofs(num_cells * local_dim);
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> cell_ptr(num_cells + 1);
-  cell_ptr = local_dim;
+  std::vector<std::int32_t> dofs(
+      common::narrow_index(std::int64_t(num_cells) * local_dim));
+  std::vector<std::int32_t> cell_ptr(num_cells + 1, local_dim);
   cell_ptr[0] = 0;
-  std::partial_sum(cell_ptr.data() + 1, cell_ptr.data() + cell_ptr.rows(),
+  std::partial_sum(cell_ptr.data() + 1, cell_ptr.data() + cell_ptr.size(),
                    cell_ptr.data() + 1);
 
-  // Allocate entity indices array
-  std::vector<std::vector<int32_t>> entity_indices_local(D + 1);
-  std::vector<std::vector<int64_t>> entity_indices_global(D + 1);
+  // Compute cell dof permutations (distinct permutations plus a
+  // per-cell index into them). Note: not unpacked with structured
+  // bindings, which cannot be captured by the lambda below in C++17
+  const auto perm_data
+      = fem::compute_dof_permutations(topology, element_dof_layout);
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      permutations
+      = perm_data.first;
+  const std::vector<std::int32_t>& cell_to_perm = perm_data.second;
+
+  // Dof offsets for each topological dimension
+  std::vector<std::int32_t> offset_local(D + 2, 0);
+  std::vector<std::int64_t> offset_global(D + 2, 0);
   for (int d = 0; d <= D; ++d)
   {
-    const int num_entities = mesh::cell_num_entities(topology.cell_type(), d);
-    entity_indices_local[d].resize(num_entities);
-    entity_indices_global[d].resize(num_entities);
+    const std::int32_t num_entity_dofs = element_dof_layout.num_entity_dofs(d);
+    offset_local[d + 1]
+        = offset_local[d] + num_entity_dofs * num_mesh_entities_local[d];
+    offset_global[d + 1]
+        = offset_global[d] + num_entity_dofs * num_mesh_entities_global[d];
   }
 
-  // Entity dofs on cell (dof = entity_dofs[dim][entity][index])
-  const std::vector<std::vector<std::set<int>>>& entity_dofs
-      = element_dof_layout.entity_dofs_all();
-
-  // Compute cell dof permutations
-  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      permutations
-      = fem::compute_dof_permutations(topology, element_dof_layout);
-
   // Storage for local-to-global map
   std::vector<std::int64_t> local_to_global(local_size);
 
   // Dof (dim, entity index) marker
   std::vector<std::pair<std::int8_t, std::int32_t>> dof_entity(local_size);
 
-  // Loops over cells and build dofmaps from ElementDofmap
-  for (int c = 0; c < connectivity[0]->num_nodes(); ++c)
+  // The local-to-global map and the (dimension, entity) marker of a
+  // dof depend only on the entity it sits on, so they are filled once
+  // per entity (in parallel over disjoint entity ranges) rather than
+  // once per incident cell
+  for (int d = 0; d <= D; ++d)
   {
-    // Get local (process) and global cell entity indices
-    for (int d = 0; d < D; ++d)
+    if (!needs_entities[d])
+      continue;
+    const std::int32_t num_entity_dofs = element_dof_layout.num_entity_dofs(d);
+    const std::vector<std::int64_t>& global_d = global_indices[d];
+    parallel_for(num_mesh_entities_local[d],
+                 [&, d, num_entity_dofs](std::int32_t begin, std::int32_t end) {
+                   for (std::int32_t e = begin; e < end; ++e)
+                   {
+                     for (std::int32_t k = 0; k < num_entity_dofs; ++k)
+                     {
+                       const std::int32_t dof
+                           = offset_local[d] + num_entity_dofs * e + k;
+                       local_to_global[dof]
+                           = offset_global[d] + num_entity_dofs * global_d[e]
+                             + k;
+                       dof_entity[dof] = {(std::int8_t)d, e};
+                     }
+                   }
+                 });
+  }
+
+  // Loop over cells and build the dofmap from the ElementDofmap. Each
+  // cell writes only its own rows, so the loop is threaded over
+  // disjoint cell ranges.
+  parallel_for(num_cells, [&](std::int32_t begin, std::int32_t end) {
+    // Cell entity index scratch for this thread
+    std::vector<std::vector<std::int32_t>> entity_indices_local(D + 1);
+    for (int d = 0; d <= D; ++d)
+    {
+      entity_indices_local[d].resize(
+          mesh::cell_num_entities(topology.cell_type(), d));
+    }
+
+    for (std::int32_t c = begin; c < end; ++c)
     {
-      if (needs_entities[d])
+      // Get local (process) cell entity indices
+      for (int d = 0; d < D; ++d)
       {
-        auto entities = connectivity[d]->links(c);
-        for (int i = 0; i < entities.rows(); ++i)
+        if (needs_entities[d])
         {
-          entity_indices_local[d][i] = entities[i];
-          entity_indices_global[d][i] = global_indices[d][entities[i]];
+          auto entities = connectivity[d]->links(c);
+          for (int i = 0; i < entities.rows(); ++i)
+            entity_indices_local[d][i] = entities[i];
         }
       }
-    }
 
-    // Handle cell index separately because cell.entities(D) doesn't work.
-    if (needs_entities[D])
-    {
-      entity_indices_global[D][0] = global_indices[D][c];
-      entity_indices_local[D][0] = c;
-    }
+      // Handle cell index separately because cell.entities(D) doesn't
+      // work.
+      if (needs_entities[D])
+        entity_indices_local[D][0] = c;
 
-    // Iterate over each topological dimension of cell
-    std::int32_t offset_local = 0;
-    std::int64_t offset_global = 0;
-    for (auto e_dofs_d = entity_dofs.begin(); e_dofs_d != entity_dofs.end();
-         ++e_dofs_d)
-    {
-      const std::int8_t d = std::distance(entity_dofs.begin(), e_dofs_d);
-
-      // Iterate over each entity of current dimension d
-      for (auto e_dofs = e_dofs_d->begin(); e_dofs != e_dofs_d->end(); ++e_dofs)
+      // Iterate over each topological dimension of cell
+      for (int d = 0; d <= D; ++d)
       {
-        // Get entity indices (local to cell, local to process, and
-        // global)
-        const std::int32_t e = std::distance(e_dofs_d->begin(), e_dofs);
-        const std::int32_t e_index_local = entity_indices_local[d][e];
-        const std::int64_t e_index_global = entity_indices_global[d][e];
-
-        // Loop over dofs belong to entity e of dimension d (d, e)
-        // d: topological dimension
-        // e: local entity index
-        // dof_local: local index of dof at (d, e)
-        const std::int32_t num_entity_dofs = e_dofs->size();
-        for (auto dof_local = e_dofs->begin(); dof_local != e_dofs->end();
-             ++dof_local)
+        const std::int32_t num_entity_dofs
+            = element_dof_layout.num_entity_dofs(d);
+        if (num_entity_dofs == 0)
+          continue;
+
+        // Iterate over each entity of current dimension d
+        const std::int32_t num_entities = entity_indices_local[d].size();
+        for (std::int32_t e = 0; e < num_entities; ++e)
         {
-          const std::int32_t count = std::distance(e_dofs->begin(), dof_local);
-          const std::int32_t dof
-              = offset_local + num_entity_dofs * e_index_local + count;
-          dofs[cell_ptr[c] + permutations(c, *dof_local)] = dof;
-          local_to_global[dof]
-              = offset_global + num_entity_dofs * e_index_global + count;
-          dof_entity[dof] = {d, e_index_local};
+          // Get entity indices (local to cell and local to process)
+          const std::int32_t e_index_local = entity_indices_local[d][e];
+
+          // Loop over dofs belonging to entity e of dimension d (d, e)
+          // d: topological dimension
+          // e: local entity index
+          auto e_dofs = element_dof_layout.entity_dofs(d, e);
+          for (std::int32_t count = 0; count < num_entity_dofs; ++count)
+          {
+            const std::int32_t dof
+                = offset_local[d] + num_entity_dofs * e_index_local + count;
+            dofs[cell_ptr[c] + permutations(cell_to_perm[c], e_dofs[count])]
+                = dof;
+          }
         }
       }
-      offset_local += entity_dofs[d][0].size() * num_mesh_entities_local[d];
-      offset_global += entity_dofs[d][0].size() * num_mesh_entities_global[d];
     }
-  }
+  });
 
   return {
       graph::AdjacencyList<std::int32_t>(std::move(dofs), std::move(cell_ptr)),
@@ -208,12 +248,13 @@ build_basic_dofmap(const mesh::Topology& topology,
 ///
 /// @param [in] dofmap The basic dofmap data
 /// @param [in] topology The mesh topology
+/// @param [in] reorder The re-ordering strategy for owned dofs
 /// @return The pair (old-to-new local index map, M), where M is the
 ///   number of dofs owned by this process
 std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
     const graph::AdjacencyList<std::int32_t>& dofmap,
     const std::vector<std::pair<std::int8_t, std::int32_t>>& dof_entity,
-    const mesh::Topology& topology)
+    const mesh::Topology& topology, ReorderingStrategy reorder)
 {
   // Get ownership offset for each dimension
   const int D = topology.dim();
@@ -247,49 +288,59 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
   }
 
   // Build local graph, based on dof map with contiguous numbering
-  // (unowned dofs excluded)
-  std::vector<std::vector<std::int32_t>> graph_data(owned_size);
-  for (std::int32_t cell = 0; cell < dofmap.num_nodes(); ++cell)
-  {
-    auto nodes = dofmap.links(cell);
-    for (std::int32_t i = 0; i < nodes.rows(); ++i)
+  // (unowned dofs excluded). The per-node edge vectors are arena
+  // allocated and released wholesale when the block exits, instead of
+  // one free per node.
+  const graph::AdjacencyList<std::int32_t> graph = [&]() {
+    common::Arena arena;
+    const common::ArenaAllocator<std::int32_t> alloc(arena);
+    using EdgeVector
+        = std::vector<std::int32_t, common::ArenaAllocator<std::int32_t>>;
+    std::vector<EdgeVector> graph_data(owned_size, EdgeVector(alloc));
+    for (std::int32_t cell = 0; cell < dofmap.num_nodes(); ++cell)
     {
-      const std::int32_t node_i = original_to_contiguous[nodes[i]];
-
-      // Skip unowned node
-      if (node_i == -1)
-        continue;
-
-      for (std::int32_t j = 0; j < nodes.rows(); ++j)
+      auto nodes = dofmap.links(cell);
+      for (std::int32_t i = 0; i < nodes.rows(); ++i)
       {
-        // Skip diagonal
-        if (i == j)
+        const std::int32_t node_i = original_to_contiguous[nodes[i]];
+
+        // Skip unowned node
+        if (node_i == -1)
           continue;
 
-        const std::int32_t node_j = original_to_contiguous[nodes[j]];
-        if (node_j != -1)
-          graph_data[node_i].push_back(node_j);
+        for (std::int32_t j = 0; j < nodes.rows(); ++j)
+        {
+          // Skip diagonal
+          if (i == j)
+            continue;
+
+          const std::int32_t node_j = original_to_contiguous[nodes[j]];
+          if (node_j != -1)
+            graph_data[node_i].push_back(node_j);
+        }
       }
     }
-  }
 
-  // Eliminate duplicates and create AdjacencyList
-  for (auto& node : graph_data)
-  {
-    std::sort(node.begin(), node.end());
-    node.erase(std::unique(node.begin(), node.end()), node.end());
-  }
-  const graph::AdjacencyList<std::int32_t> graph(graph_data);
-  std::vector<std::vector<std::int32_t>>().swap(graph_data);
+    // Eliminate duplicates and create AdjacencyList
+    for (EdgeVector& node : graph_data)
+    {
+      std::sort(node.begin(), node.end());
+      node.erase(std::unique(node.begin(), node.end()), node.end());
+    }
+    return graph::AdjacencyList<std::int32_t>(graph_data);
+  }();
 
   // Reorder owned nodes
-  const std::string ordering_library = "SCOTCH";
   std::vector<int> node_remap;
-  if (ordering_library == "Boost")
-    node_remap = graph::BoostGraphOrdering::compute_cuthill_mckee(graph, true);
-  else if (ordering_library == "SCOTCH")
+  switch (reorder)
+  {
+  case ReorderingStrategy::scotch:
     std::tie(node_remap, std::ignore) = graph::SCOTCH::compute_gps(graph);
-  else if (ordering_library == "random")
+    break;
+  case ReorderingStrategy::rcm:
+    node_remap = graph::BoostGraphOrdering::compute_cuthill_mckee(graph, true);
+    break;
+  case ReorderingStrategy::random:
   {
     // NOTE: Randomised dof ordering should only be used for
     // testing/benchmarking
@@ -298,12 +349,24 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
     std::random_device rd;
     std::default_random_engine g(rd());
     std::shuffle(node_remap.begin(), node_remap.end(), g);
+    break;
   }
-  else
+  default:
+    throw std::runtime_error("Unknown dof reordering strategy.");
+  }
+
+  // Report the local bandwidth of the reordered dof graph
+  std::int32_t bandwidth = 0;
+  for (std::int32_t node = 0; node < graph.num_nodes(); ++node)
   {
-    throw std::runtime_error("Requested library '" + ordering_library
-                             + "' is unknown");
+    auto edges = graph.links(node);
+    for (std::int32_t i = 0; i < edges.rows(); ++i)
+    {
+      bandwidth = std::max(
+          bandwidth, std::abs(node_remap[node] - node_remap[edges[i]]));
+    }
   }
+  LOG(INFO) << "Dof graph bandwidth after reordering: " << bandwidth;
 
   // Reconstruct remaped nodes, and place un-owned nodes at the end
   std::vector<int> old_to_new(dof_entity.size(), -1);
@@ -381,53 +444,48 @@ std::pair<std::vector<std::int64_t>, std::vector<int>> get_global_indices(
     }
   }
 
-  std::vector<int> requests_dim;
-  std::vector<MPI_Request> requests(D + 1);
-  std::vector<MPI_Comm> comm(D + 1, MPI_COMM_NULL);
-  std::vector<std::vector<std::int64_t>> all_dofs_received(D + 1);
-  std::vector<std::vector<int>> recv_offsets(D + 1);
+  // Build one exchange plan covering every entity dimension: each
+  // (index pair, neighbour) combination becomes one item [dimension,
+  // global old index, global new index]. A single nonblocking
+  // point-to-point exchange then replaces one neighbourhood collective
+  // -- and one neighbourhood communicator creation -- per dimension.
+  std::vector<int> item_dest;
+  std::vector<std::int8_t> item_dim;
+  std::vector<std::int32_t> item_pair;
   for (int d = 0; d <= D; ++d)
   {
     // FIXME: This should check which dimension are needed by the dofmap
     auto map = topology.index_map(d);
     if (map)
     {
-      // Get number of processes in neighbourhood
-      const std::vector<std::int32_t>& neighbours = map->neighbours();
-      MPI_Dist_graph_create_adjacent(
-          map->mpi_comm(), neighbours.size(), neighbours.data(), MPI_UNWEIGHTED,
-          neighbours.size(), neighbours.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
-          false, &comm[d]);
-
-      int num_neighbours(-1), outdegree(-2), weighted(-1);
-      MPI_Dist_graph_neighbors_count(comm[d], &num_neighbours, &outdegree,
-                                     &weighted);
-      assert(num_neighbours == outdegree);
-
-      // Number and values to send and receive
-      const int num_indices = global[d].size();
-      std::vector<int> num_indices_recv(num_neighbours);
-      MPI_Neighbor_allgather(&num_indices, 1, MPI_INT, num_indices_recv.data(),
-                             1, MPI_INT, comm[d]);
-
-      // Compute displacements for data to receive. Last entry has total
-      // number of received items.
-      std::vector<int>& disp = recv_offsets[d];
-      disp.resize(num_neighbours + 1);
-      std::partial_sum(num_indices_recv.begin(), num_indices_recv.end(),
-                       disp.begin() + 1);
-
-      // TODO: use MPI_Ineighbor_alltoallv
-      // Send global index of dofs with bcs to all neighbours
-      std::vector<std::int64_t>& dofs_received = all_dofs_received[d];
-      dofs_received.resize(disp.back());
-      MPI_Ineighbor_allgatherv(global[d].data(), global[d].size(), MPI_INT64_T,
-                               dofs_received.data(), num_indices_recv.data(),
-                               disp.data(), MPI_INT64_T, comm[d],
-                               &requests[requests_dim.size()]);
-      requests_dim.push_back(d);
+      for (std::int32_t p : map->neighbours())
+      {
+        for (std::size_t j = 0; j < global[d].size(); j += 2)
+        {
+          item_dest.push_back(p);
+          item_dim.push_back(d);
+          item_pair.push_back(j);
+        }
+      }
     }
   }
+  graph::RedistributionPlan plan(topology.mpi_comm(), item_dest);
+
+  // Exchange, accumulating (global old, global new, owner) triples per
+  // dimension as the block of each neighbour arrives
+  std::vector<std::vector<std::array<std::int64_t, 3>>> global_old_new(D + 1);
+  plan.execute<std::int64_t>(
+      3,
+      [&](std::size_t m, std::int64_t* buf) {
+        const int d = item_dim[m];
+        buf[0] = d;
+        buf[1] = global[d][item_pair[m]];
+        buf[2] = global[d][item_pair[m] + 1];
+      },
+      [&](int src, const std::int64_t* data, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += 3)
+          global_old_new[data[i]].push_back({data[i + 1], data[i + 2], src});
+      });
 
   // Build  [local_new - num_owned] -> global old array  broken down by
   // dimension
@@ -445,47 +503,31 @@ std::pair<std::vector<std::int64_t>, std::vector<int>> get_global_indices(
 
   std::vector<std::int64_t> local_to_global_new(old_to_new.size() - num_owned);
   std::vector<int> local_to_global_new_owner(old_to_new.size() - num_owned);
-  for (std::size_t i = 0; i < requests_dim.size(); ++i)
+  for (int d = 0; d <= D; ++d)
   {
-    int idx, d;
-    MPI_Waitany(requests_dim.size(), requests.data(), &idx, MPI_STATUS_IGNORE);
-    d = requests_dim[idx];
-
-    auto map = topology.index_map(d);
-    const std::vector<std::int32_t>& neighbours = map->neighbours();
-
-    // Build (global old, global new) map for dofs of dimension d
-    std::unordered_map<std::int64_t, std::pair<int64_t, int>> global_old_new;
-    std::vector<std::int64_t>& dofs_received = all_dofs_received[d];
-    std::vector<int>& offsets = recv_offsets[d];
-    for (std::size_t j = 0; j < dofs_received.size(); j += 2)
-    {
-      const auto pos = std::upper_bound(offsets.begin(), offsets.end(), j);
-      const int owner = std::distance(offsets.begin(), pos) - 1;
-      global_old_new.insert(
-          {dofs_received[j], {dofs_received[j + 1], neighbours[owner]}});
-    }
+    // Sort the triples of dimension d on the old index; the per-dof
+    // resolution below is then a binary search over a contiguous array
+    // instead of a hash lookup per dof
+    std::vector<std::array<std::int64_t, 3>>& entries = global_old_new[d];
+    std::sort(entries.begin(), entries.end());
 
     // Build the dimension d part of local_to_global_new vector
     std::vector<std::int64_t>& local_new_to_global_old_d
         = local_new_to_global_old[d];
     for (std::size_t i = 0; i < local_new_to_global_old_d.size(); i += 2)
     {
-      auto it = global_old_new.find(local_new_to_global_old_d[i]);
-      assert(it != global_old_new.end());
-      local_to_global_new[local_new_to_global_old_d[i + 1]] = it->second.first;
-      local_to_global_new_owner[local_new_to_global_old_d[i + 1]]
-          = it->second.second;
+      const auto it = std::lower_bound(
+          entries.begin(), entries.end(),
+          std::array<std::int64_t, 3>{local_new_to_global_old_d[i],
+                                      std::numeric_limits<std::int64_t>::min(),
+                                      0});
+      assert(it != entries.end());
+      assert((*it)[0] == local_new_to_global_old_d[i]);
+      local_to_global_new[local_new_to_global_old_d[i + 1]] = (*it)[1];
+      local_to_global_new_owner[local_new_to_global_old_d[i + 1]] = (*it)[2];
     }
   }
 
-  // Free the communicator
-  for (std::size_t d = 0; d < comm.size(); ++d)
-  {
-    if (comm[d] != MPI_COMM_NULL)
-      MPI_Comm_free(&comm[d]);
-  }
-
   return {local_to_global_new, local_to_global_new_owner};
 }
 //-----------------------------------------------------------------------------
@@ -497,27 +539,29 @@ std::tuple<std::shared_ptr<const ElementDofLayout>,
            std::shared_ptr<const common::IndexMap>,
            graph::AdjacencyList<std::int32_t>>
 DofMapBuilder::build(MPI_Comm comm, const mesh::Topology& topology,
-                     std::shared_ptr<const ElementDofLayout> element_dof_layout)
+                     std::shared_ptr<const ElementDofLayout> element_dof_layout,
+                     ReorderingStrategy reorder)
 {
   assert(element_dof_layout);
   const int bs = element_dof_layout->block_size();
   if (bs == 1)
   {
     auto [index_map, dofmap]
-        = DofMapBuilder::build(comm, topology, *element_dof_layout, 1);
+        = DofMapBuilder::build(comm, topology, *element_dof_layout, 1, reorder);
     return {element_dof_layout, index_map, std::move(dofmap)};
   }
   else
   {
     auto [index_map, dofmap] = DofMapBuilder::build(
-        comm, topology, *element_dof_layout->sub_dofmap({0}), bs);
+        comm, topology, *element_dof_layout->sub_dofmap({0}), bs, reorder);
     return {element_dof_layout, index_map, std::move(dofmap)};
   }
 }
 //-----------------------------------------------------------------------------
 std::pair<std::shared_ptr<common::IndexMap>, graph::AdjacencyList<std::int32_t>>
 DofMapBuilder::build(MPI_Comm comm, const mesh::Topology& topology,
-                     const ElementDofLayout& element_dof_layout, int block_size)
+                     const ElementDofLayout& element_dof_layout,
+                     int block_size, ReorderingStrategy reorder, bool expand)
 {
   common::Timer t0("Init dofmap");
 
@@ -547,19 +591,55 @@ DofMapBuilder::build(MPI_Comm comm, const mesh::Topology& topology,
 
   // Build re-ordering map for data locality and get number of owned
   // nodes
-  const auto [old_to_new, num_owned]
-      = compute_reordering_map(node_graph0, dof_entity0, topology);
+  auto [old_to_new, num_owned]
+      = compute_reordering_map(node_graph0, dof_entity0, topology, reorder);
 
   // Compute process offset for owned nodes
   const std::int64_t process_offset
       = dolfinx::MPI::global_offset(comm, num_owned, true);
 
   // Get global indices for unowned dofs
-  const auto [local_to_global_unowned, local_to_global_owner]
+  auto [local_to_global_unowned, local_to_global_owner]
       = get_global_indices(topology, num_owned, process_offset,
                            local_to_global0, old_to_new, dof_entity0);
   assert(local_to_global_unowned.size() == local_to_global_owner.size());
 
+  // Group the unowned dofs by owning rank, sorted by global index
+  // within each rank. The ghost section of vectors then matches the
+  // order in which scatter data is exchanged, so IndexMap can pack,
+  // send and receive per-neighbour blocks contiguously instead of
+  // gathering from scattered ghost positions (see
+  // IndexMap::scatter_fwd).
+  {
+    const std::int32_t num_unowned = local_to_global_unowned.size();
+    std::vector<std::int32_t> perm(num_unowned);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::sort(perm.begin(), perm.end(),
+              [&owner = local_to_global_owner,
+               &global = local_to_global_unowned](std::int32_t a,
+                                                  std::int32_t b) {
+                return std::make_pair(owner[a], global[a])
+                       < std::make_pair(owner[b], global[b]);
+              });
+
+    std::vector<std::int32_t> new_ghost_pos(num_unowned);
+    std::vector<std::int64_t> unowned_sorted(num_unowned);
+    std::vector<int> owner_sorted(num_unowned);
+    for (std::int32_t i = 0; i < num_unowned; ++i)
+    {
+      new_ghost_pos[perm[i]] = i;
+      unowned_sorted[i] = local_to_global_unowned[perm[i]];
+      owner_sorted[i] = local_to_global_owner[perm[i]];
+    }
+    local_to_global_unowned = std::move(unowned_sorted);
+    local_to_global_owner = std::move(owner_sorted);
+    for (std::int32_t& node : old_to_new)
+    {
+      if (node >= num_owned)
+        node = num_owned + new_ghost_pos[node - num_owned];
+    }
+  }
+
   // Create IndexMap for dofs range on this process
   auto index_map = std::make_unique<common::IndexMap>(
       comm, num_owned, local_to_global_unowned, local_to_global_owner,
@@ -568,31 +648,221 @@ DofMapBuilder::build(MPI_Comm comm, const mesh::Topology& topology,
 
   // FIXME: There is an assumption here on the dof order for an element.
   //        It should come from the ElementDofLayout.
-  // Build re-ordered dofmap, accounting for block size
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dofmap(
-      node_graph0.array().rows() * block_size);
-  for (std::int32_t cell = 0; cell < node_graph0.num_nodes(); ++cell)
+  // Build re-ordered dofmap, accounting for block size. With expand
+  // false the blocks are left implicit (bs = 1 writes the re-ordered
+  // node indices unscaled).
+  const std::int32_t bs = expand ? block_size : 1;
+  std::vector<std::int32_t> dofmap(node_graph0.array().rows() * bs);
+  parallel_for(
+      node_graph0.num_nodes(), [&, bs](std::int32_t begin, std::int32_t end) {
+        for (std::int32_t cell = begin; cell < end; ++cell)
+        {
+          const std::int32_t local_dim0 = node_graph0.num_links(cell);
+          auto old_nodes = node_graph0.links(cell);
+          for (std::int32_t j = 0; j < local_dim0; ++j)
+          {
+            const std::int32_t old_node = old_nodes[j];
+            const std::int32_t new_node = old_to_new[old_node];
+            for (std::int32_t block = 0; block < bs; ++block)
+            {
+              dofmap[cell * bs * local_dim0 + block * local_dim0 + j]
+                  = bs * new_node + block;
+            }
+          }
+        }
+      });
+
+  assert(dofmap.size() % node_graph0.num_nodes() == 0);
+  const std::int32_t width = dofmap.size() / node_graph0.num_nodes();
+  std::vector<std::int32_t> dofmap_offsets(node_graph0.num_nodes() + 1);
+  for (std::size_t i = 0; i < dofmap_offsets.size(); ++i)
+    dofmap_offsets[i] = i * width;
+
+  return {std::move(index_map),
+          graph::AdjacencyList<std::int32_t>(std::move(dofmap),
+                                             std::move(dofmap_offsets))};
+}
+//-----------------------------------------------------------------------------
+std::pair<std::shared_ptr<common::IndexMap>, graph::AdjacencyList<std::int32_t>>
+DofMapBuilder::merge_periodic_dofs(
+    MPI_Comm comm, const common::IndexMap& index_map,
+    const graph::AdjacencyList<std::int32_t>& dofmap,
+    const std::vector<std::array<std::int64_t, 2>>& dof_pairs)
+{
+  common::Timer t0("Merge periodic dofs");
+  const int mpi_size = dolfinx::MPI::size(comm);
+  const std::array<std::int64_t, 2> range = index_map.local_range();
+  const std::int32_t num_owned = index_map.size_local();
+
+  // Ownership is contiguous per rank, so the owner of a global index
+  // can be located in the allgathered ranges
+  auto owner_of
+      = [](const std::vector<std::int64_t>& ranges, std::int64_t global) {
+          auto it = std::upper_bound(ranges.begin(), ranges.end(), global);
+          return std::distance(ranges.begin(), it) - 1;
+        };
+  std::vector<std::int64_t> old_ranges(mpi_size + 1, 0);
+  std::int64_t size64 = num_owned;
+  MPI_Allgather(&size64, 1, MPI_INT64_T, old_ranges.data() + 1, 1, MPI_INT64_T,
+                comm);
+  std::partial_sum(old_ranges.begin(), old_ranges.end(), old_ranges.begin());
+
+  // Record the master of each owned slave dof
+  std::vector<std::int64_t> master_of(num_owned, -1);
+  for (const std::array<std::int64_t, 2>& pair : dof_pairs)
   {
-    const std::int32_t local_dim0 = node_graph0.num_links(cell);
-    auto old_nodes = node_graph0.links(cell);
-    for (std::int32_t j = 0; j < local_dim0; ++j)
+    if (pair[0] < range[0] or pair[0] >= range[1])
     {
-      const std::int32_t old_node = old_nodes[j];
-      const std::int32_t new_node = old_to_new[old_node];
-      for (std::int32_t block = 0; block < block_size; ++block)
+      throw std::runtime_error("Periodic dof pairs must be supplied on the "
+                               "rank owning the slave dof.");
+    }
+    if (pair[0] == pair[1])
+      continue;
+    const std::int32_t slave = pair[0] - range[0];
+    if (master_of[slave] != -1 and master_of[slave] != pair[1])
+      throw std::runtime_error("Conflicting masters for periodic dof.");
+    master_of[slave] = pair[1];
+  }
+
+  // Compact new numbering of the surviving owned dofs, keeping their
+  // relative order
+  std::int32_t num_new_owned = 0;
+  for (std::int32_t v = 0; v < num_owned; ++v)
+  {
+    if (master_of[v] == -1)
+      ++num_new_owned;
+  }
+  const std::int64_t new_offset
+      = dolfinx::MPI::global_offset(comm, num_new_owned, true);
+  std::vector<std::int64_t> new_global(num_owned, -1);
+  for (std::int32_t v = 0, c = 0; v < num_owned; ++v)
+  {
+    if (master_of[v] == -1)
+      new_global[v] = new_offset + c++;
+  }
+  std::vector<std::int64_t> new_ranges(mpi_size + 1, 0);
+  size64 = num_new_owned;
+  MPI_Allgather(&size64, 1, MPI_INT64_T, new_ranges.data() + 1, 1, MPI_INT64_T,
+                comm);
+  std::partial_sum(new_ranges.begin(), new_ranges.end(), new_ranges.begin());
+
+  // Fetch the new global index of each slave's master from the
+  // master's owner. After this exchange new_global is the resolved new
+  // index for every owned dof, slave or not.
+  {
+    std::vector<std::vector<std::int64_t>> send_req(mpi_size);
+    std::vector<std::vector<std::int32_t>> req_slave(mpi_size);
+    for (std::int32_t v = 0; v < num_owned; ++v)
+    {
+      if (master_of[v] != -1)
       {
-        dofmap[cell * block_size * local_dim0 + block * local_dim0 + j]
-            = block_size * new_node + block;
+        const int p = owner_of(old_ranges, master_of[v]);
+        send_req[p].push_back(master_of[v]);
+        req_slave[p].push_back(v);
       }
     }
+    const graph::AdjacencyList<std::int64_t> recv_req = dolfinx::MPI::all_to_all(
+        comm, graph::AdjacencyList<std::int64_t>(send_req));
+    std::vector<std::vector<std::int64_t>> send_ans(mpi_size);
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      auto requests = recv_req.links(p);
+      for (int k = 0; k < requests.rows(); ++k)
+      {
+        const std::int32_t local = requests[k] - range[0];
+        assert(local >= 0 and local < num_owned);
+        if (master_of[local] != -1)
+        {
+          throw std::runtime_error("A periodic master dof is itself a slave. "
+                                   "Chained pairs are not resolved.");
+        }
+        send_ans[p].push_back(new_global[local]);
+      }
+    }
+    const graph::AdjacencyList<std::int64_t> recv_ans = dolfinx::MPI::all_to_all(
+        comm, graph::AdjacencyList<std::int64_t>(send_ans));
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      auto answers = recv_ans.links(p);
+      for (int k = 0; k < answers.rows(); ++k)
+        new_global[req_slave[p][k]] = answers[k];
+    }
   }
 
-  assert(dofmap.rows() % node_graph0.num_nodes() == 0);
-  Eigen::Map<Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
-                          Eigen::RowMajor>>
-      _dofmap(dofmap.data(), node_graph0.num_nodes(),
-              dofmap.rows() / node_graph0.num_nodes());
+  // Fetch the resolved new global index of each old ghost from its
+  // owner (for ghosts that were slaves this is the master's new index)
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts_old
+      = index_map.ghosts();
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& ghost_owner_rank
+      = index_map.ghost_owners();
+  std::vector<std::int64_t> ghost_new(ghosts_old.rows(), -1);
+  {
+    std::vector<std::vector<std::int64_t>> send_req(mpi_size);
+    std::vector<std::vector<std::int32_t>> req_pos(mpi_size);
+    for (Eigen::Index g = 0; g < ghosts_old.rows(); ++g)
+    {
+      const int p = ghost_owner_rank[g];
+      send_req[p].push_back(ghosts_old[g]);
+      req_pos[p].push_back(g);
+    }
+    const graph::AdjacencyList<std::int64_t> recv_req = dolfinx::MPI::all_to_all(
+        comm, graph::AdjacencyList<std::int64_t>(send_req));
+    std::vector<std::vector<std::int64_t>> send_ans(mpi_size);
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      auto requests = recv_req.links(p);
+      for (int k = 0; k < requests.rows(); ++k)
+      {
+        const std::int32_t local = requests[k] - range[0];
+        assert(local >= 0 and local < num_owned);
+        send_ans[p].push_back(new_global[local]);
+      }
+    }
+    const graph::AdjacencyList<std::int64_t> recv_ans = dolfinx::MPI::all_to_all(
+        comm, graph::AdjacencyList<std::int64_t>(send_ans));
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      auto answers = recv_ans.links(p);
+      for (int k = 0; k < answers.rows(); ++k)
+        ghost_new[req_pos[p][k]] = answers[k];
+    }
+  }
 
-  return {std::move(index_map), graph::AdjacencyList<std::int32_t>(_dofmap)};
+  // Rewrite the dofmap in the new numbering. Dofs outside the new
+  // owned range (old ghosts, and slaves whose master lives on another
+  // rank) become ghosts of the new map.
+  std::unordered_map<std::int64_t, std::int32_t> global_to_local_ghost;
+  std::vector<std::int64_t> new_ghosts;
+  std::vector<int> new_ghost_owners;
+  auto new_local = [&](std::int64_t global) -> std::int32_t {
+    if (global >= new_offset and global < new_offset + num_new_owned)
+      return global - new_offset;
+    const std::int32_t next = num_new_owned + new_ghosts.size();
+    auto [it, inserted] = global_to_local_ghost.insert({global, next});
+    if (inserted)
+    {
+      new_ghosts.push_back(global);
+      new_ghost_owners.push_back(owner_of(new_ranges, global));
+    }
+    return it->second;
+  };
+  const auto& old_array = dofmap.array();
+  std::vector<std::int32_t> new_array(old_array.rows());
+  for (Eigen::Index i = 0; i < old_array.rows(); ++i)
+  {
+    const std::int32_t l = old_array[i];
+    const std::int64_t global
+        = l < num_owned ? new_global[l] : ghost_new[l - num_owned];
+    assert(global != -1);
+    new_array[i] = new_local(global);
+  }
+  std::vector<std::int32_t> new_offsets(
+      dofmap.offsets().data(), dofmap.offsets().data() + dofmap.offsets().rows());
+
+  auto new_index_map = std::make_shared<common::IndexMap>(
+      comm, num_new_owned, new_ghosts, new_ghost_owners,
+      index_map.block_size());
+  return {new_index_map, graph::AdjacencyList<std::int32_t>(
+                             std::move(new_array), std::move(new_offsets))};
 }
 //-----------------------------------------------------------------------------
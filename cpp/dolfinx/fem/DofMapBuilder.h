@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <array>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <memory>
 #include <mpi.h>
@@ -29,6 +30,16 @@ namespace fem
 {
 class ElementDofLayout;
 
+/// Strategy for re-ordering the owned dofs. The ordering controls the
+/// bandwidth of assembled matrices, which in turn affects SpMV and
+/// incomplete-factorisation performance.
+enum class ReorderingStrategy
+{
+  scotch, ///< SCOTCH Gibbs-Poole-Stockmeyer ordering (default)
+  rcm,    ///< Reverse Cuthill-McKee via Boost
+  random  ///< Random ordering, for testing/benchmarking only
+};
+
 /// Builds a DofMap on a mesh::Mesh
 
 class DofMapBuilder
@@ -40,13 +51,45 @@ public:
                     std::shared_ptr<const common::IndexMap>,
                     graph::AdjacencyList<std::int32_t>>
   build(MPI_Comm comm, const mesh::Topology& topology,
-        std::shared_ptr<const ElementDofLayout> element_dof_layout);
+        std::shared_ptr<const ElementDofLayout> element_dof_layout,
+        ReorderingStrategy reorder = ReorderingStrategy::scotch);
 
-  /// Build dofmap
+  /// Build dofmap. If expand is false the returned adjacency list
+  /// holds the unexpanded dof nodes rather than the block-expanded dof
+  /// indices; cell dofs are then block_size * node + component (used
+  /// for implicit DofMaps).
   static std::pair<std::shared_ptr<common::IndexMap>,
                    graph::AdjacencyList<std::int32_t>>
   build(MPI_Comm comm, const mesh::Topology& topology,
-        const ElementDofLayout& element_dof_layout, int block_size);
+        const ElementDofLayout& element_dof_layout, int block_size,
+        ReorderingStrategy reorder = ReorderingStrategy::scotch,
+        bool expand = true);
+
+  /// Merge matched (slave, master) dof pairs of a built dofmap into
+  /// single dofs, e.g. to identify the dofs on the two sides of a
+  /// periodic boundary. Every slave dof is removed from the index map
+  /// and its cell-dof entries are rewritten to the master dof, so
+  /// operators assembled with the returned map are natively periodic
+  /// and no constraint matrix is needed at solve time. The surviving
+  /// dofs are renumbered compactly, keeping their relative order.
+  /// Collective.
+  /// @param[in] comm MPI communicator
+  /// @param[in] index_map Index map of the dofmap to merge (unexpanded
+  ///   node map for blocked spaces; pairs are then node indices and
+  ///   all block components are identified together)
+  /// @param[in] dofmap The dofmap to merge
+  /// @param[in] dof_pairs Matched (slave, master) pairs as global dof
+  ///   indices, e.g. from a geometric relation between the boundary
+  ///   coordinates. Each pair must be supplied on the rank owning the
+  ///   slave dof; a master must not itself be a slave (chains are not
+  ///   resolved)
+  /// @return New index map (without the slave dofs) and the rewritten
+  ///   dofmap
+  static std::pair<std::shared_ptr<common::IndexMap>,
+                   graph::AdjacencyList<std::int32_t>>
+  merge_periodic_dofs(MPI_Comm comm, const common::IndexMap& index_map,
+                      const graph::AdjacencyList<std::int32_t>& dofmap,
+                      const std::vector<std::array<std::int64_t, 2>>& dof_pairs);
 };
 } // namespace fem
 } // namespace dolfinx
@@ -78,6 +78,23 @@ ElementDofLayout::ElementDofLayout(
     }
   }
 
+  // Flatten the entity dof lists so that the per-entity queries do not
+  // touch std::set. The sets iterate in ascending order, so the flat
+  // arrays preserve the dof ordering of the set-based accessors.
+  _entity_dofs_offset.fill(0);
+  _entity_closure_dofs_offset.fill(0);
+  for (std::size_t dim = 0; dim < entity_dofs.size(); ++dim)
+  {
+    _entity_dofs_offset[dim] = _entity_dofs_flat.size();
+    for (const std::set<int>& edofs : _entity_dofs[dim])
+      _entity_dofs_flat.insert(_entity_dofs_flat.end(), edofs.begin(),
+                               edofs.end());
+    _entity_closure_dofs_offset[dim] = _entity_closure_dofs_flat.size();
+    for (const std::set<int>& edofs : _entity_closure_dofs[dim])
+      _entity_closure_dofs_flat.insert(_entity_closure_dofs_flat.end(),
+                                       edofs.begin(), edofs.end());
+  }
+
   // Check that base_permutations has the correct shape
   int perm_count = 0;
   const std::array<int, 4> perms_per_dim = {0, 1, 2, 4};
@@ -117,27 +134,6 @@ int ElementDofLayout::num_entity_closure_dofs(int dim) const
   return _num_entity_closure_dofs.at(dim);
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, 1>
-ElementDofLayout::entity_dofs(int entity_dim, int cell_entity_index) const
-{
-  const std::set<int>& edofs
-      = _entity_dofs.at(entity_dim).at(cell_entity_index);
-  Eigen::Array<int, Eigen::Dynamic, 1> dofs(edofs.size());
-  std::copy(edofs.begin(), edofs.end(), dofs.data());
-  return dofs;
-}
-//-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, 1>
-ElementDofLayout::entity_closure_dofs(int entity_dim,
-                                      int cell_entity_index) const
-{
-  const std::set<int>& edofs
-      = _entity_closure_dofs.at(entity_dim).at(cell_entity_index);
-  Eigen::Array<int, Eigen::Dynamic, 1> dofs(edofs.size());
-  std::copy(edofs.begin(), edofs.end(), dofs.data());
-  return dofs;
-}
-//-----------------------------------------------------------------------------
 const std::vector<std::vector<std::set<int>>>&
 ElementDofLayout::entity_dofs_all() const
 {
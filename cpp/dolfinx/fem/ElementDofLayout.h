@@ -99,19 +99,40 @@ public:
   ///   dimension
   int num_entity_closure_dofs(int dim) const;
 
-  /// Local-local mapping of dofs on entity of cell
+  /// Local-local mapping of dofs on entity of cell. The dofs are
+  /// stored in flat offset-indexed arrays, so this query is two index
+  /// computations and no allocation.
   /// @param[in] entity_dim The entity dimension
   /// @param[in] cell_entity_index The local entity index on the cell
-  /// @return Degrees of freedom on a single element.
-  Eigen::Array<int, Eigen::Dynamic, 1> entity_dofs(int entity_dim,
-                                                   int cell_entity_index) const;
+  /// @return Degrees of freedom on a single element (view into this
+  ///   object, valid for its lifetime)
+  Eigen::Map<const Eigen::Array<int, Eigen::Dynamic, 1>>
+  entity_dofs(int entity_dim, int cell_entity_index) const
+  {
+    const int num_dofs = _num_entity_dofs[entity_dim];
+    return Eigen::Map<const Eigen::Array<int, Eigen::Dynamic, 1>>(
+        _entity_dofs_flat.data() + _entity_dofs_offset[entity_dim]
+            + num_dofs * cell_entity_index,
+        num_dofs);
+  }
 
-  /// Local-local closure dofs on entity of cell
+  /// Local-local closure dofs on entity of cell. The dofs are stored
+  /// in flat offset-indexed arrays, so this query is two index
+  /// computations and no allocation.
   /// @param[in] entity_dim The entity dimension
   /// @param[in] cell_entity_index The local entity index on the cell
-  /// @return Degrees of freedom on a single element
-  Eigen::Array<int, Eigen::Dynamic, 1>
-  entity_closure_dofs(int entity_dim, int cell_entity_index) const;
+  /// @return Degrees of freedom on a single element (view into this
+  ///   object, valid for its lifetime)
+  Eigen::Map<const Eigen::Array<int, Eigen::Dynamic, 1>>
+  entity_closure_dofs(int entity_dim, int cell_entity_index) const
+  {
+    const int num_dofs = _num_entity_closure_dofs[entity_dim];
+    return Eigen::Map<const Eigen::Array<int, Eigen::Dynamic, 1>>(
+        _entity_closure_dofs_flat.data()
+            + _entity_closure_dofs_offset[entity_dim]
+            + num_dofs * cell_entity_index,
+        num_dofs);
+  }
 
   /// Direct access to all entity dofs (dof = _entity_dofs[dim][entity][i])
   const std::vector<std::vector<std::set<int>>>& entity_dofs_all() const;
@@ -173,6 +194,14 @@ private:
   // List of dofs with connected entities of lower dimension
   std::vector<std::vector<std::set<int>>> _entity_closure_dofs;
 
+  // Flattened entity (closure) dofs in ascending order, with per-dim
+  // offsets. dof = _entity_dofs_flat[_entity_dofs_offset[dim]
+  // + _num_entity_dofs[dim]*entity + i]
+  std::vector<int> _entity_dofs_flat;
+  std::vector<int> _entity_closure_dofs_flat;
+  std::array<int, 4> _entity_dofs_offset;
+  std::array<int, 4> _entity_closure_dofs_offset;
+
   // List of sub dofmaps
   std::vector<std::shared_ptr<const ElementDofLayout>> _sub_dofmaps;
 
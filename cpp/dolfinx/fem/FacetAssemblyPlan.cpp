@@ -0,0 +1,126 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "FacetAssemblyPlan.h"
+#include "Form.h"
+#include <algorithm>
+#include <cassert>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+//-----------------------------------------------------------------------------
+FacetAssemblyPlan::FacetAssemblyPlan(const Form& L)
+{
+  std::shared_ptr<const mesh::Mesh> mesh = L.mesh();
+  assert(mesh);
+  const int tdim = mesh->topology().dim();
+
+  mesh->topology_mutable().create_entities(tdim - 1);
+  mesh->topology_mutable().create_connectivity(tdim - 1, tdim);
+  mesh->topology_mutable().create_entity_permutations();
+
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+
+  const Eigen::Array<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic>& perms
+      = mesh->topology().get_facet_permutations();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  auto f_to_c = mesh->topology().connectivity(tdim - 1, tdim);
+  assert(f_to_c);
+  auto c_to_f = mesh->topology().connectivity(tdim, tdim - 1);
+  assert(c_to_f);
+
+  const FormIntegrals& integrals = L.integrals();
+  using type = fem::FormIntegrals::Type;
+  const int num_integrals = integrals.num_integrals(type::exterior_facet);
+  _integrals.resize(num_integrals);
+  for (int i = 0; i < num_integrals; ++i)
+  {
+    const std::vector<std::int32_t>& active_facets
+        = integrals.integral_domains(type::exterior_facet, i);
+
+    FacetData& plan = _integrals[i];
+    plan.cells.reserve(active_facets.size());
+    plan.local_facets.reserve(active_facets.size());
+    plan.perms.reserve(active_facets.size());
+    plan.cell_info.reserve(active_facets.size());
+    plan.x_dofs.reserve(active_facets.size() * num_dofs_g);
+
+    for (std::int32_t f : active_facets)
+    {
+      // Get index of first attached cell
+      assert(f_to_c->num_links(f) > 0);
+      const std::int32_t cell = f_to_c->links(f)[0];
+
+      // Get local index of facet with respect to the cell
+      auto facets = c_to_f->links(cell);
+      const auto* it
+          = std::find(facets.data(), facets.data() + facets.rows(), f);
+      assert(it != (facets.data() + facets.rows()));
+      const int local_facet = std::distance(facets.data(), it);
+
+      plan.cells.push_back(cell);
+      plan.local_facets.push_back(local_facet);
+      plan.perms.push_back(perms(local_facet, cell));
+      plan.cell_info.push_back(cell_info[cell]);
+
+      auto x_dofs = x_dofmap.links(cell);
+      for (int j = 0; j < num_dofs_g; ++j)
+        plan.x_dofs.push_back(x_dofs[j]);
+    }
+  }
+
+  const int num_interior_integrals
+      = integrals.num_integrals(type::interior_facet);
+  _interior_integrals.resize(num_interior_integrals);
+  for (int i = 0; i < num_interior_integrals; ++i)
+  {
+    const std::vector<std::int32_t>& active_facets
+        = integrals.integral_domains(type::interior_facet, i);
+
+    InteriorFacetData& plan = _interior_integrals[i];
+    plan.cells.reserve(2 * active_facets.size());
+    plan.local_facets.reserve(2 * active_facets.size());
+    plan.perms.reserve(2 * active_facets.size());
+    plan.cell_info.reserve(active_facets.size());
+    plan.x_dofs.reserve(2 * active_facets.size() * num_dofs_g);
+
+    for (std::int32_t f : active_facets)
+    {
+      // Get the two attached cells
+      auto cells = f_to_c->links(f);
+      assert(cells.rows() == 2);
+
+      for (int k = 0; k < 2; ++k)
+      {
+        // Get local index of facet with respect to the cell
+        auto facets = c_to_f->links(cells[k]);
+        const auto* it
+            = std::find(facets.data(), facets.data() + facets.rows(), f);
+        assert(it != (facets.data() + facets.rows()));
+        const int local_facet = std::distance(facets.data(), it);
+
+        plan.cells.push_back(cells[k]);
+        plan.local_facets.push_back(local_facet);
+        plan.perms.push_back(perms(local_facet, cells[k]));
+
+        auto x_dofs = x_dofmap.links(cells[k]);
+        for (int j = 0; j < num_dofs_g; ++j)
+          plan.x_dofs.push_back(x_dofs[j]);
+      }
+      plan.cell_info.push_back(cell_info[cells[0]]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx
+{
+namespace fem
+{
+class Form;
+
+/// Precomputed assembly plan for the facet integrals of a form. For
+/// each active facet the plan caches the attached cell(s), the local
+/// facet index within each cell, the facet permutation(s) and the cell
+/// permutation info, and the coordinate-dof indices for the geometry
+/// gather. For interior facets the plan additionally stores the
+/// scatter map that places the per-cell packed coefficients into the
+/// stacked two-cell coefficient array expected by DG kernels. Building
+/// the plan performs the facet-to-cell and cell-to-facet searches once;
+/// repeated assemblies with the plan then only run the kernel. The plan
+/// is invalidated by any change to the mesh topology or to the
+/// integration domains of the form.
+
+class FacetAssemblyPlan
+{
+public:
+  /// Cached data for the active facets of one exterior facet integral
+  struct FacetData
+  {
+    /// Attached cell for each active facet
+    std::vector<std::int32_t> cells;
+
+    /// Local index of the facet with respect to the attached cell
+    std::vector<int> local_facets;
+
+    /// Facet permutation passed to the kernel
+    std::vector<std::uint8_t> perms;
+
+    /// Cell permutation info passed to the kernel
+    std::vector<std::uint32_t> cell_info;
+
+    /// Coordinate dof indices for the geometry gather, flattened with
+    /// stride num_dofs_g (one row per facet)
+    std::vector<std::int32_t> x_dofs;
+  };
+
+  /// Cached data for the active facets of one interior facet integral.
+  /// Per-facet data is stored for the two attached cells back-to-back,
+  /// so entries 2*f and 2*f + 1 belong to facet f.
+  struct InteriorFacetData
+  {
+    /// The two attached cells for each active facet
+    std::vector<std::int32_t> cells;
+
+    /// Local index of the facet with respect to each attached cell
+    std::vector<int> local_facets;
+
+    /// Facet permutation for each attached cell
+    std::vector<std::uint8_t> perms;
+
+    /// Cell permutation info passed to the kernel (one entry per facet,
+    /// taken from the first attached cell)
+    std::vector<std::uint32_t> cell_info;
+
+    /// Coordinate dof indices for the stacked two-cell geometry gather,
+    /// flattened with stride 2*num_dofs_g (one row per facet)
+    std::vector<std::int32_t> x_dofs;
+  };
+
+  /// Build the plan for all facet integrals of a form
+  /// @param[in] L The form to build the plan for
+  explicit FacetAssemblyPlan(const Form& L);
+
+  /// Number of exterior facet integrals covered by the plan
+  int num_integrals() const { return _integrals.size(); }
+
+  /// Cached facet data for the ith exterior facet integral
+  const FacetData& data(int i) const { return _integrals.at(i); }
+
+  /// Number of interior facet integrals covered by the plan
+  int num_interior_integrals() const { return _interior_integrals.size(); }
+
+  /// Cached facet data for the ith interior facet integral
+  const InteriorFacetData& interior_data(int i) const
+  {
+    return _interior_integrals.at(i);
+  }
+
+private:
+  std::vector<FacetData> _integrals;
+  std::vector<InteriorFacetData> _interior_integrals;
+};
+} // namespace fem
+} // namespace dolfinx
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "FiniteElement.h"
+#include <Eigen/Dense>
 #include <dolfinx/common/log.h>
 #include <dolfinx/mesh/utils.h>
 #include <functional>
@@ -15,6 +16,52 @@
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Monomial exponents spanning the polynomial space of a Lagrange
+// element: total degree <= k on simplices, degree <= k per direction
+// on hypercubes. Empty for unsupported cells.
+std::vector<std::array<int, 3>> monomial_exponents(mesh::CellType cell,
+                                                   int degree)
+{
+  std::vector<std::array<int, 3>> exponents;
+  switch (cell)
+  {
+  case mesh::CellType::interval:
+    for (int i = 0; i <= degree; ++i)
+      exponents.push_back({i, 0, 0});
+    break;
+  case mesh::CellType::triangle:
+    for (int i = 0; i <= degree; ++i)
+      for (int j = 0; j <= degree - i; ++j)
+        exponents.push_back({i, j, 0});
+    break;
+  case mesh::CellType::tetrahedron:
+    for (int i = 0; i <= degree; ++i)
+      for (int j = 0; j <= degree - i; ++j)
+        for (int k = 0; k <= degree - i - j; ++k)
+          exponents.push_back({i, j, k});
+    break;
+  case mesh::CellType::quadrilateral:
+    for (int i = 0; i <= degree; ++i)
+      for (int j = 0; j <= degree; ++j)
+        exponents.push_back({i, j, 0});
+    break;
+  case mesh::CellType::hexahedron:
+    for (int i = 0; i <= degree; ++i)
+      for (int j = 0; j <= degree; ++j)
+        for (int k = 0; k <= degree; ++k)
+          exponents.push_back({i, j, k});
+    break;
+  default:
+    break;
+  }
+  return exponents;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 FiniteElement::FiniteElement(const ufc_finite_element& ufc_element)
     : _signature(ufc_element.signature), _family(ufc_element.family),
@@ -77,6 +124,46 @@ FiniteElement::FiniteElement(const ufc_finite_element& ufc_element)
     _sub_elements.push_back(std::make_shared<FiniteElement>(*ufc_sub_element));
     std::free(ufc_sub_element);
   }
+
+  // Build the direct tabulation coefficients for scalar Lagrange
+  // elements: the basis is expressed in the monomial basis of the
+  // element's polynomial space by inverting the Vandermonde matrix at
+  // the dof coordinates, so tabulation becomes one dense product over
+  // all points instead of a call into generated code per batch. The
+  // construction depends only on the dof coordinates, so it is
+  // independent of the dof ordering convention of the generated code.
+  if (_has_refX and _value_size == 1
+      and (_family == "Lagrange" or _family == "Discontinuous Lagrange"
+           or _family == "Q" or _family == "DQ"))
+  {
+    const std::vector<std::array<int, 3>> exponents
+        = monomial_exponents(_cell_shape, _degree);
+    if ((int)exponents.size() == _space_dim)
+    {
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+          vandermonde(_space_dim, _space_dim);
+      for (int p = 0; p < _space_dim; ++p)
+      {
+        for (int j = 0; j < _space_dim; ++j)
+        {
+          double m = 1.0;
+          for (int d = 0; d < _tdim; ++d)
+            for (int e = 0; e < exponents[j][d]; ++e)
+              m *= _refX(p, d);
+          vandermonde(p, j) = m;
+        }
+      }
+
+      Eigen::FullPivLU<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor>>
+          lu(vandermonde);
+      if (lu.isInvertible())
+      {
+        _monomial_coeffs = lu.inverse();
+        _monomial_exponents = exponents;
+      }
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 std::string FiniteElement::signature() const { return _signature; }
@@ -112,8 +199,39 @@ void FiniteElement::evaluate_reference_basis(
     const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
                                         Eigen::RowMajor>>& X) const
 {
-  assert(_evaluate_reference_basis);
   const int num_points = X.rows();
+
+  // Direct path for Lagrange elements, selected at construction:
+  // evaluate the monomial basis at all points and apply the
+  // precomputed coefficients as one dense product. The product
+  // vectorizes over the point batch, unlike the per-point generated
+  // code reached through the stored function pointer.
+  if (_monomial_coeffs.size() > 0)
+  {
+    const int num_monomials = _monomial_exponents.size();
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        monomials(num_points, num_monomials);
+    for (int p = 0; p < num_points; ++p)
+    {
+      for (int j = 0; j < num_monomials; ++j)
+      {
+        double m = 1.0;
+        for (int d = 0; d < _tdim; ++d)
+          for (int e = 0; e < _monomial_exponents[j][d]; ++e)
+            m *= X(p, d);
+        monomials(p, j) = m;
+      }
+    }
+
+    // reference_values has shape (num_points, space_dim, 1)
+    Eigen::Map<
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+        values(reference_values.data(), num_points, _space_dim);
+    values.noalias() = monomials * _monomial_coeffs;
+    return;
+  }
+
+  assert(_evaluate_reference_basis);
   int ret = _evaluate_reference_basis(reference_values.data(), num_points,
                                       X.data());
   if (ret == -1)
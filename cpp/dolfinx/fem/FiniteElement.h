@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <array>
 #include <dolfinx/common/types.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <functional>
@@ -139,6 +140,13 @@ private:
   bool _has_refX;
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> _refX;
 
+  // Monomial exponents and coefficients for the direct Lagrange
+  // tabulation path, built once at construction. Empty when only the
+  // generated code path is available.
+  std::vector<std::array<int, 3>> _monomial_exponents;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      _monomial_coeffs;
+
   // List of sub-elements (if any)
   std::vector<std::shared_ptr<const FiniteElement>> _sub_elements;
 
@@ -205,3 +205,29 @@ Form::constants() const
 //-----------------------------------------------------------------------------
 const fem::FormIntegrals& Form::integrals() const { return _integrals; }
 //-----------------------------------------------------------------------------
+std::vector<std::size_t> Form::dependency_versions() const
+{
+  std::vector<std::size_t> versions;
+  versions.reserve(1 + _coefficients.size() + _constants.size());
+  versions.push_back(_mesh ? _mesh->geometry().version() : 0);
+  for (int i = 0; i < _coefficients.size(); ++i)
+  {
+    auto f = _coefficients.get(i);
+    versions.push_back(f ? f->version() : 0);
+  }
+  for (const auto& c : _constants)
+    versions.push_back(c.second ? c.second->version() : 0);
+  return versions;
+}
+//-----------------------------------------------------------------------------
+void Form::record_dependency_versions() const
+{
+  _dep_versions = dependency_versions();
+  _deps_recorded = true;
+}
+//-----------------------------------------------------------------------------
+bool Form::is_up_to_date() const
+{
+  return _deps_recorded and _dep_versions == dependency_versions();
+}
+//-----------------------------------------------------------------------------
@@ -207,7 +207,56 @@ public:
       std::pair<std::string, std::shared_ptr<const function::Constant>>>&
   constants() const;
 
+  /// Record the current versions of the form's dependencies (mesh
+  /// geometry, coefficients and constants). Called by the assemble_*
+  /// entry points after assembly; call it directly when assembling
+  /// through the low-level fem::impl drivers.
+  void record_dependency_versions() const;
+
+  /// Check whether the form has been assembled since any of its
+  /// dependencies (mesh geometry, coefficients or constants) was last
+  /// modified. Drivers can use this to skip reassembly of operators
+  /// that have not changed, e.g. a constant-coefficient stiffness
+  /// matrix in a time-stepping loop. Note that Constant must be
+  /// flagged manually with Constant::mark_modified() since its value
+  /// array is public.
+  /// @return True if dependency versions were recorded and none has
+  ///   changed since; false if the form has never been assembled or a
+  ///   dependency has been modified
+  bool is_up_to_date() const;
+
+  /// Scalar types that generated form kernels can use
+  enum class ScalarType
+  {
+    float32,
+    float64,
+    complex64,
+    complex128
+  };
+
+  /// The scalar type of this build's PETSc scalar
+  static constexpr ScalarType petsc_scalar_type()
+  {
+#ifdef PETSC_USE_COMPLEX
+    return ScalarType::complex128;
+#else
+    return ScalarType::float64;
+#endif
+  }
+
+  /// The scalar type of the attached kernels and coefficient data.
+  /// Defaults to the PETSc scalar of this build. Drivers that attach
+  /// kernels generated for another scalar (e.g. float32 ensemble
+  /// members) set this accordingly and assemble through the
+  /// scalar-templated drivers in fem::impl rather than the PETSc
+  /// entry points, which accept only forms of the PETSc scalar type.
+  ScalarType scalar_type = petsc_scalar_type();
+
 private:
+  // Collect the current version of each dependency (geometry,
+  // coefficients, constants) into a flat list
+  std::vector<std::size_t> dependency_versions() const;
+
   // Integrals associated with the Form
   FormIntegrals _integrals;
 
@@ -223,6 +272,11 @@ private:
 
   // The mesh (needed for functionals when we don't have any spaces)
   std::shared_ptr<const mesh::Mesh> _mesh;
+
+  // Dependency versions recorded at the last assembly; mutable because
+  // assembly of a const Form records versions
+  mutable std::vector<std::size_t> _dep_versions;
+  mutable bool _deps_recorded = false;
 };
 } // namespace fem
 } // namespace dolfinx
@@ -58,13 +58,204 @@ void FormIntegrals::set_tabulate_tensor(
     ++pos;
   }
 
-  // Create new Integral and insert
-  struct FormIntegrals::Integral new_integral
-      = {fn, i, std::vector<std::int32_t>()};
+  // Create new Integral and insert. The optional kernel variants start
+  // empty; they are attached afterwards through their setters.
+  struct FormIntegrals::Integral new_integral;
+  new_integral.tabulate = fn;
+  new_integral.id = i;
 
   integrals.insert(integrals.begin() + pos, new_integral);
 }
 //-----------------------------------------------------------------------------
+void FormIntegrals::add_tabulate_tensor(
+    FormIntegrals::Type type, int id,
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const int*, const std::uint8_t*,
+                       const std::uint32_t)>
+        fn)
+{
+  const int type_index = static_cast<int>(type);
+  std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+
+  // Find the integral with matching ID
+  auto it = std::find_if(integrals.begin(), integrals.end(),
+                         [id](const auto& q) { return q.id == id; });
+  if (it == integrals.end())
+  {
+    throw std::runtime_error("No integral with ID " + std::to_string(id)
+                             + ". Set the first term with "
+                               "set_tabulate_tensor.");
+  }
+
+  // On the first split, the kernel set with set_tabulate_tensor
+  // becomes term 0
+  if (it->term_tabulate.empty())
+    it->term_tabulate.push_back(it->tabulate);
+  it->term_tabulate.push_back(std::move(fn));
+
+  // Rebuild the fused kernel the assemblers invoke: each term
+  // accumulates into the same (zeroed) element tensor, so the sweep
+  // over the domain entities stays a single pass while every term
+  // integrates at its own quadrature cost.
+  it->tabulate
+      = [terms = it->term_tabulate](
+            PetscScalar* A, const PetscScalar* w, const PetscScalar* c,
+            const double* coordinate_dofs, const int* entity_local_index,
+            const std::uint8_t* quadrature_permutation,
+            const std::uint32_t cell_permutation) {
+          for (const auto& term : terms)
+          {
+            term(A, w, c, coordinate_dofs, entity_local_index,
+                 quadrature_permutation, cell_permutation);
+          }
+        };
+}
+//-----------------------------------------------------------------------------
+const std::vector<
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const int*, const std::uint8_t*,
+                       const std::uint32_t)>>&
+FormIntegrals::get_term_tabulate_tensors(FormIntegrals::Type type, int i) const
+{
+  int type_index = static_cast<int>(type);
+  const std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+  return integrals.at(i).term_tabulate;
+}
+//-----------------------------------------------------------------------------
+const std::pair<std::function<void(PetscScalar*, const PetscScalar*,
+                                   const PetscScalar*, const double*,
+                                   const std::uint32_t*, int)>,
+                int>&
+FormIntegrals::get_batch_tabulate_tensor(FormIntegrals::Type type, int i) const
+{
+  int type_index = static_cast<int>(type);
+  const std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+  return integrals.at(i).batch_tabulate;
+}
+//-----------------------------------------------------------------------------
+void FormIntegrals::set_batch_tabulate_tensor(
+    FormIntegrals::Type type, int id, int batch_size,
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const std::uint32_t*, int)>
+        fn)
+{
+  if (batch_size < 1)
+    throw std::runtime_error("Batch size must be at least 1");
+
+  const int type_index = static_cast<int>(type);
+  std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+
+  // Find the integral with matching ID
+  auto it = std::find_if(integrals.begin(), integrals.end(),
+                         [id](const auto& q) { return q.id == id; });
+  if (it == integrals.end())
+  {
+    throw std::runtime_error("No integral with ID " + std::to_string(id)
+                             + ". Set the scalar kernel first.");
+  }
+
+  it->batch_tabulate = {fn, batch_size};
+}
+//-----------------------------------------------------------------------------
+const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const double*, const double*,
+                         const double*, const std::uint32_t)>&
+FormIntegrals::get_geometry_tabulate_tensor(FormIntegrals::Type type,
+                                            int i) const
+{
+  int type_index = static_cast<int>(type);
+  const std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+  return integrals.at(i).geometry_tabulate;
+}
+//-----------------------------------------------------------------------------
+void FormIntegrals::set_geometry_tabulate_tensor(
+    FormIntegrals::Type type, int id,
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const double*, const double*,
+                       const double*, const std::uint32_t)>
+        fn)
+{
+  const int type_index = static_cast<int>(type);
+  std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+
+  // Find the integral with matching ID
+  auto it = std::find_if(integrals.begin(), integrals.end(),
+                         [id](const auto& q) { return q.id == id; });
+  if (it == integrals.end())
+  {
+    throw std::runtime_error("No integral with ID " + std::to_string(id)
+                             + ". Set the standard kernel first.");
+  }
+
+  it->geometry_tabulate = fn;
+}
+//-----------------------------------------------------------------------------
+const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const std::uint32_t)>&
+FormIntegrals::get_qp_tabulate_tensor(FormIntegrals::Type type, int i) const
+{
+  int type_index = static_cast<int>(type);
+  const std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+  return integrals.at(i).qp_tabulate;
+}
+//-----------------------------------------------------------------------------
+void FormIntegrals::set_qp_tabulate_tensor(
+    FormIntegrals::Type type, int id,
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const std::uint32_t)>
+        fn)
+{
+  const int type_index = static_cast<int>(type);
+  std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+
+  // Find the integral with matching ID
+  auto it = std::find_if(integrals.begin(), integrals.end(),
+                         [id](const auto& q) { return q.id == id; });
+  if (it == integrals.end())
+  {
+    throw std::runtime_error("No integral with ID " + std::to_string(id)
+                             + ". Set the standard kernel first.");
+  }
+
+  it->qp_tabulate = fn;
+}
+//-----------------------------------------------------------------------------
+const FormIntegrals::CostEstimate&
+FormIntegrals::cost_estimate(FormIntegrals::Type type, int i) const
+{
+  int type_index = static_cast<int>(type);
+  const std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+  return integrals.at(i).cost;
+}
+//-----------------------------------------------------------------------------
+void FormIntegrals::set_cost_estimate(FormIntegrals::Type type, int id,
+                                      const CostEstimate& cost)
+{
+  const int type_index = static_cast<int>(type);
+  std::vector<struct FormIntegrals::Integral>& integrals
+      = _integrals.at(type_index);
+
+  // Find the integral with matching ID
+  auto it = std::find_if(integrals.begin(), integrals.end(),
+                         [id](const auto& q) { return q.id == id; });
+  if (it == integrals.end())
+  {
+    throw std::runtime_error("No integral with ID " + std::to_string(id)
+                             + ". Set the kernel first.");
+  }
+
+  it->cost = cost;
+}
+//-----------------------------------------------------------------------------
 int FormIntegrals::num_integrals(FormIntegrals::Type type) const
 {
   return _integrals.at(static_cast<int>(type)).size();
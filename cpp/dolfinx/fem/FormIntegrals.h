@@ -9,6 +9,7 @@
 #include <array>
 #include <functional>
 #include <petscsys.h>
+#include <utility>
 #include <vector>
 
 namespace dolfinx
@@ -63,6 +64,170 @@ public:
                          const std::uint32_t)>
           fn);
 
+  /// Add a further 'tabulate_tensor' term kernel to the integral with
+  /// ID id of given type. An integral whose terms require different
+  /// quadrature degrees can be compiled as one kernel per quadrature
+  /// rule instead of integrating every term at the highest degree:
+  /// register the first term with set_tabulate_tensor and each further
+  /// term here. The element tensor is the sum of all term kernels,
+  /// which accumulate into the same (zeroed) output array, so the
+  /// assemblers keep a single sweep over the domain entities while
+  /// each term runs its own quadrature loop at its own cost. All term
+  /// kernels receive the full packed coefficient array of the form.
+  /// The specialised kernels (batched, geometry-factor,
+  /// quadrature-point coefficient), when set, must evaluate the full
+  /// sum of terms themselves.
+  /// @param[in] type Integral type
+  /// @param[in] id Integral ID
+  /// @param[in] fn tabulate function for the additional term
+  void add_tabulate_tensor(
+      FormIntegrals::Type type, int id,
+      std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const int*, const std::uint8_t*,
+                         const std::uint32_t)>
+          fn);
+
+  /// Get the individual term kernels of integral i of given type. The
+  /// list is empty unless the integral has been split with
+  /// add_tabulate_tensor; when non-empty it holds all terms, including
+  /// the one registered with set_tabulate_tensor, and
+  /// get_tabulate_tensor returns their fused sum.
+  /// @param[in] type Integral type
+  /// @param[in] i Integral number
+  /// @return The term kernels of the integral
+  const std::vector<
+      std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const int*, const std::uint8_t*,
+                         const std::uint32_t)>>&
+  get_term_tabulate_tensors(FormIntegrals::Type type, int i) const;
+
+  /// Get the batched 'tabulate_tensor' function for integral i of given
+  /// type. The function may be empty if no batched kernel has been set.
+  /// A batched kernel evaluates the element tensor for several cells in
+  /// one call. Geometry and coefficient data are passed in
+  /// structure-of-arrays layout with the cell (batch) index fastest,
+  /// and the output tensor uses the same layout, i.e. entry (i, j) of
+  /// cell b is at A[(i*n1 + j)*batch_size + b].
+  /// @param[in] type Integral type
+  /// @param[in] i Integral number
+  /// @return Function to call for the batched tabulate_tensor, and the
+  ///   batch size (SIMD width x unroll) the kernel was generated for
+  const std::pair<std::function<void(PetscScalar*, const PetscScalar*,
+                                     const PetscScalar*, const double*,
+                                     const std::uint32_t*, int)>,
+                  int>&
+  get_batch_tabulate_tensor(FormIntegrals::Type type, int i) const;
+
+  /// Set a batched 'tabulate_tensor' function for the integral with ID
+  /// id of given type. The (non-batched) integral must already have
+  /// been added with set_tabulate_tensor; the scalar kernel remains the
+  /// fallback for remainder cells and for callers that do not batch.
+  /// @param[in] type Integral type
+  /// @param[in] id Integral ID
+  /// @param[in] batch_size Number of cells evaluated per kernel call
+  /// @param[in] fn Batched tabulate function
+  void set_batch_tabulate_tensor(
+      FormIntegrals::Type type, int id, int batch_size,
+      std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const std::uint32_t*, int)>
+          fn);
+
+  /// Get the 'tabulate_tensor' function with precomputed geometry
+  /// factors for integral i of given type. The function may be empty if
+  /// no such kernel has been set. The kernel receives, in addition to
+  /// the standard arguments, the Jacobian J, inverse Jacobian K and
+  /// Jacobian determinant detJ of the coordinate map evaluated at its
+  /// quadrature points (see GeometryFactors), so it can skip the
+  /// geometry computation.
+  /// @param[in] type Integral type
+  /// @param[in] i Integral number
+  /// @return Function to call for tabulate_tensor with geometry
+  ///   factors, with arguments (A, w, c, coordinate_dofs, J, K, detJ,
+  ///   cell_permutation_info)
+  const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                           const double*, const double*, const double*,
+                           const double*, const std::uint32_t)>&
+  get_geometry_tabulate_tensor(FormIntegrals::Type type, int i) const;
+
+  /// Set a 'tabulate_tensor' function taking precomputed geometry
+  /// factors for the integral with ID id of given type. The
+  /// (standard) integral must already have been added with
+  /// set_tabulate_tensor; the standard kernel remains the fallback for
+  /// callers that do not precompute geometry. The kernel's quadrature
+  /// points must match the reference points the GeometryFactors buffer
+  /// was built with.
+  /// @param[in] type Integral type
+  /// @param[in] id Integral ID
+  /// @param[in] fn Tabulate function with arguments (A, w, c,
+  ///   coordinate_dofs, J, K, detJ, cell_permutation_info)
+  void set_geometry_tabulate_tensor(
+      FormIntegrals::Type type, int id,
+      std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const double*, const double*,
+                         const double*, const std::uint32_t)>
+          fn);
+
+  /// Get the 'tabulate_tensor' function taking precomputed coefficient
+  /// values at quadrature points for integral i of given type. The
+  /// function may be empty if no such kernel has been set. The kernel
+  /// receives the cached coefficient values (see CoefficientQPCache)
+  /// in place of the packed expansion coefficients, so it can skip the
+  /// per-cell coefficient interpolation.
+  /// @param[in] type Integral type
+  /// @param[in] i Integral number
+  /// @return Function to call for tabulate_tensor with quadrature-point
+  ///   coefficient values, with arguments (A, w_qp, c, coordinate_dofs,
+  ///   cell_permutation_info)
+  const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                           const double*, const std::uint32_t)>&
+  get_qp_tabulate_tensor(FormIntegrals::Type type, int i) const;
+
+  /// Set a 'tabulate_tensor' function taking precomputed coefficient
+  /// values at quadrature points for the integral with ID id of given
+  /// type. The (standard) integral must already have been added with
+  /// set_tabulate_tensor; the standard kernel remains the fallback for
+  /// callers that do not cache coefficient values. The kernel's
+  /// quadrature points must match the reference points the
+  /// CoefficientQPCache was built with.
+  /// @param[in] type Integral type
+  /// @param[in] id Integral ID
+  /// @param[in] fn Tabulate function with arguments (A, w_qp, c,
+  ///   coordinate_dofs, cell_permutation_info)
+  void set_qp_tabulate_tensor(
+      FormIntegrals::Type type, int id,
+      std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                         const double*, const std::uint32_t)>
+          fn);
+
+  /// Per-entity cost estimate for an integral kernel. Costs are
+  /// estimates (typically from the form compiler) and are used by the
+  /// threaded assembler to pick its scheduling granularity; they do not
+  /// have to be exact, only roughly proportional to the true cost.
+  struct CostEstimate
+  {
+    /// Estimated floating point operations per cell/facet
+    double flops_per_entity = 0.0;
+
+    /// Estimated bytes moved per cell/facet
+    double bytes_per_entity = 0.0;
+  };
+
+  /// Get the cost estimate for integral i of given type. Both fields
+  /// are zero if no estimate has been attached.
+  /// @param[in] type Integral type
+  /// @param[in] i Integral number
+  /// @return The per-entity cost estimate
+  const CostEstimate& cost_estimate(FormIntegrals::Type type, int i) const;
+
+  /// Attach a per-entity cost estimate to the integral with ID id of
+  /// given type. The integral must already have been added with
+  /// set_tabulate_tensor.
+  /// @param[in] type Integral type
+  /// @param[in] id Integral ID
+  /// @param[in] cost Per-entity cost estimate for the integral kernel
+  void set_cost_estimate(FormIntegrals::Type type, int id,
+                         const CostEstimate& cost);
+
   /// Number of integrals of given type
   /// @param[in] t Integral type
   /// @return Number of integrals
@@ -109,6 +274,45 @@ private:
                        const double*, const int*, const std::uint8_t*,
                        const std::uint32_t)>
         tabulate;
+
+    // Individual term kernels of an integral split by quadrature
+    // requirement (see add_tabulate_tensor). Empty unless the integral
+    // has been split; when non-empty, tabulate is the fused sum of
+    // these kernels.
+    std::vector<
+        std::function<void(PetscScalar*, const PetscScalar*,
+                           const PetscScalar*, const double*, const int*,
+                           const std::uint8_t*, const std::uint32_t)>>
+        term_tabulate;
+
+    // Optional batched kernel (structure-of-arrays data for batch_size
+    // cells per call) and its batch size. The function is empty if no
+    // batched kernel has been set.
+    std::pair<std::function<void(PetscScalar*, const PetscScalar*,
+                                 const PetscScalar*, const double*,
+                                 const std::uint32_t*, int)>,
+              int>
+        batch_tabulate;
+
+    // Optional kernel taking precomputed geometry factors (J, K, detJ
+    // at the quadrature points, see GeometryFactors). The function is
+    // empty if no such kernel has been set.
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const double*, const double*,
+                       const double*, const std::uint32_t)>
+        geometry_tabulate;
+
+    // Optional kernel taking precomputed coefficient values at the
+    // quadrature points (see CoefficientQPCache). The function is
+    // empty if no such kernel has been set.
+    std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                       const double*, const std::uint32_t)>
+        qp_tabulate;
+
+    // Per-entity cost estimate for the kernel; both fields are zero
+    // when no estimate has been attached
+    CostEstimate cost;
+
     int id;
     std::vector<std::int32_t> active_entities;
   };
@@ -0,0 +1,93 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "GeometryFactors.h"
+#include "CoordinateElement.h"
+#include <cassert>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+//-----------------------------------------------------------------------------
+GeometryFactors::GeometryFactors(
+    const mesh::Mesh& mesh,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& X)
+    : _num_points(X.rows()), _gdim(mesh.geometry().dim()),
+      _tdim(mesh.topology().dim())
+{
+  assert(X.cols() == _tdim);
+  const fem::CoordinateElement& cmap = mesh.geometry().cmap();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  auto map = mesh.topology().index_map(_tdim);
+  assert(map);
+  const std::int32_t num_cells = map->size_local() + map->num_ghosts();
+
+  _J.resize(std::size_t(num_cells) * _num_points * _gdim * _tdim);
+  _K.resize(std::size_t(num_cells) * _num_points * _tdim * _gdim);
+  _detJ.resize(std::size_t(num_cells) * _num_points);
+
+  // Per-cell work arrays for the coordinate map evaluation
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cell_geometry(num_dofs_g, _gdim);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x(
+      _num_points, _gdim);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Xc(
+      _num_points, _tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(_num_points, _gdim, _tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(_num_points, _tdim, _gdim);
+  Eigen::Array<double, Eigen::Dynamic, 1> detJ(_num_points);
+
+  const std::size_t J_stride = std::size_t(_num_points) * _gdim * _tdim;
+  const std::size_t K_stride = std::size_t(_num_points) * _tdim * _gdim;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    // Gather cell node coordinates
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < num_dofs_g; ++i)
+      cell_geometry.row(i) = x_g.row(x_dofs[i]).head(_gdim);
+
+    // Push the reference points forward and evaluate the geometry map
+    // factors at the resulting physical points
+    cmap.push_forward(x, X, cell_geometry);
+    cmap.compute_reference_geometry(Xc, J, detJ, K, x, cell_geometry);
+
+    std::copy(J.data(), J.data() + J_stride, _J.data() + c * J_stride);
+    std::copy(K.data(), K.data() + K_stride, _K.data() + c * K_stride);
+    std::copy(detJ.data(), detJ.data() + _num_points,
+              _detJ.data() + std::size_t(c) * _num_points);
+  }
+}
+//-----------------------------------------------------------------------------
+int GeometryFactors::num_points() const { return _num_points; }
+//-----------------------------------------------------------------------------
+const double* GeometryFactors::J(std::int32_t cell) const
+{
+  return _J.data() + std::size_t(cell) * _num_points * _gdim * _tdim;
+}
+//-----------------------------------------------------------------------------
+const double* GeometryFactors::K(std::int32_t cell) const
+{
+  return _K.data() + std::size_t(cell) * _num_points * _tdim * _gdim;
+}
+//-----------------------------------------------------------------------------
+const double* GeometryFactors::detJ(std::int32_t cell) const
+{
+  return _detJ.data() + std::size_t(cell) * _num_points;
+}
+//-----------------------------------------------------------------------------
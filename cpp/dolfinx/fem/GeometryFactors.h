@@ -0,0 +1,74 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx
+{
+
+namespace mesh
+{
+class Mesh;
+}
+
+namespace fem
+{
+
+/// Precomputed geometry factors of the coordinate map at a fixed set of
+/// reference (quadrature) points, for every cell of a mesh.
+///
+/// For each cell the Jacobian J, its (pseudo-)inverse K and determinant
+/// detJ of the coordinate map are evaluated at the given reference
+/// points and stored in a flat buffer. Kernels that opt into the
+/// extended signature (see FormIntegrals::set_geometry_tabulate_tensor)
+/// receive pointers into this buffer instead of recomputing the factors
+/// from the cell coordinates on every call. The buffer depends only on
+/// the mesh and the reference points, so one object can be shared
+/// between all forms integrating with the same quadrature rule, e.g.
+/// the Jacobian and residual forms of a Newton solve.
+
+class GeometryFactors
+{
+public:
+  /// Compute geometry factors for every cell (owned and ghost)
+  /// @param[in] mesh The mesh
+  /// @param[in] X Points on the reference cell (shape num_points x
+  ///              tdim) at which to evaluate the coordinate map,
+  ///              typically the quadrature points of the kernels that
+  ///              will consume the factors
+  GeometryFactors(const mesh::Mesh& mesh,
+                  const Eigen::Ref<const Eigen::Array<
+                      double, Eigen::Dynamic, Eigen::Dynamic,
+                      Eigen::RowMajor>>& X);
+
+  /// Number of reference points per cell
+  int num_points() const;
+
+  /// Jacobian of the coordinate map for a cell, shape (num_points x
+  /// gdim x tdim), row-major with the point index slowest
+  const double* J(std::int32_t cell) const;
+
+  /// Inverse (pseudo-inverse for gdim != tdim) Jacobian for a cell,
+  /// shape (num_points x tdim x gdim)
+  const double* K(std::int32_t cell) const;
+
+  /// Jacobian (pseudo-)determinant for a cell, one value per point
+  const double* detJ(std::int32_t cell) const;
+
+private:
+  int _num_points, _gdim, _tdim;
+
+  // Flat per-cell storage; cell c occupies the half-open range
+  // [c * stride, (c + 1) * stride) with stride num_points*gdim*tdim
+  // for _J, num_points*tdim*gdim for _K and num_points for _detJ
+  std::vector<double> _J, _K, _detJ;
+};
+} // namespace fem
+} // namespace dolfinx
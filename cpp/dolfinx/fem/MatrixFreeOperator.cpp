@@ -0,0 +1,189 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MatrixFreeOperator.h"
+#include "DofMap.h"
+#include "ElementDofLayout.h"
+#include "Form.h"
+#include "utils.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/VectorPool.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// PETSc shell matrix MATOP_MULT callback, forwarding to
+// MatrixFreeOperator::mult
+PetscErrorCode matshell_mult(Mat A, Vec x, Vec y)
+{
+  void* ctx = nullptr;
+  MatShellGetContext(A, &ctx);
+  assert(ctx);
+  static_cast<const MatrixFreeOperator*>(ctx)->mult(x, y);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+// Create the PETSc shell matrix with the size/layout of the form
+Mat create_shell_matrix(const Form& a)
+{
+  if (a.rank() != 2)
+    throw std::runtime_error("Form must be bilinear (rank 2)");
+  if (a.integrals().num_integrals(FormIntegrals::Type::exterior_facet) > 0
+      or a.integrals().num_integrals(FormIntegrals::Type::interior_facet) > 0)
+  {
+    throw std::runtime_error(
+        "Matrix-free operator supports cell integrals only");
+  }
+
+  auto map0 = a.function_space(0)->dofmap()->index_map;
+  auto map1 = a.function_space(1)->dofmap()->index_map;
+  assert(map0);
+  assert(map1);
+
+  const PetscInt m = map0->block_size() * map0->size_local();
+  const PetscInt n = map1->block_size() * map1->size_local();
+  const PetscInt M = map0->block_size() * map0->size_global();
+  const PetscInt N = map1->block_size() * map1->size_global();
+
+  Mat A = nullptr;
+  MatCreateShell(a.mesh()->mpi_comm(), m, n, M, N, nullptr, &A);
+  return A;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+MatrixFreeOperator::MatrixFreeOperator(std::shared_ptr<const Form> a)
+    : la::PETScOperator(create_shell_matrix(*a), false), _a(a)
+{
+  MatShellSetContext(_matA, static_cast<void*>(this));
+  MatShellSetOperation(_matA, MATOP_MULT,
+                       reinterpret_cast<void (*)(void)>(matshell_mult));
+}
+//-----------------------------------------------------------------------------
+MatrixFreeOperator::~MatrixFreeOperator()
+{
+  if (_x_work)
+    la::VectorPool::checkin(_x_work);
+  if (_y_work)
+    la::VectorPool::checkin(_y_work);
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::mult(Vec x, Vec y) const
+{
+  std::shared_ptr<const mesh::Mesh> mesh = _a->mesh();
+  assert(mesh);
+
+  std::shared_ptr<const fem::DofMap> dofmap0 = _a->function_space(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1 = _a->function_space(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  const int num_dofs_per_cell0 = dofmap0->element_dof_layout->num_dofs();
+  const int num_dofs_per_cell1 = dofmap1->element_dof_layout->num_dofs();
+
+  // Check out ghosted work vectors on first apply; recycled through
+  // the pool across operator instances
+  if (!_x_work)
+  {
+    _x_work = la::VectorPool::checkout(*dofmap1->index_map);
+    _y_work = la::VectorPool::checkout(*dofmap0->index_map);
+  }
+
+  // Copy x into the ghosted work vector and update ghost values
+  VecCopy(x, _x_work);
+  VecGhostUpdateBegin(_x_work, INSERT_VALUES, SCATTER_FORWARD);
+  VecGhostUpdateEnd(_x_work, INSERT_VALUES, SCATTER_FORWARD);
+
+  // Pack constants and coefficients (skipped if unchanged)
+  if (!_a->all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  pack_constants(*_a, _workspace.constants);
+  pack_coefficients(*_a, _workspace.coeffs, _workspace.coeff_versions);
+
+  // Prepare cell geometry
+  mesh->topology_mutable().create_entity_permutations();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const int gdim = mesh->geometry().dim();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh->geometry().x();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  // Zero y work vector, including the ghost portion
+  {
+    Vec y_local = nullptr;
+    VecGhostGetLocalForm(_y_work, &y_local);
+    VecSet(y_local, 0.0);
+    VecGhostRestoreLocalForm(_y_work, &y_local);
+  }
+
+  {
+    la::VecReadWrapper x_wrap(_x_work);
+    la::VecWrapper y_wrap(_y_work);
+
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinate_dofs(num_dofs_g, gdim);
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        Ae(num_dofs_per_cell0, num_dofs_per_cell1);
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> xe(num_dofs_per_cell1);
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> ye(num_dofs_per_cell0);
+    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> cell_dofs0(
+        num_dofs_per_cell0);
+    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> cell_dofs1(
+        num_dofs_per_cell1);
+
+    const FormIntegrals& integrals = _a->integrals();
+    using type = fem::FormIntegrals::Type;
+    for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
+    {
+      const auto& kernel = integrals.get_tabulate_tensor(type::cell, i);
+      const std::vector<std::int32_t>& active_cells
+          = integrals.integral_domains(type::cell, i);
+      for (std::int32_t c : active_cells)
+      {
+        // Get cell coordinates/geometry
+        auto x_dofs = x_dofmap.links(c);
+        for (int j = 0; j < x_dofs.rows(); ++j)
+          coordinate_dofs.row(j) = x_g.row(x_dofs[j]).head(gdim);
+
+        // Tabulate element tensor
+        auto coeff_cell = _workspace.coeffs.row(c);
+        Ae.setZero();
+        kernel(Ae.data(), coeff_cell.data(), _workspace.constants.data(),
+               coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+        // Gather local x, apply element tensor, scatter local y. The
+        // filling cell_dofs overload supports implicit dofmaps, where
+        // the dof indices are computed from the (smaller) node graph.
+        dofmap0->cell_dofs(c, cell_dofs0);
+        dofmap1->cell_dofs(c, cell_dofs1);
+        for (int j = 0; j < num_dofs_per_cell1; ++j)
+          xe[j] = x_wrap.x[cell_dofs1[j]];
+        ye.noalias() = Ae * xe;
+        for (int j = 0; j < num_dofs_per_cell0; ++j)
+          y_wrap.x[cell_dofs0[j]] += ye[j];
+      }
+    }
+  }
+
+  // Accumulate ghost contributions into owning processes and copy the
+  // owned part into y
+  VecGhostUpdateBegin(_y_work, ADD_VALUES, SCATTER_REVERSE);
+  VecGhostUpdateEnd(_y_work, ADD_VALUES, SCATTER_REVERSE);
+  VecCopy(_y_work, y);
+}
+//-----------------------------------------------------------------------------
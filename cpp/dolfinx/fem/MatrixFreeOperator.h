@@ -0,0 +1,69 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "AssemblyWorkspace.h"
+#include <dolfinx/la/PETScOperator.h>
+#include <memory>
+#include <petscmat.h>
+#include <petscvec.h>
+
+namespace dolfinx
+{
+namespace fem
+{
+class Form;
+
+/// Matrix-free operator for a bilinear form. The action y = A x is
+/// computed by looping over cells, gathering the local part of x via
+/// the dofmap, applying the element tensor, and scattering the result
+/// back with ghost accumulation -- the global matrix is never
+/// assembled, so memory is O(ndofs) rather than O(nnz). The operator is
+/// exposed as a PETSc shell matrix (la::PETScOperator), so it can be
+/// used directly with la::PETScKrylovSolver.
+///
+/// Only forms with cell integrals are supported. Coefficients are
+/// re-packed automatically when they change (tracked via the PETSc
+/// vector state counters).
+
+class MatrixFreeOperator : public la::PETScOperator
+{
+public:
+  /// Create a matrix-free operator for a bilinear form
+  /// @param[in] a The bilinear form defining the operator
+  explicit MatrixFreeOperator(std::shared_ptr<const Form> a);
+
+  // Copy constructor (deleted)
+  MatrixFreeOperator(const MatrixFreeOperator&) = delete;
+
+  /// Destructor
+  ~MatrixFreeOperator();
+
+  // Assignment operator (deleted)
+  MatrixFreeOperator& operator=(const MatrixFreeOperator&) = delete;
+
+  /// Compute y = A x. Called by the PETSc shell matrix; may also be
+  /// called directly. The vectors must be compatible with the layout
+  /// returned by create_vector().
+  /// @param[in] x The vector to apply the operator to
+  /// @param[in,out] y The result vector. Overwritten.
+  void mult(Vec x, Vec y) const;
+
+private:
+  // The bilinear form
+  std::shared_ptr<const Form> _a;
+
+  // Scratch for coefficient/constant packing, reused across applies
+  mutable AssemblyWorkspace _workspace;
+
+  // Ghosted work vectors for x (after forward scatter) and y (before
+  // reverse accumulation), created lazily on first apply
+  mutable Vec _x_work = nullptr;
+  mutable Vec _y_work = nullptr;
+};
+} // namespace fem
+} // namespace dolfinx
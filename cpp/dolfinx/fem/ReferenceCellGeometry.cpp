@@ -12,25 +12,35 @@ using namespace dolfinx;
 using namespace dolfinx::fem;
 
 //-----------------------------------------------------------------------------
-Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 ReferenceCellGeometry::get_vertices(mesh::CellType cell_type)
 {
-  const static Eigen::Array<double, 1, 1> point
-      = (Eigen::Array<double, 1, 1>() << 0.0).finished();
-  const static Eigen::Array<double, 2, 1> interval
-      = (Eigen::Array<double, 2, 1>() << 0.0, 1.0).finished();
-  const static Eigen::Array<double, 3, 2, Eigen::RowMajor> triangle
+  // The vertex tables are built once on first use and returned by
+  // reference, so repeated queries have no construction cost
+  const static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      point = (Eigen::Array<double, 1, 1>() << 0.0).finished();
+  const static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      interval = (Eigen::Array<double, 2, 1>() << 0.0, 1.0).finished();
+  const static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      triangle
       = (Eigen::Array<double, 3, 2, Eigen::RowMajor>() << 0, 0, 1, 0, 0, 1)
             .finished();
-  const static Eigen::Array<double, 4, 2, Eigen::RowMajor> quadrilateral
-      = (Eigen::Array<double, 4, 2, Eigen::RowMajor>() << 0, 0, 0, 1, 1, 0, 1,
-         1)
-            .finished();
-  const static Eigen::Array<double, 4, 3, Eigen::RowMajor> tetrahedron
-      = (Eigen::Array<double, 4, 3, Eigen::RowMajor>() << 0, 0, 0, 1, 0, 0, 0,
-         1, 0, 0, 0, 1)
-            .finished();
-  const static Eigen::Array<double, 6, 4, Eigen::RowMajor> hexahedron
+  const static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      quadrilateral = (Eigen::Array<double, 4, 2, Eigen::RowMajor>() << 0, 0,
+                       0, 1, 1, 0, 1, 1)
+                          .finished();
+  const static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      tetrahedron = (Eigen::Array<double, 4, 3, Eigen::RowMajor>() << 0, 0, 0,
+                     1, 0, 0, 0, 1, 0, 0, 0, 1)
+                        .finished();
+  const static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      hexahedron
       = (Eigen::Array<double, 6, 4, Eigen::RowMajor>() << 0, 0, 0, 0, 0, 1, 0,
          1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1)
             .finished();
@@ -52,8 +62,5 @@ ReferenceCellGeometry::get_vertices(mesh::CellType cell_type)
   default:
     throw std::runtime_error("Unknown cell type.");
   }
-
-  return Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
-                      Eigen::RowMajor>();
 }
 //-----------------------------------------------------------------------------
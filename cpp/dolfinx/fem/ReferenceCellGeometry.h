@@ -16,8 +16,10 @@ namespace dolfinx::fem
 class ReferenceCellGeometry
 {
 public:
-  /// Get geometric points for all vertices
-  static Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  /// Get geometric points for all vertices. The returned reference is
+  /// to a static table, so repeated queries have no construction cost.
+  static const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>&
   get_vertices(mesh::CellType cell_type);
 };
 } // namespace dolfinx::fem
@@ -24,8 +24,11 @@ void SparsityPatternBuilder::cells(
   const int D = topology.dim();
   auto cells = topology.connectivity(D, 0);
   assert(cells);
-  for (int c = 0; c < cells->num_nodes(); ++c)
-    pattern.insert(dofmaps[0]->cell_dofs(c), dofmaps[1]->cell_dofs(c));
+
+  // Bulk insertion of the full cell dofmaps; the pattern distributes
+  // the row insertion over the worker threads
+  assert(dofmaps[0]->list().num_nodes() >= cells->num_nodes());
+  pattern.insert_cells(dofmaps[0]->list(), dofmaps[1]->list());
 }
 //-----------------------------------------------------------------------------
 void SparsityPatternBuilder::interior_facets(
@@ -5,28 +5,496 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "assemble_matrix_impl.h"
+#include "AssemblyTrace.h"
+#include "AssemblyWorkspace.h"
 #include "DofMap.h"
 #include "Form.h"
+#include "CoefficientQPCache.h"
+#include "GeometryFactors.h"
 #include "utils.h"
+#include <dolfinx/common/Counters.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/BoostGraphColoring.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
+#include <algorithm>
+#include <atomic>
 #include <petscsys.h>
+#include <thread>
+#include <type_traits>
 
 using namespace dolfinx;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Group active cells into 'colors' such that no two cells in a group
+// share a degree-of-freedom in the test or trial space. Cells in the
+// same group touch disjoint rows and columns of the matrix, so their
+// kernels and insertions can execute concurrently without races.
+std::vector<std::vector<std::int32_t>>
+color_active_cells(const std::vector<std::int32_t>& active_cells,
+                   const graph::AdjacencyList<std::int32_t>& dofmap0,
+                   const graph::AdjacencyList<std::int32_t>& dofmap1)
+{
+  // Build dof -> active cell lists, with trial space dofs offset past
+  // the test space dofs
+  const std::int32_t num_dofs0
+      = dofmap0.num_nodes() > 0 ? dofmap0.array().maxCoeff() + 1 : 0;
+  const std::int32_t num_dofs1
+      = dofmap1.num_nodes() > 0 ? dofmap1.array().maxCoeff() + 1 : 0;
+  std::vector<std::vector<std::int32_t>> dof_to_cell(num_dofs0 + num_dofs1);
+  for (std::size_t i = 0; i < active_cells.size(); ++i)
+  {
+    auto dofs0 = dofmap0.links(active_cells[i]);
+    for (Eigen::Index j = 0; j < dofs0.rows(); ++j)
+      dof_to_cell[dofs0[j]].push_back(i);
+    auto dofs1 = dofmap1.links(active_cells[i]);
+    for (Eigen::Index j = 0; j < dofs1.rows(); ++j)
+      dof_to_cell[num_dofs0 + dofs1[j]].push_back(i);
+  }
+
+  // Build cell-cell conflict graph (cells sharing a dof)
+  std::vector<std::vector<std::int32_t>> conflicts(active_cells.size());
+  for (const std::vector<std::int32_t>& cells : dof_to_cell)
+  {
+    for (std::int32_t c0 : cells)
+      for (std::int32_t c1 : cells)
+        if (c0 != c1)
+          conflicts[c0].push_back(c1);
+  }
+  for (std::vector<std::int32_t>& c : conflicts)
+  {
+    std::sort(c.begin(), c.end());
+    c.erase(std::unique(c.begin(), c.end()), c.end());
+  }
+
+  // Color the conflict graph and group cells by color
+  std::vector<int> colors;
+  const std::size_t num_colors
+      = graph::BoostGraphColoring::compute_local_vertex_coloring(
+          graph::AdjacencyList<std::int32_t>(conflicts), colors);
+  std::vector<std::vector<std::int32_t>> cells_by_color(num_colors);
+  for (std::size_t i = 0; i < active_cells.size(); ++i)
+    cells_by_color[colors[i]].push_back(active_cells[i]);
+
+  return cells_by_color;
+}
+//-----------------------------------------------------------------------------
+// Cell assembly driver specialised for fixed element dimensions (N0 x
+// N1 element tensor). The fixed sizes let the compiler fully unroll the
+// dof gather and bc/insertion loops. Behaviour matches the dynamic
+// driver in fem::impl::assemble_cells.
+template <typename ScalarType, int N0, int N1>
+void assemble_cells_fixed(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const int*, const std::uint8_t*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values)
+{
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<ScalarType, N0, N1, Eigen::RowMajor> Ae;
+
+  for (std::int32_t c : active_cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < x_dofs.rows(); ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate tensor
+    auto coeff_cell = coeffs.row(c);
+    Ae.setZero();
+    kernel(Ae.data(), coeff_cell.data(), constant_values.data(),
+           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+    const std::int32_t* dofs0 = dofmap0.links_ptr(c);
+    const std::int32_t* dofs1 = dofmap1.links_ptr(c);
+
+    // Zero rows/columns for essential bcs
+    if (!bc0.empty())
+    {
+      for (int i = 0; i < N0; ++i)
+      {
+        if (bc0[dofs0[i]])
+          Ae.row(i).setZero();
+      }
+    }
+    if (!bc1.empty())
+    {
+      for (int j = 0; j < N1; ++j)
+      {
+        if (bc1[dofs1[j]])
+          Ae.col(j).setZero();
+      }
+    }
+
+    mat_set_values_local(N0, dofs0, N1, dofs1, Ae.data());
+  }
+}
+//-----------------------------------------------------------------------------
+// Dispatch to a fixed-size assembly driver for the dominant square
+// element sizes: 3/4/6/10 dofs per cell (P1/P2 simplices) and their
+// 3-vector block counterparts. Returns false if no specialisation
+// matches, in which case the caller falls back to the dynamic driver.
+template <typename ScalarType>
+bool assemble_cells_fixed_dispatch(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0, int num_dofs_per_cell0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1, int num_dofs_per_cell1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const int*, const std::uint8_t*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values)
+{
+  if (num_dofs_per_cell0 != num_dofs_per_cell1)
+    return false;
+
+  auto call = [&](auto n) {
+    constexpr int N = decltype(n)::value;
+    assemble_cells_fixed<ScalarType, N, N>(mat_set_values_local, mesh,
+                                           active_cells, dofmap0, dofmap1, bc0,
+                                           bc1, kernel, coeffs,
+                                           constant_values);
+  };
+
+  switch (num_dofs_per_cell0)
+  {
+  case 3:
+    call(std::integral_constant<int, 3>{});
+    return true;
+  case 4:
+    call(std::integral_constant<int, 4>{});
+    return true;
+  case 6:
+    call(std::integral_constant<int, 6>{});
+    return true;
+  case 10:
+    call(std::integral_constant<int, 10>{});
+    return true;
+  case 9:
+    call(std::integral_constant<int, 9>{});
+    return true;
+  case 12:
+    call(std::integral_constant<int, 12>{});
+    return true;
+  case 18:
+    call(std::integral_constant<int, 18>{});
+    return true;
+  case 30:
+    call(std::integral_constant<int, 30>{});
+    return true;
+  default:
+    return false;
+  }
+}
+//-----------------------------------------------------------------------------
+// Execute a batched kernel over cells, packing geometry and coefficient
+// data for batch_size cells into structure-of-arrays buffers (batch
+// index fastest) so cross-cell vectorized kernels can be used. The tail
+// of the cell list is padded by replicating the last cell; padded lanes
+// are computed but not inserted.
+template <typename ScalarType>
+void assemble_cells_batched(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0, int num_dofs_per_cell0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1, int num_dofs_per_cell1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const std::uint32_t*, int)>& kernel,
+    int batch_size,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values)
+{
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Structure-of-arrays batch buffers, batch index fastest
+  std::vector<double> coords_soa(num_dofs_g * gdim * batch_size);
+  std::vector<ScalarType> coeffs_soa(coeffs.cols() * batch_size);
+  std::vector<std::uint32_t> info_batch(batch_size);
+  std::vector<ScalarType> Ab(num_dofs_per_cell0 * num_dofs_per_cell1
+                             * batch_size);
+  Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae(num_dofs_per_cell0, num_dofs_per_cell1);
+
+  for (std::size_t offset = 0; offset < active_cells.size();
+       offset += batch_size)
+  {
+    const int nb
+        = std::min<std::size_t>(batch_size, active_cells.size() - offset);
+
+    // Pack geometry, coefficients and permutation data (padding lanes
+    // replicate the last cell of the batch)
+    for (int b = 0; b < batch_size; ++b)
+    {
+      const std::int32_t c = active_cells[offset + std::min(b, nb - 1)];
+      auto x_dofs = x_dofmap.links(c);
+      for (int i = 0; i < num_dofs_g; ++i)
+        for (int d = 0; d < gdim; ++d)
+          coords_soa[(i * gdim + d) * batch_size + b] = x_g(x_dofs[i], d);
+      for (Eigen::Index k = 0; k < coeffs.cols(); ++k)
+        coeffs_soa[k * batch_size + b] = coeffs(c, k);
+      info_batch[b] = cell_info[c];
+    }
+
+    // Tabulate batch of element tensors in one kernel call
+    std::fill(Ab.begin(), Ab.end(), 0);
+    kernel(Ab.data(), coeffs_soa.data(), constant_values.data(),
+           coords_soa.data(), info_batch.data(), nb);
+
+    // Unpack each cell tensor and insert
+    for (int b = 0; b < nb; ++b)
+    {
+      const std::int32_t c = active_cells[offset + b];
+      for (int i = 0; i < num_dofs_per_cell0; ++i)
+        for (int j = 0; j < num_dofs_per_cell1; ++j)
+          Ae(i, j) = Ab[(i * num_dofs_per_cell1 + j) * batch_size + b];
+
+      auto dofs0 = dofmap0.links(c);
+      auto dofs1 = dofmap1.links(c);
+      if (!bc0.empty())
+      {
+        for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+        {
+          if (bc0[dofs0[i]])
+            Ae.row(i).setZero();
+        }
+      }
+      if (!bc1.empty())
+      {
+        for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+        {
+          if (bc1[dofs1[j]])
+            Ae.col(j).setZero();
+        }
+      }
+
+      mat_set_values_local(num_dofs_per_cell0, dofs0.data(),
+                           num_dofs_per_cell1, dofs1.data(), Ae.data());
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+// Cell assembly with a kernel that takes precomputed geometry factors
+// (J, K, detJ at its quadrature points) from a GeometryFactors buffer
+// instead of recomputing them from the cell coordinates. Behaviour
+// otherwise matches the serial path of fem::impl::assemble_cells.
+void assemble_cells_geometry(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0, int num_dofs_per_cell0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1, int num_dofs_per_cell1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const double*,
+                             const double*, const double*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values,
+    const fem::GeometryFactors& geometry)
+{
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae;
+
+  for (std::int32_t c : active_cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate tensor with precomputed geometry factors
+    auto coeff_cell = coeffs.row(c);
+    Ae.setZero(num_dofs_per_cell0, num_dofs_per_cell1);
+    kernel(Ae.data(), coeff_cell.data(), constant_values.data(),
+           coordinate_dofs.data(), geometry.J(c), geometry.K(c),
+           geometry.detJ(c), cell_info[c]);
+
+    auto dofs0 = dofmap0.links(c);
+    auto dofs1 = dofmap1.links(c);
+
+    // Zero rows/columns for essential bcs
+    if (!bc0.empty())
+    {
+      for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+      {
+        if (bc0[dofs0[i]])
+          Ae.row(i).setZero();
+      }
+    }
+    if (!bc1.empty())
+    {
+      for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+      {
+        if (bc1[dofs1[j]])
+          Ae.col(j).setZero();
+      }
+    }
+
+    mat_set_values_local(num_dofs_per_cell0, dofs0.data(), num_dofs_per_cell1,
+                         dofs1.data(), Ae.data());
+  }
+}
+//-----------------------------------------------------------------------------
+// Cell assembly with a kernel that reads cached coefficient values at
+// its quadrature points from a CoefficientQPCache instead of
+// interpolating the coefficients from their expansion coefficients on
+// every cell. Behaviour otherwise matches the serial path of
+// fem::impl::assemble_cells.
+void assemble_cells_qp(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0, int num_dofs_per_cell0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1, int num_dofs_per_cell1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values,
+    const fem::CoefficientQPCache& coeff_qp)
+{
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae;
+
+  for (std::int32_t c : active_cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate tensor with cached quadrature-point coefficient values
+    Ae.setZero(num_dofs_per_cell0, num_dofs_per_cell1);
+    kernel(Ae.data(), coeff_qp.w(c), constant_values.data(),
+           coordinate_dofs.data(), cell_info[c]);
+
+    auto dofs0 = dofmap0.links(c);
+    auto dofs1 = dofmap1.links(c);
+
+    // Zero rows/columns for essential bcs
+    if (!bc0.empty())
+    {
+      for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+      {
+        if (bc0[dofs0[i]])
+          Ae.row(i).setZero();
+      }
+    }
+    if (!bc1.empty())
+    {
+      for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+      {
+        if (bc1[dofs1[j]])
+          Ae.col(j).setZero();
+      }
+    }
+
+    mat_set_values_local(num_dofs_per_cell0, dofs0.data(), num_dofs_per_cell1,
+                         dofs1.data(), Ae.data());
+  }
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 template <typename ScalarType>
 void fem::impl::assemble_matrix(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                             const std::int32_t*, const ScalarType*)>&
         mat_set_values_local,
-    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1)
+    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    AssemblyWorkspace* workspace, const FacetAssemblyPlan* plan,
+    const GeometryFactors* geometry, const CoefficientQPCache* coeff_qp)
 {
+  if (a.scalar_type != Form::petsc_scalar_type())
+  {
+    throw std::runtime_error(
+        "Form scalar type does not match the PETSc scalar. Assemble forms "
+        "with other scalar types through the scalar-templated drivers.");
+  }
+
   std::shared_ptr<const mesh::Mesh> mesh = a.mesh();
   assert(mesh);
 
@@ -43,16 +511,19 @@ void fem::impl::assemble_matrix(
   const int num_dofs_per_cell0 = dofmap0->element_dof_layout->num_dofs();
   const int num_dofs_per_cell1 = dofmap1->element_dof_layout->num_dofs();
 
-  // Prepare constants
+  // Prepare constants and coefficients, packing into the workspace (if
+  // provided) so the arrays are reused across repeated assembly calls
   if (!a.all_constants_set())
     throw std::runtime_error("Unset constant in Form");
-  const Eigen::Array<ScalarType, Eigen::Dynamic, 1> constant_values
-      = pack_constants(a);
-
-  // Prepare coefficients
+  AssemblyWorkspace local_workspace;
+  AssemblyWorkspace& w = workspace ? *workspace : local_workspace;
+  pack_constants(a, w.constants);
+  pack_coefficients(a, w.coeffs, w.coeff_versions);
+  const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values
+      = w.constants;
   const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
-                     Eigen::RowMajor>
-      coeffs = pack_coefficients(a);
+                     Eigen::RowMajor>& coeffs
+      = w.coeffs;
 
   const FormIntegrals& integrals = a.integrals();
   using type = fem::FormIntegrals::Type;
@@ -61,10 +532,77 @@ void fem::impl::assemble_matrix(
     const auto& fn = integrals.get_tabulate_tensor(type::cell, i);
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
+    AssemblyTrace::record(active_cells);
 
-    fem::impl::assemble_cells<ScalarType>(
-        mat_set_values_local, *mesh, active_cells, dofs0, num_dofs_per_cell0,
-        dofs1, num_dofs_per_cell1, bc0, bc1, fn, coeffs, constant_values);
+    // Use the kernel reading cached quadrature-point coefficient
+    // values when a cache is supplied and such a kernel has been
+    // attached
+    const auto& qp_fn = integrals.get_qp_tabulate_tensor(type::cell, i);
+    if constexpr (std::is_same<ScalarType, PetscScalar>::value)
+    {
+      if (coeff_qp and qp_fn)
+      {
+        assemble_cells_qp(mat_set_values_local, *mesh, active_cells, dofs0,
+                          num_dofs_per_cell0, dofs1, num_dofs_per_cell1, bc0,
+                          bc1, qp_fn, constant_values, *coeff_qp);
+        continue;
+      }
+    }
+
+    // Use the kernel taking precomputed geometry factors when a
+    // factors buffer is supplied and such a kernel has been attached
+    const auto& geometry_fn
+        = integrals.get_geometry_tabulate_tensor(type::cell, i);
+    if constexpr (std::is_same<ScalarType, PetscScalar>::value)
+    {
+      if (geometry and geometry_fn)
+      {
+        assemble_cells_geometry(mat_set_values_local, *mesh, active_cells,
+                                dofs0, num_dofs_per_cell0, dofs1,
+                                num_dofs_per_cell1, bc0, bc1, geometry_fn,
+                                coeffs, constant_values, *geometry);
+        continue;
+      }
+    }
+
+    // Use the batched (SIMD) kernel when one has been attached to the
+    // integral, otherwise fall back to the cell-at-a-time loop
+    const auto& batch_fn = integrals.get_batch_tabulate_tensor(type::cell, i);
+    if (batch_fn.first)
+    {
+      assemble_cells_batched<ScalarType>(
+          mat_set_values_local, *mesh, active_cells, dofs0, num_dofs_per_cell0,
+          dofs1, num_dofs_per_cell1, bc0, bc1, batch_fn.first, batch_fn.second,
+          coeffs, constant_values);
+    }
+    else
+    {
+      // Prefer a fixed-size driver when one is instantiated for this
+      // element size (serial path only; the threaded path handles its
+      // own partitioning). Without a thread-safe PETSc build insertion
+      // is always serial, so the fixed drivers stay usable.
+#ifdef PETSC_HAVE_THREADSAFETY
+      const bool serial_insertion = common::num_worker_threads() == 1;
+#else
+      const bool serial_insertion = true;
+#endif
+      const bool used_fixed
+          = serial_insertion
+            and assemble_cells_fixed_dispatch<ScalarType>(
+                mat_set_values_local, *mesh, active_cells, dofs0,
+                num_dofs_per_cell0, dofs1, num_dofs_per_cell1, bc0, bc1, fn,
+                coeffs, constant_values);
+      if (!used_fixed)
+      {
+        const FormIntegrals::CostEstimate& cost
+            = integrals.cost_estimate(type::cell, i);
+        fem::impl::assemble_cells<ScalarType>(
+            mat_set_values_local, *mesh, active_cells, dofs0,
+            num_dofs_per_cell0, dofs1, num_dofs_per_cell1, bc0, bc1, fn,
+            coeffs, constant_values, &w,
+            cost.flops_per_entity + cost.bytes_per_entity);
+      }
+    }
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
@@ -79,13 +617,29 @@ void fem::impl::assemble_matrix(
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
   {
-    const std::vector<int> c_offsets = a.coefficients().offsets();
     const auto& fn = integrals.get_tabulate_tensor(type::interior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::interior_facet, i);
-    fem::impl::assemble_interior_facets<ScalarType>(
-        mat_set_values_local, *mesh, active_facets, *dofmap0, *dofmap1, bc0,
-        bc1, fn, coeffs, c_offsets, constant_values);
+
+    // Re-pack the coefficients facet-pair-major so the facet loop reads
+    // one contiguous row per facet
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>
+        facet_coeffs
+        = pack_coefficients_interior_facets(a, coeffs, active_facets);
+    if (plan)
+    {
+      // Use the precomputed cell pairs and gather indices
+      fem::impl::assemble_interior_facets<ScalarType>(
+          mat_set_values_local, *mesh, plan->interior_data(i), *dofmap0,
+          *dofmap1, bc0, bc1, fn, facet_coeffs, constant_values);
+    }
+    else
+    {
+      fem::impl::assemble_interior_facets<ScalarType>(
+          mat_set_values_local, *mesh, active_facets, *dofmap0, *dofmap1, bc0,
+          bc1, fn, facet_coeffs, constant_values);
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -96,7 +650,9 @@ template void fem::impl::assemble_matrix<PetscScalar>(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                             const std::int32_t*, const PetscScalar*)>&
         mat_set_values_local,
-    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1);
+    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    AssemblyWorkspace* workspace, const FacetAssemblyPlan* plan,
+    const GeometryFactors* geometry, const CoefficientQPCache* coeff_qp);
 // @endcond
 //-----------------------------------------------------------------------------
 template <typename ScalarType>
@@ -113,8 +669,13 @@ void fem::impl::assemble_cells(
                              const std::uint32_t)>& kernel,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values)
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values,
+    AssemblyWorkspace* workspace, double cost_per_cell)
 {
+  static const int counter
+      = common::Counters::register_counter("cells assembled");
+  common::Counters::add(counter, active_cells.size());
+
   const int gdim = mesh.geometry().dim();
   mesh.topology_mutable().create_entity_permutations();
 
@@ -126,53 +687,138 @@ void fem::impl::assemble_cells(
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
       = mesh.geometry().x();
 
-  // Data structures used in assembly
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coordinate_dofs(num_dofs_g, gdim);
-  Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Ae;
-
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
       = mesh.topology().get_cell_permutation_info();
 
-  // Iterate over active cells
-  for (std::int32_t c : active_cells)
-  {
-    // Get cell coordinates/geometry
-    auto x_dofs = x_dofmap.links(c);
-    for (int i = 0; i < x_dofs.rows(); ++i)
-      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+  // Assemble and insert the element tensor for one cell. Scratch arrays
+  // are passed in so each thread can use its own.
+  auto assemble_cell
+      = [&](std::int32_t c,
+            Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                         Eigen::RowMajor>& coordinate_dofs,
+            Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                          Eigen::RowMajor>& Ae) {
+          // Get cell coordinates/geometry
+          auto x_dofs = x_dofmap.links(c);
+          for (int i = 0; i < x_dofs.rows(); ++i)
+            coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
 
-    // Tabulate tensor
-    auto coeff_cell = coeffs.row(c);
-    Ae.setZero(num_dofs_per_cell0, num_dofs_per_cell1);
-    kernel(Ae.data(), coeff_cell.data(), constant_values.data(),
-           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+          // Tabulate tensor
+          auto coeff_cell = coeffs.row(c);
+          Ae.setZero(num_dofs_per_cell0, num_dofs_per_cell1);
+          kernel(Ae.data(), coeff_cell.data(), constant_values.data(),
+                 coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
 
-    auto dofs0 = dofmap0.links(c);
-    auto dofs1 = dofmap1.links(c);
+          auto dofs0 = dofmap0.links(c);
+          auto dofs1 = dofmap1.links(c);
 
-    // Zero rows/columns for essential bcs
-    if (!bc0.empty())
+          // Zero rows/columns for essential bcs
+          if (!bc0.empty())
+          {
+            for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+            {
+              const std::int32_t dof = dofs0[i];
+              if (bc0[dof])
+                Ae.row(i).setZero();
+            }
+          }
+          if (!bc1.empty())
+          {
+            for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+            {
+              const std::int32_t dof = dofs1[j];
+              if (bc1[dof])
+                Ae.col(j).setZero();
+            }
+          }
+
+          mat_set_values_local(num_dofs_per_cell0, dofs0.data(),
+                               num_dofs_per_cell1, dofs1.data(), Ae.data());
+        };
+
+  // Coloring only keeps local rows conflict-free; concurrent
+  // MatSetValuesLocal calls still race on PETSc's shared MatStash for
+  // off-process rows, so concurrent insertion needs a thread-safe
+  // PETSc build (as in assemble_matrix_nest) and plain builds stay
+  // serial
+#ifdef PETSC_HAVE_THREADSAFETY
+  const int num_threads = common::num_worker_threads();
+#else
+  const int num_threads = 1;
+#endif
+  if (num_threads == 1 or (int)active_cells.size() < 2 * num_threads)
+  {
+    // Serial assembly over active cells. Scratch arrays come from the
+    // workspace when one is provided so repeated assembly calls reuse
+    // their allocations.
+    AssemblyWorkspace local_workspace;
+    AssemblyWorkspace& w = workspace ? *workspace : local_workspace;
+    w.coordinate_dofs.resize(num_dofs_g, gdim);
+    if constexpr (std::is_same<ScalarType, PetscScalar>::value)
     {
-      for (Eigen::Index i = 0; i < Ae.rows(); ++i)
-      {
-        const std::int32_t dof = dofs0[i];
-        if (bc0[dof])
-          Ae.row(i).setZero();
-      }
+      for (std::int32_t c : active_cells)
+        assemble_cell(c, w.coordinate_dofs, w.Ae);
     }
-    if (!bc1.empty())
+    else
     {
-      for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+      // The workspace element scratch is PetscScalar-typed; other
+      // scalars use a local element matrix
+      Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                    Eigen::RowMajor>
+          Ae;
+      for (std::int32_t c : active_cells)
+        assemble_cell(c, w.coordinate_dofs, Ae);
+    }
+  }
+  else
+  {
+    // Threaded assembly. Cells are grouped by color such that cells in
+    // a group share no dofs, so kernel evaluation and matrix insertion
+    // for cells of the same color are free of write conflicts.
+    const std::vector<std::vector<std::int32_t>> cells_by_color
+        = color_active_cells(active_cells, dofmap0, dofmap1);
+    for (const std::vector<std::int32_t>& cells : cells_by_color)
+    {
+      // Chunk size for the dynamic scheduler below. With a cost
+      // estimate, size chunks so one grab is ~1M cost units (flops +
+      // bytes), keeping expensive kernels on small chunks for balance
+      // and cheap kernels on large chunks to limit counter contention.
+      // Without an estimate, aim for ~8 grabs per thread.
+      std::int32_t chunk;
+      if (cost_per_cell > 0.0)
+        chunk = std::int32_t(std::max(1.0, 1e6 / cost_per_cell));
+      else
+        chunk = std::max<std::int32_t>(1, cells.size() / (8 * num_threads));
+
+      // Threads grab chunks of cells from a shared counter
+      // (self-scheduling), so a thread that hits expensive cells
+      // naturally takes fewer of them and no static partition
+      // serializes the tail
+      std::atomic<std::int32_t> next(0);
+      std::vector<std::thread> threads;
+      threads.reserve(num_threads);
+      for (int t = 0; t < num_threads; ++t)
       {
-        const std::int32_t dof = dofs1[j];
-        if (bc1[dof])
-          Ae.col(j).setZero();
+        threads.emplace_back([&]() {
+          Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+              coordinate_dofs(num_dofs_g, gdim);
+          Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>
+              Ae;
+          std::int32_t begin;
+          while ((begin = next.fetch_add(chunk, std::memory_order_relaxed))
+                 < (std::int32_t)cells.size())
+          {
+            const std::int32_t end
+                = std::min<std::int32_t>(begin + chunk, cells.size());
+            for (std::int32_t i = begin; i < end; ++i)
+              assemble_cell(cells[i], coordinate_dofs, Ae);
+          }
+        });
       }
+      for (std::thread& thread : threads)
+        thread.join();
     }
-
-    mat_set_values_local(num_dofs_per_cell0, dofs0.data(), num_dofs_per_cell1,
-                         dofs1.data(), Ae.data());
   }
 }
 //-----------------------------------------------------------------------------
@@ -196,7 +842,7 @@ void fem::impl::assemble_exterior_facets(
 
   // FIXME: cleanup these calls? Some of the happen internally again.
   mesh.topology_mutable().create_entities(tdim - 1);
-  mesh.topology_mutable().create_connectivity(tdim - 1, tdim);
+  mesh.topology_mutable().create_facet_cell_connectivity();
   mesh.topology_mutable().create_entity_permutations();
 
   // Prepare cell geometry
@@ -217,37 +863,38 @@ void fem::impl::assemble_exterior_facets(
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
       = mesh.topology().get_cell_permutation_info();
 
-  // Iterate over all facets
-  auto f_to_c = mesh.topology().connectivity(tdim - 1, tdim);
-  assert(f_to_c);
+  // Iterate over all facets, using the fixed-width facet -> cell
+  // lookup (no offsets array to read)
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 2, Eigen::RowMajor>&
+      f_cells = mesh.topology().facet_cells();
   auto c_to_f = mesh.topology().connectivity(tdim, tdim - 1);
   assert(c_to_f);
   for (std::int32_t f : active_facets)
   {
-    auto cells = f_to_c->links(f);
-    assert(cells.rows() == 1);
+    const std::int32_t cell = f_cells(f, 0);
+    assert(f_cells(f, 1) == -1);
 
     // Get local index of facet with respect to the cell
-    auto facets = c_to_f->links(cells[0]);
+    auto facets = c_to_f->links(cell);
     const auto* it = std::find(facets.data(), facets.data() + facets.rows(), f);
     assert(it != (facets.data() + facets.rows()));
     const int local_facet = std::distance(facets.data(), it);
 
     // Get cell vertex coordinates
-    auto x_dofs = x_dofmap.links(cells[0]);
+    auto x_dofs = x_dofmap.links(cell);
     for (int i = 0; i < num_dofs_g; ++i)
       coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
 
     // Get dof maps for cell
-    auto dmap0 = dofmap0.cell_dofs(cells[0]);
-    auto dmap1 = dofmap1.cell_dofs(cells[0]);
+    auto dmap0 = dofmap0.cell_dofs(cell);
+    auto dmap1 = dofmap1.cell_dofs(cell);
 
     // Tabulate tensor
-    auto coeff_cell = coeffs.row(cells[0]);
-    const std::uint8_t perm = perms(local_facet, cells[0]);
+    auto coeff_cell = coeffs.row(cell);
+    const std::uint8_t perm = perms(local_facet, cell);
     Ae.setZero(dmap0.size(), dmap1.size());
     kernel(Ae.data(), coeff_cell.data(), constant_values.data(),
-           coordinate_dofs.data(), &local_facet, &perm, cell_info[cells[0]]);
+           coordinate_dofs.data(), &local_facet, &perm, cell_info[cell]);
 
     // Zero rows/columns for essential bcs
     if (!bc0.empty())
@@ -285,7 +932,6 @@ void fem::impl::assemble_interior_facets(
                              const std::uint32_t)>& fn,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const std::vector<int>& offsets,
     const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values)
 {
   const int gdim = mesh.geometry().dim();
@@ -309,8 +955,9 @@ void fem::impl::assemble_interior_facets(
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       coordinate_dofs(2 * num_dofs_g, gdim);
   Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Ae;
-  Eigen::Array<ScalarType, Eigen::Dynamic, 1> coeff_array(2 * offsets.back());
-  assert(offsets.back() == coeffs.cols());
+
+  // Coefficients are packed facet-pair-major, one row per facet
+  assert(coeffs.rows() == (Eigen::Index)active_facets.size());
 
   // Temporaries for joint dofmaps
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dmapjoint0, dmapjoint1;
@@ -325,8 +972,10 @@ void fem::impl::assemble_interior_facets(
   assert(c);
   auto c_to_f = mesh.topology().connectivity(tdim, tdim - 1);
   assert(c_to_f);
-  for (std::int32_t facet_index : active_facets)
+  for (std::size_t index = 0; index < active_facets.size(); ++index)
   {
+    const std::int32_t facet_index = active_facets[index];
+
     // Create attached cells
     auto cells = c->links(facet_index);
     assert(cells.rows() == 2);
@@ -370,27 +1019,114 @@ void fem::impl::assemble_interior_facets(
     dmapjoint1.head(dmap1_cell0.size()) = dmap1_cell0;
     dmapjoint1.tail(dmap1_cell1.size()) = dmap1_cell1;
 
-    // Layout for the restricted coefficients is flattened
+    // Tabulate tensor. The coefficient row holds the restricted
+    // coefficients already flattened as
     // w[coefficient][restriction][dof]
-    auto coeff_cell0 = coeffs.row(cells[0]);
-    auto coeff_cell1 = coeffs.row(cells[1]);
+    Ae.setZero(dmapjoint0.size(), dmapjoint1.size());
+    fn(Ae.data(), coeffs.row(index).data(), constant_values.data(),
+       coordinate_dofs.data(), local_facet.data(), perm.data(),
+       cell_info[cells[0]]);
 
-    // Loop over coefficients
-    for (std::size_t i = 0; i < offsets.size() - 1; ++i)
+    // Zero rows/columns for essential bcs
+    if (!bc0.empty())
     {
-      // Loop over entries for coefficient i
-      const int num_entries = offsets[i + 1] - offsets[i];
-      coeff_array.segment(2 * offsets[i], num_entries)
-          = coeff_cell0.segment(offsets[i], num_entries);
-      coeff_array.segment(offsets[i + 1] + offsets[i], num_entries)
-          = coeff_cell1.segment(offsets[i], num_entries);
+      for (Eigen::Index i = 0; i < dmapjoint0.size(); ++i)
+      {
+        if (bc0[dmapjoint0[i]])
+          Ae.row(i).setZero();
+      }
+    }
+    if (!bc1.empty())
+    {
+      for (Eigen::Index j = 0; j < dmapjoint1.size(); ++j)
+      {
+        if (bc1[dmapjoint1[j]])
+          Ae.col(j).setZero();
+      }
     }
 
-    // Tabulate tensor
-    Ae.setZero(dmapjoint0.size(), dmapjoint1.size());
-    fn(Ae.data(), coeff_array.data(), constant_values.data(),
+    mat_set_values_local(dmapjoint0.size(), dmapjoint0.data(),
+                         dmapjoint1.size(), dmapjoint1.data(), Ae.data());
+  }
+}
+//-----------------------------------------------------------------------------
+template <typename ScalarType>
+void fem::impl::assemble_interior_facets(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const FacetAssemblyPlan::InteriorFacetData& plan,
+    const DofMap& dofmap0, const DofMap& dofmap1, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const int*, const std::uint8_t*,
+                             const std::uint32_t)>& fn,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values)
+{
+  const std::int32_t num_facets = plan.cell_info.size();
+  if (num_facets == 0)
+    return;
+
+  const int gdim = mesh.geometry().dim();
+
+  // Prepare cell geometry
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = mesh.geometry().dofmap().num_links(0);
+
+  // Data structures used in assembly, allocated once for all facets
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(2 * num_dofs_g, gdim);
+
+  // Coefficients are packed facet-pair-major, one row per facet
+  assert(coeffs.rows() == num_facets);
+
+  // The joint dofmap sizes are fixed across facets
+  const int ndofs0 = 2 * dofmap0.cell_dofs(plan.cells[0]).size();
+  const int ndofs1 = 2 * dofmap1.cell_dofs(plan.cells[0]).size();
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dmapjoint0(ndofs0);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> dmapjoint1(ndofs1);
+  Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae(ndofs0, ndofs1);
+
+  // Iterate over the cached (cell0, cell1, local_facet0, local_facet1)
+  // quadruples
+  for (std::int32_t f = 0; f < num_facets; ++f)
+  {
+    const std::int32_t cell0 = plan.cells[2 * f];
+    const std::int32_t cell1 = plan.cells[2 * f + 1];
+    const std::array<int, 2> local_facet
+        = {plan.local_facets[2 * f], plan.local_facets[2 * f + 1]};
+    const std::array<std::uint8_t, 2> perm
+        = {plan.perms[2 * f], plan.perms[2 * f + 1]};
+
+    // Get stacked cell geometry
+    const std::int32_t* x_dofs = plan.x_dofs.data() + 2 * f * num_dofs_g;
+    for (int i = 0; i < 2 * num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Get dof maps for cells and pack
+    auto dmap0_cell0 = dofmap0.cell_dofs(cell0);
+    auto dmap0_cell1 = dofmap0.cell_dofs(cell1);
+    dmapjoint0.head(dmap0_cell0.size()) = dmap0_cell0;
+    dmapjoint0.tail(dmap0_cell1.size()) = dmap0_cell1;
+
+    auto dmap1_cell0 = dofmap1.cell_dofs(cell0);
+    auto dmap1_cell1 = dofmap1.cell_dofs(cell1);
+    dmapjoint1.head(dmap1_cell0.size()) = dmap1_cell0;
+    dmapjoint1.tail(dmap1_cell1.size()) = dmap1_cell1;
+
+    // Tabulate tensor. The coefficient row holds the restricted
+    // coefficients already flattened as
+    // w[coefficient][restriction][dof]
+    Ae.setZero();
+    fn(Ae.data(), coeffs.row(f).data(), constant_values.data(),
        coordinate_dofs.data(), local_facet.data(), perm.data(),
-       cell_info[cells[0]]);
+       plan.cell_info[f]);
 
     // Zero rows/columns for essential bcs
     if (!bc0.empty())
@@ -415,3 +1151,69 @@ void fem::impl::assemble_interior_facets(
   }
 }
 //-----------------------------------------------------------------------------
+// @cond
+// protect from Doxygen
+// Explicit instantiations of the assembly drivers for the remaining
+// supported scalar types. The Form-level entry point is tied to
+// PetscScalar (its kernels and coefficient data come from the PETSc
+// build), but the drivers below take kernels and packed data from the
+// caller, so ensemble drivers carrying their own float32 (or real/
+// complex) kernels can assemble in the same binary.
+#define DOLFINX_INSTANTIATE_MATRIX_DRIVERS(T)                                  \
+  template void fem::impl::assemble_cells<T>(                                  \
+      const std::function<int(std::int32_t, const std::int32_t*,               \
+                              std::int32_t, const std::int32_t*, const T*)>&,  \
+      const mesh::Mesh&, const std::vector<std::int32_t>&,                     \
+      const graph::AdjacencyList<std::int32_t>&, int,                          \
+      const graph::AdjacencyList<std::int32_t>&, int,                          \
+      const std::vector<bool>&, const std::vector<bool>&,                      \
+      const std::function<void(T*, const T*, const T*, const double*,          \
+                               const int*, const std::uint8_t*,                \
+                               const std::uint32_t)>&,                         \
+      const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,                    \
+                         Eigen::RowMajor>&,                                    \
+      const Eigen::Array<T, Eigen::Dynamic, 1>&, AssemblyWorkspace*, double);  \
+  template void fem::impl::assemble_exterior_facets<T>(                        \
+      const std::function<int(std::int32_t, const std::int32_t*,               \
+                              std::int32_t, const std::int32_t*, const T*)>&,  \
+      const mesh::Mesh&, const std::vector<std::int32_t>&, const DofMap&,      \
+      const DofMap&, const std::vector<bool>&, const std::vector<bool>&,       \
+      const std::function<void(T*, const T*, const T*, const double*,          \
+                               const int*, const std::uint8_t*,                \
+                               const std::uint32_t)>&,                         \
+      const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,                    \
+                         Eigen::RowMajor>&,                                    \
+      const Eigen::Array<T, Eigen::Dynamic, 1>);                               \
+  template void fem::impl::assemble_interior_facets<T>(                        \
+      const std::function<int(std::int32_t, const std::int32_t*,               \
+                              std::int32_t, const std::int32_t*, const T*)>&,  \
+      const mesh::Mesh&, const std::vector<std::int32_t>&, const DofMap&,      \
+      const DofMap&, const std::vector<bool>&, const std::vector<bool>&,       \
+      const std::function<void(T*, const T*, const T*, const double*,          \
+                               const int*, const std::uint8_t*,                \
+                               const std::uint32_t)>&,                         \
+      const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,                    \
+                         Eigen::RowMajor>&,                                    \
+      const Eigen::Array<T, Eigen::Dynamic, 1>&);                              \
+  template void fem::impl::assemble_interior_facets<T>(                        \
+      const std::function<int(std::int32_t, const std::int32_t*,               \
+                              std::int32_t, const std::int32_t*, const T*)>&,  \
+      const mesh::Mesh&, const FacetAssemblyPlan::InteriorFacetData&,          \
+      const DofMap&, const DofMap&, const std::vector<bool>&,                  \
+      const std::vector<bool>&,                                                \
+      const std::function<void(T*, const T*, const T*, const double*,          \
+                               const int*, const std::uint8_t*,                \
+                               const std::uint32_t)>&,                         \
+      const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,                    \
+                         Eigen::RowMajor>&,                                    \
+      const Eigen::Array<T, Eigen::Dynamic, 1>&);
+
+DOLFINX_INSTANTIATE_MATRIX_DRIVERS(float)
+#ifdef PETSC_USE_COMPLEX
+DOLFINX_INSTANTIATE_MATRIX_DRIVERS(double)
+#else
+DOLFINX_INSTANTIATE_MATRIX_DRIVERS(std::complex<double>)
+#endif
+#undef DOLFINX_INSTANTIATE_MATRIX_DRIVERS
+// @endcond
+//-----------------------------------------------------------------------------
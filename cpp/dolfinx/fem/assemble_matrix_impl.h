@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <dolfinx/fem/FacetAssemblyPlan.h>
 #include <functional>
 #include <petscmat.h>
 #include <petscsys.h>
@@ -33,8 +34,11 @@ class Mesh;
 
 namespace fem
 {
+class CoefficientQPCache;
 class Form;
 class DofMap;
+class GeometryFactors;
+struct AssemblyWorkspace;
 
 namespace impl
 {
@@ -43,16 +47,34 @@ namespace impl
 /// i.e. a view into a larger matrix, and assembly is performed using
 /// local indices. Rows (bc0) and columns (bc1) with Dirichlet
 /// conditions are zeroed. Markers (bc0 and bc1) can be empty if not bcs
-/// are applied. Matrix is not finalised.
+/// are applied. Matrix is not finalised. If a workspace is provided,
+/// packing arrays and element-level scratch are taken from (and left
+/// in) the workspace so repeated assembly does not allocate. If a facet
+/// assembly plan is provided, interior facet integrals use the
+/// precomputed cell pairs and scatter maps from the plan. If a
+/// geometry factors buffer is provided, cell integrals with a kernel
+/// set via FormIntegrals::set_geometry_tabulate_tensor are assembled
+/// with that kernel, skipping the per-cell geometry computation. If a
+/// quadrature-point coefficient cache is provided, cell integrals with
+/// a kernel set via FormIntegrals::set_qp_tabulate_tensor are
+/// assembled with that kernel, skipping the per-cell coefficient
+/// interpolation.
 
 template <typename ScalarType>
 void assemble_matrix(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                             const std::int32_t*, const ScalarType*)>&
         mat_set_values_local,
-    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1);
+    const Form& a, const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    AssemblyWorkspace* workspace = nullptr,
+    const FacetAssemblyPlan* plan = nullptr,
+    const GeometryFactors* geometry = nullptr,
+    const CoefficientQPCache* coeff_qp = nullptr);
 
-/// Execute kernel over cells and accumulate result in Mat
+/// Execute kernel over cells and accumulate result in Mat. An optional
+/// estimated cost per cell (arbitrary units, e.g. flops + bytes, see
+/// FormIntegrals::CostEstimate) sets the granularity of the dynamic
+/// scheduler in the threaded path; 0 means unknown.
 template <typename ScalarType>
 void assemble_cells(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -67,7 +89,8 @@ void assemble_cells(
                              const std::uint32_t)>& kernel,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values);
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values,
+    AssemblyWorkspace* workspace = nullptr, double cost_per_cell = 0.0);
 
 /// Execute kernel over exterior facets and  accumulate result in Mat
 template <typename ScalarType>
@@ -85,7 +108,10 @@ void assemble_exterior_facets(
                        Eigen::RowMajor>& coeffs,
     const Eigen::Array<ScalarType, Eigen::Dynamic, 1> constant_values);
 
-/// Execute kernel over interior facets and  accumulate result in Mat
+/// Execute kernel over interior facets and  accumulate result in Mat.
+/// The coefficients must be packed facet-pair-major (one row per facet
+/// in @p active_facets, see fem::pack_coefficients_interior_facets),
+/// so the kernel loop reads one contiguous row per facet.
 template <typename ScalarType>
 void assemble_interior_facets(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -99,7 +125,26 @@ void assemble_interior_facets(
                              const std::uint32_t)>& kernel,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const std::vector<int>& offsets,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values);
+
+/// Execute kernel over interior facets using a precomputed plan and
+/// accumulate result in Mat. The (cell, cell, local facet, local facet)
+/// quadruples and permutations are taken from the plan, so no topology
+/// searches are performed in the facet loop. The coefficients must be
+/// packed facet-pair-major, one row per plan entry.
+template <typename ScalarType>
+void assemble_interior_facets(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const FacetAssemblyPlan::InteriorFacetData& plan,
+    const DofMap& dofmap0, const DofMap& dofmap1, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const int*, const std::uint8_t*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
     const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constant_values);
 
 } // namespace impl
@@ -9,7 +9,9 @@
 #include "Form.h"
 #include "utils.h"
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/function/Constant.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
@@ -24,6 +26,13 @@ using namespace dolfinx::fem;
 //-----------------------------------------------------------------------------
 PetscScalar dolfinx::fem::impl::assemble_scalar(const dolfinx::fem::Form& M)
 {
+  if (M.scalar_type != Form::petsc_scalar_type())
+  {
+    throw std::runtime_error(
+        "Form scalar type does not match the PETSc scalar. Assemble forms "
+        "with other scalar types through the scalar-templated drivers.");
+  }
+
   std::shared_ptr<const mesh::Mesh> mesh = M.mesh();
   assert(mesh);
 
@@ -72,17 +81,171 @@ PetscScalar dolfinx::fem::impl::assemble_scalar(const dolfinx::fem::Form& M)
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
   {
-    const std::vector<int> c_offsets = M.coefficients().offsets();
     const auto& fn = integrals.get_tabulate_tensor(type::interior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::interior_facet, i);
-    value += fem::impl::assemble_interior_facets(
-        *mesh, active_facets, fn, coeffs, c_offsets, constant_values);
+
+    // Re-pack the coefficients facet-pair-major so the facet loop reads
+    // one contiguous row per facet
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>
+        facet_coeffs
+        = pack_coefficients_interior_facets(M, coeffs, active_facets);
+    value += fem::impl::assemble_interior_facets(*mesh, active_facets, fn,
+                                                 facet_coeffs, constant_values);
   }
 
   return value;
 }
 //-----------------------------------------------------------------------------
+PetscScalar fem::impl::assemble_cellwise(
+    const fem::Form& M, Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& values)
+{
+  if (M.scalar_type != Form::petsc_scalar_type())
+  {
+    throw std::runtime_error(
+        "Form scalar type does not match the PETSc scalar. Assemble forms "
+        "with other scalar types through the scalar-templated drivers.");
+  }
+
+  std::shared_ptr<const mesh::Mesh> mesh = M.mesh();
+  assert(mesh);
+
+  const FormIntegrals& integrals = M.integrals();
+  using type = fem::FormIntegrals::Type;
+  if (integrals.num_integrals(type::exterior_facet) > 0
+      or integrals.num_integrals(type::interior_facet) > 0)
+  {
+    throw std::runtime_error(
+        "Cell-wise assembly supports cell integrals only");
+  }
+
+  // One slot per local cell, cells outside the domains stay zero
+  const int tdim = mesh->topology().dim();
+  auto cell_map = mesh->topology().index_map(tdim);
+  assert(cell_map);
+  values.setZero(cell_map->size_local() + cell_map->num_ghosts());
+
+  // Prepare constants
+  if (!M.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const std::vector<
+      std::pair<std::string, std::shared_ptr<const function::Constant>>>&
+      constants
+      = M.constants();
+
+  std::vector<PetscScalar> constant_values;
+  for (auto const& constant : constants)
+  {
+    const std::vector<PetscScalar>& array = constant.second->value;
+    constant_values.insert(constant_values.end(), array.data(),
+                           array.data() + array.size());
+  }
+
+  // Prepare coefficients
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs = pack_coefficients(M);
+
+  PetscScalar value = 0.0;
+  for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
+  {
+    const auto& fn = integrals.get_tabulate_tensor(type::cell, i);
+    const std::vector<std::int32_t>& active_cells
+        = integrals.integral_domains(type::cell, i);
+    value += fem::impl::assemble_cells_cellwise(*mesh, active_cells, fn,
+                                                coeffs, constant_values,
+                                                values);
+  }
+
+  return value;
+}
+//-----------------------------------------------------------------------------
+PetscScalar fem::impl::assemble_cells_cellwise(
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& fn,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const std::vector<PetscScalar>& constant_values,
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> values)
+{
+  const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+  mesh.topology_mutable().create_entities(tdim);
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Assemble one contiguous range of active cells, accumulating into
+  // values[cell] and returning the sum of the range, fused into the
+  // same pass over the kernel outputs
+  auto assemble_range = [&](std::size_t begin, std::size_t end,
+                            Eigen::Array<double, Eigen::Dynamic,
+                                         Eigen::Dynamic, Eigen::RowMajor>&
+                                coordinate_dofs) -> PetscScalar {
+    PetscScalar sum(0);
+    for (std::size_t index = begin; index < end; ++index)
+    {
+      const std::int32_t c = active_cells[index];
+
+      // Get cell coordinates/geometry
+      auto x_dofs = x_dofmap.links(c);
+      for (int i = 0; i < num_dofs_g; ++i)
+        coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+      PetscScalar value(0);
+      auto coeff_cell = coeffs.row(c);
+      fn(&value, coeff_cell.data(), constant_values.data(),
+         coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+      values[c] += value;
+      sum += value;
+    }
+    return sum;
+  };
+
+  const int num_threads = common::num_worker_threads();
+  if (num_threads == 1 or (int)active_cells.size() < 2 * num_threads)
+  {
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinate_dofs(num_dofs_g, gdim);
+    return assemble_range(0, active_cells.size(), coordinate_dofs);
+  }
+
+  // Threaded assembly. A cell appears once per domain, so chunks of
+  // cells write to disjoint output slots; the per-chunk sums land in
+  // task-owned slots and are combined below.
+  const std::size_t chunk
+      = std::max<std::size_t>(1, active_cells.size() / (8 * num_threads));
+  const int num_tasks = (active_cells.size() + chunk - 1) / chunk;
+  std::vector<PetscScalar> partial_sums(num_tasks, 0.0);
+  common::global_thread_pool().run(
+      num_tasks, [&assemble_range, &partial_sums, &active_cells, chunk,
+                  num_dofs_g, gdim](int t) {
+        Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+            coordinate_dofs(num_dofs_g, gdim);
+        const std::size_t begin = t * chunk;
+        const std::size_t end
+            = std::min(begin + chunk, active_cells.size());
+        partial_sums[t] = assemble_range(begin, end, coordinate_dofs);
+      });
+
+  PetscScalar value(0);
+  for (const PetscScalar& s : partial_sums)
+    value += s;
+  return value;
+}
+//-----------------------------------------------------------------------------
 PetscScalar fem::impl::assemble_cells(
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
     const std::function<void(PetscScalar*, const PetscScalar*,
@@ -203,7 +366,6 @@ PetscScalar fem::impl::assemble_interior_facets(
                              const std::uint8_t*, const std::uint32_t)>& fn,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const std::vector<int>& offsets,
     const std::vector<PetscScalar>& constant_values)
 {
   const int gdim = mesh.geometry().dim();
@@ -225,8 +387,9 @@ PetscScalar fem::impl::assemble_interior_facets(
   // Creat data structures used in assembly
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       coordinate_dofs(2 * num_dofs_g, gdim);
-  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> coeff_array(2 * offsets.back());
-  assert(offsets.back() == coeffs.cols());
+
+  // Coefficients are packed facet-pair-major, one row per facet
+  assert(coeffs.rows() == (Eigen::Index)active_facets.size());
 
   const Eigen::Array<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic>& perms
       = mesh.topology().get_facet_permutations();
@@ -240,8 +403,10 @@ PetscScalar fem::impl::assemble_interior_facets(
 
   // Iterate over all facets
   PetscScalar value(0);
-  for (std::int32_t f : active_facets)
+  for (std::size_t index = 0; index < active_facets.size(); ++index)
   {
+    const std::int32_t f = active_facets[index];
+
     // Create attached cell
     auto cells = f_to_c->links(f);
     assert(cells.rows() == 2);
@@ -269,22 +434,9 @@ PetscScalar fem::impl::assemble_interior_facets(
       coordinate_dofs.row(i + num_dofs_g) = x_g.row(x_dofs1[i]).head(gdim);
     }
 
-    // Layout for the restricted coefficients is flattened
+    // The row holds the restricted coefficients already flattened as
     // w[coefficient][restriction][dof]
-    auto coeff_cell0 = coeffs.row(cells[0]);
-    auto coeff_cell1 = coeffs.row(cells[1]);
-
-    // Loop over coefficients
-    for (std::size_t i = 0; i < offsets.size() - 1; ++i)
-    {
-      // Loop over entries for coefficient i
-      const int num_entries = offsets[i + 1] - offsets[i];
-      coeff_array.segment(2 * offsets[i], num_entries)
-          = coeff_cell0.segment(offsets[i], num_entries);
-      coeff_array.segment(offsets[i + 1] + offsets[i], num_entries)
-          = coeff_cell1.segment(offsets[i], num_entries);
-    }
-    fn(&value, coeff_array.data(), constant_values.data(),
+    fn(&value, coeffs.row(index).data(), constant_values.data(),
        coordinate_dofs.data(), local_facet.data(), perm.data(),
        cell_info[cells[0]]);
   }
@@ -37,6 +37,32 @@ namespace impl
 /// Assemble functional into an scalar
 PetscScalar assemble_scalar(const fem::Form& M);
 
+/// Assemble functional cell-by-cell into a flat per-cell array. Cell
+/// integrals only; throws for forms with facet integrals.
+/// @param[in] M The form (functional) to assemble
+/// @param[out] values Per-cell contributions. Resized to the number of
+///   local cells (owned and ghost) and zeroed; cells outside the
+///   integration domains stay zero.
+/// @return Sum of the per-cell contributions, i.e. the process-local
+///   assemble_scalar value of the form
+PetscScalar assemble_cellwise(const fem::Form& M,
+                              Eigen::Array<PetscScalar, Eigen::Dynamic, 1>&
+                                  values);
+
+/// Assemble functional over cells, accumulating each cell contribution
+/// into values[cell]. Thread-parallel: every output slot belongs to
+/// one cell, so chunks of cells run concurrently without write
+/// conflicts and without dofmap indirection.
+PetscScalar assemble_cells_cellwise(
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& fn,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const std::vector<PetscScalar>& constant_values,
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> values);
+
 /// Assemble functional over cells
 PetscScalar assemble_cells(
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
@@ -57,15 +83,17 @@ PetscScalar assemble_exterior_facets(
                        Eigen::RowMajor>& coeffs,
     const std::vector<PetscScalar>& constant_values);
 
-/// Assemble functional over interior facets
+/// Assemble functional over interior facets. The coefficients must be
+/// packed facet-pair-major (one row per facet in @p active_facets, see
+/// fem::pack_coefficients_interior_facets), so the kernel loop reads
+/// one contiguous row per facet.
 PetscScalar assemble_interior_facets(
-    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
     const std::function<void(PetscScalar*, const PetscScalar*,
                              const PetscScalar*, const double*, const int*,
                              const std::uint8_t*, const std::uint32_t)>& fn,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const std::vector<int>& offsets,
     const std::vector<PetscScalar>& constant_values);
 
 } // namespace impl
@@ -5,9 +5,13 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "assemble_vector_impl.h"
+#include "AssemblyTrace.h"
+#include "AssemblyWorkspace.h"
 #include "DirichletBC.h"
 #include "DofMap.h"
 #include "Form.h"
+#include "CoefficientQPCache.h"
+#include "GeometryFactors.h"
 #include "utils.h"
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/types.h>
@@ -26,6 +30,111 @@ using namespace dolfinx::fem;
 namespace
 {
 //-----------------------------------------------------------------------------
+// Cell assembly with a kernel that takes precomputed geometry factors
+// (J, K, detJ at its quadrature points) from a GeometryFactors buffer
+// instead of recomputing them from the cell coordinates
+void _assemble_cells_geometry(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap, int num_dofs_per_cell,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const double*,
+                             const double*, const double*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values,
+    const fem::GeometryFactors& geometry)
+{
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  // Data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  for (std::int32_t c : active_cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate vector for cell with precomputed geometry factors
+    auto coeff_cell = coeffs.row(c);
+    be.setZero();
+    kernel(be.data(), coeff_cell.data(), constant_values.data(),
+           coordinate_dofs.data(), geometry.J(c), geometry.K(c),
+           geometry.detJ(c), cell_info[c]);
+
+    // Scatter cell vector to 'global' vector array
+    auto dofs = dofmap.links(c);
+    for (Eigen::Index i = 0; i < num_dofs_per_cell; ++i)
+      b[dofs[i]] += be[i];
+  }
+}
+//-----------------------------------------------------------------------------
+// Cell assembly with a kernel that reads cached coefficient values at
+// its quadrature points from a CoefficientQPCache instead of
+// interpolating the coefficients from their expansion coefficients on
+// every cell
+void _assemble_cells_qp(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap, int num_dofs_per_cell,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*,
+                             const std::uint32_t)>& kernel,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values,
+    const fem::CoefficientQPCache& coeff_qp)
+{
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  // Data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  for (std::int32_t c : active_cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate vector for cell with cached quadrature-point
+    // coefficient values
+    be.setZero();
+    kernel(be.data(), coeff_qp.w(c), constant_values.data(),
+           coordinate_dofs.data(), cell_info[c]);
+
+    // Scatter cell vector to 'global' vector array
+    auto dofs = dofmap.links(c);
+    for (Eigen::Index i = 0; i < num_dofs_per_cell; ++i)
+      b[dofs[i]] += be[i];
+  }
+}
+//-----------------------------------------------------------------------------
 // Implementation of bc application
 void _lift_bc_cells(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
@@ -307,8 +416,17 @@ void _lift_bc_exterior_facets(
 
 //-----------------------------------------------------------------------------
 void fem::impl::assemble_vector(
-    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L)
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    AssemblyWorkspace* workspace, const FacetAssemblyPlan* plan,
+    const GeometryFactors* geometry, const CoefficientQPCache* coeff_qp)
 {
+  if (L.scalar_type != Form::petsc_scalar_type())
+  {
+    throw std::runtime_error(
+        "Form scalar type does not match the PETSc scalar. Assemble forms "
+        "with other scalar types through the scalar-templated drivers.");
+  }
+
   std::shared_ptr<const mesh::Mesh> mesh = L.mesh();
   assert(mesh);
 
@@ -321,16 +439,19 @@ void fem::impl::assemble_vector(
   assert(dofmap->element_dof_layout);
   const int num_dofs_per_cell = dofmap->element_dof_layout->num_dofs();
 
-  // Prepare constants
+  // Prepare constants and coefficients, packing into the workspace (if
+  // provided) so the arrays are reused across repeated assembly calls
   if (!L.all_constants_set())
     throw std::runtime_error("Unset constant in Form");
-  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
-      = pack_constants(L);
-
-  // Prepare coefficients
+  AssemblyWorkspace local_workspace;
+  AssemblyWorkspace& w = workspace ? *workspace : local_workspace;
+  pack_constants(L, w.constants);
+  pack_coefficients(L, w.coeffs, w.coeff_versions);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values
+      = w.constants;
   const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
-                     Eigen::RowMajor>
-      coeffs = pack_coefficients(L);
+                     Eigen::RowMajor>& coeffs
+      = w.coeffs;
 
   const FormIntegrals& integrals = L.integrals();
   using type = fem::FormIntegrals::Type;
@@ -340,29 +461,299 @@ void fem::impl::assemble_vector(
         = integrals.get_tabulate_tensor(FormIntegrals::Type::cell, i);
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
-    fem::impl::assemble_cells(b, *mesh, active_cells, dofs, num_dofs_per_cell,
-                              fn, coeffs, constant_values);
+    AssemblyTrace::record(active_cells);
+
+    // Use the kernel reading cached quadrature-point coefficient
+    // values when a cache is supplied and such a kernel has been
+    // attached
+    const auto& qp_fn = integrals.get_qp_tabulate_tensor(type::cell, i);
+    if (coeff_qp and qp_fn)
+    {
+      _assemble_cells_qp(b, *mesh, active_cells, dofs, num_dofs_per_cell,
+                         qp_fn, constant_values, *coeff_qp);
+      continue;
+    }
+
+    // Use the kernel taking precomputed geometry factors when a
+    // factors buffer is supplied and such a kernel has been attached
+    const auto& geometry_fn
+        = integrals.get_geometry_tabulate_tensor(type::cell, i);
+    if (geometry and geometry_fn)
+    {
+      _assemble_cells_geometry(b, *mesh, active_cells, dofs,
+                               num_dofs_per_cell, geometry_fn, coeffs,
+                               constant_values, *geometry);
+    }
+    else
+    {
+      fem::impl::assemble_cells(b, *mesh, active_cells, dofs,
+                                num_dofs_per_cell, fn, coeffs, constant_values,
+                                &w);
+    }
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
   {
     const auto& fn
         = integrals.get_tabulate_tensor(FormIntegrals::Type::exterior_facet, i);
-    const std::vector<std::int32_t>& active_facets
-        = integrals.integral_domains(type::exterior_facet, i);
-    fem::impl::assemble_exterior_facets(b, *mesh, active_facets, *dofmap, fn,
-                                        coeffs, constant_values);
+    if (plan)
+    {
+      // Facet-to-cell lookups and gather indices come from the plan
+      fem::impl::assemble_exterior_facets(b, *mesh, plan->data(i), *dofmap, fn,
+                                          coeffs, constant_values);
+    }
+    else
+    {
+      const std::vector<std::int32_t>& active_facets
+          = integrals.integral_domains(type::exterior_facet, i);
+      fem::impl::assemble_exterior_facets(b, *mesh, active_facets, *dofmap, fn,
+                                          coeffs, constant_values);
+    }
   }
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
   {
-    const std::vector<int> c_offsets = L.coefficients().offsets();
     const auto& fn
         = integrals.get_tabulate_tensor(FormIntegrals::Type::interior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::interior_facet, i);
+
+    // Re-pack the coefficients facet-pair-major so the facet loop reads
+    // one contiguous row per facet
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>
+        facet_coeffs
+        = pack_coefficients_interior_facets(L, coeffs, active_facets);
     fem::impl::assemble_interior_facets(b, *mesh, active_facets, *dofmap, fn,
-                                        coeffs, c_offsets, constant_values);
+                                        facet_coeffs, constant_values);
+  }
+}
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_vector_fused(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const Form& a,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
+        bc_values1,
+    const std::vector<bool>& bc_markers1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale)
+{
+  assert(L.rank() == 1);
+  assert(a.rank() == 2);
+
+  std::shared_ptr<const mesh::Mesh> mesh = L.mesh();
+  assert(mesh);
+  if (a.mesh() != mesh)
+    throw std::runtime_error("Forms must share a mesh for fused assembly");
+
+  // Both forms must be a single default cell integral so one cell loop
+  // covers both
+  using type = fem::FormIntegrals::Type;
+  for (const Form* form : {&L, &a})
+  {
+    if (form->integrals().num_integrals(type::cell) != 1
+        or form->integrals().integral_ids(type::cell)[0] != -1
+        or form->integrals().num_integrals(type::exterior_facet) > 0
+        or form->integrals().num_integrals(type::interior_facet) > 0)
+    {
+      throw std::runtime_error("Fused assembly requires forms with a single "
+                               "default cell integral");
+    }
+  }
+
+  // Get dofmap data. The test space is shared between L and a.
+  std::shared_ptr<const fem::DofMap> dofmap0 = L.function_space(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1 = a.function_space(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  const graph::AdjacencyList<std::int32_t>& dofs0 = dofmap0->list();
+  const graph::AdjacencyList<std::int32_t>& dofs1 = dofmap1->list();
+  const int num_dofs_per_cell0 = dofmap0->element_dof_layout->num_dofs();
+  const int num_dofs_per_cell1 = dofmap1->element_dof_layout->num_dofs();
+
+  // Prepare constants and coefficients for both forms
+  if (!L.all_constants_set() or !a.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants_L
+      = pack_constants(L);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants_a
+      = pack_constants(a);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs_L = pack_coefficients(L);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs_a = pack_coefficients(a);
+
+  const auto& kernel_L = L.integrals().get_tabulate_tensor(type::cell, 0);
+  const auto& kernel_a = a.integrals().get_tabulate_tensor(type::cell, 0);
+  const std::vector<std::int32_t>& active_cells
+      = L.integrals().integral_domains(type::cell, 0);
+
+  // Prepare cell geometry
+  mesh->topology_mutable().create_entity_permutations();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const int gdim = mesh->geometry().dim();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh->geometry().x();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  // Data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell0);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae(num_dofs_per_cell0, num_dofs_per_cell1);
+
+  // Single pass over cells: assemble L and apply lifting from a
+  for (std::int32_t c : active_cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate element vector
+    be.setZero();
+    kernel_L(be.data(), coeffs_L.row(c).data(), constants_L.data(),
+             coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+    // Apply lifting (be -= scale * Ae (g - x0)) if a bc dof touches
+    // this cell
+    auto dmap1 = dofs1.links(c);
+    bool has_bc = false;
+    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
+    {
+      if (bc_markers1[dmap1[j]])
+      {
+        has_bc = true;
+        break;
+      }
+    }
+
+    if (has_bc)
+    {
+      Ae.setZero();
+      kernel_a(Ae.data(), coeffs_a.row(c).data(), constants_a.data(),
+               coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+      for (Eigen::Index j = 0; j < dmap1.size(); ++j)
+      {
+        const std::int32_t jj = dmap1[j];
+        if (bc_markers1[jj])
+        {
+          const PetscScalar bc = bc_values1[jj];
+          if (x0.rows() > 0)
+            be -= Ae.col(j) * scale * (bc - x0[jj]);
+          else
+            be -= Ae.col(j) * scale * bc;
+        }
+      }
+    }
+
+    // Scatter cell vector to 'global' vector array
+    auto dmap0 = dofs0.links(c);
+    for (Eigen::Index i = 0; i < num_dofs_per_cell0; ++i)
+      b[dmap0[i]] += be[i];
+  }
+}
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_vector_ensemble(
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>>
+        b,
+    const Form& L,
+    const std::vector<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>>& coeffs)
+{
+  if (L.scalar_type != Form::petsc_scalar_type())
+  {
+    throw std::runtime_error(
+        "Form scalar type does not match the PETSc scalar. Assemble forms "
+        "with other scalar types through the scalar-templated drivers.");
+  }
+
+  const FormIntegrals& integrals = L.integrals();
+  using type = fem::FormIntegrals::Type;
+  if (integrals.num_integrals(type::exterior_facet) > 0
+      or integrals.num_integrals(type::interior_facet) > 0)
+  {
+    throw std::runtime_error(
+        "Ensemble assembly supports cell integrals only");
+  }
+
+  const int num_samples = coeffs.size();
+  assert(b.rows() == num_samples);
+
+  std::shared_ptr<const mesh::Mesh> mesh = L.mesh();
+  assert(mesh);
+  const int gdim = mesh->geometry().dim();
+
+  mesh->topology_mutable().create_entity_permutations();
+
+  // Get dofmap data
+  assert(L.function_space(0));
+  std::shared_ptr<const fem::DofMap> dofmap = L.function_space(0)->dofmap();
+  assert(dofmap);
+  const graph::AdjacencyList<std::int32_t>& dofs = dofmap->list();
+  assert(dofmap->element_dof_layout);
+  const int num_dofs_per_cell = dofmap->element_dof_layout->num_dofs();
+
+  // Constants are shared across the ensemble
+  if (!L.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
+      = pack_constants(L);
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh->geometry().x();
+
+  // Data structures used in assembly. Element vectors are stored
+  // sample-major (one contiguous row per sample) so each kernel call
+  // writes to a contiguous block.
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      be(num_samples, num_dofs_per_cell);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
+  {
+    const auto& fn = integrals.get_tabulate_tensor(type::cell, i);
+    const std::vector<std::int32_t>& active_cells
+        = integrals.integral_domains(type::cell, i);
+    for (std::int32_t c : active_cells)
+    {
+      // Gather cell geometry once for all samples
+      auto x_dofs = x_dofmap.links(c);
+      for (int j = 0; j < num_dofs_g; ++j)
+        coordinate_dofs.row(j) = x_g.row(x_dofs[j]).head(gdim);
+
+      // Tabulate element vector for each coefficient sample; geometry
+      // and permutation data are reused across the ensemble
+      be.setZero();
+      for (int k = 0; k < num_samples; ++k)
+      {
+        fn(be.row(k).data(), coeffs[k].row(c).data(), constant_values.data(),
+           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+      }
+
+      // Scatter element vectors: one dofmap lookup serves all samples
+      auto dmap = dofs.links(c);
+      for (Eigen::Index j = 0; j < num_dofs_per_cell; ++j)
+        for (int k = 0; k < num_samples; ++k)
+          b(k, dmap[j]) += be(k, j);
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -375,7 +766,8 @@ void fem::impl::assemble_cells(
                              const std::uint8_t*, const std::uint32_t)>& kernel,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values)
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values,
+    AssemblyWorkspace* workspace)
 {
   const int gdim = mesh.geometry().dim();
 
@@ -389,10 +781,16 @@ void fem::impl::assemble_cells(
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
       = mesh.geometry().x();
 
-  // Create data structures used in assembly
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coordinate_dofs(num_dofs_g, gdim);
-  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell);
+  // Data structures used in assembly, taken from the workspace when
+  // one is provided so their allocations are reused
+  AssemblyWorkspace local_workspace;
+  AssemblyWorkspace& w = workspace ? *workspace : local_workspace;
+  w.coordinate_dofs.resize(num_dofs_g, gdim);
+  w.be.resize(num_dofs_per_cell);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      coordinate_dofs
+      = w.coordinate_dofs;
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>& be = w.be;
 
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
       = mesh.topology().get_cell_permutation_info();
@@ -418,6 +816,58 @@ void fem::impl::assemble_cells(
   }
 }
 //-----------------------------------------------------------------------------
+void fem::impl::assemble_exterior_facets(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const mesh::Mesh& mesh, const FacetAssemblyPlan::FacetData& plan,
+    const fem::DofMap& dofmap,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& fn,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values)
+{
+  const int gdim = mesh.geometry().dim();
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  // Create data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
+
+  // All facet-to-cell data comes precomputed from the plan; only the
+  // kernel and the scatter run per facet
+  for (std::size_t k = 0; k < plan.cells.size(); ++k)
+  {
+    const std::int32_t cell = plan.cells[k];
+    const int local_facet = plan.local_facets[k];
+    const std::uint8_t perm = plan.perms[k];
+
+    // Gather cell vertex coordinates using the cached dof indices
+    const std::int32_t* x_dofs = plan.x_dofs.data() + k * num_dofs_g;
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Get dof map for cell
+    auto dmap = dofmap.cell_dofs(cell);
+
+    // Tabulate element vector
+    auto coeff_cell = coeffs.row(cell);
+    be.setZero(dmap.size());
+    fn(be.data(), coeff_cell.data(), constant_values.data(),
+       coordinate_dofs.data(), &local_facet, &perm, plan.cell_info[k]);
+
+    // Add element vector to global vector
+    for (Eigen::Index i = 0; i < dmap.size(); ++i)
+      b[dmap[i]] += be[i];
+  }
+}
+//-----------------------------------------------------------------------------
 void fem::impl::assemble_exterior_facets(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
@@ -434,7 +884,7 @@ void fem::impl::assemble_exterior_facets(
 
   // FIXME: cleanup these calls? Some of the happen internally again.
   mesh.topology_mutable().create_entities(tdim - 1);
-  mesh.topology_mutable().create_connectivity(tdim - 1, tdim);
+  mesh.topology_mutable().create_facet_cell_connectivity();
   mesh.topology_mutable().create_entity_permutations();
 
   // Prepare cell geometry
@@ -455,15 +905,15 @@ void fem::impl::assemble_exterior_facets(
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
       = mesh.topology().get_cell_permutation_info();
 
-  auto f_to_c = mesh.topology().connectivity(tdim - 1, tdim);
-  assert(f_to_c);
+  // Fixed-width facet -> cell lookup: no offsets array to read
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 2, Eigen::RowMajor>&
+      f_cells = mesh.topology().facet_cells();
   auto c_to_f = mesh.topology().connectivity(tdim, tdim - 1);
   assert(c_to_f);
   for (const auto& f : active_facets)
   {
     // Get index of first attached cell
-    assert(f_to_c->num_links(f) > 0);
-    const std::int32_t cell = f_to_c->links(f)[0];
+    const std::int32_t cell = f_cells(f, 0);
 
     // Get local index of facet with respect to the cell
     auto facets = c_to_f->links(cell);
@@ -501,7 +951,6 @@ void fem::impl::assemble_interior_facets(
                              const std::uint8_t*, const std::uint32_t)>& fn,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const std::vector<int>& offsets,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values)
 {
   const int gdim = mesh.geometry().dim();
@@ -524,8 +973,9 @@ void fem::impl::assemble_interior_facets(
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       coordinate_dofs(2 * num_dofs_g, gdim);
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
-  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> coeff_array(2 * offsets.back());
-  assert(offsets.back() == coeffs.cols());
+
+  // Coefficients are packed facet-pair-major, one row per facet
+  assert(coeffs.rows() == (Eigen::Index)active_facets.size());
 
   const Eigen::Array<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic>& perms
       = mesh.topology().get_facet_permutations();
@@ -536,8 +986,10 @@ void fem::impl::assemble_interior_facets(
   assert(f_to_c);
   auto c_to_f = mesh.topology().connectivity(tdim, tdim - 1);
   assert(c_to_f);
-  for (const auto& f : active_facets)
+  for (std::size_t index = 0; index < active_facets.size(); ++index)
   {
+    const std::int32_t f = active_facets[index];
+
     // Get attached cell indices
     auto cells = f_to_c->links(f);
     assert(cells.rows() == 2);
@@ -570,25 +1022,11 @@ void fem::impl::assemble_interior_facets(
     auto dmap0 = dofmap.cell_dofs(cells[0]);
     auto dmap1 = dofmap.cell_dofs(cells[1]);
 
-    // Layout for the restricted coefficients is flattened
+    // Tabulate element vector. The coefficient row holds the
+    // restricted coefficients already flattened as
     // w[coefficient][restriction][dof]
-    auto coeff_cell0 = coeffs.row(cells[0]);
-    auto coeff_cell1 = coeffs.row(cells[1]);
-
-    // Loop over coefficients
-    for (std::size_t i = 0; i < offsets.size() - 1; ++i)
-    {
-      // Loop over entries for coefficient i
-      const int num_entries = offsets[i + 1] - offsets[i];
-      coeff_array.segment(2 * offsets[i], num_entries)
-          = coeff_cell0.segment(offsets[i], num_entries);
-      coeff_array.segment(offsets[i + 1] + offsets[i], num_entries)
-          = coeff_cell1.segment(offsets[i], num_entries);
-    }
-
-    // Tabulate element vector
     be.setZero(dmap0.size() + dmap1.size());
-    fn(be.data(), coeff_array.data(), constant_values.data(),
+    fn(be.data(), coeffs.row(index).data(), constant_values.data(),
        coordinate_dofs.data(), local_facet.data(), perm.data(),
        cell_info[cells[0]]);
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "FacetAssemblyPlan.h"
 #include <Eigen/Dense>
 #include <dolfinx/common/types.h>
 #include <functional>
@@ -34,9 +35,12 @@ class Mesh;
 
 namespace fem
 {
+class CoefficientQPCache;
 class DirichletBC;
 class Form;
 class DofMap;
+class GeometryFactors;
+struct AssemblyWorkspace;
 
 /// Implementation of assembly
 namespace impl
@@ -46,8 +50,78 @@ namespace impl
 /// @param[in,out] b The vector to be assembled. It will not be zeroed
 ///                  before assembly.
 /// @param[in] L The linear forms to assemble into b
+/// @param[in] workspace Optional workspace. If provided, packing arrays
+///                      and element-level scratch are taken from (and
+///                      left in) the workspace so repeated assembly
+///                      does not allocate.
+/// @param[in] plan Optional precomputed exterior facet assembly plan
+///                 built for L. If provided, facet lookups and geometry
+///                 gather indices are taken from the plan.
+/// @param[in] geometry Optional precomputed geometry factors. If
+///                     provided, cell integrals with a kernel set via
+///                     FormIntegrals::set_geometry_tabulate_tensor are
+///                     assembled with that kernel, skipping the
+///                     per-cell geometry computation.
+/// @param[in] coeff_qp Optional cached coefficient values at
+///                     quadrature points. If provided, cell integrals
+///                     with a kernel set via
+///                     FormIntegrals::set_qp_tabulate_tensor are
+///                     assembled with that kernel, skipping the
+///                     per-cell coefficient interpolation.
 void assemble_vector(
-    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L);
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    AssemblyWorkspace* workspace = nullptr,
+    const FacetAssemblyPlan* plan = nullptr,
+    const GeometryFactors* geometry = nullptr,
+    const CoefficientQPCache* coeff_qp = nullptr);
+
+/// Assemble linear form into an Eigen vector with boundary-condition
+/// lifting fused into the same cell loop:
+///
+///   b <- b + L_e - scale * A_e (g - x0)
+///
+/// computed element-wise in a single pass, where A is generated by the
+/// bilinear form a and g holds the boundary condition values. This
+/// avoids the separate apply_lifting() sweep over cells. Dirichlet rows
+/// of b are not set; call set_bc() afterwards (it touches only the bc
+/// dofs). Both forms must consist of a single default cell integral and
+/// share mesh and test space.
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+///                  before assembly.
+/// @param[in] L The linear form to assemble into b
+/// @param[in] a The bilinear form generating the lifting matrix
+/// @param[in] bc_values1 The boundary condition 'values'
+/// @param[in] bc_markers1 Markers for the boundary condition dofs
+///                        (columns of A)
+/// @param[in] x0 The vector used in the lifting; may be empty
+/// @param[in] scale Scaling to apply to the lifting term
+void assemble_vector_fused(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const Form& a,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
+        bc_values1,
+    const std::vector<bool>& bc_markers1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale);
+
+/// Assemble linear form for an ensemble of packed coefficient sets in
+/// one cell sweep. Row k of b receives the assembly of L with
+/// coefficient data coeffs[k]; cell geometry, permutation data and
+/// dofmap lookups are gathered once per cell and reused across the
+/// ensemble. Constants are taken from the form and shared by all
+/// samples. Only cell integrals are supported.
+/// @param[in,out] b Array with one row per sample and one column per
+///                  process-local dof. Not zeroed before assembly.
+/// @param[in] L The linear form to assemble
+/// @param[in] coeffs Packed coefficient arrays, one per sample, each
+///                   with the layout produced by pack_coefficients()
+void assemble_vector_ensemble(
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>>
+        b,
+    const Form& L,
+    const std::vector<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>>& coeffs);
 
 /// Execute kernel over cells and accumulate result in vector
 void assemble_cells(
@@ -59,6 +133,20 @@ void assemble_cells(
                              const std::uint8_t*, const std::uint32_t)>& kernel,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values,
+    AssemblyWorkspace* workspace = nullptr);
+
+/// Execute kernel over the facets of a precomputed exterior facet
+/// assembly plan and accumulate result in vector
+void assemble_exterior_facets(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const mesh::Mesh& mesh, const FacetAssemblyPlan::FacetData& plan,
+    const fem::DofMap& dofmap,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& fn,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values);
 
 /// Execute kernel over cells and accumulate result in vector
@@ -73,7 +161,10 @@ void assemble_exterior_facets(
                        Eigen::RowMajor>& coeffs,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values);
 
-/// Assemble linear form interior facet integrals into an Eigen vector
+/// Assemble linear form interior facet integrals into an Eigen vector.
+/// The coefficients must be packed facet-pair-major (one row per facet
+/// in @p active_facets, see fem::pack_coefficients_interior_facets),
+/// so the kernel loop reads one contiguous row per facet.
 void assemble_interior_facets(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
@@ -83,7 +174,6 @@ void assemble_interior_facets(
                              const std::uint8_t*, const std::uint32_t)>& fn,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const std::vector<int>& offsets,
     const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values);
 
 /// Modify b such that:
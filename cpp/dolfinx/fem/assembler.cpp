@@ -5,6 +5,8 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "assembler.h"
+#include "AssemblyWorkspace.h"
+#include "CoefficientQPCache.h"
 #include "DirichletBC.h"
 #include "DofMap.h"
 #include "Form.h"
@@ -13,12 +15,19 @@
 #include "assemble_vector_impl.h"
 #include "utils.h"
 #include <Eigen/Sparse>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <memory>
+#include <numeric>
+#include <thread>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
@@ -29,14 +38,16 @@ namespace
 #ifdef PETSC_USE_64BIT_INDICES
 const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                         const std::int32_t*, const PetscScalar*)>
-make_petsc_lambda(Mat A, std::vector<PetscInt>& tmp_dofs_petsc64)
+make_petsc_lambda(Mat A)
 {
 
   const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                           const std::int32_t*, const PetscScalar*)>
-      f = [A, &tmp_dofs_petsc64](std::int32_t nrow, const std::int32_t* rows,
-                                 std::int32_t ncol, const std::int32_t* cols,
-                                 const PetscScalar* y) {
+      f = [A](std::int32_t nrow, const std::int32_t* rows, std::int32_t ncol,
+              const std::int32_t* cols, const PetscScalar* y) {
+        // Per-thread scratch: the lambda may be invoked concurrently
+        // from the threaded assembly loops
+        static thread_local std::vector<PetscInt> tmp_dofs_petsc64;
         tmp_dofs_petsc64.resize(nrow + ncol);
         std::copy(rows, rows + nrow, tmp_dofs_petsc64.begin());
         std::copy(cols, cols + ncol, tmp_dofs_petsc64.begin() + nrow);
@@ -54,7 +65,7 @@ make_petsc_lambda(Mat A, std::vector<PetscInt>& tmp_dofs_petsc64)
 #else
 const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                         const std::int32_t*, const PetscScalar*)>
-make_petsc_lambda(Mat A, std::vector<PetscInt>&)
+make_petsc_lambda(Mat A)
 {
   const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                           const std::int32_t*, const PetscScalar*)>
@@ -71,19 +82,163 @@ make_petsc_lambda(Mat A, std::vector<PetscInt>&)
   return f;
 }
 #endif
+//-----------------------------------------------------------------------------
+// Insertion lambda using MatSetValuesBlockedLocal. The dofmap
+// expansion is component-major (DofMapBuilder stores all component-0
+// dofs of the cell first, then all component-1 dofs, ...), so the
+// scalar dofs of node n are rows[k * nrow/bs + n] = bs * n + k and the
+// block indices are the first nrow/bs row entries divided by bs. The
+// element matrix carries the same component-major ordering and is
+// re-packed here into the node-major blocked layout
+// MatSetValuesBlockedLocal expects (the bs components of each node
+// consecutive). The re-pack is one pass over the element matrix;
+// inserting bs x bs blocks lets PETSc search the column indices once
+// per block rather than once per scalar entry.
+const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                        const std::int32_t*, const PetscScalar*)>
+make_blocked_petsc_lambda(Mat A, int bs)
+{
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      f = [A, bs](std::int32_t nrow, const std::int32_t* rows,
+                  std::int32_t ncol, const std::int32_t* cols,
+                  const PetscScalar* y) {
+        // Per-thread scratch: the lambda may be invoked concurrently
+        // from the threaded assembly loops
+        static thread_local std::vector<PetscInt> tmp_dofs;
+        static thread_local std::vector<PetscScalar> tmp_vals;
+        const std::int32_t nrow_b = nrow / bs;
+        const std::int32_t ncol_b = ncol / bs;
+        tmp_dofs.resize(nrow_b + ncol_b);
+        for (std::int32_t i = 0; i < nrow_b; ++i)
+          tmp_dofs[i] = rows[i] / bs;
+        for (std::int32_t j = 0; j < ncol_b; ++j)
+          tmp_dofs[nrow_b + j] = cols[j] / bs;
+        const PetscInt *rows1 = tmp_dofs.data(), *cols1 = rows1 + nrow_b;
+
+        // Re-pack the component-major element matrix node-major: entry
+        // (node i, component k; node j, component l) moves from row
+        // k * nrow_b + i, column l * ncol_b + j to row i * bs + k,
+        // column j * bs + l
+        std::vector<PetscScalar>& vals = tmp_vals;
+        vals.resize((std::size_t)nrow * ncol);
+        for (std::int32_t i = 0; i < nrow_b; ++i)
+        {
+          for (int k = 0; k < bs; ++k)
+          {
+            const PetscScalar* src = y + (std::size_t)(k * nrow_b + i) * ncol;
+            PetscScalar* dst = vals.data() + (std::size_t)(i * bs + k) * ncol;
+            for (std::int32_t j = 0; j < ncol_b; ++j)
+            {
+              for (int l = 0; l < bs; ++l)
+                dst[j * bs + l] = src[l * ncol_b + j];
+            }
+          }
+        }
+
+        PetscErrorCode ierr
+            = MatSetValuesBlockedLocal(A, nrow_b, rows1, ncol_b, cols1,
+                                       vals.data(), ADD_VALUES);
+#ifdef DEBUG
+        if (ierr != 0)
+          la::petsc_error(ierr, __FILE__, "MatSetValuesBlockedLocal");
+#endif
+        return 0;
+      };
+  return f;
+}
+//-----------------------------------------------------------------------------
+// Return the common block size of the form's dofmaps if the matrix
+// local-to-global maps carry the same block size (see
+// la::create_petsc_matrix), otherwise 1
+int insertion_block_size(Mat A, const Form& a)
+{
+  const int bs0 = a.function_space(0)->dofmap()->index_map->block_size();
+  const int bs1 = a.function_space(1)->dofmap()->index_map->block_size();
+  if (bs0 != bs1 or bs0 == 1)
+    return 1;
+
+  ISLocalToGlobalMapping l2g0 = nullptr, l2g1 = nullptr;
+  MatGetLocalToGlobalMapping(A, &l2g0, &l2g1);
+  if (!l2g0 or !l2g1)
+    return 1;
+  PetscInt bs_map0 = 1, bs_map1 = 1;
+  ISLocalToGlobalMappingGetBlockSize(l2g0, &bs_map0);
+  ISLocalToGlobalMappingGetBlockSize(l2g1, &bs_map1);
+  if (bs_map0 != bs0 or bs_map1 != bs0)
+    return 1;
+
+  return bs0;
+}
+//-----------------------------------------------------------------------------
+// Pick blocked or scalar insertion for assembling a into A
+const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                        const std::int32_t*, const PetscScalar*)>
+make_insertion_lambda(Mat A, const Form& a)
+{
+  const int bs = insertion_block_size(A, a);
+  if (bs > 1)
+    return make_blocked_petsc_lambda(A, bs);
+  else
+    return make_petsc_lambda(A);
+}
 
 } // namespace
 
 //-----------------------------------------------------------------------------
 PetscScalar fem::assemble_scalar(const Form& M)
 {
-  return fem::impl::assemble_scalar(M);
+  const PetscScalar m = fem::impl::assemble_scalar(M);
+  M.record_dependency_versions();
+  return m;
+}
+//-----------------------------------------------------------------------------
+fem::CellwiseValues fem::assemble_cellwise(const Form& M)
+{
+  CellwiseValues result;
+  result.sum = fem::impl::assemble_cellwise(M, result.values);
+  result.max = result.values.size() > 0
+                   ? result.values.real().maxCoeff()
+                   : 0.0;
+  M.record_dependency_versions();
+  return result;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> fem::mark_cells_fraction(
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>>&
+        values,
+    double fraction)
+{
+  if (fraction < 0.0 or fraction > 1.0)
+    throw std::runtime_error("Marking fraction must be in [0, 1].");
+
+  const std::int32_t num_cells = values.rows();
+  const std::int32_t num_marked
+      = std::min<std::int32_t>(num_cells, std::lround(fraction * num_cells));
+
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+  std::nth_element(cells.begin(), cells.begin() + num_marked, cells.end(),
+                   [&values](std::int32_t a, std::int32_t b) {
+                     return PetscRealPart(values[a])
+                            > PetscRealPart(values[b]);
+                   });
+  cells.resize(num_marked);
+  std::sort(cells.begin(), cells.end());
+  return cells;
 }
 //-----------------------------------------------------------------------------
 void fem::assemble_vector(Vec b, const Form& L)
 {
   la::VecWrapper _b(b);
   fem::impl::assemble_vector(_b.x, L);
+  L.record_dependency_versions();
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(Vec b, const Form& L, AssemblyWorkspace& workspace)
+{
+  la::VecWrapper _b(b);
+  fem::impl::assemble_vector(_b.x, L, &workspace);
 }
 //-----------------------------------------------------------------------------
 void fem::assemble_vector(
@@ -92,6 +247,111 @@ void fem::assemble_vector(
   fem::impl::assemble_vector(b, L);
 }
 //-----------------------------------------------------------------------------
+void fem::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    AssemblyWorkspace& workspace)
+{
+  fem::impl::assemble_vector(b, L, &workspace);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(Vec b, const Form& L, const FacetAssemblyPlan& plan)
+{
+  la::VecWrapper _b(b);
+  fem::impl::assemble_vector(_b.x, L, nullptr, &plan);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const FacetAssemblyPlan& plan)
+{
+  fem::impl::assemble_vector(b, L, nullptr, &plan);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(Vec b, const Form& L,
+                          const GeometryFactors& geometry)
+{
+  la::VecWrapper _b(b);
+  fem::impl::assemble_vector(_b.x, L, nullptr, nullptr, &geometry);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const GeometryFactors& geometry)
+{
+  fem::impl::assemble_vector(b, L, nullptr, nullptr, &geometry);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(Vec b, const Form& L, CoefficientQPCache& coeff_qp)
+{
+  // Re-evaluate any modified coefficients (no-op when all are
+  // unchanged)
+  coeff_qp.update();
+  la::VecWrapper _b(b);
+  fem::impl::assemble_vector(_b.x, L, nullptr, nullptr, nullptr, &coeff_qp);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    CoefficientQPCache& coeff_qp)
+{
+  coeff_qp.update();
+  fem::impl::assemble_vector(b, L, nullptr, nullptr, nullptr, &coeff_qp);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector_fused(
+    Vec b, const Form& L, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs, const Vec x0,
+    double scale)
+{
+  // Build boundary condition markers and values on the trial space of a
+  auto V1 = a.function_space(1);
+  assert(V1);
+  auto map1 = V1->dofmap()->index_map;
+  assert(map1);
+  const int crange
+      = map1->block_size() * (map1->size_local() + map1->num_ghosts());
+  std::vector<bool> bc_markers1(crange, false);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> bc_values1
+      = Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>::Zero(crange);
+  for (const std::shared_ptr<const DirichletBC>& bc : bcs)
+  {
+    assert(bc);
+    bc->mark_dofs(bc_markers1);
+    bc->dof_values(bc_values1);
+  }
+
+  // Fused cell loop (assemble + lifting), then set Dirichlet rows.
+  // set_bc only visits the bc dofs, so no further pass over the full
+  // vector is made.
+  {
+    la::VecWrapper _b(b);
+    if (x0)
+    {
+      la::VecReadWrapper _x0(x0);
+      impl::assemble_vector_fused(_b.x, L, a, bc_values1, bc_markers1, _x0.x,
+                                  scale);
+    }
+    else
+    {
+      const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> x0_empty(0);
+      impl::assemble_vector_fused(_b.x, L, a, bc_values1, bc_markers1,
+                                  x0_empty, scale);
+    }
+  }
+  set_bc(b, bcs, x0, scale);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector_ensemble(
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>>
+        b,
+    const Form& L,
+    const std::vector<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>>& coeffs)
+{
+  fem::impl::assemble_vector_ensemble(b, L, coeffs);
+}
+//-----------------------------------------------------------------------------
 void fem::apply_lifting(
     Vec b, const std::vector<std::shared_ptr<const Form>>& a,
     const std::vector<std::vector<std::shared_ptr<const DirichletBC>>>& bcs1,
@@ -187,9 +447,12 @@ Eigen::SparseMatrix<PetscScalar, Eigen::RowMajor> fem::assemble_matrix_eigen(
   return mat;
 }
 //-----------------------------------------------------------------------------
-void fem::assemble_matrix(
-    Mat A, const Form& a,
-    const std::vector<std::shared_ptr<const DirichletBC>>& bcs)
+namespace
+{
+// Build boundary condition markers for the test and trial spaces of a
+// bilinear form
+std::pair<std::vector<bool>, std::vector<bool>> build_dof_markers(
+    const Form& a, const std::vector<std::shared_ptr<const DirichletBC>>& bcs)
 {
   // Index maps for dof ranges
   auto map0 = a.function_space(0)->dofmap()->index_map;
@@ -217,41 +480,365 @@ void fem::assemble_matrix(
     }
   }
 
-  std::vector<PetscInt> tmp_dofs_petsc64;
+  return {std::move(dof_marker0), std::move(dof_marker1)};
+}
+//-----------------------------------------------------------------------------
+// Check whether two forms reference exactly the same coefficient
+// Functions (in the same order), in which case their packed coefficient
+// arrays are identical
+bool same_coefficients(const Form& a0, const Form& a1)
+{
+  const fem::FormCoefficients& c0 = a0.coefficients();
+  const fem::FormCoefficients& c1 = a1.coefficients();
+  if (c0.size() != c1.size())
+    return false;
+  for (int i = 0; i < c0.size(); ++i)
+  {
+    if (c0.get(i) != c1.get(i))
+      return false;
+  }
+
+  // Nothing worth sharing when there are no coefficients
+  return c0.size() > 0;
+}
+} // namespace
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs)
+{
+  const auto [dof_marker0, dof_marker1] = build_dof_markers(a, bcs);
+
   const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                           const std::int32_t*, const PetscScalar*)>
-      mat_set_values_local = make_petsc_lambda(A, tmp_dofs_petsc64);
+      mat_set_values_local = make_insertion_lambda(A, a);
 
   // Assemble
   impl::assemble_matrix(mat_set_values_local, a, dof_marker0, dof_marker1);
+  a.record_dependency_versions();
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    AssemblyWorkspace& workspace)
+{
+  const auto [dof_marker0, dof_marker1] = build_dof_markers(a, bcs);
+
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_insertion_lambda(A, a);
+
+  // Assemble
+  impl::assemble_matrix(mat_set_values_local, a, dof_marker0, dof_marker1,
+                        &workspace);
 }
 //-----------------------------------------------------------------------------
 void fem::assemble_matrix(Mat A, const Form& a, const std::vector<bool>& bc0,
                           const std::vector<bool>& bc1)
 {
-  std::vector<PetscInt> tmp_dofs_petsc64;
   const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                           const std::int32_t*, const PetscScalar*)>
-      mat_set_values_local = make_petsc_lambda(A, tmp_dofs_petsc64);
+      mat_set_values_local = make_insertion_lambda(A, a);
 
   impl::assemble_matrix(mat_set_values_local, a, bc0, bc1);
 }
 //-----------------------------------------------------------------------------
+void fem::assemble_matrix(Mat A, const Form& a, const std::vector<bool>& bc0,
+                          const std::vector<bool>& bc1,
+                          AssemblyWorkspace& workspace)
+{
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_insertion_lambda(A, a);
+
+  impl::assemble_matrix(mat_set_values_local, a, bc0, bc1, &workspace);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const FacetAssemblyPlan& plan)
+{
+  const auto [dof_marker0, dof_marker1] = build_dof_markers(a, bcs);
+
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_insertion_lambda(A, a);
+
+  // Assemble
+  impl::assemble_matrix(mat_set_values_local, a, dof_marker0, dof_marker1,
+                        nullptr, &plan);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const GeometryFactors& geometry)
+{
+  const auto [dof_marker0, dof_marker1] = build_dof_markers(a, bcs);
+
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_insertion_lambda(A, a);
+
+  // Assemble
+  impl::assemble_matrix(mat_set_values_local, a, dof_marker0, dof_marker1,
+                        nullptr, nullptr, &geometry);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    CoefficientQPCache& coeff_qp)
+{
+  // Re-evaluate any modified coefficients (no-op when all are
+  // unchanged)
+  coeff_qp.update();
+
+  const auto [dof_marker0, dof_marker1] = build_dof_markers(a, bcs);
+
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_insertion_lambda(A, a);
+
+  // Assemble
+  impl::assemble_matrix(mat_set_values_local, a, dof_marker0, dof_marker1,
+                        nullptr, nullptr, nullptr, &coeff_qp);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix_nest(
+    Mat A,
+    const Eigen::Ref<const Eigen::Array<const Form*, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs)
+{
+  // Collect the sub-matrix/form pairs to assemble
+  std::vector<std::pair<Mat, const Form*>> blocks;
+  for (Eigen::Index i = 0; i < a.rows(); ++i)
+  {
+    for (Eigen::Index j = 0; j < a.cols(); ++j)
+    {
+      if (a(i, j))
+      {
+        Mat subA = nullptr;
+        MatNestGetSubMat(A, i, j, &subA);
+        if (!subA)
+        {
+          throw std::runtime_error(
+              "MatNest block for non-null form has not been initialised.");
+        }
+        blocks.emplace_back(subA, a(i, j));
+      }
+    }
+  }
+
+  // Pack coefficients up front, one workspace per block. Blocks whose
+  // forms reference exactly the same coefficient Functions produce
+  // identical packed arrays, so the pack is performed once and copied;
+  // the recorded versions then make the per-block repack inside the
+  // assembly a no-op.
+  std::vector<AssemblyWorkspace> workspaces(blocks.size());
+  for (std::size_t k = 0; k < blocks.size(); ++k)
+  {
+    std::size_t source = k;
+    for (std::size_t l = 0; l < k; ++l)
+    {
+      if (same_coefficients(*blocks[l].second, *blocks[k].second))
+      {
+        source = l;
+        break;
+      }
+    }
+
+    if (source < k)
+    {
+      workspaces[k].coeffs = workspaces[source].coeffs;
+      workspaces[k].coeff_versions = workspaces[source].coeff_versions;
+    }
+    else
+    {
+      pack_coefficients(*blocks[k].second, workspaces[k].coeffs,
+                        workspaces[k].coeff_versions);
+    }
+  }
+
+#ifdef PETSC_HAVE_THREADSAFETY
+  // The nest blocks are distinct Mats, so with a thread-safe PETSc
+  // build they can be assembled concurrently
+  const std::size_t num_threads = std::min<std::size_t>(
+      common::num_worker_threads(), blocks.size());
+  if (num_threads > 1)
+  {
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+      threads.emplace_back([&blocks, &workspaces, &bcs, &next]() {
+        std::size_t k;
+        while ((k = next.fetch_add(1)) < blocks.size())
+          assemble_matrix(blocks[k].first, *blocks[k].second, bcs,
+                          workspaces[k]);
+      });
+    }
+    for (std::thread& t : threads)
+      t.join();
+    return;
+  }
+#endif
+
+  for (std::size_t k = 0; k < blocks.size(); ++k)
+    assemble_matrix(blocks[k].first, *blocks[k].second, bcs, workspaces[k]);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix_incremental(
+    Mat A, const Form& a, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1, const std::vector<std::int32_t>& dirty_cells,
+    CellTensorCache& cache)
+{
+  std::shared_ptr<const mesh::Mesh> mesh = a.mesh();
+  assert(mesh);
+
+  const FormIntegrals& integrals = a.integrals();
+  using type = fem::FormIntegrals::Type;
+  if (integrals.num_integrals(type::exterior_facet) > 0
+      or integrals.num_integrals(type::interior_facet) > 0
+      or integrals.num_integrals(type::cell) != 1)
+  {
+    throw std::runtime_error("Incremental assembly supports forms with a "
+                             "single cell integral only");
+  }
+
+  // Get dofmap data
+  std::shared_ptr<const fem::DofMap> dofmap0 = a.function_space(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1 = a.function_space(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  const int num_dofs_per_cell0 = dofmap0->element_dof_layout->num_dofs();
+  const int num_dofs_per_cell1 = dofmap1->element_dof_layout->num_dofs();
+
+  // Prepare constants and coefficients
+  if (!a.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
+      = pack_constants(a);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs = pack_coefficients(a);
+
+  const auto& kernel = integrals.get_tabulate_tensor(type::cell, 0);
+  const std::vector<std::int32_t>& active_cells
+      = integrals.integral_domains(type::cell, 0);
+
+  // Prepare cell geometry
+  mesh->topology_mutable().create_entity_permutations();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const int gdim = mesh->geometry().dim();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh->geometry().x();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_insertion_lambda(A, a);
+
+  // A zero-initialised cache makes the first call a full assembly:
+  // every delta is then just the freshly computed tensor
+  const int tdim = mesh->topology().dim();
+  const std::int32_t num_cells
+      = mesh->topology().index_map(tdim)->size_local()
+        + mesh->topology().index_map(tdim)->num_ghosts();
+  const bool full_assembly = cache.values.size() == 0;
+  if (full_assembly)
+    cache.values.setZero(num_cells, num_dofs_per_cell0 * num_dofs_per_cell1);
+
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae(num_dofs_per_cell0, num_dofs_per_cell1);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae_delta(num_dofs_per_cell0, num_dofs_per_cell1);
+
+  const std::vector<std::int32_t>& cells
+      = full_assembly ? active_cells : dirty_cells;
+  for (std::int32_t c : cells)
+  {
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
+    for (int i = 0; i < x_dofs.rows(); ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Tabulate tensor
+    auto coeff_cell = coeffs.row(c);
+    Ae.setZero();
+    kernel(Ae.data(), coeff_cell.data(), constant_values.data(),
+           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+    auto dofs0 = dofmap0->list().links(c);
+    auto dofs1 = dofmap1->list().links(c);
+
+    // Zero rows/columns for essential bcs
+    if (!bc0.empty())
+    {
+      for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+      {
+        if (bc0[dofs0[i]])
+          Ae.row(i).setZero();
+      }
+    }
+    if (!bc1.empty())
+    {
+      for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+      {
+        if (bc1[dofs1[j]])
+          Ae.col(j).setZero();
+      }
+    }
+
+    // Subtract the stale cached contribution, add the fresh one, and
+    // update the cache
+    auto cached = cache.values.row(c);
+    Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                             Eigen::RowMajor>>
+        Ae_cached(cached.data(), num_dofs_per_cell0, num_dofs_per_cell1);
+    Ae_delta = Ae - Ae_cached;
+    mat_set_values_local(num_dofs_per_cell0, dofs0.data(), num_dofs_per_cell1,
+                         dofs1.data(), Ae_delta.data());
+    Ae_cached = Ae;
+  }
+}
+//-----------------------------------------------------------------------------
 void fem::add_diagonal(
     Mat A, const function::FunctionSpace& V,
     const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
     PetscScalar diagonal)
 {
+  // Collect the owned constrained rows of all boundary conditions and
+  // process them in a single sorted sweep, rather than one
+  // MatSetValuesLocal pass per condition. Rows constrained by more
+  // than one condition receive the value once.
+  std::vector<std::int32_t> rows;
   for (const auto& bc : bcs)
   {
     assert(bc);
     if (V.contains(*bc->function_space()))
     {
-      const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& owned_dofs
-          = bc->dofs_owned().col(0);
-      add_diagonal(A, owned_dofs, diagonal);
+      auto owned_dofs = bc->dofs_owned().col(0);
+      for (Eigen::Index i = 0; i < owned_dofs.size(); ++i)
+        rows.push_back(owned_dofs[i]);
     }
   }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+  add_diagonal(A,
+               Eigen::Map<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>(
+                   rows.data(), rows.size()),
+               diagonal);
 }
 //-----------------------------------------------------------------------------
 void fem::add_diagonal(
@@ -266,10 +853,9 @@ void fem::add_diagonal(
   // NOTE: MatSetValuesLocal uses ADD_VALUES, hence it requires that the
   //       diagonal is zero before this function is called.
 
-  std::vector<PetscInt> tmp_dofs_petsc64;
   const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                           const std::int32_t*, const PetscScalar*)>
-      mat_set_values_local = make_petsc_lambda(A, tmp_dofs_petsc64);
+      mat_set_values_local = make_petsc_lambda(A);
 
   for (Eigen::Index i = 0; i < rows.size(); ++i)
   {
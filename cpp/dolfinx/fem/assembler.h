@@ -25,6 +25,11 @@ namespace fem
 {
 class DirichletBC;
 class Form;
+struct AssemblyWorkspace;
+struct CellTensorCache;
+class CoefficientQPCache;
+class FacetAssemblyPlan;
+class GeometryFactors;
 
 // -- Scalar ----------------------------------------------------------------
 
@@ -35,6 +40,51 @@ class Form;
 ///         process
 PetscScalar assemble_scalar(const Form& M);
 
+/// Per-cell assembly result from assemble_cellwise, with the
+/// reductions needed for refinement marking fused into the assembly
+/// pass
+struct CellwiseValues
+{
+  /// Contribution of each local cell (owned and ghost cells, in mesh
+  /// cell order). Cells outside the integration domains are zero.
+  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> values;
+
+  /// Sum of the per-cell values, i.e. the process-local
+  /// assemble_scalar value of the form
+  PetscScalar sum;
+
+  /// Largest per-cell value (real part) on this process
+  double max;
+};
+
+/// Assemble a functional cell-by-cell into a flat per-cell array, e.g.
+/// a squared error indicator. Each kernel output is written straight
+/// to the slot of its cell, with no dofmap indirection and no function
+/// space, which is cheaper than assembling into a DG0 vector. The cell
+/// loop is thread-parallel (one output slot per cell, so no write
+/// conflicts) and the local sum is accumulated in the same pass; the
+/// local max is one vectorized scan over the result. Caller is
+/// responsible for any accumulation across processes. Cell integrals
+/// only; throws for forms with facet integrals.
+/// @param[in] M The form (functional) to assemble
+/// @return Per-cell values with the fused local reductions
+CellwiseValues assemble_cellwise(const Form& M);
+
+/// Mark the fraction of local cells with the largest values, e.g. for
+/// building the MeshTags marker passed to refinement::refine from the
+/// indicator of assemble_cellwise. Selection is by quantile
+/// (nth_element on the real parts), so no sort of the full array is
+/// needed. Marking is per-process; for a global quantile, rescale
+/// @p fraction from a global reduction first.
+/// @param[in] values Per-cell values. Pass the leading size_local
+///   segment to mark owned cells only.
+/// @param[in] fraction Fraction of the cells to mark, in [0, 1]
+/// @return The marked cell indices, sorted
+std::vector<std::int32_t> mark_cells_fraction(
+    const Eigen::Ref<const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>>&
+        values,
+    double fraction);
+
 // -- Vectors ----------------------------------------------------------------
 
 /// Assemble linear form into an already allocated PETSc vector. Ghost
@@ -48,6 +98,14 @@ PetscScalar assemble_scalar(const Form& M);
 /// @param[in] L The linear form to assemble
 void assemble_vector(Vec b, const Form& L);
 
+/// Assemble linear form into an already allocated PETSc vector, reusing
+/// assembly scratch data from a workspace. See
+/// assemble_vector(Vec, const Form&) for semantics.
+/// @param[in,out] b The PETsc vector to assemble the form into
+/// @param[in] L The linear form to assemble
+/// @param[in,out] workspace Reusable assembly scratch storage
+void assemble_vector(Vec b, const Form& L, AssemblyWorkspace& workspace);
+
 /// Assemble linear form into an Eigen vector
 /// @param[in,out] b The Eigen vector to be assembled. It will not be
 ///                  zeroed before assembly.
@@ -55,6 +113,136 @@ void assemble_vector(Vec b, const Form& L);
 void assemble_vector(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L);
 
+/// Assemble linear form into an Eigen vector, reusing assembly scratch
+/// data from a workspace
+/// @param[in,out] b The Eigen vector to be assembled. It will not be
+///                  zeroed before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in,out] workspace Reusable assembly scratch storage
+void assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    AssemblyWorkspace& workspace);
+
+/// Assemble linear form into an already allocated PETSc vector using a
+/// precomputed exterior facet assembly plan. Facet-to-cell lookups,
+/// permutations and geometry gather indices are taken from the plan, so
+/// repeated facet-heavy assemblies only run the kernels. See
+/// assemble_vector(Vec, const Form&) for the remaining semantics.
+/// @param[in,out] b The PETsc vector to assemble the form into
+/// @param[in] L The linear form to assemble
+/// @param[in] plan Facet assembly plan built for L
+void assemble_vector(Vec b, const Form& L, const FacetAssemblyPlan& plan);
+
+/// Assemble linear form into an Eigen vector using a precomputed
+/// exterior facet assembly plan
+/// @param[in,out] b The Eigen vector to be assembled. It will not be
+///                  zeroed before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in] plan Facet assembly plan built for L
+void assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const FacetAssemblyPlan& plan);
+
+/// Assemble linear form into an already allocated PETSc vector using
+/// precomputed geometry factors. Cell integrals with a kernel set via
+/// FormIntegrals::set_geometry_tabulate_tensor receive J, K and detJ
+/// from the factors buffer instead of recomputing them; integrals
+/// without such a kernel fall back to the standard path. The same
+/// buffer can be shared between forms, e.g. the Jacobian and residual
+/// of a Newton solve. See assemble_vector(Vec, const Form&) for the
+/// remaining semantics.
+/// @param[in,out] b The PETsc vector to assemble the form into
+/// @param[in] L The linear form to assemble
+/// @param[in] geometry Geometry factors evaluated at the quadrature
+///                     points of the opted-in kernels
+void assemble_vector(Vec b, const Form& L, const GeometryFactors& geometry);
+
+/// Assemble linear form into an Eigen vector using precomputed
+/// geometry factors
+/// @param[in,out] b The Eigen vector to be assembled. It will not be
+///                  zeroed before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in] geometry Geometry factors evaluated at the quadrature
+///                     points of the opted-in kernels
+void assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const GeometryFactors& geometry);
+
+/// Assemble linear form into an already allocated PETSc vector using
+/// cached coefficient values at quadrature points. Cell integrals with
+/// a kernel set via FormIntegrals::set_qp_tabulate_tensor read the
+/// cached values instead of interpolating the coefficients per cell;
+/// integrals without such a kernel fall back to the standard path. The
+/// cache is refreshed first (a no-op when no coefficient has been
+/// modified), so constant-in-time coefficients are interpolated only
+/// once across repeated assemblies. See assemble_vector(Vec, const
+/// Form&) for the remaining semantics.
+/// @param[in,out] b The PETsc vector to assemble the form into
+/// @param[in] L The linear form to assemble
+/// @param[in,out] coeff_qp Coefficient values cached at the quadrature
+///                         points of the opted-in kernels
+void assemble_vector(Vec b, const Form& L, CoefficientQPCache& coeff_qp);
+
+/// Assemble linear form into an Eigen vector using cached coefficient
+/// values at quadrature points
+/// @param[in,out] b The Eigen vector to be assembled. It will not be
+///                  zeroed before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in,out] coeff_qp Coefficient values cached at the quadrature
+///                         points of the opted-in kernels
+void assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    CoefficientQPCache& coeff_qp);
+
+/// Assemble linear form, apply lifting and set Dirichlet rows in one
+/// pass:
+///
+///   b <- b + L_e - scale * A_e (g - x0)  (element-wise, single cell
+///                                         loop)
+///   b[dof] = scale * (g[dof] - x0[dof])  (owned Dirichlet dofs only)
+///
+/// This fuses assemble_vector() + apply_lifting() + set_bc() for the
+/// common one-form/one-matrix case, avoiding two extra passes over cell
+/// data. Ghost contributions are not accumulated; caller is responsible
+/// for calling VecGhostUpdateBegin/End. Both forms must consist of a
+/// single default cell integral.
+/// @param[in,out] b The PETSc vector to assemble into. Not zeroed
+///                  before assembly.
+/// @param[in] L The linear form to assemble
+/// @param[in] a The bilinear form generating the lifting matrix. Must
+///              share mesh and test space with L.
+/// @param[in] bcs Boundary conditions on the trial space of a
+/// @param[in] x0 Vector used in the lifting, e.g. the current Newton
+///               solution. May be null.
+/// @param[in] scale Scaling applied to the lifting and bc values
+void assemble_vector_fused(
+    Vec b, const Form& L, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs, const Vec x0,
+    double scale);
+
+/// Assemble linear form for an ensemble of coefficient samples in one
+/// cell sweep. Row k of b receives the assembly of L with packed
+/// coefficient data coeffs[k]; cell geometry, permutation data and
+/// dofmap lookups are gathered once per cell and shared across the
+/// ensemble, so K samples cost roughly one sweep plus K kernel calls
+/// per cell. Constants are taken from the form and shared by all
+/// samples. Only cell integrals are supported. Ghost contributions are
+/// not accumulated.
+/// @param[in,out] b Array with one row per sample and one column per
+///                  process-local dof. Not zeroed before assembly.
+/// @param[in] L The linear form to assemble
+/// @param[in] coeffs Packed coefficient arrays, one per sample, each
+///                   with the layout produced by pack_coefficients().
+///                   Build them by attaching each sample's coefficients
+///                   to the form and packing.
+void assemble_vector_ensemble(
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>>
+        b,
+    const Form& L,
+    const std::vector<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>>& coeffs);
+
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
 
@@ -124,6 +312,18 @@ void assemble_matrix(
     Mat A, const Form& a,
     const std::vector<std::shared_ptr<const DirichletBC>>& bcs);
 
+/// Assemble bilinear form into a matrix, reusing assembly scratch data
+/// from a workspace. See
+/// assemble_matrix(Mat, const Form&, const std::vector&) for semantics.
+/// @param[in,out] A The PETsc matrix to assemble the form into
+/// @param[in] a The bilinear from to assemble
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in,out] workspace Reusable assembly scratch storage
+void assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    AssemblyWorkspace& workspace);
+
 /// Assemble bilinear form into a matrix. Matrix must already be
 /// initialised. Does not zero or finalise the matrix.
 /// @param[in,out] A The matrix to assemble in to. Matrix must be
@@ -138,14 +338,128 @@ void assemble_matrix(
 void assemble_matrix(Mat A, const Form& a, const std::vector<bool>& bc0,
                      const std::vector<bool>& bc1);
 
+/// Assemble bilinear form into a matrix, reusing assembly scratch data
+/// from a workspace. See assemble_matrix(Mat, const Form&, const
+/// std::vector<bool>&, const std::vector<bool>&) for semantics.
+/// @param[in,out] A The matrix to assemble in to
+/// @param[in] a The bilinear form to assemble
+/// @param[in] bc0 Boundary condition markers for the rows
+/// @param[in] bc1 Boundary condition markers for the columns
+/// @param[in,out] workspace Reusable assembly scratch storage
+void assemble_matrix(Mat A, const Form& a, const std::vector<bool>& bc0,
+                     const std::vector<bool>& bc1,
+                     AssemblyWorkspace& workspace);
+
+/// Assemble bilinear form into a matrix using a precomputed facet
+/// assembly plan. Interior facet (DG) integrals use the cached
+/// (cell, cell, local facet, local facet) quadruples and coefficient
+/// scatter maps from the plan instead of searching the topology per
+/// facet. See assemble_matrix(Mat, const Form&, const std::vector&)
+/// for semantics.
+/// @param[in,out] A The PETsc matrix to assemble the form into
+/// @param[in] a The bilinear from to assemble
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] plan Precomputed facet assembly plan built from the form
+void assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const FacetAssemblyPlan& plan);
+
+/// Assemble bilinear form into a matrix using precomputed geometry
+/// factors. Cell integrals with a kernel set via
+/// FormIntegrals::set_geometry_tabulate_tensor receive J, K and detJ
+/// from the factors buffer instead of recomputing them; integrals
+/// without such a kernel fall back to the standard path. The same
+/// buffer can be shared between forms, e.g. the Jacobian and residual
+/// of a Newton solve. See assemble_matrix(Mat, const Form&, const
+/// std::vector&) for semantics.
+/// @param[in,out] A The PETsc matrix to assemble the form into
+/// @param[in] a The bilinear from to assemble
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] geometry Geometry factors evaluated at the quadrature
+///                     points of the opted-in kernels
+void assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const GeometryFactors& geometry);
+
+/// Assemble bilinear form into a matrix using cached coefficient
+/// values at quadrature points. Cell integrals with a kernel set via
+/// FormIntegrals::set_qp_tabulate_tensor read the cached values
+/// instead of interpolating the coefficients per cell; integrals
+/// without such a kernel fall back to the standard path. The cache is
+/// refreshed first (a no-op when no coefficient has been modified), so
+/// constant-in-time coefficients are interpolated only once across
+/// repeated assemblies. See assemble_matrix(Mat, const Form&, const
+/// std::vector&) for semantics.
+/// @param[in,out] A The PETsc matrix to assemble the form into
+/// @param[in] a The bilinear from to assemble
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in,out] coeff_qp Coefficient values cached at the quadrature
+///                         points of the opted-in kernels
+void assemble_matrix(
+    Mat A, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    CoefficientQPCache& coeff_qp);
+
+/// Assemble a rectangular array of bilinear forms into the sub-blocks
+/// of a MatNest matrix (see fem::create_matrix_nest). Each non-null
+/// form a(i, j) is assembled into the corresponding nest block, which
+/// must already be initialised. Blocks touch disjoint PETSc Mats, so
+/// when PETSc is built with thread safety (PETSC_HAVE_THREADSAFETY)
+/// the blocks are assembled concurrently on the worker threads (see
+/// DOLFINX_NUM_THREADS); otherwise they are assembled one after the
+/// other. Coefficient packing is shared between blocks whose forms
+/// reference exactly the same coefficient Functions. Sub-blocks are not
+/// zeroed and the matrix is not finalised.
+/// @param[in,out] A The MatNest matrix to assemble the forms into. The
+///                  nest layout must match the block structure of a.
+/// @param[in] a The bilinear forms to assemble. a(i, j) may be null,
+///              in which case block (i, j) is left untouched.
+/// @param[in] bcs Boundary conditions to apply to each block. For
+///                boundary condition dofs the row and column are
+///                zeroed. Diagonal entries are not set (see
+///                fem::add_diagonal).
+void assemble_matrix_nest(
+    Mat A,
+    const Eigen::Ref<const Eigen::Array<const Form*, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs);
+
+/// Incrementally re-assemble a bilinear form into a matrix, re-running
+/// kernels only on the given dirty cells. On the first call (empty
+/// cache) a full assembly is performed and every element tensor is
+/// recorded in the cache. On subsequent calls only dirty_cells are
+/// visited: the stale cached contribution of each cell is subtracted
+/// and the freshly computed one added, so the matrix must not have been
+/// modified by other means between calls. Only forms with cell
+/// integrals are supported. Matrix is not finalised.
+/// @param[in,out] A The matrix to assemble in to. Matrix must be
+///                  initialised and must carry the contributions
+///                  recorded in the cache.
+/// @param[in] a The bilinear form to assemble
+/// @param[in] bc0 Boundary condition markers for the rows
+/// @param[in] bc1 Boundary condition markers for the columns
+/// @param[in] dirty_cells Cells whose coefficients or geometry changed
+///                        since the cache was recorded. Ignored on the
+///                        first (full) assembly.
+/// @param[in,out] cache Per-cell element tensor cache
+void assemble_matrix_incremental(Mat A, const Form& a,
+                                 const std::vector<bool>& bc0,
+                                 const std::vector<bool>& bc1,
+                                 const std::vector<std::int32_t>& dirty_cells,
+                                 CellTensorCache& cache);
+
 /// Adds a value to the diagonal of the matrix for rows with a Dirichlet
 /// boundary conditions applied. This function is typically called after
 /// assembly. The assembly function zeroes Dirichlet rows and columns.
 /// This function adds the value only to rows that are locally owned,
-/// and therefore does not create a need for parallel communication. For
-/// block matrices, this function should normally be called only on the
-/// diagonal blocks, i.e. blocks for which the test and trial spaces are
-/// the same.
+/// and therefore does not create a need for parallel communication. The
+/// rows of all boundary conditions are gathered, sorted and processed
+/// in one sweep, so a row constrained by more than one condition
+/// receives the value once. For block matrices, this function should
+/// normally be called only on the diagonal blocks, i.e. blocks for
+/// which the test and trial spaces are the same.
 /// @param[in,out] A The matrix to add diagonal values to
 /// @param[in] V The function space for the rows and columns of the
 ///              matrix. It is used to extract only the Dirichlet
@@ -10,6 +10,7 @@
 #include <dolfinx/common/log.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Topology.h>
+#include <map>
 
 using namespace dolfinx;
 
@@ -284,7 +285,8 @@ compute_ordering_hexahedron(const mesh::Topology& topology)
 } // namespace
 
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+std::pair<Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+          std::vector<std::int32_t>>
 fem::compute_dof_permutations(const mesh::Topology& topology,
                               const fem::ElementDofLayout& dof_layout)
 {
@@ -326,19 +328,50 @@ fem::compute_dof_permutations(const mesh::Topology& topology,
   const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       permutations = dof_layout.base_permutations();
   const int pcols = permutations.cols();
+  const int num_cells = cell_ordering.rows();
+  const int num_orders = cell_ordering.cols();
 
-  // Compute permutations on each cell
+  // Encode the orders of each cell as a mixed-radix code. Cells with
+  // equal codes share a dof permutation, so only the distinct codes
+  // are expanded below. The radix of each position only needs to
+  // exceed the largest order that occurs in that position.
+  std::vector<std::int64_t> radix(num_orders, 1);
+  for (int i = 0; i < num_orders; ++i)
+    if (num_cells > 0)
+      radix[i] = cell_ordering.col(i).maxCoeff() + 1;
+
+  // Map each cell to its code, recording the first cell on which each
+  // distinct code occurs
+  std::map<std::int64_t, std::int32_t> code_to_row;
+  std::vector<std::int32_t> cell_to_row(num_cells);
+  std::vector<std::int32_t> representative_cell;
+  for (int cell = 0; cell < num_cells; ++cell)
+  {
+    std::int64_t code = 0;
+    for (int i = 0; i < num_orders; ++i)
+      code = code * radix[i] + cell_ordering(cell, i);
+
+    const auto [it, inserted] = code_to_row.insert(
+        {code, (std::int32_t)representative_cell.size()});
+    if (inserted)
+      representative_cell.push_back(cell);
+    cell_to_row[cell] = it->second;
+  }
+
+  // Compose each distinct permutation once
+  const std::int32_t num_distinct = representative_cell.size();
   Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> p(
-      cell_ordering.rows(), pcols);
+      num_distinct, pcols);
   for (int i = 0; i < pcols; ++i)
     p.col(i) = i;
 
-  // For each cell
   std::vector<int> temp(pcols);
-  for (int cell = 0; cell < cell_ordering.rows(); ++cell)
+  for (std::int32_t row = 0; row < num_distinct; ++row)
   {
+    const std::int32_t cell = representative_cell[row];
+
     // For each permutation in permutations
-    for (int i = 0; i < cell_ordering.cols(); ++i)
+    for (int i = 0; i < num_orders; ++i)
     {
       // cell_ordering(cell, i) says how many times this permutation
       // should be applied
@@ -347,13 +380,13 @@ fem::compute_dof_permutations(const mesh::Topology& topology,
         // This must be inside the loop as p changes after each
         // permutation
         for (int k = 0; k < pcols; ++k)
-          temp[k] = p(cell, k);
+          temp[k] = p(row, k);
         for (int k = 0; k < pcols; ++k)
-          p(cell, permutations(i, k)) = temp[k];
+          p(row, permutations(i, k)) = temp[k];
       }
     }
   }
 
-  return p;
+  return {std::move(p), std::move(cell_to_row)};
 }
 //-----------------------------------------------------------------------------
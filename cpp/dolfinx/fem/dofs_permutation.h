@@ -6,6 +6,7 @@
 
 #include <Eigen/Dense>
 #include <dolfinx/mesh/cell_types.h>
+#include <utility>
 #include <vector>
 
 namespace dolfinx
@@ -20,13 +21,20 @@ namespace fem
 {
 class ElementDofLayout;
 
-/// Return the dof permutations for all cells. Each row contains the
-/// numbers from 0 to (number of dofs on reference - 1) permuted so that
-/// edges are oriented towards the higher global vertex index
+/// Compute the dof permutations for all cells in compact form. Each
+/// permutation contains the numbers from 0 to (number of dofs on
+/// reference - 1) permuted so that edges are oriented towards the
+/// higher global vertex index. A mesh has only a small number of
+/// distinct cell orientations, so the distinct permutations are stored
+/// once and each cell holds an index into them, keeping the memory
+/// O(cells) rather than O(cells x dofs). Each distinct permutation is
+/// also composed only once, instead of once per cell.
 /// @param[in] topology The mesh topology
 /// @param[in] dof_layout The layout of dofs on a each cell
-/// @return The permutations
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+/// @return The pair (distinct permutations (one per row), map from
+///   cell to row of the distinct permutations)
+std::pair<Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+          std::vector<std::int32_t>>
 compute_dof_permutations(const mesh::Topology& topology,
                          const fem::ElementDofLayout& dof_layout);
 
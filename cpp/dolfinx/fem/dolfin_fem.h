@@ -11,12 +11,18 @@ namespace dolfinx
 
 // DOLFINX fem interface
 
+#include <dolfinx/fem/AssemblyTrace.h>
+#include <dolfinx/fem/AssemblyWorkspace.h>
+#include <dolfinx/fem/CoefficientQPCache.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DirichletBC.h>
 #include <dolfinx/fem/DiscreteOperators.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/FacetAssemblyPlan.h>
 #include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/GeometryFactors.h>
+#include <dolfinx/fem/MatrixFreeOperator.h>
 #include <dolfinx/fem/SparsityPatternBuilder.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/utils.h>
@@ -6,11 +6,13 @@
 
 #include "utils.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/fem/DiscreteOperators.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/DofMapBuilder.h>
 #include <dolfinx/fem/Form.h>
@@ -25,6 +27,7 @@
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/TopologyComputation.h>
 #include <memory>
+#include <mutex>
 #include <petscsys.h>
 #include <string>
 #include <ufc.h>
@@ -34,6 +37,21 @@ using namespace dolfinx;
 namespace
 {
 //-----------------------------------------------------------------------------
+// Process-wide cache of assembled sparsity patterns. The pattern of a
+// bilinear form depends only on the dofmap pair and the integral types
+// present, so forms sharing these (a, J, preconditioner forms) reuse
+// one pattern build. Entries are keyed on the dofmaps via weak
+// pointers; entries whose dofmaps have been destroyed are pruned on
+// every access.
+struct SparsityCacheEntry
+{
+  std::weak_ptr<const fem::DofMap> dofmap0, dofmap1;
+  std::array<bool, 3> integral_types;
+  std::shared_ptr<const la::SparsityPattern> pattern;
+};
+std::vector<SparsityCacheEntry> sparsity_cache;
+std::mutex sparsity_cache_mutex;
+//-----------------------------------------------------------------------------
 int get_num_permutations(const mesh::CellType cell_type)
 {
   // In general, this will return num_edges + 2*num_faces + 4*num_volumes
@@ -194,15 +212,51 @@ la::SparsityPattern dolfinx::fem::create_sparsity_pattern(const Form& a)
 //-----------------------------------------------------------------------------
 la::PETScMatrix dolfinx::fem::create_matrix(const Form& a)
 {
-  // Build sparsitypattern
-  la::SparsityPattern pattern = fem::create_sparsity_pattern(a);
+  std::shared_ptr<const DofMap> dofmap0 = a.function_space(0)->dofmap();
+  std::shared_ptr<const DofMap> dofmap1 = a.function_space(1)->dofmap();
+  const std::array<bool, 3> integral_types
+      = {a.integrals().num_integrals(fem::FormIntegrals::Type::cell) > 0,
+         a.integrals().num_integrals(fem::FormIntegrals::Type::interior_facet)
+             > 0,
+         a.integrals().num_integrals(fem::FormIntegrals::Type::exterior_facet)
+             > 0};
+
+  // Look for a matching assembled pattern in the cache, pruning
+  // entries whose dofmaps no longer exist
+  std::shared_ptr<const la::SparsityPattern> pattern;
+  {
+    std::lock_guard<std::mutex> lock(sparsity_cache_mutex);
+    sparsity_cache.erase(
+        std::remove_if(sparsity_cache.begin(), sparsity_cache.end(),
+                       [](const SparsityCacheEntry& e) {
+                         return e.dofmap0.expired() or e.dofmap1.expired();
+                       }),
+        sparsity_cache.end());
+    for (const SparsityCacheEntry& e : sparsity_cache)
+    {
+      if (e.dofmap0.lock() == dofmap0 and e.dofmap1.lock() == dofmap1
+          and e.integral_types == integral_types)
+      {
+        pattern = e.pattern;
+        break;
+      }
+    }
+  }
 
-  // Finalise communication
-  pattern.assemble();
+  if (!pattern)
+  {
+    // Build and finalise the sparsity pattern, and cache it
+    la::SparsityPattern p = fem::create_sparsity_pattern(a);
+    p.assemble();
+    pattern = std::make_shared<const la::SparsityPattern>(std::move(p));
+
+    std::lock_guard<std::mutex> lock(sparsity_cache_mutex);
+    sparsity_cache.push_back({dofmap0, dofmap1, integral_types, pattern});
+  }
 
   // Initialize matrix
   common::Timer t1("Init tensor");
-  la::PETScMatrix A(a.mesh()->mpi_comm(), pattern);
+  la::PETScMatrix A(a.mesh()->mpi_comm(), *pattern);
   t1.stop();
 
   return A;
@@ -416,6 +470,14 @@ fem::create_vector_nest(const std::vector<const common::IndexMap*>& maps)
   return la::PETScVector(y, false);
 }
 //-----------------------------------------------------------------------------
+la::PETScMatrix
+fem::create_interpolation_matrix(const function::FunctionSpace& V_src,
+                                 const function::FunctionSpace& V_dst)
+{
+  // Rows are the destination dofs, columns the source dofs
+  return DiscreteOperators::build_interpolation(V_dst, V_src);
+}
+//-----------------------------------------------------------------------------
 fem::ElementDofLayout
 fem::create_element_dof_layout(const ufc_dofmap& dofmap,
                                const mesh::CellType cell_type,
@@ -488,7 +550,8 @@ fem::create_element_dof_layout(const ufc_dofmap& dofmap,
 }
 //-----------------------------------------------------------------------------
 fem::DofMap fem::create_dofmap(MPI_Comm comm, const ufc_dofmap& ufc_dofmap,
-                               mesh::Topology& topology)
+                               mesh::Topology& topology,
+                               ReorderingStrategy reorder, bool implicit)
 {
   auto element_dof_layout = std::make_shared<ElementDofLayout>(
       create_element_dof_layout(ufc_dofmap, topology.cell_type()));
@@ -512,8 +575,23 @@ fem::DofMap fem::create_dofmap(MPI_Comm comm, const ufc_dofmap& ufc_dofmap,
     }
   }
 
+  if (implicit)
+  {
+    // Build the unexpanded node graph and compute cell dofs
+    // arithmetically, rather than storing the block-expanded list
+    const int bs = element_dof_layout->block_size();
+    auto [index_map, node_map] = DofMapBuilder::build(
+        comm, topology,
+        bs == 1 ? *element_dof_layout : *element_dof_layout->sub_dofmap({0}),
+        bs, reorder, false);
+    return DofMap(element_dof_layout, index_map,
+                  std::make_shared<graph::AdjacencyList<std::int32_t>>(
+                      std::move(node_map)),
+                  bs);
+  }
+
   auto [dof_layout, index_map, dofmap]
-      = DofMapBuilder::build(comm, topology, element_dof_layout);
+      = DofMapBuilder::build(comm, topology, element_dof_layout, reorder);
   return DofMap(dof_layout, index_map, std::move(dofmap));
 }
 //-----------------------------------------------------------------------------
@@ -700,6 +778,16 @@ fem::create_functionspace(ufc_function_space* (*fptr)(const char*),
 //-----------------------------------------------------------------------------
 Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 fem::pack_coefficients(const fem::Form& form)
+{
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> c;
+  pack_coefficients(form, c);
+  return c;
+}
+//-----------------------------------------------------------------------------
+void fem::pack_coefficients(
+    const fem::Form& form,
+    Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        c)
 {
   // Get form coefficient offsets amd dofmaps
   const fem::FormCoefficients& coefficients = form.coefficients();
@@ -727,15 +815,55 @@ fem::pack_coefficients(const fem::Form& form)
   const int num_cells = mesh->topology().index_map(tdim)->size_local()
                         + mesh->topology().index_map(tdim)->num_ghosts();
 
-  // Copy data into coefficient array
-  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> c(
-      num_cells, offsets.back());
+  // Detect spatially constant coefficients: when every entry of a
+  // coefficient vector holds the same value, each cell packs that same
+  // value, so the columns can be broadcast-filled without the per-cell
+  // dof gathers. (The coefficient cannot be moved to the constants
+  // array - which slot a generated kernel reads a symbol from is fixed
+  // at generation time.)
+  std::vector<bool> is_uniform(coefficients.size(), false);
+  std::vector<PetscScalar> uniform_value(coefficients.size(), 0.0);
+  for (std::size_t i = 0; i < v.size(); ++i)
+  {
+    PetscInt n = 0;
+    VecGetSize(x_local[i], &n);
+    if (n == 0)
+      continue;
+    const PetscScalar* _v = v[i];
+    bool uniform = true;
+    for (PetscInt k = 1; k < n; ++k)
+    {
+      if (_v[k] != _v[0])
+      {
+        uniform = false;
+        break;
+      }
+    }
+    is_uniform[i] = uniform;
+    uniform_value[i] = _v[0];
+  }
+
+  // Copy data into coefficient array. resize() is a no-op when the
+  // array already has the required shape, so the allocation is reused
+  // across repeated assembly calls.
+  c.resize(num_cells, offsets.back());
   if (coefficients.size() > 0)
   {
+    for (std::size_t coeff = 0; coeff < dofmaps.size(); ++coeff)
+    {
+      if (is_uniform[coeff])
+      {
+        c.middleCols(offsets[coeff], offsets[coeff + 1] - offsets[coeff])
+            .setConstant(uniform_value[coeff]);
+      }
+    }
+
     for (int cell = 0; cell < num_cells; ++cell)
     {
       for (std::size_t coeff = 0; coeff < dofmaps.size(); ++coeff)
       {
+        if (is_uniform[coeff])
+          continue;
         auto dofs = dofmaps[coeff]->cell_dofs(cell);
         const PetscScalar* _v = v[coeff];
         for (Eigen::Index k = 0; k < dofs.size(); ++k)
@@ -750,25 +878,111 @@ fem::pack_coefficients(const fem::Form& form)
     VecRestoreArrayRead(x_local[i], &v[i]);
     VecGhostRestoreLocalForm(x[i], &x_local[i]);
   }
+}
+//-----------------------------------------------------------------------------
+void fem::pack_coefficients(
+    const fem::Form& form,
+    Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        c,
+    std::vector<std::uint64_t>& versions)
+{
+  // Get the current state counter of each coefficient vector. PETSc
+  // bumps the object state whenever vector entries are modified.
+  const fem::FormCoefficients& coefficients = form.coefficients();
+  std::vector<std::uint64_t> current(coefficients.size());
+  for (int i = 0; i < coefficients.size(); ++i)
+  {
+    PetscObjectState state;
+    PetscObjectStateGet((PetscObject)coefficients.get(i)->vector().vec(),
+                        &state);
+    current[i] = state;
+  }
+
+  // Skip the pack when nothing changed since versions were recorded
+  // and the array has the shape required by this form
+  std::shared_ptr<const mesh::Mesh> mesh = form.mesh();
+  assert(mesh);
+  const int tdim = mesh->topology().dim();
+  const std::int32_t num_cells = mesh->topology().index_map(tdim)->size_local()
+                                 + mesh->topology().index_map(tdim)->num_ghosts();
+  if (c.rows() == num_cells and c.cols() == coefficients.offsets().back()
+      and current == versions)
+  {
+    return;
+  }
+
+  pack_coefficients(form, c);
+  versions = std::move(current);
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+fem::pack_coefficients_interior_facets(
+    const fem::Form& form,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const std::vector<std::int32_t>& active_facets)
+{
+  const std::vector<int>& offsets = form.coefficients().offsets();
+  assert(offsets.back() == coeffs.cols());
+
+  std::shared_ptr<const mesh::Mesh> mesh = form.mesh();
+  assert(mesh);
+  const int tdim = mesh->topology().dim();
+  mesh->topology_mutable().create_connectivity(tdim - 1, tdim);
+  auto f_to_c = mesh->topology().connectivity(tdim - 1, tdim);
+  assert(f_to_c);
+
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> c(
+      active_facets.size(), 2 * offsets.back());
+  for (std::size_t facet = 0; facet < active_facets.size(); ++facet)
+  {
+    auto cells = f_to_c->links(active_facets[facet]);
+    assert(cells.rows() == 2);
+    auto coeff_cell0 = coeffs.row(cells[0]);
+    auto coeff_cell1 = coeffs.row(cells[1]);
+
+    // Layout for the restricted coefficients is flattened
+    // w[coefficient][restriction][dof]
+    for (std::size_t i = 0; i < offsets.size() - 1; ++i)
+    {
+      const int num_entries = offsets[i + 1] - offsets[i];
+      c.row(facet).segment(2 * offsets[i], num_entries)
+          = coeff_cell0.segment(offsets[i], num_entries);
+      c.row(facet).segment(offsets[i + 1] + offsets[i], num_entries)
+          = coeff_cell1.segment(offsets[i], num_entries);
+    }
+  }
 
   return c;
 }
 //-----------------------------------------------------------------------------
 Eigen::Array<PetscScalar, Eigen::Dynamic, 1>
 fem::pack_constants(const fem::Form& form)
+{
+  Eigen::Array<PetscScalar, Eigen::Dynamic, 1> c;
+  pack_constants(form, c);
+  return c;
+}
+//-----------------------------------------------------------------------------
+void fem::pack_constants(const fem::Form& form,
+                         Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& c)
 {
   const std::vector<
       std::pair<std::string, std::shared_ptr<const function::Constant>>>
       constants = form.constants();
-  std::vector<PetscScalar> constant_values;
+
+  // Compute total size and resize (a no-op if already the right size)
+  std::int32_t size = 0;
+  for (const auto& constant : constants)
+    size += constant.second->value.size();
+  c.resize(size);
+
+  std::int32_t offset = 0;
   for (const auto& constant : constants)
   {
     const std::vector<PetscScalar>& array = constant.second->value;
-    constant_values.insert(constant_values.end(), array.data(),
-                           array.data() + array.size());
+    std::copy(array.begin(), array.end(), c.data() + offset);
+    offset += array.size();
   }
-
-  return Eigen::Map<const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>>(
-      constant_values.data(), constant_values.size(), 1);
 }
 //-----------------------------------------------------------------------------
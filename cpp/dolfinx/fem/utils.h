@@ -8,6 +8,7 @@
 
 #include "CoordinateElement.h"
 #include "DofMap.h"
+#include "DofMapBuilder.h"
 #include "ElementDofLayout.h"
 #include <dolfinx/common/types.h>
 #include <dolfinx/la/PETScMatrix.h>
@@ -90,6 +91,24 @@ la::PETScVector create_vector_block(
 la::PETScVector
 create_vector_nest(const std::vector<const common::IndexMap*>& maps);
 
+/// Build the sparse matrix A of the linear interpolation operator
+/// from @p V_src to @p V_dst, so that for \f$w \in V_{src}\f$ with
+/// coefficient vector x, y = Ax is the coefficient vector of the
+/// interpolant of w in \f$V_{dst}\f$. Repeated transfer between the
+/// same pair of spaces (e.g. every time step, or the prolongation of
+/// a geometric multigrid hierarchy between nested spaces) is then a
+/// single matrix-vector product instead of a full
+/// Function::interpolate pass. See
+/// DiscreteOperators::build_interpolation for the supported elements:
+/// both spaces on the same mesh, scalar identity-mapped elements with
+/// point-evaluation dofs.
+/// @param[in] V_src Space interpolated from (matrix columns)
+/// @param[in] V_dst Space interpolated into (matrix rows)
+/// @return The interpolation matrix
+la::PETScMatrix
+create_interpolation_matrix(const function::FunctionSpace& V_src,
+                            const function::FunctionSpace& V_dst);
+
 /// Create an ElementDofLayout from a ufc_dofmap
 ElementDofLayout create_element_dof_layout(const ufc_dofmap& dofmap,
                                            const mesh::CellType cell_type,
@@ -100,8 +119,15 @@ ElementDofLayout create_element_dof_layout(const ufc_dofmap& dofmap,
 /// @param[in] comm MPI communicator
 /// @param[in] dofmap The ufc_dofmap
 /// @param[in] topology The mesh topology
+/// @param[in] reorder The re-ordering strategy for owned dofs
+/// @param[in] implicit If true, build an implicit (unexpanded) dofmap
+///   where cell dofs are computed arithmetically from the node graph
+///   rather than stored. Implicit maps support only the filling
+///   cell_dofs overload - see DofMap.
 DofMap create_dofmap(MPI_Comm comm, const ufc_dofmap& dofmap,
-                     mesh::Topology& topology);
+                     mesh::Topology& topology,
+                     ReorderingStrategy reorder = ReorderingStrategy::scotch,
+                     bool implicit = false);
 
 /// Create a form from a form_create function returning a pointer to a
 /// ufc_form, taking care of memory allocation
@@ -159,10 +185,71 @@ create_functionspace(ufc_function_space* (*fptr)(const char*),
 Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 pack_coefficients(const fem::Form& form);
 
+// NOTE: This is subject to change
+/// Pack form coefficients ready for assembly into a caller-provided
+/// array, reusing its allocation when already of the required size
+/// @param[in] form The form to pack coefficients for
+/// @param[in,out] c Array to pack into. Resized if required.
+void pack_coefficients(
+    const fem::Form& form,
+    Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        c);
+
+// NOTE: This is subject to change
+/// Pack form coefficients ready for assembly, skipping the pack when no
+/// coefficient has changed since the versions were recorded. The
+/// version of each coefficient is the PETSc object state of its vector,
+/// which PETSc increments on every modification. On return c holds the
+/// packed coefficients and versions the matching vector states.
+/// @param[in] form The form to pack coefficients for
+/// @param[in,out] c Array to pack into. Left untouched if versions
+///                  match.
+/// @param[in,out] versions Recorded coefficient vector versions.
+///                         Pass the same vector on each call; an empty
+///                         vector forces a pack.
+void pack_coefficients(
+    const fem::Form& form,
+    Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        c,
+    std::vector<std::uint64_t>& versions);
+
+// NOTE: This is subject to change
+/// Re-pack cell-major coefficients in facet-pair-major layout for
+/// interior facet assembly. The cell-major layout of pack_coefficients
+/// suits cell and exterior facet kernels, which read one contiguous
+/// row per cell. Interior facet kernels need the coefficients of both
+/// attached cells interleaved per coefficient, and gathering them from
+/// two strided cell rows for every facet thrashes in the assembly
+/// loop. This packs one row per facet of an interior facet integral,
+/// already in the flattened w[coefficient][restriction][dof] layout
+/// the kernels expect, so each kernel call reads a single contiguous
+/// stream.
+/// @param[in] form The form the coefficients belong to
+/// @param[in] coeffs Cell-major packed coefficients, as returned by
+///   pack_coefficients
+/// @param[in] active_facets The facets of the interior facet integral,
+///   in assembly order
+/// @return Array with one row per facet in @p active_facets and width
+///   twice the total coefficient size
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+pack_coefficients_interior_facets(
+    const fem::Form& form,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const std::vector<std::int32_t>& active_facets);
+
 // NOTE: This is subject to change
 /// Pack form constants ready for assembly
 Eigen::Array<PetscScalar, Eigen::Dynamic, 1>
 pack_constants(const fem::Form& form);
 
+// NOTE: This is subject to change
+/// Pack form constants ready for assembly into a caller-provided array,
+/// reusing its allocation when already of the required size
+/// @param[in] form The form to pack constants for
+/// @param[in,out] c Array to pack into. Resized if required.
+void pack_constants(const fem::Form& form,
+                    Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& c);
+
 } // namespace fem
 } // namespace dolfinx
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <cstddef>
 #include <petscsys.h>
 #include <vector>
 
@@ -37,5 +38,18 @@ public:
 
   /// Values, stored as a flattened array.
   std::vector<PetscScalar> value;
+
+  /// Version counter for dependency tracking (see
+  /// Form::is_up_to_date). The value array is public, so the counter
+  /// cannot advance automatically; call mark_modified() after
+  /// changing value.
+  std::size_t version() const { return _version; }
+
+  /// Advance the version counter. Call after modifying value.
+  void mark_modified() { ++_version; }
+
+private:
+  // Version counter
+  std::size_t _version = 0;
 };
 } // namespace dolfinx::function
@@ -0,0 +1,163 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "FieldStatistics.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/la/PETScVector.h>
+#include <dolfinx/la/utils.h>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace dolfinx;
+using namespace dolfinx::function;
+
+//-----------------------------------------------------------------------------
+FieldStatistics::FieldStatistics(std::shared_ptr<const Function> u,
+                                 const std::vector<Statistic>& statistics)
+    : _u(u)
+{
+  assert(_u);
+  assert(_u->function_space());
+  assert(_u->function_space()->dofmap());
+  const auto map = _u->function_space()->dofmap()->index_map;
+  assert(map);
+  const std::int32_t n = map->block_size() * map->size_local();
+
+  for (const Statistic s : statistics)
+  {
+    switch (s)
+    {
+    case Statistic::mean:
+      _sum.resize(n, 0.0);
+      break;
+    case Statistic::rms:
+      _sum2.resize(n, 0.0);
+      break;
+    case Statistic::min:
+      _min.resize(n, std::numeric_limits<double>::max());
+      break;
+    case Statistic::max:
+      _max.resize(n, std::numeric_limits<double>::lowest());
+      break;
+    case Statistic::third_moment:
+      _sum3.resize(n, 0.0);
+      break;
+    case Statistic::fourth_moment:
+      _sum4.resize(n, 0.0);
+      break;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void FieldStatistics::update()
+{
+  la::VecReadWrapper x(_u->vector().vec(), false);
+  const std::int32_t n = x.x.size();
+
+  // One fused pass over the owned entries. The per-statistic branches
+  // are loop-invariant and perfectly predicted, so the pass stays
+  // memory-bound regardless of how many statistics are registered.
+  const bool need_sum = !_sum.empty();
+  const bool need_sum2 = !_sum2.empty();
+  const bool need_sum3 = !_sum3.empty();
+  const bool need_sum4 = !_sum4.empty();
+  const bool need_min = !_min.empty();
+  const bool need_max = !_max.empty();
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    const PetscScalar v = x.x[i];
+    const double vr = std::real(v);
+    if (need_sum)
+      _sum[i] += v;
+    if (need_sum2)
+      _sum2[i] += std::norm(v);
+    if (need_min)
+      _min[i] = std::min(_min[i], vr);
+    if (need_max)
+      _max[i] = std::max(_max[i], vr);
+    if (need_sum3)
+      _sum3[i] += vr * vr * vr;
+    if (need_sum4)
+    {
+      const double v2 = vr * vr;
+      _sum4[i] += v2 * v2;
+    }
+  }
+
+  x.restore();
+  ++_num_steps;
+}
+//-----------------------------------------------------------------------------
+Function FieldStatistics::compute(Statistic statistic) const
+{
+  if (_num_steps == 0)
+    throw std::runtime_error("No time steps have been accumulated.");
+
+  auto check_registered = [](const auto& buffer) {
+    if (buffer.empty())
+    {
+      throw std::runtime_error(
+          "Statistic was not registered with FieldStatistics.");
+    }
+  };
+
+  Function f(_u->function_space());
+  la::VecWrapper y(f.vector().vec());
+  const double inv_n = 1.0 / double(_num_steps);
+  std::string suffix;
+  switch (statistic)
+  {
+  case Statistic::mean:
+    check_registered(_sum);
+    for (std::size_t i = 0; i < _sum.size(); ++i)
+      y.x[i] = _sum[i] * inv_n;
+    suffix = "mean";
+    break;
+  case Statistic::rms:
+    check_registered(_sum2);
+    for (std::size_t i = 0; i < _sum2.size(); ++i)
+      y.x[i] = std::sqrt(_sum2[i] * inv_n);
+    suffix = "rms";
+    break;
+  case Statistic::min:
+    check_registered(_min);
+    for (std::size_t i = 0; i < _min.size(); ++i)
+      y.x[i] = _min[i];
+    suffix = "min";
+    break;
+  case Statistic::max:
+    check_registered(_max);
+    for (std::size_t i = 0; i < _max.size(); ++i)
+      y.x[i] = _max[i];
+    suffix = "max";
+    break;
+  case Statistic::third_moment:
+    check_registered(_sum3);
+    for (std::size_t i = 0; i < _sum3.size(); ++i)
+      y.x[i] = _sum3[i] * inv_n;
+    suffix = "moment3";
+    break;
+  case Statistic::fourth_moment:
+    check_registered(_sum4);
+    for (std::size_t i = 0; i < _sum4.size(); ++i)
+      y.x[i] = _sum4[i] * inv_n;
+    suffix = "moment4";
+    break;
+  }
+  y.restore();
+  f.vector().update_ghosts();
+  f.name = _u->name + "_" + suffix;
+  return f;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,94 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace function
+{
+class Function;
+
+/// In-situ accumulation of pointwise time statistics of a Function.
+/// Register the statistics of interest at construction, call update()
+/// once per time step (a single fused pass over the owned PETSc Vec
+/// entries) and finalize the accumulated fields once at the end of the
+/// run, e.g. for writing through XDMFFile::write_function. This
+/// replaces writing the full field every step and averaging offline.
+class FieldStatistics
+{
+public:
+  /// Pointwise statistics that can be accumulated. For complex scalar
+  /// types the mean is complex; the other statistics are computed from
+  /// the magnitude (rms) or real part (min, max, moments).
+  enum class Statistic : int
+  {
+    mean = 0,          ///< Time average
+    rms = 1,           ///< Root-mean-square over time
+    min = 2,           ///< Pointwise minimum over time
+    max = 3,           ///< Pointwise maximum over time
+    third_moment = 4,  ///< Time average of the cubed value
+    fourth_moment = 5  ///< Time average of the fourth power
+  };
+
+  /// Create an accumulator for a Function
+  /// @param[in] u The Function to track. The accumulator reads the
+  ///   current Vec values on each update() call.
+  /// @param[in] statistics The statistics to accumulate. Only the
+  ///   requested accumulator buffers are allocated.
+  FieldStatistics(std::shared_ptr<const Function> u,
+                  const std::vector<Statistic>& statistics);
+
+  // Copy constructor
+  FieldStatistics(const FieldStatistics& s) = delete;
+
+  /// Move constructor
+  FieldStatistics(FieldStatistics&& s) = default;
+
+  /// Destructor
+  ~FieldStatistics() = default;
+
+  // Assignment
+  FieldStatistics& operator=(const FieldStatistics& s) = delete;
+
+  /// Move assignment
+  FieldStatistics& operator=(FieldStatistics&& s) = default;
+
+  /// Accumulate the current values of the tracked Function. Call once
+  /// per time step. All registered statistics are updated in one pass
+  /// over the owned Vec entries.
+  void update();
+
+  /// Number of steps accumulated so far
+  std::int64_t num_steps() const { return _num_steps; }
+
+  /// Finalize a statistic into a Function on the same function space.
+  /// The ghost values of the result are up to date, so it can be
+  /// written directly. The result is named "<u.name>_<statistic>".
+  /// @param[in] statistic The statistic to finalize. Must have been
+  ///   registered at construction.
+  /// @return The finalized statistic field
+  Function compute(Statistic statistic) const;
+
+private:
+  // Tracked function
+  std::shared_ptr<const Function> _u;
+
+  // Number of update() calls
+  std::int64_t _num_steps = 0;
+
+  // Accumulator buffers over the owned Vec entries. A buffer is empty
+  // when the corresponding statistic was not registered.
+  std::vector<PetscScalar> _sum;
+  std::vector<double> _sum2, _sum3, _sum4, _min, _max;
+};
+} // namespace function
+} // namespace dolfinx
@@ -5,7 +5,9 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "Function.h"
+#include <algorithm>
 #include <cfloat>
+#include <numeric>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
@@ -267,6 +269,154 @@ void Function::eval(
   }
 }
 //-----------------------------------------------------------------------------
+void Function::eval_batched(
+    const Eigen::Ref<
+        const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>& x,
+    const Eigen::Ref<const Eigen::Array<int, Eigen::Dynamic, 1>>& cells,
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>>
+        u) const
+{
+  if (x.rows() != cells.rows())
+  {
+    throw std::runtime_error(
+        "Number of points and number of cells must be equal.");
+  }
+  if (x.rows() != u.rows())
+  {
+    throw std::runtime_error("Length of array for Function values must be the "
+                             "same as the number of points.");
+  }
+
+  // Get mesh
+  assert(_function_space);
+  std::shared_ptr<const mesh::Mesh> mesh = _function_space->mesh();
+  assert(mesh);
+  const int gdim = mesh->geometry().dim();
+  const int tdim = mesh->topology().dim();
+
+  // Get geometry data
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh->geometry().x();
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+
+  // Get coordinate map
+  const fem::CoordinateElement& cmap = mesh->geometry().cmap();
+
+  // Get element
+  assert(_function_space->element());
+  std::shared_ptr<const fem::FiniteElement> element
+      = _function_space->element();
+  assert(element);
+  const int reference_value_size = element->reference_value_size();
+  const int value_size = element->value_size();
+  const int space_dimension = element->space_dimension();
+
+  // Get dofmap
+  std::shared_ptr<const fem::DofMap> dofmap = _function_space->dofmap();
+  assert(dofmap);
+
+  mesh->topology_mutable().create_entity_permutations();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  // Group points by containing cell: sort the point indices (of points
+  // with a non-negative cell index) by cell, so that each cell's points
+  // form a contiguous run
+  std::vector<Eigen::Index> point_indices;
+  point_indices.reserve(cells.rows());
+  for (Eigen::Index p = 0; p < cells.rows(); ++p)
+  {
+    if (cells(p) >= 0)
+      point_indices.push_back(p);
+  }
+  std::sort(point_indices.begin(), point_indices.end(),
+            [&cells](Eigen::Index p0, Eigen::Index p1) {
+              return cells(p0) < cells(p1);
+            });
+
+  u.setZero();
+  la::VecReadWrapper v(_vector.vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _v = v.x;
+
+  // Geometry, basis and coefficient scratch, resized per cell to the
+  // number of points in the cell
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J;
+  Eigen::Array<double, Eigen::Dynamic, 1> detJ;
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K;
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> X;
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values;
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values;
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> xp;
+  Eigen::Matrix<PetscScalar, 1, Eigen::Dynamic> coefficients(space_dimension);
+
+  // Loop over runs of points sharing a cell
+  std::size_t start = 0;
+  while (start < point_indices.size())
+  {
+    const int cell_index = cells(point_indices[start]);
+    std::size_t stop = start + 1;
+    while (stop < point_indices.size()
+           and cells(point_indices[stop]) == cell_index)
+    {
+      ++stop;
+    }
+    const Eigen::Index num_points_c = stop - start;
+
+    // Get cell geometry (coordinate dofs), once for all points in the
+    // cell
+    auto x_dofs = x_dofmap.links(cell_index);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+    // Gather the physical coordinates of the cell's points
+    xp.resize(num_points_c, gdim);
+    for (Eigen::Index k = 0; k < num_points_c; ++k)
+      xp.row(k) = x.row(point_indices[start + k]).head(gdim);
+
+    // Compute reference coordinates X, and J, detJ and K for all of the
+    // cell's points together
+    X.resize(num_points_c, tdim);
+    J.resize(num_points_c, gdim, tdim);
+    detJ.resize(num_points_c);
+    K.resize(num_points_c, tdim, gdim);
+    cmap.compute_reference_geometry(X, J, detJ, K, xp, coordinate_dofs);
+
+    // Compute basis on reference element for all points, and push
+    // forward to the physical element
+    basis_reference_values.resize(num_points_c, space_dimension,
+                                  reference_value_size);
+    element->evaluate_reference_basis(basis_reference_values, X);
+    basis_values.resize(num_points_c, space_dimension, value_size);
+    element->transform_reference_basis(basis_values, basis_reference_values, X,
+                                       J, detJ, K, cell_info[cell_index]);
+
+    // Get degrees of freedom for current cell, once for all points
+    auto dofs = dofmap->cell_dofs(cell_index);
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+      coefficients[i] = _v[dofs[i]];
+
+    // Compute expansion: u(p, j) = sum_i coefficients[i] * basis(p, i, j)
+    for (Eigen::Index k = 0; k < num_points_c; ++k)
+    {
+      Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor>>
+          basis_p(basis_values.data() + k * space_dimension * value_size,
+                  space_dimension, value_size);
+      u.row(point_indices[start + k])
+          = (coefficients * basis_p.cast<PetscScalar>()).array();
+    }
+
+    start = stop;
+  }
+}
+//-----------------------------------------------------------------------------
 void Function::interpolate(const Function& v)
 {
   assert(_function_space);
@@ -375,3 +525,44 @@ Function::compute_point_values() const
 //-----------------------------------------------------------------------------
 std::size_t Function::id() const { return _id; }
 //-----------------------------------------------------------------------------
+std::size_t Function::version() const
+{
+  // PETSc already tracks modifications of the vector through the
+  // object state counter, so reuse it rather than maintaining a
+  // parallel counter that every write path would have to bump
+  PetscObjectState state = 0;
+  PetscErrorCode ierr
+      = PetscObjectStateGet((PetscObject)_vector.vec(), &state);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "PetscObjectStateGet");
+  return static_cast<std::size_t>(state);
+}
+//-----------------------------------------------------------------------------
+void function::move_mesh(mesh::Mesh& mesh, const Function& displacement)
+{
+  assert(displacement.function_space());
+  if (displacement.function_space()->mesh().get() != &mesh)
+  {
+    throw std::runtime_error(
+        "Displacement function must be defined on the mesh being moved.");
+  }
+  const int gdim = mesh.geometry().dim();
+  if (displacement.value_size() != gdim)
+  {
+    throw std::runtime_error("Displacement value size does not match the "
+                             "geometric dimension.");
+  }
+
+  // One row per geometry node, zero-padded to the 3D coordinate layout
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      values = displacement.compute_point_values();
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> dx(values.rows(), 3);
+  dx.setZero();
+  for (Eigen::Index i = 0; i < values.rows(); ++i)
+    for (int d = 0; d < gdim; ++d)
+      dx(i, d) = std::real(values(i, d));
+
+  mesh.move(dx);
+}
+//-----------------------------------------------------------------------------
@@ -144,6 +144,28 @@ public:
                                Eigen::RowMajor>>
            u) const;
 
+  /// Evaluate the Function at points, grouping points by containing
+  /// cell. For each cell the geometry and degrees-of-freedom are
+  /// gathered once and the basis functions are tabulated for all of the
+  /// cell's points together, so this is considerably faster than eval()
+  /// when many points share cells. Results are identical to eval().
+  /// @param[in] x The coordinates of the points. It has shape
+  ///              (num_points, 3).
+  /// @param[in] cells An array of cell indices. cells[i] is the index
+  ///                  of the cell that contains the point x(i).
+  ///                  Negative cell indices can be passed, and the
+  ///                  corresponding point will be ignored.
+  /// @param[in,out] u The values at the points. Values are not computed
+  ///                  for points with a negative cell index. This
+  ///                  argument must be passed with the correct size.
+  void eval_batched(
+      const Eigen::Ref<
+          const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>& x,
+      const Eigen::Ref<const Eigen::Array<int, Eigen::Dynamic, 1>>& cells,
+      Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                              Eigen::RowMajor>>
+          u) const;
+
   /// Compute values at all mesh points
   /// @return The values at all geometric points
   Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -155,6 +177,12 @@ public:
   /// ID
   std::size_t id() const;
 
+  /// Version of the expansion coefficients, for dependency tracking
+  /// (see Form::is_up_to_date). The counter advances whenever the
+  /// underlying PETSc vector is modified, so no manual bookkeeping is
+  /// required.
+  std::size_t version() const;
+
 private:
   // ID
   std::size_t _id;
@@ -165,5 +193,18 @@ private:
   // The vector of expansion coefficients (local)
   la::PETScVector _vector;
 };
+
+/// Displace a mesh by a vector-valued function, e.g. one step of an
+/// ALE scheme. The function is evaluated at every geometry node and
+/// added to the node coordinates through mesh::Mesh::move, so the
+/// geometry version advances and the mesh's registered geometry-update
+/// callbacks fire. In complex builds the real part of the displacement
+/// is applied.
+/// @param[in,out] mesh The mesh to move. Must be the mesh of the
+///   function's space.
+/// @param[in] displacement The displacement, with value size equal to
+///   the geometric dimension
+void move_mesh(mesh::Mesh& mesh, const Function& displacement);
+
 } // namespace function
 } // namespace dolfinx
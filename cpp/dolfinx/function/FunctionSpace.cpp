@@ -6,6 +6,7 @@
 
 #include "FunctionSpace.h"
 #include "Function.h"
+#include <algorithm>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
 #include <dolfinx/common/types.h>
@@ -17,6 +18,7 @@
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <vector>
 
 using namespace dolfinx;
@@ -65,12 +67,6 @@ void FunctionSpace::interpolate_from_any(
     const Function& v) const
 {
   assert(v.function_space());
-  if (!v.function_space()->has_element(*_element))
-  {
-    throw std::runtime_error("Restricting finite elements function in "
-                             "different elements not supported.");
-  }
-
   assert(_mesh);
   assert(v.function_space()->mesh());
   if (_mesh->id() != v.function_space()->mesh()->id())
@@ -79,6 +75,14 @@ void FunctionSpace::interpolate_from_any(
         "Interpolation on different meshes not supported (yet).");
   }
 
+  // Same mesh, but different elements: interpolate via a local
+  // reference-element interpolation matrix
+  if (!v.function_space()->has_element(*_element))
+  {
+    interpolate_same_mesh(expansion_coefficients, v);
+    return;
+  }
+
   const int tdim = _mesh->topology().dim();
 
   // Get dofmaps
@@ -104,6 +108,148 @@ void FunctionSpace::interpolate_from_any(
   }
 }
 //-----------------------------------------------------------------------------
+void FunctionSpace::interpolate_same_mesh(
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>>
+        expansion_coefficients,
+    const Function& v) const
+{
+  assert(_element);
+  assert(v.function_space());
+  std::shared_ptr<const fem::FiniteElement> element_v
+      = v.function_space()->element();
+  assert(element_v);
+
+  // The dofs of this element must be point evaluations at known
+  // reference coordinates, and both elements must be scalar valued
+  // (identity pull-back), so that the local interpolation matrix can
+  // be built from reference element data alone
+  if (!_element->has_dof_reference_coordinates())
+  {
+    throw std::runtime_error(
+        "Interpolation between different elements requires dof reference "
+        "coordinates for the target element.");
+  }
+  if (_element->value_size() != 1 or _element->reference_value_size() != 1
+      or element_v->value_size() != 1
+      or element_v->reference_value_size() != 1)
+  {
+    throw std::runtime_error("Interpolation between different elements is "
+                             "supported for scalar elements only.");
+  }
+
+  // The dof reference coordinates are tabulated in reference dof
+  // order. The target element's dof permutations must be the identity
+  // for the matrix rows to match the cell dofs.
+  assert(_dofmap);
+  assert(_dofmap->element_dof_layout);
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      base_perm = _dofmap->element_dof_layout->base_permutations();
+  for (Eigen::Index i = 0; i < base_perm.rows(); ++i)
+  {
+    for (Eigen::Index j = 0; j < base_perm.cols(); ++j)
+    {
+      if (base_perm(i, j) != j)
+      {
+        throw std::runtime_error(
+            "Interpolation between different elements is not supported for "
+            "target elements with permuted dofs.");
+      }
+    }
+  }
+
+  assert(_mesh);
+  const int tdim = _mesh->topology().dim();
+  const int gdim = _mesh->geometry().dim();
+  const int num_dofs = _element->space_dimension();
+  const int num_dofs_v = element_v->space_dimension();
+
+  // Reference coordinates of this element's dofs
+  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      X = _element->dof_reference_coordinates();
+  assert(X.rows() == num_dofs);
+
+  // Tabulate the source basis at the dof points of this element, once
+  // for all cells
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+      num_dofs, num_dofs_v, 1);
+  element_v->evaluate_reference_basis(basis_reference_values, X);
+
+  // Identity geometry data. The push-forward of identity-mapped
+  // (scalar) basis functions does not depend on the cell geometry, but
+  // it may apply the cell's dof permutations.
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_dofs, gdim, tdim);
+  J.setZero();
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_dofs, tdim, gdim);
+  K.setZero();
+  const int dim_min = gdim < tdim ? gdim : tdim;
+  for (int p = 0; p < num_dofs; ++p)
+  {
+    for (int i = 0; i < dim_min; ++i)
+    {
+      J(p, i, i) = 1.0;
+      K(p, i, i) = 1.0;
+    }
+  }
+  const Eigen::Array<double, Eigen::Dynamic, 1> detJ
+      = Eigen::Array<double, Eigen::Dynamic, 1>::Ones(num_dofs);
+
+  _mesh->topology_mutable().create_entity_permutations();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = _mesh->topology().get_cell_permutation_info();
+
+  // Local interpolation matrices, one per distinct cell permutation. A
+  // mesh has only a few distinct permutations, so each matrix is built
+  // once and re-used as a small matrix-vector product per cell.
+  std::map<std::uint32_t, Eigen::Matrix<PetscScalar, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>
+      M_cache;
+
+  std::shared_ptr<const fem::DofMap> dofmap_v = v.function_space()->dofmap();
+  assert(dofmap_v);
+  la::VecReadWrapper v_vector_wrap(v.vector().vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> v_array
+      = v_vector_wrap.x;
+
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> coefficients_v(num_dofs_v);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> coefficients(num_dofs);
+
+  // Iterate over mesh and interpolate on each cell (using last
+  // computed value if the source is not continuous, e.g. discontinuous
+  // Galerkin methods)
+  auto map = _mesh->topology().index_map(tdim);
+  assert(map);
+  const int num_cells = map->size_local() + map->num_ghosts();
+  for (int c = 0; c < num_cells; ++c)
+  {
+    auto it = M_cache.find(cell_info[c]);
+    if (it == M_cache.end())
+    {
+      // Push the source basis forward with this cell's permutations
+      Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(num_dofs,
+                                                             num_dofs_v, 1);
+      element_v->transform_reference_basis(basis_values,
+                                           basis_reference_values, X, J, detJ,
+                                           K, cell_info[c]);
+      Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                    Eigen::RowMajor>
+          M(num_dofs, num_dofs_v);
+      for (int i = 0; i < num_dofs; ++i)
+        for (int j = 0; j < num_dofs_v; ++j)
+          M(i, j) = basis_values(i, j, 0);
+      it = M_cache.emplace(cell_info[c], std::move(M)).first;
+    }
+
+    auto dofs_v = dofmap_v->cell_dofs(c);
+    auto dofs = _dofmap->cell_dofs(c);
+    for (Eigen::Index i = 0; i < dofs_v.size(); ++i)
+      coefficients_v[i] = v_array[dofs_v[i]];
+
+    coefficients = it->second * coefficients_v;
+    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+      expansion_coefficients[dofs[i]] = coefficients[i];
+  }
+}
+//-----------------------------------------------------------------------------
 void FunctionSpace::interpolate(
     Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>>
         expansion_coefficients,
@@ -147,44 +293,142 @@ void FunctionSpace::interpolate(
         const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
                                             Eigen::RowMajor>>&)>& f) const
 {
-  // Evaluate expression at dof points
-  const Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor> x
-      = tabulate_dof_coordinates().transpose();
-  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
-                     Eigen::RowMajor>
-      values = f(x);
-
+  assert(_mesh);
   assert(_element);
+  assert(_dofmap);
+
+  if (!_component.empty())
+  {
+    throw std::runtime_error(
+        "Cannot tabulate coordinates for a FunctionSpace that is a subspace.");
+  }
+
+  const int gdim = _mesh->geometry().dim();
+  const int tdim = _mesh->topology().dim();
+
   std::vector<int> vshape(_element->value_rank(), 1);
   for (std::size_t i = 0; i < vshape.size(); ++i)
     vshape[i] = _element->value_dimension(i);
   const int value_size = std::accumulate(std::begin(vshape), std::end(vshape),
                                          1, std::multiplies<>());
 
-  // Note: pybind11 maps 1D NumPy arrays to column vectors for
-  // Eigen::Array<PetscScalar, Eigen::Dynamic,Eigen::Dynamic, Eigen::RowMajor>
-  // types, therefore we need to handle vectors as a special case.
-  if (values.cols() == 1 and values.rows() != 1)
+  // Dof coordinates on reference element
+  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      X = _element->dof_reference_coordinates();
+
+  // Get coordinate map and cell geometry
+  const fem::CoordinateElement& cmap = _mesh->geometry().cmap();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = _mesh->geometry().dofmap();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      x_g
+      = _mesh->geometry().x();
+
+  // Stream fixed-size coordinate tiles through the expression rather
+  // than materializing the full 3 x num_dofs coordinate array and
+  // value array: cell dof coordinates are tabulated a block of cells
+  // at a time, the expression is evaluated on the tile and the
+  // coefficients are written directly into the function vector. Dofs
+  // shared between cells are evaluated once per touching cell, but the
+  // values are identical and the peak memory no longer scales with the
+  // space dimension.
+  const int ndofs_cell = _element->space_dimension();
+  const int cells_per_block = std::max(1, 2048 / ndofs_cell);
+
+  // Tile work arrays
+  Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor> x_tile
+      = Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor>::Zero(
+          3, cells_per_block * ndofs_cell);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinates(ndofs_cell, gdim);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values_cell(ndofs_cell, value_size);
+  std::vector<PetscScalar> cell_coefficients(
+      _dofmap->element_dof_layout->num_dofs());
+
+  // FIXME: Dummy coordinate dofs - should limit the interpolation to
+  // Lagrange, in which case we don't need coordinate dofs in
+  // FiniteElement::transform_values.
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      dummy_coordinate_dofs;
+
+  auto map = _mesh->topology().index_map(tdim);
+  assert(map);
+  const int num_cells = map->size_local() + map->num_ghosts();
+  for (int c0 = 0; c0 < num_cells; c0 += cells_per_block)
   {
-    if (values.rows() != x.cols())
+    const int num_cells_block = std::min(cells_per_block, num_cells - c0);
+    const int num_points = num_cells_block * ndofs_cell;
+
+    // Tabulate dof coordinates for the cells of this block
+    for (int b = 0; b < num_cells_block; ++b)
     {
-      throw std::runtime_error("Number of computed values is not equal to the "
-                               "number of evaluation points. (1)");
+      auto x_dofs = x_dofmap.links(c0 + b);
+      for (int i = 0; i < num_dofs_g; ++i)
+        coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+      cmap.push_forward(coordinates, X, coordinate_dofs);
+      for (int i = 0; i < ndofs_cell; ++i)
+      {
+        x_tile.col(b * ndofs_cell + i).head(gdim)
+            = coordinates.row(i).transpose();
+      }
     }
-    interpolate(coefficients, values);
-  }
-  else
-  {
-    if (values.rows() != value_size)
-      throw std::runtime_error("Values shape is incorrect. (2)");
 
-    if (values.cols() != x.cols())
+    // Evaluate expression on the tile
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>
+        values = f(x_tile.leftCols(num_points));
+
+    // Note: pybind11 maps 1D NumPy arrays to column vectors for
+    // Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+    // Eigen::RowMajor> types, therefore we need to handle vectors as a
+    // special case.
+    const bool vector_values = values.cols() == 1 and values.rows() != 1;
+    if (vector_values)
+    {
+      if (values.rows() != num_points)
+      {
+        throw std::runtime_error("Number of computed values is not equal to "
+                                 "the number of evaluation points. (1)");
+      }
+    }
+    else
     {
-      throw std::runtime_error("Number of computed values is not equal to the "
-                               "number of evaluation points. (2)");
+      if (values.rows() != value_size)
+        throw std::runtime_error("Values shape is incorrect. (2)");
+      if (values.cols() != num_points)
+      {
+        throw std::runtime_error("Number of computed values is not equal to "
+                                 "the number of evaluation points. (2)");
+      }
     }
 
-    interpolate(coefficients, values.transpose());
+    // Map values to expansion coefficients, cell by cell
+    for (int b = 0; b < num_cells_block; ++b)
+    {
+      for (int i = 0; i < ndofs_cell; ++i)
+      {
+        if (vector_values)
+          values_cell(i, 0) = values(b * ndofs_cell + i, 0);
+        else
+        {
+          for (int j = 0; j < value_size; ++j)
+            values_cell(i, j) = values(j, b * ndofs_cell + i);
+        }
+      }
+
+      _element->transform_values(cell_coefficients.data(), values_cell,
+                                 dummy_coordinate_dofs);
+
+      auto cell_dofs = _dofmap->cell_dofs(c0 + b);
+      for (Eigen::Index i = 0; i < cell_dofs.rows(); ++i)
+        coefficients[cell_dofs[i]] = cell_coefficients[i];
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -217,12 +461,10 @@ FunctionSpace::sub(const std::vector<int>& component) const
   assert(_element);
   assert(_dofmap);
 
-  // Check if sub space is already in the cache and not expired
+  // Check if sub space is already in the cache. Spaces are immutable,
+  // so a cached subspace never goes stale and is returned directly
   if (auto it = _subspaces.find(component); it != _subspaces.end())
-  {
-    if (auto s = it->second.lock())
-      return s;
-  }
+    return it->second;
 
   // Extract sub-element
   std::shared_ptr<const fem::FiniteElement> element
@@ -241,9 +483,9 @@ FunctionSpace::sub(const std::vector<int>& component) const
   sub_space->_component.insert(sub_space->_component.end(), component.begin(),
                                component.end());
 
-  // Insert new subspace into cache
-  _subspaces.insert(std::pair<std::vector<int>, std::shared_ptr<FunctionSpace>>(
-      sub_space->_component, sub_space));
+  // Insert new subspace into cache, keyed by the component relative to
+  // this space (the lookup key above)
+  _subspaces.insert({component, sub_space});
 
   return sub_space;
 }
@@ -254,23 +496,114 @@ FunctionSpace::collapse() const
   if (_component.empty())
     throw std::runtime_error("Function space is not a subspace");
 
+  // Return the cached collapsed space if it has been built before
+  if (_collapsed_space)
+    return {_collapsed_space, _collapsed_dofs};
+
   // Create collapsed DofMap
   std::shared_ptr<fem::DofMap> collapsed_dofmap;
   std::vector<std::int32_t> collapsed_dofs;
   std::tie(collapsed_dofmap, collapsed_dofs)
       = _dofmap->collapse(_mesh->mpi_comm(), _mesh->topology());
 
-  // Create new FunctionSpace and return
-  auto collapsed_sub_space
+  // Create new FunctionSpace, cache it and return
+  _collapsed_space
       = std::make_shared<FunctionSpace>(_mesh, _element, collapsed_dofmap);
+  _collapsed_dofs = std::move(collapsed_dofs);
 
-  return std::pair(std::move(collapsed_sub_space), std::move(collapsed_dofs));
+  return {_collapsed_space, _collapsed_dofs};
 }
 //-----------------------------------------------------------------------------
 std::vector<int> FunctionSpace::component() const { return _component; }
 //-----------------------------------------------------------------------------
+std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
+FunctionSpace::entity_closure_dofs(int dim) const
+{
+  // Return the cached map if it has been built before
+  if (auto it = _entity_dofs.find(dim); it != _entity_dofs.end())
+    return it->second;
+
+  assert(_mesh);
+  assert(_dofmap);
+  assert(_dofmap->element_dof_layout);
+  const int tdim = _mesh->topology().dim();
+
+  // Initialise entity-cell connectivity
+  _mesh->topology_mutable().create_entities(dim);
+  _mesh->topology_mutable().create_connectivity(dim, tdim);
+
+  auto e_to_c = _mesh->topology().connectivity(dim, tdim);
+  assert(e_to_c);
+  auto c_to_e = _mesh->topology().connectivity(tdim, dim);
+  assert(c_to_e);
+
+  // Local dof layout for dofs in the closure of each cell entity
+  const int num_cell_entities
+      = mesh::cell_num_entities(_mesh->topology().cell_type(), dim);
+  std::vector<Eigen::Array<int, Eigen::Dynamic, 1>> entity_dofs;
+  for (int i = 0; i < num_cell_entities; ++i)
+  {
+    entity_dofs.push_back(
+        _dofmap->element_dof_layout->entity_closure_dofs(dim, i));
+  }
+
+  const int num_entity_dofs
+      = _dofmap->element_dof_layout->num_entity_closure_dofs(dim);
+  auto map = _mesh->topology().index_map(dim);
+  assert(map);
+  const std::int32_t num_entities = map->size_local() + map->num_ghosts();
+
+  // Fill one row per entity across worker threads. Each entity reads
+  // its dofs through the first attached cell, so rows are disjoint
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      dofs(num_entities, num_entity_dofs);
+  common::parallel_for(num_entities, [&](std::int32_t begin, std::int32_t end) {
+    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> cell_dofs;
+    for (std::int32_t e = begin; e < end; ++e)
+    {
+      // Get first attached cell
+      assert(e_to_c->num_links(e) > 0);
+      const std::int32_t cell = e_to_c->links(e)[0];
+
+      // Get local index of the entity with respect to the cell
+      auto entities_d = c_to_e->links(cell);
+      const auto* it = std::find(entities_d.data(),
+                                 entities_d.data() + entities_d.rows(), e);
+      assert(it != (entities_d.data() + entities_d.rows()));
+      const int entity_local_index = std::distance(entities_d.data(), it);
+
+      _dofmap->cell_dofs(cell, cell_dofs);
+      for (int j = 0; j < num_entity_dofs; ++j)
+        dofs(e, j) = cell_dofs[entity_dofs[entity_local_index][j]];
+    }
+  });
+
+  auto adj = std::make_shared<const graph::AdjacencyList<std::int32_t>>(dofs);
+  _entity_dofs.insert({dim, adj});
+  return adj;
+}
+//-----------------------------------------------------------------------------
 Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
 FunctionSpace::tabulate_dof_coordinates() const
+{
+  // Get local size
+  assert(_dofmap);
+  std::shared_ptr<const common::IndexMap> index_map = _dofmap->index_map;
+  assert(index_map);
+  const int bs = index_map->block_size();
+  const std::int32_t local_size
+      = bs * (index_map->size_local() + index_map->num_ghosts());
+
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x
+      = Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>::Zero(
+          local_size, 3);
+  tabulate_dof_coordinates(x);
+  return x;
+}
+//-----------------------------------------------------------------------------
+void FunctionSpace::tabulate_dof_coordinates(
+    Eigen::Ref<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>> x)
+    const
 {
   // Geometric dimension
   assert(_mesh);
@@ -283,14 +616,7 @@ FunctionSpace::tabulate_dof_coordinates() const
     throw std::runtime_error(
         "Cannot tabulate coordinates for a FunctionSpace that is a subspace.");
   }
-
-  // Get local size
   assert(_dofmap);
-  std::shared_ptr<const common::IndexMap> index_map = _dofmap->index_map;
-  assert(index_map);
-  int bs = index_map->block_size();
-  std::int32_t local_size
-      = bs * (index_map->size_local() + index_map->num_ghosts());
 
   // Dof coordinate on reference element
   const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& X
@@ -309,42 +635,44 @@ FunctionSpace::tabulate_dof_coordinates() const
       x_g
       = _mesh->geometry().x();
 
-  // Array to hold coordinates to return
-  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x
-      = Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>::Zero(
-          local_size, 3);
-
-  // Loop over cells and tabulate dofs
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coordinates(_element->space_dimension(), gdim);
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coordinate_dofs(num_dofs_g, gdim);
+  // Ensure any lazy dofmap state (sub-dofmap views) is materialized
+  // before the threaded loop below
+  _dofmap->list();
 
+  // Loop over cells and tabulate dofs across worker threads. The
+  // coordinates of a dof shared between cells are computed by every
+  // cell touching it, but the computed values are identical, so the
+  // duplicate writes are harmless.
   auto map = _mesh->topology().index_map(tdim);
   assert(map);
   const int num_cells = map->size_local() + map->num_ghosts();
-  for (int c = 0; c < num_cells; ++c)
-  {
-    // Update cell
-    auto x_dofs = x_dofmap.links(c);
-    for (int i = 0; i < num_dofs_g; ++i)
-      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
-
-    // Get local-to-global map
-    auto dofs = _dofmap->cell_dofs(c);
-
-    // Tabulate dof coordinates on cell
-    cmap.push_forward(coordinates, X, coordinate_dofs);
-
-    // Copy dof coordinates into vector
-    for (Eigen::Index i = 0; i < dofs.size(); ++i)
+  common::parallel_for(num_cells, [&](std::int32_t begin, std::int32_t end) {
+    // Per-thread work arrays
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinates(_element->space_dimension(), gdim);
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinate_dofs(num_dofs_g, gdim);
+    for (std::int32_t c = begin; c < end; ++c)
     {
-      const std::int32_t dof = dofs[i];
-      x.row(dof).head(gdim) = coordinates.row(i);
+      // Update cell
+      auto x_dofs = x_dofmap.links(c);
+      for (int i = 0; i < num_dofs_g; ++i)
+        coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+      // Get local-to-global map
+      auto dofs = _dofmap->cell_dofs(c);
+
+      // Tabulate dof coordinates on cell
+      cmap.push_forward(coordinates, X, coordinate_dofs);
+
+      // Copy dof coordinates into vector
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+      {
+        const std::int32_t dof = dofs[i];
+        x.row(dof).head(gdim) = coordinates.row(i);
+      }
     }
-  }
-
-  return x;
+  });
 }
 //-----------------------------------------------------------------------------
 void FunctionSpace::set_x(
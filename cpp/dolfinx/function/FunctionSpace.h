@@ -23,6 +23,12 @@ namespace fem
 class DofMap;
 }
 
+namespace graph
+{
+template <typename T>
+class AdjacencyList;
+}
+
 namespace mesh
 {
 class Mesh;
@@ -151,11 +157,30 @@ public:
   ///         W.sub(1).sub(0) == [1, 0]
   std::vector<int> component() const;
 
+  /// Map from mesh entities of dimension dim to the dofs of this space
+  /// in the entity closure (one row per entity, including ghost
+  /// entities). Built on first call and cached - spaces are immutable,
+  /// so repeated access, e.g. when rebuilding boundary conditions, is
+  /// a shared_ptr copy.
+  /// @param[in] dim The topological dimension of the entities
+  /// @return Adjacency list mapping each entity to its closure dofs
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
+  entity_closure_dofs(int dim) const;
+
   /// Tabulate the physical coordinates of all dofs on this process.
   /// @return The dof coordinates [([x0, y0, z0], [x1, y1, z1], ...)
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
   tabulate_dof_coordinates() const;
 
+  /// Tabulate the physical coordinates of all dofs on this process
+  /// into a preallocated array, avoiding the allocation of the
+  /// returning overload.
+  /// @param[in,out] x Array of shape (num local dofs, 3) to fill with
+  ///   the dof coordinates
+  void tabulate_dof_coordinates(
+      Eigen::Ref<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>> x)
+      const;
+
   /// Set dof entries in vector to value*x[i], where [x][i] is the
   /// coordinate of the dof spatial coordinate. Parallel layout of
   /// vector must be consistent with dof map range This function is
@@ -181,6 +206,10 @@ public:
   std::shared_ptr<const fem::DofMap> dofmap() const;
 
 private:
+  // InterpolationPlan maps values at dof points to expansion
+  // coefficients via the private interpolate() below
+  friend class InterpolationPlan;
+
   // Interpolate data. Fills coefficients using 'values', which are the
   // values of an expression at each dof.
   void interpolate(
@@ -204,6 +233,18 @@ private:
                            expansion_coefficients,
                        const Function& v) const;
 
+  // Structural interpolation between different (scalar, point
+  // evaluation) elements on the same mesh. Builds a local
+  // reference-element interpolation matrix (one per distinct cell
+  // permutation) by evaluating the source basis at the dof coordinates
+  // of this space's element, then applies it cell-by-cell as a small
+  // matrix-vector product. Avoids the point-location and per-point
+  // evaluation of the coordinate-based path.
+  void interpolate_same_mesh(
+      Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>>
+          expansion_coefficients,
+      const Function& v) const;
+
   // The component w.r.t. to root space
   std::vector<int> _component;
 
@@ -213,8 +254,20 @@ private:
   // The identifier of root space
   std::size_t _root_space_id;
 
-  // Cache of subspaces
-  mutable std::map<std::vector<int>, std::weak_ptr<FunctionSpace>> _subspaces;
+  // Cache of subspaces, keyed by component relative to this space.
+  // Never invalidated - spaces are immutable
+  mutable std::map<std::vector<int>, std::shared_ptr<FunctionSpace>>
+      _subspaces;
+
+  // Cache of the collapsed space and collapsed-to-parent dof map,
+  // built on first call to collapse()
+  mutable std::shared_ptr<FunctionSpace> _collapsed_space;
+  mutable std::vector<std::int32_t> _collapsed_dofs;
+
+  // Cache of entity-to-closure-dofs maps, keyed by entity dimension.
+  // Never invalidated - spaces are immutable
+  mutable std::map<int, std::shared_ptr<const graph::AdjacencyList<std::int32_t>>>
+      _entity_dofs;
 };
 } // namespace function
 } // namespace dolfinx
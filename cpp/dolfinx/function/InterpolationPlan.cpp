@@ -0,0 +1,171 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "InterpolationPlan.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/PETScVector.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <numeric>
+#include <stdexcept>
+
+using namespace dolfinx;
+using namespace dolfinx::function;
+
+//-----------------------------------------------------------------------------
+InterpolationPlan::InterpolationPlan(
+    std::shared_ptr<const FunctionSpace> V_to,
+    std::shared_ptr<const FunctionSpace> V_from)
+    : _V_to(V_to), _V_from(V_from)
+{
+  assert(_V_to);
+  assert(_V_from);
+  assert(_V_to->element());
+  assert(_V_from->element());
+
+  // Check that value shapes match
+  if (_V_to->element()->value_rank() != _V_from->element()->value_rank())
+  {
+    throw std::runtime_error("Cannot interpolate between spaces. Value ranks "
+                             "do not match.");
+  }
+  for (int i = 0; i < _V_to->element()->value_rank(); ++i)
+  {
+    if (_V_to->element()->value_dimension(i)
+        != _V_from->element()->value_dimension(i))
+    {
+      throw std::runtime_error("Cannot interpolate between spaces. Value "
+                               "dimensions do not match.");
+    }
+  }
+
+  assert(_V_to->mesh());
+  assert(_V_from->mesh());
+  const mesh::Mesh& mesh_from = *_V_from->mesh();
+  MPI_Comm comm = mesh_from.mpi_comm();
+  const int comm_size = MPI::size(comm);
+
+  // Coordinates of the target space's dofs (including ghost dofs, so
+  // no ghost update is required after apply())
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x
+      = _V_to->tabulate_dof_coordinates();
+  _num_points = x.rows();
+
+  // Locate each target dof coordinate in the source mesh (collective)
+  geometry::BoundingBoxTree tree(mesh_from, mesh_from.topology().dim());
+  const auto located = geometry::locate_points(tree, mesh_from, x);
+  const std::vector<int>& ranks = std::get<0>(located);
+  const std::vector<std::int32_t>& cells = std::get<1>(located);
+
+  // Group the points by evaluating rank
+  std::vector<std::int32_t> count(comm_size, 0);
+  for (Eigen::Index p = 0; p < x.rows(); ++p)
+  {
+    if (ranks[p] >= 0)
+      ++count[ranks[p]];
+  }
+  _request_offsets.assign(comm_size + 1, 0);
+  std::partial_sum(count.begin(), count.end(), _request_offsets.begin() + 1);
+
+  const std::int32_t num_requests = _request_offsets.back();
+  _dof_indices.resize(num_requests);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> send_cells(num_requests);
+  Eigen::Array<double, Eigen::Dynamic, 1> send_x(3 * num_requests);
+  std::vector<std::int32_t> pos(_request_offsets.begin(),
+                                _request_offsets.end() - 1);
+  for (Eigen::Index p = 0; p < x.rows(); ++p)
+  {
+    if (ranks[p] < 0)
+      continue;
+    const std::int32_t k = pos[ranks[p]]++;
+    _dof_indices[k] = p;
+    send_cells[k] = cells[p];
+    for (int j = 0; j < 3; ++j)
+      send_x[3 * k + j] = x(p, j);
+  }
+
+  // Exchange the evaluation requests (cell indices and physical
+  // coordinates)
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets_cells(comm_size + 1);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets_x(comm_size + 1);
+  for (int r = 0; r < comm_size + 1; ++r)
+  {
+    offsets_cells[r] = _request_offsets[r];
+    offsets_x[r] = 3 * _request_offsets[r];
+  }
+  const graph::AdjacencyList<std::int32_t> recv_cells = MPI::all_to_all(
+      comm, graph::AdjacencyList<std::int32_t>(send_cells, offsets_cells));
+  const graph::AdjacencyList<double> recv_x = MPI::all_to_all(
+      comm, graph::AdjacencyList<double>(send_x, offsets_x));
+
+  // Store the evaluation side of the plan
+  const std::int32_t num_eval = recv_cells.array().rows();
+  _eval_cells.resize(num_eval);
+  _eval_x.resize(num_eval, 3);
+  for (std::int32_t k = 0; k < num_eval; ++k)
+  {
+    _eval_cells[k] = recv_cells.array()[k];
+    for (int j = 0; j < 3; ++j)
+      _eval_x(k, j) = recv_x.array()[3 * k + j];
+  }
+  _eval_offsets.assign(recv_cells.offsets().data(),
+                       recv_cells.offsets().data()
+                           + recv_cells.offsets().rows());
+}
+//-----------------------------------------------------------------------------
+void InterpolationPlan::apply(Function& u, const Function& v) const
+{
+  assert(u.function_space());
+  assert(v.function_space());
+  if (*u.function_space() != *_V_to or *v.function_space() != *_V_from)
+  {
+    throw std::runtime_error(
+        "Function spaces do not match the interpolation plan.");
+  }
+
+  MPI_Comm comm = _V_from->mesh()->mpi_comm();
+  const int comm_size = MPI::size(comm);
+  const int value_size = _V_from->element()->value_size();
+
+  // Evaluate the source Function at the cached (cell, point) pairs
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values_eval(_eval_cells.rows(), value_size);
+  v.eval_batched(_eval_x, _eval_cells, values_eval);
+
+  // Return the values to the requesting ranks. values_eval is row
+  // major, so the flattened array is grouped by origin rank.
+  Eigen::Map<const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> send_values(
+      values_eval.data(), values_eval.rows() * value_size);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> send_offsets(comm_size + 1);
+  for (int r = 0; r < comm_size + 1; ++r)
+    send_offsets[r] = value_size * _eval_offsets[r];
+  const graph::AdjacencyList<PetscScalar> recv_values = MPI::all_to_all(
+      comm, graph::AdjacencyList<PetscScalar>(send_values, send_offsets));
+
+  // Scatter the received values to the target dof points. Points not
+  // found in the source mesh keep the value zero.
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values(_num_points, value_size);
+  values.setZero();
+  const auto values_in = recv_values.array();
+  for (std::size_t k = 0; k < _dof_indices.size(); ++k)
+  {
+    for (int j = 0; j < value_size; ++j)
+      values(_dof_indices[k], j) = values_in[value_size * k + j];
+  }
+
+  // Map the dof point values to expansion coefficients
+  la::VecWrapper x_wrap(u.vector().vec());
+  _V_to->interpolate(x_wrap.x, values);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <memory>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace function
+{
+class Function;
+class FunctionSpace;
+
+/// Cached plan for interpolating a Function between two function
+/// spaces on different (non-matching) meshes in parallel.
+///
+/// At construction the coordinates of the target space's dofs are
+/// located in the source mesh using a geometry::BoundingBoxTree and
+/// the distributed point location in geometry::locate_points(), and
+/// the evaluation requests are exchanged so that each process knows
+/// which of its cells it must evaluate for which remote rank. apply()
+/// then only evaluates the source Function at the cached (cell, point)
+/// pairs and exchanges the values, so a plan built once can be applied
+/// every coupling step at the cost of one evaluation sweep and one
+/// all-to-all. Construction and apply() are collective over the mesh
+/// communicator; both meshes must share it.
+///
+/// Target dofs whose coordinates lie outside the source mesh on all
+/// processes are set to zero.
+class InterpolationPlan
+{
+public:
+  /// Build the interpolation plan
+  /// @param[in] V_to The function space to interpolate into. Its
+  ///   element must support tabulating dof coordinates (point
+  ///   evaluation dofs)
+  /// @param[in] V_from The function space of the source Function
+  InterpolationPlan(std::shared_ptr<const FunctionSpace> V_to,
+                    std::shared_ptr<const FunctionSpace> V_from);
+
+  /// Copy constructor
+  InterpolationPlan(const InterpolationPlan& plan) = default;
+
+  /// Move constructor
+  InterpolationPlan(InterpolationPlan&& plan) = default;
+
+  /// Destructor
+  ~InterpolationPlan() = default;
+
+  /// Interpolate a source Function into a target Function using the
+  /// cached plan
+  /// @param[in,out] u The target Function (on the space the plan was
+  ///   built for)
+  /// @param[in] v The source Function (on the source space of the
+  ///   plan)
+  void apply(Function& u, const Function& v) const;
+
+private:
+  // The target and source function spaces
+  std::shared_ptr<const FunctionSpace> _V_to;
+  std::shared_ptr<const FunctionSpace> _V_from;
+
+  // Number of target dof points (local, including ghosts)
+  std::int32_t _num_points;
+
+  // Target dof indices (local, including ghosts) for which values are
+  // received, grouped by the rank that evaluates them
+  std::vector<std::int32_t> _dof_indices;
+
+  // Number of points requested from each rank (prefix sums, length
+  // comm size + 1)
+  std::vector<std::int32_t> _request_offsets;
+
+  // Points this process evaluates for other ranks: physical
+  // coordinates, local cell indices and per-origin-rank prefix sums
+  // (length comm size + 1)
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> _eval_x;
+  Eigen::Array<int, Eigen::Dynamic, 1> _eval_cells;
+  std::vector<std::int32_t> _eval_offsets;
+};
+} // namespace function
+} // namespace dolfinx
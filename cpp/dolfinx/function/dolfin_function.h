@@ -13,5 +13,7 @@ namespace dolfinx
 
 // DOLFINX function interface
 
+#include <dolfinx/function/FieldStatistics.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/function/InterpolationPlan.h>
@@ -6,8 +6,10 @@
 
 #include "BoxMesh.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <vector>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/fem/ElementDofLayout.h>
@@ -86,6 +88,73 @@ create_geom(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
   return geom;
 }
 //-----------------------------------------------------------------------------
+// Destination ranks for each cube in the cell slab [range_c[0],
+// range_c[1]). The grid is structured, so ownership is known
+// analytically: a cube stays on the generating rank and, when
+// ghosting, is also sent to the owners of the neighbouring cubes
+// (face neighbours for GhostMode::shared_facet, all 26 neighbours for
+// GhostMode::shared_vertex). This precomputed distribution lets mesh
+// construction skip the graph partitioner entirely.
+std::vector<std::vector<std::int32_t>>
+cube_destinations(MPI_Comm comm, std::array<std::int64_t, 2> range_c,
+                  std::array<std::int64_t, 3> n,
+                  const mesh::GhostMode ghost_mode)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const std::int64_t nx = n[0];
+  const std::int64_t ny = n[1];
+  const std::int64_t nz = n[2];
+  const std::int64_t n_cells = nx * ny * nz;
+
+  std::vector<std::vector<std::int32_t>> dest(range_c[1] - range_c[0]);
+  for (std::int64_t i = range_c[0]; i < range_c[1]; ++i)
+  {
+    std::vector<std::int32_t>& d = dest[i - range_c[0]];
+    d.push_back(rank);
+    if (ghost_mode == mesh::GhostMode::none)
+      continue;
+
+    const std::int64_t iz = i / (nx * ny);
+    const std::int64_t j = i % (nx * ny);
+    const std::int64_t iy = j / nx;
+    const std::int64_t ix = j % nx;
+    for (int dz = -1; dz <= 1; ++dz)
+    {
+      for (int dy = -1; dy <= 1; ++dy)
+      {
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+          if (ghost_mode == mesh::GhostMode::shared_facet
+              and std::abs(dx) + std::abs(dy) + std::abs(dz) != 1)
+          {
+            continue;
+          }
+          else if (dx == 0 and dy == 0 and dz == 0)
+            continue;
+
+          if (ix + dx < 0 or ix + dx >= nx or iy + dy < 0 or iy + dy >= ny
+              or iz + dz < 0 or iz + dz >= nz)
+          {
+            continue;
+          }
+
+          const std::int64_t nbr
+              = (iz + dz) * nx * ny + (iy + dy) * nx + (ix + dx);
+          const int owner = dolfinx::MPI::index_owner(size, nbr, n_cells);
+          if (owner != rank
+              and std::find(d.begin(), d.end(), owner) == d.end())
+          {
+            d.push_back(owner);
+          }
+        }
+      }
+    }
+  }
+
+  return dest;
+}
+//-----------------------------------------------------------------------------
 mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
                      std::array<std::size_t, 3> n,
                      const fem::CoordinateElement& element,
@@ -138,8 +207,23 @@ mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
     ++cell;
   }
 
+  // Each tetrahedron inherits the destinations of its cube. This may
+  // ghost a few more cells than a strict facet layer (tetrahedra of a
+  // boundary cube that do not touch the shared face), but avoids any
+  // partitioner or dual graph computation.
+  const std::vector<std::vector<std::int32_t>> cube_dest
+      = cube_destinations(comm, range_c, {nx, ny, nz}, ghost_mode);
+  std::vector<std::vector<std::int32_t>> dest;
+  dest.reserve(6 * cube_dest.size());
+  for (const std::vector<std::int32_t>& d : cube_dest)
+    for (int i = 0; i < 6; ++i)
+      dest.push_back(d);
+
+  // Keep the lexicographic generation order (x fastest): it is already
+  // cache-friendly and matches the StructuredGrid descriptor
   return mesh::create_mesh(comm, graph::AdjacencyList<std::int64_t>(topo),
-                           element, geom, ghost_mode);
+                           element, geom, ghost_mode,
+                           graph::AdjacencyList<std::int32_t>(dest), false);
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh build_hex(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
@@ -180,8 +264,14 @@ mesh::Mesh build_hex(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
     ++cell;
   }
 
-  return mesh::create_mesh(comm, graph::AdjacencyList<std::int64_t>(topo),
-                           element, geom, ghost_mode);
+  // Keep the lexicographic generation order (x fastest): it is already
+  // cache-friendly and matches the StructuredGrid descriptor
+  return mesh::create_mesh(
+      comm, graph::AdjacencyList<std::int64_t>(topo), element, geom,
+      ghost_mode,
+      graph::AdjacencyList<std::int32_t>(
+          cube_destinations(comm, range_c, {nx, ny, nz}, ghost_mode)),
+      false);
 }
 //-----------------------------------------------------------------------------
 
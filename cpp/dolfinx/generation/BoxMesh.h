@@ -35,6 +35,14 @@ public:
   /// two points is not important in terms of minimum and maximum
   /// coordinates.
   ///
+  /// Generation is fully distributed: each rank generates only its own
+  /// slab of cells and vertices, and cell ownership (including the
+  /// ghost layer) is computed analytically from the structured grid, so
+  /// no graph partitioner is invoked and no redistribution takes place.
+  /// Cells keep their lexicographic generation order (x fastest),
+  /// which is cache-friendly and matches the StructuredGrid
+  /// point-location descriptor.
+  ///
   /// @param[in] comm MPI communicator to build mesh on
   /// @param[in] p Points of box
   /// @param[in] n Number of cells in each direction.
@@ -0,0 +1,120 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "StructuredGrid.h"
+#include <cmath>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Topology.h>
+#include <stdexcept>
+
+using namespace dolfinx;
+using namespace dolfinx::generation;
+
+//-----------------------------------------------------------------------------
+StructuredGrid::StructuredGrid(const mesh::Mesh& mesh,
+                               const std::array<Eigen::Vector3d, 2>& p,
+                               std::array<std::size_t, 3> n)
+    : _tdim(mesh.topology().dim())
+{
+  for (int d = 0; d < 3; ++d)
+  {
+    _p0[d] = std::min(p[0][d], p[1][d]);
+    _p1[d] = std::max(p[0][d], p[1][d]);
+    _n[d] = d < _tdim ? n[d] : 1;
+    if (d < _tdim)
+    {
+      if (_n[d] < 1 or _p1[d] - _p0[d] <= 0.0)
+        throw std::runtime_error("Degenerate structured grid.");
+      _dx[d] = (_p1[d] - _p0[d]) / static_cast<double>(_n[d]);
+    }
+    else
+      _dx[d] = 0.0;
+  }
+
+  // Map each original grid vertex back to the local cells touching it.
+  // The partitioner renumbers cells and vertices, but the geometry
+  // input indices preserve the generation numbering of the nodes. The
+  // map covers non-vertex nodes too for higher-order geometries, which
+  // is harmless.
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const std::vector<std::int64_t>& input_indices
+      = mesh.geometry().input_global_indices();
+  for (std::int32_t c = 0; c < x_dofmap.num_nodes(); ++c)
+  {
+    auto x_dofs = x_dofmap.links(c);
+    for (Eigen::Index i = 0; i < x_dofs.rows(); ++i)
+      _vertex_cells[input_indices[x_dofs[i]]].push_back(c);
+  }
+}
+//-----------------------------------------------------------------------------
+bool StructuredGrid::grid_index(const Eigen::Vector3d& x,
+                                std::array<std::int64_t, 3>& i) const
+{
+  const double rtol = 1e-14;
+  for (int d = 0; d < 3; ++d)
+  {
+    if (d >= _tdim)
+    {
+      i[d] = 0;
+      continue;
+    }
+    const double eps = rtol * (_p1[d] - _p0[d]);
+    if (x[d] < _p0[d] - eps or x[d] > _p1[d] + eps)
+      return false;
+    i[d] = static_cast<std::int64_t>(std::floor((x[d] - _p0[d]) / _dx[d]));
+    i[d] = std::min(std::max(i[d], std::int64_t(0)), _n[d] - 1);
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+std::int64_t StructuredGrid::grid_cell(const Eigen::Vector3d& x) const
+{
+  std::array<std::int64_t, 3> i;
+  if (!grid_index(x, i))
+    return -1;
+  return (i[2] * _n[1] + i[1]) * _n[0] + i[0];
+}
+//-----------------------------------------------------------------------------
+std::int32_t StructuredGrid::locate(const mesh::Mesh& mesh,
+                                    const Eigen::Vector3d& x) const
+{
+  std::array<std::int64_t, 3> i;
+  if (!grid_index(x, i))
+    return -1;
+
+  // Candidate cells are the local cells touching a corner vertex of
+  // the grid cell: every sub-cell of a grid cell contains at least one
+  // of its corners, for all the subdivisions the generation classes
+  // produce
+  const std::int64_t sx = 1;
+  const std::int64_t sy = _n[0] + 1;
+  const std::int64_t sz = (_n[0] + 1) * (_n[1] + 1);
+  std::vector<int> candidates;
+  const int num_corners = 1 << _tdim;
+  for (int corner = 0; corner < num_corners; ++corner)
+  {
+    const std::int64_t v = (i[0] + (corner & 1)) * sx
+                           + (i[1] + ((corner >> 1) & 1)) * sy
+                           + (i[2] + ((corner >> 2) & 1)) * sz;
+    if (auto it = _vertex_cells.find(v); it != _vertex_cells.end())
+      candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+
+  const std::vector<int> cells
+      = geometry::select_colliding_cells(mesh, candidates, x, 1);
+  return cells.empty() ? -1 : cells[0];
+}
+//-----------------------------------------------------------------------------
+Eigen::Vector3d StructuredGrid::closest_point(const Eigen::Vector3d& x) const
+{
+  Eigen::Vector3d y = x;
+  for (int d = 0; d < _tdim; ++d)
+    y[d] = std::min(std::max(y[d], _p0[d]), _p1[d]);
+  return y;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <dolfinx/mesh/Mesh.h>
+#include <unordered_map>
+#include <vector>
+
+namespace dolfinx
+{
+namespace generation
+{
+
+/// Descriptor for the structured geometry of meshes produced by
+/// IntervalMesh, RectangleMesh and BoxMesh. It locates points by
+/// arithmetic on the uniform grid instead of traversing a
+/// BoundingBoxTree: the grid cell containing a point is found in O(1),
+/// and the mesh cell within it is identified from a table mapping the
+/// original grid vertices to the local cells touching them, built once
+/// at construction. Intended for query-heavy users such as
+/// immersed-boundary and particle methods on a uniform background
+/// mesh.
+
+class StructuredGrid
+{
+public:
+  /// Create a descriptor for a structured mesh
+  /// @param[in] mesh The mesh, as returned by IntervalMesh,
+  ///                 RectangleMesh or BoxMesh with the same parameters
+  /// @param[in] p Corner points spanning the grid (the order is not
+  ///              important). Unused coordinate directions must
+  ///              coincide.
+  /// @param[in] n Number of grid cells in each used direction
+  StructuredGrid(const mesh::Mesh& mesh, const std::array<Eigen::Vector3d, 2>& p,
+                 std::array<std::size_t, 3> n);
+
+  /// Index of the grid cell containing a point, computed
+  /// arithmetically. For simplicial meshes a grid cell holds several
+  /// mesh cells; use locate to resolve the mesh cell.
+  /// @param[in] x The point
+  /// @return Grid cell index in the generation ordering (x fastest),
+  ///         or -1 if the point lies outside the grid
+  std::int64_t grid_cell(const Eigen::Vector3d& x) const;
+
+  /// Find the local mesh cell containing a point
+  /// @param[in] mesh The mesh passed to the constructor
+  /// @param[in] x The point
+  /// @return Local cell index, or -1 if the point is outside the grid
+  ///         or the containing cell is not on this process
+  std::int32_t locate(const mesh::Mesh& mesh, const Eigen::Vector3d& x) const;
+
+  /// Closest point of the grid to a point, i.e. the point clamped to
+  /// the grid bounding box. For points inside the grid this is the
+  /// point itself.
+  /// @param[in] x The point
+  /// @return The closest point on the grid
+  Eigen::Vector3d closest_point(const Eigen::Vector3d& x) const;
+
+private:
+  // Per-axis grid indices for a point, false if outside the grid
+  bool grid_index(const Eigen::Vector3d& x, std::array<std::int64_t, 3>& i) const;
+
+  // Topological dimension (number of used axes)
+  int _tdim;
+
+  // Lower corner, upper corner and grid spacing per axis
+  std::array<double, 3> _p0, _p1, _dx;
+
+  // Number of grid cells per axis (1 on unused axes)
+  std::array<std::int64_t, 3> _n;
+
+  // Map from original (generation) grid vertex index to the local
+  // cells touching that vertex
+  std::unordered_map<std::int64_t, std::vector<std::int32_t>> _vertex_cells;
+};
+} // namespace generation
+} // namespace dolfinx
@@ -14,3 +14,4 @@ namespace dolfinx
 #include <dolfinx/generation/BoxMesh.h>
 #include <dolfinx/generation/IntervalMesh.h>
 #include <dolfinx/generation/RectangleMesh.h>
+#include <dolfinx/generation/StructuredGrid.h>
@@ -5,68 +5,85 @@
 
 #include "BoundingBoxTree.h"
 #include "utils.h"
+#include <algorithm>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
-#include <dolfinx/mesh/MeshEntity.h>
 #include <dolfinx/mesh/utils.h>
+#include <limits>
+#include <thread>
 
 using namespace dolfinx;
 using namespace dolfinx::geometry;
 
 namespace
 {
+using SplitMethod = BoundingBoxTree::SplitMethod;
 //-----------------------------------------------------------------------------
-// Compute bounding box of mesh entity
+// Compute bounding box of mesh entity (dim, index). Uses flat
+// connectivity views and the split (structure-of-arrays) coordinate
+// buffer so no entity objects are constructed in the per-leaf loops
+// and the per-axis min/max runs on contiguous data.
 Eigen::Array<double, 2, 3, Eigen::RowMajor>
-compute_bbox_of_entity(const mesh::MeshEntity& entity)
+compute_bbox_of_entity(const mesh::Mesh& mesh, int dim, std::int32_t index)
 {
   // Get mesh entity data
-  const int tdim = entity.mesh().topology().dim();
-  const int dim = entity.dim();
-  const mesh::Geometry& geometry = entity.mesh().geometry();
+  const int tdim = mesh.topology().dim();
+  const mesh::Geometry& geometry = mesh.geometry();
   const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
 
-  entity.mesh().topology_mutable().create_connectivity(dim, tdim);
+  mesh.topology_mutable().create_connectivity(dim, tdim);
 
   // Find attached cell
-  auto e_to_c = entity.mesh().topology().connectivity(dim, tdim);
-  assert(e_to_c);
-  assert(e_to_c->num_links(entity.index()) > 0);
-  const std::int32_t c = e_to_c->links(entity.index())[0];
+  const mesh::Topology::ConnectivitySpan e_to_c
+      = mesh.topology().connectivity_span(dim, tdim);
+  assert(e_to_c.num_links(index) > 0);
+  const std::int32_t c = e_to_c.links(index)[0];
 
   auto dofs = x_dofmap.links(c);
-  auto c_to_v = entity.mesh().topology().connectivity(tdim, 0);
-  assert(c_to_v);
-  auto cell_vertices = c_to_v->links(c);
-
-  auto vertices = entity.entities(0);
-  assert(vertices.rows() >= 2);
-  const auto* it
-      = std::find(cell_vertices.data(),
-                  cell_vertices.data() + cell_vertices.rows(), vertices[0]);
-  assert(it != (cell_vertices.data() + cell_vertices.rows()));
-  const int local_vertex = std::distance(cell_vertices.data(), it);
-
-  const Eigen::Vector3d x0 = geometry.node(dofs(local_vertex));
+  const mesh::Topology::ConnectivitySpan c_to_v
+      = mesh.topology().connectivity_span(tdim, 0);
+  const std::int32_t* cell_vertices = c_to_v.links(c);
+  const std::int32_t num_cell_vertices = c_to_v.num_links(c);
+
+  const mesh::Topology::ConnectivitySpan e_to_v
+      = mesh.topology().connectivity_span(dim, 0);
+  const std::int32_t* vertices = e_to_v.links(index);
+  const std::int32_t num_vertices = e_to_v.num_links(index);
+  assert(num_vertices >= 2);
+  const auto* it = std::find(cell_vertices, cell_vertices + num_cell_vertices,
+                             vertices[0]);
+  assert(it != cell_vertices + num_cell_vertices);
+  const int local_vertex = std::distance(cell_vertices, it);
+
+  const std::vector<double>& x_split
+      = geometry.packed_x<double>(mesh::CoordinateLayout::split);
+  const Eigen::Index num_nodes = geometry.x().rows();
+  const double* xs[3] = {x_split.data(), x_split.data() + num_nodes,
+                         x_split.data() + 2 * num_nodes};
+
+  const std::int32_t dof0 = dofs(local_vertex);
   Eigen::Array<double, 2, 3, Eigen::RowMajor> b;
-  b.row(0) = x0;
-  b.row(1) = x0;
+  for (int d = 0; d < 3; ++d)
+    b(0, d) = b(1, d) = xs[d][dof0];
 
   // Compute min and max over remaining vertices
-  for (int i = 1; i < vertices.rows(); ++i)
+  for (int i = 1; i < num_vertices; ++i)
   {
-    const auto* it
-        = std::find(cell_vertices.data(),
-                    cell_vertices.data() + cell_vertices.rows(), vertices[i]);
-    assert(it != (cell_vertices.data() + cell_vertices.rows()));
-    const int local_vertex = std::distance(cell_vertices.data(), it);
-
-    const Eigen::Vector3d x = geometry.node(dofs(local_vertex));
-    b.row(0) = b.row(0).min(x.transpose().array());
-    b.row(1) = b.row(1).max(x.transpose().array());
+    const auto* it = std::find(cell_vertices,
+                               cell_vertices + num_cell_vertices, vertices[i]);
+    assert(it != cell_vertices + num_cell_vertices);
+    const int local_vertex = std::distance(cell_vertices, it);
+
+    const std::int32_t dof = dofs(local_vertex);
+    for (int d = 0; d < 3; ++d)
+    {
+      b(0, d) = std::min(b(0, d), xs[d][dof]);
+      b(1, d) = std::max(b(1, d), xs[d][dof]);
+    }
   }
 
   return b;
@@ -110,12 +127,155 @@ Eigen::Array<double, 2, 3, Eigen::RowMajor> compute_bbox_of_bboxes(
   return b;
 }
 //------------------------------------------------------------------------------
+// Half-surface area of a bounding box
+double half_area(const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b)
+{
+  const Eigen::Array<double, 1, 3> d = b.row(1) - b.row(0);
+  return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+}
+//------------------------------------------------------------------------------
+// Partition boxes by a binned surface area heuristic along the given
+// axis. Returns the partition point, or partition_begin if the split
+// is degenerate and the caller should fall back to the median split.
+std::vector<int>::iterator sah_split(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
+    const std::vector<int>::iterator partition_begin,
+    const std::vector<int>::iterator partition_end,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b, int axis)
+{
+  constexpr int num_bins = 16;
+  const double a0 = b(0, axis);
+  const double extent = b(1, axis) - a0;
+  if (extent <= 0.0)
+    return partition_begin;
+
+  // Bin the boxes by centroid and accumulate per-bin counts and bounds
+  auto bin_of = [&](int i) {
+    const double c
+        = 0.5 * (leaf_bboxes(2 * i, axis) + leaf_bboxes(2 * i + 1, axis));
+    return std::min(num_bins - 1,
+                    static_cast<int>(num_bins * (c - a0) / extent));
+  };
+  std::array<int, num_bins> count;
+  count.fill(0);
+  std::array<Eigen::Array<double, 2, 3, Eigen::RowMajor>, num_bins> bounds;
+  for (auto it = partition_begin; it != partition_end; ++it)
+  {
+    const int bin = bin_of(*it);
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor> box
+        = leaf_bboxes.block<2, 3>(2 * (*it), 0);
+    if (count[bin] == 0)
+      bounds[bin] = box;
+    else
+    {
+      bounds[bin].row(0) = bounds[bin].row(0).min(box.row(0));
+      bounds[bin].row(1) = bounds[bin].row(1).max(box.row(1));
+    }
+    ++count[bin];
+  }
+
+  // Sweep from the right to get suffix costs, then from the left to
+  // find the cheapest of the (num_bins - 1) split planes
+  std::array<double, num_bins> suffix_cost;
+  {
+    Eigen::Array<double, 2, 3, Eigen::RowMajor> box;
+    int n = 0;
+    for (int bin = num_bins - 1; bin > 0; --bin)
+    {
+      if (count[bin] > 0)
+      {
+        if (n == 0)
+          box = bounds[bin];
+        else
+        {
+          box.row(0) = box.row(0).min(bounds[bin].row(0));
+          box.row(1) = box.row(1).max(bounds[bin].row(1));
+        }
+        n += count[bin];
+      }
+      suffix_cost[bin] = n > 0 ? n * half_area(box) : 0.0;
+    }
+  }
+
+  int best_bin = -1;
+  {
+    double best_cost = std::numeric_limits<double>::max();
+    Eigen::Array<double, 2, 3, Eigen::RowMajor> box;
+    int n = 0;
+    for (int bin = 0; bin < num_bins - 1; ++bin)
+    {
+      if (count[bin] > 0)
+      {
+        if (n == 0)
+          box = bounds[bin];
+        else
+        {
+          box.row(0) = box.row(0).min(bounds[bin].row(0));
+          box.row(1) = box.row(1).max(bounds[bin].row(1));
+        }
+        n += count[bin];
+      }
+      if (n == 0)
+        continue;
+      const double cost = n * half_area(box) + suffix_cost[bin + 1];
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best_bin = bin;
+      }
+    }
+  }
+  if (best_bin < 0)
+    return partition_begin;
+
+  auto partition_middle
+      = std::partition(partition_begin, partition_end,
+                       [&](int i) { return bin_of(i) <= best_bin; });
+  if (partition_middle == partition_begin or partition_middle == partition_end)
+    return partition_begin;
+  return partition_middle;
+}
+//------------------------------------------------------------------------------
+// Partition boxes for an interior node: at the cheapest binned-SAH
+// plane when requested (and non-degenerate), otherwise at the median
+// centroid along the longest axis
+std::vector<int>::iterator partition_boxes(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
+    const std::vector<int>::iterator partition_begin,
+    const std::vector<int>::iterator partition_end,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b, SplitMethod split)
+{
+  Eigen::Array<double, 2, 3, Eigen::RowMajor>::Index axis;
+  (b.row(1) - b.row(0)).maxCoeff(&axis);
+
+  if (split == SplitMethod::sah)
+  {
+    auto partition_middle
+        = sah_split(leaf_bboxes, partition_begin, partition_end, b, axis);
+    if (partition_middle != partition_begin)
+      return partition_middle;
+  }
+
+  auto partition_middle
+      = partition_begin + (partition_end - partition_begin) / 2;
+  std::nth_element(partition_begin, partition_middle, partition_end,
+                   [&leaf_bboxes, axis](int i, int j) -> bool {
+                     const double bi = leaf_bboxes(i * 2, axis)
+                                       + leaf_bboxes(i * 2 + 1, axis);
+                     const double bj = leaf_bboxes(j * 2, axis)
+                                       + leaf_bboxes(j * 2 + 1, axis);
+                     return (bi < bj);
+                   });
+  return partition_middle;
+}
+//------------------------------------------------------------------------------
 int _build_from_leaf(
     const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
     const std::vector<int>::iterator partition_begin,
     const std::vector<int>::iterator partition_end,
     std::vector<std::array<int, 2>>& bboxes,
-    std::vector<double>& bbox_coordinates)
+    std::vector<double>& bbox_coordinates,
+    SplitMethod split = SplitMethod::median)
 {
   assert(partition_begin < partition_end);
 
@@ -144,26 +304,16 @@ int _build_from_leaf(
     Eigen::Array<double, 2, 3, Eigen::RowMajor> b
         = compute_bbox_of_bboxes(leaf_bboxes, partition_begin, partition_end);
 
-    // Sort bounding boxes along longest axis
-    Eigen::Array<double, 2, 3, Eigen::RowMajor>::Index axis;
-    (b.row(1) - b.row(0)).maxCoeff(&axis);
-    auto partition_middle
-        = partition_begin + (partition_end - partition_begin) / 2;
-    std::nth_element(partition_begin, partition_middle, partition_end,
-                     [&leaf_bboxes, axis](int i, int j) -> bool {
-                       const double bi = leaf_bboxes(i * 2, axis)
-                                         + leaf_bboxes(i * 2 + 1, axis);
-                       const double bj = leaf_bboxes(j * 2, axis)
-                                         + leaf_bboxes(j * 2 + 1, axis);
-                       return (bi < bj);
-                     });
+    // Split the boxes along the longest axis
+    auto partition_middle = partition_boxes(leaf_bboxes, partition_begin,
+                                            partition_end, b, split);
 
     // Split bounding boxes into two groups and call recursively
     std::array<int, 2> bbox;
     bbox[0] = _build_from_leaf(leaf_bboxes, partition_begin, partition_middle,
-                               bboxes, bbox_coordinates);
+                               bboxes, bbox_coordinates, split);
     bbox[1] = _build_from_leaf(leaf_bboxes, partition_middle, partition_end,
-                               bboxes, bbox_coordinates);
+                               bboxes, bbox_coordinates, split);
 
     // Store bounding box data. Note that root box will be added last.
     bboxes.push_back(bbox);
@@ -172,20 +322,82 @@ int _build_from_leaf(
     return bboxes.size() - 1;
   }
 }
+//------------------------------------------------------------------------------
+// Build with subtree tasks: the top of the recursion forks the right
+// subtree onto a new thread, building it into local arrays that are
+// spliced back with the node indices offset. Children keep smaller
+// indices than their parent, as the serial builder guarantees.
+int _build_from_leaf_parallel(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
+    const std::vector<int>::iterator partition_begin,
+    const std::vector<int>::iterator partition_end,
+    std::vector<std::array<int, 2>>& bboxes,
+    std::vector<double>& bbox_coordinates, SplitMethod split, int depth)
+{
+  if (depth < 1 or partition_end - partition_begin < 512)
+  {
+    return _build_from_leaf(leaf_bboxes, partition_begin, partition_end,
+                            bboxes, bbox_coordinates, split);
+  }
+
+  Eigen::Array<double, 2, 3, Eigen::RowMajor> b
+      = compute_bbox_of_bboxes(leaf_bboxes, partition_begin, partition_end);
+  auto partition_middle
+      = partition_boxes(leaf_bboxes, partition_begin, partition_end, b, split);
+
+  // Right subtree on its own thread, into local arrays
+  std::vector<std::array<int, 2>> bboxes1;
+  std::vector<double> bbox_coordinates1;
+  std::thread right([&]() {
+    _build_from_leaf_parallel(leaf_bboxes, partition_middle, partition_end,
+                              bboxes1, bbox_coordinates1, split, depth - 1);
+  });
+  const int bbox0
+      = _build_from_leaf_parallel(leaf_bboxes, partition_begin,
+                                  partition_middle, bboxes, bbox_coordinates,
+                                  split, depth - 1);
+  right.join();
+
+  // Splice the right subtree, offsetting its node indices. Leaves
+  // (child_0 == node) keep their entity index.
+  const int offset = bboxes.size();
+  for (std::size_t i = 0; i < bboxes1.size(); ++i)
+  {
+    const std::array<int, 2>& bx = bboxes1[i];
+    if (bx[0] == (int)i)
+      bboxes.push_back({(int)i + offset, bx[1]});
+    else
+      bboxes.push_back({bx[0] + offset, bx[1] + offset});
+  }
+  bbox_coordinates.insert(bbox_coordinates.end(), bbox_coordinates1.begin(),
+                          bbox_coordinates1.end());
+  const int bbox1 = bboxes.size() - 1;
+
+  bboxes.push_back({bbox0, bbox1});
+  bbox_coordinates.insert(bbox_coordinates.end(), b.data(), b.data() + 3);
+  bbox_coordinates.insert(bbox_coordinates.end(), b.data() + 3, b.data() + 6);
+  return bboxes.size() - 1;
+}
 //-----------------------------------------------------------------------------
 std::tuple<Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor>,
            Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
 build_from_leaf(
-    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes)
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
+    SplitMethod split = SplitMethod::median)
 {
   assert(leaf_bboxes.size() % 2 == 0);
   std::vector<int> partition(leaf_bboxes.rows() / 2);
   std::iota(partition.begin(), partition.end(), 0);
 
+  // Fork one task level per doubling of the worker thread count
+  int depth = 0;
+  for (int t = common::num_worker_threads(); t > 1; t /= 2)
+    ++depth;
+
   std::vector<std::array<int, 2>> bboxes;
   std::vector<double> bbox_coordinates;
-  _build_from_leaf(leaf_bboxes, partition.begin(), partition.end(), bboxes,
-                   bbox_coordinates);
+  _build_from_leaf_parallel(leaf_bboxes, partition.begin(), partition.end(),
+                            bboxes, bbox_coordinates, split, depth);
 
   Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor> bbox_array(
       bboxes.size(), 2);
@@ -259,10 +471,13 @@ BoundingBoxTree::BoundingBoxTree(
     const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& bbox_coords)
     : _tdim(0), _bboxes(bboxes), _bbox_coordinates(bbox_coords)
 {
-  // Do nothing
+  _mem_usage.update(sizeof(int) * _bboxes.size()
+                    + sizeof(double) * _bbox_coordinates.size());
 }
 //-----------------------------------------------------------------------------
-BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
+BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim,
+                                 SplitMethod split)
+    : _tdim(tdim)
 {
   // Check dimension
   if (tdim < 1 or tdim > mesh.topology().dim())
@@ -282,12 +497,11 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
       2 * num_leaves, 3);
   for (int e = 0; e < num_leaves; ++e)
   {
-    leaf_bboxes.block<2, 3>(2 * e, 0)
-        = compute_bbox_of_entity(mesh::MeshEntity(mesh, tdim, e));
+    leaf_bboxes.block<2, 3>(2 * e, 0) = compute_bbox_of_entity(mesh, tdim, e);
   }
 
   // Recursively build the bounding box tree from the leaves
-  std::tie(_bboxes, _bbox_coordinates) = build_from_leaf(leaf_bboxes);
+  std::tie(_bboxes, _bbox_coordinates) = build_from_leaf(leaf_bboxes, split);
 
   LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
             << " nodes for " << num_leaves << " entities.";
@@ -310,6 +524,10 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
     LOG(INFO) << "Computed global bounding box tree with "
               << global_tree->num_bboxes() << " boxes.";
   }
+
+  _build_quality = quality();
+  _mem_usage.update(sizeof(int) * _bboxes.size()
+                    + sizeof(double) * _bbox_coordinates.size());
 }
 //-----------------------------------------------------------------------------
 BoundingBoxTree::BoundingBoxTree(const std::vector<Eigen::Vector3d>& points)
@@ -338,10 +556,100 @@ BoundingBoxTree::BoundingBoxTree(const std::vector<Eigen::Vector3d>& points)
 
   LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
             << " nodes for " << num_leaves << " points.";
+
+  _build_quality = quality();
+  _mem_usage.update(sizeof(int) * _bboxes.size()
+                    + sizeof(double) * _bbox_coordinates.size());
 }
 //-----------------------------------------------------------------------------
 int BoundingBoxTree::num_bboxes() const { return _bboxes.rows(); }
 //-----------------------------------------------------------------------------
+void BoundingBoxTree::refit(const mesh::Mesh& mesh)
+{
+  if (_tdim < 1)
+  {
+    throw std::runtime_error(
+        "Can only refit trees built from mesh entities.");
+  }
+
+  auto map = mesh.topology().index_map(_tdim);
+  assert(map);
+  const std::int32_t num_leaves = map->size_local() + map->num_ghosts();
+  if (2 * num_leaves - 1 != num_bboxes())
+    throw std::runtime_error("Mesh does not match the tree.");
+
+  // Children are stored before their parent (the root box is last), so
+  // a single forward pass updates leaves from the mesh geometry and
+  // internal boxes from their already-updated children
+  for (int node = 0; node < num_bboxes(); ++node)
+  {
+    if (_bboxes(node, 0) == node)
+    {
+      // Leaf: recompute from the entity coordinates
+      _bbox_coordinates.block<2, 3>(2 * node, 0)
+          = compute_bbox_of_entity(mesh, _tdim, _bboxes(node, 1));
+    }
+    else
+    {
+      const int c0 = _bboxes(node, 0);
+      const int c1 = _bboxes(node, 1);
+      _bbox_coordinates.row(2 * node)
+          = _bbox_coordinates.row(2 * c0).min(_bbox_coordinates.row(2 * c1));
+      _bbox_coordinates.row(2 * node + 1)
+          = _bbox_coordinates.row(2 * c0 + 1)
+                .max(_bbox_coordinates.row(2 * c1 + 1));
+    }
+  }
+
+  // Refresh the global (per-process) tree from the new root boxes
+  MPI_Comm comm = mesh.mpi_comm();
+  const int mpi_size = MPI::size(comm);
+  if (mpi_size > 1)
+  {
+    const auto send_bbox = _bbox_coordinates.bottomRows(2);
+    Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> recv_bbox(
+        mpi_size * 2, 3);
+    MPI_Allgather(send_bbox.data(), 6, MPI_DOUBLE, recv_bbox.data(), 6,
+                  MPI_DOUBLE, comm);
+
+    auto [global_bboxes, global_coords] = build_from_leaf(recv_bbox);
+    global_tree.reset(new BoundingBoxTree(global_bboxes, global_coords));
+  }
+}
+//-----------------------------------------------------------------------------
+double BoundingBoxTree::quality() const
+{
+  if (num_bboxes() == 0)
+    return 0.0;
+
+  // Half-surface area of a box
+  auto half_area = [this](int node) {
+    const Eigen::Array<double, 1, 3> d
+        = _bbox_coordinates.row(2 * node + 1) - _bbox_coordinates.row(2 * node);
+    return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+  };
+
+  const double root_area = half_area(num_bboxes() - 1);
+  if (root_area <= 0.0)
+    return 0.0;
+
+  double area = 0.0;
+  for (int node = 0; node < num_bboxes(); ++node)
+  {
+    if (_bboxes(node, 0) != node)
+      area += half_area(node);
+  }
+
+  return area / root_area;
+}
+//-----------------------------------------------------------------------------
+bool BoundingBoxTree::needs_rebuild(double factor) const
+{
+  if (_build_quality <= 0.0)
+    return false;
+  return quality() > factor * _build_quality;
+}
+//-----------------------------------------------------------------------------
 std::string BoundingBoxTree::str() const
 {
   std::stringstream s;
@@ -8,6 +8,7 @@
 
 #include <Eigen/Dense>
 #include <array>
+#include <dolfinx/common/MemoryRegistry.h>
 #include <memory>
 #include <vector>
 
@@ -31,11 +32,25 @@ class BoundingBoxTree
 {
 
 public:
+  /// Criterion for choosing the split plane during construction
+  enum class SplitMethod
+  {
+    median, ///< Split at the median box centroid along the longest
+            ///< axis. Cheapest to build and gives balanced trees.
+    sah     ///< Binned surface area heuristic. Slightly more expensive
+            ///< to build but gives faster queries on anisotropic
+            ///< meshes, e.g. stretched boundary-layer cells.
+  };
+
   /// Constructor
   /// @param[in] mesh The mesh for building the bounding box tree
   /// @param[in] tdim The topological dimension of the mesh entities to
   ///                 by the bounding box tree for
-  BoundingBoxTree(const mesh::Mesh& mesh, int tdim);
+  /// @param[in] split Split criterion for interior nodes. The build is
+  ///                  split over the worker threads configured by
+  ///                  DOLFINX_NUM_THREADS for either criterion.
+  BoundingBoxTree(const mesh::Mesh& mesh, int tdim,
+                  SplitMethod split = SplitMethod::median);
 
   /// Constructor
   /// @param[in] points Cloud of points to build the bounding box tree
@@ -63,6 +78,30 @@ public:
   /// Return number of bounding boxes
   int num_bboxes() const;
 
+  /// Recompute all box extents from the current mesh geometry, keeping
+  /// the existing hierarchy. Use when only the coordinates of the mesh
+  /// have changed (e.g. ALE mesh motion) and the topology is
+  /// unchanged: a single bottom-up O(n) pass over the stored nodes
+  /// replaces the O(n log n) rebuild. The boxes remain tight but the
+  /// split planes are those of the original build, so repeated refits
+  /// on large motions degrade query performance (see needs_rebuild).
+  /// @param[in] mesh The mesh the tree was built from, with updated
+  ///                 geometry
+  void refit(const mesh::Mesh& mesh);
+
+  /// Tree quality measure: the sum of the half-surface areas of all
+  /// internal boxes relative to the half-surface area of the root box.
+  /// Grows as refits inflate and overlap the boxes. Lower is better;
+  /// the value is meaningful only relative to the value after a full
+  /// build.
+  double quality() const;
+
+  /// Check whether refits have degraded the tree enough that a full
+  /// rebuild pays off: true when quality() exceeds factor times the
+  /// value recorded when the tree was constructed.
+  /// @param[in] factor Allowed quality degradation factor
+  bool needs_rebuild(double factor = 1.5) const;
+
   /// Topological dimension of leaf entities
   int tdim() const;
 
@@ -81,6 +120,16 @@ public:
     return {_bboxes(node, 0), _bboxes(node, 1)};
   }
 
+  /// Flat array of bounding box coordinates for all nodes, two rows
+  /// per node (lower corner then upper corner). Allows traversals over
+  /// many queries to read box extents in place instead of copying a
+  /// box per visited node via get_bbox.
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
+  bbox_coordinates() const
+  {
+    return _bbox_coordinates;
+  }
+
 private:
   // Constructor
   BoundingBoxTree(
@@ -91,6 +140,10 @@ private:
   // Topological dimension of leaf entities
   int _tdim;
 
+  // Quality measure recorded after the full build, compared against by
+  // needs_rebuild()
+  double _build_quality = -1.0;
+
   // Print out recursively, for debugging
   void tree_print(std::stringstream& s, int i) const;
 
@@ -100,6 +153,9 @@ private:
   // List of bounding box coordinates
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> _bbox_coordinates;
 
+  // Reported resident bytes of the tree arrays
+  common::MemoryRegistry::Usage _mem_usage{"BoundingBoxTree"};
+
 public:
   /// Global tree for mesh ownership of each process (same on all
   /// processes)
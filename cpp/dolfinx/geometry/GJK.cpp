@@ -15,13 +15,16 @@ using namespace dolfinx;
 
 namespace
 {
+// Simplex of up to four points of the Minkowski difference. The row
+// count is dynamic but the storage is a fixed 4x3 block on the stack,
+// so simplex updates never touch the heap (the GJK kernel is called
+// O(10^7) times per contact sweep and heap traffic here dominates).
+using Simplex = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor, 4, 3>;
+
 // Find the resulting sub-simplex of the input simplex which is nearest to the
 // origin. Also, return the shortest vector from the origin to the resulting
 // simplex.
-std::pair<Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>,
-          Eigen::Vector3d>
-nearest_simplex(
-    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor, 4, 3>& s)
+std::pair<Simplex, Eigen::Vector3d> nearest_simplex(const Simplex& s)
 {
   if (s.rows() == 2)
   {
@@ -62,7 +65,7 @@ nearest_simplex(
     }
 
     // Test ACD, ABD and/or ABC.
-    Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> smin;
+    Simplex smin;
     Eigen::Vector3d vmin = {0, 0, 0};
     static const int facets[3][3] = {{0, 1, 3}, {0, 2, 3}, {1, 2, 3}};
     double qmin = std::numeric_limits<double>::max();
@@ -70,7 +73,7 @@ nearest_simplex(
     {
       if (f_inside[i + 1] == false)
       {
-        Eigen::Matrix<double, 3, 3, Eigen::RowMajor> M;
+        Simplex M(3, 3);
         M << s.row(facets[i][0]), s.row(facets[i][1]), s.row(facets[i][2]);
         auto [snew, v] = nearest_simplex(M);
         const double q = v.squaredNorm();
@@ -119,8 +122,7 @@ nearest_simplex(
   s.rowwise().squaredNorm().minCoeff(&i);
   Eigen::Vector3d vmin = s.row(i);
   double qmin = vmin.squaredNorm();
-  Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> smin
-      = vmin.transpose();
+  Simplex smin = vmin.transpose();
 
   // Check if edges are closer
   static const int f[3][2] = {{0, 1}, {0, 2}, {1, 2}};
@@ -163,11 +165,12 @@ support(const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& bd,
   }
   return bd.row(i);
 }
-} // namespace
-//-----------------------------------------------------
-Eigen::Vector3d geometry::compute_distance_gjk(
+//-------------------------------------------------------------------------------
+// GJK iteration starting from a given point of the Minkowski difference
+Eigen::Vector3d distance_gjk(
     const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& p,
-    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& q)
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& q,
+    const Eigen::Vector3d& v_init)
 {
   const int maxk = 10; // Maximum number of iterations of the GJK algorithm
 
@@ -175,9 +178,8 @@ Eigen::Vector3d geometry::compute_distance_gjk(
   const double eps = 1e-12;
 
   // Initialise vector and simplex
-  Eigen::Vector3d v = p.row(0) - q.row(0);
-  Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor, 4, 3> s
-      = v.transpose();
+  Eigen::Vector3d v = v_init;
+  Simplex s = v.transpose();
 
   // Begin GJK iteration
   int k;
@@ -219,3 +221,57 @@ Eigen::Vector3d geometry::compute_distance_gjk(
   // Compute and return distance
   return v;
 }
+} // namespace
+//-----------------------------------------------------
+Eigen::Vector3d geometry::compute_distance_gjk(
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& p,
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& q)
+{
+  return distance_gjk(p, q, p.row(0) - q.row(0));
+}
+//-----------------------------------------------------
+Eigen::Vector3d geometry::compute_distance_gjk(
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& p,
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& q,
+    const Eigen::Vector3d& v0)
+{
+  if (v0.squaredNorm() < 1e-24)
+    return distance_gjk(p, q, p.row(0) - q.row(0));
+
+  // Start from the simplex vertex the final iteration of a query with
+  // direction v0 would have produced. For temporally coherent queries
+  // this is (close to) the solution support point, so the iteration
+  // terminates after few steps.
+  return distance_gjk(p, q, support(p, -v0) - support(q, v0));
+}
+//-----------------------------------------------------
+Eigen::Vector3d geometry::GJKQueryCache::compute_distance(
+    std::int64_t key,
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& p,
+    const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>& q)
+{
+  Eigen::Vector3d v;
+  if (auto it = _directions.find(key); it != _directions.end())
+    v = compute_distance_gjk(p, q, it->second);
+  else
+    v = compute_distance_gjk(p, q);
+
+  _directions[key] = v;
+  return v;
+}
+//-----------------------------------------------------
+std::vector<Eigen::Vector3d> geometry::GJKQueryCache::compute_distance(
+    const std::vector<std::int64_t>& keys,
+    const std::vector<Eigen::Matrix<double, Eigen::Dynamic, 3,
+                                    Eigen::RowMajor>>& p,
+    const std::vector<Eigen::Matrix<double, Eigen::Dynamic, 3,
+                                    Eigen::RowMajor>>& q)
+{
+  if (keys.size() != p.size() or keys.size() != q.size())
+    throw std::runtime_error("Mismatch in GJK batch sizes.");
+
+  std::vector<Eigen::Vector3d> v(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    v[i] = compute_distance(keys[i], p[i], q[i]);
+  return v;
+}
@@ -8,11 +8,15 @@
 #include "BoundingBoxTree.h"
 #include "GJK.h"
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
+#include <numeric>
 
 using namespace dolfinx;
 
@@ -68,10 +72,10 @@ _compute_closest_entity(const geometry::BoundingBoxTree& tree,
     // Get entity (child_1 denotes entity index for leaves)
     assert(tree.tdim() == mesh.topology().dim());
     const int entity_index = bbox[1];
-    mesh::MeshEntity cell(mesh, mesh.topology().dim(), entity_index);
 
     // If entity is closer than best result so far, then return it
-    const double r2 = geometry::squared_distance(cell, point);
+    const double r2 = geometry::squared_distance(
+        mesh, mesh.topology().dim(), entity_index, point);
     if (r2 < R2)
     {
       closest_entity = entity_index;
@@ -216,6 +220,142 @@ void _compute_collisions_tree(const geometry::BoundingBoxTree& A,
   // the logic is easier to follow.
 }
 //-----------------------------------------------------------------------------
+// Pull a physical point inside a cell back to reference coordinates,
+// padded with zeros to three components
+Eigen::Vector3d pull_back_point(const mesh::Mesh& mesh, std::int32_t cell,
+                                const Eigen::Vector3d& x)
+{
+  const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+  const fem::CoordinateElement& cmap = mesh.geometry().cmap();
+
+  // Get cell geometry (coordinate dofs)
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  auto x_dofs = x_dofmap.links(cell);
+  for (int i = 0; i < num_dofs_g; ++i)
+    coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+  // Compute reference coordinates X (J, detJ and K are discarded)
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(1, gdim, tdim);
+  Eigen::Array<double, Eigen::Dynamic, 1> detJ(1);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(1, tdim, gdim);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> X(1,
+                                                                          tdim);
+  Eigen::Array<double, 1, Eigen::Dynamic, Eigen::RowMajor> _x
+      = x.head(gdim).transpose();
+  cmap.compute_reference_geometry(X, J, detJ, K, _x, coordinate_dofs);
+
+  Eigen::Vector3d Xp = Eigen::Vector3d::Zero();
+  for (int d = 0; d < tdim; ++d)
+    Xp[d] = X(0, d);
+  return Xp;
+}
+//-----------------------------------------------------------------------------
+// Exact containment test for a single cell. Straight-sided simplices
+// use barycentric sign checks; other cells fall back to the GJK
+// distance used by select_colliding_cells.
+bool point_in_cell(const mesh::Mesh& mesh, std::int32_t cell,
+                   const Eigen::Vector3d& x)
+{
+  const int tdim = mesh.topology().dim();
+  const int gdim = mesh.geometry().dim();
+  if (mesh::is_simplex(mesh.topology().cell_type()) and gdim == tdim
+      and mesh.geometry().cmap().is_affine())
+  {
+    const graph::AdjacencyList<std::int32_t>& x_dofmap
+        = mesh.geometry().dofmap();
+    auto x_dofs = x_dofmap.links(cell);
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+        = mesh.geometry().x();
+
+    // Solve J lambda = x - v0, padding unused dimensions with the
+    // identity so the barycentric coordinates of the padding are zero
+    Eigen::Matrix3d J = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d b = Eigen::Vector3d::Zero();
+    for (int j = 0; j < tdim; ++j)
+      for (int i = 0; i < tdim; ++i)
+        J(i, j) = x_g(x_dofs[j + 1], i) - x_g(x_dofs[0], i);
+    for (int i = 0; i < tdim; ++i)
+      b[i] = x[i] - x_g(x_dofs[0], i);
+    const Eigen::Vector3d lambda = J.partialPivLu().solve(b);
+
+    const double eps = 1e-12;
+    double sum = 0.0;
+    for (int j = 0; j < tdim; ++j)
+    {
+      if (lambda[j] < -eps)
+        return false;
+      sum += lambda[j];
+    }
+    return sum <= 1.0 + eps;
+  }
+
+  // Non-simplex or curved cell
+  const double eps2 = 1e-20;
+  return geometry::squared_distance(mesh, tdim, cell, x) < eps2;
+}
+//-----------------------------------------------------------------------------
+// Slab test of a ray against a tree node box. On a hit, tnear is set
+// to the entry parameter (clamped to t0).
+bool ray_bbox_intersect(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x,
+    int node, const Eigen::Vector3d& origin, const Eigen::Vector3d& inv_dir,
+    double t0, double t1, double& tnear)
+{
+  for (int d = 0; d < 3; ++d)
+  {
+    double ta = (x(2 * node, d) - origin[d]) * inv_dir[d];
+    double tb = (x(2 * node + 1, d) - origin[d]) * inv_dir[d];
+    if (inv_dir[d] < 0.0)
+      std::swap(ta, tb);
+    // NaN from 0 * inf (ray parallel to a slab it touches) loses
+    // against the running bounds here, which keeps the test
+    // conservative
+    t0 = ta > t0 ? ta : t0;
+    t1 = tb < t1 ? tb : t1;
+    if (t0 > t1)
+      return false;
+  }
+  tnear = t0;
+  return true;
+}
+//-----------------------------------------------------------------------------
+// Append all leaf boxes hit by one ray, reusing the caller's stack
+void _compute_ray_collisions(
+    const geometry::BoundingBoxTree& tree,
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x,
+    const Eigen::Vector3d& origin, const Eigen::Vector3d& inv_dir, double t0,
+    double t1, std::vector<int>& stack, std::vector<int>& entities)
+{
+  const int root = tree.num_bboxes() - 1;
+  if (root < 0)
+    return;
+
+  double tnear;
+  stack.push_back(root);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+    if (!ray_bbox_intersect(x, node, origin, inv_dir, t0, t1, tnear))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+      entities.push_back(bbox[1]);
+    else
+    {
+      stack.push_back(bbox[0]);
+      stack.push_back(bbox[1]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 
 } // namespace
 
@@ -263,6 +403,174 @@ std::vector<int> geometry::compute_collisions(const BoundingBoxTree& tree,
   return entities;
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::vector<int>> geometry::compute_collisions(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& p)
+{
+  std::vector<int> entities;
+  std::vector<int> offsets(p.rows() + 1, 0);
+  const int root = tree.num_bboxes() - 1;
+  if (root < 0)
+    return {std::move(entities), std::move(offsets)};
+
+  // Box extents are read in place; the in/out test below matches
+  // point_in_bbox (same relative tolerance) but works on the raw
+  // coordinate array so the per-axis comparisons vectorize
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = tree.bbox_coordinates();
+  const double rtol = 1e-14;
+
+  // Explicit traversal stack, reused across the batch
+  std::vector<int> stack;
+  stack.reserve(64);
+  for (Eigen::Index i = 0; i < p.rows(); ++i)
+  {
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+      const int node = stack.back();
+      stack.pop_back();
+
+      bool inside = true;
+      for (int d = 0; d < 3; ++d)
+      {
+        const double b0 = x(2 * node, d);
+        const double b1 = x(2 * node + 1, d);
+        const double eps = rtol * (b1 - b0);
+        inside = inside and p(i, d) >= (b0 - eps) and p(i, d) <= (b1 + eps);
+      }
+      if (!inside)
+        continue;
+
+      const std::array<int, 2> bbox = tree.bbox(node);
+      if (is_leaf(bbox, node))
+      {
+        // child_1 denotes entity for leaves
+        entities.push_back(bbox[1]);
+      }
+      else
+      {
+        stack.push_back(bbox[0]);
+        stack.push_back(bbox[1]);
+      }
+    }
+    offsets[i + 1] = entities.size();
+  }
+
+  return {std::move(entities), std::move(offsets)};
+}
+//-----------------------------------------------------------------------------
+std::vector<int> geometry::compute_ray_collisions(
+    const BoundingBoxTree& tree, const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction, double t0, double t1)
+{
+  const Eigen::Vector3d inv_dir = direction.cwiseInverse();
+  std::vector<int> stack;
+  stack.reserve(64);
+  std::vector<int> entities;
+  _compute_ray_collisions(tree, tree.bbox_coordinates(), origin, inv_dir, t0,
+                          t1, stack, entities);
+  return entities;
+}
+//-----------------------------------------------------------------------------
+std::pair<int, double> geometry::compute_ray_first_collision(
+    const BoundingBoxTree& tree, const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction, double t0, double t1)
+{
+  const int root = tree.num_bboxes() - 1;
+  if (root < 0)
+    return {-1, t1};
+
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = tree.bbox_coordinates();
+  const Eigen::Vector3d inv_dir = direction.cwiseInverse();
+
+  int hit = -1;
+  double t_hit = t1;
+  double tnear;
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(root);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+
+    // Prune nodes entered behind the best hit so far
+    if (!ray_bbox_intersect(x, node, origin, inv_dir, t0, t_hit, tnear))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+    {
+      if (tnear < t_hit or hit < 0)
+      {
+        hit = bbox[1];
+        t_hit = tnear;
+      }
+    }
+    else
+    {
+      // Visit the nearer child first so the far subtree can be pruned
+      double ta, tb;
+      const bool hit_a
+          = ray_bbox_intersect(x, bbox[0], origin, inv_dir, t0, t_hit, ta);
+      const bool hit_b
+          = ray_bbox_intersect(x, bbox[1], origin, inv_dir, t0, t_hit, tb);
+      if (hit_a and hit_b)
+      {
+        if (ta < tb)
+        {
+          stack.push_back(bbox[1]);
+          stack.push_back(bbox[0]);
+        }
+        else
+        {
+          stack.push_back(bbox[0]);
+          stack.push_back(bbox[1]);
+        }
+      }
+      else if (hit_a)
+        stack.push_back(bbox[0]);
+      else if (hit_b)
+        stack.push_back(bbox[1]);
+    }
+  }
+
+  return {hit, t_hit};
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::vector<int>> geometry::compute_ray_collisions(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& origin,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& direction,
+    double t0, double t1)
+{
+  if (origin.rows() != direction.rows())
+    throw std::runtime_error("Mismatch in ray batch sizes.");
+
+  std::vector<int> entities;
+  std::vector<int> offsets(origin.rows() + 1, 0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = tree.bbox_coordinates();
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  for (Eigen::Index i = 0; i < origin.rows(); ++i)
+  {
+    const Eigen::Vector3d o = origin.row(i).matrix().transpose();
+    const Eigen::Vector3d inv_dir
+        = direction.row(i).matrix().transpose().cwiseInverse();
+    _compute_ray_collisions(tree, x, o, inv_dir, t0, t1, stack, entities);
+    offsets[i + 1] = entities.size();
+  }
+
+  return {std::move(entities), std::move(offsets)};
+}
+//-----------------------------------------------------------------------------
 std::vector<int>
 geometry::compute_process_collisions(const geometry::BoundingBoxTree& tree,
                                      const Eigen::Vector3d& p)
@@ -348,35 +656,43 @@ geometry::compute_closest_point(const BoundingBoxTree& tree,
 double geometry::squared_distance(const mesh::MeshEntity& entity,
                                   const Eigen::Vector3d& p)
 {
-  const int dim = entity.dim();
-  const int tdim = entity.mesh().topology().dim();
+  return geometry::squared_distance(entity.mesh(), entity.dim(),
+                                    entity.index(), p);
+}
+//-------------------------------------------------------------------------------
+double geometry::squared_distance(const mesh::Mesh& mesh, int dim,
+                                  std::int32_t index, const Eigen::Vector3d& p)
+{
+  const int tdim = mesh.topology().dim();
   const graph::AdjacencyList<std::int32_t>& x_dofmap
-      = entity.mesh().geometry().dofmap();
+      = mesh.geometry().dofmap();
 
   // Find attached cell
-  entity.mesh().topology_mutable().create_connectivity(dim, tdim);
-  auto e_to_c = entity.mesh().topology().connectivity(dim, tdim);
-  assert(e_to_c);
-  assert(e_to_c->num_links(entity.index()) > 0);
-  const std::int32_t c = e_to_c->links(entity.index())[0];
+  mesh.topology_mutable().create_connectivity(dim, tdim);
+  const mesh::Topology::ConnectivitySpan e_to_c
+      = mesh.topology().connectivity_span(dim, tdim);
+  assert(e_to_c.num_links(index) > 0);
+  const std::int32_t c = e_to_c.links(index)[0];
 
   auto dofs = x_dofmap.links(c);
-  auto c_to_v = entity.mesh().topology().connectivity(tdim, 0);
-  assert(c_to_v);
-  auto cell_vertices = c_to_v->links(c);
-
-  auto vertices = entity.entities(0);
-  const mesh::Geometry& geometry = entity.mesh().geometry();
-
-  Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> v(vertices.size(),
-                                                              3);
-  for (int i = 0; i < vertices.size(); ++i)
-  {
-    const std::int32_t* it
-        = std::find(cell_vertices.data(),
-                    cell_vertices.data() + cell_vertices.rows(), vertices[i]);
-    assert(it != (cell_vertices.data() + cell_vertices.rows()));
-    const int local_vertex = std::distance(cell_vertices.data(), it);
+  const mesh::Topology::ConnectivitySpan c_to_v
+      = mesh.topology().connectivity_span(tdim, 0);
+  const std::int32_t* cell_vertices = c_to_v.links(c);
+  const std::int32_t num_cell_vertices = c_to_v.num_links(c);
+
+  const mesh::Topology::ConnectivitySpan e_to_v
+      = mesh.topology().connectivity_span(dim, 0);
+  const std::int32_t* vertices = e_to_v.links(index);
+  const std::int32_t num_vertices = e_to_v.num_links(index);
+  const mesh::Geometry& geometry = mesh.geometry();
+
+  Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> v(num_vertices, 3);
+  for (int i = 0; i < num_vertices; ++i)
+  {
+    const std::int32_t* it = std::find(
+        cell_vertices, cell_vertices + num_cell_vertices, vertices[i]);
+    assert(it != (cell_vertices + num_cell_vertices));
+    const int local_vertex = std::distance(cell_vertices, it);
     v.row(i) = geometry.node(dofs(local_vertex));
   }
 
@@ -393,8 +709,7 @@ geometry::select_colliding_cells(const dolfinx::mesh::Mesh& mesh,
   std::vector<int> result;
   for (int c : candidate_cells)
   {
-    mesh::MeshEntity entity(mesh, tdim, c);
-    const double d2 = squared_distance(entity, point);
+    const double d2 = squared_distance(mesh, tdim, c, point);
     if (d2 < eps2)
     {
       result.push_back(c);
@@ -404,3 +719,234 @@ geometry::select_colliding_cells(const dolfinx::mesh::Mesh& mesh,
   }
   return result;
 }
+//-------------------------------------------------------------------------------
+std::int32_t geometry::locate_cell(const BoundingBoxTree& tree,
+                                   const mesh::Mesh& mesh,
+                                   const Eigen::Vector3d& p)
+{
+  const int root = tree.num_bboxes() - 1;
+  if (root < 0)
+    return -1;
+
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = tree.bbox_coordinates();
+  const double rtol = 1e-14;
+
+  // Depth-first traversal with the containment test run directly on
+  // each leaf, returning at the first hit
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(root);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+
+    // In/out test matching point_in_bbox, on the raw coordinate array
+    bool inside = true;
+    for (int d = 0; d < 3; ++d)
+    {
+      const double b0 = x(2 * node, d);
+      const double b1 = x(2 * node + 1, d);
+      const double eps = rtol * (b1 - b0);
+      inside = inside and p[d] >= (b0 - eps) and p[d] <= (b1 + eps);
+    }
+    if (!inside)
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+    {
+      if (point_in_cell(mesh, bbox[1], p))
+        return bbox[1];
+    }
+    else
+    {
+      stack.push_back(bbox[0]);
+      stack.push_back(bbox[1]);
+    }
+  }
+
+  return -1;
+}
+//-------------------------------------------------------------------------------
+std::tuple<std::vector<int>, std::vector<std::int32_t>,
+           Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+geometry::locate_points(
+    const BoundingBoxTree& tree, const mesh::Mesh& mesh,
+    const Eigen::Ref<
+        const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>& p)
+{
+  MPI_Comm comm = mesh.mpi_comm();
+  const int mpi_rank = MPI::rank(comm);
+  const int mpi_size = MPI::size(comm);
+  const std::int32_t num_points = p.rows();
+
+  std::vector<int> point_rank(num_points, -1);
+  std::vector<std::int32_t> point_cell(num_points, -1);
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> X
+      = Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>::Zero(
+          num_points, 3);
+
+  // Resolve points colliding with a local cell
+  const auto [candidates, offsets] = compute_collisions(tree, p);
+  std::vector<std::int32_t> unresolved;
+  for (std::int32_t i = 0; i < num_points; ++i)
+  {
+    const Eigen::Vector3d x = p.row(i).matrix().transpose();
+    const std::vector<int> cand(candidates.begin() + offsets[i],
+                                candidates.begin() + offsets[i + 1]);
+    const std::vector<int> cells = select_colliding_cells(mesh, cand, x, 1);
+    if (!cells.empty())
+    {
+      point_rank[i] = mpi_rank;
+      point_cell[i] = cells[0];
+      X.row(i) = pull_back_point(mesh, cells[0], x).transpose();
+    }
+    else
+      unresolved.push_back(i);
+  }
+
+  if (mpi_size == 1)
+    return {std::move(point_rank), std::move(point_cell), std::move(X)};
+
+  // Determine candidate processes for each unresolved point from the
+  // per-process tree
+  std::vector<std::vector<std::int32_t>> fwd_points(mpi_size);
+  for (std::int32_t i : unresolved)
+  {
+    const Eigen::Vector3d x = p.row(i).matrix().transpose();
+    for (int r : compute_process_collisions(tree, x))
+    {
+      if (r != mpi_rank)
+        fwd_points[r].push_back(i);
+    }
+  }
+
+  // Exchange counts to discover which processes send to this one
+  std::vector<int> send_count(mpi_size, 0);
+  for (int r = 0; r < mpi_size; ++r)
+    send_count[r] = fwd_points[r].size();
+  std::vector<int> recv_count(mpi_size);
+  MPI_Alltoall(send_count.data(), 1, MPI_INT, recv_count.data(), 1, MPI_INT,
+               comm);
+
+  std::vector<int> dest, src;
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    if (send_count[r] > 0)
+      dest.push_back(r);
+    if (recv_count[r] > 0)
+      src.push_back(r);
+  }
+
+  // Forward graph (receive from src, send to dest) and its reverse for
+  // the replies
+  MPI_Comm fwd_comm, rev_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &fwd_comm);
+  MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 src.size(), src.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &rev_comm);
+
+  // Pack point coordinates for each destination
+  std::vector<int> fwd_sizes(dest.size()), fwd_disp(dest.size() + 1, 0);
+  for (std::size_t n = 0; n < dest.size(); ++n)
+  {
+    fwd_sizes[n] = 3 * send_count[dest[n]];
+    fwd_disp[n + 1] = fwd_disp[n] + fwd_sizes[n];
+  }
+  std::vector<double> send_x;
+  send_x.reserve(fwd_disp.back());
+  for (int r : dest)
+  {
+    for (std::int32_t i : fwd_points[r])
+      for (int d = 0; d < 3; ++d)
+        send_x.push_back(p(i, d));
+  }
+
+  std::vector<int> recv_sizes(src.size()), recv_disp(src.size() + 1, 0);
+  for (std::size_t n = 0; n < src.size(); ++n)
+  {
+    recv_sizes[n] = 3 * recv_count[src[n]];
+    recv_disp[n + 1] = recv_disp[n] + recv_sizes[n];
+  }
+  std::vector<double> recv_x(recv_disp.back());
+
+  MPI_Request req;
+  MPI_Ineighbor_alltoallv(send_x.data(), fwd_sizes.data(), fwd_disp.data(),
+                          MPI_DOUBLE, recv_x.data(), recv_sizes.data(),
+                          recv_disp.data(), MPI_DOUBLE, fwd_comm, &req);
+  MPI_Wait(&req, MPI_STATUS_IGNORE);
+
+  // Test the received points against the local tree and compute
+  // reference coordinates for the hits
+  const std::int32_t num_recv = recv_x.size() / 3;
+  std::vector<std::int32_t> reply_cell(num_recv, -1);
+  std::vector<double> reply_X(3 * num_recv, 0.0);
+  for (std::int32_t i = 0; i < num_recv; ++i)
+  {
+    const Eigen::Vector3d x(recv_x[3 * i], recv_x[3 * i + 1],
+                            recv_x[3 * i + 2]);
+    const std::vector<int> cells
+        = select_colliding_cells(mesh, compute_collisions(tree, x), x, 1);
+    if (!cells.empty())
+    {
+      reply_cell[i] = cells[0];
+      const Eigen::Vector3d Xp = pull_back_point(mesh, cells[0], x);
+      for (int d = 0; d < 3; ++d)
+        reply_X[3 * i + d] = Xp[d];
+    }
+  }
+
+  // Send the replies back along the reverse graph. Counts per point:
+  // one cell index and three reference coordinates.
+  std::vector<int> cell_sizes_out(src.size()), cell_disp_out(src.size() + 1, 0);
+  for (std::size_t n = 0; n < src.size(); ++n)
+  {
+    cell_sizes_out[n] = recv_count[src[n]];
+    cell_disp_out[n + 1] = cell_disp_out[n] + cell_sizes_out[n];
+  }
+  std::vector<int> cell_sizes_in(dest.size()), cell_disp_in(dest.size() + 1, 0);
+  for (std::size_t n = 0; n < dest.size(); ++n)
+  {
+    cell_sizes_in[n] = send_count[dest[n]];
+    cell_disp_in[n + 1] = cell_disp_in[n] + cell_sizes_in[n];
+  }
+  std::vector<std::int32_t> reply_cell_in(cell_disp_in.back());
+  std::vector<double> reply_X_in(3 * cell_disp_in.back());
+
+  std::array<MPI_Request, 2> reqs;
+  MPI_Ineighbor_alltoallv(reply_cell.data(), cell_sizes_out.data(),
+                          cell_disp_out.data(), MPI_INT32_T,
+                          reply_cell_in.data(), cell_sizes_in.data(),
+                          cell_disp_in.data(), MPI_INT32_T, rev_comm, &reqs[0]);
+  MPI_Ineighbor_alltoallv(reply_X.data(), recv_sizes.data(), recv_disp.data(),
+                          MPI_DOUBLE, reply_X_in.data(), fwd_sizes.data(),
+                          fwd_disp.data(), MPI_DOUBLE, rev_comm, &reqs[1]);
+  MPI_Waitall(2, reqs.data(), MPI_STATUSES_IGNORE);
+  MPI_Comm_free(&fwd_comm);
+  MPI_Comm_free(&rev_comm);
+
+  // Accept the reply from the lowest responding rank for each point.
+  // Destinations are visited in increasing rank order.
+  for (std::size_t n = 0; n < dest.size(); ++n)
+  {
+    const std::vector<std::int32_t>& points = fwd_points[dest[n]];
+    for (std::size_t k = 0; k < points.size(); ++k)
+    {
+      const std::int32_t i = points[k];
+      const std::int32_t c = reply_cell_in[cell_disp_in[n] + k];
+      if (c >= 0 and point_rank[i] == -1)
+      {
+        point_rank[i] = dest[n];
+        point_cell[i] = c;
+        for (int d = 0; d < 3; ++d)
+          X(i, d) = reply_X_in[fwd_disp[n] + 3 * k + d];
+      }
+    }
+  }
+
+  return {std::move(point_rank), std::move(point_cell), std::move(X)};
+}
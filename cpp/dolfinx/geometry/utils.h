@@ -8,6 +8,9 @@
 
 #include "BoundingBoxTree.h"
 #include <Eigen/Dense>
+#include <cstdint>
+#include <limits>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -40,11 +43,114 @@ compute_collisions(const BoundingBoxTree& tree0, const BoundingBoxTree& tree1);
 std::vector<int> compute_collisions(const BoundingBoxTree& tree,
                                     const Eigen::Vector3d& p);
 
+/// Compute all collisions between bounding boxes and a batch of
+/// points. Equivalent to calling compute_collisions once per point,
+/// but the traversal is iterative (explicit stack) and reads box
+/// extents in place, amortizing the setup over the batch. Intended for
+/// query-heavy users such as particle tracking.
+/// @param[in] tree The bounding box tree
+/// @param[in] p The points, one per row
+/// @return Bounding box leaves that contain each point, in CSR form:
+///         the collisions for point i are
+///         entities[offsets[i]:offsets[i + 1]], where (entities,
+///         offsets) is the returned pair and offsets has p.rows() + 1
+///         entries
+std::pair<std::vector<int>, std::vector<int>> compute_collisions(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& p);
+
+/// Compute all leaf bounding boxes intersected by a ray, by slab-test
+/// traversal of the tree. One traversal replaces sampling points along
+/// the ray and calling compute_collisions per sample.
+/// @param[in] tree The bounding box tree
+/// @param[in] origin Ray origin
+/// @param[in] direction Ray direction (need not be normalized)
+/// @param[in] t0 Lower bound of the ray parameter
+/// @param[in] t1 Upper bound of the ray parameter
+/// @return Entities whose leaf box intersects the ray segment
+///         origin + t * direction, t in [t0, t1]
+std::vector<int>
+compute_ray_collisions(const BoundingBoxTree& tree,
+                       const Eigen::Vector3d& origin,
+                       const Eigen::Vector3d& direction, double t0 = 0.0,
+                       double t1 = std::numeric_limits<double>::max());
+
+/// Compute the first leaf bounding box hit by a ray. The traversal is
+/// ordered by box entry parameter and prunes subtrees behind the best
+/// hit found so far.
+/// @param[in] tree The bounding box tree
+/// @param[in] origin Ray origin
+/// @param[in] direction Ray direction (need not be normalized)
+/// @param[in] t0 Lower bound of the ray parameter
+/// @param[in] t1 Upper bound of the ray parameter
+/// @return (entity, t) for the leaf box with the smallest entry
+///         parameter, or (-1, t1) if the ray misses the tree
+std::pair<int, double>
+compute_ray_first_collision(const BoundingBoxTree& tree,
+                            const Eigen::Vector3d& origin,
+                            const Eigen::Vector3d& direction, double t0 = 0.0,
+                            double t1 = std::numeric_limits<double>::max());
+
+/// Compute leaf bounding boxes intersected by a batch of rays.
+/// Equivalent to calling compute_ray_collisions once per ray, with the
+/// traversal stack reused across the batch.
+/// @param[in] tree The bounding box tree
+/// @param[in] origin Ray origins, one per row
+/// @param[in] direction Ray directions, one per row
+/// @param[in] t0 Lower bound of the ray parameter
+/// @param[in] t1 Upper bound of the ray parameter
+/// @return Intersected entities for each ray, in CSR form: the hits
+///         for ray i are entities[offsets[i]:offsets[i + 1]], where
+///         (entities, offsets) is the returned pair
+std::pair<std::vector<int>, std::vector<int>> compute_ray_collisions(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& origin,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& direction,
+    double t0 = 0.0, double t1 = std::numeric_limits<double>::max());
+
 /// Compute all collisions between processes and Point returning a
 /// list of process ranks
 std::vector<int> compute_process_collisions(const BoundingBoxTree& tree,
                                             const Eigen::Vector3d& p);
 
+/// Find a cell containing a point. The tree traversal is interleaved
+/// with an exact containment test per leaf (barycentric sign checks
+/// for straight-sided simplices, GJK distance otherwise) and stops at
+/// the first containing cell, so no candidate vector is materialized.
+/// Intended for query-heavy users such as particle loops; the result
+/// matches compute_collisions followed by select_colliding_cells with
+/// n = 1.
+/// @param[in] tree Bounding box tree for the cells of the mesh
+/// @param[in] mesh The mesh
+/// @param[in] p The point
+/// @return Local index of a cell containing the point, or -1 if none
+std::int32_t locate_cell(const BoundingBoxTree& tree, const mesh::Mesh& mesh,
+                         const Eigen::Vector3d& p);
+
+/// Locate the owning process, cell and reference coordinates for a
+/// batch of points. Points found in a cell on the calling process are
+/// resolved locally; the remaining points are forwarded to the
+/// candidate processes identified by the per-process tree, tested
+/// there and the replies gathered back with nonblocking neighborhood
+/// collectives. When more than one process holds a point, the one
+/// with the lowest rank is reported. Collective over the mesh
+/// communicator.
+/// @param[in] tree Bounding box tree for the cells of the mesh
+/// @param[in] mesh The mesh
+/// @param[in] p The points, one per row
+/// @return For each point: the rank owning a colliding cell (-1 if
+///         the point lies outside the mesh on all processes), the
+///         cell index local to that rank (-1 if none) and the
+///         reference coordinates of the point in that cell
+std::tuple<std::vector<int>, std::vector<std::int32_t>,
+           Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+locate_points(const BoundingBoxTree& tree, const mesh::Mesh& mesh,
+              const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                                  Eigen::RowMajor>>& p);
+
 /// Compute closest mesh entity and distance to the point. The tree must
 /// have been initialised with topological co-dimension 0.
 std::pair<int, double>
@@ -75,6 +181,18 @@ double compute_squared_distance_bbox(
 double squared_distance(const mesh::MeshEntity& entity,
                         const Eigen::Vector3d& p);
 
+/// Compute squared distance from a given point to the nearest point on
+/// a mesh entity given by (dim, index). Flat-index variant of
+/// squared_distance(const mesh::MeshEntity&, const Eigen::Vector3d&)
+/// for tight loops, avoiding entity object construction.
+/// @param[in] mesh Mesh
+/// @param[in] dim Topological dimension of the entity
+/// @param[in] index Local index of the entity
+/// @param[in] p Point
+/// @return shortest squared distance from p to entity
+double squared_distance(const mesh::Mesh& mesh, int dim, std::int32_t index,
+                        const Eigen::Vector3d& p);
+
 /// From the given Mesh, select up to n cells from the list which actually
 /// collide with point p. n may be zero (selects all valid cells). Less than n
 /// cells may be returned.
@@ -0,0 +1,132 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "AccessOrdering.h"
+#include "AdjacencyList.h"
+#include <algorithm>
+#include <dolfinx/common/Timer.h>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace dolfinx;
+using namespace dolfinx::graph;
+
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+AccessOrdering::compute_blocked(const AdjacencyList<std::int32_t>& dofmap,
+                                const std::vector<std::int32_t>& trace,
+                                std::int32_t num_cells,
+                                std::int32_t block_size)
+{
+  common::Timer timer("Compute access ordering");
+
+  if (num_cells > dofmap.num_nodes())
+    throw std::runtime_error("Cell count exceeds dofmap size.");
+  if (block_size < 1)
+    throw std::runtime_error("Block size must be positive.");
+  if (num_cells == 0)
+    return {};
+
+  // Visit count per cell and the cells in order of first access
+  std::vector<std::int64_t> visits(num_cells, 0);
+  std::vector<std::int32_t> first_touch;
+  for (std::int32_t c : trace)
+  {
+    if (c >= 0 and c < num_cells and visits[c]++ == 0)
+      first_touch.push_back(c);
+  }
+
+  // Dof-to-cell adjacency (CSR) over the visited cells, so block
+  // growth can find the cells sharing a dof with the block
+  std::int32_t num_dofs = 0;
+  for (std::int32_t c : first_touch)
+  {
+    auto dofs = dofmap.links(c);
+    for (int j = 0; j < dofs.rows(); ++j)
+      num_dofs = std::max(num_dofs, dofs[j] + 1);
+  }
+  std::vector<std::int32_t> dof_offsets(num_dofs + 1, 0);
+  for (std::int32_t c : first_touch)
+  {
+    auto dofs = dofmap.links(c);
+    for (int j = 0; j < dofs.rows(); ++j)
+      ++dof_offsets[dofs[j] + 1];
+  }
+  for (std::int32_t d = 0; d < num_dofs; ++d)
+    dof_offsets[d + 1] += dof_offsets[d];
+  std::vector<std::int32_t> dof_cells(dof_offsets.back());
+  {
+    std::vector<std::int32_t> pos(dof_offsets.begin(), dof_offsets.end() - 1);
+    for (std::int32_t c : first_touch)
+    {
+      auto dofs = dofmap.links(c);
+      for (int j = 0; j < dofs.rows(); ++j)
+        dof_cells[pos[dofs[j]]++] = c;
+    }
+  }
+
+  // Grow blocks greedily: seed in first-access order, then repeatedly
+  // add the unplaced cell with the highest affinity to the block
+  // (visit-weighted count of dofs shared with cells already placed in
+  // the block)
+  std::vector<std::int32_t> perm(num_cells, -1);
+  std::int32_t next = 0;
+  std::unordered_map<std::int32_t, std::int64_t> score;
+  for (std::int32_t seed : first_touch)
+  {
+    if (perm[seed] != -1)
+      continue;
+
+    score.clear();
+    std::int32_t current = seed;
+    std::int32_t block_count = 0;
+    while (true)
+    {
+      perm[current] = next++;
+      ++block_count;
+
+      // Open the dofs of the added cell towards its unplaced sharers
+      auto dofs = dofmap.links(current);
+      for (int j = 0; j < dofs.rows(); ++j)
+      {
+        for (std::int32_t k = dof_offsets[dofs[j]];
+             k < dof_offsets[dofs[j] + 1]; ++k)
+        {
+          const std::int32_t other = dof_cells[k];
+          if (perm[other] == -1)
+            score[other] += visits[other];
+        }
+      }
+      score.erase(current);
+
+      if (block_count == block_size or score.empty())
+        break;
+
+      // Highest score wins; ties go to the lower cell index so the
+      // ordering is deterministic
+      auto best = score.begin();
+      for (auto it = std::next(score.begin()); it != score.end(); ++it)
+      {
+        if (it->second > best->second
+            or (it->second == best->second and it->first < best->first))
+        {
+          best = it;
+        }
+      }
+      current = best->first;
+    }
+  }
+
+  // Cells the trace never touched keep their relative order at the end
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    if (perm[c] == -1)
+      perm[c] = next++;
+  }
+
+  return perm;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,48 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx::graph
+{
+
+template <typename T>
+class AdjacencyList;
+
+/// Cell re-orderings computed from recorded access traces (see
+/// fem::AssemblyTrace), complementing the static orderings in
+/// BoostGraphOrdering.
+
+class AccessOrdering
+{
+public:
+  /// Compute a locality-optimized re-ordering (map[old] -> new) of the
+  /// cells from a recorded access trace. Cells are grouped greedily
+  /// into blocks of @p block_size: blocks are seeded in first-access
+  /// order and grown by repeatedly adding the unplaced cell sharing
+  /// the most dofs with the block, weighted by how often the trace
+  /// visits it, so cells whose dof gathers touch the same cache lines
+  /// end up adjacent even when the trace visits them far apart (e.g.
+  /// in different integral domains). Cells never visited by the trace
+  /// are appended in their original order. Apply the permutation with
+  /// mesh::reorder_cells.
+  /// @param[in] dofmap Cell-to-dof connectivity the trace gathered
+  ///   through
+  /// @param[in] trace The recorded cell access sequence
+  /// @param[in] num_cells Number of cells to permute (owned cells);
+  ///   trace entries outside [0, num_cells) are ignored
+  /// @param[in] block_size Target number of cells per locality block.
+  ///   Choose so a block's dofs fit the target cache level.
+  /// @return Map from old to new cell index
+  static std::vector<std::int32_t>
+  compute_blocked(const AdjacencyList<std::int32_t>& dofmap,
+                  const std::vector<std::int32_t>& trace,
+                  std::int32_t num_cells, std::int32_t block_size = 64);
+};
+} // namespace dolfinx::graph
@@ -12,6 +12,7 @@
 #include <numeric>
 #include <sstream>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::graph
@@ -22,6 +23,10 @@ namespace dolfinx::graph
 /// contiguous list of nodes [0, 1, 2, ..., n) it stores the connected
 /// nodes. The representation is strictly local, i.e. it is not parallel
 /// aware.
+///
+/// Data and offsets are held in std::vector buffers, so builders that
+/// accumulate into vectors can move their results in without a copy;
+/// array() and offsets() expose the buffers as Eigen maps.
 
 template <typename T>
 class AdjacencyList
@@ -32,39 +37,35 @@ public:
   /// @param [in] n Number of nodes
   explicit AdjacencyList(const std::int32_t n) : _array(n), _offsets(n + 1)
   {
-    std::iota(_array.data(), _array.data() + n, 0);
-    std::iota(_offsets.data(), _offsets.data() + n + 1, 0);
+    std::iota(_array.begin(), _array.end(), 0);
+    std::iota(_offsets.begin(), _offsets.end(), 0);
   }
 
-  /// Construct adjacency list from arrays of data (Eigen data types)
+  /// Construct adjacency list from vector buffers, taking ownership of
+  /// the caller's data without copying
   /// @param [in] data Adjacency array
   /// @param [in] offsets The index to the adjacency list in the data
   ///   array for node i
-  template <typename U, typename V,
-            std::enable_if_t<std::is_base_of<Eigen::EigenBase<std::decay_t<V>>,
-                                             std::decay_t<V>>::value,
-                             int> = 0>
-  AdjacencyList(U&& data, V&& offsets)
-      : _array(std::forward<U>(data)), _offsets(std::forward<V>(offsets))
+  AdjacencyList(std::vector<T>&& data, std::vector<std::int32_t>&& offsets)
+      : _array(std::move(data)), _offsets(std::move(offsets))
   {
-    // Do nothing
+    assert(!_offsets.empty());
+    assert(_offsets.back() == (std::int32_t)_array.size());
   }
 
-  /// Construct adjacency list from arrays of data  (non-Eigen data
-  /// types)
+  /// Construct adjacency list from arrays of data (Eigen data types,
+  /// containers with begin()/end(), or std::vector, which is moved
+  /// from when passed as an rvalue)
   /// @param [in] data Adjacency array
   /// @param [in] offsets The index to the adjacency list in the data
   ///   array for node i
-  template <typename U, typename V,
-            std::enable_if_t<!std::is_base_of<Eigen::EigenBase<std::decay_t<V>>,
-                                              std::decay_t<V>>::value,
-                             int> = 0>
+  template <typename U, typename V>
   AdjacencyList(U&& data, V&& offsets)
-      : _array(data.size()), _offsets(offsets.size())
+      : _array(to_vector<T>(std::forward<U>(data))),
+        _offsets(to_vector<std::int32_t>(std::forward<V>(offsets)))
   {
-    assert(offsets.back() == (std::int32_t)data.size());
-    std::copy(data.begin(), data.end(), _array.data());
-    std::copy(offsets.begin(), offsets.end(), _offsets.data());
+    assert(!_offsets.empty());
+    assert(_offsets.back() == (std::int32_t)_array.size());
   }
 
   /// Construct adjacency list for a problem with a fixed number of
@@ -77,13 +78,14 @@ public:
       : _array(matrix.rows() * matrix.cols()), _offsets(matrix.rows() + 1)
   {
     const std::int32_t num_links = matrix.cols();
-    for (Eigen::Index e = 0; e < _offsets.rows(); e++)
+    for (std::size_t e = 0; e < _offsets.size(); e++)
       _offsets[e] = e * num_links;
 
     // NOTE: Do not directly copy data from matrix because it may be a
     // view into a larger array
     for (Eigen::Index i = 0; i < matrix.rows(); ++i)
-      _array.segment(_offsets(i), num_links) = matrix.row(i);
+      for (std::int32_t j = 0; j < num_links; ++j)
+        _array[i * num_links + j] = matrix(i, j);
   }
 
   /// Set all connections for all entities (T is a '2D' container, e.g.
@@ -102,13 +104,12 @@ public:
     }
     _offsets[data.size()] = size;
 
-    std::vector<T> c;
-    c.reserve(size);
+    // Copy the node data directly into the final array, avoiding an
+    // intermediate buffer
+    _array.resize(size);
+    T* ptr = _array.data();
     for (auto e = data.begin(); e != data.end(); ++e)
-      c.insert(c.end(), e->begin(), e->end());
-
-    _array = Eigen::Array<T, Eigen::Dynamic, 1>(c.size());
-    std::copy(c.begin(), c.end(), _array.data());
+      ptr = std::copy(e->begin(), e->end(), ptr);
   }
 
   /// Copy constructor
@@ -129,20 +130,19 @@ public:
   /// Equality operator
   bool operator==(const AdjacencyList& list) const
   {
-    return (this->_array == list._array).all()
-           and (this->_offsets == list._offsets).all();
+    return this->_array == list._array and this->_offsets == list._offsets;
   }
 
   /// Number of nodes
   /// @return The number of nodes
-  std::int32_t num_nodes() const { return _offsets.rows() - 1; }
+  std::int32_t num_nodes() const { return _offsets.size() - 1; }
 
   /// Number of connections for given node
   /// @param [in] node Node index
   /// @return The number of outgoing links (edges) from the node
   int num_links(int node) const
   {
-    assert((node + 1) < _offsets.rows());
+    assert((std::size_t)(node + 1) < _offsets.size());
     return _offsets[node + 1] - _offsets[node];
   }
 
@@ -150,34 +150,41 @@ public:
   /// @param [in] node Node index
   /// @return Array of outgoing links for the node. The length will be
   ///   AdjacencyList:num_links(node).
-  typename Eigen::Array<T, Eigen::Dynamic, 1>::SegmentReturnType links(int node)
+  Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>> links(int node)
   {
-    return _array.segment(_offsets[node], _offsets[node + 1] - _offsets[node]);
+    return Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>(
+        _array.data() + _offsets[node], _offsets[node + 1] - _offsets[node]);
   }
 
   /// Links (edges) for given node (const version)
   /// @param [in] node Node index
   /// @return Array of outgoing links for the node. The length will be
   ///   AdjacencyList:num_links(node).
-  typename Eigen::Array<T, Eigen::Dynamic, 1>::ConstSegmentReturnType
-  links(int node) const
+  Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>> links(int node) const
   {
-    return _array.segment(_offsets[node], _offsets[node + 1] - _offsets[node]);
+    return Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>(
+        _array.data() + _offsets[node], _offsets[node + 1] - _offsets[node]);
   }
 
   /// TODO: attempt to remove
   const std::int32_t* links_ptr(int node) const
   {
-    return &_array[_offsets[node]];
+    return _array.data() + _offsets[node];
   }
 
   /// Return contiguous array of links for all nodes (const version)
-  const Eigen::Array<T, Eigen::Dynamic, 1>& array() const { return _array; }
+  Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>> array() const
+  {
+    return Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>(_array.data(),
+                                                                _array.size());
+  }
 
   /// Offset for each node in array() (const version)
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& offsets() const
+  Eigen::Map<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>
+  offsets() const
   {
-    return _offsets;
+    return Eigen::Map<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>(
+        _offsets.data(), _offsets.size());
   }
 
   /// Hash of graph
@@ -192,16 +199,33 @@ public:
     std::stringstream s;
     s << "<AdjacencyList> with " + std::to_string(this->num_nodes()) + " nodes"
       << std::endl;
-    for (Eigen::Index e = 0; e < _offsets.size() - 1; e++)
+    for (std::size_t e = 0; e < _offsets.size() - 1; e++)
       s << "  " << e << ": " << this->links(e).transpose() << std::endl;
     return s.str();
   }
 
 private:
+  // Normalize constructor input to a vector: move std::vector rvalues,
+  // evaluate Eigen expressions, copy other containers element-wise
+  template <typename W, typename C>
+  static std::vector<W> to_vector(C&& c)
+  {
+    if constexpr (std::is_same<std::decay_t<C>, std::vector<W>>::value)
+      return std::forward<C>(c);
+    else if constexpr (std::is_base_of<Eigen::EigenBase<std::decay_t<C>>,
+                                       std::decay_t<C>>::value)
+    {
+      const auto e = c.eval();
+      return std::vector<W>(e.data(), e.data() + e.size());
+    }
+    else
+      return std::vector<W>(c.begin(), c.end());
+  }
+
   // Connections for all entities stored as a contiguous array
-  Eigen::Array<T, Eigen::Dynamic, 1> _array;
+  std::vector<T> _array;
 
   // Position of first connection for each entity (using local index)
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _offsets;
+  std::vector<std::int32_t> _offsets;
 }; // namespace graph
 } // namespace dolfinx::graph
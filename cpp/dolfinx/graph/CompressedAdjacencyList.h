@@ -0,0 +1,203 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "AdjacencyList.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx::graph
+{
+
+/// A compressed, immutable version of AdjacencyList. The links of each
+/// node are stored as zig-zag encoded variable-length integers of the
+/// deltas between consecutive links, which after a locality-improving
+/// node ordering are typically small and encode in one or two bytes
+/// instead of four. The list can be traversed one node at a time with
+/// for_each_node (block decode, no per-node offset chasing) or
+/// rehydrated in full with decompress(). Random access to a single node
+/// is supported but requires decoding that node's links.
+
+template <typename T>
+class CompressedAdjacencyList
+{
+public:
+  /// Compress an adjacency list
+  /// @param[in] list The adjacency list to compress
+  explicit CompressedAdjacencyList(const AdjacencyList<T>& list)
+      : _offsets(list.num_nodes() + 1, 0)
+  {
+    // Guess two bytes per link to limit re-allocation during encoding
+    _data.reserve(2 * list.array().rows());
+    for (std::int32_t n = 0; n < list.num_nodes(); ++n)
+    {
+      auto links = list.links(n);
+      encode_varint(links.rows());
+      std::int64_t previous = 0;
+      for (Eigen::Index i = 0; i < links.rows(); ++i)
+      {
+        encode_varint(zigzag(static_cast<std::int64_t>(links[i]) - previous));
+        previous = links[i];
+      }
+      _offsets[n + 1] = _data.size();
+    }
+    _data.shrink_to_fit();
+  }
+
+  /// Copy constructor
+  CompressedAdjacencyList(const CompressedAdjacencyList& list) = default;
+
+  /// Move constructor
+  CompressedAdjacencyList(CompressedAdjacencyList&& list) = default;
+
+  /// Destructor
+  ~CompressedAdjacencyList() = default;
+
+  /// Number of nodes
+  /// @return The number of nodes
+  std::int32_t num_nodes() const { return _offsets.size() - 1; }
+
+  /// Number of connections for given node
+  /// @param [in] node Node index
+  /// @return The number of outgoing links (edges) from the node
+  int num_links(int node) const
+  {
+    assert(node + 1 < (int)_offsets.size());
+    std::size_t pos = _offsets[node];
+    return decode_varint(pos);
+  }
+
+  /// Decode the links of a node
+  /// @param[in] node Node index
+  /// @param[out] buffer Storage for the decoded links. Must have room
+  ///   for at least num_links(node) values.
+  /// @return The number of decoded links
+  int links(int node, T* buffer) const
+  {
+    assert(node + 1 < (int)_offsets.size());
+    std::size_t pos = _offsets[node];
+    return decode_node(pos, buffer);
+  }
+
+  /// Traverse all nodes in order, decoding the links of one node at a
+  /// time into an internal buffer. The callable is invoked as f(node,
+  /// links, num_links); the links pointer is only valid during the
+  /// call. This is the preferred access pattern for assembly-style
+  /// loops over a compressed list.
+  template <typename Fn>
+  void for_each_node(Fn&& f) const
+  {
+    std::vector<T> buffer;
+    std::size_t pos = 0;
+    for (std::int32_t n = 0; n < num_nodes(); ++n)
+    {
+      std::size_t peek = pos;
+      const int num_links = decode_varint(peek);
+      buffer.resize(num_links);
+      decode_node(pos, buffer.data());
+      f(n, buffer.data(), num_links);
+    }
+  }
+
+  /// Rehydrate the full adjacency list
+  /// @return The uncompressed adjacency list
+  AdjacencyList<T> decompress() const
+  {
+    std::vector<std::int32_t> offsets(num_nodes() + 1, 0);
+    std::size_t pos = 0;
+    for (std::int32_t n = 0; n < num_nodes(); ++n)
+    {
+      std::size_t peek = pos;
+      offsets[n + 1] = offsets[n] + decode_varint(peek);
+      skip_node(pos);
+    }
+
+    std::vector<T> array(offsets.back());
+    pos = 0;
+    for (std::int32_t n = 0; n < num_nodes(); ++n)
+      decode_node(pos, array.data() + offsets[n]);
+
+    return AdjacencyList<T>(array, offsets);
+  }
+
+  /// Size of the compressed link data in bytes
+  std::size_t num_bytes() const
+  {
+    return _data.size() + _offsets.size() * sizeof(std::size_t);
+  }
+
+private:
+  // Map a signed value to an unsigned value with small absolute values
+  // mapped to small codes
+  static std::uint64_t zigzag(std::int64_t value)
+  {
+    return (static_cast<std::uint64_t>(value) << 1)
+           ^ static_cast<std::uint64_t>(value >> 63);
+  }
+
+  // Inverse of zigzag
+  static std::int64_t unzigzag(std::uint64_t code)
+  {
+    return static_cast<std::int64_t>(code >> 1)
+           ^ -static_cast<std::int64_t>(code & 1);
+  }
+
+  // Append a variable-length encoded value to the data stream
+  void encode_varint(std::uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      _data.push_back(static_cast<std::uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    _data.push_back(static_cast<std::uint8_t>(value));
+  }
+
+  // Decode a variable-length encoded value, advancing pos
+  std::uint64_t decode_varint(std::size_t& pos) const
+  {
+    std::uint64_t value = 0;
+    int shift = 0;
+    while (_data[pos] & 0x80)
+    {
+      value |= static_cast<std::uint64_t>(_data[pos++] & 0x7f) << shift;
+      shift += 7;
+    }
+    value |= static_cast<std::uint64_t>(_data[pos++]) << shift;
+    return value;
+  }
+
+  // Decode the links of the node starting at pos into buffer, advancing
+  // pos past the node. Returns the number of links.
+  int decode_node(std::size_t& pos, T* buffer) const
+  {
+    const int num_links = decode_varint(pos);
+    std::int64_t value = 0;
+    for (int i = 0; i < num_links; ++i)
+    {
+      value += unzigzag(decode_varint(pos));
+      buffer[i] = static_cast<T>(value);
+    }
+    return num_links;
+  }
+
+  // Advance pos past the node starting at pos
+  void skip_node(std::size_t& pos) const
+  {
+    const int num_links = decode_varint(pos);
+    for (int i = 0; i < num_links; ++i)
+      decode_varint(pos);
+  }
+
+  // Encoded link data for all nodes
+  std::vector<std::uint8_t> _data;
+
+  // Byte position in _data of the start of each node
+  std::vector<std::size_t> _offsets;
+};
+} // namespace dolfinx::graph
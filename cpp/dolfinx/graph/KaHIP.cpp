@@ -130,10 +130,8 @@ graph::AdjacencyList<std::int32_t> dolfinx::graph::KaHIP::partition(
     for (int p = 0; p < recv_cell_partition.rows(); p += 2)
       cell_ownership[recv_cell_partition[p]] = recv_cell_partition[p + 1];
 
-    const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& xadj
-        = adj_graph.offsets();
-    const Eigen::Array<unsigned long long, Eigen::Dynamic, 1>& adjncy
-        = adj_graph.array();
+    const auto xadj = adj_graph.offsets();
+    const auto adjncy = adj_graph.array();
 
     // Generate map for where new boundary cells need to be sent
     for (std::int32_t i = 0; i < ncells; i++)
@@ -5,8 +5,10 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "ParMETIS.h"
+#include <algorithm>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
+#include <numeric>
 
 #ifdef HAS_PARMETIS
 #include <parmetis.h>
@@ -19,55 +21,6 @@ namespace
 {
 //-----------------------------------------------------------------------------
 template <typename T>
-std::vector<int> adaptive_repartition(MPI_Comm mpi_comm,
-                                      const graph::AdjacencyList<T>& adj_graph,
-                                      double weight)
-{
-  common::Timer timer(
-      "Compute graph partition (ParMETIS Adaptive Repartition)");
-
-  // Options for ParMETIS
-  idx_t options[4];
-  options[0] = 1;
-  options[1] = 0;
-  options[2] = 15;
-  options[3] = PARMETIS_PSR_UNCOUPLED;
-  // For repartition, PARMETIS_PSR_COUPLED seems to suppress all
-  // migration if already balanced.  Try PARMETIS_PSR_UNCOUPLED for
-  // better edge cut.
-
-  common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
-  real_t _itr = weight;
-  std::vector<idx_t> part(adj_graph.num_nodes());
-  std::vector<idx_t> vsize(part.size(), 1);
-  assert(!part.empty());
-
-  // Number of partitions (one for each process)
-  idx_t nparts = dolfinx::MPI::size(mpi_comm);
-
-  // Remaining ParMETIS parameters
-  idx_t ncon = 1;
-  idx_t* elmwgt = nullptr;
-  idx_t wgtflag = 0;
-  idx_t edgecut = 0;
-  idx_t numflag = 0;
-  std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
-  std::vector<real_t> ubvec(ncon, 1.05);
-
-  // Call ParMETIS to repartition graph
-  int err = ParMETIS_V3_AdaptiveRepart(
-      adj_graph.node_distribution().data(), adj_graph.nodes().data(),
-      adj_graph.edges().data(), elmwgt, nullptr, vsize.data(), &wgtflag,
-      &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), &_itr, options,
-      &edgecut, part.data(), &mpi_comm);
-  assert(err == METIS_OK);
-  timer1.stop();
-
-  // Copy cell partition data and return
-  return std::vector<int>(part.begin(), part.end());
-}
-//-----------------------------------------------------------------------------
-template <typename T>
 std::vector<int> refine(MPI_Comm mpi_comm,
                         const graph::AdjacencyList<T>& adj_graph)
 {
@@ -239,9 +192,8 @@ graph::AdjacencyList<std::int32_t> dolfinx::graph::ParMETIS::partition(
     for (int p = 0; p < recv_cell_partition.rows(); p += 2)
       cell_ownership[recv_cell_partition[p]] = recv_cell_partition[p + 1];
 
-    const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& xadj
-        = adj_graph.offsets();
-    const Eigen::Array<idx_t, Eigen::Dynamic, 1>& adjncy = adj_graph.array();
+    const auto xadj = adj_graph.offsets();
+    const auto adjncy = adj_graph.array();
 
     // Generate map for where new boundary cells need to be sent
     for (std::int32_t i = 0; i < ncells; i++)
@@ -285,4 +237,70 @@ graph::AdjacencyList<std::int32_t> dolfinx::graph::ParMETIS::partition(
   return graph::AdjacencyList<std::int32_t>(dests, offsets);
 }
 //-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> dolfinx::graph::ParMETIS::adaptive_repartition(
+    MPI_Comm mpi_comm, const graph::AdjacencyList<idx_t>& adj_graph, double itr)
+{
+  common::Timer timer(
+      "Compute graph partition (ParMETIS Adaptive Repartition)");
+
+  const int rank = dolfinx::MPI::rank(mpi_comm);
+  const int size = dolfinx::MPI::size(mpi_comm);
+
+  // Options for ParMETIS. For repartition, PARMETIS_PSR_COUPLED seems
+  // to suppress all migration if already balanced. Try
+  // PARMETIS_PSR_UNCOUPLED for better edge cut.
+  idx_t options[4];
+  options[0] = 1;
+  options[1] = 0;
+  options[2] = 15;
+  options[3] = PARMETIS_PSR_UNCOUPLED;
+
+  // Number of partitions (one for each process)
+  idx_t nparts = size;
+
+  // Remaining ParMETIS parameters
+  idx_t ncon = 1;
+  idx_t* elmwgt = nullptr;
+  idx_t wgtflag = 0;
+  idx_t edgecut = 0;
+  idx_t numflag = 0;
+  std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
+  std::vector<real_t> ubvec(ncon, 1.05);
+  real_t _itr = itr;
+
+  // Communicate number of nodes between all processors
+  std::vector<idx_t> node_distribution(size);
+  const idx_t num_local_cells = adj_graph.num_nodes();
+  MPI_Allgather(&num_local_cells, 1, MPI::mpi_type<idx_t>(),
+                node_distribution.data(), 1, MPI::mpi_type<idx_t>(), mpi_comm);
+  node_distribution.insert(node_distribution.begin(), 0);
+  for (std::size_t i = 1; i != node_distribution.size(); ++i)
+    node_distribution[i] += node_distribution[i - 1];
+
+  // The current partition is the current distribution: each node is
+  // on its owning process
+  std::vector<idx_t> part(std::max<std::int32_t>(1, num_local_cells), rank);
+  std::vector<idx_t> vsize(part.size(), 1);
+
+  // Call ParMETIS to repartition graph. ParMETIS is not const-correct,
+  // so we throw away const-ness and trust ParMETIS.
+  common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
+  int err = ParMETIS_V3_AdaptiveRepart(
+      const_cast<idx_t*>(node_distribution.data()),
+      const_cast<idx_t*>(adj_graph.offsets().data()),
+      const_cast<idx_t*>(adj_graph.array().data()), elmwgt, nullptr,
+      vsize.data(), &wgtflag, &numflag, &ncon, &nparts, tpwgts.data(),
+      ubvec.data(), &_itr, options, &edgecut, part.data(), &mpi_comm);
+  assert(err == METIS_OK);
+  timer1.stop();
+
+  // Copy cell partition data (one destination per node)
+  std::vector<std::int32_t> dests(part.begin(),
+                                  part.begin() + num_local_cells);
+  std::vector<std::int32_t> offsets(num_local_cells + 1);
+  std::iota(offsets.begin(), offsets.end(), 0);
+  return graph::AdjacencyList<std::int32_t>(dests, offsets);
+}
+//-----------------------------------------------------------------------------
 #endif
@@ -31,6 +31,23 @@ public:
   partition(MPI_Comm mpi_comm, idx_t nparts,
             const AdjacencyList<idx_t>& adj_graph, bool ghosting);
 
+  /// Incremental (diffusive) repartition with ParMETIS AdaptiveRepart.
+  /// Starts from the current distribution of the graph (one part per
+  /// process) and migrates only what is needed to restore balance,
+  /// preserving the locality of untouched regions. Intended for
+  /// adaptive refinement cycles, where a from-scratch partition would
+  /// move nearly every cell.
+  /// @param[in] mpi_comm MPI Communicator
+  /// @param[in] adj_graph Distributed node connectivity graph
+  /// @param[in] itr Ratio of inter-process communication time to data
+  ///   redistribution time. Larger values favour less migration (the
+  ///   ParMETIS manual suggests values between 100 and 1000 when
+  ///   migration is expensive)
+  /// @return Destination rank for each input node
+  static AdjacencyList<std::int32_t>
+  adaptive_repartition(MPI_Comm mpi_comm, const AdjacencyList<idx_t>& adj_graph,
+                       double itr = 1000.0);
+
 #endif
 };
 } // namespace dolfinx::graph
@@ -7,10 +7,15 @@
 #include "Partitioning.h"
 #include <Eigen/Dense>
 #include <algorithm>
+#include <dolfinx/common/ArenaAllocator.h>
+#include <dolfinx/common/CommTracer.h>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/types.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/RedistributionPlan.h>
 #include <dolfinx/graph/SCOTCH.h>
+#include <map>
 #include <unordered_map>
 
 using namespace dolfinx;
@@ -40,8 +45,16 @@ Partitioning::reorder_global_indices(
   MPI_Allreduce(&my_max_global_index, &max_global_index, 1, MPI_INT64_T,
                 MPI_MAX, comm);
 
-  // Create global ->local map
-  std::unordered_map<std::int64_t, std::int32_t> global_to_local;
+  // Create global->local map, arena-backed: the map nodes all die when
+  // this routine returns, so individual frees are skipped
+  common::Arena arena;
+  std::unordered_map<
+      std::int64_t, std::int32_t, std::hash<std::int64_t>,
+      std::equal_to<std::int64_t>,
+      common::ArenaAllocator<std::pair<const std::int64_t, std::int32_t>>>
+      global_to_local{
+          common::ArenaAllocator<std::pair<const std::int64_t, std::int32_t>>(
+              arena)};
   for (std::size_t i = 0; i < global_indices.size(); ++i)
     global_to_local.insert({global_indices[i], i});
 
@@ -359,8 +372,8 @@ std::pair<graph::AdjacencyList<std::int32_t>, std::vector<std::int64_t>>
 Partitioning::create_local_adjacency_list(
     const graph::AdjacencyList<std::int64_t>& cells)
 {
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& array = cells.array();
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> array_local(array.rows());
+  const auto array = cells.array();
+  std::vector<std::int32_t> array_local(array.rows());
 
   // Re-map global to local
   int local = 0;
@@ -399,10 +412,9 @@ Partitioning::create_distributed_adjacency_list(
   const auto [local_to_local_new, ghosts, ghost_owners]
       = reorder_global_indices(comm, local_to_global_links, shared_links);
 
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& data_old
-      = list_local.array();
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> data_new(data_old.rows());
-  for (int i = 0; i < data_new.rows(); ++i)
+  const auto data_old = list_local.array();
+  std::vector<std::int32_t> data_new(data_old.rows());
+  for (std::size_t i = 0; i < data_new.size(); ++i)
     data_new[i] = local_to_local_new[data_old[i]];
 
   const int num_owned_vertices = local_to_local_new.size() - ghosts.size();
@@ -418,110 +430,120 @@ Partitioning::distribute(MPI_Comm comm,
                          const graph::AdjacencyList<std::int32_t>& destinations)
 {
   common::Timer timer("Distribute AdjacencyList");
+  common::CommTracer::Phase phase("mesh distribution");
 
   assert(list.num_nodes() == (int)destinations.num_nodes());
   const std::int64_t offset_global
       = dolfinx::MPI::global_offset(comm, list.num_nodes(), true);
 
-  const int size = dolfinx::MPI::size(comm);
-  // Compute number of links to send to each process
-  std::vector<int> num_per_dest_send(size, 0);
+  // Build the exchange plan: one item of (num_links + 3) elements per
+  // (node, destination) pair
+  std::vector<int> item_dest;
+  std::vector<std::int32_t> item_size;
+  std::vector<std::int32_t> item_node;
   for (int i = 0; i < destinations.num_nodes(); ++i)
   {
     const auto& dests = destinations.links(i);
     for (int j = 0; j < destinations.num_links(i); ++j)
-      num_per_dest_send[dests[j]] += list.num_links(i) + 3;
-  }
-
-  // Compute send array displacements
-  std::vector<int> disp_send(size + 1, 0);
-  std::partial_sum(num_per_dest_send.begin(), num_per_dest_send.end(),
-                   disp_send.begin() + 1);
-
-  // Send/receive number of items to communicate
-  std::vector<int> num_per_dest_recv(size, 0);
-  MPI_Alltoall(num_per_dest_send.data(), 1, MPI_INT, num_per_dest_recv.data(),
-               1, MPI_INT, comm);
-
-  // Compute receive array displacements
-  std::vector<int> disp_recv(size + 1, 0);
-  std::partial_sum(num_per_dest_recv.begin(), num_per_dest_recv.end(),
-                   disp_recv.begin() + 1);
-
-  // Prepare send buffer
-  std::vector<int> offset = disp_send;
-  std::vector<std::int64_t> data_send(disp_send.back());
-  for (int i = 0; i < list.num_nodes(); ++i)
-  {
-    const auto& dests = destinations.links(i);
-    for (std::int32_t j = 0; j < destinations.num_links(i); ++j)
     {
-      std::int32_t dest = dests[j];
-      auto links = list.links(i);
-      data_send[offset[dest]++] = dests[0];
-      data_send[offset[dest]++] = i + offset_global;
-      data_send[offset[dest]++] = links.rows();
-      for (int k = 0; k < links.rows(); ++k)
-        data_send[offset[dest]++] = links(k);
+      item_dest.push_back(dests[j]);
+      item_size.push_back(list.num_links(i) + 3);
+      item_node.push_back(i);
     }
   }
+  graph::RedistributionPlan plan(comm, item_dest, item_size);
 
-  // Send/receive data
-  std::vector<std::int64_t> data_recv(disp_recv.back());
-  MPI_Alltoallv(data_send.data(), num_per_dest_send.data(), disp_send.data(),
-                MPI_INT64_T, data_recv.data(), num_per_dest_recv.data(),
-                disp_recv.data(), MPI_INT64_T, comm);
+  // Per-source unpacked blocks, keyed on the source rank so the
+  // concatenation below runs in rank order and the result is identical
+  // to a synchronous exchange
+  const int mpi_rank = MPI::rank(comm);
+  struct UnpackedBlock
+  {
+    int src;
+    std::vector<std::int64_t> array, ghost_array;
+    std::vector<std::int64_t> global_indices, ghost_global_indices;
+    std::vector<std::int32_t> num_links, ghost_num_links;
+    std::vector<int> ghost_index_owner;
+  };
+  std::map<int, UnpackedBlock> blocks_map;
+
+  // Execute the exchange: pack [owner, global index, num_links,
+  // links...] per item, and unpack the block of each source rank as
+  // its message arrives (overlapping the messages still in flight)
+  plan.execute<std::int64_t>(
+      1,
+      [&](std::size_t m, std::int64_t* buf) {
+        const std::int32_t i = item_node[m];
+        auto links = list.links(i);
+        *buf++ = destinations.links(i)[0];
+        *buf++ = i + offset_global;
+        *buf++ = links.rows();
+        for (int k = 0; k < links.rows(); ++k)
+          *buf++ = links(k);
+      },
+      [&](int p, const std::int64_t* data, std::size_t n) {
+        UnpackedBlock& block = blocks_map[p];
+        block.src = p;
+        for (std::size_t i = 0; i < n;)
+        {
+          if (data[i] == mpi_rank)
+          {
+            i++;
+            block.global_indices.push_back(data[i++]);
+            const std::int64_t num_links = data[i++];
+            for (int j = 0; j < num_links; ++j)
+              block.array.push_back(data[i++]);
+            block.num_links.push_back(num_links);
+          }
+          else
+          {
+            block.ghost_index_owner.push_back(data[i++]);
+            block.ghost_global_indices.push_back(data[i++]);
+            const std::int64_t num_links = data[i++];
+            for (int j = 0; j < num_links; ++j)
+              block.ghost_array.push_back(data[i++]);
+            block.ghost_num_links.push_back(num_links);
+          }
+        }
+      });
 
-  // Unpack receive buffer
-  int mpi_rank = MPI::rank(comm);
+  // Concatenate the blocks in rank order, owned nodes first
   std::vector<std::int64_t> array;
-  std::vector<std::int64_t> ghost_array;
   std::vector<std::int64_t> global_indices;
-  std::vector<std::int64_t> ghost_global_indices;
   std::vector<std::int32_t> list_offset = {0};
-  std::vector<std::int32_t> ghost_list_offset = {0};
   std::vector<int> src;
   std::vector<int> ghost_src;
   std::vector<int> ghost_index_owner;
-
-  for (std::size_t p = 0; p < disp_recv.size() - 1; ++p)
+  for (const auto& [p, block] : blocks_map)
   {
-    for (int i = disp_recv[p]; i < disp_recv[p + 1];)
-    {
-      if (data_recv[i] == mpi_rank)
-      {
-        src.push_back(p);
-        i++; // index_owner.push_back(data_recv[i++]);
-        global_indices.push_back(data_recv[i++]);
-        const std::int64_t num_links = data_recv[i++];
-        for (int j = 0; j < num_links; ++j)
-          array.push_back(data_recv[i++]);
-        list_offset.push_back(list_offset.back() + num_links);
-      }
-      else
-      {
-        ghost_src.push_back(p);
-        ghost_index_owner.push_back(data_recv[i++]);
-        ghost_global_indices.push_back(data_recv[i++]);
-        const std::int64_t num_links = data_recv[i++];
-        for (int j = 0; j < num_links; ++j)
-          ghost_array.push_back(data_recv[i++]);
-        ghost_list_offset.push_back(ghost_list_offset.back() + num_links);
-      }
-    }
+    src.insert(src.end(), block.global_indices.size(), p);
+    global_indices.insert(global_indices.end(), block.global_indices.begin(),
+                          block.global_indices.end());
+    array.insert(array.end(), block.array.begin(), block.array.end());
+    for (std::int32_t n : block.num_links)
+      list_offset.push_back(list_offset.back() + n);
+    ghost_src.insert(ghost_src.end(), block.ghost_global_indices.size(), p);
+    ghost_index_owner.insert(ghost_index_owner.end(),
+                             block.ghost_index_owner.begin(),
+                             block.ghost_index_owner.end());
   }
 
   // Attach all ghost cells at the end of the list
+  for (const auto& [p, block] : blocks_map)
+  {
+    global_indices.insert(global_indices.end(),
+                          block.ghost_global_indices.begin(),
+                          block.ghost_global_indices.end());
+    array.insert(array.end(), block.ghost_array.begin(),
+                 block.ghost_array.end());
+    for (std::int32_t n : block.ghost_num_links)
+      list_offset.push_back(list_offset.back() + n);
+  }
   src.insert(src.end(), ghost_src.begin(), ghost_src.end());
-  global_indices.insert(global_indices.end(), ghost_global_indices.begin(),
-                        ghost_global_indices.end());
-  array.insert(array.end(), ghost_array.begin(), ghost_array.end());
-  int ghost_offset = list_offset.back();
-  list_offset.pop_back();
-  for (int& offset : ghost_list_offset)
-    offset += ghost_offset;
-  list_offset.insert(list_offset.end(), ghost_list_offset.begin(),
-                     ghost_list_offset.end());
+
+  // The adjacency offsets are local indices; fail loudly rather than
+  // wrap when the received lists approach the local index limit
+  common::narrow_index(array.size());
 
   return {graph::AdjacencyList<std::int64_t>(array, list_offset),
           std::move(src), std::move(global_indices),
@@ -659,8 +681,8 @@ std::vector<std::int64_t> Partitioning::compute_local_to_global_links(
                              "global adjacency lists.");
   }
 
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& _global = global.array();
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& _local = local.array();
+  const auto _global = global.array();
+  const auto _local = local.array();
   if (_global.rows() != _local.rows())
   {
     throw std::runtime_error("Data size mismatch between local and "
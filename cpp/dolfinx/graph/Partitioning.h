@@ -123,6 +123,30 @@ public:
                   const Eigen::Ref<const Eigen::Array<
                       T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>& x);
 
+  /// Distribute multiple row-wise data arrays that share the same
+  /// global index request in a single exchange. Equivalent to calling
+  /// the single-array distribute_data once per array, but the index
+  /// request round is performed once and the replies are packed into
+  /// one buffer, so the number of large collectives does not grow with
+  /// the number of payloads. All arrays must have the same number of
+  /// rows (the same global index space); the column counts may differ.
+  ///
+  /// @param[in] comm The MPI communicator
+  /// @param[in] indices Global indices of the data required by this
+  ///   process
+  /// @param[in] x Data arrays on this process which may be distributed
+  ///   (by row). The global index for the [0, ..., n) local rows is
+  ///   assumed to be the local index plus the offset for this rank
+  /// @return The data for each index in @p indices, one array per
+  ///   input array
+  template <typename T>
+  static std::vector<
+      Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+  distribute_data(
+      MPI_Comm comm, const std::vector<std::int64_t>& indices,
+      const std::vector<Eigen::Ref<const Eigen::Array<
+          T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>>& x);
+
   /// Given an adjacency list with global, possibly non-contiguous, link
   /// indices and a local adjacency list with contiguous link indices
   /// starting from zero, compute a local-to-global map for the links.
@@ -160,10 +184,34 @@ Partitioning::distribute_data(
     MPI_Comm comm, const std::vector<std::int64_t>& indices,
     const Eigen::Ref<const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
                                         Eigen::RowMajor>>& x)
+{
+  std::vector<Eigen::Ref<const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                            Eigen::RowMajor>>>
+      payloads = {x};
+  return std::move(distribute_data<T>(comm, indices, payloads).front());
+}
+//---------------------------------------------------------------------------
+template <typename T>
+std::vector<Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+Partitioning::distribute_data(
+    MPI_Comm comm, const std::vector<std::int64_t>& indices,
+    const std::vector<Eigen::Ref<const Eigen::Array<
+        T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>>& x)
 {
   common::Timer timer("Fetch float data from remote processes");
 
-  const std::int64_t num_points_local = x.rows();
+  if (x.empty())
+    return {};
+  const std::int64_t num_points_local = x.front().rows();
+  for (const auto& _x : x)
+  {
+    if (_x.rows() != num_points_local)
+    {
+      throw std::runtime_error(
+          "All arrays distributed together must have the same number of "
+          "rows.");
+    }
+  }
   const int size = dolfinx::MPI::size(comm);
   const int rank = dolfinx::MPI::rank(comm);
   std::vector<std::int64_t> global_sizes(size);
@@ -222,9 +270,14 @@ Partitioning::distribute_data(
                 number_index_recv.data(), disp_index_recv.data(), MPI_INT64_T,
                 comm);
 
-  const int item_size = x.cols();
+  // Total row width across all payloads
+  int item_size = 0;
+  for (const auto& _x : x)
+    item_size += _x.cols();
   assert(item_size != 0);
-  // Pack point data to send back (transpose)
+
+  // Pack point data to send back (transpose), with the rows of all
+  // payloads concatenated so one exchange ships every array
   Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x_return(
       indices_recv.size(), item_size);
   for (int p = 0; p < size; ++p)
@@ -233,7 +286,12 @@ Partitioning::distribute_data(
     {
       const std::int32_t index_local = indices_recv[i] - global_offsets[rank];
       assert(index_local >= 0);
-      x_return.row(i) = x.row(index_local);
+      int col = 0;
+      for (const auto& _x : x)
+      {
+        x_return.row(i).segment(col, _x.cols()) = _x.row(index_local);
+        col += _x.cols();
+      }
     }
   }
 
@@ -248,8 +306,19 @@ Partitioning::distribute_data(
                 disp_index_recv.data(), compound_type, my_x.data(),
                 number_index_send.data(), disp_index_send.data(), compound_type,
                 comm);
+  MPI_Type_free(&compound_type);
+
+  // Split the packed buffer back into one array per payload
+  std::vector<Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+      out;
+  int col = 0;
+  for (const auto& _x : x)
+  {
+    out.push_back(my_x.middleCols(col, _x.cols()));
+    col += _x.cols();
+  }
 
-  return my_x;
+  return out;
 }
 
 } // namespace dolfinx::graph
@@ -0,0 +1,71 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "RedistributionPlan.h"
+#include <cassert>
+#include <numeric>
+
+using namespace dolfinx;
+using namespace dolfinx::graph;
+
+//-----------------------------------------------------------------------------
+RedistributionPlan::RedistributionPlan(MPI_Comm comm,
+                                       const std::vector<int>& dest,
+                                       const std::vector<std::int32_t>& size)
+    : _comm(comm), _mpi_size(dolfinx::MPI::size(comm))
+{
+  assert(dest.size() == size.size());
+
+  // Count elements per destination rank
+  _num_send.assign(_mpi_size, 0);
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    assert(dest[i] >= 0 and dest[i] < _mpi_size);
+    _num_send[dest[i]] += size[i];
+  }
+  _disp_send.assign(_mpi_size + 1, 0);
+  std::partial_sum(_num_send.begin(), _num_send.end(), _disp_send.begin() + 1);
+
+  // Assign each item its slot in the packed send buffer. Items for the
+  // same destination keep their input order.
+  std::vector<int> pos(_disp_send.begin(), _disp_send.end() - 1);
+  _item_offset.resize(dest.size());
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    _item_offset[i] = pos[dest[i]];
+    pos[dest[i]] += size[i];
+  }
+
+  // Exchange element counts; the only collective of the plan
+  _num_recv.assign(_mpi_size, 0);
+  MPI_Alltoall(_num_send.data(), 1, MPI_INT, _num_recv.data(), 1, MPI_INT,
+               _comm);
+  _disp_recv.assign(_mpi_size + 1, 0);
+  std::partial_sum(_num_recv.begin(), _num_recv.end(), _disp_recv.begin() + 1);
+
+  // Record the ranks with non-empty blocks; executions post messages
+  // for these only
+  for (int p = 0; p < _mpi_size; ++p)
+  {
+    if (_num_recv[p] > 0)
+      _src_ranks.push_back(p);
+    if (_num_send[p] > 0)
+      _dest_ranks.push_back(p);
+  }
+}
+//-----------------------------------------------------------------------------
+RedistributionPlan::RedistributionPlan(MPI_Comm comm,
+                                       const std::vector<int>& dest)
+    : RedistributionPlan(comm, dest, std::vector<std::int32_t>(dest.size(), 1))
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+std::int32_t RedistributionPlan::num_recv_elements() const
+{
+  return _disp_recv.back();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,182 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/common/CommTracer.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <mpi.h>
+#include <vector>
+
+namespace dolfinx::graph
+{
+
+/// Plan-based engine for redistributing row data across ranks ("send
+/// item i to rank dest[i]"). The exchange plan -- per-rank send and
+/// receive counts, displacements and the packed position of every item
+/// -- is built once from the destinations, with a single MPI_Alltoall
+/// of the counts. The data movement is then executed any number of
+/// times, with different value types, item widths and packing, so
+/// payloads that share the same destinations (e.g. entity keys and
+/// their tag values) reuse one plan instead of re-counting and
+/// re-exchanging sizes per payload. Execution uses nonblocking
+/// point-to-point messages between the communicating rank pairs only,
+/// and can hand each source rank's block to the caller as it arrives
+/// so unpacking overlaps the messages still in flight.
+class RedistributionPlan
+{
+public:
+  /// Build a plan for items of varying length. Collective (one
+  /// MPI_Alltoall of the element counts).
+  /// @param[in] comm The communicator to redistribute over
+  /// @param[in] dest Destination rank of each item
+  /// @param[in] size Length of each item in elements. An execution
+  ///   with width w ships size[i] * w values for item i.
+  RedistributionPlan(MPI_Comm comm, const std::vector<int>& dest,
+                     const std::vector<std::int32_t>& size);
+
+  /// Build a plan for single-element items. Equivalent to passing a
+  /// size array of ones.
+  /// @param[in] comm The communicator to redistribute over
+  /// @param[in] dest Destination rank of each item
+  RedistributionPlan(MPI_Comm comm, const std::vector<int>& dest);
+
+  /// Execute the plan, invoking @p unpack with the block of each
+  /// source rank as its message completes, so unpacking overlaps the
+  /// messages still in flight. Items from one source arrive in the
+  /// order they were passed to the plan on that source.
+  /// @param[in] width Number of values of type T per element
+  /// @param[in] pack Callback pack(i, buf) that writes the
+  ///   size[i] * width values of item i to buf
+  /// @param[in] unpack Callback unpack(src, data, n) invoked once per
+  ///   communicating source rank with its n received values
+  template <typename T, typename Pack, typename Unpack>
+  void execute(int width, Pack&& pack, Unpack&& unpack) const;
+
+  /// Execute the plan and return the received values grouped by
+  /// source rank (one node per rank, like MPI::all_to_all).
+  /// @param[in] width Number of values of type T per element
+  /// @param[in] pack Callback pack(i, buf) that writes the
+  ///   size[i] * width values of item i to buf
+  /// @return Received values, grouped by source rank
+  template <typename T, typename Pack>
+  graph::AdjacencyList<T> execute(int width, Pack&& pack) const;
+
+  /// Number of elements received by this rank over one execution with
+  /// width 1
+  std::int32_t num_recv_elements() const;
+
+private:
+  // Start and wait for the exchange of a packed send buffer, calling
+  // unpack per completed source block
+  template <typename T, typename Unpack>
+  void exchange(const std::vector<T>& send_buffer, std::vector<T>& recv_buffer,
+                int width, Unpack&& unpack) const;
+
+  // Communicator of the exchange
+  MPI_Comm _comm;
+
+  // Size of the communicator
+  int _mpi_size;
+
+  // Element offset of each item in the packed send buffer
+  std::vector<std::int32_t> _item_offset;
+
+  // Per-rank element counts and displacements for send and receive
+  std::vector<int> _num_send, _disp_send, _num_recv, _disp_recv;
+
+  // Ranks this process receives from/sends to (non-empty blocks only)
+  std::vector<int> _src_ranks, _dest_ranks;
+};
+
+//---------------------------------------------------------------------------
+// Implementation
+//---------------------------------------------------------------------------
+template <typename T, typename Unpack>
+void RedistributionPlan::exchange(const std::vector<T>& send_buffer,
+                                  std::vector<T>& recv_buffer, int width,
+                                  Unpack&& unpack) const
+{
+  const double t0 = MPI_Wtime();
+  recv_buffer.resize(std::size_t(_disp_recv.back()) * width);
+  std::vector<MPI_Request> recv_requests(_src_ranks.size());
+  for (std::size_t i = 0; i < _src_ranks.size(); ++i)
+  {
+    const int p = _src_ranks[i];
+    MPI_Irecv(recv_buffer.data() + std::size_t(_disp_recv[p]) * width,
+              _num_recv[p] * width, dolfinx::MPI::mpi_type<T>(), p, 0, _comm,
+              &recv_requests[i]);
+  }
+
+  std::vector<MPI_Request> send_requests(_dest_ranks.size());
+  for (std::size_t i = 0; i < _dest_ranks.size(); ++i)
+  {
+    const int p = _dest_ranks[i];
+    MPI_Isend(send_buffer.data() + std::size_t(_disp_send[p]) * width,
+              _num_send[p] * width, dolfinx::MPI::mpi_type<T>(), p, 0, _comm,
+              &send_requests[i]);
+  }
+
+  // Hand over each block as its receive completes
+  for (std::size_t b = 0; b < _src_ranks.size(); ++b)
+  {
+    int idx;
+    MPI_Waitany(recv_requests.size(), recv_requests.data(), &idx,
+                MPI_STATUS_IGNORE);
+    const int p = _src_ranks[idx];
+    unpack(p, recv_buffer.data() + std::size_t(_disp_recv[p]) * width,
+           std::size_t(_num_recv[p]) * width);
+  }
+  MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
+
+  if (common::CommTracer::enabled())
+  {
+    double duration = MPI_Wtime() - t0;
+    for (int p = 0; p < _mpi_size; ++p)
+    {
+      if (_num_send[p] + _num_recv[p] > 0)
+      {
+        common::CommTracer::record(
+            p, sizeof(T) * width * (_num_send[p] + _num_recv[p]), duration);
+        duration = 0.0;
+      }
+    }
+  }
+}
+//---------------------------------------------------------------------------
+template <typename T, typename Pack, typename Unpack>
+void RedistributionPlan::execute(int width, Pack&& pack, Unpack&& unpack) const
+{
+  // Pack each item into its slot of the send buffer
+  std::vector<T> send_buffer(std::size_t(_disp_send.back()) * width);
+  for (std::size_t i = 0; i < _item_offset.size(); ++i)
+    pack(i, send_buffer.data() + std::size_t(_item_offset[i]) * width);
+
+  std::vector<T> recv_buffer;
+  exchange(send_buffer, recv_buffer, width, std::forward<Unpack>(unpack));
+}
+//---------------------------------------------------------------------------
+template <typename T, typename Pack>
+graph::AdjacencyList<T> RedistributionPlan::execute(int width,
+                                                    Pack&& pack) const
+{
+  std::vector<T> send_buffer(std::size_t(_disp_send.back()) * width);
+  for (std::size_t i = 0; i < _item_offset.size(); ++i)
+    pack(i, send_buffer.data() + std::size_t(_item_offset[i]) * width);
+
+  std::vector<T> recv_buffer;
+  exchange(send_buffer, recv_buffer, width,
+           [](int, const T*, std::size_t) { /* data lands in place */ });
+
+  std::vector<std::int32_t> offsets(_mpi_size + 1, 0);
+  for (int p = 0; p < _mpi_size; ++p)
+    offsets[p + 1] = _disp_recv[p + 1] * width;
+  return graph::AdjacencyList<T>(std::move(recv_buffer), std::move(offsets));
+}
+
+} // namespace dolfinx::graph
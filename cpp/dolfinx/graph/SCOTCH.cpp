@@ -44,9 +44,8 @@ dolfinx::graph::SCOTCH::compute_reordering(
   const SCOTCH_Num vertnbr = graph.num_nodes();
 
   // Copy graph into array with SCOTCH_Num types
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& data = graph.array();
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& offsets
-      = graph.offsets();
+  const auto data = graph.array();
+  const auto offsets = graph.offsets();
   const std::vector<SCOTCH_Num> verttab(offsets.data(),
                                         offsets.data() + offsets.rows());
   const std::vector<SCOTCH_Num> edgetab(data.data(), data.data() + data.rows());
@@ -119,10 +118,70 @@ dolfinx::graph::SCOTCH::compute_reordering(
   return std::pair(std::move(permutation), std::move(inverse_permutation));
 }
 //-----------------------------------------------------------------------------
+std::vector<int>
+dolfinx::graph::SCOTCH::partition_local(
+    const AdjacencyList<SCOTCH_Num>& local_graph, int nparts)
+{
+  const SCOTCH_Num vertnbr = local_graph.num_nodes();
+  std::vector<int> partition(vertnbr, 0);
+  if (vertnbr == 0 or nparts <= 1)
+    return partition;
+
+  // Copy offsets to match the SCOTCH_Num type
+  std::vector<SCOTCH_Num> verttab(local_graph.offsets().data(),
+                                  local_graph.offsets().data()
+                                      + local_graph.offsets().rows());
+  const SCOTCH_Num* edgetab = local_graph.array().data();
+  const SCOTCH_Num edgenbr = local_graph.array().size();
+
+  // Build SCOTCH (serial) graph
+  SCOTCH_Graph grafdat;
+  if (SCOTCH_graphInit(&grafdat) != 0)
+    throw std::runtime_error("Error initializing SCOTCH graph");
+  if (SCOTCH_graphBuild(&grafdat, 0, vertnbr, verttab.data(), nullptr, nullptr,
+                        nullptr, edgenbr, const_cast<SCOTCH_Num*>(edgetab),
+                        nullptr))
+  {
+    throw std::runtime_error("Error building SCOTCH graph");
+  }
+
+#ifdef DEBUG
+  if (SCOTCH_graphCheck(&grafdat))
+    throw std::runtime_error("Consistency error in SCOTCH graph");
+#endif
+
+  // Partition with the default strategy. Reset the random number
+  // generator for deterministic partitions.
+  SCOTCH_Strat strat;
+  SCOTCH_stratInit(&strat);
+  SCOTCH_randomReset();
+  std::vector<SCOTCH_Num> parttab(vertnbr);
+  if (SCOTCH_graphPart(&grafdat, nparts, &strat, parttab.data()))
+    throw std::runtime_error("Error during SCOTCH partitioning");
+
+  // Clean up SCOTCH objects
+  SCOTCH_graphExit(&grafdat);
+  SCOTCH_stratExit(&strat);
+
+  std::copy(parttab.begin(), parttab.end(), partition.begin());
+  return partition;
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+dolfinx::graph::SCOTCH::partition(const MPI_Comm mpi_comm, const int nparts,
+                                  const AdjacencyList<SCOTCH_Num>& local_graph,
+                                  const std::vector<std::size_t>& node_weights,
+                                  std::int32_t num_ghost_nodes, bool ghosting)
+{
+  return partition(mpi_comm, nparts, local_graph, node_weights, {},
+                   num_ghost_nodes, ghosting);
+}
+//-----------------------------------------------------------------------------
 graph::AdjacencyList<std::int32_t>
 dolfinx::graph::SCOTCH::partition(const MPI_Comm mpi_comm, const int nparts,
                                   const AdjacencyList<SCOTCH_Num>& local_graph,
                                   const std::vector<std::size_t>& node_weights,
+                                  const std::vector<std::size_t>& edge_weights,
                                   std::int32_t num_ghost_nodes, bool ghosting)
 {
   LOG(INFO) << "Compute graph partition using PT-SCOTCH";
@@ -161,13 +220,25 @@ dolfinx::graph::SCOTCH::partition(const MPI_Comm mpi_comm, const int nparts,
   if (!node_weights.empty())
     vload.assign(node_weights.begin(), node_weights.end());
 
+  // Handle edge weights (if any)
+  if (!edge_weights.empty()
+      and edge_weights.size() != (std::size_t)edgeloctab_size)
+  {
+    throw std::runtime_error("Edge weight array size does not match number "
+                             "of local graph edges");
+  }
+  std::vector<SCOTCH_Num> eload;
+  if (!edge_weights.empty())
+    eload.assign(edge_weights.begin(), edge_weights.end());
+
   // Build SCOTCH distributed graph. SCOTCH is not const-correct, so we throw
   // away constness and trust SCOTCH.
   common::Timer timer1("SCOTCH: call SCOTCH_dgraphBuild");
   if (SCOTCH_dgraphBuild(&dgrafdat, baseval, vertlocnbr, vertlocnbr,
                          vertloctab.data(), nullptr, vload.data(), nullptr,
                          edgeloctab_size, edgeloctab_size,
-                         const_cast<SCOTCH_Num*>(edgeloctab), nullptr, nullptr))
+                         const_cast<SCOTCH_Num*>(edgeloctab), nullptr,
+                         eload.data()))
   {
     throw std::runtime_error("Error building SCOTCH graph");
   }
@@ -45,6 +45,38 @@ public:
             const std::vector<std::size_t>& node_weights,
             std::int32_t num_ghost_nodes, bool ghosting);
 
+  /// Compute distributed graph partition with node and edge weights.
+  /// SCOTCH balances a single load per node, so multiple balancing
+  /// constraints (e.g. cost and memory) must be folded into one
+  /// combined node weight by the caller.
+  /// @param mpi_comm MPI Communicator
+  /// @param nparts Number of partitions to divide graph nodes into
+  /// @param local_graph Node connectivity graph
+  /// @param node_weights Weight for each node (empty for uniform)
+  /// @param edge_weights Weight for each edge, in the order of the
+  ///   adjacency array of @p local_graph (empty for uniform)
+  /// @param num_ghost_nodes Number of graph nodes which are owned on
+  ///   other processes
+  /// @param ghosting Flag to enable ghosting of the output node
+  ///   distribution
+  /// @return Destination rank for each input node
+  static AdjacencyList<std::int32_t>
+  partition(const MPI_Comm mpi_comm, const int nparts,
+            const AdjacencyList<SCOTCH_Num>& local_graph,
+            const std::vector<std::size_t>& node_weights,
+            const std::vector<std::size_t>& edge_weights,
+            std::int32_t num_ghost_nodes, bool ghosting);
+
+  /// Partition a graph that is local to this process (serial SCOTCH).
+  /// Used e.g. for the within-node level of hierarchical partitioning,
+  /// where each node's subgraph is partitioned independently.
+  /// @param[in] local_graph Node connectivity graph, with edges
+  ///   referring to local node indices only
+  /// @param[in] nparts Number of partitions to divide graph nodes into
+  /// @return Partition number for each node
+  static std::vector<int>
+  partition_local(const AdjacencyList<SCOTCH_Num>& local_graph, int nparts);
+
   /// Compute reordering (map[old] -> new) using Gibbs-Poole-Stockmeyer
   /// (GPS) re-ordering
   /// @param[in] graph Input graph
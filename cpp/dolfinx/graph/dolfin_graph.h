@@ -12,4 +12,6 @@ namespace dolfinx
 
 // DOLFINX graph interface
 
+#include <dolfinx/graph/AccessOrdering.h>
 #include <dolfinx/graph/BoostGraphOrdering.h>
+#include <dolfinx/graph/RedistributionPlan.h>
@@ -7,6 +7,7 @@
 #include "HDF5Interface.h"
 #include <boost/filesystem.hpp>
 #include <dolfinx/common/MPI.h>
+#include <map>
 
 #define HDF5_MAXSTRLEN 80
 
@@ -53,20 +54,46 @@ bool has_group(const hid_t handle, const std::string& group_name)
   return object_info.type == H5O_TYPE_GROUP;
 }
 
+/// I/O profile recorded for each open file, so writes without an
+/// explicit profile inherit the chunking and compression settings of
+/// the file they go into
+std::map<hid_t, HDF5IOProfile> open_file_profiles;
+
 } // namespace
 
 //-----------------------------------------------------------------------------
 hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string& filename,
                                const std::string& mode, const bool use_mpi_io)
+{
+  return open_file(mpi_comm, filename, mode, use_mpi_io, HDF5IOProfile());
+}
+//-----------------------------------------------------------------------------
+hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string& filename,
+                               const std::string& mode, const bool use_mpi_io,
+                               const HDF5IOProfile& profile)
 {
   // Set parallel access with communicator
   const hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
 
+  // Apply file object alignment (stripe-sized alignment can
+  // substantially improve throughput on parallel file systems)
+  if (profile.alignment > 0)
+  {
+    if (H5Pset_alignment(plist_id, profile.alignment_threshold,
+                         profile.alignment)
+        < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_alignment unsuccessful");
+    }
+  }
+
 #ifdef H5_HAVE_PARALLEL
   if (use_mpi_io)
   {
     MPI_Info info;
     MPI_Info_create(&info);
+    for (const std::array<std::string, 2>& hint : profile.mpi_info)
+      MPI_Info_set(info, hint[0].c_str(), hint[1].c_str());
     if (H5Pset_fapl_mpio(plist_id, mpi_comm, info) < 0)
       throw std::runtime_error("Call to H5Pset_fapl_mpio unsuccessful");
     MPI_Info_free(&info);
@@ -111,11 +138,21 @@ hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string& filename,
   if (H5Pclose(plist_id) < 0)
     throw std::runtime_error("Failed to close HDF5 file property list.");
 
+  open_file_profiles[file_id] = profile;
+
   return file_id;
 }
 //-----------------------------------------------------------------------------
+const HDF5IOProfile& HDF5Interface::file_profile(const hid_t handle)
+{
+  static const HDF5IOProfile default_profile;
+  auto it = open_file_profiles.find(handle);
+  return it != open_file_profiles.end() ? it->second : default_profile;
+}
+//-----------------------------------------------------------------------------
 void HDF5Interface::close_file(const hid_t handle)
 {
+  open_file_profiles.erase(handle);
   if (H5Fclose(handle) < 0)
     throw std::runtime_error("Failed to close HDF5 file.");
 }
@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <dolfinx/common/Counters.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
 #include <hdf5.h>
 #include <mpi.h>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -21,6 +26,61 @@ namespace dolfinx
 namespace io
 {
 
+/// Compression stage applied to floating-point datasets created with a
+/// profile. Filters require chunked storage, which is enabled
+/// automatically when compression is selected; writing compressed
+/// datasets in parallel requires collective MPI-IO transfers. Integer
+/// datasets (topology, index data) are never compressed.
+enum class HDF5Compression : int
+{
+  none = 0,     ///< Store values uncompressed
+  lossless = 1, ///< Byte shuffle followed by deflate
+  lossy = 2     ///< Error-bounded quantization (scale-offset filter),
+                ///< then shuffle and deflate
+};
+
+/// Tuning parameters for parallel HDF5 I/O. The defaults reproduce the
+/// historic behaviour; on parallel file systems the chunk shape,
+/// alignment and MPI-IO hints should be matched to the stripe
+/// configuration.
+struct HDF5IOProfile
+{
+  /// Chunk size (rows) for created datasets. 0 selects the built-in
+  /// heuristic (dataset split in two, clamped to [1024, 1048576] rows).
+  hsize_t chunk_size = 0;
+
+  /// File object alignment in bytes (H5Pset_alignment), applied to
+  /// objects larger than @p alignment_threshold. 0 leaves the library
+  /// default.
+  hsize_t alignment = 0;
+
+  /// Minimum object size for @p alignment to apply
+  hsize_t alignment_threshold = 1;
+
+  /// Use collective (true) or independent (false) MPI-IO transfers
+  bool collective = true;
+
+  /// MPI-IO hints, e.g. {"cb_nodes", "8"}, passed to the file driver
+  std::vector<std::array<std::string, 2>> mpi_info;
+
+  /// Number of writer (aggregator) ranks for
+  /// HDF5Interface::write_dataset_aggregated. 0 means every rank
+  /// writes its own block.
+  int num_writers = 0;
+
+  /// Compression applied to floating-point datasets created through
+  /// this profile
+  HDF5Compression compression = HDF5Compression::none;
+
+  /// Maximum absolute error of the lossy stage. Values are quantized
+  /// to the decimal precision covering this bound before the lossless
+  /// stage; smooth fields typically shrink 10-20x.
+  double lossy_error = 1.0e-6;
+
+  /// Deflate (zlib) level for the lossless stage, 1 (fast) to 9 (best)
+  int deflate_level = 6;
+};
+
 /// This class provides an interface to some HDF5 functionality
 
 class HDF5Interface
@@ -35,10 +95,31 @@ public:
   static hid_t open_file(MPI_Comm mpi_comm, const std::string& filename,
                          const std::string& mode, const bool use_mpi_io);
 
+  /// Open HDF5 with an I/O profile and return file descriptor. The
+  /// profile alignment and MPI-IO hints are applied to the file access
+  /// property list.
+  /// @param[in] mpi_comm MPI communicator
+  /// @param[in] filename Name of the HDF5 file to open
+  /// @param[in] mode Mode in which to open the file (w, r, a)
+  /// @param[in] use_mpi_io True if MPI-IO should be used
+  /// @param[in] profile I/O tuning parameters
+  static hid_t open_file(MPI_Comm mpi_comm, const std::string& filename,
+                         const std::string& mode, const bool use_mpi_io,
+                         const HDF5IOProfile& profile);
+
   /// Close HDF5 file
   /// @param[in] handle HDF5 file handle
   static void close_file(const hid_t handle);
 
+  /// Return the I/O profile the file was opened with (the default
+  /// profile when none was given). Writes that do not take an explicit
+  /// profile use this, so datasets written through helper layers (e.g.
+  /// the XDMF data items) inherit the chunking and compression of the
+  /// file they go into.
+  /// @param[in] handle HDF5 file handle
+  /// @return The profile recorded when the file was opened
+  static const HDF5IOProfile& file_profile(const hid_t handle);
+
   /// Flush data to file to improve data integrity after interruption
   /// @param[in] handle HDF5 file handle
   static void flush_file(const hid_t handle);
@@ -65,6 +146,75 @@ public:
                             const std::vector<std::int64_t>& global_size,
                             bool use_mpi_io, bool use_chunking);
 
+  /// Write data to existing HDF file as defined by range blocks on
+  /// each process, with chunking and the transfer mode taken from an
+  /// I/O profile
+  /// @param[in] handle HDF5 file handle
+  /// @param[in] dataset_path Path for the dataset in the HDF5 file
+  /// @param[in] data Data to be written, flattened into 1D vector
+  ///   (row-major storage)
+  /// @param[in] range The local range on this processor
+  /// @param[in] global_size The global shape shape of the array
+  /// @param[in] use_mpi_io True if MPI-IO should be used
+  /// @param[in] use_chunking True if chunking should be used
+  /// @param[in] profile I/O tuning parameters
+  template <typename T>
+  static void write_dataset(const hid_t handle, const std::string& dataset_path,
+                            const T* data,
+                            const std::array<std::int64_t, 2>& range,
+                            const std::vector<std::int64_t>& global_size,
+                            bool use_mpi_io, bool use_chunking,
+                            const HDF5IOProfile& profile);
+
+  /// Write rank 2 data that is narrower in memory than in the file.
+  /// The memory buffer holds (range[1] - range[0]) rows of mem_width
+  /// contiguous values; these are written to the first mem_width
+  /// columns of the dataset rows, and the remaining columns keep the
+  /// dataset fill value (zero). This writes zero-padded data (e.g. 2D
+  /// vectors stored as 3D) without materializing a padded copy.
+  /// @param[in] handle HDF5 file handle
+  /// @param[in] dataset_path Path for the dataset in the HDF5 file
+  /// @param[in] data Data to be written, flattened into 1D vector
+  /// @param[in] range The local range on this processor
+  /// @param[in] global_size The global shape of the dataset (rank 2)
+  /// @param[in] mem_width Number of values per row in memory. Must not
+  ///   exceed the dataset row width global_size[1].
+  /// @param[in] use_mpi_io True if MPI-IO should be used
+  /// @param[in] use_chunking True if chunking should be used
+  template <typename T>
+  static void write_dataset_selected(
+      const hid_t handle, const std::string& dataset_path, const T* data,
+      const std::array<std::int64_t, 2>& range,
+      const std::vector<std::int64_t>& global_size, const int mem_width,
+      bool use_mpi_io, bool use_chunking);
+
+  /// Two-phase (aggregated) parallel write. The local blocks of
+  /// profile.num_writers consecutive groups of ranks are first gathered
+  /// onto the lowest rank of each group, which then writes the combined
+  /// block collectively; the remaining ranks participate in the
+  /// collective write with an empty selection. Aggregation onto a
+  /// number of writers matched to the file system reduces lock and
+  /// stripe contention for writes of many small per-rank blocks. The
+  /// local ranges must be ordered by rank (block distribution). Falls
+  /// back to a plain write when profile.num_writers is 0 or not smaller
+  /// than the communicator size, or when MPI-IO is not used.
+  /// @param[in] comm MPI communicator the file was opened on
+  /// @param[in] handle HDF5 file handle
+  /// @param[in] dataset_path Path for the dataset in the HDF5 file
+  /// @param[in] data Data to be written, flattened into 1D vector
+  ///   (row-major storage)
+  /// @param[in] range The local range on this processor
+  /// @param[in] global_size The global shape shape of the array
+  /// @param[in] use_mpi_io True if MPI-IO should be used
+  /// @param[in] use_chunking True if chunking should be used
+  /// @param[in] profile I/O tuning parameters
+  template <typename T>
+  static void write_dataset_aggregated(
+      MPI_Comm comm, const hid_t handle, const std::string& dataset_path,
+      const T* data, const std::array<std::int64_t, 2>& range,
+      const std::vector<std::int64_t>& global_size, bool use_mpi_io,
+      bool use_chunking, const HDF5IOProfile& profile);
+
   /// Read data from a HDF5 dataset "dataset_path" as defined by range
   /// blocks on each process.
   ///
@@ -162,6 +312,17 @@ inline void HDF5Interface::write_dataset(
     const hid_t file_handle, const std::string& dataset_path, const T* data,
     const std::array<std::int64_t, 2>& range,
     const std::vector<int64_t>& global_size, bool use_mpi_io, bool use_chunking)
+{
+  write_dataset(file_handle, dataset_path, data, range, global_size, use_mpi_io,
+                use_chunking, file_profile(file_handle));
+}
+//---------------------------------------------------------------------------
+template <typename T>
+inline void HDF5Interface::write_dataset(
+    const hid_t file_handle, const std::string& dataset_path, const T* data,
+    const std::array<std::int64_t, 2>& range,
+    const std::vector<int64_t>& global_size, bool use_mpi_io, bool use_chunking,
+    const HDF5IOProfile& profile)
 {
   // Data rank
   const std::size_t rank = global_size.size();
@@ -194,6 +355,170 @@ inline void HDF5Interface::write_dataset(
   const hid_t filespace0 = H5Screate_simple(rank, dimsf.data(), nullptr);
   assert(filespace0 != HDF5_FAIL);
 
+  // Compression applies to floating-point data only, and the filter
+  // pipeline needs a chunked layout, so it forces chunking on
+  const bool compress
+      = profile.compression != HDF5Compression::none
+        and (h5type == H5T_NATIVE_FLOAT or h5type == H5T_NATIVE_DOUBLE);
+  if (compress)
+    use_chunking = true;
+
+  // Set chunking parameters
+  hid_t chunking_properties;
+  if (use_chunking)
+  {
+    // Take the chunk size from the I/O profile, otherwise set chunk
+    // size and limit to 1kB min/1MB max
+    hsize_t chunk_size = profile.chunk_size;
+    if (chunk_size == 0)
+    {
+      chunk_size = dimsf[0] / 2;
+      if (chunk_size > 1048576)
+        chunk_size = 1048576;
+      if (chunk_size < 1024)
+        chunk_size = 1024;
+    }
+
+    hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
+    chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(chunking_properties, rank, chunk_dims);
+
+    if (compress)
+    {
+      if (profile.compression == HDF5Compression::lossy)
+      {
+        // Quantize with the scale-offset filter. Keeping d decimal
+        // digits bounds the rounding error by 0.5 * 10^-d, so keep
+        // enough digits to cover the requested absolute error.
+        const int digits = std::max(
+            0,
+            (int)std::ceil(-std::log10(2.0 * profile.lossy_error)));
+        status = H5Pset_scaleoffset(chunking_properties, H5Z_SO_FLOAT_DSCALE,
+                                    digits);
+        assert(status != HDF5_FAIL);
+      }
+
+      // Lossless stage: byte shuffle groups the (now highly repetitive
+      // after quantization) bytes by significance, then deflate
+      status = H5Pset_shuffle(chunking_properties);
+      assert(status != HDF5_FAIL);
+      status = H5Pset_deflate(chunking_properties, profile.deflate_level);
+      assert(status != HDF5_FAIL);
+    }
+  }
+  else
+    chunking_properties = H5P_DEFAULT;
+
+  // Check that group exists and recursively create if required
+  const std::string group_name(dataset_path, 0, dataset_path.rfind('/'));
+  add_group(file_handle, group_name);
+
+  // Create global dataset (using dataset_path)
+  const hid_t dset_id
+      = H5Dcreate2(file_handle, dataset_path.c_str(), h5type, filespace0,
+                   H5P_DEFAULT, chunking_properties, H5P_DEFAULT);
+  assert(dset_id != HDF5_FAIL);
+
+  // Close global data space
+  status = H5Sclose(filespace0);
+  assert(status != HDF5_FAIL);
+
+  // Create a local data space
+  const hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
+  assert(memspace != HDF5_FAIL);
+
+  // Create a file dataspace within the global space - a hyperslab
+  const hid_t filespace1 = H5Dget_space(dset_id);
+  status = H5Sselect_hyperslab(filespace1, H5S_SELECT_SET, offset.data(),
+                               nullptr, count.data(), nullptr);
+  assert(status != HDF5_FAIL);
+
+  // Set parallel access
+  const hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+  if (use_mpi_io)
+  {
+#ifdef H5_HAVE_PARALLEL
+    status = H5Pset_dxpl_mpio(plist_id, profile.collective
+                                            ? H5FD_MPIO_COLLECTIVE
+                                            : H5FD_MPIO_INDEPENDENT);
+    assert(status != HDF5_FAIL);
+#else
+    throw std::runtime_error("HDF5 library has not been configured with MPI");
+#endif
+  }
+
+  // Write local dataset into selected hyperslab
+  status = H5Dwrite(dset_id, h5type, memspace, filespace1, plist_id, data);
+  assert(status != HDF5_FAIL);
+
+  {
+    static const int counter
+        = common::Counters::register_counter("hdf5 bytes written");
+    std::int64_t num_bytes = sizeof(T);
+    for (std::size_t i = 0; i < rank; ++i)
+      num_bytes *= count[i];
+    common::Counters::add(counter, num_bytes);
+  }
+
+  if (use_chunking)
+  {
+    // Close chunking properties
+    status = H5Pclose(chunking_properties);
+    assert(status != HDF5_FAIL);
+  }
+
+  // Close dataset collectively
+  status = H5Dclose(dset_id);
+  assert(status != HDF5_FAIL);
+
+  // Close hyperslab
+  status = H5Sclose(filespace1);
+  assert(status != HDF5_FAIL);
+
+  // Close local dataset
+  status = H5Sclose(memspace);
+  assert(status != HDF5_FAIL);
+
+  // Release file-access template
+  status = H5Pclose(plist_id);
+  assert(status != HDF5_FAIL);
+}
+//---------------------------------------------------------------------------
+template <typename T>
+inline void HDF5Interface::write_dataset_selected(
+    const hid_t file_handle, const std::string& dataset_path, const T* data,
+    const std::array<std::int64_t, 2>& range,
+    const std::vector<std::int64_t>& global_size, const int mem_width,
+    bool use_mpi_io, bool use_chunking)
+{
+  assert(global_size.size() == 2);
+  assert(mem_width <= global_size[1]);
+  if (mem_width == global_size[1])
+  {
+    // Memory and file widths agree - plain contiguous write
+    write_dataset(file_handle, dataset_path, data, range, global_size,
+                  use_mpi_io, use_chunking);
+    return;
+  }
+
+  // Get HDF5 data type
+  const hid_t h5type = hdf5_type<T>();
+
+  // File selection: the first mem_width columns of the local rows. The
+  // unselected (padding) columns keep the dataset fill value (zero).
+  const hsize_t count[2] = {hsize_t(range[1] - range[0]), hsize_t(mem_width)};
+  const hsize_t offset[2] = {hsize_t(range[0]), 0};
+
+  // Dataset dimensions
+  const std::vector<hsize_t> dimsf(global_size.begin(), global_size.end());
+
+  // Generic status report
+  herr_t status;
+
+  // Create a global data space
+  const hid_t filespace0 = H5Screate_simple(2, dimsf.data(), nullptr);
+  assert(filespace0 != HDF5_FAIL);
+
   // Set chunking parameters
   hid_t chunking_properties;
   if (use_chunking)
@@ -207,7 +532,7 @@ inline void HDF5Interface::write_dataset(
 
     hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
     chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
-    H5Pset_chunk(chunking_properties, rank, chunk_dims);
+    H5Pset_chunk(chunking_properties, 2, chunk_dims);
   }
   else
     chunking_properties = H5P_DEFAULT;
@@ -226,14 +551,14 @@ inline void HDF5Interface::write_dataset(
   status = H5Sclose(filespace0);
   assert(status != HDF5_FAIL);
 
-  // Create a local data space
-  const hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
+  // Create a local data space matching the memory layout
+  const hid_t memspace = H5Screate_simple(2, count, nullptr);
   assert(memspace != HDF5_FAIL);
 
   // Create a file dataspace within the global space - a hyperslab
   const hid_t filespace1 = H5Dget_space(dset_id);
-  status = H5Sselect_hyperslab(filespace1, H5S_SELECT_SET, offset.data(),
-                               nullptr, count.data(), nullptr);
+  status = H5Sselect_hyperslab(filespace1, H5S_SELECT_SET, offset, nullptr,
+                               count, nullptr);
   assert(status != HDF5_FAIL);
 
   // Set parallel access
@@ -252,6 +577,13 @@ inline void HDF5Interface::write_dataset(
   status = H5Dwrite(dset_id, h5type, memspace, filespace1, plist_id, data);
   assert(status != HDF5_FAIL);
 
+  {
+    static const int counter
+        = common::Counters::register_counter("hdf5 bytes written");
+    common::Counters::add(counter,
+                          std::int64_t(sizeof(T)) * count[0] * count[1]);
+  }
+
   if (use_chunking)
   {
     // Close chunking properties
@@ -277,6 +609,72 @@ inline void HDF5Interface::write_dataset(
 }
 //---------------------------------------------------------------------------
 template <typename T>
+inline void HDF5Interface::write_dataset_aggregated(
+    MPI_Comm comm, const hid_t file_handle, const std::string& dataset_path,
+    const T* data, const std::array<std::int64_t, 2>& range,
+    const std::vector<std::int64_t>& global_size, bool use_mpi_io,
+    bool use_chunking, const HDF5IOProfile& profile)
+{
+  const int mpi_size = dolfinx::MPI::size(comm);
+  const int mpi_rank = dolfinx::MPI::rank(comm);
+  if (!use_mpi_io or profile.num_writers <= 0
+      or profile.num_writers >= mpi_size)
+  {
+    write_dataset(file_handle, dataset_path, data, range, global_size,
+                  use_mpi_io, use_chunking, profile);
+    return;
+  }
+
+  // Number of values per dataset row
+  const std::int64_t row_size
+      = std::accumulate(std::next(global_size.begin()), global_size.end(),
+                        std::int64_t(1), std::multiplies<std::int64_t>());
+
+  // Split into num_writers groups of consecutive ranks; the lowest
+  // rank of each group is the writer
+  const int group = mpi_rank * profile.num_writers / mpi_size;
+  MPI_Comm group_comm;
+  MPI_Comm_split(comm, group, mpi_rank, &group_comm);
+  int group_rank, group_size;
+  MPI_Comm_rank(group_comm, &group_rank);
+  MPI_Comm_size(group_comm, &group_size);
+
+  // Gather block sizes (in values) and ranges on the writer
+  const std::int64_t num_values = (range[1] - range[0]) * row_size;
+  std::vector<std::int64_t> group_values(group_size);
+  MPI_Gather(&num_values, 1, MPI_INT64_T, group_values.data(), 1, MPI_INT64_T,
+             0, group_comm);
+  std::array<std::int64_t, 2> group_range = range;
+  MPI_Reduce(&range[0], &group_range[0], 1, MPI_INT64_T, MPI_MIN, 0,
+             group_comm);
+  MPI_Reduce(&range[1], &group_range[1], 1, MPI_INT64_T, MPI_MAX, 0,
+             group_comm);
+
+  // Gather the local blocks onto the writer. The blocks are ordered by
+  // rank, so the gathered buffer is the contiguous group block.
+  std::vector<int> counts(group_size), displs(group_size);
+  std::int64_t group_num_values = 0;
+  for (int i = 0; i < group_size; ++i)
+  {
+    counts[i] = group_values[i];
+    displs[i] = group_num_values;
+    group_num_values += group_values[i];
+  }
+  std::vector<T> buffer(group_rank == 0 ? group_num_values : 0);
+  MPI_Gatherv(data, num_values, dolfinx::MPI::mpi_type<T>(), buffer.data(),
+              counts.data(), displs.data(), dolfinx::MPI::mpi_type<T>(), 0,
+              group_comm);
+  MPI_Comm_free(&group_comm);
+
+  // Collective write: writers write their group block, other ranks
+  // participate with an empty selection
+  if (group_rank != 0)
+    group_range = {0, 0};
+  write_dataset(file_handle, dataset_path, buffer.data(), group_range,
+                global_size, use_mpi_io, use_chunking, profile);
+}
+//---------------------------------------------------------------------------
+template <typename T>
 inline std::vector<T>
 HDF5Interface::read_dataset(const hid_t file_handle,
                             const std::string& dataset_path,
@@ -8,6 +8,8 @@
 #include "VTKWriter.h"
 #include "pugixml.hpp"
 #include <boost/cstdint.hpp>
+#include <complex>
+#include <cstring>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
@@ -31,14 +33,17 @@ using namespace dolfinx::io;
 namespace
 {
 void write_function(const function::Function& u, const std::string filename,
-                    const std::size_t counter, double time);
+                    const std::size_t counter, double time, bool binary,
+                    VTKWriter::MeshPiece& mesh_piece);
 void write_mesh(const mesh::Mesh& mesh, const std::string filename,
-                const std::size_t counter, double time);
+                const std::size_t counter, double time, bool binary,
+                VTKWriter::MeshPiece& mesh_piece);
 std::string init(const mesh::Mesh& mesh, const std::string filename,
-                 const std::size_t counter, std::size_t dim);
-void results_write(const function::Function& u, std::string file);
+                 const std::size_t counter, std::size_t dim, bool binary);
+void results_write(const function::Function& u, std::string file,
+                   std::vector<std::uint8_t>* appended);
 void write_point_data(const function::Function& u, const mesh::Mesh& mesh,
-                      std::string file);
+                      std::string file, std::vector<std::uint8_t>* appended);
 void pvd_file_write(std::size_t step, double time, const std::string filename,
                     std::string file);
 void pvtu_write_function(std::size_t dim, std::size_t rank,
@@ -52,8 +57,10 @@ void pvtu_write_mesh(const std::string filename,
 void pvtu_write(const function::Function& u, const std::string filename,
                 const std::string pvtu_filename, const std::size_t counter);
 void vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
-                     const std::string vtu_filename);
+                     const std::string vtu_filename, bool binary);
 void vtk_header_close(std::string file);
+void vtk_header_close_appended(std::string file,
+                               const std::vector<std::uint8_t>& appended);
 std::string vtu_name(const int process, const int num_processes,
                      const int counter, const std::string filename,
                      const std::string ext);
@@ -63,7 +70,7 @@ void pvtu_write_mesh(pugi::xml_node xml_node);
 
 //----------------------------------------------------------------------------
 void vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
-                     const std::string vtu_filename)
+                     const std::string vtu_filename, bool binary)
 {
   // Open file
   std::ofstream file(vtu_filename.c_str(), std::ios::app);
@@ -73,8 +80,10 @@ void vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
 
   // Write headers
   file << "<?xml version=\"1.0\"?>" << std::endl;
-  file << R"(<VTKFile type="UnstructuredGrid"  version="0.1" )"
-       << ">" << std::endl;
+  file << R"(<VTKFile type="UnstructuredGrid"  version="0.1" )";
+  if (binary)
+    file << R"(header_type="UInt64" )";
+  file << ">" << std::endl;
   file << "<UnstructuredGrid>" << std::endl;
   file << "<Piece  NumberOfPoints=\"" << num_vertices << "\" NumberOfCells=\""
        << num_cells << "\">" << std::endl;
@@ -102,6 +111,26 @@ void vtk_header_close(std::string vtu_filename)
   file.close();
 }
 //----------------------------------------------------------------------------
+void vtk_header_close_appended(std::string vtu_filename,
+                               const std::vector<std::uint8_t>& appended)
+{
+  // Open file in binary mode; the appended section holds raw bytes
+  std::ofstream file(vtu_filename.c_str(), std::ios::app | std::ios::binary);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("IO Error");
+  }
+
+  // Close the grid and write the raw data blocks in one streamed write
+  file << "</Piece>" << std::endl << "</UnstructuredGrid>" << std::endl;
+  file << R"(<AppendedData encoding="raw">)" << std::endl << "_";
+  file.write(reinterpret_cast<const char*>(appended.data()), appended.size());
+  file << std::endl << "</AppendedData>" << std::endl << "</VTKFile>";
+
+  // Close file
+  file.close();
+}
+//----------------------------------------------------------------------------
 std::string vtu_name(const int process, const int num_processes,
                      const int counter, const std::string filename,
                      const std::string ext)
@@ -146,7 +175,7 @@ std::string strip_path(const std::string filename, const std::string file)
 }
 //----------------------------------------------------------------------------
 std::string init(const mesh::Mesh& mesh, const std::string filename,
-                 const std::size_t counter, std::size_t cell_dim)
+                 const std::size_t counter, std::size_t cell_dim, bool binary)
 {
   // Get MPI communicators
   const MPI_Comm mpi_comm = mesh.mpi_comm();
@@ -165,13 +194,14 @@ std::string init(const mesh::Mesh& mesh, const std::string filename,
   const int num_nodes = mesh.geometry().x().rows();
 
   // Write headers
-  vtk_header_open(num_nodes, num_cells, vtu_filename);
+  vtk_header_open(num_nodes, num_cells, vtu_filename, binary);
 
   return vtu_filename;
 }
 //----------------------------------------------------------------------------
 void write_function(const function::Function& u, const std::string filename,
-                    const std::size_t counter, double time)
+                    const std::size_t counter, double time, bool binary,
+                    VTKWriter::MeshPiece& mesh_piece)
 {
   assert(u.function_space());
   std::shared_ptr<const mesh::Mesh> mesh = u.function_space()->mesh();
@@ -182,13 +212,32 @@ void write_function(const function::Function& u, const std::string filename,
 
   // Get vtu file name and initialise
   std::string vtu_filename
-      = init(*mesh, filename, counter, mesh->topology().dim());
+      = init(*mesh, filename, counter, mesh->topology().dim(), binary);
 
-  // Write mesh
-  VTKWriter::write_mesh(*mesh, mesh->topology().dim(), vtu_filename);
+  // Serialize the mesh, or reuse the cached serialization when the
+  // mesh is unchanged since the previous step, so that for a static
+  // mesh only the field data is encoded per step
+  VTKWriter::update_mesh_piece(*mesh, mesh->topology().dim(), binary,
+                               mesh_piece);
+  {
+    std::ofstream file(vtu_filename.c_str(), std::ios::app);
+    if (!file.is_open())
+      throw std::runtime_error("Unable to open file " + vtu_filename);
+    file << mesh_piece.xml;
+  }
 
-  // Write results
-  results_write(u, vtu_filename);
+  // Write results. In binary mode the data arrays are collected in the
+  // appended buffer (seeded with the mesh blocks, which the mesh XML
+  // references at the start of the section) and written raw after the
+  // XML body.
+  std::vector<std::uint8_t> appended;
+  if (binary)
+  {
+    appended = mesh_piece.blocks;
+    results_write(u, vtu_filename, &appended);
+  }
+  else
+    results_write(u, vtu_filename, nullptr);
 
   // Parallel-specific files
   const std::size_t num_processes = dolfinx::MPI::size(mpi_comm);
@@ -202,7 +251,10 @@ void write_function(const function::Function& u, const std::string filename,
     pvd_file_write(counter, time, filename, vtu_filename);
 
   // Finalise and write pvd files
-  vtk_header_close(vtu_filename);
+  if (binary)
+    vtk_header_close_appended(vtu_filename, appended);
+  else
+    vtk_header_close(vtu_filename);
 
   DLOG(INFO) << "Saved function \""
              << "u"
@@ -210,7 +262,8 @@ void write_function(const function::Function& u, const std::string filename,
 }
 //----------------------------------------------------------------------------
 void write_mesh(const mesh::Mesh& mesh, const std::string filename,
-                const std::size_t counter, double time)
+                const std::size_t counter, double time, bool binary,
+                VTKWriter::MeshPiece& mesh_piece)
 {
   common::Timer t("Write mesh to PVD/VTK file");
 
@@ -219,10 +272,21 @@ void write_mesh(const mesh::Mesh& mesh, const std::string filename,
 
   // Get vtu file name and initialise out files
   std::string vtu_filename
-      = init(mesh, filename, counter, mesh.topology().dim());
+      = init(mesh, filename, counter, mesh.topology().dim(), binary);
 
-  // Write local mesh to vtu file
-  VTKWriter::write_mesh(mesh, mesh.topology().dim(), vtu_filename);
+  // Write local mesh to vtu file, reusing the cached serialization
+  // when the mesh is unchanged since the previous step
+  VTKWriter::update_mesh_piece(mesh, mesh.topology().dim(), binary,
+                               mesh_piece);
+  {
+    std::ofstream file(vtu_filename.c_str(), std::ios::app);
+    if (!file.is_open())
+      throw std::runtime_error("Unable to open file " + vtu_filename);
+    file << mesh_piece.xml;
+  }
+  std::vector<std::uint8_t> appended;
+  if (binary)
+    appended = mesh_piece.blocks;
 
   // Parallel-specific files
   const std::size_t num_processes = dolfinx::MPI::size(mpi_comm);
@@ -236,12 +300,16 @@ void write_mesh(const mesh::Mesh& mesh, const std::string filename,
     pvd_file_write(counter, time, filename, vtu_filename);
 
   // Finalise
-  vtk_header_close(vtu_filename);
+  if (binary)
+    vtk_header_close_appended(vtu_filename, appended);
+  else
+    vtk_header_close(vtu_filename);
 
   DLOG(INFO) << "Saved mesh in VTK format to file:" << filename;
 }
 //----------------------------------------------------------------------------
-void results_write(const function::Function& u, std::string vtu_filename)
+void results_write(const function::Function& u, std::string vtu_filename,
+                   std::vector<std::uint8_t>* appended)
 {
   // Get rank of function::Function
   const std::size_t rank = u.value_rank();
@@ -288,13 +356,19 @@ void results_write(const function::Function& u, std::string vtu_filename)
   assert(dofmap);
   assert(dofmap->element_dof_layout);
   if (dofmap->element_dof_layout->num_dofs() == cell_based_dim)
-    VTKWriter::write_cell_data(u, vtu_filename);
+  {
+    if (appended)
+      VTKWriter::write_cell_data(u, vtu_filename, *appended);
+    else
+      VTKWriter::write_cell_data(u, vtu_filename);
+  }
   else
-    write_point_data(u, *mesh, vtu_filename);
+    write_point_data(u, *mesh, vtu_filename, appended);
 }
 //----------------------------------------------------------------------------
 void write_point_data(const function::Function& u, const mesh::Mesh& mesh,
-                      std::string vtu_filename)
+                      std::string vtu_filename,
+                      std::vector<std::uint8_t>* appended)
 {
   const std::size_t rank = u.value_rank();
 
@@ -309,6 +383,58 @@ void write_point_data(const function::Function& u, const mesh::Mesh& mesh,
   Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       values = u.compute_point_values();
 
+  if (appended)
+  {
+    // Pack values (padded to 3D where required) into a flat array
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points
+        = mesh.geometry().x();
+    const std::size_t num_components = rank == 0 ? 1 : (rank == 1 ? 3 : 9);
+    std::vector<double> data;
+    data.reserve(points.rows() * num_components);
+    for (int i = 0; i < points.rows(); ++i)
+    {
+      for (std::size_t j = 0; j < dim; ++j)
+      {
+        data.push_back(std::real(values(i, j)));
+        // Pad 2D vectors/tensor rows with 0.0 to make them 3D
+        if ((rank == 1 and dim == 2) or (rank == 2 and dim == 4))
+          if (j % 2 == 1)
+            data.push_back(0.0);
+      }
+      // Pad the third row of 2D tensors
+      if (rank == 2 and dim == 4)
+      {
+        data.push_back(0.0);
+        data.push_back(0.0);
+        data.push_back(0.0);
+      }
+    }
+
+    // Append the raw block (byte count header plus payload)
+    const std::uint64_t num_bytes = data.size() * sizeof(double);
+    const std::size_t block_offset = appended->size();
+    appended->resize(block_offset + sizeof(num_bytes) + num_bytes);
+    std::memcpy(appended->data() + block_offset, &num_bytes,
+                sizeof(num_bytes));
+    std::memcpy(appended->data() + block_offset + sizeof(num_bytes),
+                data.data(), num_bytes);
+
+    const std::string rank_type
+        = rank == 0 ? "Scalars" : (rank == 1 ? "Vectors" : "Tensors");
+    fp << "<PointData  " << rank_type << "=\""
+       << "u"
+       << "\"> " << std::endl;
+    fp << R"(<DataArray  type="Float64"  Name=")"
+       << "u"
+       << "\"";
+    if (rank > 0)
+      fp << "  NumberOfComponents=\"" << num_components << "\"";
+    fp << R"(  format="appended" offset=")" << block_offset << "\" />"
+       << std::endl;
+    fp << "</PointData> " << std::endl;
+    return;
+  }
+
   if (rank == 0)
   {
     fp << "<PointData  Scalars=\""
@@ -597,32 +723,37 @@ void pvtu_write(const function::Function& u, const std::string filename,
 } // namespace
 
 //----------------------------------------------------------------------------
-VTKFile::VTKFile(const std::string filename) : _filename(filename), _counter(0)
+VTKFile::VTKFile(const std::string filename, const Encoding encoding)
+    : _filename(filename), _encoding(encoding), _counter(0)
 {
   // Do nothing
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::Mesh& mesh)
 {
-  write_mesh(mesh, _filename, _counter, _counter);
+  write_mesh(mesh, _filename, _counter, _counter,
+             _encoding == Encoding::appended, _mesh_piece);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const function::Function& u)
 {
-  write_function(u, _filename, _counter, _counter);
+  write_function(u, _filename, _counter, _counter,
+                 _encoding == Encoding::appended, _mesh_piece);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const mesh::Mesh& mesh, double time)
 {
-  write_mesh(mesh, _filename, _counter, time);
+  write_mesh(mesh, _filename, _counter, time,
+             _encoding == Encoding::appended, _mesh_piece);
   ++_counter;
 }
 //----------------------------------------------------------------------------
 void VTKFile::write(const function::Function& u, double time)
 {
-  write_function(u, _filename, _counter, time);
+  write_function(u, _filename, _counter, time,
+                 _encoding == Encoding::appended, _mesh_piece);
   ++_counter;
 }
 //----------------------------------------------------------------------------
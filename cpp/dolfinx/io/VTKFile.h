@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "VTKWriter.h"
 #include <fstream>
 #include <string>
 #include <utility>
@@ -39,8 +40,20 @@ namespace io
 class VTKFile
 {
 public:
+  /// File encoding type. The appended encoding stores the data arrays
+  /// as raw binary blocks after the XML body; it is much faster to
+  /// write and produces considerably smaller files than ASCII.
+  enum class Encoding
+  {
+    ascii,
+    appended
+  };
+
   /// Create VTK file
-  VTKFile(const std::string filename);
+  /// @param[in] filename Name of the file
+  /// @param[in] encoding File encoding (ASCII or appended binary)
+  VTKFile(const std::string filename,
+          const Encoding encoding = Encoding::ascii);
 
   /// Destructor
   ~VTKFile() = default;
@@ -60,8 +73,16 @@ public:
 private:
   const std::string _filename;
 
+  // File encoding
+  const Encoding _encoding;
+
   // Counter for the number of times various data has been written
   std::size_t _counter;
+
+  // Cached serialization of the mesh, reused across time steps while
+  // the mesh is unchanged (static-grid deduplication). Only the field
+  // data is re-encoded per step.
+  VTKWriter::MeshPiece _mesh_piece;
 };
 } // namespace io
 } // namespace dolfinx
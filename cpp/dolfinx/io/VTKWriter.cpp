@@ -19,6 +19,9 @@
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
+#include <complex>
+#include <cstring>
+#include <numeric>
 #include <fstream>
 #include <iomanip>
 #include <ostream>
@@ -60,6 +63,166 @@ std::int8_t get_vtk_cell_type(const mesh::Mesh& mesh, int cell_dim)
   }
 }
 //----------------------------------------------------------------------------
+// Append a raw binary block (std::uint64_t byte count followed by the
+// payload) to the appended data buffer and return the block offset,
+// which is referenced by the "offset" attribute of the DataArray tag
+template <typename T>
+std::size_t append_block(const std::vector<T>& data,
+                         std::vector<std::uint8_t>& appended)
+{
+  const std::uint64_t num_bytes = data.size() * sizeof(T);
+  const std::size_t block_offset = appended.size();
+  appended.resize(block_offset + sizeof(num_bytes) + num_bytes);
+  std::memcpy(appended.data() + block_offset, &num_bytes, sizeof(num_bytes));
+  std::memcpy(appended.data() + block_offset + sizeof(num_bytes), data.data(),
+              num_bytes);
+  return block_offset;
+}
+//----------------------------------------------------------------------------
+// Pack function values at cell centres (padded to 3D where required)
+// into a flat array of doubles
+std::vector<double> pack_cell_data(const mesh::Mesh& mesh,
+                                   const std::vector<std::size_t>& offset,
+                                   const std::vector<PetscScalar>& values,
+                                   std::size_t data_dim, std::size_t rank)
+{
+  std::vector<double> data;
+  auto cell_offset = offset.begin();
+  const int tdim = mesh.topology().dim();
+  const int num_cells = mesh.topology().index_map(tdim)->size_local();
+  data.reserve(num_cells * data_dim);
+  for (int i = 0; i < num_cells; ++i)
+  {
+    if (rank == 1 && data_dim == 2)
+    {
+      // Append 0.0 to 2D vectors to make them 3D
+      data.push_back(std::real(values[*cell_offset]));
+      data.push_back(std::real(values[*cell_offset + 1]));
+      data.push_back(0.0);
+    }
+    else if (rank == 2 && data_dim == 4)
+    {
+      // Pad with 0.0 to 2D tensors to make them 3D
+      for (std::size_t j = 0; j < 2; j++)
+      {
+        data.push_back(std::real(values[*cell_offset + 2 * j]));
+        data.push_back(std::real(values[*cell_offset + 2 * j + 1]));
+        data.push_back(0.0);
+      }
+      data.push_back(0.0);
+      data.push_back(0.0);
+      data.push_back(0.0);
+    }
+    else
+    {
+      // Write all components
+      for (std::size_t j = 0; j < data_dim; j++)
+        data.push_back(std::real(values[*cell_offset + j]));
+    }
+    ++cell_offset;
+  }
+
+  return data;
+}
+//----------------------------------------------------------------------------
+// Build the VTK connectivity array for the mesh
+std::vector<std::int32_t> build_vtk_connectivity(const mesh::Mesh& mesh,
+                                                 int cell_dim, int& num_nodes)
+{
+  std::vector<std::int32_t> connectivity;
+  const int tdim = mesh.topology().dim();
+  if (cell_dim == 0)
+  {
+    // Special case when only points should be visualized
+    const int num_points = mesh.geometry().x().rows();
+    connectivity.resize(num_points);
+    std::iota(connectivity.begin(), connectivity.end(), 0);
+    num_nodes = 1;
+  }
+  else if (cell_dim == tdim)
+  {
+    // Special case where the cells are visualized (Supports higher
+    // order elements)
+    const graph::AdjacencyList<std::int32_t>& x_dofmap
+        = mesh.geometry().dofmap();
+    // FIXME: Use better way to get number of nods
+    num_nodes = x_dofmap.num_links(0);
+
+    // Get map from VTK index i to DOLFIN index j
+    std::vector<std::uint8_t> map = io::cells::transpose(
+        io::cells::perm_vtk(mesh.topology().cell_type(), num_nodes));
+
+    // TODO: Remove when when paraview issue 19433 is resolved
+    // (https://gitlab.kitware.com/paraview/paraview/issues/19433)
+    if (mesh.topology().cell_type() == dolfinx::mesh::CellType::hexahedron
+        and num_nodes == 27)
+    {
+      map = {0,  9, 12, 3,  1, 10, 13, 4,  18, 15, 21, 6,  19, 16,
+             22, 7, 2,  11, 5, 14, 8,  17, 20, 23, 24, 25, 26};
+    }
+
+    connectivity.reserve(x_dofmap.num_nodes() * num_nodes);
+    for (int c = 0; c < x_dofmap.num_nodes(); ++c)
+    {
+      auto x_dofs = x_dofmap.links(c);
+      for (int i = 0; i < x_dofs.rows(); ++i)
+        connectivity.push_back(x_dofs(map[i]));
+    }
+  }
+  else
+  {
+    throw std::runtime_error(
+        "VTK outout for mesh_entities for dim<tdim is not implemented yet.");
+  }
+
+  return connectivity;
+}
+//----------------------------------------------------------------------------
+// mesh::Mesh writer (appended binary)
+void write_binary_mesh(const mesh::Mesh& mesh, int cell_dim,
+                       std::ostream& file, std::vector<std::uint8_t>& appended)
+{
+  const int num_cells = mesh.topology().index_map(cell_dim)->size_local();
+
+  // Get VTK cell type
+  const std::int8_t vtk_cell_type = get_vtk_cell_type(mesh, cell_dim);
+
+  // Write vertex positions
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points
+      = mesh.geometry().x();
+  std::vector<double> point_data(points.data(),
+                                 points.data() + points.size());
+  file << "<Points>" << std::endl;
+  file << R"(<DataArray  type="Float64"  NumberOfComponents="3"  )"
+       << R"(format="appended" offset=")" << append_block(point_data, appended)
+       << "\" />" << std::endl
+       << "</Points>" << std::endl;
+
+  // Write cell connectivity
+  int num_nodes = 0;
+  const std::vector<std::int32_t> connectivity
+      = build_vtk_connectivity(mesh, cell_dim, num_nodes);
+  file << "<Cells>" << std::endl;
+  file << R"(<DataArray  type="Int32"  Name="connectivity"  )"
+       << R"(format="appended" offset=")"
+       << append_block(connectivity, appended) << "\" />" << std::endl;
+
+  // Write offset into connectivity array for the end of each cell
+  std::vector<std::int32_t> offsets(num_cells);
+  for (int c = 0; c < num_cells; ++c)
+    offsets[c] = (c + 1) * num_nodes;
+  file << R"(<DataArray  type="Int32"  Name="offsets"  )"
+       << R"(format="appended" offset=")" << append_block(offsets, appended)
+       << "\" />" << std::endl;
+
+  // Write cell type
+  const std::vector<std::int8_t> types(num_cells, vtk_cell_type);
+  file << R"(<DataArray  type="Int8"  Name="types"  )"
+       << R"(format="appended" offset=")" << append_block(types, appended)
+       << "\" />" << std::endl;
+  file << "</Cells>" << std::endl;
+}
+//----------------------------------------------------------------------------
 // Write cell data (ascii)
 std::string ascii_cell_data(const mesh::Mesh& mesh,
                             const std::vector<std::size_t>& offset,
@@ -107,21 +270,14 @@ std::string ascii_cell_data(const mesh::Mesh& mesh,
 }
 //----------------------------------------------------------------------------
 // mesh::Mesh writer (ascii)
-void write_ascii_mesh(const mesh::Mesh& mesh, int cell_dim,
-                      std::string filename)
+void write_ascii_mesh(const mesh::Mesh& mesh, int cell_dim, std::ostream& file)
 {
   const int num_cells = mesh.topology().index_map(cell_dim)->size_local();
 
   // Get VTK cell type
   const std::int8_t vtk_cell_type = get_vtk_cell_type(mesh, cell_dim);
 
-  // Open file
-  std::ofstream file(filename.c_str(), std::ios::app);
   file.precision(16);
-  if (!file.is_open())
-  {
-    throw std::runtime_error("Unable to open file:" + filename);
-  }
 
   // Write vertex positions
   file << "<Points>" << std::endl;
@@ -242,19 +398,40 @@ void write_ascii_mesh(const mesh::Mesh& mesh, int cell_dim,
     file << std::to_string(vtk_cell_type) << " ";
   file << "</DataArray>" << std::endl;
   file << "</Cells>" << std::endl;
-
-  // Close file
-  file.close();
 }
 //-----------------------------------------------------------------------------
 
 } // namespace
 
+//----------------------------------------------------------------------------
+void VTKWriter::update_mesh_piece(const mesh::Mesh& mesh, std::size_t cell_dim,
+                                  bool binary, MeshPiece& piece)
+{
+  if (piece.built and piece.id == mesh.id()
+      and piece.version == mesh.geometry().version())
+  {
+    return;
+  }
+
+  std::ostringstream ss;
+  piece.blocks.clear();
+  if (binary)
+    write_binary_mesh(mesh, cell_dim, ss, piece.blocks);
+  else
+    write_ascii_mesh(mesh, cell_dim, ss);
+  piece.xml = ss.str();
+  piece.id = mesh.id();
+  piece.version = mesh.geometry().version();
+  piece.built = true;
+}
 //----------------------------------------------------------------------------
 void VTKWriter::write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
                            std::string filename)
 {
-  write_ascii_mesh(mesh, cell_dim, filename);
+  std::ofstream file(filename.c_str(), std::ios::app);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open file:" + filename);
+  write_ascii_mesh(mesh, cell_dim, file);
 }
 //----------------------------------------------------------------------------
 void VTKWriter::write_cell_data(const function::Function& u,
@@ -359,3 +536,111 @@ void VTKWriter::write_cell_data(const function::Function& u,
   fp << "</CellData> " << std::endl;
 }
 //----------------------------------------------------------------------------
+void VTKWriter::write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
+                           std::string filename,
+                           std::vector<std::uint8_t>& appended)
+{
+  std::ofstream file(filename.c_str(), std::ios::app);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open file:" + filename);
+  write_binary_mesh(mesh, cell_dim, file, appended);
+}
+//----------------------------------------------------------------------------
+void VTKWriter::write_cell_data(const function::Function& u,
+                                std::string filename,
+                                std::vector<std::uint8_t>& appended)
+{
+  assert(u.function_space());
+  std::shared_ptr<const mesh::Mesh> mesh = u.function_space()->mesh();
+  assert(mesh);
+  std::shared_ptr<const fem::DofMap> dofmap = u.function_space()->dofmap();
+  assert(dofmap);
+  const int tdim = mesh->topology().dim();
+  const std::int32_t num_cells = mesh->topology().index_map(tdim)->size_local();
+
+  // Get rank of function::Function
+  const int rank = u.value_rank();
+  if (rank > 2)
+  {
+    throw std::runtime_error("Don't know how to handle vector function with "
+                             "dimension other than 2 or 3");
+  }
+
+  // Get number of components
+  const int data_dim = u.value_size();
+  int num_components = 0;
+  if (rank == 1)
+  {
+    if (!(data_dim == 2 || data_dim == 3))
+    {
+      throw std::runtime_error(
+          "Don't know how to handle vector function with dimension  "
+          "other than 2 or 3");
+    }
+    num_components = 3;
+  }
+  else if (rank == 2)
+  {
+    if (!(data_dim == 4 || data_dim == 9))
+    {
+      throw std::runtime_error("Don't know how to handle tensor function with "
+                               "dimension other than 4 or 9");
+    }
+    num_components = 9;
+  }
+
+  // Build lists of dofs and create map
+  std::vector<std::int32_t> dof_set;
+  std::vector<std::size_t> offset(num_cells * data_dim + 1);
+  auto cell_offset = offset.begin();
+  assert(dofmap->element_dof_layout);
+  const int num_dofs_cell = dofmap->element_dof_layout->num_dofs();
+  for (int c = 0; c < num_cells; ++c)
+  {
+    // Tabulate dofs
+    auto dofs = dofmap->cell_dofs(c);
+    for (int i = 0; i < num_dofs_cell; ++i)
+      dof_set.push_back(dofs[i]);
+
+    // Add local dimension to cell offset and increment
+    *(cell_offset + 1) = *(cell_offset) + num_dofs_cell;
+    ++cell_offset;
+  }
+
+  // Get values
+  std::vector<PetscScalar> values(dof_set.size());
+  la::VecReadWrapper u_wrapper(u.vector().vec());
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _x
+      = u_wrapper.x;
+  for (std::size_t i = 0; i < dof_set.size(); ++i)
+    values[i] = _x[dof_set[i]];
+
+  // Pack and append cell data as one raw block
+  const std::vector<double> data
+      = pack_cell_data(*mesh, offset, values, data_dim, rank);
+
+  std::ofstream fp(filename.c_str(), std::ios_base::app);
+  if (rank == 0)
+  {
+    fp << "<CellData  Scalars=\""
+       << "u"
+       << "\"> " << std::endl;
+    fp << R"(<DataArray  type="Float64"  Name=")"
+       << "u"
+       << R"("  format="appended" offset=")" << append_block(data, appended)
+       << "\" />" << std::endl;
+  }
+  else
+  {
+    fp << "<CellData  " << (rank == 1 ? "Vectors" : "Tensors") << "=\""
+       << "u"
+       << "\"> " << std::endl;
+    fp << R"(<DataArray  type="Float64"  Name=")"
+       << "u"
+       << "\"  NumberOfComponents=\"" << num_components
+       << R"("  format="appended" offset=")" << append_block(data, appended)
+       << "\" />" << std::endl;
+  }
+  fp << "</CellData> " << std::endl;
+}
+//----------------------------------------------------------------------------
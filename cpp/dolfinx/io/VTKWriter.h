@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -29,12 +30,50 @@ namespace io
 class VTKWriter
 {
 public:
+  /// Serialized VTK form of a mesh: the XML fragment holding the
+  /// Points and Cells arrays and, in the appended binary encoding, the
+  /// raw data blocks it references (empty in ascii mode, where the
+  /// data is inline in the XML). VTKFile caches this between time
+  /// steps so that a static mesh is encoded only once; the VTU format
+  /// requires every file to contain its grid, so the cached bytes are
+  /// still emitted per step.
+  struct MeshPiece
+  {
+    /// True once the piece has been built
+    bool built = false;
+    /// Mesh::id() the piece was built from
+    std::size_t id = 0;
+    /// Geometry version at build time
+    std::size_t version = 0;
+    /// Points/Cells XML fragment
+    std::string xml;
+    /// Raw binary blocks referenced by the XML (appended encoding).
+    /// The mesh blocks are always first in the appended section, so
+    /// the offsets remain valid when the piece is reused.
+    std::vector<std::uint8_t> blocks;
+  };
+
+  /// Build the serialized mesh piece, or reuse it unchanged when it
+  /// was built from the same mesh and geometry version
+  static void update_mesh_piece(const mesh::Mesh& mesh, std::size_t cell_dim,
+                                bool binary, MeshPiece& piece);
+
   /// mesh::Mesh writer
   static void write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
                          std::string file);
 
   /// Cell data writer
   static void write_cell_data(const function::Function& u, std::string file);
+
+  /// mesh::Mesh writer (appended binary encoding). DataArray tags
+  /// reference raw binary blocks collected in @p appended, which the
+  /// caller writes out in the AppendedData section of the file.
+  static void write_mesh(const mesh::Mesh& mesh, std::size_t cell_dim,
+                         std::string file, std::vector<std::uint8_t>& appended);
+
+  /// Cell data writer (appended binary encoding)
+  static void write_cell_data(const function::Function& u, std::string file,
+                              std::vector<std::uint8_t>& appended);
 };
 } // namespace io
 } // namespace dolfinx
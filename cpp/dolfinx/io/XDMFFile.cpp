@@ -14,6 +14,7 @@
 #include "xdmf_utils.h"
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <dolfinx/common/Timer.h>
 #include <dolfinx/common/utils.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/graph/AdjacencyList.h>
@@ -21,13 +22,17 @@
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/utils.h>
+#include <fstream>
+#include <numeric>
+#include <sstream>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
 
 //-----------------------------------------------------------------------------
 XDMFFile::XDMFFile(MPI_Comm comm, const std::string filename,
-                   const std::string file_mode, const Encoding encoding)
+                   const std::string file_mode, const Encoding encoding,
+                   const HDF5IOProfile& io_profile)
     : _mpi_comm(comm), _filename(filename), _file_mode(file_mode),
       _xml_doc(new pugi::xml_document), _encoding(encoding)
 {
@@ -44,7 +49,7 @@ XDMFFile::XDMFFile(MPI_Comm comm, const std::string filename,
     const std::string hdf5_filename = xdmf_utils::get_hdf5_filename(_filename);
     const bool mpi_io = MPI::size(_mpi_comm.comm()) > 1 ? true : false;
     _h5_id = HDF5Interface::open_file(_mpi_comm.comm(), hdf5_filename,
-                                      file_mode, mpi_io);
+                                      file_mode, mpi_io, io_profile);
     assert(_h5_id > 0);
     LOG(INFO) << "Opened HDF5 file with id \"" << _h5_id << "\"";
   }
@@ -118,11 +123,19 @@ XDMFFile::~XDMFFile() { close(); }
 //-----------------------------------------------------------------------------
 void XDMFFile::close()
 {
+  // Wait for any in-flight asynchronous write before closing the file
+  fence();
   if (_h5_id > 0)
     HDF5Interface::close_file(_h5_id);
   _h5_id = -1;
 }
 //-----------------------------------------------------------------------------
+void XDMFFile::fence()
+{
+  if (_io_thread.joinable())
+    _io_thread.join();
+}
+//-----------------------------------------------------------------------------
 void XDMFFile::write_mesh(const mesh::Mesh& mesh, const std::string xpath)
 {
   pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
@@ -130,9 +143,13 @@ void XDMFFile::write_mesh(const mesh::Mesh& mesh, const std::string xpath)
     throw std::runtime_error("XML node '" + xpath + "' not found.");
 
   // Add the mesh Grid to the domain
-  xdmf_mesh::add_mesh(_mpi_comm.comm(), node, _h5_id, mesh, mesh.name);
+  xdmf_mesh::add_mesh(_mpi_comm.comm(), node, _h5_id, mesh, mesh.name,
+                      store_partition);
 
-  // Save XML file (on process 0 only)
+  // Save XML file (on process 0 only). The tree has changed outside
+  // the time series, so the next time-series flush must be a full
+  // rewrite.
+  _xml_tail_offset = -1;
   if (MPI::rank(_mpi_comm.comm()) == 0)
     _xml_doc->save_file(_filename.c_str(), "  ");
 }
@@ -154,7 +171,10 @@ void XDMFFile::write_geometry(const mesh::Geometry& geometry,
   xdmf_mesh::add_geometry_data(_mpi_comm.comm(), grid_node, _h5_id, path_prefix,
                                geometry);
 
-  // Save XML file (on process 0 only)
+  // Save XML file (on process 0 only). The tree has changed outside
+  // the time series, so the next time-series flush must be a full
+  // rewrite.
+  _xml_tail_offset = -1;
   if (MPI::rank(_mpi_comm.comm()) == 0)
     _xml_doc->save_file(_filename.c_str(), "  ");
 }
@@ -164,14 +184,59 @@ mesh::Mesh XDMFFile::read_mesh(const fem::CoordinateElement& element,
                                const std::string name,
                                const std::string xpath) const
 {
-  // Read mesh data
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
-                     Eigen::RowMajor>
-      cells = XDMFFile::read_topology_data(name, xpath);
+  common::Timer timer("XDMF read mesh");
+
+  pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
+  if (!node)
+    throw std::runtime_error("XML node '" + xpath + "' not found.");
+
+  pugi::xml_node grid_node
+      = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
+  if (!grid_node)
+    throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+
+  // If the file records the decomposition it was written with and the
+  // communicator size matches, each rank reads exactly the cells it
+  // owned at write time and the graph partitioner is skipped
+  const std::array<std::int64_t, 2> partition_range
+      = xdmf_mesh::read_partition_range(_mpi_comm.comm(), _h5_id, grid_node);
+  const bool use_partition
+      = partition_range[0] >= 0 and mode != mesh::GhostMode::shared_vertex;
+
+  // Read topology data in bounded windows (2M cells per window) to
+  // avoid holding the raw file data alongside the permuted cells
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cells = use_partition
+                  ? xdmf_mesh::read_topology_data(_mpi_comm.comm(), _h5_id,
+                                                  grid_node, 2097152,
+                                                  partition_range)
+                  : xdmf_mesh::read_topology_data(_mpi_comm.comm(), _h5_id,
+                                                  grid_node, 2097152);
   const auto x = XDMFFile::read_geometry_data(name, xpath);
 
-  // Create mesh
+  // Create mesh, releasing the intermediate cell array once it has
+  // been captured in the adjacency list
   graph::AdjacencyList<std::int64_t> cells_adj(cells);
+  cells.resize(0, 0);
+  if (use_partition)
+  {
+    // Every cell stays on the rank that wrote it. The ghost layer, if
+    // requested, is rebuilt afterwards; it is not part of the stored
+    // decomposition.
+    const std::int32_t num_cells = cells_adj.num_nodes();
+    std::vector<std::int32_t> offsets(num_cells + 1);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    const graph::AdjacencyList<std::int32_t> dest(
+        std::vector<std::int32_t>(num_cells, MPI::rank(_mpi_comm.comm())),
+        std::move(offsets));
+    mesh::Mesh mesh = mesh::create_mesh(_mpi_comm.comm(), cells_adj, element, x,
+                                        mesh::GhostMode::none, dest);
+    if (mode == mesh::GhostMode::shared_facet)
+      mesh = mesh::add_ghost_layer(mesh);
+    mesh.name = name;
+    return mesh;
+  }
+
   mesh::Mesh mesh
       = mesh::create_mesh(_mpi_comm.comm(), cells_adj, element, x, mode);
   mesh.name = name;
@@ -255,9 +320,71 @@ void XDMFFile::write_function(const function::Function& function,
   // Add the mesh Grid to the domain
   xdmf_function::add_function(_mpi_comm.comm(), function, t, grid_node, _h5_id);
 
-  // Save XML file (on process 0 only)
+  // Flush XML file (on process 0 only). When the time series Grid is
+  // the last node in the Domain and the position of the closing tags
+  // from the previous flush is known, only the new Grid and the
+  // closing tags are written, so the per-step XML cost does not grow
+  // with the number of steps.
   if (MPI::rank(_mpi_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  {
+    const std::string tail = "    </Grid>\n  </Domain>\n</Xdmf>\n";
+    if (_xml_tail_offset >= 0 and !timegrid_node.next_sibling())
+    {
+      // Serialize only the newly appended Grid, at its depth in the
+      // document
+      std::ostringstream ss;
+      grid_node.print(ss, "  ", pugi::format_default, pugi::encoding_auto, 3);
+
+      std::fstream xml_file(_filename,
+                            std::ios::in | std::ios::out | std::ios::binary);
+      xml_file.seekp(_xml_tail_offset);
+      xml_file << ss.str();
+      _xml_tail_offset = xml_file.tellp();
+      xml_file << tail;
+    }
+    else
+    {
+      // Full rewrite. If the document ends with the expected closing
+      // tags, record their position so that subsequent steps can
+      // append incrementally.
+      std::ostringstream ss;
+      _xml_doc->save(ss, "  ");
+      const std::string xml = ss.str();
+      std::ofstream xml_file(_filename, std::ios::binary);
+      xml_file << xml;
+
+      if (!timegrid_node.next_sibling() and xml.size() >= tail.size()
+          and xml.compare(xml.size() - tail.size(), tail.size(), tail) == 0)
+      {
+        _xml_tail_offset = xml.size() - tail.size();
+      }
+      else
+        _xml_tail_offset = -1;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void XDMFFile::write_function_async(const function::Function& function,
+                                    const double t,
+                                    const std::string mesh_xpath)
+{
+  // Bound the number of in-flight checkpoints to one
+  fence();
+
+  // Snapshot the function vector into the staging buffer (reused
+  // between checkpoints on the same function space)
+  if (!_staging or _staging->function_space() != function.function_space())
+  {
+    _staging
+        = std::make_unique<function::Function>(function.function_space());
+  }
+  VecCopy(function.vector().vec(), _staging->vector().vec());
+  _staging->name = function.name;
+
+  // Assemble the XML and perform the HDF5 writes in the background
+  _io_thread = std::thread([this, t, mesh_xpath]() {
+    this->write_function(*_staging, t, mesh_xpath);
+  });
 }
 //-----------------------------------------------------------------------------
 void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>& meshtags,
@@ -280,7 +407,10 @@ void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>& meshtags,
   xdmf_meshtags::add_meshtags(_mpi_comm.comm(), meshtags, grid_node, _h5_id,
                               meshtags.name);
 
-  // Save XML file (on process 0 only)
+  // Save XML file (on process 0 only). The tree has changed outside
+  // the time series, so the next time-series flush must be a full
+  // rewrite.
+  _xml_tail_offset = -1;
   if (MPI::rank(_mpi_comm.comm()) == 0)
     _xml_doc->save_file(_filename.c_str(), "  ");
 }
@@ -301,10 +431,26 @@ XDMFFile::read_meshtags(const std::shared_ptr<const mesh::Mesh>& mesh,
                      Eigen::RowMajor>
       entities = read_topology_data(name, xpath);
 
-  pugi::xml_node values_data_node
-      = grid_node.child("Attribute").child("DataItem");
-  std::vector<std::int32_t> values = xdmf_read::get_dataset<std::int32_t>(
-      _mpi_comm.comm(), values_data_node, _h5_id);
+  pugi::xml_node attribute_node = grid_node.child("Attribute");
+  pugi::xml_node values_data_node = attribute_node.child("DataItem");
+  pugi::xml_node encoding_node = attribute_node.find_child_by_attribute(
+      "Information", "Name", "Encoding");
+  std::vector<std::int32_t> values;
+  if (encoding_node
+      and std::string(encoding_node.attribute("Value").as_string()) == "RLE")
+  {
+    // Values are run-length encoded (see xdmf_meshtags::add_meshtags).
+    // Every rank reads the (small) encoded dataset and expands only
+    // its block of the decoded sequence.
+    const std::vector<std::int32_t> runs = xdmf_read::get_dataset<std::int32_t>(
+        _mpi_comm.comm(), values_data_node, _h5_id, {{-1, -1}});
+    values = xdmf_read::decode_rle(_mpi_comm.comm(), runs);
+  }
+  else
+  {
+    values = xdmf_read::get_dataset<std::int32_t>(_mpi_comm.comm(),
+                                                  values_data_node, _h5_id);
+  }
 
   const std::pair<std::string, int> cell_type_str
       = xdmf_utils::get_cell_type(grid_node.child("Topology"));
@@ -366,7 +512,10 @@ void XDMFFile::write_information(const std::string name,
   info_node.append_attribute("Name") = name.c_str();
   info_node.append_attribute("Value") = value.c_str();
 
-  // Save XML file (on process 0 only)
+  // Save XML file (on process 0 only). The tree has changed outside
+  // the time series, so the next time-series flush must be a full
+  // rewrite.
+  _xml_tail_offset = -1;
   if (MPI::rank(_mpi_comm.comm()) == 0)
     _xml_doc->save_file(_filename.c_str(), "  ");
 }
@@ -11,6 +11,7 @@
 #include <dolfinx/mesh/cell_types.h>
 #include <memory>
 #include <string>
+#include <thread>
 
 namespace pugi
 {
@@ -67,9 +68,18 @@ public:
   static const Encoding default_encoding = Encoding::HDF5;
 
   /// Constructor
+  /// @param[in] comm MPI communicator
+  /// @param[in] filename Name of the file
+  /// @param[in] file_mode Mode in which to open the file (w, r, a)
+  /// @param[in] encoding File encoding
+  /// @param[in] io_profile HDF5 I/O tuning parameters. Alignment and
+  ///   MPI-IO hints are applied when the HDF5 file is opened; the
+  ///   chunking and compression settings apply to every floating-point
+  ///   dataset subsequently written through this file
   XDMFFile(MPI_Comm comm, const std::string filename,
            const std::string file_mode,
-           const Encoding encoding = default_encoding);
+           const Encoding encoding = default_encoding,
+           const HDF5IOProfile& io_profile = HDF5IOProfile());
 
   /// Destructor
   ~XDMFFile();
@@ -81,7 +91,9 @@ public:
   /// no effect.
   void close();
 
-  /// Save Mesh
+  /// Save Mesh. With store_partition set, the decomposition is
+  /// recorded alongside the mesh data and a later read_mesh on the
+  /// same number of ranks skips the graph partitioner.
   /// @param[in] mesh
   /// @param[in] xpath XPath where Mesh Grid will be written
   void write_mesh(const mesh::Mesh& mesh,
@@ -94,7 +106,11 @@ public:
   void write_geometry(const mesh::Geometry& geometry, const std::string name,
                       const std::string xpath = "/Xdmf/Domain");
 
-  /// Read in Mesh
+  /// Read in Mesh. If the file records the decomposition it was
+  /// written with (see store_partition) and the communicator size
+  /// matches, the recorded partition is reused and the graph
+  /// partitioner is skipped; otherwise the cells are partitioned from
+  /// scratch.
   /// @param[in] element Element that describes the geometry of a cell
   /// @param[in] mode The type of ghosting/halo to use for the mesh when
   ///   distributed in parallel
@@ -138,6 +154,27 @@ public:
                       const std::string mesh_xpath
                       = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]");
 
+  /// Write Function asynchronously. The function vector is snapshotted
+  /// into a reusable staging buffer (one vector copy) and the XML
+  /// assembly and HDF5 writes are performed on a background thread
+  /// while the caller continues. At most one checkpoint is in flight:
+  /// a second call (and close()) first waits for the previous write to
+  /// complete. In parallel the MPI library must have been initialised
+  /// with MPI_THREAD_MULTIPLE, and the caller must not perform
+  /// communication on the file communicator while a write is in
+  /// flight.
+  /// @param[in] function The Function to write to file
+  /// @param[in] t The time stamp to associate with the Function
+  /// @param[in] mesh_xpath XPath for a Grid under which Function will
+  ///   be inserted
+  void write_function_async(const function::Function& function, const double t,
+                            const std::string mesh_xpath
+                            = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]");
+
+  /// Wait for an in-flight asynchronous write to complete. A no-op if
+  /// no write is in flight.
+  void fence();
+
   /// Write MeshTags
   /// @param[in] meshtags
   /// @param[in] geometry_xpath XPath where Geometry is already stored
@@ -173,6 +210,15 @@ public:
   /// @return The MPI communicator for the file object
   MPI_Comm comm() const;
 
+  /// Store the decomposition when writing a mesh: write_mesh records
+  /// the per-rank owned cell counts as an extra dataset, and read_mesh
+  /// on the same number of ranks reuses them instead of running the
+  /// graph partitioner. The in-file record is portable across
+  /// machines, complementing the on-disk partition cache
+  /// (DOLFINX_PARTITION_CACHE), which is keyed to the local
+  /// filesystem.
+  bool store_partition = false;
+
 private:
   // MPI communicator
   dolfinx::MPI::Comm _mpi_comm;
@@ -191,6 +237,20 @@ private:
   std::unique_ptr<pugi::xml_document> _xml_doc;
 
   Encoding _encoding;
+
+  // Staging buffer (snapshot) for asynchronous writes, reused between
+  // checkpoints on the same function space
+  std::unique_ptr<function::Function> _staging;
+
+  // Background thread performing an in-flight asynchronous write
+  std::thread _io_thread;
+
+  // Byte offset of the closing tags in the XDMF file when the time
+  // series Grid is the last node in the Domain. Used to flush
+  // time-series steps by appending only the new Grid and rewriting the
+  // tail, rather than re-serializing the whole XML tree. Set to -1
+  // whenever the tree changes elsewhere, forcing a full rewrite.
+  std::int64_t _xml_tail_offset = -1;
 };
 
 } // namespace io
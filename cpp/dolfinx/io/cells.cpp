@@ -6,13 +6,42 @@
 
 #include "cells.h"
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <numeric>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace dolfinx;
 namespace
 {
+// Execute f(begin, end) over [0, n) on the worker threads (see
+// DOLFINX_NUM_THREADS), splitting the range into one contiguous chunk
+// per thread. Runs serially for small n or a single thread.
+template <typename Fn>
+void parallel_for_range(Eigen::Index n, Fn&& f)
+{
+  const int num_threads = common::num_worker_threads();
+  if (num_threads <= 1 or n < 2 * num_threads)
+  {
+    f(Eigen::Index(0), n);
+    return;
+  }
+
+  const Eigen::Index chunk = (n + num_threads - 1) / num_threads;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    const Eigen::Index begin = t * chunk;
+    const Eigen::Index end = std::min(begin + chunk, n);
+    if (begin < end)
+      threads.emplace_back(f, begin, end);
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+}
+//-----------------------------------------------------------------------------
 int cell_degree(mesh::CellType type, int num_nodes)
 {
   switch (type)
@@ -361,13 +390,19 @@ io::cells::compute_permutation(
 {
   Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       cells_new(cells.rows(), cells.cols());
-  for (Eigen::Index c = 0; c < cells_new.rows(); ++c)
-  {
-    auto cell = cells.row(c);
-    auto cell_new = cells_new.row(c);
-    for (Eigen::Index i = 0; i < cell_new.size(); ++i)
-      cell_new(i) = cell(p[i]);
-  }
+
+  // Gather the permuted nodes of each cell, with the cells divided in
+  // contiguous blocks over the worker threads (cells are independent)
+  parallel_for_range(cells_new.rows(),
+                     [&](Eigen::Index c_begin, Eigen::Index c_end) {
+                       for (Eigen::Index c = c_begin; c < c_end; ++c)
+                       {
+                         auto cell = cells.row(c);
+                         auto cell_new = cells_new.row(c);
+                         for (Eigen::Index i = 0; i < cell_new.size(); ++i)
+                           cell_new(i) = cell(p[i]);
+                       }
+                     });
   return cells_new;
 }
 //-----------------------------------------------------------------------------
@@ -0,0 +1,247 @@
+// Copyright (C) 2020 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "checkpoint.h"
+#include "HDF5Interface.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/function/Function.h>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/la/PETScVector.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <petscsys.h>
+
+using namespace dolfinx;
+using namespace dolfinx::io;
+
+namespace
+{
+// Number of doubles per PetscScalar (2 for complex builds). Values are
+// stored as raw doubles so the file layout does not depend on the
+// PETSc scalar type of the writing build.
+constexpr std::int64_t doubles_per_scalar
+    = sizeof(PetscScalar) / sizeof(double);
+} // namespace
+
+//-----------------------------------------------------------------------------
+void checkpoint::write(const std::string& filename, const function::Function& u)
+{
+  assert(u.function_space());
+  assert(u.function_space()->dofmap());
+  const auto map = u.function_space()->dofmap()->index_map;
+  assert(map);
+  assert(u.function_space()->mesh());
+  MPI_Comm comm = u.function_space()->mesh()->mpi_comm();
+
+  const int bs = map->block_size();
+  const std::array<std::int64_t, 2> range = map->local_range();
+  const std::int64_t num_blocks_global = map->size_global();
+  const bool mpi_io = dolfinx::MPI::size(comm) > 1;
+
+  const hid_t h5_id
+      = HDF5Interface::open_file(comm, filename, "w", mpi_io);
+
+  // Write the owned dof values at their global dof positions. Dof
+  // ownership is a block distribution over the global dof order, so
+  // this is one contiguous hyperslab per rank.
+  la::VecReadWrapper x(u.vector().vec());
+  const std::int64_t stride = bs * doubles_per_scalar;
+  HDF5Interface::write_dataset<double>(
+      h5_id, "/checkpoint/values",
+      reinterpret_cast<const double*>(x.x.data()),
+      {range[0] * stride, range[1] * stride},
+      {num_blocks_global * stride}, mpi_io, false);
+  x.restore();
+
+  // Write the index map metadata needed to validate a restore (rank 0
+  // writes, the other ranks join the collective call with an empty
+  // block)
+  const std::array<std::int64_t, 3> metadata
+      = {bs, num_blocks_global, doubles_per_scalar};
+  const std::array<std::int64_t, 2> meta_range
+      = dolfinx::MPI::rank(comm) == 0
+            ? std::array<std::int64_t, 2>{0, 3}
+            : std::array<std::int64_t, 2>{3, 3};
+  HDF5Interface::write_dataset<std::int64_t>(h5_id, "/checkpoint/metadata",
+                                             metadata.data(), meta_range, {3},
+                                             mpi_io, false);
+
+  HDF5Interface::close_file(h5_id);
+}
+//-----------------------------------------------------------------------------
+void checkpoint::write(const std::string& filename, const function::Function& u,
+                       int ranks_per_file)
+{
+  assert(u.function_space());
+  assert(u.function_space()->dofmap());
+  const auto map = u.function_space()->dofmap()->index_map;
+  assert(map);
+  assert(u.function_space()->mesh());
+  MPI_Comm comm = u.function_space()->mesh()->mpi_comm();
+
+  const int bs = map->block_size();
+  const std::array<std::int64_t, 2> range = map->local_range();
+  const std::int64_t num_blocks_global = map->size_global();
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Resolve the group size: one file per compute node when not given
+  int rpf = ranks_per_file;
+  if (rpf <= 0)
+  {
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                        &node_comm);
+    const int node_size = dolfinx::MPI::size(node_comm);
+    MPI_Comm_free(&node_comm);
+    MPI_Allreduce(&node_size, &rpf, 1, MPI_INT, MPI_MAX, comm);
+  }
+
+  const int num_parts = (size + rpf - 1) / rpf;
+  const int part = rank / rpf;
+  MPI_Comm part_comm;
+  MPI_Comm_split(comm, part, rank, &part_comm);
+
+  // Gather the start of every rank's owned block range. Ownership is a
+  // block distribution over the global dof order, so part k covers the
+  // contiguous range [starts[k * rpf], starts[min((k + 1) * rpf, size)])
+  std::vector<std::int64_t> rank_starts(size + 1);
+  MPI_Allgather(&range[0], 1, MPI_INT64_T, rank_starts.data(), 1, MPI_INT64_T,
+                comm);
+  rank_starts[size] = num_blocks_global;
+  const std::int64_t part_start = rank_starts[std::size_t(part) * rpf];
+  const std::int64_t part_end
+      = rank_starts[std::min(std::size_t(part + 1) * rpf, std::size_t(size))];
+
+  // Each part writes its slice of the global dof order to its own file
+  const bool mpi_io = dolfinx::MPI::size(part_comm) > 1;
+  const hid_t h5_id = HDF5Interface::open_file(
+      part_comm, filename + "." + std::to_string(part), "w", mpi_io);
+  la::VecReadWrapper x(u.vector().vec());
+  const std::int64_t stride = bs * doubles_per_scalar;
+  HDF5Interface::write_dataset<double>(
+      h5_id, "/checkpoint/values",
+      reinterpret_cast<const double*>(x.x.data()),
+      {(range[0] - part_start) * stride, (range[1] - part_start) * stride},
+      {(part_end - part_start) * stride}, mpi_io, false);
+  x.restore();
+  HDF5Interface::close_file(h5_id);
+  MPI_Comm_free(&part_comm);
+
+  // Rank 0 writes the manifest: part count, restore metadata and the
+  // global block range boundaries of the parts
+  if (rank == 0)
+  {
+    std::vector<std::int64_t> manifest
+        = {num_parts, bs, num_blocks_global, doubles_per_scalar};
+    for (int k = 0; k <= num_parts; ++k)
+      manifest.push_back(
+          rank_starts[std::min(std::size_t(k) * rpf, std::size_t(size))]);
+    const hid_t m_id = HDF5Interface::open_file(MPI_COMM_SELF, filename, "w",
+                                                false);
+    HDF5Interface::write_dataset<std::int64_t>(
+        m_id, "/checkpoint/manifest", manifest.data(),
+        {0, (std::int64_t)manifest.size()}, {(std::int64_t)manifest.size()},
+        false, false);
+    HDF5Interface::close_file(m_id);
+  }
+}
+//-----------------------------------------------------------------------------
+void checkpoint::read(const std::string& filename, function::Function& u)
+{
+  assert(u.function_space());
+  assert(u.function_space()->dofmap());
+  const auto map = u.function_space()->dofmap()->index_map;
+  assert(map);
+  assert(u.function_space()->mesh());
+  MPI_Comm comm = u.function_space()->mesh()->mpi_comm();
+
+  const int bs = map->block_size();
+  const std::array<std::int64_t, 2> range = map->local_range();
+  const bool mpi_io = dolfinx::MPI::size(comm) > 1;
+
+  const hid_t h5_id = HDF5Interface::open_file(comm, filename, "r", mpi_io);
+
+  // A split (file-per-node) checkpoint carries a manifest instead of
+  // the values; reassemble from the part files
+  if (HDF5Interface::has_dataset(h5_id, "/checkpoint/manifest"))
+  {
+    const std::vector<std::int64_t> manifest
+        = HDF5Interface::read_dataset<std::int64_t>(
+            h5_id, "/checkpoint/manifest", {-1, -1});
+    HDF5Interface::close_file(h5_id);
+    if (manifest.size() < 4
+        or (std::int64_t)manifest.size() != 4 + manifest[0] + 1)
+      throw std::runtime_error("Malformed checkpoint manifest.");
+    const std::int64_t num_parts = manifest[0];
+    if (manifest[1] != bs or manifest[2] != map->size_global()
+        or manifest[3] != doubles_per_scalar)
+    {
+      throw std::runtime_error(
+          "Checkpoint file is incompatible with the Function.");
+    }
+    const std::int64_t* starts = manifest.data() + 4;
+
+    // Read the overlap with each part file that intersects the owned
+    // block range (independent I/O - at most a handful of parts per
+    // rank)
+    const std::int64_t stride = bs * doubles_per_scalar;
+    la::VecWrapper x(u.vector().vec());
+    double* xdata = reinterpret_cast<double*>(x.x.data());
+    for (std::int64_t k = 0; k < num_parts; ++k)
+    {
+      const std::int64_t lo = std::max(range[0], starts[k]);
+      const std::int64_t hi = std::min(range[1], starts[k + 1]);
+      if (lo >= hi)
+        continue;
+      const hid_t p_id = HDF5Interface::open_file(
+          MPI_COMM_SELF, filename + "." + std::to_string(k), "r", false);
+      const std::vector<double> values = HDF5Interface::read_dataset<double>(
+          p_id, "/checkpoint/values",
+          {(lo - starts[k]) * stride, (hi - starts[k]) * stride});
+      HDF5Interface::close_file(p_id);
+      std::memcpy(xdata + (lo - range[0]) * stride, values.data(),
+                  values.size() * sizeof(double));
+    }
+    x.restore();
+    u.vector().update_ghosts();
+    return;
+  }
+
+  // Check that the checkpoint matches the function space
+  const std::vector<std::int64_t> metadata
+      = HDF5Interface::read_dataset<std::int64_t>(h5_id, "/checkpoint/metadata",
+                                                  {-1, -1});
+  if (metadata.size() != 3 or metadata[0] != bs
+      or metadata[1] != map->size_global()
+      or metadata[2] != doubles_per_scalar)
+  {
+    HDF5Interface::close_file(h5_id);
+    throw std::runtime_error(
+        "Checkpoint file is incompatible with the Function.");
+  }
+
+  // Read the owned block of dof values (one collective read per rank)
+  const std::int64_t stride = bs * doubles_per_scalar;
+  const std::vector<double> values = HDF5Interface::read_dataset<double>(
+      h5_id, "/checkpoint/values", {range[0] * stride, range[1] * stride});
+  HDF5Interface::close_file(h5_id);
+
+  // Copy into the owned part of the vector and scatter to ghosts
+  la::VecWrapper x(u.vector().vec());
+  assert((std::int64_t)values.size()
+         <= (std::int64_t)x.x.size() * doubles_per_scalar);
+  std::memcpy(x.x.data(), values.data(), values.size() * sizeof(double));
+  x.restore();
+  u.vector().update_ghosts();
+}
+//-----------------------------------------------------------------------------
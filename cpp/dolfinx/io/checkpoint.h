@@ -0,0 +1,63 @@
+// Copyright (C) 2020 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <string>
+
+namespace dolfinx
+{
+
+namespace function
+{
+class Function;
+}
+
+/// Lightweight native checkpointing of Function data
+namespace io::checkpoint
+{
+
+/// Write a checkpoint of a Function to an HDF5 file. The degree-of-
+/// freedom values are stored in global dof order (each rank writes its
+/// owned block), together with the index map metadata (block size,
+/// global size) needed to validate a restore. The layout is raw HDF5
+/// with no XML indirection, and is independent of the number of ranks
+/// used to write it.
+/// @param[in] filename Name of the HDF5 file to create
+/// @param[in] u The Function to checkpoint
+void write(const std::string& filename, const function::Function& u);
+
+/// Write a checkpoint split over multiple files. Groups of
+/// ranks_per_file consecutive ranks each write an independent HDF5
+/// file "<filename>.<k>" through a sub-communicator, avoiding the
+/// lock contention of a single shared file on parallel file systems;
+/// ranks_per_file <= 0 selects one file per compute node. Rank 0
+/// writes a manifest to "<filename>" recording the part count and the
+/// global dof range covered by each part, so read() can reassemble
+/// the data on any number of ranks.
+/// @param[in] filename Name of the manifest file to create; the part
+///   files are created next to it
+/// @param[in] u The Function to checkpoint
+/// @param[in] ranks_per_file Number of consecutive ranks sharing a
+///   part file (<= 0 for one file per node)
+void write(const std::string& filename, const function::Function& u,
+           int ranks_per_file);
+
+/// Restore a Function from a checkpoint file. The Function must be
+/// defined on a function space with the same global dof numbering as
+/// the writing run (e.g. built from the same mesh file through the
+/// same pipeline); the number of ranks may differ. Each rank performs
+/// a single collective read of its owned block, followed by one
+/// forward scatter to fill the ghost values. Both single-file and
+/// split (file-per-node) checkpoints are handled; for a split
+/// checkpoint each rank reads its block from the overlapping part
+/// files identified by the manifest.
+/// @param[in] filename Name of the HDF5 file to read
+/// @param[in,out] u The Function to restore into
+void read(const std::string& filename, function::Function& u);
+
+} // namespace io::checkpoint
+} // namespace dolfinx
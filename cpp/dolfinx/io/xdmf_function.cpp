@@ -5,9 +5,11 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "xdmf_function.h"
+#include "HDF5Interface.h"
 #include "pugixml.hpp"
 #include "xdmf_mesh.h"
 #include "xdmf_utils.h"
+#include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/fem/DofMap.h>
@@ -83,10 +85,29 @@ void xdmf_function::add_function(MPI_Comm comm, const function::Function& u,
   std::shared_ptr<const mesh::Mesh> mesh = u.function_space()->mesh();
   assert(mesh);
 
+  const bool cell_centred = has_cell_centred_data(u);
+
+  // Point data in the real build is written at its natural width with
+  // a column-selected HDF5 write (padding columns keep the zero fill
+  // value), so no padded copy of the data is made. This requires the
+  // padding to be a zero tail, which rules out 2D tensors (their
+  // padding has interior gaps). Cell data, ASCII storage and complex
+  // builds use the padded copy.
+#ifdef PETSC_USE_COMPLEX
+  const bool write_selected = false;
+#else
+  const bool write_selected
+      = (h5_id > 0) and !cell_centred
+        and !(u.value_rank() == 2 and u.value_size() == 4);
+#endif
+
   // Get function::Function data values and shape
   std::vector<PetscScalar> data_values;
-  const bool cell_centred = has_cell_centred_data(u);
-  if (cell_centred)
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      point_values;
+  if (write_selected)
+    point_values = u.compute_point_values();
+  else if (cell_centred)
     data_values = xdmf_utils::get_cell_data_values(u);
   else
     data_values = xdmf_utils::get_point_data_values(u);
@@ -157,11 +178,43 @@ void xdmf_function::add_function(MPI_Comm comm, const function::Function& u,
                               component_data_values, offset,
                               {num_values, width}, "", use_mpi_io);
 #else
-    // Add data item
-    const std::int64_t offset
-        = dolfinx::MPI::global_offset(comm, data_values.size() / width, true);
-    xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name, data_values,
-                              offset, {num_values, width}, "", use_mpi_io);
+    if (write_selected)
+    {
+      // Write the leading (owned) point rows straight from the
+      // compute_point_values() array; the rows are contiguous, so no
+      // intermediate buffer is needed
+      assert(mesh->geometry().index_map());
+      const std::int32_t num_local_points
+          = mesh->geometry().index_map()->size_local();
+      assert(point_values.rows() >= num_local_points);
+      const std::int64_t offset
+          = dolfinx::MPI::global_offset(comm, num_local_points, true);
+      HDF5Interface::write_dataset_selected(
+          h5_id, dataset_name, point_values.data(),
+          {offset, offset + num_local_points}, {num_values, width},
+          u.value_size(), use_mpi_io, false);
+
+      // Add DataItem node describing the padded dataset
+      pugi::xml_node data_item_node = attribute_node.append_child("DataItem");
+      assert(data_item_node);
+      const std::string dims
+          = std::to_string(num_values) + " " + std::to_string(width);
+      data_item_node.append_attribute("Dimensions") = dims.c_str();
+      data_item_node.append_attribute("Format") = "HDF";
+      const boost::filesystem::path p(HDF5Interface::get_filename(h5_id));
+      const std::string xdmf_path = p.filename().string() + ":" + dataset_name;
+      data_item_node.append_child(pugi::node_pcdata)
+          .set_value(xdmf_path.c_str());
+    }
+    else
+    {
+      // Add data item
+      const std::int64_t offset
+          = dolfinx::MPI::global_offset(comm, data_values.size() / width, true);
+      xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name,
+                                data_values, offset, {num_values, width}, "",
+                                use_mpi_io);
+    }
 #endif
   }
 }
@@ -9,6 +9,7 @@
 #include "pugixml.hpp"
 #include "xdmf_read.h"
 #include "xdmf_utils.h"
+#include <algorithm>
 #include <dolfinx/fem/ElementDofLayout.h>
 
 using namespace dolfinx;
@@ -192,7 +193,7 @@ void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
 //----------------------------------------------------------------------------
 void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node,
                          const hid_t h5_id, const mesh::Mesh& mesh,
-                         const std::string name)
+                         const std::string name, bool store_partition)
 {
   LOG(INFO) << "Adding mesh to node \"" << xml_node.path('/') << "\"";
 
@@ -219,6 +220,24 @@ void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node,
 
   // Add geometry node and attributes (including writing data)
   add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry());
+
+  if (store_partition)
+  {
+    // The owned cells of each rank are written contiguously in rank
+    // order above, so the per-rank cell counts describe the
+    // decomposition and the ownership completely. Information nodes
+    // are ignored by other XDMF readers.
+    pugi::xml_node info_node = grid_node.append_child("Information");
+    assert(info_node);
+    info_node.append_attribute("Name") = "Partition";
+
+    const int mpi_size = dolfinx::MPI::size(comm);
+    const std::vector<std::int64_t> count = {(std::int64_t)num_cells};
+    const std::vector<std::int64_t> shape = {mpi_size};
+    xdmf_utils::add_data_item(info_node, h5_id, path_prefix + "/partition",
+                              count, dolfinx::MPI::rank(comm), shape, "Int",
+                              mpi_size > 1);
+  }
 }
 //----------------------------------------------------------------------------
 Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -264,6 +283,108 @@ xdmf_mesh::read_geometry_data(MPI_Comm comm, const hid_t h5_id,
 }
 //----------------------------------------------------------------------------
 Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+xdmf_mesh::read_topology_data(MPI_Comm comm, const hid_t h5_id,
+                              const pugi::xml_node& node,
+                              std::int64_t window_size)
+{
+  // Get topology node
+  pugi::xml_node topology_node = node.child("Topology");
+  assert(topology_node);
+
+  // Get topology dataset node
+  pugi::xml_node topology_data_node = topology_node.child("DataItem");
+  assert(topology_data_node);
+
+  // Windowed reads need ranged access to the dataset, which is only
+  // available for HDF5 storage
+  pugi::xml_attribute format_attr = topology_data_node.attribute("Format");
+  assert(format_attr);
+  if (window_size <= 0 or std::string(format_attr.as_string()) != "HDF")
+    return read_topology_data(comm, h5_id, node);
+
+  // Local range of cells to read on this rank
+  const std::vector<std::int64_t> tdims0
+      = xdmf_utils::get_dataset_shape(topology_data_node);
+  const int mpi_rank = dolfinx::MPI::rank(comm);
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      mpi_rank, tdims0[0], dolfinx::MPI::size(comm));
+
+  return read_topology_data(comm, h5_id, node, window_size, range);
+}
+//----------------------------------------------------------------------------
+Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+xdmf_mesh::read_topology_data(MPI_Comm, const hid_t h5_id,
+                              const pugi::xml_node& node,
+                              std::int64_t window_size,
+                              const std::array<std::int64_t, 2>& range)
+{
+  // Get topology node
+  pugi::xml_node topology_node = node.child("Topology");
+  assert(topology_node);
+
+  // Get cell type
+  const std::pair<std::string, int> cell_type_str
+      = xdmf_utils::get_cell_type(topology_node);
+  mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
+
+  // Get topology dataset node
+  pugi::xml_node topology_data_node = topology_node.child("DataItem");
+  assert(topology_data_node);
+
+  // Ranged access to the dataset is only available for HDF5 storage
+  pugi::xml_attribute format_attr = topology_data_node.attribute("Format");
+  assert(format_attr);
+  if (std::string(format_attr.as_string()) != "HDF")
+    throw std::runtime_error("Ranged topology read requires HDF5 storage.");
+
+  const std::vector<std::int64_t> tdims
+      = xdmf_utils::get_dataset_shape(topology_data_node);
+  const int npoint_per_cell = tdims[1];
+  const std::int64_t num_local_cells = range[1] - range[0];
+  if (window_size <= 0)
+    window_size = num_local_cells;
+
+  // The HDF5 storage may be 2D (cells x points) or flattened to 1D
+  const auto paths = xdmf_utils::get_hdf5_paths(topology_data_node);
+  const std::vector<std::int64_t> shape_hdf5
+      = HDF5Interface::get_dataset_shape(h5_id, paths[1]);
+  const bool flat = (shape_hdf5.size() == 1);
+  if (flat and shape_hdf5[0] != tdims[0] * npoint_per_cell)
+  {
+    throw std::runtime_error("Data size in XDMF/XML and size of HDF5 "
+                             "dataset are inconsistent");
+  }
+
+  const std::vector<std::uint8_t> perm
+      = io::cells::perm_vtk(cell_type, npoint_per_cell);
+
+  // Read the local cell range in bounded windows, permuting each
+  // window from VTK to DOLFINX ordering as it arrives, so only one
+  // window of the raw file data is held at any time
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cells(num_local_cells, npoint_per_cell);
+  for (std::int64_t w0 = range[0]; w0 < range[1]; w0 += window_size)
+  {
+    const std::int64_t w1 = std::min(w0 + window_size, range[1]);
+    std::array<std::int64_t, 2> window_range = {w0, w1};
+    if (flat)
+      window_range = {w0 * npoint_per_cell, w1 * npoint_per_cell};
+    const std::vector<std::int64_t> data
+        = HDF5Interface::read_dataset<std::int64_t>(h5_id, paths[1],
+                                                    window_range);
+    assert((std::int64_t)data.size() == (w1 - w0) * npoint_per_cell);
+    for (std::int64_t c = 0; c < w1 - w0; ++c)
+    {
+      auto cell = cells.row(c + w0 - range[0]);
+      for (int i = 0; i < npoint_per_cell; ++i)
+        cell(i) = data[c * npoint_per_cell + perm[i]];
+    }
+  }
+
+  return cells;
+}
+//----------------------------------------------------------------------------
+Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 xdmf_mesh::read_topology_data(MPI_Comm comm, const hid_t h5_id,
                               const pugi::xml_node& node)
 {
@@ -298,3 +419,55 @@ xdmf_mesh::read_topology_data(MPI_Comm comm, const hid_t h5_id,
       cells_vtk, io::cells::perm_vtk(cell_type, cells_vtk.cols()));
 }
 //----------------------------------------------------------------------------
+std::array<std::int64_t, 2>
+xdmf_mesh::read_partition_range(MPI_Comm comm, const hid_t h5_id,
+                                const pugi::xml_node& node)
+{
+  // Locate the recorded partition (see add_mesh)
+  pugi::xml_node info_node
+      = node.find_child_by_attribute("Information", "Name", "Partition");
+  if (!info_node)
+    return {-1, -1};
+  pugi::xml_node data_node = info_node.child("DataItem");
+  if (!data_node)
+    return {-1, -1};
+
+  // The ranged topology read needs random access, which only HDF5
+  // storage provides
+  pugi::xml_node topology_node = node.child("Topology");
+  assert(topology_node);
+  pugi::xml_node topology_data_node = topology_node.child("DataItem");
+  assert(topology_data_node);
+  pugi::xml_attribute format_attr = topology_data_node.attribute("Format");
+  if (!format_attr or std::string(format_attr.as_string()) != "HDF")
+    return {-1, -1};
+
+  // The stored decomposition is usable only on the number of ranks it
+  // was written with
+  const std::vector<std::int64_t> shape
+      = xdmf_utils::get_dataset_shape(data_node);
+  if (shape.size() != 1 or shape[0] != dolfinx::MPI::size(comm))
+    return {-1, -1};
+
+  // One count per rank: the block-distributed read hands each rank
+  // exactly its own cell count, and an inclusive scan gives the end of
+  // its contiguous range
+  const std::vector<std::int64_t> count
+      = xdmf_read::get_dataset<std::int64_t>(comm, data_node, h5_id);
+  assert(count.size() == 1);
+  std::int64_t stop = 0;
+  MPI_Scan(count.data(), &stop, 1, MPI_INT64_T, MPI_SUM, comm);
+
+  // Guard against a partition that does not cover the stored cells,
+  // e.g. a file edited by hand. The check is collective, so all ranks
+  // fall back together.
+  std::int64_t num_cells = count[0];
+  MPI_Allreduce(MPI_IN_PLACE, &num_cells, 1, MPI_INT64_T, MPI_SUM, comm);
+  const std::vector<std::int64_t> tdims
+      = xdmf_utils::get_dataset_shape(topology_data_node);
+  if (num_cells != tdims[0])
+    return {-1, -1};
+
+  return {stop - count[0], stop};
+}
+//----------------------------------------------------------------------------
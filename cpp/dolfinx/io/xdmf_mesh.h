@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <array>
 #include <dolfinx/mesh/cell_types.h>
 #include <hdf5.h>
 #include <mpi.h>
@@ -36,9 +37,16 @@ namespace io::xdmf_mesh
 /// Add Mesh to xml node
 ///
 /// Creates new Grid with Topology and Geometry xml nodes for mesh. In
-/// HDF file data is stored under path prefix.
+/// HDF file data is stored under path prefix. With @p store_partition,
+/// the decomposition is recorded alongside the mesh data as the
+/// per-rank owned cell counts (the owned cells of each rank are
+/// written contiguously in rank order, so the counts describe the
+/// partition and the ownership completely); a later read on the same
+/// number of ranks can then skip the graph partitioner (see
+/// read_partition_range).
 void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, const hid_t h5_id,
-              const mesh::Mesh& mesh, const std::string path_prefix);
+              const mesh::Mesh& mesh, const std::string path_prefix,
+              bool store_partition = false);
 
 /// Add Topology xml node
 /// @param[in] comm
@@ -74,5 +82,49 @@ Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 read_topology_data(MPI_Comm comm, const hid_t h5_id,
                    const pugi::xml_node& node);
 
+/// Read Topology data in bounded windows. The local cell range is read
+/// from the HDF5 dataset in windows of at most @p window_size cells,
+/// with each window permuted from VTK to DOLFINX ordering as it
+/// arrives, so the raw file data is never held in full. Falls back to
+/// the plain read for ASCII storage or window_size <= 0.
+/// @param[in] comm MPI communicator
+/// @param[in] h5_id HDF5 file handle
+/// @param[in] node XML Grid node
+/// @param[in] window_size Maximum number of cells read per window
+/// @returns ((cell type, degree), topology)
+Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+read_topology_data(MPI_Comm comm, const hid_t h5_id,
+                   const pugi::xml_node& node, std::int64_t window_size);
+
+/// Read the cell range this rank owned when the mesh was written, from
+/// the partition recorded by add_mesh with partition storage. The
+/// range is usable only when the stored decomposition matches the
+/// current communicator size and the topology is stored in HDF5 (the
+/// ranged read needs random access); otherwise {-1, -1} is returned
+/// and the caller should fall back to the graph partitioner.
+/// Collective.
+/// @param[in] comm MPI communicator
+/// @param[in] h5_id HDF5 file handle
+/// @param[in] node XML Grid node
+/// @returns The half-open global cell range owned by this rank at
+///   write time, or {-1, -1} if no usable partition is recorded
+std::array<std::int64_t, 2> read_partition_range(MPI_Comm comm,
+                                                 const hid_t h5_id,
+                                                 const pugi::xml_node& node);
+
+/// Read Topology data for an explicit global cell range, in bounded
+/// windows (see the windowed overload). Requires HDF5 storage.
+/// @param[in] comm MPI communicator
+/// @param[in] h5_id HDF5 file handle
+/// @param[in] node XML Grid node
+/// @param[in] window_size Maximum number of cells read per window
+/// @param[in] range Half-open global range of cells to read on this
+///   rank
+/// @returns ((cell type, degree), topology)
+Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+read_topology_data(MPI_Comm comm, const hid_t h5_id,
+                   const pugi::xml_node& node, std::int64_t window_size,
+                   const std::array<std::int64_t, 2>& range);
+
 } // namespace io::xdmf_mesh
 } // namespace dolfinx
@@ -49,12 +49,55 @@ void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
   const std::int64_t local_num_values = active_entities.size();
   MPI_Allreduce(&local_num_values, &global_num_values, 1, MPI_INT64_T, MPI_SUM,
                 comm);
-  const std::int64_t offset
-      = dolfinx::MPI::global_offset(comm, active_entities.size(), true);
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
-  xdmf_utils::add_data_item(attribute_node, h5_id, path_prefix + "/Values",
-                            meshtags.values(), offset, {global_num_values, 1},
-                            "", use_mpi_io);
+
+  // Run-length encode the values (as (run length, value) pairs) when
+  // they compress well - boundary tag sets are typically dominated by
+  // a single value. The reader expands its own block of the decoded
+  // sequence, see xdmf_read::decode_rle. Only applied with HDF5
+  // storage; XML (ASCII) storage keeps the plain values.
+  std::vector<T> runs;
+  if (h5_id > 0)
+  {
+    const std::vector<T>& values = meshtags.values();
+    for (std::size_t i = 0; i < values.size();)
+    {
+      std::size_t j = i + 1;
+      while (j < values.size() and values[j] == values[i])
+        ++j;
+      runs.push_back(j - i);
+      runs.push_back(values[i]);
+      i = j;
+    }
+  }
+
+  std::int64_t global_num_runs = 0;
+  const std::int64_t local_num_runs = runs.size();
+  MPI_Allreduce(&local_num_runs, &global_num_runs, 1, MPI_INT64_T, MPI_SUM,
+                comm);
+
+  if (h5_id > 0 and global_num_runs > 0
+      and 4 * global_num_runs <= global_num_values)
+  {
+    pugi::xml_node encoding_node = attribute_node.append_child("Information");
+    assert(encoding_node);
+    encoding_node.append_attribute("Name") = "Encoding";
+    encoding_node.append_attribute("Value") = "RLE";
+
+    const std::int64_t offset
+        = dolfinx::MPI::global_offset(comm, runs.size(), true);
+    xdmf_utils::add_data_item(attribute_node, h5_id, path_prefix + "/Values",
+                              runs, offset, {global_num_runs, 1}, "",
+                              use_mpi_io);
+  }
+  else
+  {
+    const std::int64_t offset
+        = dolfinx::MPI::global_offset(comm, active_entities.size(), true);
+    xdmf_utils::add_data_item(attribute_node, h5_id, path_prefix + "/Values",
+                              meshtags.values(), offset, {global_num_values, 1},
+                              "", use_mpi_io);
+  }
 }
 
 } // namespace xdmf_meshtags
@@ -9,6 +9,7 @@
 #include "pugixml.hpp"
 #include "xdmf_utils.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <dolfinx/common/IndexMap.h>
@@ -152,4 +153,38 @@ std::vector<T> get_dataset(MPI_Comm comm, const pugi::xml_node& dataset_node,
 }
 //----------------------------------------------------------------------------
 
+/// Expand run-length encoded data, returning this rank's block of the
+/// decoded sequence. The input is the complete encoded dataset as
+/// (run length, value) pairs, and must be the same on all ranks. The
+/// decoded sequence is split between ranks with the same block
+/// distribution that get_dataset uses for raw datasets, so the decoded
+/// values stay aligned with data read from companion datasets.
+template <typename T>
+std::vector<T> decode_rle(MPI_Comm comm, const std::vector<T>& runs)
+{
+  assert(runs.size() % 2 == 0);
+  std::int64_t num_values = 0;
+  for (std::size_t i = 0; i < runs.size(); i += 2)
+    num_values += static_cast<std::int64_t>(runs[i]);
+
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), num_values, dolfinx::MPI::size(comm));
+
+  std::vector<T> values;
+  values.reserve(range[1] - range[0]);
+  std::int64_t pos = 0;
+  for (std::size_t i = 0; i < runs.size() and pos < range[1]; i += 2)
+  {
+    const std::int64_t len = static_cast<std::int64_t>(runs[i]);
+    const std::int64_t begin = std::max(pos, range[0]);
+    const std::int64_t end = std::min(pos + len, range[1]);
+    for (std::int64_t k = begin; k < end; ++k)
+      values.push_back(runs[i + 1]);
+    pos += len;
+  }
+  assert((std::int64_t)values.size() == range[1] - range[0]);
+  return values;
+}
+//----------------------------------------------------------------------------
+
 } // namespace dolfinx::io::xdmf_read
@@ -14,11 +14,13 @@
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/RedistributionPlan.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
+#include <algorithm>
 #include <map>
 
 using namespace dolfinx;
@@ -426,54 +428,55 @@ xdmf_utils::extract_local_entities(
   //    data (i) the communication could be combined, or (ii) the
   //    communication in Step 1 could be make non-blocking.
 
-  std::vector<std::vector<std::int64_t>> entities_send(comm_size);
-  std::vector<std::vector<std::int32_t>> values_send(comm_size);
-  std::vector<std::int64_t> entity(num_vertices_per_entity);
-  for (std::int32_t e = 0; e < entities_vertices.rows(); ++e)
+  // Sort each entity key and determine its postmaster from the lowest
+  // entity node. The entity keys and the tag values share the same
+  // destinations, so one exchange plan serves both payloads.
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      entity_keys = entities_vertices;
+  std::vector<int> entity_dest(entity_keys.rows());
+  for (std::int32_t e = 0; e < entity_keys.rows(); ++e)
   {
-    // Copy vertices for entity and sort
-    std::copy(entities_vertices.row(e).data(),
-              entities_vertices.row(e).data() + entities_vertices.cols(),
-              entity.begin());
-    std::sort(entity.begin(), entity.end());
-
-    // Determine postmaster based on lowest entity node
-    const std::int32_t p
-        = dolfinx::MPI::index_owner(comm_size, entity.front(), num_nodes_g);
-    entities_send[p].insert(entities_send[p].end(), entity.begin(),
-                            entity.end());
-    values_send[p].push_back(values[e]);
+    std::sort(entity_keys.row(e).data(),
+              entity_keys.row(e).data() + entity_keys.cols());
+    entity_dest[e]
+        = dolfinx::MPI::index_owner(comm_size, entity_keys(e, 0), num_nodes_g);
   }
 
-  // TODO: Pack into one MPI call
-  const graph::AdjacencyList<std::int64_t> entities_recv = MPI::all_to_all(
-      comm, graph::AdjacencyList<std::int64_t>(entities_send));
+  graph::RedistributionPlan entity_plan(comm, entity_dest);
+  const graph::AdjacencyList<std::int64_t> entities_recv
+      = entity_plan.execute<std::int64_t>(
+          num_vertices_per_entity, [&](std::size_t e, std::int64_t* buf) {
+            std::copy_n(entity_keys.row(e).data(), num_vertices_per_entity,
+                        buf);
+          });
   const graph::AdjacencyList<std::int32_t> values_recv
-      = MPI::all_to_all(comm, graph::AdjacencyList<std::int32_t>(values_send));
+      = entity_plan.execute<std::int32_t>(
+          1, [&](std::size_t e, std::int32_t* buf) { *buf = values[e]; });
 
   // -------------------
   // 3. As 'postmaster', send back the entity key (vertex list) and tag
   //    value to ranks that possibly need the data. Do this based on the
   //    first node index in the entity key.
 
-  // NOTE: Could: (i) use a std::unordered_multimap, or (ii) only send
-  // owned nodes to the postmaster and use map, unordered_map or
-  // std::vector<pair>>, followed by a neighbourhood all_to_all at the
-  // end.
+  // NOTE: Could only send owned nodes to the postmaster, followed by
+  // a neighbourhood all_to_all at the end.
   //
-  // Build map from global node index to ranks that have the node
-  std::multimap<std::int64_t, int> node_to_rank;
+  // Build a flat (global node index, rank) list sorted by node index;
+  // ranks holding a node are then found with a binary search instead
+  // of a tree lookup per entity
+  std::vector<std::pair<std::int64_t, int>> node_to_rank;
+  node_to_rank.reserve(nodes_g_recv.array().rows());
   for (int p = 0; p < nodes_g_recv.num_nodes(); ++p)
   {
     auto nodes = nodes_g_recv.links(p);
     for (int i = 0; i < nodes.rows(); ++i)
-      node_to_rank.insert({nodes(i), p});
+      node_to_rank.push_back({nodes(i), p});
   }
+  std::sort(node_to_rank.begin(), node_to_rank.end());
 
-  // Figure out which processes are owners of received nodes
-  std::vector<std::vector<std::int64_t>> send_nodes_owned(comm_size);
-  std::vector<std::vector<std::int32_t>> send_vals_owned(comm_size);
-
+  // Figure out which processes are owners of received nodes. Each
+  // (entity, destination) pair becomes one item; the entity keys and
+  // the tag values again share a single exchange plan.
   const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
                                       Eigen::Dynamic, Eigen::RowMajor>>
       _entities_recv(entities_recv.array().data(),
@@ -481,25 +484,35 @@ xdmf_utils::extract_local_entities(
                      num_vertices_per_entity);
   auto _values_recv = values_recv.array();
   assert(_values_recv.rows() == _entities_recv.rows());
+  std::vector<int> owned_dest;
+  std::vector<std::int32_t> owned_entity;
   for (int e = 0; e < _entities_recv.rows(); ++e)
   {
     // Find ranks that have node0
-    auto [it0, it1] = node_to_rank.equal_range(_entities_recv(e, 0));
+    auto [it0, it1] = std::equal_range(
+        node_to_rank.begin(), node_to_rank.end(),
+        std::pair<std::int64_t, int>(_entities_recv(e, 0), 0),
+        [](const std::pair<std::int64_t, int>& a,
+           const std::pair<std::int64_t, int>& b) { return a.first < b.first; });
     for (auto it = it0; it != it1; ++it)
     {
-      const int p1 = it->second;
-      send_nodes_owned[p1].insert(
-          send_nodes_owned[p1].end(), _entities_recv.row(e).data(),
-          _entities_recv.row(e).data() + _entities_recv.cols());
-      send_vals_owned[p1].push_back(_values_recv(e));
+      owned_dest.push_back(it->second);
+      owned_entity.push_back(e);
     }
   }
 
-  // TODO: Pack into one MPI call
-  const graph::AdjacencyList<std::int64_t> recv_ents = MPI::all_to_all(
-      comm, graph::AdjacencyList<std::int64_t>(send_nodes_owned));
-  const graph::AdjacencyList<std::int32_t> recv_vals = MPI::all_to_all(
-      comm, graph::AdjacencyList<std::int32_t>(send_vals_owned));
+  graph::RedistributionPlan owned_plan(comm, owned_dest);
+  const graph::AdjacencyList<std::int64_t> recv_ents
+      = owned_plan.execute<std::int64_t>(
+          num_vertices_per_entity, [&](std::size_t m, std::int64_t* buf) {
+            std::copy_n(_entities_recv.row(owned_entity[m]).data(),
+                        num_vertices_per_entity, buf);
+          });
+  const graph::AdjacencyList<std::int32_t> recv_vals
+      = owned_plan.execute<std::int32_t>(
+          1, [&](std::size_t m, std::int32_t* buf) {
+            *buf = _values_recv(owned_entity[m]);
+          });
 
   // -------------------
   // 4. From the received (key, value) data, determine which keys
@@ -515,17 +528,24 @@ xdmf_utils::extract_local_entities(
   //       the std::map for *all* entities and just for candidate
   //       entities.
 
-  // Build map from input global indices to local vertex numbers
+  // Build a sorted (input global index, local vertex) list; received
+  // entity nodes are then mapped to local vertices by binary search
   const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
-  std::map<std::int64_t, std::int32_t> igi_to_vertex;
+  std::vector<std::pair<std::int64_t, std::int32_t>> igi_to_vertex;
 
   for (int c = 0; c < c_to_v->num_nodes(); ++c)
   {
     auto vertices = c_to_v->links(c);
     auto x_dofs = x_dofmap.links(c);
     for (int v = 0; v < vertices.rows(); ++v)
-      igi_to_vertex[nodes_g[x_dofs[cell_vertex_dofs[v]]]] = vertices[v];
+      igi_to_vertex.push_back({nodes_g[x_dofs[cell_vertex_dofs[v]]], vertices[v]});
   }
+  std::sort(igi_to_vertex.begin(), igi_to_vertex.end());
+  igi_to_vertex.erase(std::unique(igi_to_vertex.begin(), igi_to_vertex.end(),
+                                  [](const auto& a, const auto& b) {
+                                    return a.first == b.first;
+                                  }),
+                      igi_to_vertex.end());
 
   // Apply map and obtain entities defined with local vertex numbers
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -541,8 +561,14 @@ xdmf_utils::extract_local_entities(
   {
     for (Eigen::Index i = 0; i < entities_local.cols(); ++i)
     {
-      entities_local(e, i)
-          = igi_to_vertex[recv_ents.array()[e * num_vertices_per_entity + i]];
+      const std::int64_t igi
+          = recv_ents.array()[e * num_vertices_per_entity + i];
+      const auto it = std::lower_bound(
+          igi_to_vertex.begin(), igi_to_vertex.end(),
+          std::pair<std::int64_t, std::int32_t>(igi, 0),
+          [](const auto& a, const auto& b) { return a.first < b.first; });
+      assert(it != igi_to_vertex.end() and it->first == igi);
+      entities_local(e, i) = it->second;
     }
   }
 
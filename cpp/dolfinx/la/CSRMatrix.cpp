@@ -0,0 +1,368 @@
+// Copyright (C) 2020 Garth N. Wells
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CSRMatrix.h"
+#include "SparsityPattern.h"
+#include "utils.h"
+#include <algorithm>
+#include <dolfinx/common/CommTracer.h>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
+
+using namespace dolfinx;
+using namespace dolfinx::la;
+
+//-----------------------------------------------------------------------------
+CSRMatrix::CSRMatrix(const SparsityPattern& pattern)
+    : _mpi_comm(pattern.mpi_comm()),
+      _index_maps({pattern.index_map(0), pattern.index_map(1)})
+{
+  const graph::AdjacencyList<std::int32_t>& diag = pattern.diagonal_pattern();
+  const graph::AdjacencyList<std::int64_t>& off
+      = pattern.off_diagonal_pattern();
+
+  _row_ptr_diag.assign(diag.offsets().data(),
+                       diag.offsets().data() + diag.offsets().size());
+  _cols_diag.assign(diag.array().data(),
+                    diag.array().data() + diag.array().size());
+  _row_ptr_off.assign(off.offsets().data(),
+                      off.offsets().data() + off.offsets().size());
+  _cols_off.assign(off.array().data(),
+                   off.array().data() + off.array().size());
+
+  _values_diag.resize(_cols_diag.size(), 0.0);
+  _values_off.resize(_cols_off.size(), 0.0);
+}
+//-----------------------------------------------------------------------------
+std::int32_t CSRMatrix::find_slot(std::int32_t row, std::int32_t col) const
+{
+  assert(_index_maps[1]);
+  const int bs1 = _index_maps[1]->block_size();
+  const std::int32_t local_size1 = _index_maps[1]->size_local();
+
+  if (col < bs1 * local_size1)
+  {
+    // Diagonal block (local column indices, sorted within the row)
+    auto first = _cols_diag.begin() + _row_ptr_diag[row];
+    auto last = _cols_diag.begin() + _row_ptr_diag[row + 1];
+    auto it = std::lower_bound(first, last, col);
+    if (it == last or *it != col)
+      return -1;
+    return std::distance(_cols_diag.begin(), it);
+  }
+  else
+  {
+    // Off-diagonal block (global column indices, sorted within the
+    // row)
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
+        = _index_maps[1]->ghosts();
+    const std::div_t div = std::div(col, bs1);
+    const std::int64_t col_global
+        = bs1 * ghosts1[div.quot - local_size1] + div.rem;
+    auto first = _cols_off.begin() + _row_ptr_off[row];
+    auto last = _cols_off.begin() + _row_ptr_off[row + 1];
+    auto it = std::lower_bound(first, last, col_global);
+    if (it == last or *it != col_global)
+      return -1;
+    return _cols_diag.size() + std::distance(_cols_off.begin(), it);
+  }
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::add_local(const PetscScalar* block, int m,
+                          const std::int32_t* rows, int n,
+                          const std::int32_t* cols)
+{
+  assert(_index_maps[0]);
+  assert(_index_maps[1]);
+  const int bs0 = _index_maps[0]->block_size();
+  const int bs1 = _index_maps[1]->block_size();
+  const std::int32_t num_owned_rows = bs0 * _index_maps[0]->size_local();
+  const std::int32_t local_size0 = _index_maps[0]->size_local();
+  const std::int32_t local_size1 = _index_maps[1]->size_local();
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts0
+      = _index_maps[0]->ghosts();
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
+      = _index_maps[1]->ghosts();
+  const std::array<std::int64_t, 2> local_range1
+      = _index_maps[1]->local_range();
+
+  for (int i = 0; i < m; ++i)
+  {
+    const std::int32_t row = rows[i];
+    if (row < num_owned_rows)
+    {
+      for (int j = 0; j < n; ++j)
+      {
+        const std::int32_t slot = find_slot(row, cols[j]);
+        if (slot < 0)
+        {
+          throw std::runtime_error(
+              "Cannot add value: entry is not in the sparsity pattern.");
+        }
+        if (slot < (std::int32_t)_cols_diag.size())
+          _values_diag[slot] += block[i * n + j];
+        else
+          _values_off[slot - _cols_diag.size()] += block[i * n + j];
+      }
+    }
+    else
+    {
+      // Unowned row - stash with global indices and send to the owner
+      // in apply()
+      const std::div_t div0 = std::div(row, bs0);
+      const std::int64_t row_global
+          = bs0 * ghosts0[div0.quot - local_size0] + div0.rem;
+      for (int j = 0; j < n; ++j)
+      {
+        std::int64_t col_global;
+        if (cols[j] < bs1 * local_size1)
+          col_global = bs1 * local_range1[0] + cols[j];
+        else
+        {
+          const std::div_t div1 = std::div(cols[j], bs1);
+          col_global = bs1 * ghosts1[div1.quot - local_size1] + div1.rem;
+        }
+        _stash_indices.push_back(row_global);
+        _stash_indices.push_back(col_global);
+        _stash_values.push_back(block[i * n + j]);
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::compute_slots(int m, const std::int32_t* rows, int n,
+                              const std::int32_t* cols,
+                              std::int32_t* slots) const
+{
+  assert(_index_maps[0]);
+  const std::int32_t num_owned_rows
+      = _index_maps[0]->block_size() * _index_maps[0]->size_local();
+  for (int i = 0; i < m; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      if (rows[i] < num_owned_rows)
+        slots[i * n + j] = find_slot(rows[i], cols[j]);
+      else
+        slots[i * n + j] = -1;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::add_scattered(const PetscScalar* block,
+                              const std::int32_t* slots, int n)
+{
+  const std::int32_t num_diag = _cols_diag.size();
+  for (int i = 0; i < n; ++i)
+  {
+    assert(slots[i] >= 0);
+    if (slots[i] < num_diag)
+      _values_diag[slots[i]] += block[i];
+    else
+      _values_off[slots[i] - num_diag] += block[i];
+  }
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::apply()
+{
+  apply_begin();
+  apply_end();
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::apply_begin()
+{
+  assert(_index_maps[0]);
+  if (_pending_comm != MPI_COMM_NULL)
+    throw std::runtime_error("Stash exchange already in progress.");
+
+  // Send stashed (row, column) pairs and values to the neighbourhood
+  // (the same exchange pattern used by SparsityPattern::assemble)
+  const std::vector<std::int32_t>& neighbours = _index_maps[0]->neighbours();
+  MPI_Dist_graph_create_adjacent(
+      _mpi_comm.comm(), neighbours.size(), neighbours.data(), MPI_UNWEIGHTED,
+      neighbours.size(), neighbours.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
+      false, &_pending_comm);
+
+  int num_neighbours(-1), outdegree(-2), weighted(-1);
+  MPI_Dist_graph_neighbors_count(_pending_comm, &num_neighbours, &outdegree,
+                                 &weighted);
+  assert(num_neighbours == outdegree);
+
+  // The counts are needed to size the receive buffers, so this small
+  // exchange stays blocking; the payload exchanges below are
+  // nonblocking and complete in apply_end(), allowing independent work
+  // to overlap them.
+  const int num_my_indices = _stash_indices.size();
+  std::vector<int> num_indices_recv(num_neighbours);
+  MPI_Neighbor_allgather(&num_my_indices, 1, MPI_INT, num_indices_recv.data(),
+                         1, MPI_INT, _pending_comm);
+
+  std::vector<int> disp_indices(num_neighbours + 1, 0);
+  std::partial_sum(num_indices_recv.begin(), num_indices_recv.end(),
+                   disp_indices.begin() + 1);
+
+  _pending_requests.resize(2);
+  _indices_recv.resize(disp_indices.back());
+  MPI_Ineighbor_allgatherv(_stash_indices.data(), _stash_indices.size(),
+                           MPI_INT64_T, _indices_recv.data(),
+                           num_indices_recv.data(), disp_indices.data(),
+                           MPI_INT64_T, _pending_comm, &_pending_requests[0]);
+
+  // Matching exchange for the values (one value per index pair)
+  std::vector<int> num_values_recv(num_neighbours);
+  std::vector<int> disp_values(num_neighbours + 1, 0);
+  for (int i = 0; i < num_neighbours; ++i)
+  {
+    num_values_recv[i] = num_indices_recv[i] / 2;
+    disp_values[i + 1] = disp_values[i] + num_values_recv[i];
+  }
+  _values_recv.resize(disp_values.back());
+  MPI_Ineighbor_allgatherv(_stash_values.data(), _stash_values.size(),
+                           dolfinx::MPI::mpi_type<PetscScalar>(),
+                           _values_recv.data(), num_values_recv.data(),
+                           disp_values.data(),
+                           dolfinx::MPI::mpi_type<PetscScalar>(),
+                           _pending_comm, &_pending_requests[1]);
+
+  if (common::CommTracer::enabled())
+  {
+    // The payload exchange is nonblocking, so the message sizes are
+    // recorded here and the time waiting for completion in apply_end()
+    common::CommTracer::Phase phase("assembly stash", false);
+    const std::int64_t bytes_send
+        = sizeof(std::int64_t) * _stash_indices.size()
+          + sizeof(PetscScalar) * _stash_values.size();
+    for (int i = 0; i < num_neighbours; ++i)
+    {
+      common::CommTracer::record(
+          neighbours[i],
+          bytes_send + sizeof(std::int64_t) * num_indices_recv[i]
+              + sizeof(PetscScalar) * num_values_recv[i],
+          0.0);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::apply_end()
+{
+  assert(_index_maps[0]);
+  assert(_index_maps[1]);
+  if (_pending_comm == MPI_COMM_NULL)
+    throw std::runtime_error("No stash exchange in progress.");
+
+  const int bs0 = _index_maps[0]->block_size();
+  const int bs1 = _index_maps[1]->block_size();
+  const std::array<std::int64_t, 2> local_range0
+      = _index_maps[0]->local_range();
+  const std::array<std::int64_t, 2> local_range1
+      = _index_maps[1]->local_range();
+
+  const double t0 = MPI_Wtime();
+  MPI_Waitall(_pending_requests.size(), _pending_requests.data(),
+              MPI_STATUSES_IGNORE);
+  if (common::CommTracer::enabled())
+  {
+    const std::vector<std::int32_t>& neighbours = _index_maps[0]->neighbours();
+    if (!neighbours.empty())
+    {
+      // Completion of the exchange started in apply_begin(); the sizes
+      // were recorded there
+      common::CommTracer::Phase phase("assembly stash", false);
+      common::CommTracer::record(neighbours.front(), 0, MPI_Wtime() - t0);
+    }
+  }
+  MPI_Comm_free(&_pending_comm);
+  _pending_comm = MPI_COMM_NULL;
+  _pending_requests.clear();
+
+  // Add the received entries that this rank owns
+  const std::vector<std::int64_t>& indices_recv = _indices_recv;
+  const std::vector<PetscScalar>& values_recv = _values_recv;
+  for (std::size_t i = 0; i < values_recv.size(); ++i)
+  {
+    const std::int64_t row = indices_recv[2 * i];
+    if (row < bs0 * local_range0[0] or row >= bs0 * local_range0[1])
+      continue;
+    const std::int32_t row_local = row - bs0 * local_range0[0];
+    const std::int64_t col = indices_recv[2 * i + 1];
+
+    std::int32_t slot = -1;
+    if (col >= bs1 * local_range1[0] and col < bs1 * local_range1[1])
+    {
+      // Diagonal block: convert to local column index
+      slot = find_slot(row_local, col - bs1 * local_range1[0]);
+      if (slot >= 0)
+        _values_diag[slot] += values_recv[i];
+    }
+    else
+    {
+      // Off-diagonal block: search the global column indices directly
+      auto first = _cols_off.begin() + _row_ptr_off[row_local];
+      auto last = _cols_off.begin() + _row_ptr_off[row_local + 1];
+      auto it = std::lower_bound(first, last, col);
+      if (it != last and *it == col)
+      {
+        slot = 0;
+        _values_off[std::distance(_cols_off.begin(), it)] += values_recv[i];
+      }
+    }
+
+    if (slot < 0)
+    {
+      throw std::runtime_error(
+          "Received matrix entry is not in the sparsity pattern.");
+    }
+  }
+
+  _stash_indices.clear();
+  _stash_values.clear();
+  _indices_recv.clear();
+  _values_recv.clear();
+}
+//-----------------------------------------------------------------------------
+void CSRMatrix::zero()
+{
+  std::fill(_values_diag.begin(), _values_diag.end(), 0.0);
+  std::fill(_values_off.begin(), _values_off.end(), 0.0);
+}
+//-----------------------------------------------------------------------------
+Mat CSRMatrix::create_petsc_matrix()
+{
+  if (!_stash_indices.empty())
+  {
+    throw std::runtime_error(
+        "Cannot create PETSc matrix: unowned-row entries are pending. "
+        "Call apply() first.");
+  }
+
+  assert(_index_maps[0]);
+  assert(_index_maps[1]);
+  const int bs0 = _index_maps[0]->block_size();
+  const int bs1 = _index_maps[1]->block_size();
+  const PetscInt m = bs0 * _index_maps[0]->size_local();
+  const PetscInt n = bs1 * _index_maps[1]->size_local();
+  const PetscInt M = bs0 * _index_maps[0]->size_global();
+  const PetscInt N = bs1 * _index_maps[1]->size_global();
+
+  Mat A = nullptr;
+  PetscErrorCode ierr = MatCreateMPIAIJWithSplitArrays(
+      _mpi_comm.comm(), m, n, M, N, _row_ptr_diag.data(), _cols_diag.data(),
+      _values_diag.data(), _row_ptr_off.data(), _cols_off.data(),
+      _values_off.data(), &A);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatCreateMPIAIJWithSplitArrays");
+
+  return A;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const common::IndexMap> CSRMatrix::index_map(int dim) const
+{
+  return _index_maps.at(dim);
+}
+//-----------------------------------------------------------------------------
+MPI_Comm CSRMatrix::mpi_comm() const { return _mpi_comm.comm(); }
+//-----------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+// Copyright (C) 2020 Garth N. Wells
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <memory>
+#include <petscmat.h>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace common
+{
+class IndexMap;
+}
+
+namespace la
+{
+class SparsityPattern;
+
+/// Distributed compressed sparse row matrix built directly from an
+/// assembled SparsityPattern. Values are inserted into the CSR arrays
+/// without going through PETSc's MatSetValuesLocal machinery; entries
+/// added into unowned (ghost) rows are stashed and communicated to the
+/// owning rank by apply(). The owned blocks use the split storage that
+/// PETSc MATMPIAIJ expects (diagonal block with local column indices,
+/// off-diagonal block with global column indices), so the matrix can
+/// be handed to a PETSc solver via create_petsc_matrix() without
+/// copying the values.
+
+class CSRMatrix
+{
+public:
+  /// Create a zero-initialized matrix with the structure of an
+  /// assembled sparsity pattern
+  /// @param[in] pattern The assembled sparsity pattern
+  explicit CSRMatrix(const SparsityPattern& pattern);
+
+  // Copy constructor (deleted)
+  CSRMatrix(const CSRMatrix& A) = delete;
+
+  /// Move constructor
+  CSRMatrix(CSRMatrix&& A) = default;
+
+  /// Destructor
+  ~CSRMatrix() = default;
+
+  // Assignment operator (deleted)
+  CSRMatrix& operator=(const CSRMatrix& A) = delete;
+
+  /// Move assignment operator
+  CSRMatrix& operator=(CSRMatrix&& A) = default;
+
+  /// Add a dense block of values using local (process-wise) indices.
+  /// Rows may refer to unowned (ghost) rows, in which case the values
+  /// are stashed until apply() is called. All entries must exist in
+  /// the sparsity pattern.
+  /// @param[in] block Dense block of values, row-major, shape (m, n)
+  /// @param[in] m Number of rows in the block
+  /// @param[in] rows Local row indices
+  /// @param[in] n Number of columns in the block
+  /// @param[in] cols Local column indices
+  void add_local(const PetscScalar* block, int m, const std::int32_t* rows,
+                 int n, const std::int32_t* cols);
+
+  /// Compute the value-array slots for a dense block with the given
+  /// local indices, for use with add_scattered(). Computing the slots
+  /// once per cell and reusing them across assemblies removes the
+  /// index search from the assembly hot loop. A slot of -1 marks an
+  /// entry in an unowned row, which must be added via add_local().
+  /// @param[in] m Number of rows in the block
+  /// @param[in] rows Local row indices
+  /// @param[in] n Number of columns in the block
+  /// @param[in] cols Local column indices
+  /// @param[out] slots Value-array slot for each of the m*n entries
+  ///   (row-major)
+  void compute_slots(int m, const std::int32_t* rows, int n,
+                     const std::int32_t* cols, std::int32_t* slots) const;
+
+  /// Add values at precomputed slots (see compute_slots). All slots
+  /// must be non-negative.
+  /// @param[in] block Values to add
+  /// @param[in] slots Value-array slots, one per entry of block
+  /// @param[in] n Number of entries
+  void add_scattered(const PetscScalar* block, const std::int32_t* slots,
+                     int n);
+
+  /// Communicate entries that were added into unowned rows to the
+  /// owning ranks and add them there. Collective. Equivalent to
+  /// apply_begin() followed immediately by apply_end().
+  void apply();
+
+  /// Start communicating entries that were added into unowned rows to
+  /// the owning ranks, using nonblocking neighborhood collectives, and
+  /// return. Independent work (e.g. assembling the RHS vector) can be
+  /// overlapped with the exchange before calling apply_end(). No
+  /// entries may be added between apply_begin and apply_end.
+  /// Collective.
+  void apply_begin();
+
+  /// Finish the exchange started by apply_begin() and add the received
+  /// entries into the owned rows. Collective.
+  void apply_end();
+
+  /// Set all stored values to zero, keeping the pattern
+  void zero();
+
+  /// Create a PETSc MATMPIAIJ matrix that shares this matrix's index
+  /// and value arrays (no copy, via MatCreateMPIAIJWithSplitArrays).
+  /// This CSRMatrix must be kept alive for the lifetime of the
+  /// returned Mat, and apply() must have been called since the last
+  /// insertion. The caller is responsible for destroying the Mat.
+  Mat create_petsc_matrix();
+
+  /// Index map for dimension dim (0 = rows, 1 = columns)
+  std::shared_ptr<const common::IndexMap> index_map(int dim) const;
+
+  /// Return MPI communicator
+  MPI_Comm mpi_comm() const;
+
+private:
+  // Look up the value-array slot of an owned entry, or -1 if the
+  // entry is not in the pattern. row is a local owned row, col a local
+  // column index (possibly a ghost)
+  std::int32_t find_slot(std::int32_t row, std::int32_t col) const;
+
+  // MPI communicator
+  dolfinx::MPI::Comm _mpi_comm;
+
+  // common::IndexMaps for each dimension
+  std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
+
+  // CSR arrays for the owned rows. The diagonal block stores local
+  // column indices, the off-diagonal block global column indices;
+  // column indices are sorted within each row.
+  std::vector<PetscInt> _row_ptr_diag;
+  std::vector<PetscInt> _cols_diag;
+  std::vector<PetscInt> _row_ptr_off;
+  std::vector<PetscInt> _cols_off;
+  std::vector<PetscScalar> _values_diag;
+  std::vector<PetscScalar> _values_off;
+
+  // Stash for entries added into unowned rows: (global row, global
+  // column) pairs and the matching values, sent to the owners by
+  // apply()
+  std::vector<std::int64_t> _stash_indices;
+  std::vector<PetscScalar> _stash_values;
+
+  // In-flight stash exchange state between apply_begin() and
+  // apply_end(): neighbourhood communicator, the nonblocking requests
+  // and the receive buffers they fill
+  MPI_Comm _pending_comm = MPI_COMM_NULL;
+  std::vector<MPI_Request> _pending_requests;
+  std::vector<std::int64_t> _indices_recv;
+  std::vector<PetscScalar> _values_recv;
+};
+} // namespace la
+} // namespace dolfinx
@@ -0,0 +1,86 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "DenseBlockSolver.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cassert>
+#include <dolfinx/common/utils.h>
+
+using namespace dolfinx;
+using namespace dolfinx::la;
+
+//-----------------------------------------------------------------------------
+DenseBlockSolver::DenseBlockSolver(const std::vector<int>& block_sizes)
+    : _block_sizes(block_sizes)
+{
+  _A_offsets.reserve(block_sizes.size() + 1);
+  _b_offsets.reserve(block_sizes.size() + 1);
+  _A_offsets.push_back(0);
+  _b_offsets.push_back(0);
+  for (int n : block_sizes)
+  {
+    assert(n >= 0);
+    _A_offsets.push_back(_A_offsets.back() + (std::int64_t)n * n);
+    _b_offsets.push_back(_b_offsets.back() + n);
+  }
+
+  _A.resize(_A_offsets.back(), 0.0);
+  _b.resize(_b_offsets.back(), 0.0);
+}
+//-----------------------------------------------------------------------------
+int DenseBlockSolver::num_blocks() const { return _block_sizes.size(); }
+//-----------------------------------------------------------------------------
+int DenseBlockSolver::block_size(int block) const
+{
+  return _block_sizes[block];
+}
+//-----------------------------------------------------------------------------
+PetscScalar* DenseBlockSolver::A(int block)
+{
+  return _A.data() + _A_offsets[block];
+}
+//-----------------------------------------------------------------------------
+PetscScalar* DenseBlockSolver::b(int block)
+{
+  return _b.data() + _b_offsets[block];
+}
+//-----------------------------------------------------------------------------
+void DenseBlockSolver::solve()
+{
+  // Blocks are independent, so they are distributed over the thread
+  // pool in contiguous chunks. The factorization is done in place in
+  // the matrix buffer and the solution is written over the right-hand
+  // side, so the solve performs no allocation beyond Eigen's pivot
+  // bookkeeping.
+  common::parallel_for(
+      (std::int32_t)_block_sizes.size(), [&](std::int32_t begin,
+                                             std::int32_t end) {
+        for (std::int32_t block = begin; block < end; ++block)
+        {
+          const int n = _block_sizes[block];
+          if (n == 0)
+            continue;
+          Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>>
+              A(_A.data() + _A_offsets[block], n, n);
+          Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b(
+              _b.data() + _b_offsets[block], n);
+          Eigen::PartialPivLU<Eigen::Ref<
+              Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>>>
+              lu(A);
+          b = lu.solve(b);
+        }
+      });
+}
+//-----------------------------------------------------------------------------
+void DenseBlockSolver::set_zero()
+{
+  std::fill(_A.begin(), _A.end(), 0.0);
+  std::fill(_b.begin(), _b.end(), 0.0);
+}
+//-----------------------------------------------------------------------------
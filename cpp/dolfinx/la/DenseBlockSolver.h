@@ -0,0 +1,97 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace la
+{
+
+/// Batched dense solver for many small independent linear systems,
+/// e.g. the per-cell or per-patch problems of local error estimators
+/// and local projections. The systems are held in one contiguous
+/// buffer and factored and solved with dense LU across the worker
+/// thread pool, so the per-solve cost is the factorization itself -
+/// no global objects, no solver setup and no communication are
+/// involved. Typical block sizes are a few tens of degrees of
+/// freedom, where routing each system through PETSc costs more in
+/// setup than in arithmetic.
+///
+/// Usage: construct with the block sizes, assemble each local matrix
+/// and right-hand side into the buffers returned by A() and b()
+/// (e.g. from element kernels with patch-local index maps), then call
+/// solve(). The solutions overwrite the right-hand sides.
+
+class DenseBlockSolver
+{
+public:
+  /// Create a solver for a batch of systems, with all matrix and
+  /// right-hand side entries zero-initialized
+  /// @param[in] block_sizes Number of degrees of freedom of each
+  ///   local system
+  explicit DenseBlockSolver(const std::vector<int>& block_sizes);
+
+  // Copy constructor (deleted)
+  DenseBlockSolver(const DenseBlockSolver&) = delete;
+
+  /// Move constructor
+  DenseBlockSolver(DenseBlockSolver&&) = default;
+
+  /// Destructor
+  ~DenseBlockSolver() = default;
+
+  // Assignment operator (deleted)
+  DenseBlockSolver& operator=(const DenseBlockSolver&) = delete;
+
+  /// Move assignment operator
+  DenseBlockSolver& operator=(DenseBlockSolver&&) = default;
+
+  /// Number of systems in the batch
+  int num_blocks() const;
+
+  /// Number of degrees of freedom of a system
+  /// @param[in] block The block index
+  int block_size(int block) const;
+
+  /// Matrix buffer of a system, row-major with shape (n, n) where n
+  /// is the block size. The buffer is overwritten by its LU factors
+  /// during solve().
+  /// @param[in] block The block index
+  PetscScalar* A(int block);
+
+  /// Right-hand side buffer of a system, length the block size. Holds
+  /// the solution after solve().
+  /// @param[in] block The block index
+  PetscScalar* b(int block);
+
+  /// Factor all matrices (LU with partial pivoting, in place) and
+  /// solve all systems, distributing the blocks over the worker
+  /// thread pool. The solutions overwrite the right-hand sides.
+  void solve();
+
+  /// Zero all matrix and right-hand side entries, ready for
+  /// re-assembly. The block structure is retained and no memory is
+  /// reallocated.
+  void set_zero();
+
+private:
+  // Size of each block
+  std::vector<int> _block_sizes;
+
+  // Offset of each block in the matrix and right-hand side buffers
+  std::vector<std::int64_t> _A_offsets, _b_offsets;
+
+  // Matrix values for all blocks (row-major within each block) and
+  // right-hand side/solution values for all blocks
+  std::vector<PetscScalar> _A, _b;
+};
+} // namespace la
+} // namespace dolfinx
@@ -0,0 +1,86 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Float32Vector.h"
+#include "utils.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace dolfinx;
+using namespace dolfinx::la;
+
+//-----------------------------------------------------------------------------
+Float32Vector::Float32Vector(std::shared_ptr<const common::IndexMap> map)
+    : _map(map)
+{
+  assert(_map);
+  const std::int32_t size
+      = _map->block_size() * (_map->size_local() + _map->num_ghosts());
+  _x.assign(size, 0.0f);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const common::IndexMap> Float32Vector::map() const
+{
+  return _map;
+}
+//-----------------------------------------------------------------------------
+std::vector<float>& Float32Vector::array() { return _x; }
+//-----------------------------------------------------------------------------
+const std::vector<float>& Float32Vector::array() const { return _x; }
+//-----------------------------------------------------------------------------
+void Float32Vector::update_ghosts()
+{
+  const int bs = _map->block_size();
+  const std::vector<float> local(_x.begin(),
+                                 _x.begin() + bs * _map->size_local());
+  std::vector<float> remote;
+  _map->scatter_fwd(local, remote, bs);
+  assert((std::int32_t)remote.size() == bs * _map->num_ghosts());
+  std::copy(remote.begin(), remote.end(),
+            _x.begin() + bs * _map->size_local());
+}
+//-----------------------------------------------------------------------------
+void Float32Vector::apply_ghosts(common::IndexMap::Mode op)
+{
+  const int bs = _map->block_size();
+  std::vector<float> local(_x.begin(), _x.begin() + bs * _map->size_local());
+  const std::vector<float> remote(_x.begin() + bs * _map->size_local(),
+                                  _x.end());
+  _map->scatter_rev(local, remote, bs, op);
+  std::copy(local.begin(), local.end(), _x.begin());
+}
+//-----------------------------------------------------------------------------
+void Float32Vector::copy_from(const Vec x)
+{
+#ifdef PETSC_USE_COMPLEX
+  throw std::runtime_error(
+      "Cannot demote complex-valued vector to float32.");
+#else
+  assert(x);
+  la::VecReadWrapper w(x);
+  if ((std::size_t)w.x.size() != _x.size())
+    throw std::runtime_error("Vector layouts do not match.");
+  for (std::size_t i = 0; i < _x.size(); ++i)
+    _x[i] = static_cast<float>(w.x[i]);
+#endif
+}
+//-----------------------------------------------------------------------------
+void Float32Vector::copy_to(Vec x) const
+{
+#ifdef PETSC_USE_COMPLEX
+  throw std::runtime_error(
+      "Cannot promote float32 vector into complex-valued vector.");
+#else
+  assert(x);
+  la::VecWrapper w(x);
+  if ((std::size_t)w.x.size() != _x.size())
+    throw std::runtime_error("Vector layouts do not match.");
+  for (std::size_t i = 0; i < _x.size(); ++i)
+    w.x[i] = static_cast<PetscScalar>(_x[i]);
+  w.restore();
+#endif
+}
+//-----------------------------------------------------------------------------
@@ -8,14 +8,37 @@
 #include "PETScOperator.h"
 #include "VectorSpaceBasis.h"
 #include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/SubSystemsManager.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <petsclog.h>
+#include <petscversion.h>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+/// Busy compute kernel for the overlap microbenchmark: a dependent
+/// floating-point chain the compiler cannot elide, sized in iterations
+/// so the caller can calibrate it against the reduction latency
+double overlap_compute_kernel(std::int64_t iterations)
+{
+  volatile double acc = 1.0;
+  for (std::int64_t i = 0; i < iterations; ++i)
+    acc = acc * 1.0000001 + 1.0e-12;
+  return acc;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 PETScKrylovSolver::PETScKrylovSolver(MPI_Comm comm) : _ksp(nullptr)
 {
@@ -54,6 +77,135 @@ void PETScKrylovSolver::set_operators(const Mat A, const Mat P)
   ierr = KSPSetOperators(_ksp, A, P);
   if (ierr != 0)
     petsc_error(ierr, __FILE__, "KSPSetOperators");
+
+  // Re-apply the reuse mode; the preconditioner type may have been set
+  // (e.g. by set_from_options) since the mode was selected
+  apply_reuse_options();
+}
+//-----------------------------------------------------------------------------
+void PETScKrylovSolver::set_reuse(Reuse reuse)
+{
+  _reuse = reuse;
+  apply_reuse_options();
+}
+//-----------------------------------------------------------------------------
+void PETScKrylovSolver::set_pipelined(PipelinedMethod method)
+{
+  assert(_ksp);
+  PetscErrorCode ierr = 0;
+  switch (method)
+  {
+  case PipelinedMethod::cg:
+    ierr = KSPSetType(_ksp, KSPPIPECG);
+    break;
+  case PipelinedMethod::gmres:
+    ierr = KSPSetType(_ksp, KSPPGMRES);
+    break;
+  }
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPSetType");
+
+  // The pipelined methods only pay off when the non-blocking
+  // reductions progress while the operator is applied. Check the
+  // runtime prerequisites and point at the knobs when they are
+  // missing; correctness is unaffected either way.
+  const int thread_level = common::SubSystemsManager::mpi_thread_level();
+  if (thread_level < MPI_THREAD_MULTIPLE)
+  {
+    LOG(WARNING)
+        << "Pipelined Krylov method selected but MPI was initialised "
+           "without MPI_THREAD_MULTIPLE. Asynchronous progress threads are "
+           "unavailable and the reductions are unlikely to overlap.";
+  }
+  if (!std::getenv("MPICH_ASYNC_PROGRESS") and !std::getenv("MPIR_CVAR_ASYNC_PROGRESS")
+      and !std::getenv("I_MPI_ASYNC_PROGRESS"))
+  {
+    LOG(WARNING)
+        << "Pipelined Krylov method selected but no MPI asynchronous "
+           "progress environment switch is set (MPICH_ASYNC_PROGRESS, "
+           "MPIR_CVAR_ASYNC_PROGRESS or I_MPI_ASYNC_PROGRESS). Verify the "
+           "overlap with PETScKrylovSolver::measure_reduction_overlap.";
+  }
+}
+//-----------------------------------------------------------------------------
+double PETScKrylovSolver::measure_reduction_overlap(MPI_Comm comm, int repeats)
+{
+  // Warm up the reduction path, then time a blocking allreduce
+  double value = 1.0;
+  MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM, comm);
+  MPI_Barrier(comm);
+  double t0 = MPI_Wtime();
+  for (int i = 0; i < repeats; ++i)
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM, comm);
+  const double t_reduce = (MPI_Wtime() - t0) / repeats;
+
+  // Calibrate the compute kernel to roughly the reduction latency
+  std::int64_t iterations = 1000;
+  double t_compute = 0.0;
+  do
+  {
+    iterations *= 2;
+    t0 = MPI_Wtime();
+    overlap_compute_kernel(iterations);
+    t_compute = MPI_Wtime() - t0;
+  } while (t_compute < t_reduce and iterations < (std::int64_t(1) << 40));
+
+  // Pipelined: start the reduction, compute, then wait
+  MPI_Barrier(comm);
+  t0 = MPI_Wtime();
+  for (int i = 0; i < repeats; ++i)
+  {
+    MPI_Request request;
+    MPI_Iallreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM, comm,
+                   &request);
+    overlap_compute_kernel(iterations);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+  }
+  const double t_pipelined = (MPI_Wtime() - t0) / repeats;
+
+  // Fraction of the reduction latency hidden by the computation. The
+  // slowest rank limits the solver, so report the minimum everywhere.
+  double overlap = t_reduce > 0.0
+                       ? (t_reduce + t_compute - t_pipelined) / t_reduce
+                       : 1.0;
+  overlap = std::min(1.0, std::max(0.0, overlap));
+  MPI_Allreduce(MPI_IN_PLACE, &overlap, 1, MPI_DOUBLE, MPI_MIN, comm);
+  return overlap;
+}
+//-----------------------------------------------------------------------------
+void PETScKrylovSolver::apply_reuse_options()
+{
+  assert(_ksp);
+  PetscErrorCode ierr;
+
+  // Freeze or re-enable the preconditioner as a whole
+  ierr = KSPSetReusePreconditioner(
+      _ksp, _reuse == Reuse::preconditioner ? PETSC_TRUE : PETSC_FALSE);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPSetReusePreconditioner");
+
+  PC pc = nullptr;
+  ierr = KSPGetPC(_ksp, &pc);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPGetPC");
+
+  // For same-structure updates keep the structure-dependent setup.
+  // Symbolic factorizations are reused by PETSc automatically when the
+  // nonzero pattern is unchanged; for GAMG the coarsening and
+  // interpolation operators (the bulk of the setup cost) must be
+  // retained explicitly, so that a new operator only recomputes the
+  // Galerkin coarse matrices.
+  PCType pc_type = nullptr;
+  ierr = PCGetType(pc, &pc_type);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "PCGetType");
+  if (pc_type and strcmp(pc_type, PCGAMG) == 0)
+  {
+    ierr = PCGAMGSetReuseInterpolation(
+        pc, _reuse == Reuse::structure ? PETSC_TRUE : PETSC_FALSE);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "PCGAMGSetReuseInterpolation");
+  }
 }
 //-----------------------------------------------------------------------------
 int PETScKrylovSolver::solve(Vec x, const Vec b, bool transpose)
@@ -161,6 +313,109 @@ int PETScKrylovSolver::solve(Vec x, const Vec b, bool transpose)
   return num_iterations;
 }
 //-----------------------------------------------------------------------------
+std::vector<int> PETScKrylovSolver::solve(const std::vector<Vec>& x,
+                                          const std::vector<Vec>& b,
+                                          bool transpose)
+{
+  common::Timer timer("PETSc Krylov solver (multi-RHS)");
+  if (x.size() != b.size())
+  {
+    throw std::runtime_error(
+        "Mismatch between number of solution and right-hand side vectors");
+  }
+  if (x.empty())
+    return std::vector<int>();
+
+  PetscErrorCode ierr;
+
+  // Perform the setup (e.g. the preconditioner factorization) once for
+  // the whole batch
+  ierr = KSPSetUp(_ksp);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPSetUp");
+
+#if PETSC_VERSION_GE(3, 14, 0)
+  if (!transpose)
+  {
+    // Pack the right-hand sides as the columns of a dense matrix and
+    // solve the batch in one call. Methods with pseudo-block support
+    // apply the operator to all columns at once (SpMM) and fuse the
+    // inner products; the others solve the columns sequentially while
+    // still sharing the setup.
+    MPI_Comm comm;
+    PetscObjectGetComm((PetscObject)_ksp, &comm);
+
+    const PetscInt nrhs = x.size();
+    PetscInt m = 0;
+    VecGetLocalSize(b.front(), &m);
+
+    Mat B, X;
+    ierr = MatCreateDense(comm, m, PETSC_DECIDE, PETSC_DETERMINE, nrhs,
+                          nullptr, &B);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "MatCreateDense");
+    ierr = MatCreateDense(comm, m, PETSC_DECIDE, PETSC_DETERMINE, nrhs,
+                          nullptr, &X);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "MatCreateDense");
+
+    // Copy the right-hand sides into the (column-major) dense array
+    PetscScalar* array;
+    MatDenseGetArray(B, &array);
+    for (PetscInt j = 0; j < nrhs; ++j)
+    {
+      const PetscScalar* bj;
+      VecGetArrayRead(b[j], &bj);
+      std::copy(bj, bj + m, array + j * m);
+      VecRestoreArrayRead(b[j], &bj);
+    }
+    MatDenseRestoreArray(B, &array);
+
+    ierr = KSPMatSolve(_ksp, B, X);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "KSPMatSolve");
+
+    // Copy the solutions back and update ghost values
+    MatDenseGetArray(X, &array);
+    for (PetscInt j = 0; j < nrhs; ++j)
+    {
+      PetscScalar* xj;
+      VecGetArray(x[j], &xj);
+      std::copy(array + j * m, array + (j + 1) * m, xj);
+      VecRestoreArray(x[j], &xj);
+
+      Vec xg;
+      VecGhostGetLocalForm(x[j], &xg);
+      const bool is_ghosted = xg ? true : false;
+      VecGhostRestoreLocalForm(x[j], &xg);
+      if (is_ghosted)
+      {
+        VecGhostUpdateBegin(x[j], INSERT_VALUES, SCATTER_FORWARD);
+        VecGhostUpdateEnd(x[j], INSERT_VALUES, SCATTER_FORWARD);
+      }
+    }
+    MatDenseRestoreArray(X, &array);
+
+    MatDestroy(&B);
+    MatDestroy(&X);
+
+    PetscInt num_iterations = 0;
+    ierr = KSPGetIterationNumber(_ksp, &num_iterations);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "KSPGetIterationNumber");
+    return std::vector<int>(x.size(), num_iterations);
+  }
+#endif
+
+  // Sequential fallback; the setup above is still shared across the
+  // batch
+  std::vector<int> num_iterations;
+  num_iterations.reserve(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i)
+    num_iterations.push_back(solve(x[i], b[i], transpose));
+  return num_iterations;
+}
+//-----------------------------------------------------------------------------
 void PETScKrylovSolver::set_dm(DM dm)
 {
   assert(_ksp);
@@ -11,6 +11,7 @@
 #include <petscmat.h>
 #include <petscvec.h>
 #include <string>
+#include <vector>
 
 namespace dolfinx
 {
@@ -38,16 +39,90 @@ public:
   /// Destructor
   virtual ~PETScKrylovSolver();
 
+  /// Preconditioner work retained when the operator is updated via
+  /// set_operator/set_operators, for sequences of solves where the
+  /// operator is reassembled repeatedly (e.g. every Newton iteration or
+  /// time step)
+  enum class Reuse
+  {
+    none, ///< Full preconditioner setup on every operator update
+    structure, ///< Matrix values changed but the sparsity pattern and
+               ///< near-nullspace are unchanged. Structure-dependent
+               ///< work (multigrid coarsening/interpolation, symbolic
+               ///< factorization) is kept and only numerical parts
+               ///< (Galerkin coarse operators, numeric factorization)
+               ///< are refreshed
+    preconditioner ///< Freeze the preconditioner entirely; operator
+                   ///< updates only affect the Krylov operator
+  };
+
   /// Set operator (Mat)
   void set_operator(const Mat A);
 
   /// Set operator and preconditioner matrix (Mat)
   void set_operators(const Mat A, const Mat P);
 
+  /// Set how much preconditioner setup is reused across operator
+  /// updates. The mode applies to subsequent set_operator/set_operators
+  /// calls; it can be changed at any time, e.g. switched to
+  /// Reuse::none for one update after a mesh change.
+  void set_reuse(Reuse reuse);
+
+  /// Pipelined Krylov methods, which replace the blocking dot-product
+  /// reductions of the standard methods with non-blocking reductions
+  /// overlapped with the operator and preconditioner application
+  enum class PipelinedMethod
+  {
+    cg,   ///< Pipelined conjugate gradient (PETSc pipecg)
+    gmres ///< Pipelined GMRES (PETSc pgmres)
+  };
+
+  /// Configure the solver for a pipelined Krylov method. At large rank
+  /// counts the allreduce latency of standard CG/GMRES dominates; the
+  /// pipelined variants hide it behind the matrix-vector product, but
+  /// only if the MPI library makes progress on the non-blocking
+  /// reduction in the background. This sets the KSP type and checks
+  /// the runtime for the prerequisites: the thread support level MPI
+  /// was initialised with (see SubSystemsManager::mpi_thread_level)
+  /// and the asynchronous-progress environment switches of the common
+  /// MPI implementations, warning when overlap is unlikely. Use
+  /// measure_reduction_overlap to verify the overlap on the actual
+  /// machine.
+  /// @param[in] method The pipelined method to use
+  void set_pipelined(PipelinedMethod method);
+
+  /// Microbenchmark for reduction/computation overlap: times a
+  /// blocking allreduce, a compute kernel of comparable duration, and
+  /// the two pipelined (MPI_Iallreduce + compute + wait), and returns
+  /// the fraction of the reduction latency hidden by the computation
+  /// (0 = the non-blocking reduction only progresses in the final
+  /// wait, 1 = full overlap). The minimum over the ranks is returned
+  /// on all ranks, since the slowest rank limits the solver.
+  /// Collective; run once at startup to verify that the MPI
+  /// async-progress configuration actually works before relying on
+  /// set_pipelined.
+  /// @param[in] comm MPI communicator
+  /// @param[in] repeats Number of repetitions to average over
+  /// @return Overlap fraction in [0, 1]
+  static double measure_reduction_overlap(MPI_Comm comm, int repeats = 50);
+
   /// Solve linear system Ax = b and return number of iterations (A^t x
   /// = b if transpose is true)
   int solve(Vec x, const Vec b, bool transpose = false);
 
+  /// Solve the linear systems A x[i] = b[i] for a batch of right-hand
+  /// sides sharing the operator. The solver setup (e.g. the
+  /// preconditioner factorization) is performed once for the whole
+  /// batch, and where PETSc provides a blocked solve the right-hand
+  /// sides are solved together, so the operator is applied to all
+  /// columns at once (SpMM) and the inner products are fused.
+  /// @param[in,out] x Solution vectors, one per right-hand side
+  /// @param[in] b Right-hand side vectors
+  /// @param[in] transpose Solve the transposed systems (A^t x = b)
+  /// @return Number of iterations for each right-hand side
+  std::vector<int> solve(const std::vector<Vec>& x, const std::vector<Vec>& b,
+                         bool transpose = false);
+
   /// Sets the prefix used by PETSc when searching the PETSc options
   /// database
   void set_options_prefix(std::string options_prefix);
@@ -69,8 +144,14 @@ public:
   void set_dm_active(bool val);
 
 private:
+  // Apply the current reuse mode to the KSP/PC objects
+  void apply_reuse_options();
+
   // PETSc solver pointer
   KSP _ksp;
+
+  // Preconditioner reuse mode for operator updates
+  Reuse _reuse = Reuse::none;
 };
 } // namespace la
 } // namespace dolfinx
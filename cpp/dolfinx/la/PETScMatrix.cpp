@@ -97,6 +97,30 @@ void PETScMatrix::apply(AssemblyType type)
     petsc_error(ierr, __FILE__, "MatAssemblyEnd");
 }
 //-----------------------------------------------------------------------------
+void PETScMatrix::apply_begin(AssemblyType type)
+{
+  assert(_matA);
+  MatAssemblyType petsc_type = MAT_FINAL_ASSEMBLY;
+  if (type == AssemblyType::FLUSH)
+    petsc_type = MAT_FLUSH_ASSEMBLY;
+
+  PetscErrorCode ierr = MatAssemblyBegin(_matA, petsc_type);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatAssemblyBegin");
+}
+//-----------------------------------------------------------------------------
+void PETScMatrix::apply_end(AssemblyType type)
+{
+  assert(_matA);
+  MatAssemblyType petsc_type = MAT_FINAL_ASSEMBLY;
+  if (type == AssemblyType::FLUSH)
+    petsc_type = MAT_FLUSH_ASSEMBLY;
+
+  PetscErrorCode ierr = MatAssemblyEnd(_matA, petsc_type);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatAssemblyEnd");
+}
+//-----------------------------------------------------------------------------
 void PETScMatrix::set_options_prefix(std::string options_prefix)
 {
   assert(_matA);
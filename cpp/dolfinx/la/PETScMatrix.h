@@ -67,6 +67,19 @@ public:
   ///   FLUSH  - corresponds to PETSc MatAssemblyBegin+End(MAT_FLUSH_ASSEMBLY)
   void apply(AssemblyType type);
 
+  /// Begin finalizing assembly of the tensor (MatAssemblyBegin). The
+  /// off-process stash exchange is started and the call returns, so
+  /// independent work (e.g. assembling the RHS vector) can overlap the
+  /// communication. Must be paired with a later apply_end call with
+  /// the same type; the matrix must not be modified in between.
+  /// @param type FINAL or FLUSH, as for apply()
+  void apply_begin(AssemblyType type);
+
+  /// Finish finalizing assembly of the tensor (MatAssemblyEnd). See
+  /// apply_begin().
+  /// @param type FINAL or FLUSH, as for apply()
+  void apply_end(AssemblyType type);
+
   /// Set block of values using global indices
   void set(const PetscScalar* block, int m, const PetscInt* rows, int n,
            const PetscInt* cols);
@@ -50,13 +50,19 @@ PETScVector::PETScVector(PETScVector&& v) noexcept : _x(v._x) { v._x = nullptr;
 PETScVector::~PETScVector()
 {
   if (_x)
+  {
+    la::mark_ghosts_stale(_x);
     VecDestroy(&_x);
+  }
 }
 //-----------------------------------------------------------------------------
 PETScVector& PETScVector::operator=(PETScVector&& v)
 {
   if (_x)
+  {
+    la::mark_ghosts_stale(_x);
     VecDestroy(&_x);
+  }
   _x = v._x;
   v._x = nullptr;
   return *this;
@@ -123,21 +129,9 @@ void PETScVector::apply_ghosts()
 void PETScVector::update_ghosts()
 {
   assert(_x);
-  PetscErrorCode ierr;
-
-  Vec xg;
-  ierr = VecGhostGetLocalForm(_x, &xg);
-  CHECK_ERROR("VecGhostGetLocalForm");
-  if (xg) // Vec is ghosted
-  {
-    ierr = VecGhostUpdateBegin(_x, INSERT_VALUES, SCATTER_FORWARD);
-    CHECK_ERROR("VecGhostUpdateBegin");
-    ierr = VecGhostUpdateEnd(_x, INSERT_VALUES, SCATTER_FORWARD);
-    CHECK_ERROR("VecGhostUpdateEnd");
-  }
-
-  ierr = VecGhostRestoreLocalForm(_x, &xg);
-  CHECK_ERROR("VecGhostRestoreLocalForm");
+  // Tracked update: the communication is skipped when the vector is
+  // unchanged since its last forward update (see la::update_ghosts)
+  la::update_ghosts(_x);
 }
 //-----------------------------------------------------------------------------
 MPI_Comm PETScVector::mpi_comm() const
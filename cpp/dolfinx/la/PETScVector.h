@@ -81,7 +81,8 @@ public:
   void apply_ghosts();
 
   /// Update ghost values (gathers ghost values from the owning
-  /// processes)
+  /// processes). The communication is skipped when the vector has not
+  /// been modified since its last update (see la::update_ghosts).
   void update_ghosts();
 
   /// Return MPI communicator
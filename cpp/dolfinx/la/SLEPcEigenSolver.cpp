@@ -14,6 +14,7 @@
 #include <dolfinx/la/PETScVector.h>
 #include <petscmat.h>
 #include <slepcversion.h>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -99,6 +100,62 @@ void SLEPcEigenSolver::solve(std::int64_t n)
             << num_iterations << " iterations.";
 }
 //-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_initial_space(const VectorSpaceBasis& basis)
+{
+  assert(_eps);
+  std::vector<Vec> v;
+  v.reserve(basis.dim());
+  for (int i = 0; i < basis.dim(); ++i)
+  {
+    assert(basis[i]);
+    v.push_back(basis[i]->vec());
+  }
+
+  PetscErrorCode ierr = EPSSetInitialSpace(_eps, v.size(), v.data());
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "EPSSetInitialSpace");
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::solve_interval(double a, double b, int num_partitions)
+{
+  assert(_eps);
+  if (!(a < b))
+    throw std::runtime_error("Invalid spectrum slicing interval");
+
+  // Spectrum slicing computes all eigenvalues in [a, b] with
+  // Krylov-Schur. With more than one partition the interval is split
+  // into shift sub-intervals handled by sub-communicators, which
+  // factorize their shifted operators concurrently.
+  EPSSetType(_eps, EPSKRYLOVSCHUR);
+  EPSSetWhichEigenpairs(_eps, EPS_ALL);
+  EPSSetInterval(_eps, a, b);
+  if (num_partitions > 1)
+    EPSKrylovSchurSetPartitions(_eps, num_partitions);
+
+  // Slicing requires the shift-and-invert spectral transformation
+  ST st;
+  EPSGetST(_eps, &st);
+  STSetType(st, STSINVERT);
+
+  // Set any options from the PETSc database
+  EPSSetFromOptions(_eps);
+
+  // Solve eigenvalue problem
+  EPSSolve(_eps);
+
+  // Check for convergence
+  EPSConvergedReason reason;
+  EPSGetConvergedReason(_eps, &reason);
+  if (reason < 0)
+    LOG(WARNING) << "Eigenvalue solver did not converge";
+
+  // Report solver status
+  PetscInt num_conv = 0;
+  EPSGetConverged(_eps, &num_conv);
+  LOG(INFO) << "Spectrum slicing found " << num_conv << " eigenvalues in ["
+            << a << ", " << b << "].";
+}
+//-----------------------------------------------------------------------------
 std::complex<PetscReal> SLEPcEigenSolver::get_eigenvalue(std::size_t i) const
 {
   assert(_eps);
@@ -47,6 +47,26 @@ public:
   /// Compute the n first eigenpairs of the matrix A (solve Ax = \lambda x)
   void solve(std::int64_t n);
 
+  /// Set the initial space for the next solve from previous solution
+  /// vectors. For a slightly perturbed operator, e.g. between design
+  /// iterations, the iteration then starts close to the invariant
+  /// subspace and converges in a few iterations (warm start).
+  /// @param[in] basis Vectors spanning the initial space, typically
+  ///     the converged eigenvectors of the previous solve
+  void set_initial_space(const VectorSpaceBasis& basis);
+
+  /// Compute all eigenvalues in the interval [a, b] by spectrum
+  /// slicing. The interval is divided into shift sub-intervals
+  /// distributed over num_partitions sub-communicators of the solver
+  /// communicator, each factorizing its shifted operator
+  /// independently. Requires a Hermitian problem type, and the
+  /// communicator size must be a multiple of num_partitions.
+  /// @param[in] a Lower end of the interval
+  /// @param[in] b Upper end of the interval
+  /// @param[in] num_partitions Number of sub-communicators the
+  ///     interval is distributed over
+  void solve_interval(double a, double b, int num_partitions = 1);
+
   /// Get ith eigenvalue
   std::complex<PetscReal> get_eigenvalue(std::size_t i) const;
 
@@ -9,8 +9,10 @@
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <thread>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -221,6 +223,85 @@ void SparsityPattern::insert(
   }
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::insert_cells(
+    const graph::AdjacencyList<std::int32_t>& rows,
+    const graph::AdjacencyList<std::int32_t>& cols)
+{
+  if (_diagonal)
+  {
+    throw std::runtime_error(
+        "Cannot insert into sparsity pattern. It has already been assembled");
+  }
+  if (rows.num_nodes() != cols.num_nodes())
+    throw std::runtime_error("Row and column lists have different lengths.");
+
+  assert(_index_maps[0]);
+  const int bs0 = _index_maps[0]->block_size();
+  const std::int32_t size0
+      = bs0 * (_index_maps[0]->size_local() + _index_maps[0]->num_ghosts());
+
+  assert(_index_maps[1]);
+  const int bs1 = _index_maps[1]->block_size();
+  const std::int32_t local_size1 = _index_maps[1]->size_local();
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
+      = _index_maps[1]->ghosts();
+
+  if (rows.array().size() > 0 and rows.array().maxCoeff() >= size0)
+  {
+    throw std::runtime_error(
+        "Cannot insert rows that do not exist in the IndexMap.");
+  }
+
+  // Each worker thread owns a contiguous block of rows and scans all
+  // nodes, inserting only the rows in its block. Threads therefore
+  // never touch the same row cache and no locking is needed; the
+  // resulting caches are identical to serial insertion up to ordering,
+  // which assemble() normalizes by sorting.
+  const int num_threads = common::num_worker_threads();
+  const std::int32_t num_rows = size0;
+  auto insert_row_block = [&](std::int32_t r_begin, std::int32_t r_end) {
+    for (std::int32_t node = 0; node < rows.num_nodes(); ++node)
+    {
+      auto row_dofs = rows.links(node);
+      auto col_dofs = cols.links(node);
+      for (Eigen::Index i = 0; i < row_dofs.rows(); ++i)
+      {
+        const std::int32_t row = row_dofs[i];
+        if (row < r_begin or row >= r_end)
+          continue;
+        for (Eigen::Index j = 0; j < col_dofs.rows(); ++j)
+        {
+          if (col_dofs[j] < bs1 * local_size1)
+            _diagonal_cache[row].push_back(col_dofs[j]);
+          else
+          {
+            const std::div_t div = std::div(col_dofs[j], bs1);
+            const std::int64_t block_global = ghosts1[div.quot - local_size1];
+            _off_diagonal_cache[row].push_back(bs1 * block_global + div.rem);
+          }
+        }
+      }
+    }
+  };
+
+  if (num_threads <= 1 or num_rows < 2 * num_threads)
+    insert_row_block(0, num_rows);
+  else
+  {
+    const std::int32_t chunk = (num_rows + num_threads - 1) / num_threads;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+      const std::int32_t begin = t * chunk;
+      const std::int32_t end = std::min(begin + chunk, num_rows);
+      if (begin < end)
+        threads.emplace_back(insert_row_block, begin, end);
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+}
+//-----------------------------------------------------------------------------
 void SparsityPattern::insert_diagonal(
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& rows)
 {
@@ -246,6 +327,35 @@ void SparsityPattern::insert_diagonal(
   }
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::insert_diagonal(
+    const std::vector<
+        Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>>& rows)
+{
+  if (_diagonal)
+  {
+    throw std::runtime_error(
+        "Cannot insert into sparsity pattern. It has already been assembled");
+  }
+
+  assert(_index_maps[0]);
+  const int bs0 = _index_maps[0]->block_size();
+  const std::int32_t local_size0
+      = bs0 * (_index_maps[0]->size_local() + _index_maps[0]->num_ghosts());
+  for (const auto& r : rows)
+  {
+    for (Eigen::Index i = 0; i < r.rows(); ++i)
+    {
+      if (r[i] < local_size0)
+        _diagonal_cache[r[i]].push_back(r[i]);
+      else
+      {
+        throw std::runtime_error(
+            "Cannot insert rows that do not exist in the IndexMap.");
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 void SparsityPattern::assemble()
 {
   if (_diagonal)
@@ -384,6 +494,12 @@ void SparsityPattern::assemble()
   _off_diagonal = std::make_shared<graph::AdjacencyList<std::int64_t>>(
       _off_diagonal_cache);
   std::vector<std::vector<std::int64_t>>().swap(_off_diagonal_cache);
+
+  _mem_usage.update(
+      sizeof(std::int32_t)
+          * (_diagonal->array().rows() + _diagonal->offsets().rows())
+      + sizeof(std::int64_t)
+            * (_off_diagonal->array().rows() + _off_diagonal->offsets().rows()));
 }
 //-----------------------------------------------------------------------------
 std::int64_t SparsityPattern::num_nonzeros() const
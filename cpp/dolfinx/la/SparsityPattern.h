@@ -8,6 +8,7 @@
 
 #include <Eigen/Dense>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MemoryRegistry.h>
 #include <memory>
 #include <string>
 #include <utility>
@@ -82,6 +83,17 @@ public:
          const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
              cols);
 
+  /// Insert non-zero locations for every node of a pair of adjacency
+  /// lists, e.g. the row and column cell dofmaps of a bilinear form.
+  /// Equivalent to calling insert() once per node, but the insertion
+  /// is split into row blocks distributed over the worker threads (see
+  /// DOLFINX_NUM_THREADS), so the whole list is inserted concurrently.
+  /// @param[in] rows Row indices, one set per node (local indices)
+  /// @param[in] cols Column indices, one set per node (local indices).
+  ///   Must have the same number of nodes as rows.
+  void insert_cells(const graph::AdjacencyList<std::int32_t>& rows,
+                    const graph::AdjacencyList<std::int32_t>& cols);
+
   /// Insert non-zero locations on the diagonal
   /// @param[in] rows The rows in local (process-wise) indices. The
   ///   indices must exist in the row IndexMap.
@@ -89,6 +101,16 @@ public:
       const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
           rows);
 
+  /// Insert non-zero locations on the diagonal for several arrays of
+  /// rows (e.g. the constrained rows of all boundary conditions) in
+  /// one pass. Equivalent to calling insert_diagonal() once per array.
+  /// @param[in] rows Sets of rows in local (process-wise) indices. The
+  ///   indices must exist in the row IndexMap.
+  void insert_diagonal(
+      const std::vector<
+          Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>>&
+          rows);
+
   /// Finalize sparsity pattern and communicate off-process entries
   void assemble();
 
@@ -120,6 +142,9 @@ private:
   // Sparsity pattern data (computed once pattern is finalised)
   std::shared_ptr<graph::AdjacencyList<std::int32_t>> _diagonal;
   std::shared_ptr<graph::AdjacencyList<std::int64_t>> _off_diagonal;
+
+  // Reported resident bytes of the assembled pattern
+  common::MemoryRegistry::Usage _mem_usage{"SparsityPattern"};
 };
 } // namespace la
 } // namespace dolfinx
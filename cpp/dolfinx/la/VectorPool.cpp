@@ -0,0 +1,171 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "VectorPool.h"
+#include "utils.h"
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <dolfinx/common/Counters.h>
+#include <dolfinx/common/IndexMap.h>
+#include <functional>
+#include <map>
+#include <petscsys.h>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::la;
+
+namespace
+{
+// Layout key: communicator (as the portable Fortran handle), block
+// size, owned size, ghost count and a hash of the ghost indices for
+// map-derived vectors; a tag and the model object id for duplicates.
+// Two keys compare equal only if a vector created for one layout is a
+// valid work vector for the other.
+using PoolKey = std::array<std::int64_t, 5>;
+
+//-----------------------------------------------------------------------------
+PoolKey map_key(const dolfinx::common::IndexMap& map)
+{
+  // FNV-1a over the ghost indices, so maps with identical sizes but
+  // different ghost patterns do not share vectors
+  std::uint64_t h = 0xcbf29ce484222325ULL;
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts = map.ghosts();
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(ghosts.data());
+  for (std::size_t i = 0; i < sizeof(std::int64_t) * ghosts.rows(); ++i)
+    h = (h ^ p[i]) * 0x100000001b3ULL;
+
+  return {std::int64_t(MPI_Comm_c2f(map.mpi_comm())), map.block_size(),
+          map.size_local(), map.num_ghosts(), std::int64_t(h)};
+}
+//-----------------------------------------------------------------------------
+// Idle vectors, grouped by layout
+std::map<PoolKey, std::vector<Vec>>& free_vectors()
+{
+  static std::map<PoolKey, std::vector<Vec>> vectors;
+  return vectors;
+}
+//-----------------------------------------------------------------------------
+// Layout key of every vector the pool has handed out, so checkin can
+// file it without re-deriving the layout
+std::map<PetscObjectId, PoolKey>& issued_keys()
+{
+  static std::map<PetscObjectId, PoolKey> keys;
+  return keys;
+}
+//-----------------------------------------------------------------------------
+Vec take_or_create(const PoolKey& key, const std::function<Vec()>& create)
+{
+  static const int c_created
+      = dolfinx::common::Counters::register_counter("Work vectors created");
+  static const int c_reused
+      = dolfinx::common::Counters::register_counter("Work vectors reused");
+
+  Vec x = nullptr;
+  std::vector<Vec>& idle = free_vectors()[key];
+  if (!idle.empty())
+  {
+    x = idle.back();
+    idle.pop_back();
+    dolfinx::common::Counters::add(c_reused, 1);
+  }
+  else
+  {
+    x = create();
+    dolfinx::common::Counters::add(c_created, 1);
+  }
+
+  PetscObjectId id;
+  PetscObjectGetId(reinterpret_cast<PetscObject>(x), &id);
+  issued_keys()[id] = key;
+  return x;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+// Public knob
+std::size_t VectorPool::max_cached_per_layout = 8;
+
+//-----------------------------------------------------------------------------
+Vec VectorPool::checkout(const common::IndexMap& map)
+{
+  return take_or_create(map_key(map),
+                        [&map]() { return la::create_petsc_vector(map); });
+}
+//-----------------------------------------------------------------------------
+Vec VectorPool::checkout_like(const Vec x)
+{
+  assert(x);
+  PetscObjectId id;
+  PetscObjectGetId(reinterpret_cast<PetscObject>(x), &id);
+
+  // If the model itself came from the pool, duplicates are
+  // interchangeable with it and share its layout key; otherwise key on
+  // the model's object id, so repeated duplicates of the same vector
+  // recycle each other
+  PoolKey key;
+  if (auto it = issued_keys().find(id); it != issued_keys().end())
+    key = it->second;
+  else
+    key = {-1, -1, std::int64_t(id), 0, 0};
+
+  return take_or_create(key, [x]() {
+    Vec y = nullptr;
+    VecDuplicate(x, &y);
+    return y;
+  });
+}
+//-----------------------------------------------------------------------------
+void VectorPool::checkin(Vec x)
+{
+  assert(x);
+  PetscObjectId id;
+  PetscObjectGetId(reinterpret_cast<PetscObject>(x), &id);
+
+  std::map<PetscObjectId, PoolKey>& issued = issued_keys();
+  auto it = issued.find(id);
+  if (it == issued.end())
+  {
+    // Not a pool vector: the caller is handing over ownership, just
+    // release it
+    VecDestroy(&x);
+    return;
+  }
+
+  std::vector<Vec>& idle = free_vectors()[it->second];
+  if (idle.size() < max_cached_per_layout)
+    idle.push_back(x);
+  else
+  {
+    issued.erase(it);
+    VecDestroy(&x);
+  }
+}
+//-----------------------------------------------------------------------------
+std::size_t VectorPool::num_cached()
+{
+  std::size_t n = 0;
+  for (const auto& idle : free_vectors())
+    n += idle.second.size();
+  return n;
+}
+//-----------------------------------------------------------------------------
+void VectorPool::clear()
+{
+  for (auto& idle : free_vectors())
+  {
+    for (Vec x : idle.second)
+    {
+      PetscObjectId id;
+      PetscObjectGetId(reinterpret_cast<PetscObject>(x), &id);
+      issued_keys().erase(id);
+      VecDestroy(&x);
+    }
+  }
+  free_vectors().clear();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <petscvec.h>
+
+namespace dolfinx
+{
+namespace common
+{
+class IndexMap;
+}
+
+namespace la
+{
+
+/// Pool of reusable PETSc work vectors. Creating a distributed Vec is
+/// not free at scale (allocation, ghost index setup) and transient
+/// work vectors created and destroyed once per solve or per time step
+/// allocate in steady state and fragment the heap. The pool keeps
+/// returned vectors alive, keyed on their layout, and hands them back
+/// on the next checkout with a matching key, so step loops reach a
+/// steady state with no vector allocation.
+///
+/// Vectors are keyed on the IndexMap they were created from (checkout)
+/// or on the model vector they were duplicated from (checkout_like),
+/// so a recycled vector always has the ghost layout the caller asked
+/// for. The entries of a checked-out vector are undefined; callers
+/// must set or zero them. The pool is per-process state, like the
+/// counters registry; it is not thread-safe.
+///
+/// Usage:
+///
+///   Vec w = VectorPool::checkout(*dofmap->index_map);
+///   ...
+///   VectorPool::checkin(w);
+
+class VectorPool
+{
+public:
+  /// Get a ghosted work vector with the layout of an index map,
+  /// recycling a previously returned vector when one with the same
+  /// layout is available (see la::create_petsc_vector for the layout).
+  /// The entries are undefined.
+  /// @param[in] map Index map describing the vector layout
+  /// @return A vector owned by the caller until checkin
+  static Vec checkout(const common::IndexMap& map);
+
+  /// Get a work vector with the layout of an existing vector
+  /// (equivalent to VecDuplicate), recycling a previously returned
+  /// duplicate of the same model when available. The entries are
+  /// undefined.
+  /// @param[in] x The model vector
+  /// @return A vector owned by the caller until checkin
+  static Vec checkout_like(const Vec x);
+
+  /// Return a vector to the pool for reuse. The caller must not use
+  /// the vector afterwards. Vectors that did not come from the pool,
+  /// and vectors returned beyond max_cached_per_layout for their
+  /// layout, are destroyed.
+  /// @param[in] x The vector to return
+  static void checkin(Vec x);
+
+  /// Number of idle vectors currently held by the pool
+  static std::size_t num_cached();
+
+  /// Destroy all idle vectors held by the pool. Call before
+  /// PetscFinalize if the pool was used and PETSc object leak checking
+  /// is enabled.
+  static void clear();
+
+  /// Maximum number of idle vectors retained per layout; checkins
+  /// beyond this destroy the vector
+  static std::size_t max_cached_per_layout;
+};
+} // namespace la
+} // namespace dolfinx
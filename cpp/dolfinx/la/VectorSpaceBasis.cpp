@@ -6,43 +6,73 @@
 
 #include "VectorSpaceBasis.h"
 #include "PETScVector.h"
+#include <algorithm>
 #include <cmath>
+#include <dolfinx/common/IndexMap.h>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
 
 //-----------------------------------------------------------------------------
 VectorSpaceBasis::VectorSpaceBasis(
-    const std::vector<std::shared_ptr<PETScVector>>& basis)
-    : _basis(basis)
+    const std::vector<std::shared_ptr<PETScVector>>& basis, bool orthonormal)
+    : _basis(basis), _orthonormal(orthonormal)
 {
   // Do nothing
 }
 //-----------------------------------------------------------------------------
-void VectorSpaceBasis::orthonormalize(double tol)
+void VectorSpaceBasis::orthonormalize(double tol) { do_orthonormalize(tol); }
+//-----------------------------------------------------------------------------
+void VectorSpaceBasis::ensure_orthonormal(double tol) const
+{
+  if (!_orthonormal)
+    do_orthonormalize(tol);
+}
+//-----------------------------------------------------------------------------
+void VectorSpaceBasis::do_orthonormalize(double tol) const
 {
-  // Loop over each vector in basis
+  // Raw Vec handles for the multi-vector kernels
+  std::vector<Vec> v(_basis.size());
   for (std::size_t i = 0; i < _basis.size(); ++i)
   {
     assert(_basis[i]);
-    // Orthogonalize vector i with respect to previously orthonormalized
-    // vectors
+    v[i] = _basis[i]->vec();
+  }
+
+  std::vector<PetscScalar> dots(_basis.size());
+  for (std::size_t i = 0; i < _basis.size(); ++i)
+  {
+    // Compute the projections on the previously orthonormalized
+    // vectors and <v_i, v_i> in one multi-vector dot product, i.e. one
+    // global reduction per basis vector instead of one per (i, j) pair
+    VecMDot(v[i], i + 1, v.data(), dots.data());
+
+    // Orthogonalize vector i with respect to previously
+    // orthonormalized vectors (classical Gram-Schmidt, fused AXPY over
+    // the basis block)
+    for (std::size_t j = 0; j < i; ++j)
+      dots[j] = -dots[j];
+    VecMAXPY(v[i], i, dots.data(), v.data());
+
+    // With v_0, ..., v_{i-1} orthonormal the norm of the
+    // orthogonalized vector follows from Pythagoras, so no second
+    // reduction is needed
+    double norm2 = PetscRealPart(dots[i]);
     for (std::size_t j = 0; j < i; ++j)
     {
-      PetscScalar dot_ij = 0.0;
-      VecDot(_basis[i]->vec(), _basis[j]->vec(), &dot_ij);
-      VecAXPY(_basis[i]->vec(), -dot_ij, _basis[j]->vec());
+      const double a = std::abs(dots[j]);
+      norm2 -= a * a;
     }
-
-    // Normalise basis function
-    PetscReal norm = 0.0;
-    VecNormalize(_basis[i]->vec(), &norm);
+    const double norm = std::sqrt(std::max(norm2, 0.0));
     if (norm < tol)
     {
       throw std::runtime_error(
           "VectorSpaceBasis has linear dependency. Cannot orthogonalize.");
     }
+    VecScale(v[i], 1.0 / norm);
   }
+
+  _orthonormal = true;
 }
 //-----------------------------------------------------------------------------
 bool VectorSpaceBasis::is_orthonormal(double tol) const
@@ -113,13 +143,23 @@ bool VectorSpaceBasis::in_nullspace(const Mat A, double tol) const
 //-----------------------------------------------------------------------------
 void VectorSpaceBasis::orthogonalize(PETScVector& x) const
 {
-  for (std::size_t i = 0; i < _basis.size(); i++)
+  if (_basis.empty())
+    return;
+
+  std::vector<Vec> v(_basis.size());
+  for (std::size_t i = 0; i < _basis.size(); ++i)
   {
     assert(_basis[i]);
-    PetscScalar dot = 0.0;
-    VecDot(_basis[i]->vec(), x.vec(), &dot);
-    VecAXPY(x.vec(), -dot, _basis[i]->vec());
+    v[i] = _basis[i]->vec();
   }
+
+  // Project on the whole basis with a single multi-vector dot product
+  // (one global reduction) and a fused AXPY over the basis block
+  std::vector<PetscScalar> dots(_basis.size());
+  VecMDot(x.vec(), _basis.size(), v.data(), dots.data());
+  for (PetscScalar& d : dots)
+    d = -d;
+  VecMAXPY(x.vec(), _basis.size(), dots.data(), v.data());
 }
 //-----------------------------------------------------------------------------
 int VectorSpaceBasis::dim() const { return _basis.size(); }
@@ -129,3 +169,85 @@ std::shared_ptr<const la::PETScVector> VectorSpaceBasis::operator[](int i) const
   return _basis.at(i);
 }
 //-----------------------------------------------------------------------------
+VectorSpaceBasis la::create_rigid_body_modes(
+    const common::IndexMap& map,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& x,
+    int gdim)
+{
+  if (gdim != 2 and gdim != 3)
+  {
+    throw std::runtime_error("Rigid body modes are only defined for "
+                             "geometric dimension 2 or 3.");
+  }
+
+  const int bs = map.block_size();
+  if (bs != gdim)
+  {
+    throw std::runtime_error("Rigid body modes require a blocked space with "
+                             "block size equal to the geometric dimension.");
+  }
+
+  const std::int32_t num_dofs
+      = bs * (map.size_local() + map.num_ghosts());
+  if (x.rows() != num_dofs)
+    throw std::runtime_error("Wrong number of dof coordinates.");
+
+  // 2 translations and 1 rotation in 2D, 3 translations and 3
+  // rotations in 3D
+  const int num_modes = (gdim == 2) ? 3 : 6;
+
+  std::vector<std::shared_ptr<PETScVector>> basis;
+  basis.reserve(num_modes);
+  for (int mode = 0; mode < num_modes; ++mode)
+  {
+    auto v = std::make_shared<PETScVector>(map);
+
+    // Fill owned and ghost entries alike from the dof coordinates;
+    // dof i belongs to component i % bs of the node at x.row(i)
+    Vec v_local = nullptr;
+    VecGhostGetLocalForm(v->vec(), &v_local);
+    PetscScalar* array = nullptr;
+    VecGetArray(v_local, &array);
+    for (std::int32_t i = 0; i < num_dofs; ++i)
+    {
+      const int c = i % bs;
+      double value = 0.0;
+      if (mode < gdim)
+      {
+        // Translation along axis 'mode'
+        value = (c == mode) ? 1.0 : 0.0;
+      }
+      else if (gdim == 2)
+      {
+        // Rotation in the plane: (-y, x)
+        value = (c == 0) ? -x(i, 1) : x(i, 0);
+      }
+      else if (mode == 3)
+      {
+        // Rotation about the z-axis: (-y, x, 0)
+        value = (c == 0) ? -x(i, 1) : (c == 1) ? x(i, 0) : 0.0;
+      }
+      else if (mode == 4)
+      {
+        // Rotation about the y-axis: (z, 0, -x)
+        value = (c == 0) ? x(i, 2) : (c == 2) ? -x(i, 0) : 0.0;
+      }
+      else
+      {
+        // Rotation about the x-axis: (0, -z, y)
+        value = (c == 1) ? -x(i, 2) : (c == 2) ? x(i, 1) : 0.0;
+      }
+      array[i] = value;
+    }
+    VecRestoreArray(v_local, &array);
+    VecGhostRestoreLocalForm(v->vec(), &v_local);
+
+    basis.push_back(v);
+  }
+
+  // Orthonormalization is deferred until the basis is attached to an
+  // operator
+  return VectorSpaceBasis(basis, false);
+}
+//-----------------------------------------------------------------------------
@@ -6,10 +6,19 @@
 
 #pragma once
 
+#include <Eigen/Dense>
 #include <memory>
 #include <petscmat.h>
 #include <vector>
 
+namespace dolfinx
+{
+namespace common
+{
+class IndexMap;
+}
+} // namespace dolfinx
+
 namespace dolfinx::la
 {
 class PETScVector;
@@ -22,7 +31,14 @@ class VectorSpaceBasis
 {
 public:
   /// Constructor
-  VectorSpaceBasis(const std::vector<std::shared_ptr<PETScVector>>& basis);
+  /// @param[in] basis The basis vectors
+  /// @param[in] orthonormal Pass false if the vectors are not yet
+  ///   orthonormal. Orthonormalization is then deferred until the
+  ///   basis is attached to an operator (see ensure_orthonormal), so
+  ///   bases that are built but never attached, e.g. during mesh
+  ///   adaptation, never pay the reductions.
+  VectorSpaceBasis(const std::vector<std::shared_ptr<PETScVector>>& basis,
+                   bool orthonormal = true);
 
   /// Delete copy constructor
   VectorSpaceBasis(const VectorSpaceBasis& basis) = delete;
@@ -33,11 +49,20 @@ public:
   /// Destructor
   ~VectorSpaceBasis() = default;
 
-  /// Apply the Gram-Schmidt process to orthonormalize the basis. Throws
-  /// an error if a (near) linear dependency is detected. Error is
-  /// thrown if <x_i, x_i> < tol.
+  /// Apply the (classical) Gram-Schmidt process to orthonormalize the
+  /// basis. The projection coefficients for each vector are computed
+  /// with a single multi-vector dot product, i.e. one global reduction
+  /// per basis vector. Throws an error if a (near) linear dependency is
+  /// detected. Error is thrown if <x_i, x_i> < tol.
   void orthonormalize(double tol = 1.0e-10);
 
+  /// Orthonormalize the basis if it has not been orthonormalized yet
+  /// (see the constructor). Called at attachment by
+  /// create_petsc_nullspace, so a basis built with deferred
+  /// orthonormalization is orthonormalized exactly once, at first
+  /// use; bases flagged orthonormal are left untouched.
+  void ensure_orthonormal(double tol = 1.0e-10) const;
+
   /// Test if basis is orthonormal
   bool is_orthonormal(double tol = 1.0e-10) const;
 
@@ -47,7 +72,8 @@ public:
   /// Test if basis is in null space of A
   bool in_nullspace(const Mat A, double tol = 1.0e-10) const;
 
-  /// Orthogonalize x with respect to basis
+  /// Orthogonalize x with respect to basis, using a single global
+  /// reduction for all projection coefficients
   void orthogonalize(PETScVector& x) const;
 
   /// Number of vectors in the basis
@@ -57,6 +83,35 @@ public:
   std::shared_ptr<const PETScVector> operator[](int i) const;
 
 private:
+  // Orthonormalize the basis vectors in place (classical
+  // Gram-Schmidt). Shared by orthonormalize() and
+  // ensure_orthonormal(); only the vectors (held by pointer) and the
+  // lazy flag are modified.
+  void do_orthonormalize(double tol) const;
+
   const std::vector<std::shared_ptr<PETScVector>> _basis;
+
+  // False while orthonormalization is deferred (see constructor)
+  mutable bool _orthonormal;
 };
+
+/// Build the rigid body modes of a vector-valued space for use as the
+/// near-nullspace of elasticity operators with smoothed aggregation
+/// multigrid. The modes (2 translations and 1 rotation in 2D, 3
+/// translations and 3 rotations in 3D) are filled directly from the
+/// dof coordinates in one pass - no interpolation machinery is
+/// involved - and the returned basis defers orthonormalization until
+/// it is attached to an operator.
+/// @param[in] map The dof index map of the space. The block size must
+///   equal the geometric dimension.
+/// @param[in] x The dof coordinates, one row per local dof (owned
+///   followed by ghost), as returned by
+///   function::FunctionSpace::tabulate_dof_coordinates
+/// @param[in] gdim The geometric dimension (2 or 3)
+/// @return Basis spanning the rigid body modes, not yet orthonormalized
+VectorSpaceBasis create_rigid_body_modes(
+    const common::IndexMap& map,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& x,
+    int gdim);
 } // namespace dolfinx::la
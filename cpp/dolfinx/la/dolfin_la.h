@@ -11,6 +11,9 @@ namespace dolfinx
 
 // DOLFINX la interface
 
+#include <dolfinx/la/CSRMatrix.h>
+#include <dolfinx/la/DenseBlockSolver.h>
+#include <dolfinx/la/Float32Vector.h>
 #include <dolfinx/la/PETScKrylovSolver.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScOperator.h>
@@ -18,4 +21,5 @@ namespace dolfinx
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/la/SLEPcEigenSolver.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/VectorPool.h>
 #include <dolfinx/la/VectorSpaceBasis.h>
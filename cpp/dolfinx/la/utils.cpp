@@ -7,7 +7,13 @@
 #include "utils.h"
 #include "PETScVector.h"
 #include "VectorSpaceBasis.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <dolfinx/common/Counters.h>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/SubSystemsManager.h>
 #include <dolfinx/common/log.h>
@@ -23,6 +29,182 @@
       petsc_error(ierr, __FILE__, NAME);                                       \
   } while (0)
 
+namespace
+{
+// Reduction for the packed statistics buffer used by
+// la::compute_statistics. Entries are laid out in groups of four per
+// vector as [sum of squares, linf, max, -min]: the first entry of each
+// group is summed, the rest are maximised. This lets one MPI_Allreduce
+// combine reductions that would otherwise need separate MPI_SUM,
+// MPI_MAX and MPI_MIN collectives.
+void statistics_reduction(void* in, void* inout, int* len, MPI_Datatype*)
+{
+  const PetscReal* a = static_cast<const PetscReal*>(in);
+  PetscReal* b = static_cast<PetscReal*>(inout);
+  for (int i = 0; i < *len; ++i)
+  {
+    if (i % 4 == 0)
+      b[i] += a[i];
+    else
+      b[i] = std::max(b[i], a[i]);
+  }
+}
+// Object state of each tracked Vec after its last forward ghost
+// update, keyed by the PETSc object id (ids are never reused, unlike
+// handles). Looked up by la::update_ghosts to prove freshness.
+std::map<PetscObjectId, PetscObjectState>& ghost_clean_states()
+{
+  static std::map<PetscObjectId, PetscObjectState> states;
+  return states;
+}
+
+// Whether each elide/perform decision should be logged (set the
+// environment variable DOLFINX_SCATTER_DEBUG)
+bool scatter_debug()
+{
+  static const bool debug = (std::getenv("DOLFINX_SCATTER_DEBUG") != nullptr);
+  return debug;
+}
+} // namespace
+//-----------------------------------------------------------------------------
+void dolfinx::la::update_ghosts(Vec x)
+{
+  assert(x);
+  PetscErrorCode ierr;
+
+  Vec xg;
+  ierr = VecGhostGetLocalForm(x, &xg);
+  CHECK_ERROR("VecGhostGetLocalForm");
+  const bool ghosted = (xg != nullptr);
+  ierr = VecGhostRestoreLocalForm(x, &xg);
+  CHECK_ERROR("VecGhostRestoreLocalForm");
+  if (!ghosted)
+    return;
+
+  static const int c_performed
+      = common::Counters::register_counter("Ghost updates performed");
+  static const int c_elided
+      = common::Counters::register_counter("Ghost updates elided");
+
+  PetscObjectId id;
+  ierr = PetscObjectGetId(reinterpret_cast<PetscObject>(x), &id);
+  CHECK_ERROR("PetscObjectGetId");
+  PetscObjectState state;
+  ierr = PetscObjectStateGet(reinterpret_cast<PetscObject>(x), &state);
+  CHECK_ERROR("PetscObjectStateGet");
+
+  // The vector is clean if its state matches the recorded state from
+  // the last forward update. All ranks must agree before eliding the
+  // scatter; the agreement is one small allreduce, much cheaper than
+  // the neighbourhood scatter it can save.
+  std::map<PetscObjectId, PetscObjectState>& states = ghost_clean_states();
+  const auto it = states.find(id);
+  int clean = (it != states.end() and it->second == state) ? 1 : 0;
+  MPI_Comm comm = MPI_COMM_NULL;
+  PetscObjectGetComm(reinterpret_cast<PetscObject>(x), &comm);
+  if (dolfinx::MPI::size(comm) > 1)
+    MPI_Allreduce(MPI_IN_PLACE, &clean, 1, MPI_INT, MPI_MIN, comm);
+
+  if (clean == 1)
+  {
+    common::Counters::add(c_elided, 1);
+    if (scatter_debug())
+      LOG(INFO) << "Ghost update elided (vector unchanged on all ranks)";
+    return;
+  }
+
+  ierr = VecGhostUpdateBegin(x, INSERT_VALUES, SCATTER_FORWARD);
+  CHECK_ERROR("VecGhostUpdateBegin");
+  ierr = VecGhostUpdateEnd(x, INSERT_VALUES, SCATTER_FORWARD);
+  CHECK_ERROR("VecGhostUpdateEnd");
+  common::Counters::add(c_performed, 1);
+  if (scatter_debug())
+  {
+    LOG(INFO) << "Ghost update performed"
+              << (it != states.end() and it->second != state
+                      ? " (vector modified since last update)"
+                      : "");
+  }
+
+  // The update itself bumps the state; record the post-update state as
+  // the clean one
+  ierr = PetscObjectStateGet(reinterpret_cast<PetscObject>(x), &state);
+  CHECK_ERROR("PetscObjectStateGet");
+  states[id] = state;
+}
+//-----------------------------------------------------------------------------
+void dolfinx::la::mark_ghosts_stale(Vec x)
+{
+  assert(x);
+  PetscObjectId id;
+  const PetscErrorCode ierr
+      = PetscObjectGetId(reinterpret_cast<PetscObject>(x), &id);
+  CHECK_ERROR("PetscObjectGetId");
+  ghost_clean_states().erase(id);
+}
+//-----------------------------------------------------------------------------
+std::vector<dolfinx::la::VecStatistics>
+dolfinx::la::compute_statistics(const std::vector<Vec>& x)
+{
+  if (x.empty())
+    return {};
+
+  PetscErrorCode ierr;
+
+  // Compute local statistics over the owned entries of each vector,
+  // packed as [sum of squares, linf, max, -min] so a single custom
+  // reduction can combine them
+  std::vector<PetscReal> buffer(4 * x.size());
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    assert(x[i]);
+    PetscInt n = 0;
+    ierr = VecGetLocalSize(x[i], &n);
+    CHECK_ERROR("VecGetLocalSize");
+    const PetscScalar* array = nullptr;
+    ierr = VecGetArrayRead(x[i], &array);
+    CHECK_ERROR("VecGetArrayRead");
+
+    PetscReal sum2 = 0.0, linf = 0.0;
+    PetscReal max = -PETSC_MAX_REAL, min = PETSC_MAX_REAL;
+    for (PetscInt j = 0; j < n; ++j)
+    {
+      const PetscReal abs = PetscAbsScalar(array[j]);
+      const PetscReal re = PetscRealPart(array[j]);
+      sum2 += abs * abs;
+      linf = std::max(linf, abs);
+      max = std::max(max, re);
+      min = std::min(min, re);
+    }
+    ierr = VecRestoreArrayRead(x[i], &array);
+    CHECK_ERROR("VecRestoreArrayRead");
+
+    buffer[4 * i] = sum2;
+    buffer[4 * i + 1] = linf;
+    buffer[4 * i + 2] = max;
+    buffer[4 * i + 3] = -min;
+  }
+
+  // Combine across processes with one collective
+  MPI_Comm comm = MPI_COMM_NULL;
+  PetscObjectGetComm(reinterpret_cast<PetscObject>(x[0]), &comm);
+  MPI_Op op;
+  MPI_Op_create(statistics_reduction, 1, &op);
+  MPI_Allreduce(MPI_IN_PLACE, buffer.data(), buffer.size(), MPIU_REAL, op,
+                comm);
+  MPI_Op_free(&op);
+
+  std::vector<VecStatistics> stats(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    stats[i].l2 = std::sqrt(buffer[4 * i]);
+    stats[i].linf = buffer[4 * i + 1];
+    stats[i].max = buffer[4 * i + 2];
+    stats[i].min = -buffer[4 * i + 3];
+  }
+
+  return stats;
+}
 //-----------------------------------------------------------------------------
 Vec dolfinx::la::create_petsc_vector(const dolfinx::common::IndexMap& map)
 {
@@ -175,6 +357,10 @@ MatNullSpace dolfinx::la::create_petsc_nullspace(
 {
   PetscErrorCode ierr;
 
+  // Orthonormalize bases built with deferred orthonormalization (e.g.
+  // rigid body modes); bases flagged orthonormal are left untouched
+  nullspace.ensure_orthonormal();
+
   // Copy vectors in vector space object
   std::vector<Vec> _nullspace;
   for (int i = 0; i < nullspace.dim(); ++i)
@@ -363,6 +549,198 @@ void dolfinx::la::VecReadWrapper::restore()
       Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>(nullptr, 0);
 }
 //-----------------------------------------------------------------------------
+dolfinx::la::ScatterBatch::ScatterBatch(const common::IndexMap& map,
+                                        int num_vectors)
+    : _bs(map.block_size()), _num_vectors(num_vectors),
+      _local_size(map.size_local())
+{
+  if (num_vectors < 1)
+    throw std::runtime_error("Batch must hold at least one vector.");
+
+  const std::vector<std::int32_t>& neighbours = map.neighbours();
+  const int num_neighbours = neighbours.size();
+  MPI_Dist_graph_create_adjacent(
+      map.mpi_comm(), num_neighbours, neighbours.data(), MPI_UNWEIGHTED,
+      num_neighbours, neighbours.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+      &_comm);
+
+  // Group ghosts by owning neighbour. The resulting order (per
+  // neighbour, in ghost order) is the order in which ghost values
+  // arrive in the receive buffer.
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& ghost_owners
+      = map.ghost_owners();
+  std::vector<int> owner_pos(ghost_owners.size());
+  _recv_sizes.assign(num_neighbours, 0);
+  for (Eigen::Index i = 0; i < ghost_owners.size(); ++i)
+  {
+    const auto it
+        = std::find(neighbours.begin(), neighbours.end(), ghost_owners[i]);
+    assert(it != neighbours.end());
+    owner_pos[i] = std::distance(neighbours.begin(), it);
+    _recv_sizes[owner_pos[i]] += 1;
+  }
+  _recv_disp.assign(num_neighbours + 1, 0);
+  std::partial_sum(_recv_sizes.begin(), _recv_sizes.end(),
+                   _recv_disp.begin() + 1);
+  _ghost_pos.resize(ghost_owners.size());
+  std::vector<int> disp(_recv_disp.begin(), _recv_disp.end() - 1);
+  for (Eigen::Index i = 0; i < ghost_owners.size(); ++i)
+    _ghost_pos[disp[owner_pos[i]]++] = i;
+
+  // Tell each neighbour how many of its owned indices this process
+  // ghosts; the replies are the per-neighbour send sizes. The owned
+  // indices themselves are map.forward_indices(), grouped by neighbour
+  // in the same order.
+  _send_sizes.resize(num_neighbours);
+  MPI_Neighbor_alltoall(_recv_sizes.data(), 1, MPI_INT, _send_sizes.data(), 1,
+                        MPI_INT, _comm);
+  _send_disp.assign(num_neighbours + 1, 0);
+  std::partial_sum(_send_sizes.begin(), _send_sizes.end(),
+                   _send_disp.begin() + 1);
+  _shared_indices = map.forward_indices();
+  assert((int)_shared_indices.size() == _send_disp.back());
+
+  // Allocate the staging buffers and create the persistent requests.
+  // The buffers hold num_vectors values per index, so one message per
+  // neighbour carries the update for the whole batch.
+  const int nv = _num_vectors * _bs;
+  _send_buffer.resize(nv * _send_disp.back());
+  _recv_buffer.resize(nv * _recv_disp.back());
+  _fwd_requests.resize(2 * num_neighbours);
+  _rev_requests.resize(2 * num_neighbours);
+  for (int n = 0; n < num_neighbours; ++n)
+  {
+    // Forward: owned values out, ghost values in
+    MPI_Send_init(_send_buffer.data() + nv * _send_disp[n],
+                  nv * _send_sizes[n], dolfinx::MPI::mpi_type<PetscScalar>(),
+                  neighbours[n], 0, _comm, &_fwd_requests[2 * n]);
+    MPI_Recv_init(_recv_buffer.data() + nv * _recv_disp[n],
+                  nv * _recv_sizes[n], dolfinx::MPI::mpi_type<PetscScalar>(),
+                  neighbours[n], 0, _comm, &_fwd_requests[2 * n + 1]);
+
+    // Reverse: ghost values out, owned contributions in
+    MPI_Send_init(_recv_buffer.data() + nv * _recv_disp[n],
+                  nv * _recv_sizes[n], dolfinx::MPI::mpi_type<PetscScalar>(),
+                  neighbours[n], 1, _comm, &_rev_requests[2 * n]);
+    MPI_Recv_init(_send_buffer.data() + nv * _send_disp[n],
+                  nv * _send_sizes[n], dolfinx::MPI::mpi_type<PetscScalar>(),
+                  neighbours[n], 1, _comm, &_rev_requests[2 * n + 1]);
+  }
+}
+//-----------------------------------------------------------------------------
+dolfinx::la::ScatterBatch::~ScatterBatch()
+{
+  for (MPI_Request& request : _fwd_requests)
+    MPI_Request_free(&request);
+  for (MPI_Request& request : _rev_requests)
+    MPI_Request_free(&request);
+  if (_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&_comm);
+}
+//-----------------------------------------------------------------------------
+void dolfinx::la::ScatterBatch::update_ghosts(const std::vector<Vec>& x)
+{
+  if ((int)x.size() != _num_vectors)
+    throw std::runtime_error("Wrong number of vectors for scatter batch.");
+
+  std::vector<VecWrapper> w;
+  w.reserve(x.size());
+  for (Vec y : x)
+    w.emplace_back(y);
+
+  // Pack owned values shared with each neighbour, all vectors of the
+  // batch in one segment per neighbour
+  const int num_neighbours = _send_sizes.size();
+  for (int n = 0; n < num_neighbours; ++n)
+  {
+    PetscScalar* buffer
+        = _send_buffer.data() + _num_vectors * _bs * _send_disp[n];
+    for (int v = 0; v < _num_vectors; ++v)
+    {
+      for (int k = 0; k < _send_sizes[n]; ++k)
+      {
+        const std::int32_t index = _shared_indices[_send_disp[n] + k];
+        for (int b = 0; b < _bs; ++b)
+          *buffer++ = w[v].x[_bs * index + b];
+      }
+    }
+  }
+
+  MPI_Startall(_fwd_requests.size(), _fwd_requests.data());
+  MPI_Waitall(_fwd_requests.size(), _fwd_requests.data(),
+              MPI_STATUSES_IGNORE);
+
+  // Unpack received values into the ghost entries
+  for (int n = 0; n < num_neighbours; ++n)
+  {
+    const PetscScalar* buffer
+        = _recv_buffer.data() + _num_vectors * _bs * _recv_disp[n];
+    for (int v = 0; v < _num_vectors; ++v)
+    {
+      for (int k = 0; k < _recv_sizes[n]; ++k)
+      {
+        const std::int32_t pos = _local_size + _ghost_pos[_recv_disp[n] + k];
+        for (int b = 0; b < _bs; ++b)
+          w[v].x[_bs * pos + b] = *buffer++;
+      }
+    }
+  }
+
+  for (VecWrapper& wrapper : w)
+    wrapper.restore();
+}
+//-----------------------------------------------------------------------------
+void dolfinx::la::ScatterBatch::apply_ghosts(const std::vector<Vec>& x)
+{
+  if ((int)x.size() != _num_vectors)
+    throw std::runtime_error("Wrong number of vectors for scatter batch.");
+
+  std::vector<VecWrapper> w;
+  w.reserve(x.size());
+  for (Vec y : x)
+    w.emplace_back(y);
+
+  // Pack ghost values, addressed to the owning neighbour
+  const int num_neighbours = _send_sizes.size();
+  for (int n = 0; n < num_neighbours; ++n)
+  {
+    PetscScalar* buffer
+        = _recv_buffer.data() + _num_vectors * _bs * _recv_disp[n];
+    for (int v = 0; v < _num_vectors; ++v)
+    {
+      for (int k = 0; k < _recv_sizes[n]; ++k)
+      {
+        const std::int32_t pos = _local_size + _ghost_pos[_recv_disp[n] + k];
+        for (int b = 0; b < _bs; ++b)
+          *buffer++ = w[v].x[_bs * pos + b];
+      }
+    }
+  }
+
+  MPI_Startall(_rev_requests.size(), _rev_requests.data());
+  MPI_Waitall(_rev_requests.size(), _rev_requests.data(),
+              MPI_STATUSES_IGNORE);
+
+  // Accumulate received contributions into the owned entries
+  for (int n = 0; n < num_neighbours; ++n)
+  {
+    const PetscScalar* buffer
+        = _send_buffer.data() + _num_vectors * _bs * _send_disp[n];
+    for (int v = 0; v < _num_vectors; ++v)
+    {
+      for (int k = 0; k < _send_sizes[n]; ++k)
+      {
+        const std::int32_t index = _shared_indices[_send_disp[n] + k];
+        for (int b = 0; b < _bs; ++b)
+          w[v].x[_bs * index + b] += *buffer++;
+      }
+    }
+  }
+
+  for (VecWrapper& wrapper : w)
+    wrapper.restore();
+}
+//-----------------------------------------------------------------------------
 // Mat dolfinx::la::get_local_submatrix(const Mat A, const IS row, const IS
 // col);
 
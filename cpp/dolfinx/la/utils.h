@@ -39,6 +39,31 @@ enum class Norm
   frobenius
 };
 
+/// Statistics for a single vector, as computed by
+/// la::compute_statistics. Minimum and maximum are over the real part
+/// of the owned entries.
+struct VecStatistics
+{
+  /// l2 norm
+  PetscReal l2;
+  /// linf norm
+  PetscReal linf;
+  /// Minimum entry (real part)
+  PetscReal min;
+  /// Maximum entry (real part)
+  PetscReal max;
+};
+
+/// Compute the l2 norm, linf norm, minimum and maximum of each vector
+/// in a batch using a single MPI_Allreduce. Equivalent to calling
+/// VecNorm/VecMin/VecMax on each vector, but with one collective
+/// instead of four per vector, which matters for latency-bound
+/// diagnostics on large communicators. Ghost entries are not included.
+/// @param[in] x The vectors. All must be defined on the same
+///              communicator.
+/// @return Statistics for each vector, in the order of @p x
+std::vector<VecStatistics> compute_statistics(const std::vector<Vec>& x);
+
 /// Create a ghosted PETSc Vec. Caller is responsible for destroying the
 /// returned object.
 Vec create_petsc_vector(const common::IndexMap& map);
@@ -126,6 +151,96 @@ private:
   bool _ghosted;
 };
 
+/// Update the ghost values of a ghosted PETSc Vec from the owning
+/// processes, skipping the communication when the vector has not been
+/// modified since its last forward update. Freshness is tracked
+/// through the PETSc object state counter, which PETSc increments on
+/// every modifying access, so "to be safe" updates in step loops
+/// become cheap no-ops when the data is provably unchanged. The check
+/// is collective (one small allreduce so all ranks agree on eliding),
+/// far cheaper than the neighbourhood scatter it replaces. Performed
+/// and elided updates are tallied in the counters registry ("Ghost
+/// updates performed" / "Ghost updates elided"); set the environment
+/// variable DOLFINX_SCATTER_DEBUG to additionally log each decision.
+/// Non-ghosted vectors are ignored.
+/// @param[in,out] x The vector to update
+void update_ghosts(Vec x);
+
+/// Drop the tracked ghost state of a Vec so the next
+/// la::update_ghosts call performs the communication unconditionally,
+/// e.g. after modifying the vector through an interface the PETSc
+/// object state does not cover. Also call this before destroying a
+/// Vec whose ghost state was tracked, so the table entry is released.
+/// @param[in] x The vector whose state to drop
+void mark_ghosts_stale(Vec x);
+
+/// Batched ghost update for ghosted PETSc vectors that share an
+/// IndexMap. A separate VecGhostUpdateBegin/End per vector sends one
+/// (typically small, latency-bound) message per neighbour per vector;
+/// this class fuses the updates of a fixed-size batch of vectors into a
+/// single message per neighbour, sent through persistent MPI requests
+/// set up once at construction. Intended for e.g. Newton loops that
+/// update several vectors back to back with identical communication
+/// patterns. The batch size is fixed at construction and every update
+/// must pass exactly that many vectors, each created from the same
+/// IndexMap (see la::create_petsc_vector).
+class ScatterBatch
+{
+public:
+  /// Set up the communication pattern and persistent requests
+  /// @param[in] map Index map shared by all vectors in the batch
+  /// @param[in] num_vectors Number of vectors updated per call
+  ScatterBatch(const common::IndexMap& map, int num_vectors);
+  ScatterBatch(const ScatterBatch& batch) = delete;
+  ScatterBatch& operator=(const ScatterBatch& batch) = delete;
+  ~ScatterBatch();
+
+  /// Update the ghost entries of each vector with the value from the
+  /// owning process (equivalent to VecGhostUpdateBegin/End with
+  /// INSERT_VALUES, SCATTER_FORWARD on each vector)
+  /// @param[in,out] x The vectors to update. Must contain exactly the
+  ///                  number of vectors the batch was created for.
+  void update_ghosts(const std::vector<Vec>& x);
+
+  /// Accumulate the ghost entries of each vector into the owned entry
+  /// on the owning process (equivalent to VecGhostUpdateBegin/End with
+  /// ADD_VALUES, SCATTER_REVERSE on each vector). Ghost entries are
+  /// not modified.
+  /// @param[in,out] x The vectors to update. Must contain exactly the
+  ///                  number of vectors the batch was created for.
+  void apply_ghosts(const std::vector<Vec>& x);
+
+private:
+  // Block size of the index map
+  int _bs;
+
+  // Number of vectors per batch
+  int _num_vectors;
+
+  // Number of owned blocks
+  std::int32_t _local_size;
+
+  // Neighbourhood communicator (point-to-point, ranks preserved)
+  MPI_Comm _comm = MPI_COMM_NULL;
+
+  // Owned block indices ghosted on other processes, grouped by
+  // neighbour, with per-neighbour sizes/displacements (block units)
+  std::vector<std::int32_t> _shared_indices;
+  std::vector<int> _send_sizes, _send_disp;
+
+  // Ghost block position for each received slot, grouped by owning
+  // neighbour, with per-neighbour sizes/displacements (block units)
+  std::vector<std::int32_t> _ghost_pos;
+  std::vector<int> _recv_sizes, _recv_disp;
+
+  // Staging buffers backing the persistent requests
+  std::vector<PetscScalar> _send_buffer, _recv_buffer;
+
+  // Persistent requests for the forward (owner to ghost) and reverse
+  // (ghost to owner) exchanges
+  std::vector<MPI_Request> _fwd_requests, _rev_requests;
+};
+
 // /// Get sub-matrix. Sub-matrix is local to the process
 // Mat get_local_submatrix(const Mat A, const IS row, const IS col);
 
@@ -0,0 +1,215 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "EntitySet.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace dolfinx;
+using namespace dolfinx::mesh;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Merged scans over two sorted unique ranges. The loops advance both
+// cursors with comparison results instead of per-element branching, so
+// they run close to memory speed on the long runs typical of facet
+// sets.
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> merge_union(const std::vector<std::int32_t>& a,
+                                      const std::vector<std::int32_t>& b)
+{
+  std::vector<std::int32_t> out;
+  out.reserve(a.size() + b.size());
+  std::size_t i = 0, j = 0;
+  while (i < a.size() and j < b.size())
+  {
+    const std::int32_t x = a[i], y = b[j];
+    out.push_back(x <= y ? x : y);
+    i += (x <= y);
+    j += (y <= x);
+  }
+  out.insert(out.end(), a.begin() + i, a.end());
+  out.insert(out.end(), b.begin() + j, b.end());
+  return out;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> merge_intersect(const std::vector<std::int32_t>& a,
+                                          const std::vector<std::int32_t>& b)
+{
+  std::vector<std::int32_t> out;
+  out.reserve(std::min(a.size(), b.size()));
+  std::size_t i = 0, j = 0;
+  while (i < a.size() and j < b.size())
+  {
+    const std::int32_t x = a[i], y = b[j];
+    if (x == y)
+      out.push_back(x);
+    i += (x <= y);
+    j += (y <= x);
+  }
+  return out;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> merge_subtract(const std::vector<std::int32_t>& a,
+                                         const std::vector<std::int32_t>& b)
+{
+  std::vector<std::int32_t> out;
+  out.reserve(a.size());
+  std::size_t i = 0, j = 0;
+  while (i < a.size() and j < b.size())
+  {
+    const std::int32_t x = a[i], y = b[j];
+    if (x < y)
+      out.push_back(x);
+    i += (x <= y);
+    j += (y <= x);
+  }
+  out.insert(out.end(), a.begin() + i, a.end());
+  return out;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+// Expression tree node. Composite nodes evaluate lazily into a cache
+// shared by all sets holding the node, so an expression used by
+// several composites is computed once.
+struct EntitySet::Node
+{
+  enum class Op
+  {
+    leaf_view,
+    leaf_owned,
+    set_union,
+    set_intersect,
+    set_subtract
+  };
+
+  Op op;
+
+  // Referenced array (leaf_view)
+  const std::vector<std::int32_t>* view = nullptr;
+
+  // Owned array (leaf_owned)
+  std::vector<std::int32_t> owned;
+
+  // Operands (composites)
+  std::shared_ptr<const Node> left, right;
+
+  // Lazily filled result of a composite
+  mutable std::vector<std::int32_t> cache;
+  mutable bool evaluated = false;
+
+  const std::vector<std::int32_t>& eval() const
+  {
+    switch (op)
+    {
+    case Op::leaf_view:
+      return *view;
+    case Op::leaf_owned:
+      return owned;
+    default:
+      if (!evaluated)
+      {
+        assert(left);
+        assert(right);
+        const std::vector<std::int32_t>& a = left->eval();
+        const std::vector<std::int32_t>& b = right->eval();
+        if (op == Op::set_union)
+          cache = merge_union(a, b);
+        else if (op == Op::set_intersect)
+          cache = merge_intersect(a, b);
+        else
+          cache = merge_subtract(a, b);
+        evaluated = true;
+      }
+      return cache;
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+EntitySet::EntitySet(const std::vector<std::int32_t>& indices)
+{
+  assert(std::is_sorted(indices.begin(), indices.end()));
+  auto node = std::make_shared<Node>();
+  node->op = Node::Op::leaf_view;
+  node->view = &indices;
+  _node = node;
+}
+//-----------------------------------------------------------------------------
+EntitySet::EntitySet(std::vector<std::int32_t>&& indices)
+{
+  auto node = std::make_shared<Node>();
+  node->op = Node::Op::leaf_owned;
+  node->owned = std::move(indices);
+  if (!std::is_sorted(node->owned.begin(), node->owned.end()))
+    std::sort(node->owned.begin(), node->owned.end());
+  node->owned.erase(std::unique(node->owned.begin(), node->owned.end()),
+                    node->owned.end());
+  _node = node;
+}
+//-----------------------------------------------------------------------------
+EntitySet::EntitySet(
+    const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& indices)
+    : EntitySet(std::vector<std::int32_t>(indices.data(),
+                                          indices.data() + indices.rows()))
+{
+  // Owning leaf over a copy of the array
+}
+//-----------------------------------------------------------------------------
+EntitySet::EntitySet(std::shared_ptr<const Node> node) : _node(std::move(node))
+{
+  // Expression node (internal)
+}
+//-----------------------------------------------------------------------------
+EntitySet::~EntitySet() = default;
+//-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& EntitySet::indices() const
+{
+  assert(_node);
+  return _node->eval();
+}
+//-----------------------------------------------------------------------------
+std::size_t EntitySet::size() const { return indices().size(); }
+//-----------------------------------------------------------------------------
+bool EntitySet::contains(std::int32_t entity) const
+{
+  const std::vector<std::int32_t>& idx = indices();
+  return std::binary_search(idx.begin(), idx.end(), entity);
+}
+//-----------------------------------------------------------------------------
+namespace dolfinx::mesh
+{
+//-----------------------------------------------------------------------------
+EntitySet operator|(const EntitySet& a, const EntitySet& b)
+{
+  auto node = std::make_shared<EntitySet::Node>();
+  node->op = EntitySet::Node::Op::set_union;
+  node->left = a._node;
+  node->right = b._node;
+  return EntitySet(std::move(node));
+}
+//-----------------------------------------------------------------------------
+EntitySet operator&(const EntitySet& a, const EntitySet& b)
+{
+  auto node = std::make_shared<EntitySet::Node>();
+  node->op = EntitySet::Node::Op::set_intersect;
+  node->left = a._node;
+  node->right = b._node;
+  return EntitySet(std::move(node));
+}
+//-----------------------------------------------------------------------------
+EntitySet operator-(const EntitySet& a, const EntitySet& b)
+{
+  auto node = std::make_shared<EntitySet::Node>();
+  node->op = EntitySet::Node::Op::set_subtract;
+  node->left = a._node;
+  node->right = b._node;
+  return EntitySet(std::move(node));
+}
+//-----------------------------------------------------------------------------
+} // namespace dolfinx::mesh
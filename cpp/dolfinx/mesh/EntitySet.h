@@ -0,0 +1,120 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+
+template <typename T>
+class MeshTags;
+
+/// Set algebra over sorted entity index arrays, e.g. the tagged
+/// entities of a MeshTags object. An EntitySet is a lazy expression:
+/// composing sets with |, & and - builds an expression tree and does
+/// no work; the entity indices are computed on first access with
+/// pairwise merged scans over the sorted operands and cached in the
+/// expression node, so re-reading a composite set is free and
+/// rebuilding boundary definitions every adaptation costs linear
+/// merges instead of materialized intermediate copies for unevaluated
+/// branches.
+///
+/// Leaves either reference an existing index array without copying
+/// (the array must outlive the set and every set composed from it) or
+/// own their indices. All arrays are sorted and unique, which the
+/// MeshTags invariant already guarantees for its indices.
+///
+/// Usage:
+///
+///   mesh::EntitySet walls(tags.find(1));
+///   mesh::EntitySet inlet(tags.find(2));
+///   mesh::EntitySet outer = (walls | inlet) - corners;
+///   ... outer.indices() ...
+
+class EntitySet
+{
+public:
+  /// Create a leaf referencing a sorted, unique index array. No copy
+  /// is made; the array must outlive the set and every expression
+  /// composed from it.
+  /// @param[in] indices Sorted unique entity indices (local)
+  explicit EntitySet(const std::vector<std::int32_t>& indices);
+
+  /// Create a leaf owning an index array. The indices are sorted and
+  /// de-duplicated if required.
+  /// @param[in] indices Entity indices (local)
+  explicit EntitySet(std::vector<std::int32_t>&& indices);
+
+  /// Create a leaf owning a copy of an index array, e.g. the entities
+  /// of one tag value from MeshTags::find. The indices are sorted and
+  /// de-duplicated if required.
+  /// @param[in] indices Entity indices (local)
+  explicit EntitySet(
+      const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& indices);
+
+  /// Create a leaf referencing the tagged entities of a MeshTags
+  /// object (all values). No copy is made; the tags must outlive the
+  /// set and every expression composed from it.
+  /// @param[in] tags The tags whose entities form the set
+  template <typename T>
+  explicit EntitySet(const MeshTags<T>& tags) : EntitySet(tags.indices())
+  {
+    // Leaf over the (sorted, unique) tagged indices
+  }
+
+  /// Copy constructor (shares the expression tree and its caches)
+  EntitySet(const EntitySet& set) = default;
+
+  /// Move constructor
+  EntitySet(EntitySet&& set) = default;
+
+  /// Destructor
+  ~EntitySet();
+
+  /// Copy assignment
+  EntitySet& operator=(const EntitySet& set) = default;
+
+  /// Move assignment
+  EntitySet& operator=(EntitySet&& set) = default;
+
+  /// The entity indices of the set, sorted and unique. Evaluates the
+  /// expression on first call and caches the result.
+  const std::vector<std::int32_t>& indices() const;
+
+  /// Number of entities in the set (evaluates the expression)
+  std::size_t size() const;
+
+  /// Check set membership by binary search (evaluates the expression)
+  /// @param[in] entity The local entity index
+  bool contains(std::int32_t entity) const;
+
+  /// Set union
+  friend EntitySet operator|(const EntitySet& a, const EntitySet& b);
+
+  /// Set intersection
+  friend EntitySet operator&(const EntitySet& a, const EntitySet& b);
+
+  /// Set difference (entities of @p a not in @p b)
+  friend EntitySet operator-(const EntitySet& a, const EntitySet& b);
+
+private:
+  struct Node;
+  explicit EntitySet(std::shared_ptr<const Node> node);
+
+  // Root of the expression tree
+  std::shared_ptr<const Node> _node;
+};
+
+EntitySet operator|(const EntitySet& a, const EntitySet& b);
+EntitySet operator&(const EntitySet& a, const EntitySet& b);
+EntitySet operator-(const EntitySet& a, const EntitySet& b);
+
+} // namespace dolfinx::mesh
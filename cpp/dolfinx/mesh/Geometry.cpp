@@ -12,10 +12,39 @@
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/graph/Partitioning.h>
 #include <sstream>
+#include <type_traits>
 
 using namespace dolfinx;
 using namespace dolfinx::mesh;
 
+//-----------------------------------------------------------------------------
+Geometry::Geometry(const Geometry& parent,
+                   graph::AdjacencyList<std::int32_t> dofmap)
+    : _dim(parent._dim), _dofmap(std::move(dofmap)),
+      _index_map(parent._index_map), _cmap(parent._cmap), _x(parent._x),
+      _input_global_indices(parent._input_global_indices),
+      _version(parent._version)
+{
+  // Only the dofmap is owned; the shared coordinate storage is
+  // reported by the geometry that created it
+  _mem_usage.update(sizeof(std::int32_t)
+                    * (_dofmap.array().rows() + _dofmap.offsets().rows()));
+}
+//-----------------------------------------------------------------------------
+Geometry::Geometry(const Geometry& geometry)
+    : _dim(geometry._dim), _dofmap(geometry._dofmap),
+      _index_map(geometry._index_map), _cmap(geometry._cmap),
+      _x(std::make_shared<
+          Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>(
+          *geometry._x)),
+      _input_global_indices(geometry._input_global_indices),
+      _version(std::make_shared<std::size_t>(*geometry._version))
+{
+  _mem_usage.update(sizeof(double) * _x->size()
+                    + sizeof(std::int32_t)
+                          * (_dofmap.array().rows() + _dofmap.offsets().rows())
+                    + sizeof(std::int64_t) * _input_global_indices->size());
+}
 //-----------------------------------------------------------------------------
 int Geometry::dim() const { return _dim; }
 //-----------------------------------------------------------------------------
@@ -31,25 +60,72 @@ std::shared_ptr<const common::IndexMap> Geometry::index_map() const
 //-----------------------------------------------------------------------------
 Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& Geometry::x()
 {
-  return _x;
+  ++(*_version);
+  return *_x;
 }
 //-----------------------------------------------------------------------------
 const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
 Geometry::x() const
 {
-  return _x;
+  return *_x;
 }
 //-----------------------------------------------------------------------------
+std::size_t Geometry::version() const { return *_version; }
+//-----------------------------------------------------------------------------
 const fem::CoordinateElement& Geometry::cmap() const { return _cmap; }
 //-----------------------------------------------------------------------------
 Eigen::Vector3d Geometry::node(int n) const
 {
-  return _x.row(n).matrix().transpose();
+  return _x->row(n).matrix().transpose();
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T>& Geometry::packed_x(CoordinateLayout layout) const
+{
+  auto& caches = [this]() -> auto& {
+    if constexpr (std::is_same<T, double>::value)
+      return _packed_x64;
+    else
+      return _packed_x32;
+  }();
+  auto& [buffer, built_version] = caches[static_cast<int>(layout)];
+  if (built_version == *_version)
+    return buffer;
+
+  const Eigen::Index num_nodes = _x->rows();
+  buffer.resize(3 * num_nodes);
+  if (layout == CoordinateLayout::interleaved)
+  {
+    for (Eigen::Index i = 0; i < num_nodes; ++i)
+      for (int d = 0; d < 3; ++d)
+        buffer[3 * i + d] = static_cast<T>((*_x)(i, d));
+  }
+  else
+  {
+    for (int d = 0; d < 3; ++d)
+      for (Eigen::Index i = 0; i < num_nodes; ++i)
+        buffer[d * num_nodes + i] = static_cast<T>((*_x)(i, d));
+  }
+  built_version = *_version;
+
+  std::size_t packed_bytes = 0;
+  for (const auto& c : _packed_x64)
+    packed_bytes += sizeof(double) * c.first.size();
+  for (const auto& c : _packed_x32)
+    packed_bytes += sizeof(float) * c.first.size();
+  _packed_mem_usage.update(packed_bytes);
+
+  return buffer;
 }
 //-----------------------------------------------------------------------------
+template const std::vector<double>&
+Geometry::packed_x<double>(CoordinateLayout) const;
+template const std::vector<float>&
+Geometry::packed_x<float>(CoordinateLayout) const;
+//-----------------------------------------------------------------------------
 const std::vector<std::int64_t>& Geometry::input_global_indices() const
 {
-  return _input_global_indices;
+  return *_input_global_indices;
 }
 //-----------------------------------------------------------------------------
 std::size_t Geometry::hash() const
@@ -57,7 +133,7 @@ std::size_t Geometry::hash() const
   // Compute local hash
   boost::hash<std::vector<double>> dhash;
 
-  std::vector<double> data(_x.data(), _x.data() + _x.size());
+  std::vector<double> data(_x->data(), _x->data() + _x->size());
   const std::size_t local_hash = dhash(data);
   return local_hash;
 }
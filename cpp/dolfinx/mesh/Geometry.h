@@ -7,11 +7,15 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <array>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MemoryRegistry.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dolfinx
@@ -30,6 +34,13 @@ namespace mesh
 {
 class Topology;
 
+/// Storage layout for packed coordinate buffers
+enum class CoordinateLayout : int
+{
+  interleaved = 0, ///< xyz per node (array-of-structures)
+  split = 1        ///< all x, then all y, then all z (structure-of-arrays)
+};
+
 /// Geometry stores the geometry imposed on a mesh.
 ///
 /// Currently, the geometry is represented by the set of coordinates for
@@ -47,24 +58,48 @@ public:
            Vector64&& input_global_indices)
       : _dim(x.cols()), _dofmap(std::forward<AdjacencyList32>(dofmap)),
         _index_map(index_map), _cmap(element),
-        _input_global_indices(std::forward<Vector64>(input_global_indices))
+        _x(std::make_shared<
+            Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>()),
+        _input_global_indices(std::make_shared<const std::vector<std::int64_t>>(
+            std::forward<Vector64>(input_global_indices))),
+        _version(std::make_shared<std::size_t>(0))
   {
-    if (x.rows() != (int)_input_global_indices.size())
+    if (x.rows() != (int)_input_global_indices->size())
       throw std::runtime_error("Size mis-match");
 
     // Make all geometry 3D
     if (_dim == 3)
-      _x = x;
+      *_x = x;
     else if (_dim != 3)
     {
-      _x.resize(x.rows(), 3);
-      _x.setZero();
-      _x.block(0, 0, x.rows(), x.cols()) = x;
+      _x->resize(x.rows(), 3);
+      _x->setZero();
+      _x->block(0, 0, x.rows(), x.cols()) = x;
     }
+
+    _mem_usage.update(
+        sizeof(double) * _x->size()
+        + sizeof(std::int32_t)
+              * (_dofmap.array().rows() + _dofmap.offsets().rows())
+        + sizeof(std::int64_t) * _input_global_indices->size());
   }
 
-  /// Copy constructor
-  Geometry(const Geometry&) = default;
+  /// Create a geometry viewing the coordinate storage of another
+  /// geometry. No coordinates are copied: the new geometry shares the
+  /// node array, index map, coordinate element and input indices of @p
+  /// parent, and only the cell dofmap is its own, so it can address a
+  /// subset of the cells (e.g. a submesh) with entries indexing into
+  /// the shared node array. Coordinate updates through either geometry
+  /// are seen by both, and the coordinate version counter is shared so
+  /// caches of derived quantities stay coherent across the views.
+  /// @param[in] parent The geometry whose storage is shared
+  /// @param[in] dofmap Cell dofmap for the view, indexing into the
+  ///   shared node array
+  Geometry(const Geometry& parent, graph::AdjacencyList<std::int32_t> dofmap);
+
+  /// Copy constructor. The copy receives its own coordinate storage
+  /// (views created from it do not alias the original).
+  Geometry(const Geometry&);
 
   /// Move constructor
   Geometry(Geometry&&) = default;
@@ -87,12 +122,20 @@ public:
   /// Index map
   std::shared_ptr<const common::IndexMap> index_map() const;
 
-  /// Geometry degrees-of-freedom
+  /// Geometry degrees-of-freedom. Increments the geometry version,
+  /// since the returned reference allows modification of the
+  /// coordinates.
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x();
 
   /// Geometry degrees-of-freedom
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x() const;
 
+  /// Version counter for the coordinates. Incremented whenever
+  /// write access to the coordinates is handed out, so caches of
+  /// derived geometric quantities can detect (possible) changes
+  /// cheaply.
+  std::size_t version() const;
+
   /// The element that describes the geometry map
   /// @return The coordinate/geometry element
   const fem::CoordinateElement& cmap() const;
@@ -100,6 +143,18 @@ public:
   /// Return coordinate array for node n (index is local to the process)
   Eigen::Vector3d node(int n) const;
 
+  /// Packed copy of the coordinates in precision T (float or double)
+  /// and the requested layout. The buffer is built on first use and
+  /// cached; the cache is refreshed when the coordinate version
+  /// changes. For CoordinateLayout::interleaved the buffer holds xyz
+  /// per node; for CoordinateLayout::split it holds all x, then all y,
+  /// then all z, each block x().rows() entries long. Vectorized
+  /// kernels and tree builders can pick the precision/layout that
+  /// suits their access pattern; the canonical float64 interleaved
+  /// array x() remains the representation of record.
+  template <typename T>
+  const std::vector<T>& packed_x(CoordinateLayout layout) const;
+
   /// Global user indices
   const std::vector<std::int64_t>& input_global_indices() const;
 
@@ -121,11 +176,36 @@ private:
   // The coordinate element
   fem::CoordinateElement _cmap;
 
-  // Coordinates for all points stored as a contiguous array
-  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> _x;
-
-  // Global indices as provided on Geometry creation
-  std::vector<std::int64_t> _input_global_indices;
+  // Coordinates for all points stored as a contiguous array. Held
+  // through a shared_ptr so view geometries (see the view constructor)
+  // can alias the storage without copying.
+  std::shared_ptr<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>> _x;
+
+  // Global indices as provided on Geometry creation (immutable, shared
+  // between views)
+  std::shared_ptr<const std::vector<std::int64_t>> _input_global_indices;
+
+  // Coordinate version, bumped on write access to the coordinates.
+  // Shared between views of the same storage so caches keyed on the
+  // version stay coherent.
+  std::shared_ptr<std::size_t> _version;
+
+  // Lazily built packed coordinate buffers, indexed by layout, each
+  // tagged with the coordinate version at which it was built (max()
+  // marks an unbuilt buffer)
+  mutable std::array<std::pair<std::vector<double>, std::size_t>, 2> _packed_x64
+      = {{{{}, std::numeric_limits<std::size_t>::max()},
+          {{}, std::numeric_limits<std::size_t>::max()}}};
+  mutable std::array<std::pair<std::vector<float>, std::size_t>, 2> _packed_x32
+      = {{{{}, std::numeric_limits<std::size_t>::max()},
+          {{}, std::numeric_limits<std::size_t>::max()}}};
+
+  // Reported resident bytes (coordinates, dofmap and input indices)
+  common::MemoryRegistry::Usage _mem_usage{"Geometry coordinates"};
+
+  // Reported resident bytes of the packed coordinate buffers
+  mutable common::MemoryRegistry::Usage _packed_mem_usage{
+      "Geometry packed coordinates"};
 };
 
 /// Build Geometry
@@ -0,0 +1,135 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "GeometryCache.h"
+#include "Geometry.h"
+#include "Mesh.h"
+#include "Topology.h"
+#include "utils.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/utils.h>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::mesh;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Number of entities (owned and ghost) of dimension dim, creating the
+// entities if required
+std::int32_t num_entities(const Mesh& mesh, int dim)
+{
+  mesh.topology_mutable().create_entities(dim);
+  auto map = mesh.topology().index_map(dim);
+  assert(map);
+  return map->size_local() + map->num_ghosts();
+}
+//-----------------------------------------------------------------------------
+// Fill rows of a per-entity array by evaluating f on chunks of the
+// entity range [0, num), split over the worker threads. f captures the
+// target array and writes the rows of its chunk.
+template <typename Fill>
+void parallel_fill(std::int32_t num, Fill&& f)
+{
+  const int num_threads = common::num_worker_threads();
+  if (num_threads < 2 or num < 2 * num_threads)
+  {
+    Eigen::ArrayXi entities(num);
+    std::iota(entities.data(), entities.data() + num, 0);
+    f(0, entities);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  const std::int32_t chunk = (num + num_threads - 1) / num_threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    const std::int32_t begin = t * chunk;
+    const std::int32_t end = std::min(begin + chunk, num);
+    if (begin >= end)
+      break;
+    threads.emplace_back([begin, end, &f]() {
+      Eigen::ArrayXi entities(end - begin);
+      std::iota(entities.data(), entities.data() + (end - begin), begin);
+      f(begin, entities);
+    });
+  }
+  for (std::thread& t : threads)
+    t.join();
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+void GeometryCache::check_version(const Mesh& mesh)
+{
+  const std::size_t version = mesh.geometry().version();
+  if (version != _version)
+  {
+    clear();
+    _version = version;
+  }
+}
+//-----------------------------------------------------------------------------
+const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
+GeometryCache::midpoints(const Mesh& mesh, int dim)
+{
+  check_version(mesh);
+  if (auto it = _midpoints.find(dim); it != _midpoints.end())
+    return it->second;
+
+  const std::int32_t num = num_entities(mesh, dim);
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> values(num, 3);
+  parallel_fill(num,
+                [&](std::int32_t begin, const Eigen::ArrayXi& entities) {
+                  values.block(begin, 0, entities.rows(), 3)
+                      = mesh::midpoints(mesh, dim, entities);
+                });
+  return _midpoints.emplace(dim, std::move(values)).first->second;
+}
+//-----------------------------------------------------------------------------
+const Eigen::ArrayXd& GeometryCache::volumes(const Mesh& mesh, int dim)
+{
+  check_version(mesh);
+  if (auto it = _volumes.find(dim); it != _volumes.end())
+    return it->second;
+
+  const std::int32_t num = num_entities(mesh, dim);
+  Eigen::ArrayXd values(num);
+  parallel_fill(num,
+                [&](std::int32_t begin, const Eigen::ArrayXi& entities) {
+                  values.segment(begin, entities.rows())
+                      = mesh::volume_entities(mesh, entities, dim);
+                });
+  return _volumes.emplace(dim, std::move(values)).first->second;
+}
+//-----------------------------------------------------------------------------
+const Eigen::ArrayXd& GeometryCache::circumradii(const Mesh& mesh, int dim)
+{
+  check_version(mesh);
+  if (auto it = _circumradii.find(dim); it != _circumradii.end())
+    return it->second;
+
+  const std::int32_t num = num_entities(mesh, dim);
+  Eigen::ArrayXd values(num);
+  parallel_fill(num,
+                [&](std::int32_t begin, const Eigen::ArrayXi& entities) {
+                  values.segment(begin, entities.rows())
+                      = mesh::circumradius(mesh, entities, dim);
+                });
+  return _circumradii.emplace(dim, std::move(values)).first->second;
+}
+//-----------------------------------------------------------------------------
+void GeometryCache::clear()
+{
+  _midpoints.clear();
+  _volumes.clear();
+  _circumradii.clear();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <map>
+
+namespace dolfinx
+{
+namespace mesh
+{
+class Mesh;
+
+/// Cache of derived geometric quantities (midpoints, volumes,
+/// circumradii) for all entities of a given dimension. Quantities are
+/// computed on first request and reused until the coordinates change,
+/// detected through Geometry::version(). Intended for callers such as
+/// quality measures and refinement markers that evaluate the same
+/// quantities over all cells every cycle. The fill loops are split
+/// over the worker threads configured by DOLFINX_NUM_THREADS.
+
+class GeometryCache
+{
+public:
+  /// Create an empty cache
+  GeometryCache() = default;
+
+  /// Midpoints of all entities of dimension dim, ghosts included
+  /// @param[in] mesh The mesh
+  /// @param[in] dim Entity dimension
+  /// @return Midpoint of each entity, one per row
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
+  midpoints(const Mesh& mesh, int dim);
+
+  /// Generalized volumes of all entities of dimension dim, ghosts
+  /// included
+  /// @param[in] mesh The mesh
+  /// @param[in] dim Entity dimension
+  /// @return Volume of each entity
+  const Eigen::ArrayXd& volumes(const Mesh& mesh, int dim);
+
+  /// Circumradii of all entities of dimension dim, ghosts included
+  /// @param[in] mesh The mesh
+  /// @param[in] dim Entity dimension
+  /// @return Circumradius of each entity
+  const Eigen::ArrayXd& circumradii(const Mesh& mesh, int dim);
+
+  /// Drop all cached quantities
+  void clear();
+
+private:
+  // Drop cached quantities if the mesh coordinates have changed
+  void check_version(const Mesh& mesh);
+
+  // Geometry version the cached quantities were computed for
+  std::size_t _version = 0;
+
+  // Cached quantities, keyed on entity dimension
+  std::map<int, Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+      _midpoints;
+  std::map<int, Eigen::ArrayXd> _volumes;
+  std::map<int, Eigen::ArrayXd> _circumradii;
+};
+} // namespace mesh
+} // namespace dolfinx
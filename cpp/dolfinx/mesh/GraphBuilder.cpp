@@ -6,7 +6,9 @@
 
 #include "GraphBuilder.h"
 #include <algorithm>
+#include <boost/functional/hash.hpp>
 #include <boost/unordered_map.hpp>
+#include <dolfinx/common/ArenaAllocator.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
@@ -48,90 +50,119 @@ compute_local_dual_graph_keyed(
   // Compute edges (cell-cell connections) using local numbering
 
   // Create map from cell vertices to entity vertices
-  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
       facet_vertices = mesh::get_entity_vertices(cell_type, tdim - 1);
 
-  // Vector-of-arrays data structure, which is considerably faster than
-  // vector-of-vectors
-  std::vector<std::pair<std::array<std::int32_t, N>, std::int32_t>> facets(
-      num_facets_per_cell * num_local_cells);
-
-  // Iterate over all cells and build list of all facets (keyed on
-  // sorted vertex indices), with cell index attached
-  int counter = 0;
-  for (std::int32_t i = 0; i < num_local_cells; ++i)
-  {
-    // Iterate over facets of cell
-    for (int j = 0; j < num_facets_per_cell; ++j)
-    {
-      // Get list of facet vertices
-      auto& facet = facets[counter].first;
-      for (int k = 0; k < N; ++k)
-        facet[k] = cell_vertices(i, facet_vertices(j, k));
+  // For very large inputs the facet key list is built and matched in
+  // several passes to bound the working memory: pass p handles only the
+  // facets whose smallest vertex falls in the p-th slice of the local
+  // vertex range. Matching facets share their smallest vertex and
+  // therefore always land in the same pass, and processing the slices
+  // in ascending order visits the facets in the same order as a single
+  // sort over all of them, so the output is identical to a single-pass
+  // build. Each extra pass costs one more sweep over the cells.
+  const std::int64_t num_facets_total
+      = (std::int64_t)num_facets_per_cell * num_local_cells;
+  constexpr std::int64_t max_facets_per_pass = 1 << 24;
+  const int num_passes = std::max<std::int64_t>(
+      1, (num_facets_total + max_facets_per_pass - 1) / max_facets_per_pass);
+
+  const std::int64_t v_min
+      = cell_vertices.size() > 0 ? cell_vertices.minCoeff() : 0;
+  const std::int64_t v_max
+      = cell_vertices.size() > 0 ? cell_vertices.maxCoeff() : 0;
+  const std::int64_t v_range = v_max - v_min + 1;
 
-      // Sort facet vertices
-      std::sort(facet.begin(), facet.end());
-
-      // Attach local cell index
-      facets[counter].second = i;
-
-      // Increment facet counter
-      counter++;
-    }
-  }
-
-  // Sort facets
-  std::sort(facets.begin(), facets.end());
+  // Vector-of-arrays data structure, which is considerably faster than
+  // vector-of-vectors. Reused (cleared) between passes.
+  std::vector<std::pair<std::array<std::int32_t, N>, std::int32_t>> facets;
+  facets.reserve(std::min(num_facets_total, max_facets_per_pass));
 
-  // Find maching facets by comparing facet i and facet i -1
   std::size_t num_local_edges = 0;
   std::vector<std::vector<std::int32_t>> local_graph(num_local_cells);
   std::vector<std::pair<std::vector<std::int32_t>, std::int32_t>>
       facet_cell_map;
-  for (std::size_t i = 1; i < facets.size(); ++i)
+
+  std::array<std::int32_t, N> facet;
+  for (int pass = 0; pass < num_passes; ++pass)
   {
-    const int ii = i;
-    const int jj = i - 1;
+    // Iterate over all cells and build list of the facets (keyed on
+    // sorted vertex indices) belonging to this pass, with cell index
+    // attached
+    facets.clear();
+    for (std::int32_t i = 0; i < num_local_cells; ++i)
+    {
+      // Iterate over facets of cell
+      for (int j = 0; j < num_facets_per_cell; ++j)
+      {
+        // Get list of facet vertices
+        for (int k = 0; k < N; ++k)
+          facet[k] = cell_vertices(i, facet_vertices(j, k));
+
+        // Sort facet vertices
+        std::sort(facet.begin(), facet.end());
+
+        // Slice on the smallest facet vertex
+        if (num_passes > 1
+            and (facet[0] - v_min) * num_passes / v_range != pass)
+        {
+          continue;
+        }
+
+        // Attach local cell index
+        facets.push_back({facet, i});
+      }
+    }
+
+    // Sort facets
+    std::sort(facets.begin(), facets.end());
 
-    const auto& facet0 = facets[jj].first;
-    const auto& facet1 = facets[ii].first;
-    const int cell_index0 = facets[jj].second;
-    if (std::equal(facet1.begin(), facet1.end(), facet0.begin()))
+    // Find maching facets by comparing facet i and facet i -1
+    for (std::size_t i = 1; i < facets.size(); ++i)
     {
-      // Add edges (directed graph, so add both ways)
-      const int cell_index1 = facets[ii].second;
-      local_graph[cell_index0].push_back(cell_index1);
-      local_graph[cell_index1].push_back(cell_index0);
+      const int ii = i;
+      const int jj = i - 1;
 
-      // Since we've just found a matching pair, the next pair cannot be
-      // matching, so advance 1
-      ++i;
+      const auto& facet0 = facets[jj].first;
+      const auto& facet1 = facets[ii].first;
+      const int cell_index0 = facets[jj].second;
+      if (std::equal(facet1.begin(), facet1.end(), facet0.begin()))
+      {
+        // Add edges (directed graph, so add both ways)
+        const int cell_index1 = facets[ii].second;
+        local_graph[cell_index0].push_back(cell_index1);
+        local_graph[cell_index1].push_back(cell_index0);
+
+        // Since we've just found a matching pair, the next pair cannot be
+        // matching, so advance 1
+        ++i;
 
-      // Increment number of local edges found
-      ++num_local_edges;
+        // Increment number of local edges found
+        ++num_local_edges;
+      }
+      else
+      {
+        // No match, so add facet0 to map
+        facet_cell_map.push_back(
+            {std::vector<std::int32_t>(facet0.begin(), facet0.end()),
+             cell_index0});
+      }
     }
-    else
+
+    // Add last facet of the pass, as it's not covered by the above
+    // loop. We could check it against the preceding facet, but it's
+    // easier to just insert it here
+    if (!facets.empty())
     {
-      // No match, so add facet0 to map
-      facet_cell_map.push_back(
-          {std::vector<std::int32_t>(facet0.begin(), facet0.end()),
-           cell_index0});
+      const int k = facets.size() - 1;
+      const int cell_index = facets[k].second;
+      facet_cell_map.emplace_back(
+          std::vector<std::int32_t>(facets[k].first.begin(),
+                                    facets[k].first.end()),
+          cell_index);
     }
   }
 
-  // Add last facet, as it's not covered by the above loop. We could
-  // check it against the preceding facet, but it's easier to just
-  // insert it here
-  if (!facets.empty())
-  {
-    const int k = facets.size() - 1;
-    const int cell_index = facets[k].second;
-    facet_cell_map.emplace_back(
-        std::vector<std::int32_t>(facets[k].first.begin(),
-                                  facets[k].first.end()),
-        cell_index);
-  }
-
   return {std::move(local_graph), std::move(facet_cell_map), num_local_edges};
 }
 //-----------------------------------------------------------------------------
@@ -196,8 +227,16 @@ compute_nonlocal_dual_graph(
                 mpi_comm);
   num_global_vertices += 1;
 
+  // Arena for the match-making temporaries below: the send buffers and
+  // the match map churn through many small allocations that all die
+  // when this function returns
+  common::Arena arena;
+  const common::ArenaAllocator<std::int64_t> alloc64(arena);
+  using SendVector
+      = std::vector<std::int64_t, common::ArenaAllocator<std::int64_t>>;
+
   // Send facet-cell map to intermediary match-making processes
-  std::vector<std::vector<std::int64_t>> send_buffer(num_processes);
+  std::vector<SendVector> send_buffer(num_processes, SendVector(alloc64));
 
   // Pack map data and send to match-maker process
   for (const auto& it : facet_cell_map)
@@ -223,17 +262,22 @@ compute_nonlocal_dual_graph(
           mpi_comm, graph::AdjacencyList<std::int64_t>(send_buffer));
 
   // Clear send buffer
-  send_buffer = std::vector<std::vector<std::int64_t>>(num_processes);
+  for (SendVector& v : send_buffer)
+    v.clear();
 
   // Map to connect processes and cells, using facet as key
-  typedef boost::unordered_map<std::vector<std::int64_t>,
-                               std::pair<std::int64_t, std::int64_t>>
+  using MatchKey = SendVector;
+  typedef boost::unordered_map<
+      MatchKey, std::pair<std::int64_t, std::int64_t>, boost::hash<MatchKey>,
+      std::equal_to<MatchKey>,
+      common::ArenaAllocator<
+          std::pair<const MatchKey, std::pair<std::int64_t, std::int64_t>>>>
       MatchMap;
-  MatchMap matchmap;
+  MatchMap matchmap(alloc64);
 
   // Look for matches to send back to other processes
-  std::pair<std::vector<std::int64_t>, std::pair<std::int64_t, std::int64_t>>
-      key;
+  std::pair<MatchKey, std::pair<std::int64_t, std::int64_t>> key(
+      MatchKey(alloc64), {0, 0});
   key.first.resize(num_vertices_per_facet);
   for (int p = 0; p < num_processes; ++p)
   {
@@ -297,6 +341,191 @@ compute_nonlocal_dual_graph(
   return {std::move(graph), ghost_nodes.size(), num_nonlocal_edges};
 }
 //-----------------------------------------------------------------------------
+// Compute the boundary facets by dropping facets as they are matched:
+// locally during the sorted matching pass, then across processes with
+// the match-making exchange. See
+// GraphBuilder::compute_boundary_facets.
+template <int N>
+std::pair<
+    Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+    std::vector<std::int32_t>>
+compute_boundary_facets_keyed(
+    const MPI_Comm mpi_comm,
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& cell_vertices,
+    const mesh::CellType& cell_type)
+{
+  common::Timer timer("Compute boundary facets");
+
+  const int tdim = mesh::cell_dim(cell_type);
+  const std::int32_t num_local_cells = cell_vertices.rows();
+  const int num_facets_per_cell = mesh::cell_num_entities(cell_type, tdim - 1);
+  assert(N
+         == mesh::num_cell_vertices(mesh::cell_entity_type(cell_type,
+                                                           tdim - 1)));
+
+  // Create map from cell vertices to entity vertices
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      facet_vertices = mesh::get_entity_vertices(cell_type, tdim - 1);
+
+  // Build and match the facet key list in bounded passes, as in the
+  // local dual graph (see compute_local_dual_graph_keyed). Matched
+  // (interior) facets are dropped on the spot; only the unmatched
+  // facets of each pass are kept.
+  const std::int64_t num_facets_total
+      = (std::int64_t)num_facets_per_cell * num_local_cells;
+  constexpr std::int64_t max_facets_per_pass = 1 << 24;
+  const int num_passes = std::max<std::int64_t>(
+      1, (num_facets_total + max_facets_per_pass - 1) / max_facets_per_pass);
+
+  const std::int64_t v_min
+      = cell_vertices.size() > 0 ? cell_vertices.minCoeff() : 0;
+  const std::int64_t v_max
+      = cell_vertices.size() > 0 ? cell_vertices.maxCoeff() : 0;
+  const std::int64_t v_range = v_max - v_min + 1;
+
+  std::vector<std::pair<std::array<std::int64_t, N>, std::int32_t>> facets;
+  facets.reserve(std::min(num_facets_total, max_facets_per_pass));
+
+  // Facets not matched within this process (sorted global vertex keys
+  // with the attached local cell)
+  std::vector<std::pair<std::array<std::int64_t, N>, std::int32_t>> unmatched;
+
+  std::array<std::int64_t, N> facet;
+  for (int pass = 0; pass < num_passes; ++pass)
+  {
+    facets.clear();
+    for (std::int32_t i = 0; i < num_local_cells; ++i)
+    {
+      for (int j = 0; j < num_facets_per_cell; ++j)
+      {
+        for (int k = 0; k < N; ++k)
+          facet[k] = cell_vertices(i, facet_vertices(j, k));
+        std::sort(facet.begin(), facet.end());
+
+        // Slice on the smallest facet vertex
+        if (num_passes > 1
+            and (facet[0] - v_min) * num_passes / v_range != pass)
+        {
+          continue;
+        }
+
+        facets.push_back({facet, i});
+      }
+    }
+
+    std::sort(facets.begin(), facets.end());
+
+    // Keep only the facets without a matching neighbour
+    for (std::size_t i = 1; i < facets.size(); ++i)
+    {
+      if (facets[i].first == facets[i - 1].first)
+        ++i; // Matched (interior) pair: drop both and advance
+      else
+        unmatched.push_back(facets[i - 1]);
+    }
+    if (!facets.empty())
+      unmatched.push_back(facets.back());
+  }
+  facets.clear();
+  facets.shrink_to_fit();
+
+  // Match the leftover facets across processes; a facet matched on
+  // another rank is an interprocess facet, not a boundary facet
+  std::vector<bool> matched(unmatched.size(), false);
+  const int num_processes = dolfinx::MPI::size(mpi_comm);
+  if (num_processes > 1)
+  {
+    // Get global range of vertex indices for the match-maker
+    // partitioning
+    std::int64_t num_global_vertices = 0;
+    const std::int64_t max_vertex
+        = (cell_vertices.rows() > 0) ? cell_vertices.maxCoeff() : 0;
+    MPI_Allreduce(&max_vertex, &num_global_vertices, 1, MPI_INT64_T, MPI_MAX,
+                  mpi_comm);
+    num_global_vertices += 1;
+
+    // Send each unmatched facet key, with its position in the local
+    // list, to the match-maker process of its first vertex
+    std::vector<std::vector<std::int64_t>> send_buffer(num_processes);
+    for (std::size_t f = 0; f < unmatched.size(); ++f)
+    {
+      const int dest_proc = dolfinx::MPI::index_owner(
+          num_processes, unmatched[f].first[0], num_global_vertices);
+      send_buffer[dest_proc].insert(send_buffer[dest_proc].end(),
+                                    unmatched[f].first.begin(),
+                                    unmatched[f].first.end());
+      send_buffer[dest_proc].push_back(f);
+    }
+
+    const graph::AdjacencyList<std::int64_t> received_buffer
+        = dolfinx::MPI::all_to_all(
+            mpi_comm, graph::AdjacencyList<std::int64_t>(send_buffer));
+    for (std::vector<std::int64_t>& v : send_buffer)
+      v.clear();
+
+    // Pair up facets, keyed on the vertex list; matched facets are
+    // reported back to both owners by their local list position
+    boost::unordered_map<std::vector<std::int64_t>,
+                         std::pair<std::int32_t, std::int64_t>>
+        matchmap;
+    std::vector<std::int64_t> key(N);
+    for (int p = 0; p < num_processes; ++p)
+    {
+      auto data_p = received_buffer.links(p);
+      for (int i = 0; i < data_p.rows(); i += (N + 1))
+      {
+        std::copy(data_p.data() + i, data_p.data() + i + N, key.begin());
+        const auto [it, inserted]
+            = matchmap.insert({key, {p, data_p[i + N]}});
+        if (!inserted)
+        {
+          send_buffer[it->second.first].push_back(it->second.second);
+          send_buffer[p].push_back(data_p[i + N]);
+          matchmap.erase(it);
+        }
+      }
+    }
+
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> matched_list
+        = dolfinx::MPI::all_to_all(
+              mpi_comm, graph::AdjacencyList<std::int64_t>(send_buffer))
+              .array();
+    for (Eigen::Index i = 0; i < matched_list.rows(); ++i)
+    {
+      assert(matched_list[i] >= 0
+             and matched_list[i] < (std::int64_t)unmatched.size());
+      matched[matched_list[i]] = true;
+    }
+  }
+
+  // Pack the facets that survived both matching passes
+  std::int32_t num_boundary_facets = 0;
+  for (std::size_t f = 0; f < unmatched.size(); ++f)
+  {
+    if (!matched[f])
+      ++num_boundary_facets;
+  }
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      boundary_facets(num_boundary_facets, N);
+  std::vector<std::int32_t> boundary_cells;
+  boundary_cells.reserve(num_boundary_facets);
+  for (std::size_t f = 0; f < unmatched.size(); ++f)
+  {
+    if (!matched[f])
+    {
+      for (int k = 0; k < N; ++k)
+        boundary_facets(boundary_cells.size(), k) = unmatched[f].first[k];
+      boundary_cells.push_back(unmatched[f].second);
+    }
+  }
+
+  LOG(INFO) << "Found " << num_boundary_facets << " boundary facets from "
+            << unmatched.size() << " locally unmatched facets";
+
+  return {std::move(boundary_facets), std::move(boundary_cells)};
+}
+//-----------------------------------------------------------------------------
 
 } // namespace
 
@@ -356,3 +585,36 @@ dolfinx::mesh::GraphBuilder::compute_local_dual_graph(
   }
 }
 //-----------------------------------------------------------------------------
+std::pair<
+    Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+    std::vector<std::int32_t>>
+mesh::GraphBuilder::compute_boundary_facets(
+    const MPI_Comm mpi_comm,
+    const Eigen::Ref<const Eigen::Array<std::int64_t, Eigen::Dynamic,
+                                        Eigen::Dynamic, Eigen::RowMajor>>&
+        cell_vertices,
+    const mesh::CellType& cell_type)
+{
+  LOG(INFO) << "Compute boundary facets";
+
+  const int tdim = mesh::cell_dim(cell_type);
+  const int num_entity_vertices
+      = mesh::num_cell_vertices(mesh::cell_entity_type(cell_type, tdim - 1));
+
+  switch (num_entity_vertices)
+  {
+  case 1:
+    return compute_boundary_facets_keyed<1>(mpi_comm, cell_vertices, cell_type);
+  case 2:
+    return compute_boundary_facets_keyed<2>(mpi_comm, cell_vertices, cell_type);
+  case 3:
+    return compute_boundary_facets_keyed<3>(mpi_comm, cell_vertices, cell_type);
+  case 4:
+    return compute_boundary_facets_keyed<4>(mpi_comm, cell_vertices, cell_type);
+  default:
+    throw std::runtime_error(
+        "Cannot compute boundary facets. Entities with "
+        + std::to_string(num_entity_vertices) + " vertices not supported");
+  }
+}
+//-----------------------------------------------------------------------------
@@ -52,6 +52,34 @@ public:
                                           Eigen::Dynamic, Eigen::RowMajor>>&
           cell_vertices,
       const mesh::CellType& cell_type);
+
+  /// Compute the exterior (boundary) facets from minimal mesh data,
+  /// without materialising interior facets. Facets are matched within
+  /// the process during the dual-graph-style sorted matching pass, the
+  /// leftover facets are matched across processes through the same
+  /// match-making exchange the dual graph uses, and a facet unmatched
+  /// in both passes lies on the domain boundary. Interior facets are
+  /// dropped as they are matched, so the working memory scales with
+  /// the surface of the local cell block rather than the total facet
+  /// count, and the full facet creation of
+  /// TopologyComputation::compute_entities is skipped entirely.
+  /// Collective.
+  /// @param[in] mpi_comm MPI communicator
+  /// @param[in] cell_vertices Cell vertices on this process (global
+  ///   indices, see compute_dual_graph)
+  /// @param[in] cell_type Cell type
+  /// @return Pair of (boundary facet vertices with one facet per row,
+  ///   sorted global vertex indices; local index of the attached cell
+  ///   for each facet)
+  static std::pair<Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
+                                Eigen::RowMajor>,
+                   std::vector<std::int32_t>>
+  compute_boundary_facets(
+      const MPI_Comm mpi_comm,
+      const Eigen::Ref<const Eigen::Array<std::int64_t, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>&
+          cell_vertices,
+      const mesh::CellType& cell_type);
 };
 } // namespace mesh
 } // namespace dolfinx
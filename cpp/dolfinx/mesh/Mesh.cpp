@@ -7,10 +7,13 @@
 
 #include "Mesh.h"
 #include "Geometry.h"
+#include "GraphBuilder.h"
 #include "Partitioning.h"
 #include "Topology.h"
 #include "TopologyComputation.h"
 #include "utils.h"
+#include <algorithm>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
@@ -19,10 +22,12 @@
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DofMapBuilder.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/BoostGraphOrdering.h>
 #include <dolfinx/graph/Partitioning.h>
 #include <dolfinx/io/cells.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <memory>
+#include <utility>
 
 using namespace dolfinx;
 using namespace dolfinx::mesh;
@@ -58,6 +63,62 @@ Eigen::ArrayXd cell_r(const mesh::Mesh& mesh)
   return mesh::inradius(mesh, cells);
 }
 //-----------------------------------------------------------------------------
+/// Reorder the owned cells of a distributed cell list with reverse
+/// Cuthill-McKee applied to the local dual graph. Cells arrive from the
+/// partitioner in an order with poor locality; since the topology,
+/// geometry and dofmaps are all built in cell order, reordering here
+/// improves cache behaviour of the assembly gathers downstream. Ghost
+/// cells (stored at the end of the list) keep their positions.
+/// @param[in] cell_nodes The distributed cell list (geometry nodes)
+/// @param[in] original_cell_index The original global index for each
+///   cell
+/// @param[in] num_ghosts Number of ghost cells at the end of the list
+/// @param[in] element The coordinate element for the cells
+/// @return The reordered cell list and original cell indices
+std::pair<graph::AdjacencyList<std::int64_t>, std::vector<std::int64_t>>
+reorder_owned_cells(const graph::AdjacencyList<std::int64_t>& cell_nodes,
+                    const std::vector<std::int64_t>& original_cell_index,
+                    int num_ghosts, const fem::CoordinateElement& element)
+{
+  const std::int32_t num_owned = cell_nodes.num_nodes() - num_ghosts;
+  if (num_owned < 2)
+    return {cell_nodes, original_cell_index};
+
+  // Build the local dual graph of the owned cells from the vertex
+  // topology
+  const graph::AdjacencyList<std::int64_t> cells_topology
+      = mesh::extract_topology(element.cell_shape(), element.dof_layout(),
+                               cell_nodes);
+  const int num_vertices_per_cell = cells_topology.num_links(0);
+  Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
+                                Eigen::RowMajor>>
+      cell_vertices(cells_topology.array().data(), num_owned,
+                    num_vertices_per_cell);
+  const auto [local_graph, facet_cell_map, num_edges]
+      = mesh::GraphBuilder::compute_local_dual_graph(cell_vertices,
+                                                     element.cell_shape());
+
+  // Compute the re-ordering (map from old to new cell index)
+  const std::vector<int> remap = graph::BoostGraphOrdering::compute_cuthill_mckee(
+      graph::AdjacencyList<std::int32_t>(local_graph), true);
+
+  // Apply the permutation to the cell list and the original indices
+  const int num_nodes_per_cell = cell_nodes.num_links(0);
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cells_remapped(cell_nodes.num_nodes(), num_nodes_per_cell);
+  std::vector<std::int64_t> index_remapped(original_cell_index.size());
+  for (std::int32_t c = 0; c < cell_nodes.num_nodes(); ++c)
+  {
+    const std::int32_t dest = c < num_owned ? remap[c] : c;
+    auto nodes = cell_nodes.links(c);
+    for (int j = 0; j < num_nodes_per_cell; ++j)
+      cells_remapped(dest, j) = nodes[j];
+    index_remapped[dest] = original_cell_index[c];
+  }
+
+  return {graph::AdjacencyList<std::int64_t>(cells_remapped), index_remapped};
+}
+//-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -68,9 +129,6 @@ Mesh mesh::create_mesh(MPI_Comm comm,
                                           Eigen::Dynamic, Eigen::RowMajor>& x,
                        mesh::GhostMode ghost_mode)
 {
-  if (ghost_mode == mesh::GhostMode::shared_vertex)
-    throw std::runtime_error("Ghost mode via vertex currently disabled.");
-
   // TODO: This step can be skipped for 'P1' elements
   //
   // Extract topology data, e.g. just the vertices. For P1 geometry this
@@ -89,10 +147,34 @@ Mesh mesh::create_mesh(MPI_Comm comm,
       = Partitioning::partition_cells(comm, size, element.cell_shape(),
                                       cells_topology, GhostMode::shared_facet);
 
+  return create_mesh(comm, cells, element, x, ghost_mode, dest);
+}
+//-----------------------------------------------------------------------------
+Mesh mesh::create_mesh(MPI_Comm comm,
+                       const graph::AdjacencyList<std::int64_t>& cells,
+                       const fem::CoordinateElement& element,
+                       const Eigen::Array<double, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>& x,
+                       mesh::GhostMode ghost_mode,
+                       const graph::AdjacencyList<std::int32_t>& dest,
+                       bool reorder)
+{
+  if (ghost_mode == mesh::GhostMode::shared_vertex)
+    throw std::runtime_error("Ghost mode via vertex currently disabled.");
+
   // Distribute cells to destination rank
-  const auto [cell_nodes, src, original_cell_index, ghost_owners]
+  const auto [cell_nodes0, src, original_cell_index0, ghost_owners]
       = graph::Partitioning::distribute(comm, cells, dest);
 
+  // Reorder the owned cells for locality before building the topology.
+  // All downstream structures are built in cell order, so the improved
+  // locality carries through to the topology, geometry and dofmaps.
+  const auto [cell_nodes, original_cell_index]
+      = reorder
+            ? reorder_owned_cells(cell_nodes0, original_cell_index0,
+                                  ghost_owners.size(), element)
+            : std::pair(cell_nodes0, original_cell_index0);
+
   // Create cells and vertices with the ghosting requested. Input topology
   // includes cells shared via facet, but output will remove these, if not
   // required by ghost_mode.
@@ -136,6 +218,341 @@ Mesh mesh::create_mesh(MPI_Comm comm,
   return Mesh(comm, std::move(topology), std::move(geometry));
 }
 //-----------------------------------------------------------------------------
+Mesh mesh::add_ghost_layer(const Mesh& mesh)
+{
+  MPI_Comm comm = mesh.mpi_comm();
+  const Topology& topology = mesh.topology();
+  const Geometry& geometry = mesh.geometry();
+  const int tdim = topology.dim();
+
+  auto cell_map = topology.index_map(tdim);
+  assert(cell_map);
+  const std::int32_t num_owned_cells = cell_map->size_local();
+
+  // Rebuild the input cell list (global input node indices) for the
+  // owned cells
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
+  const std::vector<std::int64_t>& igi = geometry.input_global_indices();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      cells(num_owned_cells, num_dofs_g);
+  for (std::int32_t c = 0; c < num_owned_cells; ++c)
+  {
+    auto dofs = x_dofmap.links(c);
+    for (int j = 0; j < num_dofs_g; ++j)
+      cells(c, j) = igi[dofs[j]];
+  }
+
+  // Number of nodes in the input (global user) numbering
+  const std::int64_t max_index
+      = igi.empty() ? -1 : *std::max_element(igi.begin(), igi.end());
+  std::int64_t num_nodes_global = 0;
+  MPI_Allreduce(&max_index, &num_nodes_global, 1, MPI_INT64_T, MPI_MAX, comm);
+  num_nodes_global += 1;
+
+  // Scatter the node coordinates back to the block distribution of the
+  // input numbering, as expected by create_mesh. Nodes stored on more
+  // than one rank are sent more than once, with identical values.
+  const int mpi_size = dolfinx::MPI::size(comm);
+  const int gdim = geometry.dim();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = geometry.x();
+  std::vector<std::vector<std::int64_t>> send_index(mpi_size);
+  std::vector<std::vector<double>> send_coords(mpi_size);
+  for (std::size_t i = 0; i < igi.size(); ++i)
+  {
+    const int owner = dolfinx::MPI::index_owner(mpi_size, igi[i],
+                                                num_nodes_global);
+    send_index[owner].push_back(igi[i]);
+    for (int d = 0; d < gdim; ++d)
+      send_coords[owner].push_back(x(i, d));
+  }
+
+  const graph::AdjacencyList<std::int64_t> recv_index = dolfinx::MPI::all_to_all(
+      comm, graph::AdjacencyList<std::int64_t>(send_index));
+  const graph::AdjacencyList<double> recv_coords
+      = dolfinx::MPI::all_to_all(comm, graph::AdjacencyList<double>(send_coords));
+
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), num_nodes_global, mpi_size);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x_block(
+      range[1] - range[0], gdim);
+  const auto index_arr = recv_index.array();
+  const auto coords_arr = recv_coords.array();
+  for (Eigen::Index k = 0; k < index_arr.rows(); ++k)
+  {
+    const std::int64_t row = index_arr[k] - range[0];
+    for (int d = 0; d < gdim; ++d)
+      x_block(row, d) = coords_arr[k * gdim + d];
+  }
+
+  return create_mesh(comm, graph::AdjacencyList<std::int64_t>(cells),
+                     geometry.cmap(), x_block, GhostMode::shared_facet);
+}
+//-----------------------------------------------------------------------------
+std::tuple<Mesh, std::vector<std::int32_t>, std::vector<std::int32_t>>
+mesh::create_submesh(
+    const Mesh& mesh,
+    const Eigen::Ref<
+        const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& cells)
+{
+  common::Timer timer("Create submesh");
+  const MPI_Comm comm = mesh.mpi_comm();
+  const Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+  auto cell_map = topology.index_map(tdim);
+  auto vertex_map = topology.index_map(0);
+  assert(cell_map);
+  assert(vertex_map);
+  auto c_to_v = topology.connectivity(tdim, 0);
+  if (!c_to_v)
+    throw std::runtime_error("Missing cell-vertex connectivity.");
+
+  // Keep owned parent cells only, in parent order without duplicates.
+  // Ghost cells are dropped; their owners extract them, and a ghost
+  // layer can be rebuilt with add_ghost_layer.
+  std::vector<std::int32_t> sub_to_parent_cell(cells.data(),
+                                               cells.data() + cells.rows());
+  std::sort(sub_to_parent_cell.begin(), sub_to_parent_cell.end());
+  sub_to_parent_cell.erase(
+      std::unique(sub_to_parent_cell.begin(), sub_to_parent_cell.end()),
+      sub_to_parent_cell.end());
+  sub_to_parent_cell.erase(
+      std::lower_bound(sub_to_parent_cell.begin(), sub_to_parent_cell.end(),
+                       cell_map->size_local()),
+      sub_to_parent_cell.end());
+  const std::int32_t num_sub_cells = sub_to_parent_cell.size();
+
+  // Mark the parent vertices used by the selected cells, split into
+  // owned and ghost for the scatters below
+  const std::int32_t num_owned_vertices = vertex_map->size_local();
+  std::vector<std::int32_t> used_owned(num_owned_vertices, 0);
+  std::vector<std::int32_t> used_ghost(vertex_map->num_ghosts(), 0);
+  for (std::int32_t c : sub_to_parent_cell)
+  {
+    auto vertices = c_to_v->links(c);
+    for (int j = 0; j < vertices.rows(); ++j)
+    {
+      if (vertices[j] < num_owned_vertices)
+        used_owned[vertices[j]] = 1;
+      else
+        used_ghost[vertices[j] - num_owned_vertices] = 1;
+    }
+  }
+
+  // A vertex used only by remote submesh cells must still be numbered
+  // by its owner: accumulate ghost-side use at the owners
+  std::vector<std::int32_t> used_any(used_owned);
+  vertex_map->scatter_rev(used_any, used_ghost, 1,
+                          common::IndexMap::Mode::add);
+
+  // Number the owned submesh vertices in parent order and compute the
+  // global offset of this rank's range
+  const std::int32_t num_parent_vertices
+      = num_owned_vertices + vertex_map->num_ghosts();
+  std::vector<std::int32_t> parent_to_sub(num_parent_vertices, -1);
+  std::int32_t num_owned_sub = 0;
+  for (std::int32_t v = 0; v < num_owned_vertices; ++v)
+  {
+    if (used_any[v] > 0)
+      parent_to_sub[v] = num_owned_sub++;
+  }
+  const std::int64_t global_offset
+      = dolfinx::MPI::global_offset(comm, num_owned_sub, true);
+
+  // Send the new global index of each owned vertex to the ranks
+  // ghosting it (-1 for vertices outside the submesh)
+  std::vector<std::int64_t> new_global(num_owned_vertices, -1);
+  for (std::int32_t v = 0; v < num_owned_vertices; ++v)
+  {
+    if (parent_to_sub[v] != -1)
+      new_global[v] = parent_to_sub[v] + global_offset;
+  }
+  const std::vector<std::int64_t> ghost_new_global
+      = vertex_map->scatter_fwd(new_global, 1);
+
+  // Number the used ghost vertices after the owned ones
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& parent_ghost_owners
+      = vertex_map->ghost_owners();
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> ghost_owners;
+  std::int32_t c = num_owned_sub;
+  for (std::size_t g = 0; g < used_ghost.size(); ++g)
+  {
+    if (used_ghost[g] == 1)
+    {
+      assert(ghost_new_global[g] != -1);
+      parent_to_sub[num_owned_vertices + g] = c++;
+      ghosts.push_back(ghost_new_global[g]);
+      ghost_owners.push_back(parent_ghost_owners[g]);
+    }
+  }
+  const std::int32_t num_sub_vertices = c;
+
+  // Cell-vertex connectivity in submesh vertex numbering
+  const int num_cell_vertices
+      = mesh::num_cell_vertices(topology.cell_type());
+  std::vector<std::int32_t> sub_cells_array(num_sub_cells
+                                            * num_cell_vertices);
+  for (std::int32_t i = 0; i < num_sub_cells; ++i)
+  {
+    auto vertices = c_to_v->links(sub_to_parent_cell[i]);
+    for (int j = 0; j < num_cell_vertices; ++j)
+    {
+      assert(parent_to_sub[vertices[j]] != -1);
+      sub_cells_array[i * num_cell_vertices + j] = parent_to_sub[vertices[j]];
+    }
+  }
+  std::vector<std::int32_t> sub_cells_offsets(num_sub_cells + 1, 0);
+  for (std::int32_t i = 0; i < num_sub_cells; ++i)
+    sub_cells_offsets[i + 1] = sub_cells_offsets[i] + num_cell_vertices;
+
+  Topology sub_topology(comm, topology.cell_type());
+  auto index_map_v = std::make_shared<common::IndexMap>(
+      comm, num_owned_sub, ghosts, ghost_owners, 1);
+  sub_topology.set_index_map(0, index_map_v);
+  auto c0 = std::make_shared<graph::AdjacencyList<std::int32_t>>(
+      num_sub_vertices);
+  sub_topology.set_connectivity(c0, 0, 0);
+  auto index_map_c = std::make_shared<common::IndexMap>(
+      comm, num_sub_cells, std::vector<std::int64_t>(), std::vector<int>(), 1);
+  sub_topology.set_index_map(tdim, index_map_c);
+  sub_topology.set_connectivity(
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          std::move(sub_cells_array), std::move(sub_cells_offsets)),
+      tdim, 0);
+
+  // Geometry: restrict the dofmap to the selected cells; the node
+  // array, index map and coordinate element are shared with the parent
+  // (view constructor), so no coordinates are copied and the node
+  // indices keep the parent numbering
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  std::vector<std::int32_t> sub_x_offsets = {0};
+  std::vector<std::int32_t> sub_x_array;
+  for (std::int32_t c : sub_to_parent_cell)
+  {
+    auto dofs = x_dofmap.links(c);
+    sub_x_array.insert(sub_x_array.end(), dofs.data(),
+                       dofs.data() + dofs.rows());
+    sub_x_offsets.push_back(sub_x_array.size());
+  }
+  Geometry sub_geometry(mesh.geometry(),
+                        graph::AdjacencyList<std::int32_t>(
+                            std::move(sub_x_array), std::move(sub_x_offsets)));
+
+  // Invert the vertex map for the caller (includes owned vertices that
+  // are used by remote submesh cells only)
+  std::vector<std::int32_t> sub_to_parent_vertex(num_sub_vertices, -1);
+  for (std::int32_t v = 0; v < num_parent_vertices; ++v)
+  {
+    if (parent_to_sub[v] != -1)
+      sub_to_parent_vertex[parent_to_sub[v]] = v;
+  }
+
+  return {Mesh(comm, std::move(sub_topology), std::move(sub_geometry)),
+          std::move(sub_to_parent_cell), std::move(sub_to_parent_vertex)};
+}
+//-----------------------------------------------------------------------------
+Mesh mesh::reorder_cells(const Mesh& mesh,
+                         const std::vector<std::int32_t>& cell_permutation)
+{
+  common::Timer timer("Reorder mesh cells");
+  const MPI_Comm comm = mesh.mpi_comm();
+  const Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+  auto cell_map = topology.index_map(tdim);
+  auto vertex_map = topology.index_map(0);
+  assert(cell_map);
+  assert(vertex_map);
+  auto c_to_v = topology.connectivity(tdim, 0);
+  if (!c_to_v)
+    throw std::runtime_error("Missing cell-vertex connectivity.");
+
+  const std::int32_t num_owned = cell_map->size_local();
+  const std::int32_t num_ghosts = cell_map->num_ghosts();
+  if ((std::int32_t)cell_permutation.size() != num_owned)
+  {
+    throw std::runtime_error(
+        "Cell permutation size does not match number of owned cells.");
+  }
+
+  // Check the map is a permutation of the owned cells
+  std::vector<bool> hit(num_owned, false);
+  for (std::int32_t p : cell_permutation)
+  {
+    if (p < 0 or p >= num_owned or hit[p])
+      throw std::runtime_error("Invalid cell permutation.");
+    hit[p] = true;
+  }
+
+  // Renumbering the owned cells moves their global indices within this
+  // rank's (unchanged) range; fetch the new global index of each ghost
+  // cell from its owner
+  const std::int64_t offset = cell_map->local_range()[0];
+  std::vector<std::int64_t> new_global(num_owned);
+  for (std::int32_t c = 0; c < num_owned; ++c)
+    new_global[c] = offset + cell_permutation[c];
+  const std::vector<std::int64_t> ghost_new_global
+      = cell_map->scatter_fwd(new_global, 1);
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& ghost_owners_in
+      = cell_map->ghost_owners();
+  const std::vector<int> ghost_owners(ghost_owners_in.data(),
+                                      ghost_owners_in.data()
+                                          + ghost_owners_in.rows());
+  auto index_map_c = std::make_shared<common::IndexMap>(
+      comm, num_owned, ghost_new_global, ghost_owners, 1);
+
+  // Permute the cell-vertex connectivity rows; ghost cells (stored at
+  // the end) keep their positions
+  const std::int32_t num_cells = num_owned + num_ghosts;
+  const int num_cell_vertices = mesh::num_cell_vertices(topology.cell_type());
+  std::vector<std::int32_t> cells_array(num_cells * num_cell_vertices);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    const std::int32_t dest = c < num_owned ? cell_permutation[c] : c;
+    auto vertices = c_to_v->links(c);
+    for (int j = 0; j < num_cell_vertices; ++j)
+      cells_array[dest * num_cell_vertices + j] = vertices[j];
+  }
+  std::vector<std::int32_t> cells_offsets(num_cells + 1, 0);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    cells_offsets[c + 1] = cells_offsets[c] + num_cell_vertices;
+
+  Topology new_topology(comm, topology.cell_type());
+  new_topology.set_index_map(0, vertex_map);
+  const std::int32_t num_vertices
+      = vertex_map->size_local() + vertex_map->num_ghosts();
+  new_topology.set_connectivity(
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(num_vertices), 0, 0);
+  new_topology.set_index_map(tdim, index_map_c);
+  new_topology.set_connectivity(
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          std::move(cells_array), std::move(cells_offsets)),
+      tdim, 0);
+
+  // Geometry: permute the dofmap rows; the node array, index map and
+  // coordinate element are shared with the input (view constructor),
+  // so no coordinates are copied
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const int num_nodes_per_cell = x_dofmap.num_links(0);
+  std::vector<std::int32_t> x_array(x_dofmap.num_nodes() * num_nodes_per_cell);
+  for (std::int32_t c = 0; c < x_dofmap.num_nodes(); ++c)
+  {
+    const std::int32_t dest = c < num_owned ? cell_permutation[c] : c;
+    auto dofs = x_dofmap.links(c);
+    for (int j = 0; j < num_nodes_per_cell; ++j)
+      x_array[dest * num_nodes_per_cell + j] = dofs[j];
+  }
+  std::vector<std::int32_t> x_offsets(x_dofmap.num_nodes() + 1, 0);
+  for (std::int32_t c = 0; c < x_dofmap.num_nodes(); ++c)
+    x_offsets[c + 1] = x_offsets[c] + num_nodes_per_cell;
+  Geometry new_geometry(mesh.geometry(),
+                        graph::AdjacencyList<std::int32_t>(
+                            std::move(x_array), std::move(x_offsets)));
+
+  return Mesh(comm, std::move(new_topology), std::move(new_geometry));
+}
+//-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 Topology& Mesh::topology() { return _topology; }
@@ -148,6 +565,42 @@ Geometry& Mesh::geometry() { return _geometry; }
 //-----------------------------------------------------------------------------
 const Geometry& Mesh::geometry() const { return _geometry; }
 //-----------------------------------------------------------------------------
+void Mesh::move(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& displacement)
+{
+  // Non-const x() bumps the geometry version
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x = _geometry.x();
+  if (displacement.rows() != x.rows())
+    throw std::runtime_error("Displacement has wrong number of rows.");
+  x += displacement;
+  for (const auto& callback : _geometry_callbacks)
+    callback.second();
+}
+//-----------------------------------------------------------------------------
+void Mesh::update_coordinates(
+    const Eigen::Ref<
+        const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>& x_new)
+{
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x = _geometry.x();
+  if (x_new.rows() != x.rows())
+    throw std::runtime_error("Coordinate array has wrong number of rows.");
+  x = x_new;
+  for (const auto& callback : _geometry_callbacks)
+    callback.second();
+}
+//-----------------------------------------------------------------------------
+std::size_t Mesh::add_geometry_update_callback(std::function<void()> callback)
+{
+  _geometry_callbacks.emplace(_next_callback_id, std::move(callback));
+  return _next_callback_id++;
+}
+//-----------------------------------------------------------------------------
+void Mesh::remove_geometry_update_callback(std::size_t id)
+{
+  _geometry_callbacks.erase(id);
+}
+//-----------------------------------------------------------------------------
 double Mesh::hmin() const { return cell_h(*this).minCoeff(); }
 //-----------------------------------------------------------------------------
 double Mesh::hmax() const { return cell_h(*this).maxCoeff(); }
@@ -156,6 +609,44 @@ double Mesh::rmin() const { return cell_r(*this).minCoeff(); }
 //-----------------------------------------------------------------------------
 double Mesh::rmax() const { return cell_r(*this).maxCoeff(); }
 //-----------------------------------------------------------------------------
+const Mesh::GlobalStatistics& Mesh::global_statistics() const
+{
+  if (_global_statistics_version == _geometry.version())
+    return _global_statistics;
+
+  // Local extrema. A rank may own no cells, in which case it joins the
+  // reduction with neutral values.
+  const Eigen::ArrayXd h = cell_h(*this);
+  const Eigen::ArrayXd r = cell_r(*this);
+  std::array<double, 4> local = {std::numeric_limits<double>::max(),
+                                 std::numeric_limits<double>::max(),
+                                 std::numeric_limits<double>::max(),
+                                 std::numeric_limits<double>::max()};
+  if (h.size() > 0)
+  {
+    // Fuse min and max into one reduction by negating the maxima
+    local = {h.minCoeff(), r.minCoeff(), -h.maxCoeff(), -r.maxCoeff()};
+  }
+
+  std::array<double, 4> global;
+  MPI_Allreduce(local.data(), global.data(), 4, MPI_DOUBLE, MPI_MIN,
+                _mpi_comm.comm());
+  _global_statistics.hmin = global[0];
+  _global_statistics.rmin = global[1];
+  _global_statistics.hmax = -global[2];
+  _global_statistics.rmax = -global[3];
+
+  // Entity counts are already cached rank-locally by the index maps
+  const int tdim = _topology.dim();
+  assert(_topology.index_map(tdim));
+  assert(_topology.index_map(0));
+  _global_statistics.num_cells = _topology.index_map(tdim)->size_global();
+  _global_statistics.num_vertices = _topology.index_map(0)->size_global();
+
+  _global_statistics_version = _geometry.version();
+  return _global_statistics;
+}
+//-----------------------------------------------------------------------------
 std::size_t Mesh::hash() const
 {
   // Get local hashes
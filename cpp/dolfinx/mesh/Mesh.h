@@ -10,10 +10,16 @@
 #include "Topology.h"
 #include "cell_types.h"
 #include <Eigen/Dense>
+#include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
+#include <functional>
+#include <limits>
+#include <map>
 #include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace dolfinx
 {
@@ -119,6 +125,60 @@ public:
   /// @return The maximum of cells' inscribed sphere radii
   double rmax() const;
 
+  /// Cached global mesh statistics
+  struct GlobalStatistics
+  {
+    double hmin;               ///< Global minimum cell size
+    double hmax;               ///< Global maximum cell size
+    double rmin;               ///< Global minimum cell inradius
+    double rmax;               ///< Global maximum cell inradius
+    std::int64_t num_cells;    ///< Global number of cells
+    std::int64_t num_vertices; ///< Global number of vertices
+  };
+
+  /// Global mesh statistics. The first call, and the first call after
+  /// the geometry has changed, performs one fused collective
+  /// reduction; subsequent calls return the cached values without
+  /// communication. Call once right after construction when later
+  /// queries (e.g. in per-step logging) must be guaranteed free of
+  /// stray synchronization points.
+  /// @return The global statistics of the mesh
+  const GlobalStatistics& global_statistics() const;
+
+  /// Move the mesh: add a displacement to the coordinates of every
+  /// geometry node (one row per node, zero-padded to 3 columns). The
+  /// geometry version is bumped, so version-keyed caches (packed
+  /// coordinates, global statistics, geometry caches) refresh on next
+  /// use, and the registered geometry-update callbacks are invoked for
+  /// dependents that must rebuild eagerly. Prefer this over mutating
+  /// Geometry::x() directly, which bumps the version but does not
+  /// notify callbacks.
+  /// @param[in] displacement Displacement to add, with the shape of
+  ///   Geometry::x()
+  void move(const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                                Eigen::RowMajor>>& displacement);
+
+  /// Replace the coordinates of every geometry node (bulk assignment
+  /// with the shape of Geometry::x()), bump the geometry version and
+  /// invoke the registered geometry-update callbacks. See move().
+  /// @param[in] x The new coordinates
+  void update_coordinates(
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& x);
+
+  /// Register a callback invoked after every geometry update made
+  /// through move() or update_coordinates(), e.g. to discard a
+  /// bounding box tree built over the old coordinates. Caches keyed on
+  /// Geometry::version() invalidate themselves and need no callback.
+  /// @param[in] callback The invalidation hook
+  /// @return Id for remove_geometry_update_callback
+  std::size_t add_geometry_update_callback(std::function<void()> callback);
+
+  /// Remove a geometry-update callback. Dependents must deregister
+  /// before they are destroyed.
+  /// @param[in] id Id returned by add_geometry_update_callback
+  void remove_geometry_update_callback(std::size_t id);
+
   /// Compute hash of mesh, currently based on the has of the mesh
   /// geometry and mesh topology
   /// @return A tree-hashed value of the coordinates over all MPI
@@ -152,6 +212,17 @@ private:
 
   // Unique identifier
   std::size_t _unique_id = common::UniqueIdGenerator::id();
+
+  // Geometry-update callbacks by registration id
+  std::map<std::size_t, std::function<void()>> _geometry_callbacks;
+  std::size_t _next_callback_id = 0;
+
+  // Cached global statistics and the geometry version they were
+  // computed for; mutable because the cache is filled lazily from the
+  // const accessor. The max() tag marks the cache as unbuilt.
+  mutable GlobalStatistics _global_statistics;
+  mutable std::size_t _global_statistics_version
+      = std::numeric_limits<std::size_t>::max();
 };
 
 /// Create a mesh
@@ -161,5 +232,77 @@ Mesh create_mesh(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& cells,
                                     Eigen::RowMajor>& x,
                  GhostMode ghost_mode);
 
+/// Create a mesh with a precomputed cell distribution. Skips the graph
+/// partitioner and sends each cell to the destination ranks in @p
+/// dest, e.g. destinations computed with incremental repartitioning
+/// after refinement.
+/// @param[in] comm MPI communicator
+/// @param[in] cells Cells on this process (global node indices)
+/// @param[in] element Coordinate element for the cell geometry
+/// @param[in] x Geometry node coordinates on this process
+/// @param[in] ghost_mode Requested ghosting
+/// @param[in] dest Destination rank(s) for each cell on this process
+/// @param[in] reorder Reorder the owned cells with reverse
+///     Cuthill-McKee for locality. Pass false to keep the received
+///     cell order, e.g. for structured generators whose lexicographic
+///     numbering is already cache-friendly
+Mesh create_mesh(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& cells,
+                 const fem::CoordinateElement& element,
+                 const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                    Eigen::RowMajor>& x,
+                 GhostMode ghost_mode,
+                 const graph::AdjacencyList<std::int32_t>& dest,
+                 bool reorder = true);
+
+/// Create a new mesh equal to @p mesh but with a layer of ghost cells
+/// shared by facet. This is the upgrade path for meshes built with
+/// GhostMode::none: construct without ghosts (saving the ghost-layer
+/// memory and construction time) and call this function only when a
+/// feature that requires facet ghosts, e.g. interior facet (DG)
+/// integrals, is actually used. The input mesh data is reconstructed
+/// from the geometry of the owned cells and passed through the standard
+/// construction path, so cells may be repartitioned. This is a
+/// collective operation.
+/// @param[in] mesh The mesh to add a ghost layer to
+/// @return A new mesh with ghost cells shared by facet
+Mesh add_ghost_layer(const Mesh& mesh);
+
+/// Create a mesh over a subset of the cells of another mesh, e.g. the
+/// cells carrying a given MeshTags value. The submesh shares the
+/// coordinate storage of the parent geometry (no coordinates are
+/// copied, and coordinate updates on the parent are seen by the
+/// submesh), its topology index maps are derived from the parent's
+/// with communication only for the new global numbering of shared
+/// vertices, and construction cost scales with the subset, not the
+/// parent. The submesh is built without a ghost cell layer; use
+/// add_ghost_layer if one is needed. Collective.
+/// @param[in] mesh The parent mesh
+/// @param[in] cells Parent-local indices of the cells to extract.
+///   Ghost cells are ignored (owners extract their own copy);
+///   duplicates are removed.
+/// @return The submesh; the parent cell index of each submesh cell;
+///   and the parent vertex index of each submesh vertex
+std::tuple<Mesh, std::vector<std::int32_t>, std::vector<std::int32_t>>
+create_submesh(const Mesh& mesh,
+               const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic,
+                                                   1>>& cells);
+
+/// Create a new mesh equal to @p mesh but with the owned cells
+/// renumbered by a given permutation, e.g. an ordering computed from a
+/// recorded assembly trace (graph::AccessOrdering). Cell ownership and
+/// the per-rank global ranges are unchanged; ghost cells keep their
+/// positions, and the new global index of each ghost is fetched from
+/// its owner, so this is a collective operation. The coordinate
+/// storage is shared with the input geometry (no coordinates are
+/// copied); derived topology entities and permutations are recomputed
+/// on demand. Functions and dofmaps built on the input mesh do not
+/// apply to the new mesh.
+/// @param[in] mesh The mesh to renumber
+/// @param[in] cell_permutation Map from old to new local cell index
+///   for the owned cells
+/// @return The renumbered mesh
+Mesh reorder_cells(const Mesh& mesh,
+                   const std::vector<std::int32_t>& cell_permutation);
+
 } // namespace mesh
 } // namespace dolfinx
@@ -6,43 +6,42 @@
 
 #include "MeshQuality.h"
 #include "Geometry.h"
+#include "GeometryCache.h"
 #include "Mesh.h"
 #include "MeshEntity.h"
+#include "Topology.h"
+#include "cell_types.h"
+#include <algorithm>
+#include <cmath>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
-#include <sstream>
+#include <dolfinx/common/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
+#include <thread>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::mesh;
 
+namespace
+{
 //-----------------------------------------------------------------------------
-std::array<double, 6> MeshQuality::dihedral_angles(const MeshEntity& cell)
+// Dihedral angles of a tetrahedron from its four vertex coordinates
+// (one row per vertex)
+std::array<double, 6>
+dihedral_angles_from_points(const Eigen::Matrix<double, 4, 3, Eigen::RowMajor>& p)
 {
-  throw std::runtime_error("MeshQuality::dihedral_angles requires updating for "
-                           "proper geometry handling");
-
-  if (cell.dim() != 3)
-  {
-    throw std::runtime_error(
-        "Calculation of dihedral angle only supported for 3D cells.");
-  }
-
   static const std::size_t edges[6][2]
       = {{2, 3}, {1, 3}, {1, 2}, {0, 3}, {0, 2}, {0, 1}};
-  const Mesh& mesh = cell.mesh();
 
   std::array<double, 6> dh_angle;
   for (std::uint32_t i = 0; i < 6; ++i)
   {
-    const std::size_t i0 = cell.entities(0)[edges[i][0]];
-    const std::size_t i1 = cell.entities(0)[edges[i][1]];
-    const std::size_t i2 = cell.entities(0)[edges[5 - i][0]];
-    const std::size_t i3 = cell.entities(0)[edges[5 - i][1]];
-
-    const Eigen::Vector3d p0 = mesh.geometry().node(i0);
-    Eigen::Vector3d v1 = mesh.geometry().node(i1) - p0;
-    Eigen::Vector3d v2 = mesh.geometry().node(i2) - p0;
-    Eigen::Vector3d v3 = mesh.geometry().node(i3) - p0;
+    const Eigen::Vector3d p0 = p.row(edges[i][0]).transpose();
+    Eigen::Vector3d v1 = p.row(edges[i][1]).transpose() - p0;
+    Eigen::Vector3d v2 = p.row(edges[5 - i][0]).transpose() - p0;
+    Eigen::Vector3d v3 = p.row(edges[5 - i][1]).transpose() - p0;
 
     v1 /= v1.norm();
     v2 /= v2.norm();
@@ -55,68 +54,215 @@ std::array<double, 6> MeshQuality::dihedral_angles(const MeshEntity& cell)
   return dh_angle;
 }
 //-----------------------------------------------------------------------------
-std::array<double, 2> MeshQuality::dihedral_angles_min_max(const Mesh& mesh)
+// Quality metrics accumulated over a range of cells (local to one rank)
+struct LocalQuality
 {
-  // Get start min/max
-  double d_ang_min = 3.14 + 1.0;
-  double d_ang_max = -1.0;
+  std::array<double, 2> radius_ratio
+      = {std::numeric_limits<double>::max(),
+         std::numeric_limits<double>::lowest()};
+  std::array<double, 2> dihedral_angle = {M_PI + 1.0, -1.0};
+  std::vector<std::int64_t> hist;
+};
+//-----------------------------------------------------------------------------
+// Compute radius ratio extrema, dihedral angle extrema and the local
+// dihedral angle histogram in one pass over the cells, split across
+// the configured worker threads. Ghost cells contribute to the extrema
+// but not to the histogram, so the global bin counts count each cell
+// exactly once.
+LocalQuality fused_quality(const Mesh& mesh, GeometryCache& cache,
+                           int num_bins)
+{
+  const mesh::CellType type = mesh.topology().cell_type();
+  if (!mesh::is_simplex(type))
+  {
+    throw std::runtime_error(
+        "Mesh quality metrics not implemented for non-simplicial cells");
+  }
 
   const int tdim = mesh.topology().dim();
+  mesh.topology_mutable().create_entities(tdim - 1);
+  mesh.topology_mutable().create_connectivity(tdim, tdim - 1);
+
   auto map = mesh.topology().index_map(tdim);
   assert(map);
-  const int num_cells = map->size_local() + map->num_ghosts();
-  for (int c = 0; c < num_cells; ++c)
+  const std::int32_t num_cells = map->size_local() + map->num_ghosts();
+  const std::int32_t num_owned = map->size_local();
+
+  // Per-entity quantities, computed (or reused) by the cache with the
+  // fill loops split over the worker threads
+  const Eigen::ArrayXd& volume = cache.volumes(mesh, tdim);
+  const Eigen::ArrayXd& facet_volume = cache.volumes(mesh, tdim - 1);
+  const Eigen::ArrayXd& circumradius = cache.circumradii(mesh, tdim);
+
+  auto c_to_f = mesh.topology().connectivity(tdim, tdim - 1);
+  assert(c_to_f);
+
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = mesh.geometry().x();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+
+  const double interval = M_PI / static_cast<double>(num_bins);
+
+  auto scan = [&](std::int32_t c_begin, std::int32_t c_end, LocalQuality& q) {
+    q.hist.assign(num_bins, 0);
+    for (std::int32_t c = c_begin; c < c_end; ++c)
+    {
+      // Radius ratio: dim * inradius / circumradius, with inradius
+      // dim * V / (sum of facet volumes)
+      double ratio = 0.0;
+      if (volume[c] != 0.0 and circumradius[c] != 0.0)
+      {
+        auto facets = c_to_f->links(c);
+        double A = 0.0;
+        for (int i = 0; i <= tdim; ++i)
+          A += facet_volume[facets[i]];
+        ratio = tdim * (tdim * volume[c] / A) / circumradius[c];
+      }
+      q.radius_ratio[0] = std::min(q.radius_ratio[0], ratio);
+      q.radius_ratio[1] = std::max(q.radius_ratio[1], ratio);
+
+      if (tdim == 3)
+      {
+        auto x_dofs = x_dofmap.links(c);
+        Eigen::Matrix<double, 4, 3, Eigen::RowMajor> p;
+        for (int i = 0; i < 4; ++i)
+          p.row(i) = x.row(x_dofs[i]);
+        const std::array<double, 6> angles = dihedral_angles_from_points(p);
+        for (double a : angles)
+        {
+          q.dihedral_angle[0] = std::min(q.dihedral_angle[0], a);
+          q.dihedral_angle[1] = std::max(q.dihedral_angle[1], a);
+          if (c < num_owned)
+          {
+            // Compute bin index, handling the special case angle = Pi
+            const int slot
+                = std::min(static_cast<int>(a / interval), num_bins - 1);
+            q.hist[slot] += 1;
+          }
+        }
+      }
+    }
+  };
+
+  // Scan the cells across the configured worker threads and merge the
+  // per-chunk accumulators
+  LocalQuality q;
+  const int num_threads = common::num_worker_threads();
+  if (num_threads <= 1 or num_cells < 1024)
+    scan(0, num_cells, q);
+  else
   {
-    // Get the angles from the next cell
-    std::array<double, 6> angles = dihedral_angles(MeshEntity(mesh, tdim, c));
-
-    // And then update the min and max
-    d_ang_min
-        = std::min(d_ang_min, *std::min_element(angles.begin(), angles.end()));
-    d_ang_max
-        = std::max(d_ang_max, *std::max_element(angles.begin(), angles.end()));
+    const std::int32_t chunk = (num_cells + num_threads - 1) / num_threads;
+    std::vector<LocalQuality> chunks(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+      const std::int32_t begin = t * chunk;
+      const std::int32_t end = std::min(num_cells, begin + chunk);
+      if (begin < end)
+        threads.emplace_back(scan, begin, end, std::ref(chunks[t]));
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+
+    q.hist.assign(num_bins, 0);
+    for (const LocalQuality& qc : chunks)
+    {
+      q.radius_ratio[0] = std::min(q.radius_ratio[0], qc.radius_ratio[0]);
+      q.radius_ratio[1] = std::max(q.radius_ratio[1], qc.radius_ratio[1]);
+      q.dihedral_angle[0] = std::min(q.dihedral_angle[0], qc.dihedral_angle[0]);
+      q.dihedral_angle[1] = std::max(q.dihedral_angle[1], qc.dihedral_angle[1]);
+      for (int i = 0; i < num_bins; ++i)
+        q.hist[i] += qc.hist.empty() ? 0 : qc.hist[i];
+    }
   }
-  return {{d_ang_min, d_ang_max}};
+
+  return q;
 }
 //-----------------------------------------------------------------------------
-std::pair<std::vector<double>, std::vector<std::int64_t>>
-MeshQuality::dihedral_angle_histogram_data(const Mesh& mesh, int num_bins)
+// Midpoint of each histogram bin on [0, Pi]
+std::vector<double> histogram_bins(int num_bins)
 {
+  const double interval = M_PI / static_cast<double>(num_bins);
   std::vector<double> bins(num_bins);
-  std::vector<std::int64_t> values(num_bins, 0);
-
-  // Currently min value is 0.0 and max is Pi
-  const double interval = M_PI / (static_cast<double>(num_bins));
-
   for (int i = 0; i < num_bins; ++i)
     bins[i] = static_cast<double>(i) * interval + interval / 2.0;
+  return bins;
+}
+//-----------------------------------------------------------------------------
+} // namespace
 
-  const int tdim = mesh.topology().dim();
-  auto map = mesh.topology().index_map(tdim);
-  assert(map);
-  const int num_cells = map->size_local() + map->num_ghosts();
-  for (int c = 0; c < num_cells; ++c)
-  {
-    // this one should return the value of the angle
-    std::array<double, 6> angles = dihedral_angles(MeshEntity(mesh, tdim, c));
+//-----------------------------------------------------------------------------
+MeshQuality::QualityData
+MeshQuality::quality_data(const Mesh& mesh, GeometryCache& cache, int num_bins)
+{
+  LocalQuality q = fused_quality(mesh, cache, num_bins);
 
-    // Iterate through the collected vector
-    for (std::size_t i = 0; i < angles.size(); i++)
-    {
-      // Compute 'bin' index, and handle special case that angle = Pi
-      const int slot
-          = std::min(static_cast<int>(angles[i] / interval), num_bins - 1);
-      values[slot] += 1;
-    }
-  }
+  // Reduce the extrema in one call, flipping the sign of the maxima so
+  // MPI_MIN covers all four values
+  std::array<double, 4> extrema = {q.radius_ratio[0], q.dihedral_angle[0],
+                                   -q.radius_ratio[1], -q.dihedral_angle[1]};
+  MPI_Allreduce(MPI_IN_PLACE, extrema.data(), 4, MPI_DOUBLE, MPI_MIN,
+                mesh.mpi_comm());
+  MPI_Allreduce(MPI_IN_PLACE, q.hist.data(), num_bins, MPI_INT64_T, MPI_SUM,
+                mesh.mpi_comm());
 
-  // FIXME: This is terrible. Avoid MPI calls inside loop.
-  for (std::size_t i = 0; i < values.size(); ++i)
+  QualityData data;
+  data.radius_ratio = {extrema[0], -extrema[2]};
+  data.dihedral_angle = {extrema[1], -extrema[3]};
+  data.bins = histogram_bins(num_bins);
+  data.values = std::move(q.hist);
+  return data;
+}
+//-----------------------------------------------------------------------------
+MeshQuality::QualityData MeshQuality::quality_data(const Mesh& mesh,
+                                                   int num_bins)
+{
+  GeometryCache cache;
+  return quality_data(mesh, cache, num_bins);
+}
+//-----------------------------------------------------------------------------
+std::array<double, 2> MeshQuality::radius_ratio_min_max(const Mesh& mesh)
+{
+  GeometryCache cache;
+  return fused_quality(mesh, cache, 1).radius_ratio;
+}
+//-----------------------------------------------------------------------------
+std::array<double, 6> MeshQuality::dihedral_angles(const MeshEntity& cell)
+{
+  if (cell.dim() != 3)
   {
-    std::int64_t value = values[i];
-    MPI_Allreduce(&values[i], &value, 1, MPI_INT64_T, MPI_SUM, mesh.mpi_comm());
+    throw std::runtime_error(
+        "Calculation of dihedral angle only supported for 3D cells.");
   }
 
-  return {bins, values};
+  const Mesh& mesh = cell.mesh();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = mesh.geometry().x();
+  auto x_dofs = mesh.geometry().dofmap().links(cell.index());
+
+  Eigen::Matrix<double, 4, 3, Eigen::RowMajor> p;
+  for (int i = 0; i < 4; ++i)
+    p.row(i) = x.row(x_dofs[i]);
+
+  return dihedral_angles_from_points(p);
+}
+//-----------------------------------------------------------------------------
+std::array<double, 2> MeshQuality::dihedral_angles_min_max(const Mesh& mesh)
+{
+  GeometryCache cache;
+  return fused_quality(mesh, cache, 1).dihedral_angle;
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<double>, std::vector<std::int64_t>>
+MeshQuality::dihedral_angle_histogram_data(const Mesh& mesh, int num_bins)
+{
+  GeometryCache cache;
+  LocalQuality q = fused_quality(mesh, cache, num_bins);
+
+  MPI_Allreduce(MPI_IN_PLACE, q.hist.data(), num_bins, MPI_INT64_T, MPI_SUM,
+                mesh.mpi_comm());
+
+  return {histogram_bins(num_bins), std::move(q.hist)};
 }
 //-----------------------------------------------------------------------------
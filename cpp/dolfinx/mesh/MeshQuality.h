@@ -13,6 +13,7 @@
 
 namespace dolfinx::mesh
 {
+class GeometryCache;
 class Mesh;
 class MeshEntity;
 
@@ -21,6 +22,46 @@ class MeshEntity;
 class MeshQuality
 {
 public:
+  /// Quality metrics for all cells of a mesh, collected in a single
+  /// pass (see quality_data)
+  struct QualityData
+  {
+    /// Minimum and maximum radius ratio across all processes
+    std::array<double, 2> radius_ratio;
+
+    /// Minimum and maximum dihedral angle across all processes (3D
+    /// meshes only)
+    std::array<double, 2> dihedral_angle;
+
+    /// Midpoint of each dihedral angle histogram bin (3D meshes only)
+    std::vector<double> bins;
+
+    /// Global number of angles in each histogram bin, counting owned
+    /// cells only (3D meshes only)
+    std::vector<std::int64_t> values;
+  };
+
+  /// Compute all quality metrics (radius ratio extrema, dihedral angle
+  /// extrema and histogram) in one thread-parallel pass over the
+  /// cells, reusing cached entity volumes and circumradii. The global
+  /// values are formed with two MPI reductions, so the cost per check
+  /// is deterministic. Use this instead of the individual functions
+  /// below when more than one metric is needed.
+  /// @param[in] mesh The mesh
+  /// @param[in] cache Cache of geometric quantities, reused if already
+  ///     filled for this mesh
+  /// @param[in] num_bins Number of dihedral angle histogram bins
+  /// @return The collected quality metrics
+  static QualityData quality_data(const Mesh& mesh, GeometryCache& cache,
+                                  int num_bins = 50);
+
+  /// Compute all quality metrics with a temporary geometry cache (see
+  /// the overload taking a GeometryCache)
+  /// @param[in] mesh The mesh
+  /// @param[in] num_bins Number of dihedral angle histogram bins
+  /// @return The collected quality metrics
+  static QualityData quality_data(const Mesh& mesh, int num_bins = 50);
+
   /// Compute the minimum and maximum radius ratio of cells (for local
   /// rank only )
   /// @param[in] mesh The mesh
@@ -34,6 +75,7 @@ public:
   static std::array<double, 6> dihedral_angles(const mesh::MeshEntity& cell);
 
   /// Get internal minimum and maximum dihedral angles of a 3D mesh
+  /// (for local rank only)
   static std::array<double, 2> dihedral_angles_min_max(const Mesh& mesh);
 
   /// Create (dihedral angles, number of cells) data for creating a
@@ -16,8 +16,9 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/Partitioning.h>
 #include <dolfinx/io/cells.h>
-#include <map>
 #include <memory>
+#include <numeric>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -39,8 +40,9 @@ public:
   /// Create from entities of given dimension on a mesh
   /// @param[in] mesh The mesh on which the tags are associated
   /// @param[in] dim Topological dimension of mesh entities to tag
-  /// @param[in] indices std::vector<std::int32> of sorted and unique
-  ///   entity indices (indices local to the process)
+  /// @param[in] indices std::vector<std::int32> of entity indices
+  ///   (indices local to the process). Sorted on input if required, so
+  ///   MeshTags::indices() is always sorted and unique.
   /// @param[in] values std::vector<T> of values for each index in
   ///   indices. The size must be equal to the size of @p indices.
   template <typename U, typename V>
@@ -49,17 +51,21 @@ public:
       : _mesh(mesh), _dim(dim), _indices(std::forward<U>(indices)),
         _values(std::forward<V>(values))
   {
-    if (indices.size() != values.size())
+    if (_indices.size() != _values.size())
     {
       throw std::runtime_error(
           "Indices and values arrays must have same size.");
     }
-#ifdef DEBUG
-    if (!std::is_sorted(_indices.begin(), _indices.end()))
-      throw std::runtime_error("MeshTag data is not sorted");
-    if (std::adjacent_find(_indices.begin(), _indices.end()) != _indices.end())
-      throw std::runtime_error("MeshTag data has duplicates");
-#endif
+
+    // Establish the sorted-by-index invariant
+    if (!std::is_sorted(_indices.begin(), _indices.end())
+        or std::adjacent_find(_indices.begin(), _indices.end())
+               != _indices.end())
+    {
+      std::tie(_indices, _values) = common::sort_unique(_indices, _values);
+    }
+
+    build_value_index();
   }
 
   /// Copy constructor
@@ -77,19 +83,26 @@ public:
   /// Move assignment
   MeshTags& operator=(MeshTags&& tags) = default;
 
-  /// Find all entities with a given tag value
+  /// Find all entities with a given tag value. The lookup uses an
+  /// inverted value -> entities index built at construction, so the
+  /// cost is logarithmic in the number of distinct values.
   /// @param[in] value The value
-  /// @return Indices of tagged entities
+  /// @return Indices of tagged entities, sorted
   const Eigen::Array<std::int32_t, Eigen::Dynamic, 1> find(const T value) const
   {
-    int n = std::count(_values.begin(), _values.end(), value);
-    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> indices(n);
-    int counter = 0;
-    for (std::int32_t i = 0; i < _values.size(); ++i)
-    {
-      if (_values[i] == value)
-        indices[counter++] = _indices[i];
-    }
+    auto it = std::lower_bound(
+        _value_offsets.begin(), _value_offsets.end(), value,
+        [](const auto& a, const T& b) { return a.first < b; });
+    if (it == _value_offsets.end() or it->first != value)
+      return Eigen::Array<std::int32_t, Eigen::Dynamic, 1>();
+
+    const std::int32_t begin = it->second;
+    const std::int32_t end = std::next(it) != _value_offsets.end()
+                                 ? std::next(it)->second
+                                 : (std::int32_t)_by_value.size();
+    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> indices(end - begin);
+    for (std::int32_t p = begin; p < end; ++p)
+      indices[p - begin] = _indices[_by_value[p]];
     return indices;
   }
 
@@ -113,6 +126,28 @@ public:
   std::size_t id() const { return _unique_id; }
 
 private:
+  // Build the inverted index used by find(): positions into
+  // _indices/_values grouped by tag value (values ascending, entity
+  // indices ascending within a group), with the start of each group
+  // recorded in _value_offsets
+  void build_value_index()
+  {
+    _by_value.resize(_indices.size());
+    std::iota(_by_value.begin(), _by_value.end(), 0);
+    std::sort(_by_value.begin(), _by_value.end(),
+              [this](std::int32_t a, std::int32_t b) {
+                return _values[a] != _values[b] ? _values[a] < _values[b]
+                                                : _indices[a] < _indices[b];
+              });
+
+    _value_offsets.clear();
+    for (std::size_t p = 0; p < _by_value.size(); ++p)
+    {
+      if (p == 0 or _values[_by_value[p]] != _values[_by_value[p - 1]])
+        _value_offsets.push_back({_values[_by_value[p]], (std::int32_t)p});
+    }
+  }
+
   // Unique identifier
   std::size_t _unique_id = common::UniqueIdGenerator::id();
 
@@ -127,6 +162,13 @@ private:
 
   // Values attached to entities
   std::vector<T> _values;
+
+  // Positions into _indices/_values, grouped by tag value
+  std::vector<std::int32_t> _by_value;
+
+  // For each distinct tag value (ascending), the position in _by_value
+  // where its group starts
+  std::vector<std::pair<T, std::int32_t>> _value_offsets;
 };
 
 /// Create MeshTags from arrays
@@ -156,39 +198,74 @@ create_meshtags(const std::shared_ptr<const mesh::Mesh>& mesh, const int dim,
   const int num_vertices_per_entity = e_to_v->num_links(0);
   const int num_entities_mesh = map_e->size_local() + map_e->num_ghosts();
 
-  std::map<std::vector<std::int32_t>, std::int32_t> entity_key_to_index;
-  std::vector<std::int32_t> key(num_vertices_per_entity);
+  // Build flat arrays of entity keys (the sorted vertex tuple of each
+  // entity), one for the mesh entities and one for the received
+  // entities, order both lexicographically and merge-join them. This
+  // replaces the per-entity lookups in a map keyed on
+  // std::vector<std::int32_t>, and their allocations.
+  const int nv = num_vertices_per_entity;
+  std::vector<std::int32_t> keys_mesh(std::size_t(num_entities_mesh) * nv);
   for (int e = 0; e < num_entities_mesh; ++e)
   {
-    // Prepare a map from ordered local vertex indices to local entity number
-    // This map is used to identify if received entity is owned or ghost
     auto vertices = e_to_v->links(e);
-    for (int v = 0; v < vertices.rows(); ++v)
-      key[v] = vertices[v];
-    std::sort(key.begin(), key.end());
-    entity_key_to_index.insert({key, e});
+    std::copy(vertices.data(), vertices.data() + nv,
+              keys_mesh.begin() + std::size_t(e) * nv);
+    std::sort(keys_mesh.begin() + std::size_t(e) * nv,
+              keys_mesh.begin() + std::size_t(e + 1) * nv);
   }
 
-  // Iterate over all received entities. If entity is on this rank,
-  // store (local entity index, tag value)
-  std::vector<std::int32_t> indices_new;
-  std::vector<T> values_new;
-  std::vector<std::int32_t> entity(num_vertices_per_entity);
-
-  for (Eigen::Index e = 0; e < entities.num_nodes(); ++e)
+  const std::int32_t num_entities_recv = entities.num_nodes();
+  std::vector<std::int32_t> keys_recv(std::size_t(num_entities_recv) * nv);
+  for (std::int32_t e = 0; e < num_entities_recv; ++e)
   {
     // This would fail for mixed cell type meshes
     assert(num_vertices_per_entity == entities.num_links(e));
-    std::copy(entities.links(e).data(),
-              entities.links(e).data() + num_vertices_per_entity,
-              entity.begin());
-    std::sort(entity.begin(), entity.end());
+    std::copy(entities.links(e).data(), entities.links(e).data() + nv,
+              keys_recv.begin() + std::size_t(e) * nv);
+    std::sort(keys_recv.begin() + std::size_t(e) * nv,
+              keys_recv.begin() + std::size_t(e + 1) * nv);
+  }
+
+  auto compare_keys = [nv](const std::int32_t* keys) {
+    return [keys, nv](std::int32_t a, std::int32_t b) {
+      return std::lexicographical_compare(
+          keys + std::size_t(a) * nv, keys + std::size_t(a + 1) * nv,
+          keys + std::size_t(b) * nv, keys + std::size_t(b + 1) * nv);
+    };
+  };
+  std::vector<std::int32_t> perm_mesh(num_entities_mesh);
+  std::iota(perm_mesh.begin(), perm_mesh.end(), 0);
+  std::sort(perm_mesh.begin(), perm_mesh.end(),
+            compare_keys(keys_mesh.data()));
+  std::vector<std::int32_t> perm_recv(num_entities_recv);
+  std::iota(perm_recv.begin(), perm_recv.end(), 0);
+  std::sort(perm_recv.begin(), perm_recv.end(),
+            compare_keys(keys_recv.data()));
 
-    if (const auto it = entity_key_to_index.find(entity);
-        it != entity_key_to_index.end())
+  // Merge-join: received entities found on this rank give (local
+  // entity index, tag value)
+  std::vector<std::int32_t> indices_new;
+  std::vector<T> values_new;
+  std::size_t i = 0, j = 0;
+  while (i < perm_mesh.size() and j < perm_recv.size())
+  {
+    const std::int32_t* key_mesh
+        = keys_mesh.data() + std::size_t(perm_mesh[i]) * nv;
+    const std::int32_t* key_recv
+        = keys_recv.data() + std::size_t(perm_recv[j]) * nv;
+    if (std::lexicographical_compare(key_mesh, key_mesh + nv, key_recv,
+                                     key_recv + nv))
+      ++i;
+    else if (std::lexicographical_compare(key_recv, key_recv + nv, key_mesh,
+                                          key_mesh + nv))
+      ++j;
+    else
     {
-      indices_new.push_back(it->second);
-      values_new.push_back(values[e]);
+      // Match. Keep the mesh cursor: several received entities may
+      // carry the same key.
+      indices_new.push_back(perm_mesh[i]);
+      values_new.push_back(values[perm_recv[j]]);
+      ++j;
     }
   }
 
@@ -8,24 +8,250 @@
 #include "Mesh.h"
 #include "Topology.h"
 #include "cell_types.h"
+#include <algorithm>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/check.h>
 #include <dolfinx/common/log.h>
+#include <cstdlib>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/SCOTCH.h>
 #include <dolfinx/mesh/GraphBuilder.h>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::mesh;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Path of this rank's partition cache sidecar file, or an empty string
+// when caching is disabled (DOLFINX_PARTITION_CACHE not set). The key
+// is a global hash of the distributed cell array combined with the
+// number of parts, so re-runs on identical input data with the same
+// rank count map to the same sidecar files.
+std::string partition_cache_path(MPI_Comm comm, int n,
+                                 const graph::AdjacencyList<std::int64_t>& cells)
+{
+  const char* dir = std::getenv("DOLFINX_PARTITION_CACHE");
+  if (!dir)
+    return "";
+
+  // Combine the per-rank data hashes into a global key (same pattern
+  // as common::hash_global)
+  std::int64_t local_hash = cells.hash();
+  std::vector<std::int64_t> all_hashes(dolfinx::MPI::size(comm));
+  MPI_Gather(&local_hash, 1, MPI_INT64_T, all_hashes.data(), 1, MPI_INT64_T, 0,
+             comm);
+  boost::hash<std::vector<std::int64_t>> hash;
+  std::int64_t global_hash = hash(all_hashes);
+  MPI_Bcast(&global_hash, 1, MPI_INT64_T, 0, comm);
+
+  std::ostringstream s;
+  s << dir << "/partition-" << std::hex
+    << static_cast<std::uint64_t>(global_hash) << std::dec << "-np" << n
+    << "-r" << dolfinx::MPI::rank(comm) << ".bin";
+  return s.str();
+}
+//-----------------------------------------------------------------------------
+// Load this rank's cached partition. Returns false (leaving dest
+// untouched) if the file is missing, malformed, or does not match the
+// local cell count.
+bool read_cached_partition(const std::string& path, std::int32_t num_cells,
+                           graph::AdjacencyList<std::int32_t>& dest)
+{
+  std::ifstream f(path, std::ios::binary);
+  if (!f)
+    return false;
+
+  std::int64_t num_nodes = -1, num_links = -1;
+  f.read(reinterpret_cast<char*>(&num_nodes), sizeof(num_nodes));
+  f.read(reinterpret_cast<char*>(&num_links), sizeof(num_links));
+  if (!f or num_nodes != num_cells or num_links < 0)
+    return false;
+
+  std::vector<std::int32_t> offsets(num_nodes + 1);
+  std::vector<std::int32_t> array(num_links);
+  f.read(reinterpret_cast<char*>(offsets.data()),
+         offsets.size() * sizeof(std::int32_t));
+  f.read(reinterpret_cast<char*>(array.data()),
+         array.size() * sizeof(std::int32_t));
+  if (!f)
+    return false;
+
+  dest = graph::AdjacencyList<std::int32_t>(std::move(array),
+                                            std::move(offsets));
+  return true;
+}
+//-----------------------------------------------------------------------------
+// Store this rank's partition in its sidecar file. Failure to write is
+// not an error (the cache is best-effort).
+void write_cached_partition(const std::string& path,
+                            const graph::AdjacencyList<std::int32_t>& dest)
+{
+  std::ofstream f(path, std::ios::binary);
+  if (!f)
+  {
+    LOG(WARNING) << "Could not write partition cache file \"" << path << "\"";
+    return;
+  }
+
+  const std::int64_t num_nodes = dest.num_nodes();
+  const std::int64_t num_links = dest.array().size();
+  f.write(reinterpret_cast<const char*>(&num_nodes), sizeof(num_nodes));
+  f.write(reinterpret_cast<const char*>(&num_links), sizeof(num_links));
+  f.write(reinterpret_cast<const char*>(dest.offsets().data()),
+          dest.offsets().size() * sizeof(std::int32_t));
+  f.write(reinterpret_cast<const char*>(dest.array().data()),
+          dest.array().size() * sizeof(std::int32_t));
+}
+//-----------------------------------------------------------------------------
+// For each local cell, the destination (owner) rank of each of its
+// dual-graph neighbours, in the order of the dual graph adjacency
+// lists. Destinations of remote neighbours are fetched from the rank
+// holding them in one exchange round-trip; owners are located from the
+// global cell distribution of the input.
+graph::AdjacencyList<std::int32_t> neighbour_destinations(
+    MPI_Comm comm, const std::vector<std::vector<std::int64_t>>& dual_graph,
+    const std::vector<std::int32_t>& dest)
+{
+  const int mpi_size = dolfinx::MPI::size(comm);
+
+  // Global cell distribution of the input
+  const std::int64_t num_local = dest.size();
+  std::vector<std::int64_t> cell_offsets(mpi_size + 1, 0);
+  MPI_Allgather(&num_local, 1, MPI_INT64_T, cell_offsets.data() + 1, 1,
+                MPI_INT64_T, comm);
+  std::partial_sum(cell_offsets.begin(), cell_offsets.end(),
+                   cell_offsets.begin());
+  const std::int64_t offset = cell_offsets[dolfinx::MPI::rank(comm)];
+
+  // Request the destination of each remote neighbour from its owner
+  std::vector<std::vector<std::int64_t>> send_req(mpi_size);
+  for (const std::vector<std::int64_t>& nbrs : dual_graph)
+  {
+    for (const std::int64_t nbr : nbrs)
+    {
+      if (nbr < offset or nbr >= offset + num_local)
+      {
+        const int owner = std::distance(cell_offsets.begin(),
+                                        std::upper_bound(cell_offsets.begin(),
+                                                         cell_offsets.end(), nbr))
+                          - 1;
+        send_req[owner].push_back(nbr);
+      }
+    }
+  }
+  const graph::AdjacencyList<std::int64_t> recv_req = dolfinx::MPI::all_to_all(
+      comm, graph::AdjacencyList<std::int64_t>(send_req));
+
+  // Reply with the destination of each requested cell, in the order
+  // requested per source rank
+  std::vector<std::vector<std::int32_t>> reply(mpi_size);
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    auto req = recv_req.links(r);
+    for (Eigen::Index k = 0; k < req.rows(); ++k)
+      reply[r].push_back(dest[req[k] - offset]);
+  }
+  const graph::AdjacencyList<std::int32_t> recv_reply = dolfinx::MPI::all_to_all(
+      comm, graph::AdjacencyList<std::int32_t>(reply));
+
+  // Fill the output, popping remote destinations in request order
+  std::vector<std::int32_t> cursor(mpi_size, 0);
+  std::vector<std::int32_t> data;
+  std::vector<std::int32_t> offsets = {0};
+  for (const std::vector<std::int64_t>& nbrs : dual_graph)
+  {
+    for (const std::int64_t nbr : nbrs)
+    {
+      if (nbr >= offset and nbr < offset + num_local)
+        data.push_back(dest[nbr - offset]);
+      else
+      {
+        const int owner = std::distance(cell_offsets.begin(),
+                                        std::upper_bound(cell_offsets.begin(),
+                                                         cell_offsets.end(), nbr))
+                          - 1;
+        data.push_back(recv_reply.links(owner)[cursor[owner]++]);
+      }
+    }
+    offsets.push_back(data.size());
+  }
+
+  return graph::AdjacencyList<std::int32_t>(data, offsets);
+}
+//-----------------------------------------------------------------------------
+// Expected number of ghost cells on every rank for a given partition:
+// each cell is counted once per distinct remote rank among its
+// dual-graph neighbours. Each cell has exactly one input owner, so the
+// per-rank contributions sum to the global count without duplicates.
+std::vector<std::int32_t>
+count_expected_ghosts(MPI_Comm comm, const std::vector<std::int32_t>& dest,
+                      const graph::AdjacencyList<std::int32_t>& nbr_dest)
+{
+  const int mpi_size = dolfinx::MPI::size(comm);
+  std::vector<std::int32_t> num_ghosts(mpi_size, 0);
+  std::vector<std::int32_t> parts;
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    auto nbrs = nbr_dest.links(i);
+    parts.assign(nbrs.data(), nbrs.data() + nbrs.rows());
+    std::sort(parts.begin(), parts.end());
+    parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+    for (const std::int32_t q : parts)
+    {
+      if (q != dest[i])
+        ++num_ghosts[q];
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, num_ghosts.data(), mpi_size, MPI_INT32_T, MPI_SUM,
+                comm);
+  return num_ghosts;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 graph::AdjacencyList<std::int32_t> Partitioning::partition_cells(
     MPI_Comm comm, int n, const mesh::CellType cell_type,
     const graph::AdjacencyList<std::int64_t>& cells, mesh::GhostMode ghost_mode)
+{
+  return partition_cells(comm, n, cell_type, cells, {}, ghost_mode);
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> Partitioning::partition_cells(
+    MPI_Comm comm, int n, const mesh::CellType cell_type,
+    const graph::AdjacencyList<std::int64_t>& cells,
+    const std::vector<std::size_t>& cell_weights, mesh::GhostMode ghost_mode)
+{
+  return partition_cells(comm, n, cell_type, cells, cell_weights,
+                         PartitionObjective::edge_cut, ghost_mode);
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> Partitioning::partition_cells(
+    MPI_Comm comm, int n, const mesh::CellType cell_type,
+    const graph::AdjacencyList<std::int64_t>& cells,
+    const std::vector<std::size_t>& cell_weights, PartitionObjective objective,
+    mesh::GhostMode ghost_mode)
 {
   common::Timer timer("Partition cells across processes");
   LOG(INFO) << "Compute partition of cells across processes";
 
+  if (!cell_weights.empty()
+      and cell_weights.size() != (std::size_t)cells.num_nodes())
+  {
+    throw std::runtime_error("Cell weight array size does not match number "
+                             "of local cells");
+  }
+
   if (cells.num_nodes() > 0)
   {
     if (cells.num_links(0) != mesh::num_cell_vertices(cell_type))
@@ -37,6 +263,30 @@ graph::AdjacencyList<std::int32_t> Partitioning::partition_cells(
     }
   }
 
+  // Optional on-disk partition cache, keyed by the mesh data and the
+  // number of parts (set DOLFINX_PARTITION_CACHE to a directory to
+  // enable). A hit on all ranks skips the dual graph construction and
+  // the graph partitioner entirely. The cache key does not cover cell
+  // weights or the objective, so the cache is bypassed for weighted
+  // partitions and for non-default objectives.
+  const std::string cache_path
+      = (cell_weights.empty() and objective == PartitionObjective::edge_cut)
+            ? partition_cache_path(comm, n, cells)
+            : std::string();
+  if (!cache_path.empty())
+  {
+    graph::AdjacencyList<std::int32_t> dest(0);
+    const int hit
+        = read_cached_partition(cache_path, cells.num_nodes(), dest) ? 1 : 0;
+    int all_hit = 0;
+    MPI_Allreduce(&hit, &all_hit, 1, MPI_INT, MPI_MIN, comm);
+    if (all_hit == 1)
+    {
+      LOG(INFO) << "Loaded cell partition from cache";
+      return dest;
+    }
+  }
+
   // FIXME: Update GraphBuilder to use AdjacencyList
   // Wrap AdjacencyList
   const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
@@ -53,15 +303,353 @@ graph::AdjacencyList<std::int32_t> Partitioning::partition_cells(
       = graph_info;
 
   graph::AdjacencyList<SCOTCH_Num> adj_graph(dual_graph);
-  std::vector<std::size_t> weights;
 
   // Just flag any kind of ghosting for now
   bool ghosting = (ghost_mode != mesh::GhostMode::none);
 
-  // Call partitioner
+  // Call partitioner, balancing the summed cell weight per rank when
+  // weights are provided
   graph::AdjacencyList<std::int32_t> partition = graph::SCOTCH::partition(
-      comm, n, adj_graph, weights, num_ghost_nodes, ghosting);
+      comm, n, adj_graph, cell_weights, num_ghost_nodes, ghosting);
+
+  if (objective == PartitionObjective::ghost_cells)
+  {
+    // Neither SCOTCH nor ParMETIS exposes a communication volume
+    // objective through the interfaces used here, so refine the
+    // edge-cut partition with a greedy boundary pass: move a cell to
+    // the dominant rank among its dual-graph neighbours when this
+    // reduces the number of distinct remote ranks it is ghosted to.
+    // Moves are capped at 5% of the local cells to preserve the load
+    // balance achieved by the partitioner.
+    const std::int32_t num_cells = cells.num_nodes();
+    std::vector<std::int32_t> dest(num_cells);
+    for (std::int32_t i = 0; i < num_cells; ++i)
+      dest[i] = partition.links(i)[0];
+
+    graph::AdjacencyList<std::int32_t> nbr_dest
+        = neighbour_destinations(comm, dual_graph, dest);
+
+    // Candidate moves (gain, cell, new rank), where the gain is the
+    // reduction in the number of ranks this cell is ghosted to
+    std::vector<std::array<std::int32_t, 3>> moves;
+    std::vector<std::int32_t> parts;
+    for (std::int32_t i = 0; i < num_cells; ++i)
+    {
+      auto nbrs = nbr_dest.links(i);
+      parts.assign(nbrs.data(), nbrs.data() + nbrs.rows());
+      std::sort(parts.begin(), parts.end());
+
+      // Most frequent neighbour rank
+      std::int32_t p = dest[i];
+      std::int32_t p_count = 0;
+      for (std::size_t k = 0; k < parts.size();)
+      {
+        std::size_t k1 = k;
+        while (k1 < parts.size() and parts[k1] == parts[k])
+          ++k1;
+        if ((std::int32_t)(k1 - k) > p_count)
+        {
+          p = parts[k];
+          p_count = k1 - k;
+        }
+        k = k1;
+      }
+      if (p == dest[i])
+        continue;
+
+      parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+      std::int32_t cost_cur = 0, cost_new = 0;
+      for (const std::int32_t q : parts)
+      {
+        cost_cur += (q != dest[i]) ? 1 : 0;
+        cost_new += (q != p) ? 1 : 0;
+      }
+      if (cost_cur > cost_new)
+        moves.push_back({cost_cur - cost_new, i, p});
+    }
+
+    // Apply the best moves first, up to the cap
+    std::sort(moves.begin(), moves.end(),
+              [](const std::array<std::int32_t, 3>& a,
+                 const std::array<std::int32_t, 3>& b) { return a[0] > b[0]; });
+    const std::size_t max_moves = std::max<std::size_t>(1, num_cells / 20);
+    if (moves.size() > max_moves)
+      moves.resize(max_moves);
+    for (const std::array<std::int32_t, 3>& m : moves)
+      dest[m[1]] = m[2];
+
+    // Re-fetch the neighbour destinations to rebuild the ghost
+    // destination lists consistently with the moves on all ranks
+    nbr_dest = neighbour_destinations(comm, dual_graph, dest);
+
+    std::vector<std::int32_t> dests;
+    std::vector<std::int32_t> offsets = {0};
+    for (std::int32_t i = 0; i < num_cells; ++i)
+    {
+      dests.push_back(dest[i]);
+      if (ghosting)
+      {
+        auto nbrs = nbr_dest.links(i);
+        parts.assign(nbrs.data(), nbrs.data() + nbrs.rows());
+        std::sort(parts.begin(), parts.end());
+        parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+        for (const std::int32_t q : parts)
+        {
+          if (q != dest[i])
+            dests.push_back(q);
+        }
+      }
+      offsets.push_back(dests.size());
+    }
+    partition = graph::AdjacencyList<std::int32_t>(dests, offsets);
+
+    // Report the expected ghost load so strategies can be compared
+    // without running the full mesh setup
+    const std::vector<std::int32_t> num_ghosts
+        = count_expected_ghosts(comm, dest, nbr_dest);
+    const auto minmax
+        = std::minmax_element(num_ghosts.begin(), num_ghosts.end());
+    const std::int64_t total
+        = std::accumulate(num_ghosts.begin(), num_ghosts.end(), std::int64_t(0));
+    LOG(INFO) << "Expected ghost cells per rank: min " << *minmax.first
+              << ", max " << *minmax.second << ", mean "
+              << total / (std::int64_t)num_ghosts.size();
+  }
+
+  if (!cache_path.empty())
+    write_cached_partition(cache_path, partition);
 
   return partition;
 }
 //-----------------------------------------------------------------------------
+std::pair<graph::AdjacencyList<std::int64_t>, std::array<std::int32_t, 3>>
+Partitioning::create_dual_graph(MPI_Comm comm, const mesh::CellType cell_type,
+                                const graph::AdjacencyList<std::int64_t>& cells)
+{
+  common::Timer timer("Build dual graph (export)");
+
+  if (cells.num_nodes() > 0
+      and cells.num_links(0) != mesh::num_cell_vertices(cell_type))
+  {
+    throw std::runtime_error(
+        "Inconsistent number of cell vertices. Got "
+        + std::to_string(cells.num_links(0)) + ", expected "
+        + std::to_string(mesh::num_cell_vertices(cell_type)) + ".");
+  }
+
+  // FIXME: Update GraphBuilder to use AdjacencyList
+  // Wrap AdjacencyList
+  const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
+                                      Eigen::Dynamic, Eigen::RowMajor>>
+      _cells(cells.array().data(), cells.num_nodes(),
+             mesh::num_cell_vertices(cell_type));
+
+  const auto [dual_graph, graph_info]
+      = mesh::GraphBuilder::compute_dual_graph(comm, _cells, cell_type);
+  return {graph::AdjacencyList<std::int64_t>(dual_graph), graph_info};
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> Partitioning::compute_expected_ghosts(
+    MPI_Comm comm, const mesh::CellType cell_type,
+    const graph::AdjacencyList<std::int64_t>& cells,
+    const graph::AdjacencyList<std::int32_t>& dest)
+{
+  DOLFINX_ASSERT(dest.num_nodes() == cells.num_nodes());
+
+  const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
+                                      Eigen::Dynamic, Eigen::RowMajor>>
+      _cells(cells.array().data(), cells.num_nodes(),
+             mesh::num_cell_vertices(cell_type));
+  const auto [dual_graph, graph_info]
+      = mesh::GraphBuilder::compute_dual_graph(comm, _cells, cell_type);
+  (void)graph_info;
+
+  std::vector<std::int32_t> dest_owner(cells.num_nodes());
+  for (std::int32_t i = 0; i < cells.num_nodes(); ++i)
+    dest_owner[i] = dest.links(i)[0];
+
+  const graph::AdjacencyList<std::int32_t> nbr_dest
+      = neighbour_destinations(comm, dual_graph, dest_owner);
+  return count_expected_ghosts(comm, dest_owner, nbr_dest);
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> Partitioning::partition_cells_hierarchical(
+    MPI_Comm comm, const mesh::CellType cell_type,
+    const graph::AdjacencyList<std::int64_t>& cells, mesh::GhostMode ghost_mode)
+{
+  common::Timer timer("Partition cells across processes (hierarchical)");
+  LOG(INFO) << "Compute hierarchical two-level partition of cells";
+
+  if (ghost_mode != mesh::GhostMode::none)
+  {
+    throw std::runtime_error(
+        "Hierarchical cell partitioning supports GhostMode::none only.");
+  }
+
+  if (cells.num_nodes() > 0)
+  {
+    if (cells.num_links(0) != mesh::num_cell_vertices(cell_type))
+    {
+      throw std::runtime_error(
+          "Inconsistent number of cell vertices. Got "
+          + std::to_string(cells.num_links(0)) + ", expected "
+          + std::to_string(mesh::num_cell_vertices(cell_type)) + ".");
+    }
+  }
+
+  const int mpi_size = MPI::size(comm);
+  const int mpi_rank = MPI::rank(comm);
+
+  // Discover the node structure: the ranks sharing this node, the
+  // node leader (node-local rank 0) and its global rank
+  MPI_Comm local_comm;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, mpi_rank, MPI_INFO_NULL,
+                      &local_comm);
+  const int node_local_rank = MPI::rank(local_comm);
+  int leader = mpi_rank;
+  MPI_Bcast(&leader, 1, MPI_INT, 0, local_comm);
+  MPI_Comm_free(&local_comm);
+
+  // Gather (leader, node-local rank) for every rank to build a global
+  // node numbering and the member list of each node
+  const std::array<int, 2> my_data = {leader, node_local_rank};
+  std::vector<int> all_data(2 * mpi_size);
+  MPI_Allgather(my_data.data(), 2, MPI_INT, all_data.data(), 2, MPI_INT, comm);
+
+  std::vector<int> leaders;
+  for (int r = 0; r < mpi_size; ++r)
+    leaders.push_back(all_data[2 * r]);
+  std::sort(leaders.begin(), leaders.end());
+  leaders.erase(std::unique(leaders.begin(), leaders.end()), leaders.end());
+  const int num_nodes = leaders.size();
+
+  // Members of each node as (node-local rank, global rank), ordered by
+  // node-local rank
+  std::vector<std::vector<std::pair<int, int>>> members(num_nodes);
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    const auto it
+        = std::lower_bound(leaders.begin(), leaders.end(), all_data[2 * r]);
+    members[std::distance(leaders.begin(), it)].push_back(
+        {all_data[2 * r + 1], r});
+  }
+  for (auto& m : members)
+    std::sort(m.begin(), m.end());
+  const int my_node = std::distance(
+      leaders.begin(), std::lower_bound(leaders.begin(), leaders.end(), leader));
+
+  // Compute distributed dual graph (for the cells on this process)
+  const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
+                                      Eigen::Dynamic, Eigen::RowMajor>>
+      _cells(cells.array().data(), cells.num_nodes(),
+             mesh::num_cell_vertices(cell_type));
+  const auto [dual_graph, graph_info]
+      = mesh::GraphBuilder::compute_dual_graph(comm, _cells, cell_type);
+  const auto [num_ghost_nodes, num_local_edges, num_nonlocal_edges]
+      = graph_info;
+  const std::int32_t num_cells = cells.num_nodes();
+
+  // Level one: partition across nodes, minimising the inter-node cut
+  std::vector<std::int32_t> cell_node(num_cells, 0);
+  if (num_nodes > 1)
+  {
+    graph::AdjacencyList<SCOTCH_Num> adj_graph(dual_graph);
+    std::vector<std::size_t> weights;
+    const graph::AdjacencyList<std::int32_t> node_partition
+        = graph::SCOTCH::partition(comm, num_nodes, adj_graph, weights,
+                                   num_ghost_nodes, false);
+    for (std::int32_t i = 0; i < num_cells; ++i)
+      cell_node[i] = node_partition.links(i)[0];
+  }
+
+  // Global indices of the local cells
+  std::int64_t num_local = num_cells;
+  std::int64_t cell_offset = 0;
+  MPI_Exscan(&num_local, &cell_offset, 1, MPI_INT64_T, MPI_SUM, comm);
+
+  // Level two: send each cell to the leader of its assigned node,
+  // with the dual edges to cells on the same rank and node, packed as
+  // [global index, number of neighbours, neighbours...]. Edges to
+  // cells on other ranks are dropped at this level; within a node the
+  // cut is cheap and the leader still sees the bulk of the subgraph.
+  std::vector<std::vector<std::int64_t>> send_data(mpi_size);
+  for (std::int32_t i = 0; i < num_cells; ++i)
+  {
+    std::vector<std::int64_t>& d = send_data[members[cell_node[i]][0].second];
+    d.push_back(cell_offset + i);
+    d.push_back(0);
+    const std::size_t count_pos = d.size() - 1;
+    for (const std::int64_t nbr : dual_graph[i])
+    {
+      if (nbr >= cell_offset and nbr < cell_offset + num_local
+          and cell_node[nbr - cell_offset] == cell_node[i])
+      {
+        d.push_back(nbr);
+        ++d[count_pos];
+      }
+    }
+  }
+  const graph::AdjacencyList<std::int64_t> recv_data
+      = MPI::all_to_all(comm, graph::AdjacencyList<std::int64_t>(send_data));
+
+  // Leaders index the received cells of their node by global index
+  std::map<std::int64_t, std::int32_t> global_to_sub;
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    auto data = recv_data.links(r);
+    for (Eigen::Index k = 0; k < data.rows(); k += 2 + data[k + 1])
+      global_to_sub.emplace(data[k], 0);
+  }
+  {
+    std::int32_t sub = 0;
+    for (auto& e : global_to_sub)
+      e.second = sub++;
+  }
+
+  // Build the node subgraph and partition it across the node ranks
+  std::vector<std::vector<SCOTCH_Num>> sub_graph(global_to_sub.size());
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    auto data = recv_data.links(r);
+    for (Eigen::Index k = 0; k < data.rows(); k += 2 + data[k + 1])
+    {
+      const std::int32_t sub = global_to_sub[data[k]];
+      for (std::int64_t n = 0; n < data[k + 1]; ++n)
+        sub_graph[sub].push_back(global_to_sub[data[k + 2 + n]]);
+    }
+  }
+  const std::vector<int> sub_partition = graph::SCOTCH::partition_local(
+      graph::AdjacencyList<SCOTCH_Num>(sub_graph), members[my_node].size());
+
+  // Reply with the destination global rank of each received cell, in
+  // the order received per source rank
+  std::vector<std::vector<std::int32_t>> reply(mpi_size);
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    auto data = recv_data.links(r);
+    for (Eigen::Index k = 0; k < data.rows(); k += 2 + data[k + 1])
+    {
+      const std::int32_t sub = global_to_sub[data[k]];
+      reply[r].push_back(members[my_node][sub_partition[sub]].second);
+    }
+  }
+  const graph::AdjacencyList<std::int32_t> dest_data
+      = MPI::all_to_all(comm, graph::AdjacencyList<std::int32_t>(reply));
+
+  // Map the replies back to the local cell order. Cells were sent to
+  // their node leader in ascending order and each leader replies in
+  // the order received.
+  std::vector<std::int32_t> cursor(mpi_size, 0);
+  std::vector<std::int32_t> dests;
+  std::vector<std::int32_t> offsets = {0};
+  for (std::int32_t i = 0; i < num_cells; ++i)
+  {
+    const int lead = members[cell_node[i]][0].second;
+    dests.push_back(dest_data.links(lead)[cursor[lead]++]);
+    offsets.push_back(dests.size());
+  }
+
+  return graph::AdjacencyList<std::int32_t>(dests, offsets);
+}
+//-----------------------------------------------------------------------------
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <utility>
 #include <vector>
 
 namespace dolfinx
@@ -21,6 +23,18 @@ enum class CellType;
 class Topology;
 enum class GhostMode : int;
 
+/// Objective minimised by the cell partitioner
+enum class PartitionObjective : int
+{
+  /// Minimise the number of cut dual-graph edges (partitioner default)
+  edge_cut,
+  /// Minimise the expected number of ghost cells, i.e. the number of
+  /// (cell, remote neighbour rank) pairs, which models the data
+  /// replicated and exchanged through the resulting IndexMaps more
+  /// closely than the raw edge cut
+  ghost_cells
+};
+
 /// Tools for partitioning meshes
 
 class Partitioning
@@ -42,10 +56,131 @@ public:
   /// @param[in] ghost_mode How to overlap the cell partitioning: none,
   ///   shared_facet or shared_vertex
   /// @return Destination processes for each cell on this process
+  ///
+  /// If the environment variable DOLFINX_PARTITION_CACHE is set to a
+  /// directory, the computed partition is stored there in one binary
+  /// sidecar file per rank, keyed by a hash of the cell data and the
+  /// number of parts. Later calls with identical input on the same
+  /// number of ranks load the stored partition and skip the graph
+  /// partitioner.
+  static graph::AdjacencyList<std::int32_t>
+  partition_cells(MPI_Comm comm, int n, const mesh::CellType cell_type,
+                  const graph::AdjacencyList<std::int64_t>& cells,
+                  mesh::GhostMode ghost_mode);
+
+  /// Compute destination rank for mesh cells using a graph partitioner
+  /// with per-cell weights, e.g. measured assembly cost. The
+  /// partitioner balances the summed weight per rank rather than the
+  /// cell count. Multiple balancing constraints must be folded into a
+  /// single combined weight per cell. The on-disk partition cache is
+  /// bypassed when weights are supplied, since the cache key covers
+  /// the mesh data only.
+  /// @param[in] comm MPI Communicator
+  /// @param[in] n Number of partitions
+  /// @param[in] cell_type Cell type
+  /// @param[in] cells Cells on this process (see the unweighted
+  ///   overload for the data layout)
+  /// @param[in] cell_weights Partitioning weight for each local cell
+  ///   (empty for uniform weights)
+  /// @param[in] ghost_mode How to overlap the cell partitioning: none,
+  ///   shared_facet or shared_vertex
+  /// @return Destination processes for each cell on this process
   static graph::AdjacencyList<std::int32_t>
   partition_cells(MPI_Comm comm, int n, const mesh::CellType cell_type,
                   const graph::AdjacencyList<std::int64_t>& cells,
+                  const std::vector<std::size_t>& cell_weights,
                   mesh::GhostMode ghost_mode);
+
+  /// Compute destination rank for mesh cells using a graph partitioner
+  /// with a selectable objective. With PartitionObjective::edge_cut
+  /// this is identical to the weighted overload. With
+  /// PartitionObjective::ghost_cells the edge-cut partition is
+  /// post-processed by a greedy boundary pass that moves cells to the
+  /// dominant rank among their dual-graph neighbours when this reduces
+  /// the number of distinct remote ranks the cell is ghosted to, capped
+  /// at 5% of the local cells to preserve the load balance. The
+  /// expected ghost count per rank is logged afterwards. The on-disk
+  /// partition cache is bypassed for this objective.
+  /// @param[in] comm MPI Communicator
+  /// @param[in] n Number of partitions
+  /// @param[in] cell_type Cell type
+  /// @param[in] cells Cells on this process (see the unweighted
+  ///   overload for the data layout)
+  /// @param[in] cell_weights Partitioning weight for each local cell
+  ///   (empty for uniform weights)
+  /// @param[in] objective Quantity the partitioner should minimise
+  /// @param[in] ghost_mode How to overlap the cell partitioning: none,
+  ///   shared_facet or shared_vertex
+  /// @return Destination processes for each cell on this process
+  static graph::AdjacencyList<std::int32_t>
+  partition_cells(MPI_Comm comm, int n, const mesh::CellType cell_type,
+                  const graph::AdjacencyList<std::int64_t>& cells,
+                  const std::vector<std::size_t>& cell_weights,
+                  PartitionObjective objective, mesh::GhostMode ghost_mode);
+
+  /// Build the distributed dual graph of the cells on this process for
+  /// use with an external partitioner. Nodes are the local cells in
+  /// input order and the links hold the global indices of the
+  /// facet-neighbour cells, including neighbours owned by other ranks.
+  /// The CSR arrays of the result are available without further copies
+  /// through AdjacencyList::array() and AdjacencyList::offsets(). An
+  /// externally computed partition can then be fed back as the @p dest
+  /// argument of mesh::create_mesh, which skips the built-in graph
+  /// partitioner. Per-cell weights for the external partitioner, e.g.
+  /// measured assembly cost, are the caller's to assemble; the same
+  /// weight convention as the weighted partition_cells overload
+  /// applies.
+  /// @param[in] comm MPI Communicator
+  /// @param[in] cell_type Cell type
+  /// @param[in] cells Cells on this process (see partition_cells for
+  ///   the data layout)
+  /// @return Pair of (dual graph in global cell indices, array of
+  ///   [number of ghost nodes, number of local edges, number of
+  ///   non-local edges] for this process)
+  static std::pair<graph::AdjacencyList<std::int64_t>,
+                   std::array<std::int32_t, 3>>
+  create_dual_graph(MPI_Comm comm, const mesh::CellType cell_type,
+                    const graph::AdjacencyList<std::int64_t>& cells);
+
+  /// Compute the expected number of ghost cells on each rank for a
+  /// given cell partition, without building the mesh. A cell is counted
+  /// once per remote rank owning one of its facet neighbours, matching
+  /// the replication of GhostMode::shared_facet. Useful for comparing
+  /// partitioning strategies without running the full mesh setup.
+  /// @param[in] comm MPI Communicator
+  /// @param[in] cell_type Cell type
+  /// @param[in] cells Cells on this process (see partition_cells for
+  ///   the data layout)
+  /// @param[in] dest Destination rank for each cell, e.g. as returned
+  ///   by partition_cells. Only the first (owner) rank of each cell is
+  ///   used.
+  /// @return Expected number of ghost cells for every rank (the same
+  ///   array on all ranks)
+  static std::vector<std::int32_t>
+  compute_expected_ghosts(MPI_Comm comm, const mesh::CellType cell_type,
+                          const graph::AdjacencyList<std::int64_t>& cells,
+                          const graph::AdjacencyList<std::int32_t>& dest);
+
+  /// Compute destination rank for mesh cells with a hierarchical
+  /// two-level partition that follows the machine topology: cells are
+  /// first partitioned across compute nodes (discovered with
+  /// MPI_Comm_split_type), minimising the inter-node cut, and each
+  /// node's cells are then sub-partitioned across the ranks of that
+  /// node. Intra-node communication is much cheaper than inter-node,
+  /// so this typically reduces the expensive part of the halo exchange
+  /// compared to a flat partition into comm-size parts. With one rank
+  /// per node (or one node) the result reduces to a flat partition.
+  /// Only GhostMode::none is supported.
+  /// @param[in] comm MPI Communicator
+  /// @param[in] cell_type Cell type
+  /// @param[in] cells Cells on this process (see partition_cells for
+  ///   the data layout)
+  /// @param[in] ghost_mode Must be GhostMode::none
+  /// @return Destination processes for each cell on this process
+  static graph::AdjacencyList<std::int32_t>
+  partition_cells_hierarchical(MPI_Comm comm, const mesh::CellType cell_type,
+                               const graph::AdjacencyList<std::int64_t>& cells,
+                               mesh::GhostMode ghost_mode);
 };
 } // namespace mesh
 } // namespace dolfinx
@@ -6,8 +6,11 @@
 
 #include "PermutationComputation.h"
 #include <bitset>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Topology.h>
+#include <thread>
+#include <vector>
 
 #define BITSETSIZE 32
 
@@ -16,6 +19,33 @@ using namespace dolfinx::mesh;
 
 namespace
 {
+//-----------------------------------------------------------------------------
+/// Run f(begin, end) over [0, n), split into contiguous chunks that are
+/// executed on common::num_worker_threads() threads. The chunks are
+/// disjoint, so f may write to per-index data without synchronisation.
+template <typename Fn>
+void parallel_for_range(std::int32_t n, Fn&& f)
+{
+  const int num_threads = common::num_worker_threads();
+  if (num_threads <= 1 or n < 2 * num_threads)
+  {
+    f(0, n);
+    return;
+  }
+
+  const std::int32_t chunk = (n + num_threads - 1) / num_threads;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    const std::int32_t begin = t * chunk;
+    const std::int32_t end = std::min(begin + chunk, n);
+    if (begin < end)
+      threads.emplace_back(f, begin, end);
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+}
+//-----------------------------------------------------------------------------
 Eigen::Array<std::bitset<BITSETSIZE>, Eigen::Dynamic, 1>
 compute_face_permutations_simplex(
     const graph::AdjacencyList<std::int32_t>& c_to_v,
@@ -26,53 +56,57 @@ compute_face_permutations_simplex(
   Eigen::Array<std::bitset<BITSETSIZE>, Eigen::Dynamic, 1> face_perm(num_cells);
   face_perm.fill(0);
 
-  for (int c = 0; c < num_cells; ++c)
-  {
-    auto cell_vertices = c_to_v.links(c);
-    auto cell_faces = c_to_f.links(c);
-    for (int i = 0; i < faces_per_cell; ++i)
+  // Each cell writes only its own row of face_perm, so the cell range
+  // can be processed in disjoint chunks
+  parallel_for_range(num_cells, [&](std::int32_t c_begin, std::int32_t c_end) {
+    for (std::int32_t c = c_begin; c < c_end; ++c)
     {
-      // Get the face
-      const int face = cell_faces[i];
-      auto vertices = f_to_v.links(face);
-
-      // Orient that triangle so the the lowest numbered vertex is the
-      // origin, and the next vertex anticlockwise from the lowest has a
-      // lower number than the next vertex clockwise. Find the index of
-      // the lowest numbered vertex
-
-      // Store local vertex indices here
-      std::array<std::int32_t, 3> e_vertices;
-
-      // Find iterators pointing to cell vertex given a vertex on facet
-      for (int j = 0; j < 3; ++j)
+      auto cell_vertices = c_to_v.links(c);
+      auto cell_faces = c_to_f.links(c);
+      for (int i = 0; i < faces_per_cell; ++i)
       {
-        const auto *const it = std::find(cell_vertices.data(),
-                                  cell_vertices.data() + cell_vertices.size(),
-                                  vertices[j]);
-        // Get the actual local vertex indices
-        e_vertices[j] = it - cell_vertices.data();
+        // Get the face
+        const int face = cell_faces[i];
+        auto vertices = f_to_v.links(face);
+
+        // Orient that triangle so the the lowest numbered vertex is the
+        // origin, and the next vertex anticlockwise from the lowest has a
+        // lower number than the next vertex clockwise. Find the index of
+        // the lowest numbered vertex
+
+        // Store local vertex indices here
+        std::array<std::int32_t, 3> e_vertices;
+
+        // Find iterators pointing to cell vertex given a vertex on facet
+        for (int j = 0; j < 3; ++j)
+        {
+          const auto *const it = std::find(cell_vertices.data(),
+                                    cell_vertices.data() + cell_vertices.size(),
+                                    vertices[j]);
+          // Get the actual local vertex indices
+          e_vertices[j] = it - cell_vertices.data();
+        }
+
+        // Number of rotations
+        std::uint8_t rots = 0;
+        for (int v = 1; v < 3; ++v)
+          if (e_vertices[v] < e_vertices[rots])
+            rots = v;
+
+        // pre is the number of the next vertex clockwise from the lowest
+        // numbered vertex
+        const int pre = rots == 0 ? e_vertices[3 - 1] : e_vertices[rots - 1];
+
+        // post is the number of the next vertex anticlockwise from the
+        // lowest numbered vertex
+        const int post = rots == 3 - 1 ? e_vertices[0] : e_vertices[rots + 1];
+
+        face_perm[c][3 * i] = (post > pre);
+        face_perm[c][3 * i + 1] = rots % 2;
+        face_perm[c][3 * i + 2] = rots / 2;
       }
-
-      // Number of rotations
-      std::uint8_t rots = 0;
-      for (int v = 1; v < 3; ++v)
-        if (e_vertices[v] < e_vertices[rots])
-          rots = v;
-
-      // pre is the number of the next vertex clockwise from the lowest
-      // numbered vertex
-      const int pre = rots == 0 ? e_vertices[3 - 1] : e_vertices[rots - 1];
-
-      // post is the number of the next vertex anticlockwise from the
-      // lowest numbered vertex
-      const int post = rots == 3 - 1 ? e_vertices[0] : e_vertices[rots + 1];
-
-      face_perm[c][3 * i] = (post > pre);
-      face_perm[c][3 * i + 1] = rots % 2;
-      face_perm[c][3 * i + 2] = rots / 2;
     }
-  }
+  });
   return face_perm;
 }
 //-----------------------------------------------------------------------------
@@ -85,78 +119,82 @@ compute_face_permutations_tp(const graph::AdjacencyList<std::int32_t>& c_to_v,
   const std::int32_t num_cells = c_to_v.num_nodes();
   Eigen::Array<std::bitset<BITSETSIZE>, Eigen::Dynamic, 1> face_perm(num_cells);
   face_perm.fill(0);
-  for (int c = 0; c < num_cells; ++c)
-  {
-    auto cell_vertices = c_to_v.links(c);
-    auto cell_faces = c_to_f.links(c);
-    for (int i = 0; i < faces_per_cell; ++i)
+  // Cells write disjoint rows of face_perm; split the cell range
+  // across threads
+  parallel_for_range(num_cells, [&](std::int32_t c_begin, std::int32_t c_end) {
+    for (std::int32_t c = c_begin; c < c_end; ++c)
     {
-      const int face = cell_faces[i];
-      auto vertices = f_to_v.links(face);
-
-      // quadrilateral
-      // Orient that quad so the the lowest numbered vertex is the
-      // origin, and the next vertex anticlockwise from the lowest has a
-      // lower number than the next vertex clockwise. Find the index of
-      // the lowest numbered vertex
-      int num_min = -1;
-
-      // Store local vertex indices here
-      std::array<std::int32_t, 4> e_vertices;
-
-      // Find iterators pointing to cell vertex given a vertex on facet
-      for (int j = 0; j < 4; ++j)
-      {
-        const auto *const it = std::find(cell_vertices.data(),
-                                  cell_vertices.data() + cell_vertices.size(),
-                                  vertices[j]);
-        // Get the actual local vertex indices
-        e_vertices[j] = it - cell_vertices.data();
-      }
-
-      for (int v = 0; v < 4; ++v)
-      {
-        if (num_min == -1 or e_vertices[v] < e_vertices[num_min])
-          num_min = v;
-      }
-
-      // rots is the number of rotations to get the lowest numbered
-      // vertex to the origin
-      std::uint8_t rots = num_min;
-
-      // pre is the (local) number of the next vertex clockwise from the
-      // lowest numbered vertex
-      int pre = 2;
-
-      // post is the (local) number of the next vertex anticlockwise
-      // from the lowest numbered vertex
-      int post = 1;
-
-      // The tensor product ordering of quads must be taken into account
-      assert(num_min < 4);
-      switch (num_min)
+      auto cell_vertices = c_to_v.links(c);
+      auto cell_faces = c_to_f.links(c);
+      for (int i = 0; i < faces_per_cell; ++i)
       {
-      case 1:
-        pre = 0;
-        post = 3;
-        break;
-      case 2:
-        pre = 3;
-        post = 0;
-        rots = 3;
-        break;
-      case 3:
-        pre = 1;
-        post = 2;
-        rots = 2;
-        break;
+        const int face = cell_faces[i];
+        auto vertices = f_to_v.links(face);
+
+        // quadrilateral
+        // Orient that quad so the the lowest numbered vertex is the
+        // origin, and the next vertex anticlockwise from the lowest has a
+        // lower number than the next vertex clockwise. Find the index of
+        // the lowest numbered vertex
+        int num_min = -1;
+
+        // Store local vertex indices here
+        std::array<std::int32_t, 4> e_vertices;
+
+        // Find iterators pointing to cell vertex given a vertex on facet
+        for (int j = 0; j < 4; ++j)
+        {
+          const auto *const it = std::find(cell_vertices.data(),
+                                    cell_vertices.data() + cell_vertices.size(),
+                                    vertices[j]);
+          // Get the actual local vertex indices
+          e_vertices[j] = it - cell_vertices.data();
+        }
+
+        for (int v = 0; v < 4; ++v)
+        {
+          if (num_min == -1 or e_vertices[v] < e_vertices[num_min])
+            num_min = v;
+        }
+
+        // rots is the number of rotations to get the lowest numbered
+        // vertex to the origin
+        std::uint8_t rots = num_min;
+
+        // pre is the (local) number of the next vertex clockwise from the
+        // lowest numbered vertex
+        int pre = 2;
+
+        // post is the (local) number of the next vertex anticlockwise
+        // from the lowest numbered vertex
+        int post = 1;
+
+        // The tensor product ordering of quads must be taken into account
+        assert(num_min < 4);
+        switch (num_min)
+        {
+        case 1:
+          pre = 0;
+          post = 3;
+          break;
+        case 2:
+          pre = 3;
+          post = 0;
+          rots = 3;
+          break;
+        case 3:
+          pre = 1;
+          post = 2;
+          rots = 2;
+          break;
+        }
+
+        face_perm[c][3 * i] = (post > pre);
+        face_perm[c][3 * i + 1] = rots % 2;
+        face_perm[c][3 * i + 2] = rots / 2;
       }
-
-      face_perm[c][3 * i] = (post > pre);
-      face_perm[c][3 * i + 1] = rots % 2;
-      face_perm[c][3 * i + 2] = rots / 2;
     }
-  }
+  });
   return face_perm;
 }
 //-----------------------------------------------------------------------------
@@ -179,32 +217,33 @@ compute_edge_reflections(const mesh::Topology& topology)
   auto e_to_v = topology.connectivity(1, 0);
   assert(e_to_v);
 
-  Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> reflections(
-      edges_per_cell, c_to_v->num_nodes());
-  for (int c = 0; c < c_to_v->num_nodes(); ++c)
-  {
-    auto cell_vertices = c_to_v->links(c);
-    auto cell_edges = c_to_e->links(c);
-    for (int i = 0; i < edges_per_cell; ++i)
+  // Each cell writes only its own row of edge_perm
+  parallel_for_range(num_cells, [&](std::int32_t c_begin, std::int32_t c_end) {
+    for (std::int32_t c = c_begin; c < c_end; ++c)
     {
-      auto vertices = e_to_v->links(cell_edges[i]);
-
-      // If the entity is an interval, it should be oriented pointing
-      // from the lowest numbered vertex to the highest numbered vertex.
-
-      // Find iterators pointing to cell vertex given a vertex on facet
-      const auto *const it0
-          = std::find(cell_vertices.data(),
-                      cell_vertices.data() + cell_vertices.size(), vertices[0]);
-      const auto *const it1
-          = std::find(cell_vertices.data(),
-                      cell_vertices.data() + cell_vertices.size(), vertices[1]);
-
-      // The number of reflections. Comparing iterators directly instead
-      // of values they point to is sufficient here.
-      edge_perm[c][i] = (it1 < it0);
+      auto cell_vertices = c_to_v->links(c);
+      auto cell_edges = c_to_e->links(c);
+      for (int i = 0; i < edges_per_cell; ++i)
+      {
+        auto vertices = e_to_v->links(cell_edges[i]);
+
+        // If the entity is an interval, it should be oriented pointing
+        // from the lowest numbered vertex to the highest numbered vertex.
+
+        // Find iterators pointing to cell vertex given a vertex on facet
+        const auto *const it0
+            = std::find(cell_vertices.data(),
+                        cell_vertices.data() + cell_vertices.size(), vertices[0]);
+        const auto *const it1
+            = std::find(cell_vertices.data(),
+                        cell_vertices.data() + cell_vertices.size(), vertices[1]);
+
+        // The number of reflections. Comparing iterators directly instead
+        // of values they point to is sufficient here.
+        edge_perm[c][i] = (it1 < it0);
+      }
     }
-  }
+  });
   return edge_perm;
 }
 //-----------------------------------------------------------------------------
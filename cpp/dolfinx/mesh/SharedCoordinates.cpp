@@ -0,0 +1,103 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "SharedCoordinates.h"
+#include "Geometry.h"
+#include <algorithm>
+#include <cassert>
+#include <dolfinx/common/IndexMap.h>
+
+using namespace dolfinx;
+using namespace dolfinx::mesh;
+
+//-----------------------------------------------------------------------------
+SharedCoordinates::SharedCoordinates(const Geometry& geometry)
+{
+  std::shared_ptr<const common::IndexMap> map = geometry.index_map();
+  assert(map);
+  assert(map->block_size() == 1);
+  _size_local = map->size_local();
+  const std::int32_t num_ghosts = map->num_ghosts();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = geometry.x();
+
+  // Split off the on-node communicator. The split and the window
+  // allocation below are collective over the full communicator.
+  MPI_Comm comm = map->mpi_comm();
+  const int global_rank = MPI::rank(comm);
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, global_rank, MPI_INFO_NULL,
+                      &_node_comm);
+  const int node_size = MPI::size(_node_comm);
+
+  // Global rank and start of the owned range for every on-node rank,
+  // to map ghost owners to node ranks and global indices to
+  // owner-local rows
+  std::vector<int> node_global(node_size);
+  MPI_Allgather(&global_rank, 1, MPI_INT, node_global.data(), 1, MPI_INT,
+                _node_comm);
+  const std::int64_t range0 = map->local_range()[0];
+  std::vector<std::int64_t> node_range0(node_size);
+  MPI_Allgather(&range0, 1, MPI_INT64_T, node_range0.data(), 1, MPI_INT64_T,
+                _node_comm);
+
+  // Place the owned coordinates in this rank's window segment
+  MPI_Win_allocate_shared(sizeof(double) * 3 * _size_local, sizeof(double),
+                          MPI_INFO_NULL, _node_comm, &_owned, &_win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, _win);
+  std::copy_n(x.data(), 3 * _size_local, _owned);
+
+  // All owned segments must be filled before neighbours resolve
+  // pointers into them
+  MPI_Barrier(_node_comm);
+
+  // Resolve each ghost: on-node owners by a pointer into the owner's
+  // segment, off-node owners by a local copy (filled in a second pass
+  // so the copy buffer does not reallocate under the stored pointers)
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts = map->ghosts();
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& ghost_owners
+      = map->ghost_owners();
+  _ghost_rows.resize(num_ghosts, nullptr);
+  for (std::int32_t i = 0; i < num_ghosts; ++i)
+  {
+    const auto it = std::find(node_global.begin(), node_global.end(),
+                              ghost_owners[i]);
+    if (it == node_global.end())
+      continue;
+    const int p = std::distance(node_global.begin(), it);
+    MPI_Aint size;
+    int disp_unit;
+    double* base = nullptr;
+    MPI_Win_shared_query(_win, p, &size, &disp_unit, &base);
+    _ghost_rows[i] = base + 3 * (ghosts[i] - node_range0[p]);
+    ++_num_node_local_ghosts;
+  }
+
+  _off_node.resize(3 * (num_ghosts - _num_node_local_ghosts));
+  std::size_t pos = 0;
+  for (std::int32_t i = 0; i < num_ghosts; ++i)
+  {
+    if (_ghost_rows[i])
+      continue;
+    std::copy_n(x.row(_size_local + i).data(), 3, _off_node.data() + pos);
+    _ghost_rows[i] = _off_node.data() + pos;
+    pos += 3;
+  }
+
+  _mem_usage.update(sizeof(double) * (3 * _size_local + _off_node.size())
+                    + sizeof(const double*) * _ghost_rows.size());
+}
+//-----------------------------------------------------------------------------
+SharedCoordinates::~SharedCoordinates()
+{
+  if (_win != MPI_WIN_NULL)
+  {
+    MPI_Win_unlock_all(_win);
+    MPI_Win_free(&_win);
+  }
+  if (_node_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&_node_comm);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MemoryRegistry.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace mesh
+{
+class Geometry;
+
+/// Node-shared view of the geometry coordinates for ghosted meshes.
+///
+/// Each rank places its owned coordinates in an MPI shared-memory
+/// window; ghost coordinates whose owner lives on the same compute
+/// node are resolved by a direct pointer into the owner's window
+/// segment instead of a local copy, so intra-node ghost duplication
+/// is eliminated. Only ghosts owned by off-node ranks are stored
+/// locally. The view snapshots the coordinates at construction; it
+/// does not track later modifications through Geometry::x().
+///
+/// Construction is collective over the communicator of the geometry
+/// index map. Row indexing matches Geometry::x(): owned nodes first,
+/// then ghosts in index map order.
+class SharedCoordinates
+{
+public:
+  /// Create the shared view of the coordinates of a Geometry
+  /// (collective)
+  /// @param[in] geometry The geometry whose coordinates to share
+  explicit SharedCoordinates(const Geometry& geometry);
+
+  // Window and pointer-table ownership cannot be duplicated or
+  // transferred
+  SharedCoordinates(const SharedCoordinates&) = delete;
+  SharedCoordinates(SharedCoordinates&&) = delete;
+  SharedCoordinates& operator=(const SharedCoordinates&) = delete;
+  SharedCoordinates& operator=(SharedCoordinates&&) = delete;
+
+  /// Destructor (frees the shared window and the node communicator)
+  ~SharedCoordinates();
+
+  /// Pointer to the three coordinates of node n (local index,
+  /// including ghosts). For on-node ghosts the pointer resolves into
+  /// the owner rank's window segment.
+  const double* row(std::int32_t n) const
+  {
+    if (n < _size_local)
+      return _owned + 3 * n;
+    else
+      return _ghost_rows[n - _size_local];
+  }
+
+  /// Coordinates of node n (local index, including ghosts)
+  Eigen::Vector3d node(std::int32_t n) const
+  {
+    const double* x = row(n);
+    return Eigen::Vector3d(x[0], x[1], x[2]);
+  }
+
+  /// Number of owned nodes
+  std::int32_t size_local() const { return _size_local; }
+
+  /// Number of ghost nodes resolved into an on-node owner's window
+  /// (the remainder are stored locally)
+  std::int32_t num_node_local_ghosts() const { return _num_node_local_ghosts; }
+
+private:
+  // Number of owned nodes
+  std::int32_t _size_local = 0;
+
+  // Ghosts resolved through the shared window
+  std::int32_t _num_node_local_ghosts = 0;
+
+  // Owned coordinates (this rank's window segment)
+  double* _owned = nullptr;
+
+  // Per-ghost row pointers, into an owner's window segment or into
+  // _off_node
+  std::vector<const double*> _ghost_rows;
+
+  // Coordinates of ghosts owned by off-node ranks
+  std::vector<double> _off_node;
+
+  // Shared-memory window holding the owned coordinates
+  MPI_Win _win = MPI_WIN_NULL;
+
+  // Node-local communicator over which the window is allocated
+  MPI_Comm _node_comm = MPI_COMM_NULL;
+
+  // Reported resident bytes (window segment, off-node ghosts and
+  // pointer table)
+  common::MemoryRegistry::Usage _mem_usage{"SharedCoordinates"};
+};
+} // namespace mesh
+} // namespace dolfinx
@@ -14,6 +14,7 @@
 #include <dolfinx/common/utils.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/CompressedAdjacencyList.h>
 #include <dolfinx/graph/Partitioning.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <numeric>
@@ -192,6 +193,18 @@ std::int32_t Topology::create_entities(int dim)
 //-----------------------------------------------------------------------------
 void Topology::create_connectivity(int d0, int d1)
 {
+  // Rehydrate from the compressed copy if one exists; this is much
+  // cheaper than recomputing the connectivity
+  if (auto it = _compressed_connectivity.find({d0, d1});
+      it != _compressed_connectivity.end())
+  {
+    set_connectivity(std::make_shared<graph::AdjacencyList<std::int32_t>>(
+                         it->second->decompress()),
+                     d0, d1);
+    _compressed_connectivity.erase(it);
+    return;
+  }
+
   // Make sure entities exist
   create_entities(d0);
   create_entities(d1);
@@ -219,6 +232,53 @@ void Topology::create_connectivity(int d0, int d1)
     set_connectivity(c_d1_d0, d1, d0);
 }
 //-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+Topology::connectivity_subset(int d0, int d1,
+                              const std::vector<std::int32_t>& entities)
+{
+  // Make sure entities exist
+  create_entities(d0);
+  create_entities(d1);
+
+  // If the full connectivity exists, gather rows from it directly
+  if (connectivity(d0, d1))
+  {
+    return TopologyComputation::compute_connectivity_subset(*this, d0, d1,
+                                                            entities);
+  }
+
+  // Compute rows not yet in the cache
+  std::map<std::int32_t, std::vector<std::int32_t>>& rows
+      = _connectivity_rows[{d0, d1}];
+  std::vector<std::int32_t> missing;
+  for (std::int32_t e : entities)
+  {
+    if (rows.find(e) == rows.end())
+      missing.push_back(e);
+  }
+
+  if (!missing.empty())
+  {
+    const graph::AdjacencyList<std::int32_t> block
+        = TopologyComputation::compute_connectivity_subset(*this, d0, d1,
+                                                           missing);
+    for (std::size_t p = 0; p < missing.size(); ++p)
+    {
+      auto links = block.links(p);
+      rows.emplace(missing[p],
+                   std::vector<std::int32_t>(links.data(),
+                                             links.data() + links.rows()));
+    }
+  }
+
+  // Assemble the requested rows from the cache
+  std::vector<std::vector<std::int32_t>> connections(entities.size());
+  for (std::size_t p = 0; p < entities.size(); ++p)
+    connections[p] = rows.at(entities[p]);
+
+  return graph::AdjacencyList<std::int32_t>(connections);
+}
+//-----------------------------------------------------------------------------
 void Topology::create_entity_permutations()
 {
   if (_cell_permutations.size() > 0)
@@ -240,9 +300,18 @@ void Topology::create_entity_permutations()
 //-----------------------------------------------------------------------------
 void Topology::create_connectivity_all()
 {
-  // Compute all entities
-  for (int d = 0; d <= dim(); d++)
-    create_entities(d);
+  // Compute all missing entities in one fused pass, sharing the cell
+  // sweep and the vertex sharing information between the dimensions
+  for (const auto& [d, cell_entity, entity_vertex, index_map] :
+       TopologyComputation::compute_entities_all(_mpi_comm.comm(), *this))
+  {
+    if (cell_entity)
+      set_connectivity(cell_entity, dim(), d);
+    if (entity_vertex)
+      set_connectivity(entity_vertex, d, 0);
+    assert(index_map);
+    set_index_map(d, index_map);
+  }
 
   // Compute all connectivity
   for (int d0 = 0; d0 <= dim(); d0++)
@@ -258,12 +327,107 @@ Topology::connectivity(int d0, int d1) const
   return _connectivity(d0, d1);
 }
 //-----------------------------------------------------------------------------
+Topology::ConnectivitySpan Topology::connectivity_span(int d0, int d1) const
+{
+  assert(d0 < _connectivity.rows());
+  assert(d1 < _connectivity.cols());
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c
+      = _connectivity(d0, d1);
+  if (!c)
+  {
+    throw std::runtime_error("Connectivity " + std::to_string(d0) + " -> "
+                             + std::to_string(d1)
+                             + " does not exist (or is compressed).");
+  }
+  return {c->offsets().data(), c->array().data(), c->num_nodes()};
+}
+//-----------------------------------------------------------------------------
+void Topology::create_facet_cell_connectivity()
+{
+  if (_facet_cells_built)
+    return;
+
+  const int tdim = dim();
+  create_connectivity(tdim - 1, tdim);
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> f_to_c
+      = _connectivity(tdim - 1, tdim);
+  assert(f_to_c);
+
+  _facet_cells.resize(f_to_c->num_nodes(), 2);
+  for (std::int32_t f = 0; f < f_to_c->num_nodes(); ++f)
+  {
+    auto cells = f_to_c->links(f);
+    assert(cells.rows() >= 1 and cells.rows() <= 2);
+    _facet_cells(f, 0) = cells[0];
+    _facet_cells(f, 1) = cells.rows() == 2 ? cells[1] : -1;
+  }
+  _facet_cells_built = true;
+}
+//-----------------------------------------------------------------------------
+const Eigen::Array<std::int32_t, Eigen::Dynamic, 2, Eigen::RowMajor>&
+Topology::facet_cells() const
+{
+  if (!_facet_cells_built)
+  {
+    throw std::runtime_error("Facet-cell connectivity has not been created "
+                             "(see create_facet_cell_connectivity).");
+  }
+  return _facet_cells;
+}
+//-----------------------------------------------------------------------------
 void Topology::set_connectivity(
     std::shared_ptr<graph::AdjacencyList<std::int32_t>> c, int d0, int d1)
 {
   assert(d0 < _connectivity.rows());
   assert(d1 < _connectivity.cols());
   _connectivity(d0, d1) = c;
+  if (d0 == dim() - 1 and d1 == dim())
+    _facet_cells_built = false;
+  update_memory_usage();
+}
+//-----------------------------------------------------------------------------
+void Topology::update_memory_usage()
+{
+  // The raw adjacency lists dominate; the compressed entries and
+  // lazily computed rows are small by construction
+  std::int64_t bytes = 0;
+  for (Eigen::Index d0 = 0; d0 < _connectivity.rows(); ++d0)
+  {
+    for (Eigen::Index d1 = 0; d1 < _connectivity.cols(); ++d1)
+    {
+      if (auto c = _connectivity(d0, d1); c)
+      {
+        bytes += sizeof(std::int32_t)
+                 * (c->array().rows() + c->offsets().rows());
+      }
+    }
+  }
+  _mem_usage.update(bytes);
+}
+//-----------------------------------------------------------------------------
+void Topology::compress_connectivity(int d0, int d1)
+{
+  assert(d0 < _connectivity.rows());
+  assert(d1 < _connectivity.cols());
+  if (!_connectivity(d0, d1))
+    return;
+
+  _compressed_connectivity[{d0, d1}]
+      = std::make_shared<const graph::CompressedAdjacencyList<std::int32_t>>(
+          *_connectivity(d0, d1));
+  _connectivity(d0, d1).reset();
+  update_memory_usage();
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const graph::CompressedAdjacencyList<std::int32_t>>
+Topology::compressed_connectivity(int d0, int d1) const
+{
+  if (auto it = _compressed_connectivity.find({d0, d1});
+      it != _compressed_connectivity.end())
+  {
+    return it->second;
+  }
+  return nullptr;
 }
 //-----------------------------------------------------------------------------
 size_t Topology::hash() const
@@ -578,8 +742,7 @@ mesh::create_topology(MPI_Comm comm,
 
   MPI_Comm_free(&neighbour_comm);
 
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& cells_array
-      = cells.array();
+  const auto cells_array = cells.array();
   std::shared_ptr<graph::AdjacencyList<std::int32_t>> my_local_cells;
   if (ghost_mode == mesh::GhostMode::none)
   {
@@ -591,17 +754,16 @@ mesh::create_topology(MPI_Comm comm,
     for (std::size_t i = 0; i < my_local_cells_array.size(); ++i)
       my_local_cells_array[i] = global_to_local_index[cells_array[i]];
     my_local_cells = std::make_shared<graph::AdjacencyList<std::int32_t>>(
-        my_local_cells_array, local_offsets);
+        std::move(my_local_cells_array), std::move(local_offsets));
   }
   else
   {
     // Convert my_cells (global indexing) to my_local_cells (local indexing)
-    Eigen::Array<std::int32_t, Eigen::Dynamic, 1> my_local_cells_array(
-        cells_array.size());
-    for (int i = 0; i < my_local_cells_array.size(); ++i)
+    std::vector<std::int32_t> my_local_cells_array(cells_array.size());
+    for (std::size_t i = 0; i < my_local_cells_array.size(); ++i)
       my_local_cells_array[i] = global_to_local_index[cells_array[i]];
     my_local_cells = std::make_shared<graph::AdjacencyList<std::int32_t>>(
-        my_local_cells_array, cells.offsets());
+        std::move(my_local_cells_array), cells.offsets());
   }
 
   Topology topology(comm, cell_type);
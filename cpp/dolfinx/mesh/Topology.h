@@ -11,6 +11,8 @@
 #include <array>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MemoryRegistry.h>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -30,6 +32,8 @@ namespace graph
 {
 template <typename T>
 class AdjacencyList;
+template <typename T>
+class CompressedAdjacencyList;
 }
 
 namespace mesh
@@ -105,11 +109,87 @@ public:
   std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
   connectivity(int d0, int d1) const;
 
+  /// Flat view of a d0 -> d1 connectivity for tight index-range loops.
+  /// Holds raw pointers into the adjacency list arrays, so iterating
+  /// entities needs no shared_ptr lookup or entity object per entity.
+  /// The view is invalidated if the connectivity is replaced or
+  /// compressed.
+  struct ConnectivitySpan
+  {
+    /// Offsets into indices, one per entity plus a final end offset
+    const std::int32_t* offsets;
+
+    /// Flattened incidence indices
+    const std::int32_t* indices;
+
+    /// Number of entities of dimension d0
+    std::int32_t num_entities;
+
+    /// Incident d1-entities of entity e
+    const std::int32_t* links(std::int32_t e) const
+    {
+      return indices + offsets[e];
+    }
+
+    /// Number of incident d1-entities of entity e
+    std::int32_t num_links(std::int32_t e) const
+    {
+      return offsets[e + 1] - offsets[e];
+    }
+  };
+
+  /// Get a flat view of the d0 -> d1 connectivity for tight loops. The
+  /// connectivity must exist (see create_connectivity) and must not be
+  /// in compressed form.
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  /// @return Raw-pointer view of the adjacency list
+  ConnectivitySpan connectivity_span(int d0, int d1) const;
+
+  /// Create the fixed-width facet -> cell connectivity. A facet is
+  /// connected to at most two cells, so the incident cells are stored
+  /// two per facet with -1 marking the missing second cell of an
+  /// exterior facet. Queries index the array directly, with no offsets
+  /// lookup, which halves the memory traffic of a facet -> cell query
+  /// compared with the general adjacency list. Creates the facet ->
+  /// cell connectivity first if required. Does nothing if the
+  /// fixed-width array has already been built.
+  void create_facet_cell_connectivity();
+
+  /// Get the fixed-width facet -> cell connectivity: row f holds the
+  /// cells incident to facet f, with -1 in the second column for
+  /// exterior facets (see create_facet_cell_connectivity, which must
+  /// have been called). The array is invalidated if the facet -> cell
+  /// connectivity is replaced.
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 2, Eigen::RowMajor>&
+  facet_cells() const;
+
   /// @todo Merge with set_index_map
   /// Set connectivity for given pair of topological dimensions
   void set_connectivity(std::shared_ptr<graph::AdjacencyList<std::int32_t>> c,
                         int d0, int d1);
 
+  /// Replace the cached d0 -> d1 connectivity with a delta/varint
+  /// compressed copy and release the raw adjacency list. The compressed
+  /// form typically uses a quarter of the memory after a
+  /// locality-improving cell ordering. connectivity(d0, d1) returns a
+  /// nullptr while a connectivity is compressed; a subsequent
+  /// create_connectivity(d0, d1) rehydrates the list from the
+  /// compressed copy instead of recomputing it. Does nothing if the
+  /// connectivity does not exist.
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  void compress_connectivity(int d0, int d1);
+
+  /// Get the compressed d0 -> d1 connectivity, or nullptr if the
+  /// connectivity is not stored in compressed form. The compressed list
+  /// can be traversed directly with
+  /// CompressedAdjacencyList::for_each_node without rehydration.
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  std::shared_ptr<const graph::CompressedAdjacencyList<std::int32_t>>
+  compressed_connectivity(int d0, int d1) const;
+
   /// Returns the permutation information
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>&
   get_cell_permutation_info() const;
@@ -149,6 +229,22 @@ public:
   /// @param[in] d1 Topological dimension
   void create_connectivity(int d0, int d1);
 
+  /// Get connectivity d0 -> d1 for a subset of entities of dimension
+  /// d0, computing it lazily if the full connectivity has not been
+  /// created. Rows computed here are cached, so repeated requests (e.g.
+  /// for the boundary facets) only compute each row once, and workflows
+  /// that touch a small subset of entities avoid materialising the full
+  /// adjacency list via create_connectivity. If the full connectivity
+  /// already exists, rows are simply gathered from it.
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  /// @param[in] entities Entities of dimension d0 (local indices)
+  /// @return Adjacency list with one node per requested entity, in the
+  ///   order of @p entities
+  graph::AdjacencyList<std::int32_t>
+  connectivity_subset(int d0, int d1,
+                      const std::vector<std::int32_t>& entities);
+
   /// Compute entity permutations and reflections
   void create_entity_permutations();
 
@@ -174,6 +270,14 @@ private:
                Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       _connectivity;
 
+  // Fixed-width facet -> cell connectivity (-1 in the second column
+  // for exterior facets); empty until created
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 2, Eigen::RowMajor> _facet_cells;
+
+  // True when _facet_cells has been built from the current facet ->
+  // cell connectivity
+  bool _facet_cells_built = false;
+
   // The facet permutations
   Eigen::Array<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic>
       _facet_permutations;
@@ -181,6 +285,26 @@ private:
   // Cell permutation info. See the documentation for
   // get_cell_permutation_info for documentation of how this is encoded.
   Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> _cell_permutations;
+
+  // Cache of lazily computed connectivity rows, keyed on (d0, d1). Rows
+  // are stored per entity so partial (e.g. boundary-only) requests do
+  // not require the full d0 -> d1 adjacency list.
+  std::map<std::array<int, 2>, std::map<std::int32_t, std::vector<std::int32_t>>>
+      _connectivity_rows;
+
+  // Connectivities stored in compressed form, keyed on (d0, d1). A
+  // compressed entry replaces the corresponding raw entry in
+  // _connectivity until rehydrated by create_connectivity.
+  std::map<std::array<int, 2>,
+           std::shared_ptr<const graph::CompressedAdjacencyList<std::int32_t>>>
+      _compressed_connectivity;
+
+  // Recompute the reported resident bytes from the stored
+  // connectivities
+  void update_memory_usage();
+
+  // Reported resident bytes of the connectivity arrays
+  common::MemoryRegistry::Usage _mem_usage{"Topology connectivity"};
 };
 
 /// Create distributed topology
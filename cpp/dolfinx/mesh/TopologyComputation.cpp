@@ -14,12 +14,16 @@
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/check.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/utils.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -61,6 +65,63 @@ sort_by_perm(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
 }
 //-----------------------------------------------------------------------------
 
+/// Parallel variant of sort_by_perm. Rows are sharded by contiguous
+/// ranges of their first (smallest) column entry, each shard is sorted
+/// on its own thread and the shards are concatenated in shard order.
+/// Rows with equal first entry always land in the same shard, so the
+/// result is identical to the serial sort.
+/// @param[in] array The input array, each row sorted
+/// @param[in] num_threads Number of threads (and shards) to use
+/// @return The permutation vector that would order the rows in
+///   ascending order
+template <typename T>
+std::vector<int>
+parallel_sort_by_perm(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                         Eigen::RowMajor>& array,
+                      int num_threads)
+{
+  if (num_threads <= 1 or array.rows() < 2 * num_threads)
+    return sort_by_perm<T>(array);
+
+  const int cols = array.cols();
+  const auto cmp = [&array, &cols](int a, int b) {
+    const T* row_a = array.row(a).data();
+    const T* row_b = array.row(b).data();
+    return std::lexicographical_compare(row_a, row_a + cols, row_b,
+                                        row_b + cols);
+  };
+
+  // Bucket row indices by ranges of the leading (most significant) sort
+  // key
+  const std::int64_t key_max
+      = static_cast<std::int64_t>(array.col(0).maxCoeff()) + 1;
+  std::vector<std::vector<int>> shards(num_threads);
+  for (int i = 0; i < array.rows(); ++i)
+  {
+    const int s = static_cast<std::int64_t>(array(i, 0)) * num_threads / key_max;
+    shards[s].push_back(i);
+  }
+
+  // Sort each shard concurrently
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back(
+        [&shards, &cmp, t]() { std::sort(shards[t].begin(), shards[t].end(), cmp); });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // Concatenate the shards, which are already ordered relative to each
+  // other
+  std::vector<int> index;
+  index.reserve(array.rows());
+  for (const std::vector<int>& shard : shards)
+    index.insert(index.end(), shard.begin(), shard.end());
+  return index;
+}
+//-----------------------------------------------------------------------------
+
 /// Communicate with sharing processes to find out which entities are
 /// ghosts and return a map (vector) to move these local indices to the
 /// end of the local range. Also returns the index map, and shared
@@ -73,6 +134,11 @@ sort_by_perm(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
 ///   represented by its local vertex indices
 /// @param[in] entity_index Initial numbering for each row in
 ///   entity_list
+/// @param[in] shared_vertices Map from local vertex index to the set of
+///   sharing processes, as returned by
+///   common::IndexMap::compute_shared_indices on the vertex map. Passed
+///   in (rather than computed here) so that it can be computed once and
+///   shared when entities of several dimensions are created together.
 /// @returns Tuple of (local_indices, index map, shared entities)
 std::tuple<std::vector<int>, std::shared_ptr<common::IndexMap>>
 get_local_indexing(
@@ -81,7 +147,8 @@ get_local_indexing(
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic,
                                         Eigen::Dynamic, Eigen::RowMajor>>&
         entity_list,
-    const std::vector<std::int32_t>& entity_index)
+    const std::vector<std::int32_t>& entity_index,
+    const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices)
 {
   // Get first occurence in entity list of each entity
   std::vector<std::int32_t> unique_row(entity_list.rows(), -1);
@@ -111,7 +178,7 @@ get_local_indexing(
     {
       std::int32_t cell_count
           = cell_indexmap->size_local() + cell_indexmap->num_ghosts();
-      assert(entity_list.rows() % cell_count == 0);
+      DOLFINX_ASSERT(entity_list.rows() % cell_count == 0);
       std::int32_t num_entities_per_cell = entity_list.rows() / cell_count;
       std::int32_t ghost_offset
           = cell_indexmap->size_local() * num_entities_per_cell;
@@ -133,9 +200,6 @@ get_local_indexing(
 
   //---------
   // Create an expanded neighbour_comm from shared_vertices
-  const std::map<std::int32_t, std::set<std::int32_t>> shared_vertices
-      = vertex_indexmap->compute_shared_indices();
-
   std::set<std::int32_t> neighbour_set;
   for (auto& q : shared_vertices)
     neighbour_set.insert(q.second.begin(), q.second.end());
@@ -187,7 +251,7 @@ get_local_indexing(
       {
         const int p = q.first;
         auto it = proc_to_neighbour.find(p);
-        assert(it != proc_to_neighbour.end());
+        DOLFINX_ASSERT(it != proc_to_neighbour.end());
         const int np = it->second;
 
         vlocal.assign(entity_list.row(i).data(),
@@ -228,10 +292,8 @@ get_local_indexing(
   const graph::AdjacencyList<std::int64_t> recv_data
       = dolfinx::MPI::neighbor_all_to_all(neighbour_comm, send_offsets,
                                           send_entities_data);
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& recv_entities_data
-      = recv_data.array();
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& recv_offsets
-      = recv_data.offsets();
+  const auto recv_entities_data = recv_data.array();
+  const auto recv_offsets = recv_data.offsets();
 
   // Compare received with sent for each process
   // Any which are not found will have -1 in recv_index
@@ -268,7 +330,7 @@ get_local_indexing(
     {
       auto it = shared_entities.find(i);
       std::int8_t gs = ghost_status[i];
-      assert(gs > 0);
+      DOLFINX_CHECK(gs > 0, "entity has no ownership status");
       // Definitely ghost
       if (gs == 2)
         continue;
@@ -299,7 +361,7 @@ get_local_indexing(
         ++c;
       }
     }
-    assert(c == entity_count);
+    DOLFINX_ASSERT(c == entity_count);
   }
 
   //---------
@@ -334,12 +396,10 @@ get_local_indexing(
         = dolfinx::MPI::neighbor_all_to_all(
             neighbour_comm, send_global_index_offsets, send_global_index_data);
 
-    const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& recv_global_index_data
-        = recv_data.array();
-    const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& recv_offsets
-        = recv_data.offsets();
+    const auto recv_global_index_data = recv_data.array();
+    const auto recv_offsets = recv_data.offsets();
 
-    assert(recv_global_index_data.size() == (int)recv_index.size());
+    DOLFINX_ASSERT(recv_global_index_data.size() == (int)recv_index.size());
 
     // Map back received indices
     for (int j = 0; j < recv_global_index_data.size(); ++j)
@@ -348,7 +408,8 @@ get_local_indexing(
       const std::int32_t idx = recv_index[j];
       if (gi != -1 and idx != -1)
       {
-        assert(local_index[idx] >= num_local);
+        DOLFINX_CHECK(local_index[idx] >= num_local,
+                      "received global index for an owned entity");
         ghost_indices[local_index[idx] - num_local] = gi;
         const auto pos = std::upper_bound(
             recv_offsets.data(), recv_offsets.data() + recv_offsets.rows(), j);
@@ -357,7 +418,7 @@ get_local_indexing(
       }
     }
     for (std::int64_t idx : ghost_indices)
-      assert(idx != -1);
+      DOLFINX_CHECK(idx != -1, "ghost entity has no global index");
   }
 
   MPI_Comm_free(&neighbour_comm);
@@ -374,81 +435,161 @@ get_local_indexing(
 }
 //-----------------------------------------------------------------------------
 
-/// Compute entities of dimension d
-/// @param[in] comm MPI communicator (TODO: full or neighbour hood?)
+/// Build, for each requested entity dimension, the list of entity
+/// vertices over all cells, in a single sweep over the cells. The cell
+/// vertices are fetched once per cell and shared between the
+/// dimensions; when each dimension is computed independently this part
+/// of entity creation is repeated per dimension.
 /// @param[in] cells Adjacency list for cell-vertex connectivity
-/// @param[in] shared_vertices TODO
 /// @param[in] cell_type Cell type
-/// @param[in] dim Topological dimension of the entities to be computed
-/// @return Returns the (cell-entity connectivity, entity-cell
+/// @param[in] dims Topological dimensions of the entities to enumerate
+/// @return For each dimension in @p dims, a 2D array with one row per
+///   (cell, local entity) pair holding the entity vertices
+std::vector<
+    Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+fill_entity_lists(const graph::AdjacencyList<std::int32_t>& cells,
+                  mesh::CellType cell_type, const std::vector<int>& dims)
+{
+  const int num_cells = cells.num_nodes();
+  const std::size_t num_dims = dims.size();
+
+  // Per-dimension entity counts and cell vertex -> entity vertex maps
+  std::vector<int> num_entities_per_cell(num_dims);
+  std::vector<int> num_vertices_per_entity(num_dims);
+  std::vector<const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                                 Eigen::RowMajor>*>
+      e_vertices(num_dims);
+  std::vector<
+      Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+      entity_lists(num_dims);
+  for (std::size_t d = 0; d < num_dims; ++d)
+  {
+    num_entities_per_cell[d] = mesh::cell_num_entities(cell_type, dims[d]);
+    num_vertices_per_entity[d]
+        = mesh::num_cell_vertices(mesh::cell_entity_type(cell_type, dims[d]));
+    e_vertices[d] = &mesh::get_entity_vertices(cell_type, dims[d]);
+    entity_lists[d].resize(num_cells * num_entities_per_cell[d],
+                           num_vertices_per_entity[d]);
+  }
+
+  // Cells are independent, so the enumeration is split into contiguous
+  // cell ranges that are filled concurrently
+  const auto fill_entities = [&](int c_begin, int c_end) {
+    for (int c = c_begin; c < c_end; ++c)
+    {
+      // Get vertices from cell (once, for all requested dimensions)
+      auto vertices = cells.links(c);
+
+      // Iterate over entities of cell for each dimension
+      for (std::size_t d = 0; d < num_dims; ++d)
+      {
+        const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                           Eigen::RowMajor>& ev
+            = *e_vertices[d];
+        for (int i = 0; i < num_entities_per_cell[d]; ++i)
+        {
+          // Get entity vertices
+          const int k = c * num_entities_per_cell[d] + i;
+          for (int j = 0; j < num_vertices_per_entity[d]; ++j)
+            entity_lists[d](k, j) = vertices[ev(i, j)];
+        }
+      }
+    }
+  };
+
+  const int num_threads = common::num_worker_threads();
+  if (num_threads > 1 and num_cells > num_threads)
+  {
+    std::vector<std::thread> threads;
+    const int chunk = (num_cells + num_threads - 1) / num_threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+      const int c_begin = t * chunk;
+      const int c_end = std::min(c_begin + chunk, num_cells);
+      threads.emplace_back(fill_entities, c_begin, c_end);
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  else
+    fill_entities(0, num_cells);
+
+  return entity_lists;
+}
+//-----------------------------------------------------------------------------
+
+/// Number the entities enumerated in entity_list and build the
+/// cell-entity and entity-vertex connectivity and the entity index map.
+/// This is the per-dimension part of entity creation; the entity list
+/// comes from fill_entity_lists and the vertex sharing information is
+/// supplied by the caller so both can be shared between dimensions.
+/// @param[in] comm MPI communicator
+/// @param[in] entity_list One row per (cell, local entity) pair holding
+///   the entity vertices, as built by fill_entity_lists
+/// @param[in] vertex_index_map IndexMap for vertices
+/// @param[in] cell_index_map IndexMap for cells
+/// @param[in] shared_vertices Map from local vertex index to sharing
+///   processes for the vertex index map
+/// @param[in] dim Topological dimension of the entities
+/// @return Returns the (cell-entity connectivity, entity-vertex
 ///   connectivity, index map for the entity distribution across
-///   processes, shared entities)
+///   processes)
 std::tuple<std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<common::IndexMap>>
-compute_entities_by_key_matching(
-    MPI_Comm comm, const graph::AdjacencyList<std::int32_t>& cells,
+build_entities_from_list(
+    MPI_Comm comm,
+    const Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& entity_list,
     const std::shared_ptr<const common::IndexMap>& vertex_index_map,
     const std::shared_ptr<const common::IndexMap>& cell_index_map,
+    const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices,
     mesh::CellType cell_type, int dim)
 {
-  if (dim == 0)
-  {
-    throw std::runtime_error(
-        "Cannot create vertices for topology. Should already exist.");
-  }
-
   // Start timer
   common::Timer timer("Compute entities of dim = " + std::to_string(dim));
 
-  // Initialize local array of entities
   const std::int8_t num_entities_per_cell
       = mesh::cell_num_entities(cell_type, dim);
   const int num_vertices_per_entity
       = mesh::num_cell_vertices(mesh::cell_entity_type(cell_type, dim));
-
-  // Create map from cell vertices to entity vertices
-  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> e_vertices
-      = mesh::get_entity_vertices(cell_type, dim);
-
-  const int num_cells = cells.num_nodes();
-
-  // List of vertices for each entity in each cell
-  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      entity_list(num_cells * num_entities_per_cell, num_vertices_per_entity);
-  int k = 0;
-  for (int c = 0; c < num_cells; ++c)
-  {
-    // Get vertices from cell
-    auto vertices = cells.links(c);
-
-    // Iterate over entities of cell
-    for (int i = 0; i < num_entities_per_cell; ++i)
-    {
-      // Get entity vertices
-      for (int j = 0; j < num_vertices_per_entity; ++j)
-        entity_list(k, j) = vertices[e_vertices(i, j)];
-
-      ++k;
-    }
-  }
-  assert(k == entity_list.rows());
+  const int num_cells = entity_list.rows() / num_entities_per_cell;
 
   std::vector<std::int32_t> entity_index(entity_list.rows());
   std::int32_t entity_count = 0;
 
-  // Copy list and sort vertices of each entity into order
+  // Copy list and sort vertices of each entity into order, again over
+  // concurrent row ranges
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       entity_list_sorted = entity_list;
-  for (int i = 0; i < entity_list_sorted.rows(); ++i)
+  const int num_rows = entity_list_sorted.rows();
+  const int num_threads = common::num_worker_threads();
+  const auto sort_rows = [&](int r_begin, int r_end) {
+    for (int i = r_begin; i < r_end; ++i)
+    {
+      std::sort(entity_list_sorted.row(i).data(),
+                entity_list_sorted.row(i).data() + num_vertices_per_entity);
+    }
+  };
+  if (num_threads > 1 and num_rows > num_threads)
   {
-    std::sort(entity_list_sorted.row(i).data(),
-              entity_list_sorted.row(i).data() + num_vertices_per_entity);
+    std::vector<std::thread> threads;
+    const int chunk = (num_rows + num_threads - 1) / num_threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+      const int r_begin = t * chunk;
+      const int r_end = std::min(r_begin + chunk, num_rows);
+      threads.emplace_back(sort_rows, r_begin, r_end);
+    }
+    for (std::thread& thread : threads)
+      thread.join();
   }
+  else
+    sort_rows(0, num_rows);
 
-  // Sort the list and label uniquely
+  // Sort the list (sharded across threads) and label uniquely
   std::vector<std::int32_t> sort_order
-      = sort_by_perm<std::int32_t>(entity_list_sorted);
+      = parallel_sort_by_perm<std::int32_t>(entity_list_sorted, num_threads);
   std::int32_t last = sort_order[0];
   entity_index[last] = 0;
   for (std::size_t i = 1; i < sort_order.size(); ++i)
@@ -464,8 +605,9 @@ compute_entities_by_key_matching(
   // Communicate with other processes to find out which entities are
   // ghosted and shared. Remap the numbering so that ghosts are at the
   // end.
-  auto [local_index, index_map] = get_local_indexing(
-      comm, cell_index_map, vertex_index_map, entity_list, entity_index);
+  auto [local_index, index_map]
+      = get_local_indexing(comm, cell_index_map, vertex_index_map, entity_list,
+                           entity_index, shared_vertices);
 
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       connectivity_ce(num_cells, num_entities_per_cell);
@@ -488,6 +630,45 @@ compute_entities_by_key_matching(
 }
 //-----------------------------------------------------------------------------
 
+/// Compute entities of dimension d
+/// @param[in] comm MPI communicator (TODO: full or neighbour hood?)
+/// @param[in] cells Adjacency list for cell-vertex connectivity
+/// @param[in] vertex_index_map IndexMap for vertices
+/// @param[in] cell_index_map IndexMap for cells
+/// @param[in] cell_type Cell type
+/// @param[in] dim Topological dimension of the entities to be computed
+/// @return Returns the (cell-entity connectivity, entity-vertex
+///   connectivity, index map for the entity distribution across
+///   processes)
+std::tuple<std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+           std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+           std::shared_ptr<common::IndexMap>>
+compute_entities_by_key_matching(
+    MPI_Comm comm, const graph::AdjacencyList<std::int32_t>& cells,
+    const std::shared_ptr<const common::IndexMap>& vertex_index_map,
+    const std::shared_ptr<const common::IndexMap>& cell_index_map,
+    mesh::CellType cell_type, int dim)
+{
+  if (dim == 0)
+  {
+    throw std::runtime_error(
+        "Cannot create vertices for topology. Should already exist.");
+  }
+
+  const std::vector<
+      Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                   Eigen::RowMajor>>
+      entity_lists = fill_entity_lists(cells, cell_type, {dim});
+
+  const std::map<std::int32_t, std::set<std::int32_t>> shared_vertices
+      = vertex_index_map->compute_shared_indices();
+
+  return build_entities_from_list(comm, entity_lists.front(), vertex_index_map,
+                                  cell_index_map, shared_vertices, cell_type,
+                                  dim);
+}
+//-----------------------------------------------------------------------------
+
 /// Compute connectivity from entities of dimension d0 to entities of
 /// dimension d1 using the transpose connectivity (d1 -> d0)
 /// @param[in] c_d1_d0 The connectivity from entities of dimension d1 to
@@ -512,15 +693,12 @@ compute_from_transpose(const graph::AdjacencyList<std::int32_t>& c_d1_d0,
   }
 
   // Compute offsets
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets
-      = Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::Zero(
-          num_connections.size() + 1);
+  std::vector<std::int32_t> offsets(num_connections.size() + 1, 0);
   std::partial_sum(num_connections.begin(), num_connections.end(),
                    offsets.data() + 1);
 
   std::vector<std::int32_t> counter(num_connections.size(), 0);
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> connections(
-      offsets[offsets.rows() - 1]);
+  std::vector<std::int32_t> connections(offsets.back());
   for (int e1 = 0; e1 < c_d1_d0.num_nodes(); ++e1)
   {
     auto e = c_d1_d0.links(e1);
@@ -545,8 +723,8 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
                  const graph::AdjacencyList<std::int32_t>& c_d1_0,
                  CellType cell_type_d0, int d0, int d1)
 {
-  assert(d1 > 0);
-  assert(d0 > d1);
+  DOLFINX_ASSERT(d1 > 0);
+  DOLFINX_ASSERT(d0 > d1);
 
   // Make a map from the sorted d1 entity vertices to the d1 entity
   // index
@@ -570,7 +748,7 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
 
   // Search for d1 entities of d0 in map, and recover index
   std::vector<std::int32_t> entities;
-  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
       e_vertices_ref = mesh::get_entity_vertices(cell_type_d0, d1);
   Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> keys
       = e_vertices_ref;
@@ -587,7 +765,8 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
                              keys.row(i).data() + keys.row(i).cols(),
                              key.begin(), key.end());
       const auto it = entity_to_index.find(key);
-      assert(it != entity_to_index.end());
+      DOLFINX_CHECK(it != entity_to_index.end(),
+                    "entity vertex key not found");
       entities.push_back(it->second);
     }
     for (std::size_t k = 0; k < entities.size(); ++k)
@@ -597,6 +776,127 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
   return graph::AdjacencyList<std::int32_t>(connections);
 }
 //-----------------------------------------------------------------------------
+
+/// Compute connectivity from a subset of entities of dimension d0 to
+/// incident entities of lower dimension d1 by vertex key matching,
+/// visiting only the requested d0 entities
+/// @param[in] c_d0_0 The d0 -> 0 (entity -> vertex) connectivity
+/// @param[in] c_d1_0 The d1 -> 0 (entity -> vertex) connectivity
+/// @param[in] cell_type_d0 The cell type for entities of dimension d0
+/// @param[in] d1 The target entity dimension
+/// @param[in] entities The d0 entities to compute the connectivity for
+/// @return The connectivity, one node per requested entity
+graph::AdjacencyList<std::int32_t>
+compute_from_map_subset(const graph::AdjacencyList<std::int32_t>& c_d0_0,
+                        const graph::AdjacencyList<std::int32_t>& c_d1_0,
+                        CellType cell_type_d0, int d1,
+                        const std::vector<std::int32_t>& entities)
+{
+  // Make a map from the sorted d1 entity vertices to the d1 entity
+  // index
+  boost::unordered_map<std::vector<std::int32_t>, std::int32_t> entity_to_index;
+  entity_to_index.reserve(c_d1_0.num_nodes());
+
+  const std::size_t num_verts_d1
+      = mesh::num_cell_vertices(mesh::cell_entity_type(cell_type_d0, d1));
+
+  std::vector<std::int32_t> key(num_verts_d1);
+  for (int e = 0; e < c_d1_0.num_nodes(); ++e)
+  {
+    const std::int32_t* v = c_d1_0.links_ptr(e);
+    std::partial_sort_copy(v, v + num_verts_d1, key.begin(), key.end());
+    entity_to_index.insert({key, e});
+  }
+
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      e_vertices_ref = mesh::get_entity_vertices(cell_type_d0, d1);
+  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> keys
+      = e_vertices_ref;
+
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      connections(entities.size(), e_vertices_ref.rows());
+
+  // Search for d1 entities of the requested d0 entities in map, and
+  // recover index
+  for (std::size_t p = 0; p < entities.size(); ++p)
+  {
+    auto e0 = c_d0_0.links(entities[p]);
+    for (Eigen::Index i = 0; i < e_vertices_ref.rows(); ++i)
+      for (Eigen::Index j = 0; j < e_vertices_ref.cols(); ++j)
+        keys(i, j) = e0[e_vertices_ref(i, j)];
+    for (Eigen::Index i = 0; i < keys.rows(); ++i)
+    {
+      std::partial_sort_copy(keys.row(i).data(),
+                             keys.row(i).data() + keys.row(i).cols(),
+                             key.begin(), key.end());
+      const auto it = entity_to_index.find(key);
+      DOLFINX_CHECK(it != entity_to_index.end(),
+                    "entity vertex key not found");
+      connections(p, i) = it->second;
+    }
+  }
+
+  return graph::AdjacencyList<std::int32_t>(connections);
+}
+//-----------------------------------------------------------------------------
+
+/// Compute connectivity from a subset of entities of dimension d0 to
+/// incident entities of higher dimension d1. The requested d0 entities
+/// are hashed by their sorted vertex keys and the d1 entities are
+/// scanned once, so memory scales with the size of the subset rather
+/// than with the total number of entities.
+/// @param[in] c_d0_0 The d0 -> 0 (entity -> vertex) connectivity
+/// @param[in] c_d1_0 The d1 -> 0 (entity -> vertex) connectivity
+/// @param[in] cell_type_d1 The cell type for entities of dimension d1
+/// @param[in] d0 The source entity dimension
+/// @param[in] entities The d0 entities to compute the connectivity for
+/// @return The connectivity, one node per requested entity
+graph::AdjacencyList<std::int32_t>
+compute_transpose_subset(const graph::AdjacencyList<std::int32_t>& c_d0_0,
+                         const graph::AdjacencyList<std::int32_t>& c_d1_0,
+                         CellType cell_type_d1, int d0,
+                         const std::vector<std::int32_t>& entities)
+{
+  // Make a map from the sorted vertices of the requested d0 entities to
+  // their position in the subset
+  boost::unordered_map<std::vector<std::int32_t>, std::int32_t> entity_to_pos;
+  entity_to_pos.reserve(entities.size());
+
+  const std::size_t num_verts_d0
+      = mesh::num_cell_vertices(mesh::cell_entity_type(cell_type_d1, d0));
+
+  std::vector<std::int32_t> key(num_verts_d0);
+  for (std::size_t p = 0; p < entities.size(); ++p)
+  {
+    const std::int32_t* v = c_d0_0.links_ptr(entities[p]);
+    std::partial_sort_copy(v, v + num_verts_d0, key.begin(), key.end());
+    entity_to_pos.insert({key, p});
+  }
+
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      e_vertices_ref = mesh::get_entity_vertices(cell_type_d1, d0);
+
+  // Scan the d1 entities and append each to the rows of its requested
+  // d0 sub-entities. Scanning in entity order keeps each row sorted, as
+  // for the full transpose computation.
+  std::vector<std::vector<std::int32_t>> connections(entities.size());
+  for (int e = 0; e < c_d1_0.num_nodes(); ++e)
+  {
+    auto v1 = c_d1_0.links(e);
+    for (Eigen::Index i = 0; i < e_vertices_ref.rows(); ++i)
+    {
+      for (Eigen::Index j = 0; j < e_vertices_ref.cols(); ++j)
+        key[j] = v1[e_vertices_ref(i, j)];
+      std::sort(key.begin(), key.end());
+      const auto it = entity_to_pos.find(key);
+      if (it != entity_to_pos.end())
+        connections[it->second].push_back(e);
+    }
+  }
+
+  return graph::AdjacencyList<std::int32_t>(connections);
+}
+//-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -632,9 +932,9 @@ TopologyComputation::compute_entities(MPI_Comm comm, const Topology& topology,
     throw std::runtime_error("Cell connectivity missing.");
 
   auto vertex_map = topology.index_map(0);
-  assert(vertex_map);
+  DOLFINX_ASSERT(vertex_map);
   auto cell_map = topology.index_map(tdim);
-  assert(cell_map);
+  DOLFINX_ASSERT(cell_map);
   std::tuple<std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
              std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
              std::shared_ptr<common::IndexMap>>
@@ -644,6 +944,68 @@ TopologyComputation::compute_entities(MPI_Comm comm, const Topology& topology,
   return data;
 }
 //-----------------------------------------------------------------------------
+std::vector<
+    std::tuple<int, std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+               std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+               std::shared_ptr<common::IndexMap>>>
+TopologyComputation::compute_entities_all(MPI_Comm comm,
+                                          const Topology& topology)
+{
+  const int tdim = topology.dim();
+
+  // Find the intermediate dimensions still to be created. Vertices and
+  // cells always exist.
+  std::vector<int> dims;
+  for (int d = 1; d < tdim; ++d)
+  {
+    if (!topology.connectivity(d, 0))
+      dims.push_back(d);
+  }
+  if (dims.empty())
+    return {};
+
+  LOG(INFO) << "Computing mesh entities of all dimensions";
+  common::Timer timer("Compute entities (all dimensions)");
+
+  auto cells = topology.connectivity(tdim, 0);
+  if (!cells)
+    throw std::runtime_error("Cell connectivity missing.");
+
+  auto vertex_map = topology.index_map(0);
+  DOLFINX_ASSERT(vertex_map);
+  auto cell_map = topology.index_map(tdim);
+  DOLFINX_ASSERT(cell_map);
+
+  // Enumerate the entities of every requested dimension in one sweep
+  // over the cells
+  const std::vector<
+      Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                   Eigen::RowMajor>>
+      entity_lists = fill_entity_lists(*cells, topology.cell_type(), dims);
+
+  // Compute the vertex sharing information once; this drives the
+  // parallel numbering of every dimension
+  const std::map<std::int32_t, std::set<std::int32_t>> shared_vertices
+      = vertex_map->compute_shared_indices();
+
+  std::vector<
+      std::tuple<int, std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+                 std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+                 std::shared_ptr<common::IndexMap>>>
+      entities;
+  entities.reserve(dims.size());
+  for (std::size_t i = 0; i < dims.size(); ++i)
+  {
+    auto [ce, ev, index_map]
+        = build_entities_from_list(comm, entity_lists[i], vertex_map, cell_map,
+                                   shared_vertices, topology.cell_type(),
+                                   dims[i]);
+    entities.emplace_back(dims[i], ce, ev, index_map);
+  }
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
 std::array<std::shared_ptr<graph::AdjacencyList<std::int32_t>>, 2>
 TopologyComputation::compute_connectivity(const Topology& topology, int d0,
                                           int d1)
@@ -697,8 +1059,8 @@ TopologyComputation::compute_connectivity(const Topology& topology, int d0,
     }
     else
     {
-      assert(c_d0_0);
-      assert(topology.connectivity(d1, d0));
+      DOLFINX_ASSERT(c_d0_0);
+      DOLFINX_ASSERT(topology.connectivity(d1, d0));
       auto c_d0_d1 = std::make_shared<graph::AdjacencyList<std::int32_t>>(
           compute_from_transpose(*topology.connectivity(d1, d0),
                                  c_d0_0->num_nodes(), d0, d1));
@@ -719,3 +1081,68 @@ TopologyComputation::compute_connectivity(const Topology& topology, int d0,
     throw std::runtime_error("Entity dimension error when computing topology.");
 }
 //--------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+TopologyComputation::compute_connectivity_subset(
+    const Topology& topology, int d0, int d1,
+    const std::vector<std::int32_t>& entities)
+{
+  LOG(INFO) << "Requesting connectivity " << d0 << " - " << d1 << " for "
+            << entities.size() << " entities";
+
+  // Gather rows directly if the full connectivity is already available
+  if (auto c = topology.connectivity(d0, d1); c)
+  {
+    std::vector<std::vector<std::int32_t>> connections(entities.size());
+    for (std::size_t p = 0; p < entities.size(); ++p)
+    {
+      auto links = c->links(entities[p]);
+      connections[p].assign(links.data(), links.data() + links.rows());
+    }
+    return graph::AdjacencyList<std::int32_t>(connections);
+  }
+
+  // Get entities exist
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c_d0_0
+      = topology.connectivity(d0, 0);
+  if (d0 > 0 and !c_d0_0)
+  {
+    throw std::runtime_error("Missing entities of dimension "
+                             + std::to_string(d0) + ".");
+  }
+
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c_d1_0
+      = topology.connectivity(d1, 0);
+  if (d1 > 0 and !c_d1_0)
+  {
+    throw std::runtime_error("Missing entities of dimension "
+                             + std::to_string(d1) + ".");
+  }
+
+  // Start timer
+  common::Timer timer("Compute subset connectivity " + std::to_string(d0) + "-"
+                      + std::to_string(d1));
+
+  // Decide how to compute the connectivity
+  if (d0 == d1)
+  {
+    std::vector<std::vector<std::int32_t>> connections(entities.size());
+    for (std::size_t p = 0; p < entities.size(); ++p)
+      connections[p] = {entities[p]};
+    return graph::AdjacencyList<std::int32_t>(connections);
+  }
+  else if (d0 < d1)
+  {
+    return compute_transpose_subset(
+        *c_d0_0, *c_d1_0, mesh::cell_entity_type(topology.cell_type(), d1), d0,
+        entities);
+  }
+  else
+  {
+    // Compute by mapping vertices from a lower dimension entity to
+    // those of a higher dimension entity
+    return compute_from_map_subset(
+        *c_d0_0, *c_d1_0, mesh::cell_entity_type(topology.cell_type(), d0), d1,
+        entities);
+  }
+}
+//--------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include <dolfinx/common/MPI.h>
 #include <memory>
 #include <tuple>
+#include <vector>
 
 namespace dolfinx
 {
@@ -51,6 +52,25 @@ public:
                     std::shared_ptr<common::IndexMap>>
   compute_entities(MPI_Comm comm, const Topology& topology, int dim);
 
+  /// Compute all missing intermediate entities (0 < dim < tdim) in a
+  /// single fused pass. The per-cell entity enumeration for all
+  /// dimensions is done in one sweep over the cells, and the vertex
+  /// sharing information (a parallel computation on the vertex IndexMap)
+  /// is computed once and shared between the dimensions, rather than
+  /// repeating both per dimension as compute_entities does. Used by
+  /// Topology::create_connectivity_all ahead of computing the full
+  /// connectivity closure.
+  /// @param[in] comm MPI Communicator
+  /// @param[in] topology Mesh topology
+  /// @return For each dimension created, a tuple of (dimension,
+  ///   cell-entity connectivity, entity-vertex connectivity, index
+  ///   map). Dimensions whose entities already exist are skipped.
+  static std::vector<
+      std::tuple<int, std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+                 std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+                 std::shared_ptr<common::IndexMap>>>
+  compute_entities_all(MPI_Comm comm, const Topology& topology);
+
   /// Compute connectivity (d0 -> d1) for given pair of topological
   /// dimensions
   /// @param[in] topology The topology
@@ -63,6 +83,22 @@ public:
   ///   as the second entry. The second entry is otherwise nullptr.
   static std::array<std::shared_ptr<graph::AdjacencyList<std::int32_t>>, 2>
   compute_connectivity(const Topology& topology, int d0, int d1);
+
+  /// Compute connectivity (d0 -> d1) for a subset of entities of
+  /// dimension d0 only, without materialising the full adjacency list.
+  /// Memory use is proportional to the size of the subset, so
+  /// boundary-only workflows avoid the O(num entities) storage of
+  /// compute_connectivity. Entities of dimensions d0 and d1 must exist.
+  /// @param[in] topology The topology
+  /// @param[in] d0 The dimension of the nodes in the adjacency list
+  /// @param[in] d1 The dimension of the edges in the adjacency list
+  /// @param[in] entities Entities of dimension d0 (local indices) to
+  ///   compute the connectivity for
+  /// @return Adjacency list with one node per requested entity, in the
+  ///   order of @p entities
+  static graph::AdjacencyList<std::int32_t>
+  compute_connectivity_subset(const Topology& topology, int d0, int d1,
+                              const std::vector<std::int32_t>& entities);
 };
 } // namespace mesh
 } // namespace dolfinx
@@ -17,14 +17,22 @@ using namespace dolfinx;
 
 namespace
 {
+// The entity-vertex tables below are built once on first use and
+// returned by reference, so repeated queries have no construction
+// cost.
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_entity_vertices_interval(int dim)
 {
-  const static Eigen::Array<int, 2, 1> e0
-      = (Eigen::Array<int, 2, 1>() << 0, 1).finished();
-  const static Eigen::Array<int, 1, 2, Eigen::RowMajor> e1
-      = (Eigen::Array<int, 1, 2, Eigen::RowMajor>() << 0, 1).finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      e0 = (Eigen::Array<int, 2, 1>() << 0, 1).finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      e1 = (Eigen::Array<int, 1, 2, Eigen::RowMajor>() << 0, 1).finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      empty;
   switch (dim)
   {
   case 0:
@@ -32,170 +40,88 @@ get_entity_vertices_interval(int dim)
   case 1:
     return e1;
   default:
-    return Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>();
+    return empty;
   }
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_entity_vertices_triangle(int dim)
 {
   // We only need to know how to create edges
   assert(dim == 1);
+  (void)dim;
 
-  // Create the three edges
-  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> e(3, 2);
-  e(0, 0) = 1;
-  e(0, 1) = 2;
-  e(1, 0) = 0;
-  e(1, 1) = 2;
-  e(2, 0) = 0;
-  e(2, 1) = 1;
-
+  // The three edges
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      e = (Eigen::Array<int, 3, 2, Eigen::RowMajor>() << 1, 2, 0, 2, 0, 1)
+              .finished();
   return e;
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_entity_vertices_quadrilateral(int dim)
 {
   assert(dim == 1);
+  (void)dim;
 
-  // Create the four edges
-  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> e(4, 2);
-  e(0, 0) = 0;
-  e(0, 1) = 1;
-  e(1, 0) = 2;
-  e(1, 1) = 3;
-  e(2, 0) = 0;
-  e(2, 1) = 2;
-  e(3, 0) = 1;
-  e(3, 1) = 3;
-
+  // The four edges
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      e = (Eigen::Array<int, 4, 2, Eigen::RowMajor>() << 0, 1, 2, 3, 0, 2, 1,
+           3)
+              .finished();
   return e;
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_entity_vertices_tetrahedron(int dim)
 {
   // We only need to know how to create edges and faces
-  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> e;
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      edges = (Eigen::Array<int, 6, 2, Eigen::RowMajor>() << 2, 3, 1, 3, 1, 2,
+               0, 3, 0, 2, 0, 1)
+                  .finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      faces = (Eigen::Array<int, 4, 3, Eigen::RowMajor>() << 1, 2, 3, 0, 2, 3,
+               0, 1, 3, 0, 1, 2)
+                  .finished();
   switch (dim)
   {
   case 1:
-    // Resize data structure
-    e.resize(6, 2);
-
-    // Create the six edges
-    e(0, 0) = 2;
-    e(0, 1) = 3;
-    e(1, 0) = 1;
-    e(1, 1) = 3;
-    e(2, 0) = 1;
-    e(2, 1) = 2;
-    e(3, 0) = 0;
-    e(3, 1) = 3;
-    e(4, 0) = 0;
-    e(4, 1) = 2;
-    e(5, 0) = 0;
-    e(5, 1) = 1;
-    break;
+    return edges;
   case 2:
-    // Resize data structure
-    e.resize(4, 3);
-
-    // Create the four faces
-    e(0, 0) = 1;
-    e(0, 1) = 2;
-    e(0, 2) = 3;
-    e(1, 0) = 0;
-    e(1, 1) = 2;
-    e(1, 2) = 3;
-    e(2, 0) = 0;
-    e(2, 1) = 1;
-    e(2, 2) = 3;
-    e(3, 0) = 0;
-    e(3, 1) = 1;
-    e(3, 2) = 2;
-    break;
+    return faces;
   default:
     throw std::runtime_error("Illegal topological dimension");
   }
-
-  return e;
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_entity_vertices_hexahedron(int dim)
 {
   // We need to know how to create edges and faces
-
-  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> e;
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      edges = (Eigen::Array<int, 12, 2, Eigen::RowMajor>() << 0, 1, 2, 3, 4, 5,
+               6, 7, 0, 2, 1, 3, 4, 6, 5, 7, 0, 4, 1, 5, 2, 6, 3, 7)
+                  .finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      faces = (Eigen::Array<int, 6, 4, Eigen::RowMajor>() << 0, 1, 2, 3, 4, 5,
+               6, 7, 0, 1, 4, 5, 2, 3, 6, 7, 0, 2, 4, 6, 1, 3, 5, 7)
+                  .finished();
   switch (dim)
   {
   case 1:
-    // Resize data structure
-    e.resize(12, 2);
-
-    // Create the 12 edges
-    e(0, 0) = 0;
-    e(0, 1) = 1;
-    e(1, 0) = 2;
-    e(1, 1) = 3;
-    e(2, 0) = 4;
-    e(2, 1) = 5;
-    e(3, 0) = 6;
-    e(3, 1) = 7;
-    e(4, 0) = 0;
-    e(4, 1) = 2;
-    e(5, 0) = 1;
-    e(5, 1) = 3;
-    e(6, 0) = 4;
-    e(6, 1) = 6;
-    e(7, 0) = 5;
-    e(7, 1) = 7;
-    e(8, 0) = 0;
-    e(8, 1) = 4;
-    e(9, 0) = 1;
-    e(9, 1) = 5;
-    e(10, 0) = 2;
-    e(10, 1) = 6;
-    e(11, 0) = 3;
-    e(11, 1) = 7;
-    break;
+    return edges;
   case 2:
-    // Resize data structure
-    e.resize(6, 4);
-
-    // Create the 6 faces
-    e(0, 0) = 0;
-    e(0, 1) = 1;
-    e(0, 2) = 2;
-    e(0, 3) = 3;
-    e(1, 0) = 4;
-    e(1, 1) = 5;
-    e(1, 2) = 6;
-    e(1, 3) = 7;
-    e(2, 0) = 0;
-    e(2, 1) = 1;
-    e(2, 2) = 4;
-    e(2, 3) = 5;
-    e(3, 0) = 2;
-    e(3, 1) = 3;
-    e(3, 2) = 6;
-    e(3, 3) = 7;
-    e(4, 0) = 0;
-    e(4, 1) = 2;
-    e(4, 2) = 4;
-    e(4, 3) = 6;
-    e(5, 0) = 1;
-    e(5, 1) = 3;
-    e(5, 2) = 5;
-    e(5, 3) = 7;
-    break;
+    return faces;
   default:
     throw std::runtime_error("Illegal topological dimension. Must be 1 or 2.");
   }
-
-  return e;
 }
 //-----------------------------------------------------------------------------
 
@@ -277,7 +203,7 @@ mesh::CellType mesh::cell_facet_type(mesh::CellType type)
   }
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 mesh::get_entity_vertices(mesh::CellType type, int dim)
 {
   switch (type)
@@ -296,11 +222,10 @@ mesh::get_entity_vertices(mesh::CellType type, int dim)
     return get_entity_vertices_hexahedron(dim);
   default:
     throw std::runtime_error("Unsupported cell type.");
-    return Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>();
   }
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 mesh::get_sub_entities(CellType type, int dim0, int dim1)
 {
   if (dim0 != 2)
@@ -313,25 +238,35 @@ mesh::get_sub_entities(CellType type, int dim0, int dim1)
     throw std::runtime_error(
         "mesh::get_sub_entities supports getting edges (d=1) at present.");
   }
-  const static Eigen::Array<int, 1, 3, Eigen::RowMajor> triangle
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      triangle
       = (Eigen::Array<int, 1, 3, Eigen::RowMajor>() << 0, 1, 2).finished();
-  const static Eigen::Array<int, 1, 4, Eigen::RowMajor> quadrilateral
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      quadrilateral
       = (Eigen::Array<int, 1, 4, Eigen::RowMajor>() << 0, 3, 1, 2).finished();
-  const static Eigen::Array<int, 4, 3, Eigen::RowMajor> tetrahedron
-      = (Eigen::Array<int, 4, 3, Eigen::RowMajor>() << 0, 1, 2, 0, 3, 4, 1, 3,
-         5, 2, 4, 5)
-            .finished();
-  const static Eigen::Array<int, 6, 4, Eigen::RowMajor> hexahedron
-      = (Eigen::Array<int, 6, 4, Eigen::RowMajor>() << 0, 1, 4, 5, 2, 3, 6, 7,
-         0, 2, 8, 9, 1, 3, 10, 11, 4, 6, 8, 10, 5, 7, 9, 11)
-            .finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      tetrahedron = (Eigen::Array<int, 4, 3, Eigen::RowMajor>() << 0, 1, 2, 0,
+                     3, 4, 1, 3, 5, 2, 4, 5)
+                        .finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      hexahedron = (Eigen::Array<int, 6, 4, Eigen::RowMajor>() << 0, 1, 4, 5,
+                    2, 3, 6, 7, 0, 2, 8, 9, 1, 3, 10, 11, 4, 6, 8, 10, 5, 7, 9,
+                    11)
+                       .finished();
+  const static Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>
+      empty;
 
   switch (type)
   {
   case mesh::CellType::interval:
-    return Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>();
+    return empty;
   case mesh::CellType::point:
-    return Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>();
+    return empty;
   case mesh::CellType::triangle:
     return triangle;
   case mesh::CellType::tetrahedron:
@@ -342,7 +277,6 @@ mesh::get_sub_entities(CellType type, int dim0, int dim1)
     return hexahedron;
   default:
     throw std::runtime_error("Unsupported cell type.");
-    return Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>();
   }
 
   // static const int triangle[][4] = {
@@ -425,9 +359,9 @@ mesh::cell_entity_closure(mesh::CellType cell_type)
   for (int i = 0; i <= cell_dim; ++i)
     num_entities[i] = mesh::cell_num_entities(cell_type, i);
 
-  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
       edge_v = mesh::get_entity_vertices(cell_type, 1);
-  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
       face_e = mesh::get_sub_entities(cell_type, 2, 1);
 
   std::map<std::array<int, 2>, std::vector<std::set<int>>> entity_closure;
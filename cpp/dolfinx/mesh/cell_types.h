@@ -50,13 +50,15 @@ CellType cell_facet_type(CellType type);
 
 /// Return array entities(num entities, num vertices per entity), where
 /// entities(e, k) is the local vertex index for the kth vertex of
-/// entity e of dimension dim
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+/// entity e of dimension dim. The returned reference is to a static
+/// table, so repeated queries have no construction cost.
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_entity_vertices(CellType type, int dim);
 
 /// Get entities of dimsion dim1 and that make up entities of dimension
-/// dim0
-Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+/// dim0. The returned reference is to a static table, so repeated
+/// queries have no construction cost.
+const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
 get_sub_entities(CellType type, int dim0, int dim1);
 
 /// Return topological dimension of cell type
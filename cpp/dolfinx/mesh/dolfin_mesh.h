@@ -12,11 +12,14 @@ namespace dolfinx
 // DOLFINX mesh interface
 
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/EntitySet.h>
 #include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/GeometryCache.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
 #include <dolfinx/mesh/MeshQuality.h>
 #include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/SharedCoordinates.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
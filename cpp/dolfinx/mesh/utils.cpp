@@ -11,9 +11,13 @@
 #include "cell_types.h"
 #include <Eigen/Dense>
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
 #include <cstdlib>
+#include <dolfinx/common/Counters.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <stdexcept>
 #include <unordered_set>
@@ -477,11 +481,12 @@ mesh::cell_normals(const mesh::Mesh& mesh, int dim)
     assert(map);
     const std::int32_t num_cells = map->size_local() + map->num_ghosts();
     Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> n(num_cells, 3);
+    const mesh::Topology::ConnectivitySpan e_to_v
+        = mesh.topology().connectivity_span(1, 0);
     for (int i = 0; i < num_cells; ++i)
     {
       // Get the two vertices as points
-      const mesh::MeshEntity e(mesh, 1, i);
-      auto vertices = e.entities(0);
+      const std::int32_t* vertices = e_to_v.links(i);
       Eigen::Vector3d p0 = geometry.node(vertices[0]);
       Eigen::Vector3d p1 = geometry.node(vertices[1]);
 
@@ -497,11 +502,12 @@ mesh::cell_normals(const mesh::Mesh& mesh, int dim)
     assert(map);
     const std::int32_t num_cells = map->size_local() + map->num_ghosts();
     Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> n(num_cells, 3);
+    const mesh::Topology::ConnectivitySpan c_to_v
+        = mesh.topology().connectivity_span(2, 0);
     for (int i = 0; i < num_cells; ++i)
     {
       // Get the three vertices as points
-      const mesh::MeshEntity e(mesh, 2, i);
-      auto vertices = e.entities(0);
+      const std::int32_t* vertices = c_to_v.links(i);
       const Eigen::Vector3d p0 = geometry.node(vertices[0]);
       const Eigen::Vector3d p1 = geometry.node(vertices[1]);
       const Eigen::Vector3d p2 = geometry.node(vertices[2]);
@@ -518,11 +524,12 @@ mesh::cell_normals(const mesh::Mesh& mesh, int dim)
     assert(map);
     const std::int32_t num_cells = map->size_local() + map->num_ghosts();
     Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> n(num_cells, 3);
+    const mesh::Topology::ConnectivitySpan c_to_v
+        = mesh.topology().connectivity_span(2, 0);
     for (int i = 0; i < num_cells; ++i)
     {
       // Get three vertices as points
-      const mesh::MeshEntity e(mesh, 2, i);
-      auto vertices = e.entities(0);
+      const std::int32_t* vertices = c_to_v.links(i);
       const Eigen::Vector3d p0 = geometry.node(vertices[0]);
       const Eigen::Vector3d p1 = geometry.node(vertices[1]);
       const Eigen::Vector3d p2 = geometry.node(vertices[2]);
@@ -795,6 +802,108 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> mesh::locate_entities(
       entities.data(), entities.size());
 }
 //-----------------------------------------------------------------------------
+Eigen::Array<std::int32_t, Eigen::Dynamic, 1> mesh::locate_entities_midpoint(
+    const mesh::Mesh& mesh, const int dim,
+    const std::function<Eigen::Array<bool, Eigen::Dynamic, 1>(
+        const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
+                                            Eigen::RowMajor>>&)>& marker)
+{
+  const mesh::Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+
+  // Create entities and connectivities
+  mesh.topology_mutable().create_entities(dim);
+  mesh.topology_mutable().create_connectivity(tdim, 0);
+  if (dim < tdim)
+    mesh.topology_mutable().create_connectivity(dim, 0);
+
+  // Get all vertex 'node' indices
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const std::int32_t num_vertices = topology.index_map(0)->size_local()
+                                    + topology.index_map(0)->num_ghosts();
+  auto c_to_v = topology.connectivity(tdim, 0);
+  assert(c_to_v);
+  std::vector<std::int32_t> vertex_to_node(num_vertices);
+  for (int c = 0; c < c_to_v->num_nodes(); ++c)
+  {
+    auto x_dofs = x_dofmap.links(c);
+    auto vertices = c_to_v->links(c);
+    for (int i = 0; i < vertices.size(); ++i)
+      vertex_to_node[vertices[i]] = x_dofs[i];
+  }
+
+  auto map_e = topology.index_map(dim);
+  assert(map_e);
+  const std::int32_t num_entities = map_e->size_local() + map_e->num_ghosts();
+  auto e_to_v = topology.connectivity(dim, 0);
+  assert(e_to_v);
+
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_nodes
+      = mesh.geometry().x();
+
+  // Evaluate the marker on fixed-size blocks of midpoints, with blocks
+  // distributed over the worker threads. Entities are flagged in a
+  // byte array (each thread writes a disjoint index range); marker
+  // misbehaviour is recorded and reported after the threads join.
+  constexpr std::int32_t block_size = 4096;
+  std::vector<std::uint8_t> entity_marked(num_entities, 0);
+  std::atomic<bool> bad_marker(false);
+  common::parallel_for(
+      num_entities, [&](std::int32_t begin, std::int32_t end) {
+        Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor> x_mid(
+            3, block_size);
+        for (std::int32_t start = begin; start < end; start += block_size)
+        {
+          const std::int32_t nb = std::min(block_size, end - start);
+          for (std::int32_t k = 0; k < nb; ++k)
+          {
+            const std::int32_t e = start + k;
+            if (dim == 0)
+            {
+              // Special case: a vertex is its own midpoint
+              x_mid.col(k) = x_nodes.row(vertex_to_node[e]).transpose();
+            }
+            else
+            {
+              // FIXME: This assumes a linear geometry.
+              auto vertices = e_to_v->links(e);
+              x_mid.col(k) = 0.0;
+              for (int i = 0; i < vertices.rows(); ++i)
+                x_mid.col(k)
+                    += x_nodes.row(vertex_to_node[vertices[i]]).transpose();
+              x_mid.col(k) /= vertices.rows();
+            }
+          }
+
+          const Eigen::Array<bool, Eigen::Dynamic, 1> marked
+              = marker(x_mid.leftCols(nb));
+          if (marked.rows() != nb)
+          {
+            bad_marker = true;
+            return;
+          }
+          for (std::int32_t k = 0; k < nb; ++k)
+          {
+            if (marked[k])
+              entity_marked[start + k] = 1;
+          }
+        }
+      });
+  if (bad_marker)
+    throw std::runtime_error("Length of array of markers is wrong.");
+
+  // Collect the marked entities in index order (sorted)
+  std::vector<std::int32_t> entities;
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    if (entity_marked[e])
+      entities.push_back(e);
+  }
+
+  return Eigen::Map<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>(
+      entities.data(), entities.size());
+}
+//-----------------------------------------------------------------------------
 Eigen::Array<std::int32_t, Eigen::Dynamic, 1> mesh::locate_entities_boundary(
     const mesh::Mesh& mesh, const int dim,
     const std::function<Eigen::Array<bool, Eigen::Dynamic, 1>(
@@ -914,3 +1023,68 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> mesh::locate_entities_boundary(
       entities.data(), entities.size());
 }
 //-----------------------------------------------------------------------------
+Table mesh::load_balance_report(const Mesh& mesh, double imbalance_threshold)
+{
+  const MPI_Comm comm = mesh.mpi_comm();
+  const int mpi_size = dolfinx::MPI::size(comm);
+  const int mpi_rank = dolfinx::MPI::rank(comm);
+
+  // Per-rank metrics: mesh sizes plus the accumulated throughput
+  // counters. Registering an already-registered counter name returns
+  // its existing id, so the counters are picked up whether or not the
+  // code that increments them has run yet.
+  const int tdim = mesh.topology().dim();
+  auto cell_map = mesh.topology().index_map(tdim);
+  assert(cell_map);
+  static const int c_cells
+      = common::Counters::register_counter("cells assembled");
+  static const int c_scatter
+      = common::Counters::register_counter("scatter bytes");
+  const std::array<std::pair<std::string, double>, 4> metrics
+      = {{{"cells (owned)", double(cell_map->size_local())},
+          {"cells (ghost)", double(cell_map->num_ghosts())},
+          {"cells assembled", double(common::Counters::value(c_cells))},
+          {"scatter bytes", double(common::Counters::value(c_scatter))}}};
+
+  // Element-wise reductions over the metrics; MPI_MAXLOC also locates
+  // the most loaded rank per metric (cf. timings_imbalance)
+  struct ValueRank
+  {
+    double value;
+    int rank;
+  };
+  std::vector<double> sum, min;
+  std::vector<ValueRank> max;
+  for (const auto& [name, value] : metrics)
+  {
+    sum.push_back(value);
+    min.push_back(value);
+    max.push_back({value, mpi_rank});
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sum.data(), sum.size(), MPI_DOUBLE, MPI_SUM,
+                comm);
+  MPI_Allreduce(MPI_IN_PLACE, min.data(), min.size(), MPI_DOUBLE, MPI_MIN,
+                comm);
+  MPI_Allreduce(MPI_IN_PLACE, max.data(), max.size(), MPI_DOUBLE_INT,
+                MPI_MAXLOC, comm);
+
+  Table table("Load balance report");
+  int i = 0;
+  for (const auto& [name, value] : metrics)
+  {
+    const double avg = sum[i] / mpi_size;
+    const double imbalance = avg > 0.0 ? max[i].value / avg : 1.0;
+    table.set(name, "avg", avg);
+    table.set(name, "min", min[i]);
+    table.set(name, "max", max[i].value);
+    table.set(name, "max rank", max[i].rank);
+    table.set(name, "imbalance", imbalance);
+    table.set(name, "status",
+              imbalance > imbalance_threshold ? std::string("repartition")
+                                              : std::string("ok"));
+    ++i;
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <dolfinx/common/Table.h>
 #include <dolfinx/graph/AdjacencyList.h>
 
 namespace dolfinx
@@ -85,6 +86,29 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> locate_entities(
         const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
                                             Eigen::RowMajor>>&)>& marker);
 
+/// Compute indices of all mesh entities whose midpoint evaluates to
+/// true for the provided geometric marking function. Unlike
+/// locate_entities, which requires all vertices of an entity to be
+/// marked, the marker here sees one coordinate (the entity midpoint)
+/// per entity, which is the natural test for marking facets by
+/// position. The midpoints are assembled and the marker evaluated in
+/// fixed-size coordinate blocks from several threads (see
+/// DOLFINX_NUM_THREADS), so the marker must be thread-safe and must
+/// not assume that it sees all entities in one call.
+///
+/// @param[in] mesh The mesh
+/// @param[in] dim The topological dimension of the entities to be
+///   considered
+/// @param[in] marker The marking function, evaluated on blocks of
+///   midpoint coordinates (shape 3 x block size)
+/// @returns Sorted list of marked entity indices, including any ghost
+///   indices (indices local to the process), ready for MeshTags
+Eigen::Array<std::int32_t, Eigen::Dynamic, 1> locate_entities_midpoint(
+    const mesh::Mesh& mesh, const int dim,
+    const std::function<Eigen::Array<bool, Eigen::Dynamic, 1>(
+        const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
+                                            Eigen::RowMajor>>&)>& marker);
+
 /// Compute indicies of all mesh entities that are attached to an owned
 /// boundary facet and evaluate to true for the provided geometric
 /// marking function. An entity is considered marked if the marker
@@ -112,5 +136,23 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> locate_entities_boundary(
         const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
                                             Eigen::RowMajor>>&)>& marker);
 
+/// Diagnose the load balance of a distributed mesh. For each metric
+/// (owned cells, ghost cells, and the accumulated throughput counters
+/// for cells assembled and halo-exchange bytes, see common::Counters)
+/// the table reports the average, minimum and maximum over the ranks,
+/// the rank holding the maximum, the imbalance ratio max/avg, and a
+/// status flagging metrics whose imbalance exceeds the threshold. Any
+/// flagged metric is the repartition trigger: call this at a natural
+/// synchronisation point (e.g. between time steps or adaptation
+/// cycles) and repartition when a metric reports "repartition". Wall
+/// time imbalance per task is available separately from
+/// timings_imbalance(). Collective; all ranks get the same table.
+///
+/// @param[in] mesh The mesh
+/// @param[in] imbalance_threshold Imbalance ratio (max/avg) above
+///   which a metric is flagged
+/// @return Table with per-metric balance statistics
+Table load_balance_report(const Mesh& mesh, double imbalance_threshold = 1.2);
+
 } // namespace mesh
 } // namespace dolfinx
@@ -6,13 +6,17 @@
 
 #include "NewtonSolver.h"
 #include "NonlinearProblem.h"
+#include <algorithm>
+#include <cmath>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/la/PETScKrylovSolver.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScOptions.h>
 #include <dolfinx/la/PETScVector.h>
+#include <dolfinx/la/VectorPool.h>
 #include <string>
+#include <tuple>
 
 using namespace dolfinx;
 
@@ -33,23 +37,43 @@ nls::NewtonSolver::NewtonSolver(MPI_Comm comm)
 //-----------------------------------------------------------------------------
 nls::NewtonSolver::~NewtonSolver()
 {
+  // Return the update vector to the pool, so e.g. a step loop
+  // creating one solver per step does not allocate a fresh vector
+  // every time
   if (_dx)
-    VecDestroy(&_dx);
+    la::VectorPool::checkin(_dx);
 }
 //-----------------------------------------------------------------------------
 std::pair<int, bool>
 dolfinx::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
 {
-  // Reset iteration counts
+  // Reset iteration counts and the residual extrapolation state
   int newton_iteration = 0;
   _krylov_iterations = 0;
+  _checked_iteration = 0;
+  _residual_rate = 0.0;
 
   // Compute F(u) (assembled into _b)
   Mat A(nullptr), P(nullptr);
   Vec b = nullptr;
 
+  // Use the fused residual+Jacobian callback when the problem provides
+  // one and every iteration reassembles the Jacobian (full Newton).
+  // The Jacobian of the final, converged iterate is then assembled
+  // speculatively, but every other iterate saves the work F and J
+  // share.
+  const bool fuse = nonlinear_problem.has_FJ() and !modified_newton
+                    and jacobian_lag <= 1;
+  bool jacobian_fresh = false;
+
   nonlinear_problem.form(x);
-  b = nonlinear_problem.F(x);
+  if (fuse)
+  {
+    std::tie(b, A) = nonlinear_problem.FJ(x);
+    jacobian_fresh = true;
+  }
+  else
+    b = nonlinear_problem.F(x);
   assert(b);
 
   // Check convergence
@@ -68,39 +92,102 @@ dolfinx::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
                              + convergence_criterion);
   }
 
+  // Reset the trust region radius
+  _delta = trust_radius;
+
+  // Residual history for the Jacobian lagging safeguard
+  double residual_prev = 0.0;
+  int lag_count = 0;
+  bool have_jacobian = false;
+
   // Start iterations
   while (!newton_converged and newton_iteration < max_it)
   {
-    // Compute Jacobian
-    A = nonlinear_problem.J(x);
-    assert(A);
-    P = nonlinear_problem.P(x);
-    if (!P)
-      P = A;
+    // Decide whether to (re)assemble the Jacobian. The Jacobian is
+    // reused for jacobian_lag iterations (or for the whole solve in
+    // modified Newton mode), unless the convergence rate has degraded
+    // past jacobian_lag_rate.
+    bool assemble_jacobian = !have_jacobian;
+    if (!assemble_jacobian and !modified_newton)
+      assemble_jacobian = (lag_count >= jacobian_lag);
+    if (!assemble_jacobian and residual_prev > 0.0
+        and _residual > jacobian_lag_rate * residual_prev)
+    {
+      LOG(INFO) << "Newton solver: convergence rate degraded, reassembling "
+                   "lagged Jacobian.";
+      assemble_jacobian = true;
+    }
+
+    if (assemble_jacobian)
+    {
+      // Compute Jacobian, unless the fused FJ call already assembled
+      // it at this iterate
+      if (!jacobian_fresh)
+        A = nonlinear_problem.J(x);
+      jacobian_fresh = false;
+      assert(A);
+      P = nonlinear_problem.P(x);
+      if (!P)
+        P = A;
 
-    if (!_dx)
-      MatCreateVecs(A, &_dx, nullptr);
+      if (!_dx)
+        _dx = la::VectorPool::checkout_like(x);
 
-    // FIXME: check that this is efficient if A and/or P are unchanged
-    // Set operators
-    _solver.set_operators(A, P);
+      // Set operators. Skipped while the Jacobian is lagged, so the
+      // linear solver keeps its preconditioner factorization.
+      _solver.set_operators(A, P);
+      lag_count = 0;
+      have_jacobian = true;
+    }
+    ++lag_count;
 
     // Perform linear solve and update total number of Krylov iterations
     _krylov_iterations += _solver.solve(_dx, b);
 
-    // Update solution
-    update_solution(x, _dx, relaxation_parameter, nonlinear_problem,
-                    newton_iteration);
+    // Update solution. The globalized strategies evaluate F at the
+    // accepted iterate themselves, so b is already current afterwards.
+    bool b_updated = false;
+    if (globalization == "none")
+    {
+      update_solution(x, _dx, relaxation_parameter, nonlinear_problem,
+                      newton_iteration);
+    }
+    else if (globalization == "line_search" or globalization == "trust_region")
+    {
+      globalized_update(x, _dx, b, nonlinear_problem);
+      b_updated = true;
+    }
+    else
+    {
+      throw std::runtime_error("Unknown globalization strategy: "
+                               + globalization);
+    }
 
     // Increment iteration count
     ++newton_iteration;
 
-    // FIXME: This step is not needed if residual is based on dx and
-    //        this has converged.
-    // FIXME: But, this function call may update internal variables, etc.
-    // Compute F
-    nonlinear_problem.form(x);
-    b = nonlinear_problem.F(x);
+    if (!b_updated)
+    {
+      // FIXME: This step is not needed if residual is based on dx and
+      //        this has converged.
+      // FIXME: But, this function call may update internal variables, etc.
+      // Compute F; in fused mode the Jacobian for the next iteration
+      // is assembled in the same sweep, and the norm reduction in the
+      // convergence test below overlaps with any communication the
+      // assembly left in flight
+      nonlinear_problem.form(x);
+      if (fuse)
+      {
+        std::tie(b, A) = nonlinear_problem.FJ(x);
+        jacobian_fresh = true;
+      }
+      else
+        b = nonlinear_problem.F(x);
+    }
+
+    // Save the residual of the previous iteration for the lagging
+    // safeguard before the convergence test overwrites it
+    residual_prev = _residual;
 
     // Test for convergence
     if (convergence_criterion == "residual")
@@ -153,8 +240,45 @@ double nls::NewtonSolver::residual0() const { return _residual0; }
 bool nls::NewtonSolver::converged(const Vec r, const NonlinearProblem&,
                                   std::size_t newton_iteration)
 {
+  // Possibly skip the (collective) norm evaluation. The decision is a
+  // function of previously reduced values and the iteration count
+  // only, so it is identical on all ranks.
+  if (convergence_check_interval > 1 and newton_iteration > 0
+      and newton_iteration - _checked_iteration
+              < std::size_t(convergence_check_interval)
+      and _residual_rate > 0.0)
+  {
+    const double estimate
+        = _residual
+          * std::pow(_residual_rate, newton_iteration - _checked_iteration);
+
+    // Extrapolate geometrically; Newton converges at least this fast
+    // near the solution, so the estimate is an overestimate and
+    // skipping is safe. Do a true check once the estimate comes within
+    // a factor 10 of the tolerance.
+    if (estimate > 10.0 * std::max(atol, rtol * _residual0))
+      return false;
+  }
+
   la::PETScVector _r(r, true);
-  _residual = _r.norm(la::Norm::l2);
+  double residual_new;
+  if (residual_norm == "linf")
+    residual_new = _r.norm(la::Norm::linf);
+  else if (residual_norm == "l2")
+    residual_new = _r.norm(la::Norm::l2);
+  else
+    throw std::runtime_error("Unknown residual norm: " + residual_norm);
+
+  // Update the observed reduction rate for the extrapolation on
+  // skipped checks
+  if (newton_iteration > _checked_iteration and _residual > 0.0)
+  {
+    _residual_rate
+        = std::pow(residual_new / _residual,
+                   1.0 / double(newton_iteration - _checked_iteration));
+  }
+  _checked_iteration = newton_iteration;
+  _residual = residual_new;
 
   // If this is the first iteration step, set initial residual
   if (newton_iteration == 0)
@@ -185,3 +309,88 @@ void nls::NewtonSolver::update_solution(Vec x, const Vec dx, double relaxation,
   VecAXPY(x, -relaxation, dx);
 }
 //-----------------------------------------------------------------------------
+double nls::NewtonSolver::globalized_update(Vec x, const Vec dx, Vec& b,
+                                            NonlinearProblem& nonlinear_problem)
+{
+  // Squared residual norm at the current iterate
+  double phi0;
+  VecNorm(b, NORM_2, &phi0);
+  phi0 = phi0 * phi0;
+
+  double dx_norm;
+  VecNorm(dx, NORM_2, &dx_norm);
+
+  // Step length: full (damped) step, capped by the trust radius
+  double lambda = relaxation_parameter;
+  if (globalization == "trust_region" and lambda * dx_norm > _delta
+      and dx_norm > 0.0)
+  {
+    lambda = _delta / dx_norm;
+  }
+
+  // Take the step and evaluate the residual
+  auto evaluate = [&]() {
+    nonlinear_problem.form(x);
+    b = nonlinear_problem.F(x);
+    double phi;
+    VecNorm(b, NORM_2, &phi);
+    return phi * phi;
+  };
+  VecAXPY(x, -lambda, dx);
+  double phi = evaluate();
+
+  if (globalization == "line_search")
+  {
+    // Backtrack while the Armijo decrease condition fails. The next
+    // step length minimizes the quadratic model of
+    // phi(s) = |F(x - s dx)|^2 built from phi(0), phi'(0) = -2 phi(0)
+    // and the last trial, so each trial costs a single F evaluation.
+    const double alpha = 1.0e-4;
+    int trials = 0;
+    while (phi > (1.0 - 2.0 * alpha * lambda) * phi0
+           and trials++ < max_backtrack)
+    {
+      const double denom = phi - (1.0 - 2.0 * lambda) * phi0;
+      double lambda_new
+          = denom > 0.0 ? phi0 * lambda * lambda / denom : 0.5 * lambda;
+      lambda_new = std::min(std::max(lambda_new, 0.1 * lambda), 0.5 * lambda);
+
+      // Pull the iterate back from lambda to lambda_new and re-test
+      VecAXPY(x, lambda - lambda_new, dx);
+      lambda = lambda_new;
+      phi = evaluate();
+    }
+  }
+  else if (globalization == "trust_region")
+  {
+    // Compare the actual residual reduction with the reduction
+    // (2 lambda - lambda^2) phi(0) predicted by the linearization,
+    // adapting the radius and rejecting steps with poor agreement
+    const double eta = 1.0e-4;
+    int trials = 0;
+    while (trials++ < max_backtrack)
+    {
+      const double pred = (2.0 * lambda - lambda * lambda) * phi0;
+      const double rho = pred > 0.0 ? (phi0 - phi) / pred : 0.0;
+
+      if (rho < 0.25)
+        _delta = 0.25 * lambda * dx_norm;
+      else if (rho > 0.75 and lambda * dx_norm > 0.99 * _delta)
+        _delta *= 2.0;
+
+      // Accept the step once the reduction is genuine
+      if (rho > eta)
+        break;
+
+      // Reject: pull the iterate back to the shrunken radius
+      const double lambda_new
+          = dx_norm > 0.0 ? std::min(lambda, _delta / dx_norm) : lambda;
+      VecAXPY(x, lambda - lambda_new, dx);
+      lambda = lambda_new;
+      phi = evaluate();
+    }
+  }
+
+  return lambda;
+}
+//-----------------------------------------------------------------------------
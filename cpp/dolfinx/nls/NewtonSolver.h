@@ -73,6 +73,25 @@ public:
   /// Convergence criterion
   std::string convergence_criterion = "residual";
 
+  /// Norm used in the convergence test: "l2" (default) or "linf". Both
+  /// cost one reduction per check; the infinity norm avoids the
+  /// squaring/square-root work on the local part, which matters for
+  /// very large local vectors.
+  std::string residual_norm = "l2";
+
+  /// Evaluate the residual norm (a global reduction) only every k-th
+  /// iteration. On the iterations in between, the residual is
+  /// extrapolated from the reduction rate observed between the last
+  /// two true checks; if the extrapolated value comes within a factor
+  /// 10 of the tolerance a true check is performed regardless, and
+  /// convergence is only ever declared from a true check. The skip
+  /// decision depends only on previously reduced values and the
+  /// iteration count, so all ranks agree without communication. With
+  /// k > 1 the collective count of the nonlinear loop drops by up to a
+  /// factor k, at the price of overshooting convergence by at most
+  /// k - 1 iterations.
+  int convergence_check_interval = 1;
+
   /// Monitor convergence
   bool report = true;
 
@@ -82,6 +101,40 @@ public:
   /// Relaxation parameter
   double relaxation_parameter = 1.0;
 
+  /// Number of iterations the Jacobian is reused for before it is
+  /// reassembled (Jacobian lagging). The default of 1 reassembles
+  /// every iteration (full Newton). While the Jacobian is lagged the
+  /// linear solver operators are left untouched, so the
+  /// preconditioner factorization is reused as well.
+  int jacobian_lag = 1;
+
+  /// While the Jacobian is lagged, reassemble early if the
+  /// convergence rate degrades, i.e. if the residual exceeds this
+  /// factor times the previous residual. Set to a value >= 1 to
+  /// disable the safeguard.
+  double jacobian_lag_rate = 0.5;
+
+  /// Modified Newton: assemble the Jacobian (and preconditioner
+  /// factorization) once per solve and reuse it for all iterations,
+  /// subject to the jacobian_lag_rate safeguard
+  bool modified_newton = false;
+
+  /// Globalization strategy for the Newton update: "none" (damped
+  /// step via update_solution, the default), "line_search"
+  /// (backtracking on the residual norm with a quadratic model
+  /// choosing the next step length, so each trial costs one F
+  /// evaluation) or "trust_region" (step length capped by an adaptive
+  /// trust radius). The globalized strategies bypass update_solution.
+  std::string globalization = "none";
+
+  /// Initial trust region radius (norm of the Newton step) for
+  /// globalization == "trust_region"
+  double trust_radius = 1.0e10;
+
+  /// Maximum number of rejected trial steps per Newton iteration for
+  /// the globalized strategies
+  int max_backtrack = 10;
+
 protected:
   /// Convergence test. It may be overloaded using virtual inheritance
   /// and this base criterion may be called from derived, both in C++
@@ -109,12 +162,29 @@ protected:
                                std::size_t iteration);
 
 private:
+  // Apply the Newton update with the selected globalization strategy,
+  // leaving b holding F at the accepted iterate. Returns the accepted
+  // step length.
+  double globalized_update(Vec x, const Vec dx, Vec& b,
+                           NonlinearProblem& nonlinear_problem);
+
   // Accumulated number of Krylov iterations since solve began
   int _krylov_iterations;
 
+  // Current trust region radius (reset to trust_radius at the start
+  // of each solve)
+  double _delta = 0.0;
+
   // Most recent residual and initial residual
   double _residual, _residual0;
 
+  // Iteration of the last true (reduced) residual evaluation and the
+  // per-iteration residual reduction rate observed between the last
+  // two true evaluations, used to extrapolate the residual on skipped
+  // checks when convergence_check_interval > 1
+  std::size_t _checked_iteration = 0;
+  double _residual_rate = 0.0;
+
   // Solver
   la::PETScKrylovSolver _solver;
 
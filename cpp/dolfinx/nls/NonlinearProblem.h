@@ -8,6 +8,7 @@
 
 #include <petscmat.h>
 #include <petscvec.h>
+#include <utility>
 
 namespace dolfinx::nls
 {
@@ -43,5 +44,22 @@ public:
   /// or leaving P empty results in system matrix A being used
   /// to construct preconditioner.
   virtual Mat P(const Vec) { return nullptr; }
+
+  /// Return true if FJ() assembles F and J in one pass. The Newton
+  /// solver then calls FJ at each new iterate instead of F followed by
+  /// J, so work shared between the two (coefficient packing, geometry
+  /// tabulation, the cell sweep itself) is done once.
+  virtual bool has_FJ() const { return false; }
+
+  /// Compute F and J together at current point x. Override together
+  /// with has_FJ() when the residual and Jacobian can be assembled in
+  /// one cell sweep, inserting into the vector and the matrix from the
+  /// same kernel invocation context. The returned matrix must be fully
+  /// assembled. The solver performs the residual norm reduction
+  /// between this call and the first use of J, so communication
+  /// initiated late in the assembly overlaps with the norm.
+  /// @param[in] x The current point
+  /// @return Pair of F(x) and J(x)
+  virtual std::pair<Vec, Mat> FJ(const Vec x) { return {F(x), J(x)}; }
 };
 } // namespace dolfinx::nls
@@ -5,11 +5,15 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "ParallelRefinement.h"
+#include <algorithm>
+#include <cstdlib>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/graph/ParMETIS.h>
 #include <dolfinx/graph/Partitioning.h>
 #include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/GraphBuilder.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/Partitioning.h>
@@ -17,6 +21,7 @@
 #include <dolfinx/mesh/TopologyComputation.h>
 #include <dolfinx/mesh/utils.h>
 #include <map>
+#include <utility>
 #include <vector>
 
 using namespace dolfinx;
@@ -182,15 +187,42 @@ ParallelRefinement::ParallelRefinement(const mesh::Mesh& mesh) : _mesh(mesh)
   for (std::size_t i = 0; i < neighbours.size(); ++i)
     proc_to_neighbour.insert({neighbours[i], i});
 
-  for (auto& q : shared_edges)
+  // Build the list of edges shared with each neighbour, ordered by
+  // global edge index. Both sides of a neighbour pair hold the same
+  // edges, so the ordering defines the bit positions of the marker
+  // bitmaps exchanged in update_logical_edgefunction.
+  std::vector<std::vector<std::pair<std::int64_t, std::int32_t>>> shared(
+      neighbours.size());
+  for (const auto& q : shared_edges)
   {
-    std::set<int> neighbour_set;
+    const std::int64_t global_index = local_to_global(q.first, *map_e);
+    std::set<std::int32_t> neighbour_set;
     for (int r : q.second)
+    {
+      shared[proc_to_neighbour[r]].push_back({global_index, q.first});
       neighbour_set.insert(proc_to_neighbour[r]);
+    }
     _shared_edges.insert({q.first, neighbour_set});
   }
+  _shared_with_neighbour.resize(neighbours.size());
+  for (std::size_t i = 0; i < shared.size(); ++i)
+  {
+    std::sort(shared[i].begin(), shared[i].end());
+    for (const auto& e : shared[i])
+      _shared_with_neighbour[i].push_back(e.second);
+  }
 
-  _marked_for_update.resize(neighbours.size());
+  // Preallocate the bitmap buffers and the (fixed) counts and
+  // displacements of the neighbour collective
+  _bitmap_count.resize(neighbours.size());
+  _bitmap_displ.resize(neighbours.size() + 1, 0);
+  for (std::size_t i = 0; i < neighbours.size(); ++i)
+  {
+    _bitmap_count[i] = (_shared_with_neighbour[i].size() + 63) / 64;
+    _bitmap_displ[i + 1] = _bitmap_displ[i] + _bitmap_count[i];
+  }
+  _send_bitmap.resize(_bitmap_displ.back());
+  _recv_bitmap.resize(_bitmap_displ.back());
 }
 //-----------------------------------------------------------------------------
 ParallelRefinement::~ParallelRefinement() { MPI_Comm_free(&_neighbour_comm); }
@@ -202,24 +234,18 @@ const std::vector<bool>& ParallelRefinement::marked_edges() const
 //-----------------------------------------------------------------------------
 bool ParallelRefinement::mark(std::int32_t edge_index)
 {
-  auto map1 = _mesh.topology().index_map(1);
-  assert(map1);
-  assert(edge_index < (map1->size_local() + map1->num_ghosts()));
+  assert(_mesh.topology().index_map(1));
+  assert(edge_index < (_mesh.topology().index_map(1)->size_local()
+                       + _mesh.topology().index_map(1)->num_ghosts()));
 
   // Already marked, so nothing to do
   if (_marked_edges[edge_index])
     return false;
 
+  // Shared edges are communicated as bitmaps over the full marker
+  // state in update_logical_edgefunction, so no per-mark bookkeeping
+  // is needed
   _marked_edges[edge_index] = true;
-
-  // If it is a shared edge, add all sharing neighbours to update set
-  if (auto map_it = _shared_edges.find(edge_index);
-      map_it != _shared_edges.end())
-  {
-    const std::int64_t global_index = local_to_global(edge_index, *map1);
-    for (int p : map_it->second)
-      _marked_for_update[p].push_back(global_index);
-  }
   return true;
 }
 //-----------------------------------------------------------------------------
@@ -255,28 +281,39 @@ void ParallelRefinement::mark(
 //-----------------------------------------------------------------------------
 void ParallelRefinement::update_logical_edgefunction()
 {
-  std::vector<std::int32_t> send_offsets = {0};
-  std::vector<std::int64_t> data_to_send;
-  int num_neighbours = _marked_for_update.size();
+  // Pack the marker state of the shared edges into one bitmap per
+  // neighbour, using the agreed global-index ordering for the bit
+  // positions. The buffers and counts are fixed, so no allocation
+  // happens per round and the traffic is one bit per shared edge.
+  const int num_neighbours = _shared_with_neighbour.size();
+  std::fill(_send_bitmap.begin(), _send_bitmap.end(), 0);
   for (int i = 0; i < num_neighbours; ++i)
   {
-    data_to_send.insert(data_to_send.end(), _marked_for_update[i].begin(),
-                        _marked_for_update[i].end());
-    _marked_for_update[i].clear();
-    send_offsets.push_back(data_to_send.size());
+    std::uint64_t* bits = _send_bitmap.data() + _bitmap_displ[i];
+    const std::vector<std::int32_t>& edges = _shared_with_neighbour[i];
+    for (std::size_t k = 0; k < edges.size(); ++k)
+    {
+      if (_marked_edges[edges[k]])
+        bits[k / 64] |= (std::uint64_t(1) << (k % 64));
+    }
   }
 
-  // Send all shared edges marked for update and receive from other
-  // processes
-  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> data_to_recv
-      = MPI::neighbor_all_to_all(_neighbour_comm, send_offsets, data_to_send)
-            .array();
+  MPI_Neighbor_alltoallv(_send_bitmap.data(), _bitmap_count.data(),
+                         _bitmap_displ.data(), MPI_UINT64_T,
+                         _recv_bitmap.data(), _bitmap_count.data(),
+                         _bitmap_displ.data(), MPI_UINT64_T, _neighbour_comm);
 
-  // Flatten received values and set _marked_edges at each index received
-  std::vector<std::int32_t> local_indices
-      = _mesh.topology().index_map(1)->global_to_local(data_to_recv);
-  for (std::int32_t local_index : local_indices)
-    _marked_edges[local_index] = true;
+  // Merge the received marker state
+  for (int i = 0; i < num_neighbours; ++i)
+  {
+    const std::uint64_t* bits = _recv_bitmap.data() + _bitmap_displ[i];
+    const std::vector<std::int32_t>& edges = _shared_with_neighbour[i];
+    for (std::size_t k = 0; k < edges.size(); ++k)
+    {
+      if (bits[k / 64] & (std::uint64_t(1) << (k % 64)))
+        _marked_edges[edges[k]] = true;
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 std::map<std::int32_t, std::int64_t> ParallelRefinement::create_new_vertices()
@@ -312,7 +349,7 @@ std::map<std::int32_t, std::int64_t> ParallelRefinement::create_new_vertices()
   // If they are shared, then the new global vertex index needs to be
   // sent off-process.
 
-  int num_neighbours = _marked_for_update.size();
+  int num_neighbours = _shared_with_neighbour.size();
   std::vector<std::vector<std::int64_t>> values_to_send(num_neighbours);
   for (auto& local_edge : local_edge_to_new_vertex)
   {
@@ -381,7 +418,8 @@ std::vector<std::int64_t> ParallelRefinement::adjust_indices(
 
   std::vector<std::int64_t> global_indices = index_map->global_indices(true);
 
-  Eigen::Array<int, Eigen::Dynamic, 1> ghost_owners = index_map->ghost_owners();
+  const Eigen::Array<int, Eigen::Dynamic, 1>& ghost_owners
+      = index_map->ghost_owners();
   int local_size = index_map->size_local();
   for (int i = 0; i < local_size; ++i)
     global_indices[i] += global_offsets[mpi_rank];
@@ -432,6 +470,32 @@ ParallelRefinement::partition(const std::vector<std::int64_t>& cell_topology,
   // Build mesh
   if (redistribute)
   {
+#ifdef HAS_PARMETIS
+    // Incremental (diffusive) repartitioning: set
+    // DOLFINX_ADAPTIVE_REPARTITION (optionally to the ParMETIS itr
+    // value) to compute destinations with ParMETIS AdaptiveRepart
+    // starting from the current distribution, so only
+    // imbalance-correcting migration occurs and the locality of
+    // unrefined regions is preserved. The default is a from-scratch
+    // partition, which may migrate every cell.
+    if (const char* itr_env = std::getenv("DOLFINX_ADAPTIVE_REPARTITION"))
+    {
+      double itr = std::atof(itr_env);
+      if (itr <= 0.0)
+        itr = 1000.0;
+      const auto [dual_graph, graph_info]
+          = mesh::GraphBuilder::compute_dual_graph(
+              _mesh.mpi_comm(), cells, _mesh.topology().cell_type());
+      const graph::AdjacencyList<std::int32_t> dest
+          = graph::ParMETIS::adaptive_repartition(
+              _mesh.mpi_comm(), graph::AdjacencyList<idx_t>(dual_graph), itr);
+      return mesh::create_mesh(_mesh.mpi_comm(),
+                               graph::AdjacencyList<std::int64_t>(cells),
+                               _mesh.geometry().cmap(),
+                               _new_vertex_coordinates, mesh::GhostMode::none,
+                               dest);
+    }
+#endif
     return mesh::create_mesh(_mesh.mpi_comm(),
                              graph::AdjacencyList<std::int64_t>(cells),
                              _mesh.geometry().cmap(), _new_vertex_coordinates,
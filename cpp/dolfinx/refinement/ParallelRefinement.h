@@ -112,13 +112,21 @@ private:
   // Management of marked edges
   std::vector<bool> _marked_edges;
 
-  // Temporary storage for edges that have been recently marked (global
-  // index)
-  std::vector<std::vector<std::int64_t>> _marked_for_update;
-
-  // Shared edges between processes
+  // Shared edges between processes (edge -> neighbour positions), used
+  // to route new vertex indices in create_new_vertices
   std::map<std::int32_t, std::set<std::int32_t>> _shared_edges;
 
+  // Edges (local indices) shared with each neighbour, ordered by
+  // global edge index. Both sides of a neighbour pair hold the same
+  // edges, so the position in this list defines the bit position in
+  // the marker bitmaps exchanged between the pair.
+  std::vector<std::vector<std::int32_t>> _shared_with_neighbour;
+
+  // Preallocated bitmap buffers and fixed per-neighbour counts and
+  // displacements (in 64-bit words) for the marker exchange
+  std::vector<std::uint64_t> _send_bitmap, _recv_bitmap;
+  std::vector<int> _bitmap_count, _bitmap_displ;
+
   // Neighbourhood communicator
   MPI_Comm _neighbour_comm;
 };
@@ -8,11 +8,14 @@
 #include "ParallelRefinement.h"
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/Topology.h>
 #include <limits>
 #include <map>
+#include <thread>
 #include <vector>
 
 using namespace dolfinx;
@@ -38,25 +41,39 @@ void enforce_rules(ParallelRefinement& p_ref, const mesh::Mesh& mesh,
   assert(f_to_e);
 
   const std::vector<bool>& marked_edges = p_ref.marked_edges();
+  std::vector<std::uint8_t> mark_face(num_faces);
   std::int32_t update_count = 1;
   while (update_count > 0)
   {
     update_count = 0;
     p_ref.update_logical_edgefunction();
-    for (int f = 0; f < num_faces; ++f)
-    {
-      const std::int32_t long_e = long_edge[f];
-      if (marked_edges[long_e])
-        continue;
 
-      bool any_marked = false;
-      auto edges = f_to_e->links(f);
-      for (int i = 0; i < edges.rows(); ++i)
-        any_marked = any_marked or marked_edges[edges[i]];
+    // Scan the faces in parallel (the markers are only read here); the
+    // marking itself is applied serially below since the edge markers
+    // are shared state
+    std::fill(mark_face.begin(), mark_face.end(), 0);
+    common::parallel_for(num_faces, [&](std::int32_t begin, std::int32_t end) {
+      for (std::int32_t f = begin; f < end; ++f)
+      {
+        const std::int32_t long_e = long_edge[f];
+        if (marked_edges[long_e])
+          continue;
+
+        bool any_marked = false;
+        auto edges = f_to_e->links(f);
+        for (int i = 0; i < edges.rows(); ++i)
+          any_marked = any_marked or marked_edges[edges[i]];
+
+        if (any_marked)
+          mark_face[f] = 1;
+      }
+    });
 
-      if (any_marked)
+    for (std::int32_t f = 0; f < num_faces; ++f)
+    {
+      if (mark_face[f] and !marked_edges[long_edge[f]])
       {
-        p_ref.mark(long_e);
+        p_ref.mark(long_edge[f]);
         ++update_count;
       }
     }
@@ -68,11 +85,16 @@ void enforce_rules(ParallelRefinement& p_ref, const mesh::Mesh& mesh,
   }
 }
 //-----------------------------------------------------------------------------
-// Convenient interface for both uniform and marker refinement
-mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
-                              const std::vector<std::int32_t>& long_edge,
-                              const std::vector<bool>& edge_ratio_ok,
-                              bool redistribute)
+// Convenient interface for both uniform and marker refinement. When
+// track_parent_cells is set, the second member of the returned pair
+// holds the local parent cell index of each refined cell; the refined
+// mesh is then built through the non-redistributing path so its cell
+// order matches the parent map.
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
+                   const std::vector<std::int32_t>& long_edge,
+                   const std::vector<bool>& edge_ratio_ok, bool redistribute,
+                   bool track_parent_cells = false)
 {
   const std::int32_t tdim = mesh.topology().dim();
   const std::int32_t num_cell_edges = tdim * 3 - 3;
@@ -82,11 +104,6 @@ mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
   const std::map<std::int32_t, std::int64_t> new_vertex_map
       = p_ref.create_new_vertices();
 
-  std::vector<std::size_t> parent_cell;
-  std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
-  std::vector<int> marked_edge_list;
-  std::vector<std::int32_t> simplex_set;
-
   auto map_c = mesh.topology().index_map(tdim);
   assert(map_c);
   const int num_cells = map_c->size_local() + map_c->num_ghosts();
@@ -106,87 +123,142 @@ mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
   std::vector<std::int64_t> global_indices = ParallelRefinement::adjust_indices(
       mesh.topology().index_map(0), num_new_vertices_local);
 
-  std::vector<std::int64_t> cell_topology;
-  for (int c = 0; c < num_cells; ++c)
-  {
-    // Create vector of indices in the order [vertices][edges], 3+3 in
-    // 2D, 4+6 in 3D
-
-    // Copy vertices
-    auto vertices = c_to_v->links(c);
-    for (int v = 0; v < vertices.rows(); ++v)
-      indices[v] = global_indices[vertices[v]];
-
-    // Get cell-local indices of marked edges
-    marked_edge_list.clear();
-    auto edges = c_to_e->links(c);
-    for (int ei = 0; ei < edges.rows(); ++ei)
-      if (marked_edges[edges[ei]])
-        marked_edge_list.push_back(ei);
-
-    if (marked_edge_list.empty())
+  // Build the refined cells for a range of parent cells. All shared
+  // inputs are read-only here, so disjoint ranges can run concurrently;
+  // each range appends to its own output buffers, which are
+  // concatenated in range order to keep the cell ordering identical to
+  // a serial pass
+  auto build_cells = [&](std::int32_t c_begin, std::int32_t c_end,
+                         std::vector<std::int64_t>& cell_topology,
+                         std::vector<std::int32_t>& parent_cell) {
+    std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
+    std::vector<int> marked_edge_list;
+    std::vector<std::int32_t> simplex_set;
+    for (std::int32_t c = c_begin; c < c_end; ++c)
     {
-      // Copy over existing Cell to new topology
+      // Create vector of indices in the order [vertices][edges], 3+3 in
+      // 2D, 4+6 in 3D
+
+      // Copy vertices
+      auto vertices = c_to_v->links(c);
       for (int v = 0; v < vertices.rows(); ++v)
-        cell_topology.push_back(global_indices[vertices[v]]);
-      parent_cell.push_back(c);
-    }
-    else
-    {
-      // Get the marked edge indices for new vertices and make bool
-      // vector of marked edges
-      std::vector<bool> markers(num_cell_edges, false);
-      for (int p : marked_edge_list)
+        indices[v] = global_indices[vertices[v]];
+
+      // Get cell-local indices of marked edges
+      marked_edge_list.clear();
+      auto edges = c_to_e->links(c);
+      for (int ei = 0; ei < edges.rows(); ++ei)
+        if (marked_edges[edges[ei]])
+          marked_edge_list.push_back(ei);
+
+      if (marked_edge_list.empty())
       {
-        markers[p] = true;
-        auto it = new_vertex_map.find(edges[p]);
-        assert(it != new_vertex_map.end());
-        indices[num_cell_vertices + p] = it->second;
+        // Copy over existing Cell to new topology
+        for (int v = 0; v < vertices.rows(); ++v)
+          cell_topology.push_back(global_indices[vertices[v]]);
+        parent_cell.push_back(c);
       }
+      else
+      {
+        // Get the marked edge indices for new vertices and make bool
+        // vector of marked edges
+        std::vector<bool> markers(num_cell_edges, false);
+        for (int p : marked_edge_list)
+        {
+          markers[p] = true;
+          auto it = new_vertex_map.find(edges[p]);
+          assert(it != new_vertex_map.end());
+          indices[num_cell_vertices + p] = it->second;
+        }
 
-      // Need longest edges of each face in cell local indexing
-      // NB in 2D the face is the cell itself, and there is just one entry
-      std::vector<std::int32_t> longest_edge;
-      auto faces = c_to_f->links(c);
-      for (int f = 0; f < faces.rows(); ++f)
-        longest_edge.push_back(long_edge[faces(f)]);
+        // Need longest edges of each face in cell local indexing
+        // NB in 2D the face is the cell itself, and there is just one entry
+        std::vector<std::int32_t> longest_edge;
+        auto faces = c_to_f->links(c);
+        for (int f = 0; f < faces.rows(); ++f)
+          longest_edge.push_back(long_edge[faces(f)]);
 
-      // Convert to cell local index
-      auto edges = c_to_e->links(c);
-      for (std::int32_t& p : longest_edge)
-      {
-        for (int ej = 0; ej < edges.rows(); ++ej)
+        // Convert to cell local index
+        auto edges = c_to_e->links(c);
+        for (std::int32_t& p : longest_edge)
         {
-          if (p == edges[ej])
+          for (int ej = 0; ej < edges.rows(); ++ej)
           {
-            p = ej;
-            break;
+            if (p == edges[ej])
+            {
+              p = ej;
+              break;
+            }
           }
         }
-      }
 
-      const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
+        const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
 
-      // FIXME: this has an expensive dynamic memory allocation
-      simplex_set = PlazaRefinementND::get_simplices(markers, longest_edge,
-                                                     tdim, uniform);
+        // FIXME: this has an expensive dynamic memory allocation
+        simplex_set = PlazaRefinementND::get_simplices(markers, longest_edge,
+                                                       tdim, uniform);
 
-      // Save parent index
-      const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
-      for (std::int32_t i = 0; i < ncells; ++i)
-        parent_cell.push_back(c);
+        // Save parent index
+        const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
+        for (std::int32_t i = 0; i < ncells; ++i)
+          parent_cell.push_back(c);
 
-      // Convert from cell local index to mesh index and add to cells
-      for (std::int32_t v : simplex_set)
-        cell_topology.push_back(indices[v]);
+        // Convert from cell local index to mesh index and add to cells
+        for (std::int32_t v : simplex_set)
+          cell_topology.push_back(indices[v]);
+      }
     }
+  };
+
+  // Subdivide the cells across the configured worker threads
+  std::vector<std::int64_t> cell_topology;
+  std::vector<std::int32_t> parent_cell;
+  const int num_threads = common::num_worker_threads();
+  if (num_threads <= 1 or num_cells < 1024)
+    build_cells(0, num_cells, cell_topology, parent_cell);
+  else
+  {
+    const std::int32_t chunk = (num_cells + num_threads - 1) / num_threads;
+    std::vector<std::vector<std::int64_t>> topology_chunks(num_threads);
+    std::vector<std::vector<std::int32_t>> parent_chunks(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+      const std::int32_t begin = t * chunk;
+      const std::int32_t end = std::min(num_cells, begin + chunk);
+      if (begin < end)
+      {
+        threads.emplace_back(build_cells, begin, end,
+                             std::ref(topology_chunks[t]),
+                             std::ref(parent_chunks[t]));
+      }
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+      cell_topology.insert(cell_topology.end(), topology_chunks[t].begin(),
+                           topology_chunks[t].end());
+      parent_cell.insert(parent_cell.end(), parent_chunks[t].begin(),
+                         parent_chunks[t].end());
+    }
+  }
+
+  if (track_parent_cells)
+  {
+    // The parent map indexes the refined cells by their position in
+    // cell_topology, so keep that cell order by building through the
+    // non-redistributing path (valid on any number of ranks)
+    return {p_ref.partition(cell_topology, false), std::move(parent_cell)};
   }
 
   const bool serial = (dolfinx::MPI::size(mesh.mpi_comm()) == 1);
   if (serial)
-    return p_ref.build_local(cell_topology);
+    return {p_ref.build_local(cell_topology), std::vector<std::int32_t>()};
   else
-    return p_ref.partition(cell_topology, redistribute);
+    return {p_ref.partition(cell_topology, redistribute),
+            std::vector<std::int32_t>()};
 }
 //-----------------------------------------------------------------------------
 // 2D version of subdivision allowing for uniform subdivision (flag)
@@ -369,31 +441,35 @@ face_long_edge(const mesh::Mesh& mesh)
   auto map_e = mesh.topology().index_map(1);
   assert(map_e);
   std::vector<double> edge_length(map_e->size_local() + map_e->num_ghosts());
-  for (std::size_t e = 0; e < edge_length.size(); ++e)
-  {
-    // Get first attached cell
-    assert(e_to_c->num_links(e) > 0);
-    const std::int32_t c = e_to_c->links(e)[0];
-    auto cell_vertices = c_to_v->links(c);
-    auto edge_vertices = e_to_v->links(e);
-
-    // Find local index of edge vertices in the cell geometry map
-    const auto* it0 = std::find(cell_vertices.data(),
-                                cell_vertices.data() + cell_vertices.rows(),
-                                edge_vertices[0]);
-    assert(it0 != (cell_vertices.data() + cell_vertices.rows()));
-    const int local0 = std::distance(cell_vertices.data(), it0);
-
-    const auto* it1 = std::find(cell_vertices.data(),
-                                cell_vertices.data() + cell_vertices.rows(),
-                                edge_vertices[1]);
-    assert(it1 != (cell_vertices.data() + cell_vertices.rows()));
-    const int local1 = std::distance(cell_vertices.data(), it1);
-
-    auto x_dofs = x_dofmap.links(c);
-    edge_length[e]
-        = (x.row(x_dofs[local0]) - x.row(x_dofs[local1])).matrix().norm();
-  }
+  common::parallel_for(
+      (std::int32_t)edge_length.size(),
+      [&](std::int32_t e_begin, std::int32_t e_end) {
+        for (std::int32_t e = e_begin; e < e_end; ++e)
+        {
+          // Get first attached cell
+          assert(e_to_c->num_links(e) > 0);
+          const std::int32_t c = e_to_c->links(e)[0];
+          auto cell_vertices = c_to_v->links(c);
+          auto edge_vertices = e_to_v->links(e);
+
+          // Find local index of edge vertices in the cell geometry map
+          const auto* it0 = std::find(
+              cell_vertices.data(), cell_vertices.data() + cell_vertices.rows(),
+              edge_vertices[0]);
+          assert(it0 != (cell_vertices.data() + cell_vertices.rows()));
+          const int local0 = std::distance(cell_vertices.data(), it0);
+
+          const auto* it1 = std::find(
+              cell_vertices.data(), cell_vertices.data() + cell_vertices.rows(),
+              edge_vertices[1]);
+          assert(it1 != (cell_vertices.data() + cell_vertices.rows()));
+          const int local1 = std::distance(cell_vertices.data(), it1);
+
+          auto x_dofs = x_dofmap.links(c);
+          edge_length[e]
+              = (x.row(x_dofs[local0]) - x.row(x_dofs[local1])).matrix().norm();
+        }
+      });
 
   // Get longest edge of each face
   auto f_to_v = mesh.topology().connectivity(2, 0);
@@ -402,42 +478,52 @@ face_long_edge(const mesh::Mesh& mesh)
   assert(f_to_e);
   const std::vector<std::int64_t> global_indices
       = mesh.topology().index_map(0)->global_indices(true);
-  for (int f = 0; f < f_to_v->num_nodes(); ++f)
-  {
-    auto face_edges = f_to_e->links(f);
 
-    std::int32_t imax = 0;
-    double max_len = 0.0;
-    double min_len = std::numeric_limits<double>::max();
+  // The faces are independent. The edge ratio flags are collected in a
+  // byte array since concurrent writes to distinct std::vector<bool>
+  // entries are not thread-safe.
+  std::vector<std::uint8_t> ratio_ok(tdim == 2 ? num_faces : 0);
+  common::parallel_for(
+      f_to_v->num_nodes(), [&](std::int32_t f_begin, std::int32_t f_end) {
+        for (std::int32_t f = f_begin; f < f_end; ++f)
+        {
+          auto face_edges = f_to_e->links(f);
 
-    for (int i = 0; i < 3; ++i)
-    {
-      const double e_len = edge_length[face_edges[i]];
-      min_len = std::min(e_len, min_len);
-      if (e_len > max_len)
-      {
-        max_len = e_len;
-        imax = i;
-      }
-      else if (tdim == 3 and e_len == max_len)
-      {
-        // If edges are the same length, compare global index of
-        // opposite vertex.  Only important so that tetrahedral faces
-        // have a matching refinement pattern across processes.
-        auto vertices = f_to_v->links(f);
-        const int vmax = vertices[imax];
-        const int vi = vertices[i];
-        if (global_indices[vi] > global_indices[vmax])
-          imax = i;
-      }
-    }
+          std::int32_t imax = 0;
+          double max_len = 0.0;
+          double min_len = std::numeric_limits<double>::max();
 
-    // Only save edge ratio in 2D
-    if (tdim == 2)
-      edge_ratio_ok[f] = (min_len / max_len >= min_ratio);
+          for (int i = 0; i < 3; ++i)
+          {
+            const double e_len = edge_length[face_edges[i]];
+            min_len = std::min(e_len, min_len);
+            if (e_len > max_len)
+            {
+              max_len = e_len;
+              imax = i;
+            }
+            else if (tdim == 3 and e_len == max_len)
+            {
+              // If edges are the same length, compare global index of
+              // opposite vertex.  Only important so that tetrahedral faces
+              // have a matching refinement pattern across processes.
+              auto vertices = f_to_v->links(f);
+              const int vmax = vertices[imax];
+              const int vi = vertices[i];
+              if (global_indices[vi] > global_indices[vmax])
+                imax = i;
+            }
+          }
 
-    long_edge[f] = face_edges[imax];
-  }
+          // Only save edge ratio in 2D
+          if (tdim == 2)
+            ratio_ok[f] = (min_len / max_len >= min_ratio) ? 1 : 0;
+
+          long_edge[f] = face_edges[imax];
+        }
+      });
+
+  std::copy(ratio_ok.begin(), ratio_ok.end(), edge_ratio_ok.begin());
 
   return std::pair(std::move(long_edge), std::move(edge_ratio_ok));
 }
@@ -459,8 +545,8 @@ mesh::Mesh PlazaRefinementND::refine(const mesh::Mesh& mesh, bool redistribute)
   ParallelRefinement p_ref(mesh);
   p_ref.mark_all();
 
-  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
-                            redistribute);
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, redistribute)
+      .first;
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh
@@ -482,8 +568,110 @@ PlazaRefinementND::refine(const mesh::Mesh& mesh,
 
   enforce_rules(p_ref, mesh, long_edge);
 
-  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
-                            redistribute);
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, redistribute)
+      .first;
+}
+//-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+PlazaRefinementND::refine_with_parent_cells(const mesh::Mesh& mesh)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: refine");
+  const auto [long_edge, edge_ratio_ok] = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  p_ref.mark_all();
+
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, false, true);
+}
+//-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+PlazaRefinementND::refine_with_parent_cells(
+    const mesh::Mesh& mesh,
+    const mesh::MeshTags<std::int8_t>& refinement_marker)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: refine");
+  const auto [long_edge, edge_ratio_ok] = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  p_ref.mark(refinement_marker);
+
+  enforce_rules(p_ref, mesh, long_edge);
+
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, false, true);
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh
+PlazaRefinementND::coarsen(const mesh::Mesh& mesh,
+                           const std::vector<std::int32_t>& parent_cell,
+                           const mesh::MeshTags<std::int8_t>& coarsen_marker)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: coarsen");
+
+  // Flag the refined cells that may be coarsened (marker value 1)
+  std::vector<bool> can_coarsen(parent_cell.size(), false);
+  const std::vector<std::int32_t>& marker_indices = coarsen_marker.indices();
+  const std::vector<std::int8_t>& marker_values = coarsen_marker.values();
+  for (std::size_t i = 0; i < marker_indices.size(); ++i)
+  {
+    assert((std::size_t)marker_indices[i] < can_coarsen.size());
+    if (marker_values[i] == 1)
+      can_coarsen[marker_indices[i]] = true;
+  }
+
+  // A parent must stay refined if any of its children is not marked
+  const int tdim = mesh.topology().dim();
+  auto map_c = mesh.topology().index_map(tdim);
+  assert(map_c);
+  std::vector<bool> keep_refined(map_c->size_local() + map_c->num_ghosts(),
+                                 false);
+  for (std::size_t c = 0; c < parent_cell.size(); ++c)
+  {
+    if (!can_coarsen[c])
+      keep_refined[parent_cell[c]] = true;
+  }
+
+  // Re-refine the parent mesh only where resolution is still needed.
+  // Everywhere else the parent cells are recovered unchanged, so the
+  // result coarsens the marked regions by one level with the usual
+  // Plaza quality and conformity guarantees.
+  const auto [long_edge, edge_ratio_ok] = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  mesh.topology_mutable().create_connectivity(tdim, 1);
+  auto c_to_e = mesh.topology().connectivity(tdim, 1);
+  assert(c_to_e);
+  for (std::size_t c = 0; c < keep_refined.size(); ++c)
+  {
+    if (keep_refined[c])
+    {
+      auto edges = c_to_e->links(c);
+      for (int j = 0; j < edges.rows(); ++j)
+        p_ref.mark(edges[j]);
+    }
+  }
+
+  enforce_rules(p_ref, mesh, long_edge);
+
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, false)
+      .first;
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t>
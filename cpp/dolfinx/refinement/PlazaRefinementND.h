@@ -53,6 +53,51 @@ public:
                            const mesh::MeshTags<std::int8_t>& refinement_marker,
                            bool redistribute);
 
+  /// Uniform refine, additionally returning the local parent cell
+  /// index of each refined cell for solution transfer. The refined
+  /// mesh is never redistributed and keeps the refined cells on the
+  /// rank of their parents, so the parent indices stay valid.
+  ///
+  /// @param[in] mesh Input mesh to be refined
+  /// @return (new mesh, parent cell index of each new cell)
+  static std::pair<mesh::Mesh, std::vector<std::int32_t>>
+  refine_with_parent_cells(const mesh::Mesh& mesh);
+
+  /// Refine with markers, additionally returning the local parent cell
+  /// index of each refined cell for solution transfer. The refined
+  /// mesh is never redistributed and keeps the refined cells on the
+  /// rank of their parents, so the parent indices stay valid.
+  ///
+  /// @param[in] mesh Input mesh to be refined
+  /// @param[in] refinement_marker MeshTags listing mesh entities
+  ///   which should be split by this refinement. Value == 1 means
+  ///   "refine", any other value means "do not refine".
+  /// @return (new mesh, parent cell index of each new cell)
+  static std::pair<mesh::Mesh, std::vector<std::int32_t>>
+  refine_with_parent_cells(const mesh::Mesh& mesh,
+                           const mesh::MeshTags<std::int8_t>& refinement_marker);
+
+  /// Coarsen a mesh produced by refine_with_parent_cells by one level:
+  /// parent cells whose children are all marked as coarsenable are
+  /// recombined into the original cell, while the remaining regions
+  /// are re-refined from the parent mesh with the usual Plaza rules.
+  /// Quality is preserved since every cell of the result is either a
+  /// parent cell or a Plaza subdivision of one; conformity across
+  /// process boundaries is handled by the shared-edge communication of
+  /// ParallelRefinement.
+  ///
+  /// @param[in] mesh The parent (coarse) mesh the refined mesh was
+  ///   built from
+  /// @param[in] parent_cell Local parent cell index of each refined
+  ///   cell, as returned by refine_with_parent_cells
+  /// @param[in] coarsen_marker MeshTags on the cells of the refined
+  ///   mesh. Value == 1 means "may be coarsened"; a parent is only
+  ///   recombined if all its children are marked.
+  /// @return The coarsened mesh
+  static mesh::Mesh coarsen(const mesh::Mesh& mesh,
+                            const std::vector<std::int32_t>& parent_cell,
+                            const mesh::MeshTags<std::int8_t>& coarsen_marker);
+
   /// Get the subdivision of an original simplex into smaller simplices,
   /// for a given set of marked edges, and the longest edge of each
   /// facet (cell local indexing). A flag indicates if a uniform
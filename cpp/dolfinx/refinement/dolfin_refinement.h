@@ -13,3 +13,4 @@ namespace dolfinx
 // DOLFINX refinement interface
 
 #include <dolfinx/refinement/refine.h>
+#include <dolfinx/refinement/transfer.h>
@@ -36,6 +36,54 @@ mesh::Mesh dolfinx::refinement::refine(const mesh::Mesh& mesh,
   return refined_mesh;
 }
 //-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+dolfinx::refinement::refine_with_parent_cells(const mesh::Mesh& mesh)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Refinement only defined for simplices");
+  }
+
+  return PlazaRefinementND::refine_with_parent_cells(mesh);
+}
+//-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+dolfinx::refinement::refine_with_parent_cells(
+    const mesh::Mesh& mesh, const mesh::MeshTags<std::int8_t>& cell_markers)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Refinement only defined for simplices");
+  }
+
+  return PlazaRefinementND::refine_with_parent_cells(mesh, cell_markers);
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh
+dolfinx::refinement::coarsen(const mesh::Mesh& mesh,
+                             const std::vector<std::int32_t>& parent_cell,
+                             const mesh::MeshTags<std::int8_t>& coarsen_marker)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Coarsening only defined for simplices");
+  }
+
+  mesh::Mesh coarsened_mesh
+      = PlazaRefinementND::coarsen(mesh, parent_cell, coarsen_marker);
+
+  // Report the number of cells after coarsening
+  const int D = mesh.topology().dim();
+  const std::int64_t n1
+      = coarsened_mesh.topology().index_map(D)->size_global();
+  LOG(INFO) << "Coarsened mesh has " << n1 << " cells.";
+
+  return coarsened_mesh;
+}
+//-----------------------------------------------------------------------------
 mesh::Mesh
 dolfinx::refinement::refine(const mesh::Mesh& mesh,
                             const mesh::MeshTags<std::int8_t>& cell_markers,
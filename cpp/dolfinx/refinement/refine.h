@@ -7,6 +7,8 @@
 #pragma once
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace dolfinx
 {
@@ -24,6 +26,13 @@ namespace refinement
 
 /// Create uniformly refined mesh
 ///
+/// When redistributing, the default is a from-scratch partition of the
+/// refined mesh. If DOLFINX is built with ParMETIS, setting the
+/// environment variable DOLFINX_ADAPTIVE_REPARTITION (optionally to
+/// the ParMETIS itr value) switches to incremental repartitioning,
+/// which migrates only what is needed to restore load balance - useful
+/// for repeated adaptation cycles.
+///
 /// @param[in] mesh The mesh from which to build a refined Mesh
 /// @param[in] redistribute Optional argument to redistribute the
 ///     refined mesh if mesh is a distributed mesh.
@@ -43,5 +52,46 @@ mesh::Mesh refine(const mesh::Mesh& mesh,
                   const mesh::MeshTags<std::int8_t>& cell_markers,
                   bool redistribute = true);
 
+/// Create uniformly refined mesh together with the local parent cell
+/// index of each refined cell. The refined mesh keeps the new cells on
+/// the rank of their parents (no redistribution), so the parent map
+/// can be used to build transfer operators, e.g. with
+/// create_prolongation, and adaptation cost stays proportional to the
+/// refined region.
+///
+/// @param[in] mesh The mesh from which to build a refined Mesh
+/// @return (refined mesh, parent cell index of each refined cell)
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+refine_with_parent_cells(const mesh::Mesh& mesh);
+
+/// Create locally refined mesh together with the local parent cell
+/// index of each refined cell (see the uniform overload)
+///
+/// @param[in] mesh The mesh from which to build a refined Mesh
+/// @param[in] cell_markers A mesh function over integers specifying
+///     which cells should be refined (value == 1) (and which should not
+///     (any other integer value)).
+/// @return (refined mesh, parent cell index of each refined cell)
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+refine_with_parent_cells(const mesh::Mesh& mesh,
+                         const mesh::MeshTags<std::int8_t>& cell_markers);
+
+/// Coarsen a refined mesh by one level using the parent cell map from
+/// refine_with_parent_cells. Parent cells whose children are all
+/// marked (value == 1) are recombined; regions that must keep their
+/// resolution are re-refined from the parent mesh, preserving the
+/// Plaza quality and conformity guarantees in parallel.
+///
+/// @param[in] mesh The parent (coarse) mesh the refined mesh was built
+///     from
+/// @param[in] parent_cell Local parent cell index of each refined
+///     cell, as returned by refine_with_parent_cells
+/// @param[in] coarsen_marker MeshTags on the cells of the refined
+///     mesh; value == 1 means "may be coarsened"
+/// @return The coarsened mesh
+mesh::Mesh coarsen(const mesh::Mesh& mesh,
+                   const std::vector<std::int32_t>& parent_cell,
+                   const mesh::MeshTags<std::int8_t>& coarsen_marker);
+
 } // namespace refinement
 } // namespace dolfinx
@@ -0,0 +1,151 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "transfer.h"
+#include <Eigen/Dense>
+#include <array>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/PETScMatrix.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <memory>
+#include <stdexcept>
+
+using namespace dolfinx;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Check that V is a scalar P1 Lagrange space on a simplex mesh of
+// topological dimension tdim
+void check_p1_space(const function::FunctionSpace& V, int tdim)
+{
+  assert(V.dofmap());
+  auto layout = V.dofmap()->element_dof_layout;
+  assert(layout);
+  if (layout->num_dofs() != tdim + 1 or layout->num_entity_dofs(0) != 1)
+  {
+    throw std::runtime_error("Prolongation matrix is only supported for "
+                             "scalar P1 Lagrange spaces.");
+  }
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+la::PETScMatrix
+refinement::create_prolongation(const function::FunctionSpace& V1,
+                                const function::FunctionSpace& V0,
+                                const std::vector<std::int32_t>& parent_cell)
+{
+  assert(V1.mesh());
+  assert(V0.mesh());
+  const mesh::Mesh& mesh1 = *V1.mesh();
+  const mesh::Mesh& mesh0 = *V0.mesh();
+
+  const int tdim = mesh1.topology().dim();
+  if (mesh0.topology().dim() != tdim)
+    throw std::runtime_error("Meshes have different topological dimensions.");
+  check_p1_space(V1, tdim);
+  check_p1_space(V0, tdim);
+
+  auto cell_map1 = mesh1.topology().index_map(tdim);
+  assert(cell_map1);
+  const std::int32_t num_cells1
+      = cell_map1->size_local() + cell_map1->num_ghosts();
+  if ((std::size_t)num_cells1 != parent_cell.size())
+  {
+    throw std::runtime_error("Parent cell array does not match the number of "
+                             "cells on the refined mesh.");
+  }
+
+  // Build and preallocate the sparsity pattern: the dofs of each
+  // refined cell couple to the dofs of its parent cell
+  std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
+      = {{V1.dofmap()->index_map, V0.dofmap()->index_map}};
+  la::SparsityPattern pattern(mesh1.mpi_comm(), index_maps);
+  for (std::int32_t c = 0; c < num_cells1; ++c)
+  {
+    pattern.insert(V1.dofmap()->cell_dofs(c),
+                   V0.dofmap()->cell_dofs(parent_cell[c]));
+  }
+  pattern.assemble();
+
+  // Create matrix
+  la::PETScMatrix A(mesh1.mpi_comm(), pattern);
+
+  // Build maps from local dof numbering to global
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global1
+      = index_maps[0]->indices(true);
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1> local_to_global0
+      = index_maps[1]->indices(true);
+
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x1
+      = mesh1.geometry().x();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap1
+      = mesh1.geometry().dofmap();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x0
+      = mesh0.geometry().x();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap0
+      = mesh0.geometry().dofmap();
+
+  // Each row of the cell block holds the barycentric coordinates of a
+  // fine vertex with respect to the parent cell. For P1 geometry the
+  // geometry dofs coincide with the vertices, and the dof order
+  // follows the cell vertex order. Vertices shared between refined
+  // cells insert identical rows, so repeated insertion is harmless.
+  const int nv = tdim + 1;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> T(tdim, tdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values(nv, nv);
+  std::vector<PetscInt> rows(nv), columns(nv);
+  for (std::int32_t c = 0; c < num_cells1; ++c)
+  {
+    auto x_dofs0 = x_dofmap0.links(parent_cell[c]);
+    auto x_dofs1 = x_dofmap1.links(c);
+
+    // Affine map of the parent cell (in the first tdim coordinates)
+    for (int j = 0; j < tdim; ++j)
+    {
+      for (int i = 0; i < tdim; ++i)
+        T(i, j) = x0(x_dofs0[j + 1], i) - x0(x_dofs0[0], i);
+    }
+    const auto T_inv = T.fullPivLu();
+
+    for (int i = 0; i < nv; ++i)
+    {
+      Eigen::Matrix<double, Eigen::Dynamic, 1> b(tdim);
+      for (int d = 0; d < tdim; ++d)
+        b[d] = x1(x_dofs1[i], d) - x0(x_dofs0[0], d);
+      const Eigen::Matrix<double, Eigen::Dynamic, 1> lambda = T_inv.solve(b);
+
+      values(i, 0) = 1.0 - lambda.sum();
+      for (int j = 0; j < tdim; ++j)
+        values(i, j + 1) = lambda[j];
+    }
+
+    auto dofs1 = V1.dofmap()->cell_dofs(c);
+    auto dofs0 = V0.dofmap()->cell_dofs(parent_cell[c]);
+    for (int i = 0; i < nv; ++i)
+      rows[i] = local_to_global1[dofs1[i]];
+    for (int j = 0; j < nv; ++j)
+      columns[j] = local_to_global0[dofs0[j]];
+
+    A.set(values.data(), nv, rows.data(), nv, columns.data());
+  }
+
+  // Finalise matrix
+  A.apply(la::PETScMatrix::AssemblyType::FINAL);
+
+  return A;
+}
+//-----------------------------------------------------------------------------
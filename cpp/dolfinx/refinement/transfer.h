@@ -0,0 +1,50 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx
+{
+
+namespace function
+{
+class FunctionSpace;
+}
+
+namespace la
+{
+class PETScMatrix;
+}
+
+namespace refinement
+{
+
+/// Build the P1 prolongation matrix P mapping a coarse function
+/// \f$w\f$ to the refined space, i.e. \f$v = Pw\f$, where the refined
+/// mesh and the parent cell map were produced by
+/// refine_with_parent_cells on the coarse mesh. Each row holds the
+/// barycentric coordinates of the fine vertex inside its parent cell,
+/// so unrefined cells yield identity rows and solution transfer costs
+/// O(cells) with no geometric search. The transpose of P restricts
+/// back to the coarse space.
+///
+/// Both spaces must be scalar P1 Lagrange on simplex meshes of equal
+/// geometric and topological dimension.
+///
+/// @param[in] V1 P1 space on the refined mesh (matrix rows)
+/// @param[in] V0 P1 space on the coarse mesh (matrix columns)
+/// @param[in] parent_cell Local parent cell index of each refined
+///   cell, as returned by refine_with_parent_cells
+/// @return The prolongation matrix
+la::PETScMatrix create_prolongation(const function::FunctionSpace& V1,
+                                    const function::FunctionSpace& V0,
+                                    const std::vector<std::int32_t>& parent_cell);
+
+} // namespace refinement
+} // namespace dolfinx
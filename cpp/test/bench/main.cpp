@@ -0,0 +1,441 @@
+// Copyright (C) 2020 DOLFINX contributors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Micro-benchmarks for the hot paths, with roofline reporting. Each
+// benchmark reports its natural throughput (cells/s, entities/s,
+// ghosts/s) and an estimated memory bandwidth, compared against a
+// STREAM triad roofline measured in the same run. Results are written
+// as JSON for regression tracking.
+//
+// Usage: dolfinx_bench [n] [output.json] [--record=DIR] [--check=DIR]
+//   n            Number of grid cells per direction of the global box
+//                (default 32; the cell count is 6 n^3)
+//   output.json  Output file, written by rank 0
+//                (default dolfinx_bench.json)
+//   --record=DIR Record the results as the baseline for this machine
+//                profile (hash of the CPU model and build flags)
+//   --check=DIR  Compare against the recorded baseline and flag
+//                regressions of more than 5% on any kernel; the exit
+//                code is non-zero if a regression is found
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/defines.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/TopologyComputation.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// One benchmark result
+struct Record
+{
+  std::string name;
+  std::string params;
+  double value;
+  std::string unit;
+  double bandwidth; // Estimated memory bandwidth (GB/s), 0 if n/a
+};
+//-----------------------------------------------------------------------------
+// Wall time of f() in seconds, best of three runs
+template <typename F>
+double time_best(F&& f)
+{
+  double best = std::numeric_limits<double>::max();
+  for (int run = 0; run < 3; ++run)
+  {
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    const auto t1 = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+  }
+  return best;
+}
+//-----------------------------------------------------------------------------
+// STREAM triad a = b + s * c, measuring the local memory bandwidth
+// roofline (GB/s per rank)
+double bench_stream()
+{
+  const std::size_t n = 1 << 25;
+  std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+  const double s = 3.0;
+  const double t = time_best([&]() {
+    for (std::size_t i = 0; i < n; ++i)
+      a[i] = b[i] + s * c[i];
+  });
+
+  // Three arrays of doubles touched per iteration
+  return 3.0 * n * sizeof(double) / t / 1.0e9;
+}
+//-----------------------------------------------------------------------------
+// Cell-vertex topology of this rank's slab of a global n x n x n box
+// of cubes, each split into six tetrahedra (global vertex indices, in
+// the BoxMesh numbering)
+graph::AdjacencyList<std::int64_t> box_tet_cells(MPI_Comm comm, std::int64_t n)
+{
+  const std::int64_t n_cells = n * n * n;
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), n_cells, dolfinx::MPI::size(comm));
+
+  Eigen::Array<std::int64_t, Eigen::Dynamic, 4, Eigen::RowMajor> topo(
+      6 * (range[1] - range[0]), 4);
+  std::int64_t cell = 0;
+  for (std::int64_t i = range[0]; i < range[1]; ++i)
+  {
+    const std::int64_t iz = i / (n * n);
+    const std::int64_t j = i % (n * n);
+    const std::int64_t iy = j / n;
+    const std::int64_t ix = j % n;
+
+    const std::int64_t v0 = iz * (n + 1) * (n + 1) + iy * (n + 1) + ix;
+    const std::int64_t v1 = v0 + 1;
+    const std::int64_t v2 = v0 + (n + 1);
+    const std::int64_t v3 = v1 + (n + 1);
+    const std::int64_t v4 = v0 + (n + 1) * (n + 1);
+    const std::int64_t v5 = v1 + (n + 1) * (n + 1);
+    const std::int64_t v6 = v2 + (n + 1) * (n + 1);
+    const std::int64_t v7 = v3 + (n + 1) * (n + 1);
+
+    topo.row(cell++) << v0, v1, v3, v7;
+    topo.row(cell++) << v0, v1, v7, v5;
+    topo.row(cell++) << v0, v5, v7, v4;
+    topo.row(cell++) << v0, v3, v2, v7;
+    topo.row(cell++) << v0, v6, v4, v7;
+    topo.row(cell++) << v0, v2, v6, v7;
+  }
+
+  return graph::AdjacencyList<std::int64_t>(topo);
+}
+//-----------------------------------------------------------------------------
+// Topology construction (vertex numbering and ownership) in cells/s
+Record bench_create_topology(MPI_Comm comm,
+                             const graph::AdjacencyList<std::int64_t>& cells)
+{
+  std::vector<std::int64_t> original_index(cells.num_nodes());
+  std::iota(original_index.begin(), original_index.end(), 0);
+
+  const double t = time_best([&]() {
+    mesh::Topology topology = mesh::create_topology(
+        comm, cells, original_index, {}, mesh::CellType::tetrahedron,
+        mesh::GhostMode::none);
+  });
+
+  return {"create_topology", "tetrahedron", cells.num_nodes() / t, "cells/s",
+          0.0};
+}
+//-----------------------------------------------------------------------------
+// Entity computation (facets or edges) in entities/s with an estimated
+// index bandwidth
+Record bench_compute_entities(MPI_Comm comm, mesh::Topology& topology, int dim)
+{
+  std::int64_t num_entities = 0;
+  const double t = time_best([&]() {
+    // The computed connectivity is not stored back in the topology, so
+    // every run recomputes the entities
+    auto [cell_entity, entity_vertex, index_map]
+        = mesh::TopologyComputation::compute_entities(comm, topology, dim);
+    assert(index_map);
+    num_entities = index_map->size_local() + index_map->num_ghosts();
+  });
+
+  // Rough traffic estimate: the entity-vertex and cell-entity index
+  // data, written once and read once
+  auto cells = topology.connectivity(topology.dim(), 0);
+  const double bytes
+      = 2.0 * sizeof(std::int32_t)
+        * (num_entities * (dim + 1) + cells->array().rows());
+
+  return {"compute_entities", "dim=" + std::to_string(dim), num_entities / t,
+          "entities/s", bytes / t / 1.0e9};
+}
+//-----------------------------------------------------------------------------
+// Ghost update throughput for a given ghost fraction
+Record bench_scatter_fwd(MPI_Comm comm, std::int32_t local_size,
+                         double ghost_fraction)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Ghost a block of the previous rank's entries
+  const std::int32_t num_ghosts
+      = size > 1 ? static_cast<std::int32_t>(local_size * ghost_fraction) : 0;
+  const int prev = (rank + size - 1) % size;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  std::vector<int> ghost_ranks(num_ghosts, prev);
+  for (std::int32_t i = 0; i < num_ghosts; ++i)
+    ghosts[i] = static_cast<std::int64_t>(prev) * local_size + i;
+
+  common::IndexMap map(comm, local_size, ghosts, ghost_ranks, 1);
+
+  std::vector<std::int64_t> local_data(local_size);
+  std::iota(local_data.begin(), local_data.end(), 0);
+  std::vector<std::int64_t> remote_data;
+  const double t
+      = time_best([&]() { map.scatter_fwd(local_data, remote_data, 1); });
+
+  // Each ghost value is sent and received once
+  const double bytes = 2.0 * num_ghosts * sizeof(std::int64_t);
+  return {"scatter_fwd", "ghost_fraction=" + std::to_string(ghost_fraction),
+          num_ghosts / t, "ghosts/s", bytes / t / 1.0e9};
+}
+//-----------------------------------------------------------------------------
+// Matrix insertion path (sparsity build for a P1-type cell dofmap) in
+// cells/s. Form assembly itself needs generated kernels, so this
+// covers the insertion side of assemble_matrix.
+Record bench_sparsity_insert(MPI_Comm comm, mesh::Topology& topology)
+{
+  const int tdim = topology.dim();
+  auto c_to_v = topology.connectivity(tdim, 0);
+  assert(c_to_v);
+  auto vertex_map = topology.index_map(0);
+  assert(vertex_map);
+
+  const double t = time_best([&]() {
+    la::SparsityPattern pattern(comm, {vertex_map, vertex_map});
+    pattern.insert_cells(*c_to_v, *c_to_v);
+    pattern.assemble();
+  });
+
+  const std::int32_t num_cells = c_to_v->num_nodes();
+  const double bytes
+      = 2.0 * sizeof(std::int32_t) * c_to_v->array().rows() * 4.0;
+  return {"sparsity_insert", "P1 proxy", num_cells / t, "cells/s",
+          bytes / t / 1.0e9};
+}
+//-----------------------------------------------------------------------------
+// CPU model string from /proc/cpuinfo (or "unknown")
+std::string cpu_model()
+{
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line))
+  {
+    if (line.compare(0, 10, "model name") == 0)
+    {
+      const std::size_t colon = line.find(':');
+      if (colon != std::string::npos)
+        return line.substr(colon + 2);
+    }
+  }
+  return "unknown";
+}
+//-----------------------------------------------------------------------------
+// Machine profile keying the baselines: hash of the CPU model and the
+// build configuration. The git hash is deliberately excluded so a
+// baseline stays valid across commits on the same machine and build.
+std::string profile_hash()
+{
+  std::string s = cpu_model() + ";" + dolfinx::version()
+                  + ";debug=" + std::to_string(dolfinx::has_debug())
+                  + ";complex=" + std::to_string(dolfinx::has_petsc_complex())
+                  + ";slepc=" + std::to_string(dolfinx::has_slepc())
+                  + ";parmetis=" + std::to_string(dolfinx::has_parmetis())
+                  + ";kahip=" + std::to_string(dolfinx::has_kahip());
+  std::stringstream hash;
+  hash << std::hex << std::hash<std::string>{}(s);
+  return hash.str();
+}
+//-----------------------------------------------------------------------------
+// Write the records as JSON with the machine profile
+void write_json(const std::string& filename, const std::vector<Record>& records,
+                double roofline)
+{
+  std::ofstream file(filename);
+  file << "{\n";
+  file << "  \"profile\": \"" << profile_hash() << "\",\n";
+  file << "  \"cpu\": \"" << cpu_model() << "\",\n";
+  file << "  \"version\": \"" << dolfinx::version() << "\",\n";
+  file << "  \"records\": [\n";
+  for (std::size_t i = 0; i < records.size(); ++i)
+  {
+    const Record& r = records[i];
+    file << "    {\"name\": \"" << r.name << "\", "
+         << "\"params\": \"" << r.params << "\", "
+         << "\"value\": " << r.value << ", "
+         << "\"unit\": \"" << r.unit << "\", "
+         << "\"bandwidth_GBs\": " << r.bandwidth << ", "
+         << "\"roofline_GBs\": " << roofline << ", "
+         << "\"roofline_fraction\": "
+         << (roofline > 0.0 ? r.bandwidth / roofline : 0.0) << "}"
+         << (i + 1 < records.size() ? "," : "") << "\n";
+  }
+  file << "  ]\n";
+  file << "}\n";
+}
+//-----------------------------------------------------------------------------
+// Read (name + params -> value) back from a baseline file written by
+// write_json
+std::map<std::string, double> read_baseline(const std::string& filename)
+{
+  std::map<std::string, double> baseline;
+  std::ifstream file(filename);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const std::size_t name_pos = line.find("\"name\": \"");
+    const std::size_t params_pos = line.find("\"params\": \"");
+    const std::size_t value_pos = line.find("\"value\": ");
+    if (name_pos == std::string::npos or params_pos == std::string::npos
+        or value_pos == std::string::npos)
+    {
+      continue;
+    }
+
+    const std::size_t name_end = line.find('"', name_pos + 9);
+    const std::size_t params_end = line.find('"', params_pos + 11);
+    const std::string key = line.substr(name_pos + 9, name_end - name_pos - 9)
+                            + "/"
+                            + line.substr(params_pos + 11,
+                                          params_end - params_pos - 11);
+    baseline[key] = std::stod(line.substr(value_pos + 9));
+  }
+  return baseline;
+}
+//-----------------------------------------------------------------------------
+// Compare against the baseline for this profile. Returns the number of
+// kernels that regressed by more than tolerance.
+int check_regressions(const std::string& filename,
+                      const std::vector<Record>& records, double tolerance)
+{
+  const std::map<std::string, double> baseline = read_baseline(filename);
+  if (baseline.empty())
+  {
+    std::cout << "No baseline for this machine profile (" << filename
+              << "); run with --record first.\n";
+    return 0;
+  }
+
+  int num_regressions = 0;
+  for (const Record& r : records)
+  {
+    const auto it = baseline.find(r.name + "/" + r.params);
+    if (it == baseline.end())
+      continue;
+
+    const double change = r.value / it->second - 1.0;
+    if (change < -tolerance)
+    {
+      std::cout << "REGRESSION: " << r.name << " (" << r.params << "): "
+                << r.value << " " << r.unit << " vs baseline " << it->second
+                << " (" << 100.0 * change << "%)\n";
+      ++num_regressions;
+    }
+  }
+  if (num_regressions == 0)
+    std::cout << "All kernels within " << 100.0 * tolerance
+              << "% of the baseline.\n";
+  return num_regressions;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+  int num_regressions = 0;
+  {
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Positional arguments [n] [output.json] and baseline options
+    std::int64_t n = 32;
+    std::string filename = "dolfinx_bench.json";
+    std::string record_dir, check_dir;
+    int num_positional = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      if (arg.compare(0, 9, "--record=") == 0)
+        record_dir = arg.substr(9);
+      else if (arg.compare(0, 8, "--check=") == 0)
+        check_dir = arg.substr(8);
+      else if (num_positional++ == 0)
+        n = std::stoll(arg);
+      else
+        filename = arg;
+    }
+
+    std::vector<Record> records;
+
+    // Memory bandwidth roofline for this node
+    const double roofline = bench_stream();
+
+    // Mesh topology benchmarks on a 6 n^3 tetrahedron box
+    const graph::AdjacencyList<std::int64_t> cells = box_tet_cells(comm, n);
+    records.push_back(bench_create_topology(comm, cells));
+
+    std::vector<std::int64_t> original_index(cells.num_nodes());
+    std::iota(original_index.begin(), original_index.end(), 0);
+    mesh::Topology topology = mesh::create_topology(
+        comm, cells, original_index, {}, mesh::CellType::tetrahedron,
+        mesh::GhostMode::none);
+    records.push_back(bench_compute_entities(comm, topology, 2));
+    records.push_back(bench_compute_entities(comm, topology, 1));
+
+    // Ghost update across ghost fractions
+    for (double fraction : {0.01, 0.05, 0.25})
+      records.push_back(bench_scatter_fwd(comm, 1 << 20, fraction));
+
+    // Matrix insertion path
+    records.push_back(bench_sparsity_insert(comm, topology));
+
+    if (dolfinx::MPI::rank(comm) == 0)
+    {
+      for (const Record& r : records)
+      {
+        std::cout << r.name << " (" << r.params << "): " << r.value << " "
+                  << r.unit;
+        if (r.bandwidth > 0.0)
+        {
+          std::cout << ", " << r.bandwidth << " GB/s ("
+                    << 100.0 * r.bandwidth / roofline << "% of roofline "
+                    << roofline << " GB/s)";
+        }
+        std::cout << "\n";
+      }
+      write_json(filename, records, roofline);
+
+      const std::string baseline_file
+          = "/dolfinx_bench-" + profile_hash() + ".json";
+      if (!record_dir.empty())
+      {
+        write_json(record_dir + baseline_file, records, roofline);
+        std::cout << "Baseline recorded in " << record_dir + baseline_file
+                  << "\n";
+      }
+      if (!check_dir.empty())
+      {
+        num_regressions
+            = check_regressions(check_dir + baseline_file, records, 0.05);
+      }
+    }
+
+    // All ranks exit with the same status
+    MPI_Bcast(&num_regressions, 1, MPI_INT, 0, comm);
+  }
+  MPI_Finalize();
+
+  return num_regressions == 0 ? 0 : 1;
+}